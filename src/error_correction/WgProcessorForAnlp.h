@@ -165,7 +165,7 @@ class WgProcessorForAnlp: public BaseWgProcessorForAnlp
                                             unsigned int verbose=0);
       // Given a prefix and a pair of weights, obtains a list of the n
       // substates of the words-graph with best probability
-  bool wordSatisfiesRejWordConstraint(std::string word,
+  bool wordSatisfiesRejWordConstraint(const std::string& word,
                                       const RejectedWordsSet& rejectedWords);
   void updateWgpInfoForInitState(const std::vector<std::string>& prefixDiffVec,
                                  unsigned int verbose=0);
@@ -453,15 +453,15 @@ void WgProcessorForAnlp<ECM_FOR_WG>::initEcmScoreInfoForArc(WordGraphArcId wgArc
   EcmScoreInfo prevEsi=ecmScrInfoForState[idx];
 
       // Grow new esi for arc if necessary
-  while(ecmScrInfoForArcVec[wgArcId].size()<wgArc.words.size())
+  while(ecmScrInfoForArcVec[wgArcId].size()<wgArc.numWords)
   {
     EcmScoreInfo esi;
     ecmScrInfoForArcVec[wgArcId].push_back(esi);
   }
-  for(unsigned int w=0;w<wgArc.words.size();++w)
+  for(unsigned int w=0;w<wgArc.numWords;++w)
   {
     ecmScrInfoForArcVec[wgArcId][w]=ecm_wg_ptr->constructEsi(prevEsi,
-                                                             wgArc.words[w]);
+                                                             wg_ptr->getArcWord(wgArc,w));
     prevEsi=ecmScrInfoForArcVec[wgArcId][w];
   }
 }
@@ -561,18 +561,21 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainNbestHypStates(unsigned int n,
     if(!rejectedWords.empty())
     {
           // Obtain successors
-      std::vector<WordGraphArc> wgArcs;
-      wg_ptr->getArcsToSuccStates(hsIdx,wgArcs);
+      WordGraph::ArcIdRange range=wg_ptr->getArcIdRangeToSuccStates(hsIdx);
 
           // Find the best successor
       Score bestRestScoreForSucc=SMALL_SCORE;
-      for(unsigned int i=0;i<wgArcs.size();++i)
+      for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
       {
+        if(wg_ptr->arcPruned(*arcIdPtr))
+          continue;
+        
             // Check that the constraint is satisfied
-        bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wgArcs[i].words[0],rejectedWords);
+        WordGraphArc wgArc=wg_ptr->wordGraphArcId2WordGraphArc(*arcIdPtr);
+        bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wg_ptr->getArcWord(wgArc,0),rejectedWords);
         if(wordSatisfiesConstraint)
         {
-          Score restScoreForArc=wgArcs[i].arcScore+restScores[wgArcs[i].succStateIndex];
+          Score restScoreForArc=wgArc.arcScore+restScores[wgArc.succStateIndex];
           if(bestRestScoreForSucc<restScoreForArc)
             bestRestScoreForSucc=restScoreForArc;
         }
@@ -622,7 +625,7 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainNbestHypSubStates(unsigned int n,
           // Obtain arc from arc id.
       WordGraphArc wgArc=wg_ptr->wordGraphArcId2WordGraphArc(wgArcId);
           // Iterate over the words of the arc
-      if(wgArc.words.size()>1)
+      if(wgArc.numWords>1)
       {
             // NOTE: the last word of the arc wgArc constitutes a sub-state
             // equivalent to wgArc.succStateIndex state
@@ -630,14 +633,14 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainNbestHypSubStates(unsigned int n,
             // Obtain wg score for predecessor state
         Score wgScr=wgScoreForState[wgArc.predStateIndex];
 
-        for(unsigned int w=0;w<wgArc.words.size()-1;++w)
+        for(unsigned int w=0;w<wgArc.numWords-1;++w)
         {
               // Check that the sub-state satisfies the constraints
               // imposed by the set of rejected words
           bool subHypStateOk=true;
           if(!rejectedWords.empty())
           {
-            bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wgArc.words[w+1],rejectedWords);
+            bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wg_ptr->getArcWord(wgArc,w+1),rejectedWords);
             if(!wordSatisfiesConstraint)
               subHypStateOk=false;
           }
@@ -673,7 +676,7 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainNbestHypSubStates(unsigned int n,
 
 //---------------------------------------
 template<class ECM_FOR_WG>
-bool WgProcessorForAnlp<ECM_FOR_WG>::wordSatisfiesRejWordConstraint(std::string word,
+bool WgProcessorForAnlp<ECM_FOR_WG>::wordSatisfiesRejWordConstraint(const std::string& word,
                                                                     const RejectedWordsSet& rejectedWords)
 {
   RejectedWordsSet::const_iterator strSetIter;
@@ -754,18 +757,18 @@ void WgProcessorForAnlp<ECM_FOR_WG>::updateEcmScoreInfoForArc(const std::vector<
   EcmScoreInfo prevEsi=ecmScrInfoForState[idx];
   
       // Grow new esi for arc if necessary
-  while(ecmScrInfoForArcVec[wgArcId].size()<wgArc.words.size())
+  while(ecmScrInfoForArcVec[wgArcId].size()<wgArc.numWords)
   {
     EcmScoreInfo esi;
     ecmScrInfoForArcVec[wgArcId].push_back(esi);
   }
 
-  for(unsigned int w=0;w<wgArc.words.size();++w)
+  for(unsigned int w=0;w<wgArc.numWords;++w)
   {
         // Extend ecm score info
     ecm_wg_ptr->extendEsi(prefixDiffVec,
                           prevEsi,
-                          wgArc.words[w],
+                          wg_ptr->getArcWord(wgArc,w),
                           ecmScrInfoForArcVec[wgArcId][w]);
     prevEsi=ecmScrInfoForArcVec[wgArcId][w];
   }
@@ -962,7 +965,7 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainBestUncorrPrefHypState(unsigned int procPr
     WordGraphArc wordGraphArc=wg_ptr->wordGraphArcId2WordGraphArc(wordGraphArcId);
 
         // Obtain new value for currProcPrefPos
-    for(unsigned int w=wordGraphArc.words.size();w>0;--w)
+    for(unsigned int w=wordGraphArc.numWords;w>0;--w)
     {
       std::vector<int> predPrefWordVec=ecm_wg_ptr->obtainLastInsPrefWordVecFromEsi(ecmScrInfoForArcVec[wordGraphArcId][w-1]);
       currProcPrefPos=predPrefWordVec[currProcPrefPos];
@@ -972,9 +975,9 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainBestUncorrPrefHypState(unsigned int procPr
     hsidx=wordGraphArc.predStateIndex;
     
         // Add words to invResult
-    for(unsigned int i=wordGraphArc.words.size();i>0;--i)
+    for(unsigned int i=wordGraphArc.numWords;i>0;--i)
     {
-      invResult.push_back(wordGraphArc.words[i-1]);
+      invResult.push_back(wg_ptr->getArcWord(wordGraphArc,i-1));
     }
   }
 
@@ -1015,7 +1018,7 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainBestUncorrPrefHypSubState(unsigned int pro
 
       // Compose result
   for(unsigned int i=0;i<=arcPos;++i)
-    result.push_back(wgArc.words[i]);
+    result.push_back(wg_ptr->getArcWord(wgArc,i));
 
       // Compose wgaidVec
   wgaidVec.clear();
@@ -1062,29 +1065,35 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainCorrForHypState(std::vector<std::string> p
   
   // Obtain suffix for successor state
 
-      // Obtain set of excluded arcs
-  std::set<WordGraphArcId> excludedWgArcIdSet;
-  std::vector<WordGraphArcId> arcIdsSuccStatesVec;
+      // Obtain bit map of excluded arcs
+  std::vector<bool> excludedArcs;
   if(!rejectedWords.empty())
   {
-    wg_ptr->getArcIdsToSuccStates(hypStateIndex,arcIdsSuccStatesVec);
-    for(unsigned int i=0;i<arcIdsSuccStatesVec.size();++i)
+    WordGraph::ArcIdRange range=wg_ptr->getArcIdRangeToSuccStates(hypStateIndex);
+    for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
     {
-      WordGraphArc wgArc=wg_ptr->wordGraphArcId2WordGraphArc(arcIdsSuccStatesVec[i]);
-      bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wgArc.words[0],rejectedWords);
+      if(wg_ptr->arcPruned(*arcIdPtr))
+        continue;
+      
+      WordGraphArc wgArc=wg_ptr->wordGraphArcId2WordGraphArc(*arcIdPtr);
+      bool wordSatisfiesConstraint=wordSatisfiesRejWordConstraint(wg_ptr->getArcWord(wgArc,0),rejectedWords);
       if(!wordSatisfiesConstraint)
-        excludedWgArcIdSet.insert(arcIdsSuccStatesVec[i]);
+      {
+        if(excludedArcs.empty())
+          excludedArcs.resize(wg_ptr->numArcs(),false);
+        excludedArcs[*arcIdPtr]=true;
+      }
     }
   }
 
       // Obtain best path
   std::vector<WordGraphArc> arcVec;
-  wg_ptr->bestPathFromFinalStateToIdx(hypStateIndex,excludedWgArcIdSet,arcVec);
+  wg_ptr->bestPathFromFinalStateToIdx(hypStateIndex,excludedArcs,arcVec);
   
   for(std::vector<WordGraphArc>::reverse_iterator riter=arcVec.rbegin();riter!=arcVec.rend();++riter)
   {
-    for(unsigned int i=0;i<riter->words.size();++i)
-      result.push_back(riter->words[i]);
+    for(unsigned int i=0;i<riter->numWords;++i)
+      result.push_back(wg_ptr->getArcWord(*riter,i));
   }
 
       // Remove last blank character if exists
@@ -1167,21 +1176,21 @@ WgProcessorForAnlp<ECM_FOR_WG>::obtainCorrForHypSubState(std::vector<std::string
 
       // Obtain result concatenating words in the arc with suffix for
       // succesor state
-  for(unsigned int w=hypSubStateIdx.second+1;w<wgArc.words.size();++w)
-    result.push_back(wgArc.words[w]);
+  for(unsigned int w=hypSubStateIdx.second+1;w<wgArc.numWords;++w)
+    result.push_back(wg_ptr->getArcWord(wgArc,w));
 
   // Obtain suffix for successor state
   std::vector<Score> prevScores;
   std::vector<WordGraphArc> arcVec;
   
       // Obtain best path
-  std::set<WordGraphArcId> emptyWgArcIdSet;
-  wg_ptr->bestPathFromFinalStateToIdx(wgArc.succStateIndex,emptyWgArcIdSet,arcVec);
+  std::vector<bool> noExcludedArcs;
+  wg_ptr->bestPathFromFinalStateToIdx(wgArc.succStateIndex,noExcludedArcs,arcVec);
 
   for(std::vector<WordGraphArc>::reverse_iterator riter=arcVec.rbegin();riter!=arcVec.rend();++riter)
   {
-    for(unsigned int i=0;i<riter->words.size();++i)
-      result.push_back(riter->words[i]);
+    for(unsigned int i=0;i<riter->numWords;++i)
+      result.push_back(wg_ptr->getArcWord(*riter,i));
   }
 
       // Remove last blank character if exists
@@ -1564,7 +1573,7 @@ void WgProcessorForAnlp<ECM_FOR_WG>::printInfoForSubStates(std::ostream &outS)co
           // Obtain arc from arc id.
       WordGraphArc wgArc=wg_ptr->wordGraphArcId2WordGraphArc(wgArcId);
           // Iterate over the words of the arc
-      for(unsigned int w=0;w<wgArc.words.size();++w)
+      for(unsigned int w=0;w<wgArc.numWords;++w)
       {
         printSubStateInfo(wgArcId,w,outS);
         outS<<std::endl;
@@ -25,12 +25,64 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include "WordGraph.h"
+#include <string.h>
+#include <stdint.h>
+
+//--------------- Auxiliary functions for binary files
+
+namespace
+{
+  void writeUInt(std::ofstream& outF,
+                 uint32_t val)
+  {
+    outF.write((const char*)&val,sizeof(val));
+  }
+
+  void writeDouble(std::ofstream& outF,
+                   double val)
+  {
+    outF.write((const char*)&val,sizeof(val));
+  }
+
+  void writeString(std::ofstream& outF,
+                   const std::string& str)
+  {
+    writeUInt(outF,str.size());
+    outF.write(str.c_str(),str.size());
+  }
+
+  bool readUInt(std::ifstream& inF,
+                uint32_t& val)
+  {
+    return (bool) inF.read((char*)&val,sizeof(val));
+  }
+
+  bool readDouble(std::ifstream& inF,
+                  double& val)
+  {
+    return (bool) inF.read((char*)&val,sizeof(val));
+  }
+
+  bool readString(std::ifstream& inF,
+                  std::string& str)
+  {
+    uint32_t len;
+    if(!readUInt(inF,len))
+      return false;
+    str.resize(len);
+    if(len==0)
+      return true;
+    return (bool) inF.read(&str[0],len);
+  }
+}
 
 //--------------- WordGraph class function definitions
 
 WordGraph::WordGraph(void)
 {
   initialStateScore=0;
+  numWgStates=0;
+  adjacencyBuilt=false;
 }
 
 //---------------------------------------
@@ -76,46 +128,52 @@ void WordGraph::addArc(HypStateIndex predStateIndex,
                        HypStateIndex succStateIndex,
                        const std::vector<std::string>& words,
                        Score arcScore)
+{
+      // Obtain word indices
+  std::vector<WordIndex> wordIdxs;
+  for(unsigned int i=0;i<words.size();++i)
+    wordIdxs.push_back(addWord(words[i]));
+
+      // Add arc
+  addArcWordIdx(predStateIndex,
+                succStateIndex,
+                wordIdxs.empty() ? NULL : &wordIdxs[0],
+                wordIdxs.size(),
+                arcScore);
+}
+
+//---------------------------------------
+void WordGraph::addArcWordIdx(HypStateIndex predStateIndex,
+                              HypStateIndex succStateIndex,
+                              const WordIndex* wordIdxs,
+                              unsigned int numWords,
+                              Score arcScore)
 {
   WordGraphArc wordGraphArc;
-  WordGraphArcId wordGraphArcId;
   
       // Fill wordGraphArc data structure
   wordGraphArc.predStateIndex=predStateIndex;
   wordGraphArc.succStateIndex=succStateIndex;
   wordGraphArc.arcScore=arcScore;
-  wordGraphArc.words=words;
+  wordGraphArc.firstWordPos=arcWordIdxVec.size();
+  wordGraphArc.numWords=numWords;
+  arcWordIdxVec.insert(arcWordIdxVec.end(),wordIdxs,wordIdxs+numWords);
 
-      // Insert arc and retrieve index
+      // Insert arc
   wordGraphArcs.push_back(wordGraphArc);
-  wordGraphArcId=wordGraphArcs.size()-1;
 
       // Register arc as not selected for pruning
   arcsPruned.push_back(false);
   
-      // Add the new arc   
-  if(succStateIndex<wordGraphStates.size())
-  {
-        // Add arc to predecessor and succesor states
-    wordGraphStates[predStateIndex].arcsToSuccStates.push_back(wordGraphArcId);
-    wordGraphStates[succStateIndex].arcsToPredStates.push_back(wordGraphArcId);
-  }
-  else
-  {
-        // There were not any arcs to the successor state
-    WordGraphStateData wordGraphStateData;
-
-        // Add the required number of empty elements to wordGraphStates
-    while(succStateIndex>=wordGraphStates.size())
-      wordGraphStates.push_back(wordGraphStateData);
-
-        // Add arc to succesor state
-    wordGraphStates[predStateIndex].arcsToSuccStates.push_back(wordGraphArcId);
-
-        // Add arc to predecessor state
-    wordGraphStates[succStateIndex].arcsToPredStates.push_back(wordGraphArcId);
-  }
-
+      // Update number of states
+  if(predStateIndex>=numWgStates)
+    numWgStates=predStateIndex+1;
+  if(succStateIndex>=numWgStates)
+    numWgStates=succStateIndex+1;
+
+      // Adjacency arrays should be rebuilt
+  adjacencyBuilt=false;
+  
       // Add empty score vector
   std::vector<Score> emptyScrVec;
   scrCompsVec.push_back(emptyScrVec);
@@ -126,18 +184,28 @@ void WordGraph::addArcWithScrComps(HypStateIndex predStateIndex,
                                    HypStateIndex succStateIndex,
                                    const std::vector<std::string>& words,
                                    Score arcScore,
-                                   std::vector<Score> scrVec)
+                                   const std::vector<Score>& scrVec)
 {
       // Add arc
   addArc(predStateIndex,succStateIndex,words,arcScore);
 
       // Store components
-  std::vector<Score> emptyScrVec;
-  while(scrCompsVec.size()!=wordGraphArcs.size())
+  scrCompsVec.back()=scrVec;
+}
+
+//---------------------------------------
+WordIndex WordGraph::addWord(const std::string& word)
+{
+  StrToIdxVocab::iterator iter=strToIdxVocab.find(word);
+  if(iter!=strToIdxVocab.end())
+    return iter->second;
+  else
   {
-    scrCompsVec.push_back(emptyScrVec);
+    WordIndex w=idxToStrVocab.size();
+    idxToStrVocab.push_back(word);
+    strToIdxVocab.insert(std::make_pair(word,w));
+    return w;
   }
-  scrCompsVec[scrCompsVec.size()-1]=scrVec;
 }
 
 //---------------------------------------
@@ -167,10 +235,10 @@ Score WordGraph::getInitialStateScore(void)const
 //---------------------------------------
 std::pair<HypStateIndex,HypStateIndex> WordGraph::getHypStateIndexRange(void)const
 {
-  if(wordGraphStates.empty())
+  if(numWgStates==0)
     return std::make_pair(INVALID_STATE,INVALID_STATE);
   else
-    return std::make_pair(INITIAL_STATE,wordGraphStates.size()-1);
+    return std::make_pair(INITIAL_STATE,numWgStates-1);
 }
 
 //---------------------------------------
@@ -185,15 +253,15 @@ std::pair<WordGraphArcId,WordGraphArcId> WordGraph::getArcIndexRange(void)const
 //---------------------------------------
 WordGraphStateData WordGraph::getWordGraphStateData(HypStateIndex hypStateIndex)const
 {  
-  if(hypStateIndex<wordGraphStates.size())
+  WordGraphStateData wordGraphStateData;
+  if(hypStateIndex<numWgStates)
   {
-    return wordGraphStates[hypStateIndex];
-  }
-  else
-  {
-    WordGraphStateData wordGraphStateData;
-    return wordGraphStateData;
+    ArcIdRange predRange=getArcIdRangeToPredStates(hypStateIndex);
+    wordGraphStateData.arcsToPredStates.assign(predRange.first,predRange.second);
+    ArcIdRange succRange=getArcIdRangeToSuccStates(hypStateIndex);
+    wordGraphStateData.arcsToSuccStates.assign(succRange.first,succRange.second);
   }
+  return wordGraphStateData;
 }
 
 //---------------------------------------
@@ -209,23 +277,51 @@ WordGraphArc WordGraph::wordGraphArcId2WordGraphArc(WordGraphArcId wordGraphArcI
     wordGraphArc.predStateIndex=INVALID_STATE;
     wordGraphArc.succStateIndex=INVALID_STATE;
     wordGraphArc.arcScore=0;
+    wordGraphArc.firstWordPos=0;
+    wordGraphArc.numWords=0;
     
     return wordGraphArc;
   }
 }
 
 //---------------------------------------
-void WordGraph::getArcsToPredStates(HypStateIndex hypStateIndex,
-                                    std::vector<WordGraphArc>& wgArcs)const
+WordGraph::ArcIdRange WordGraph::getArcIdRangeToPredStates(HypStateIndex hypStateIndex)const
 {
-  std::vector<WordGraphArcId> wgArcIds;
+  if(hypStateIndex<numWgStates)
+  {
+    buildAdjacency();
+    const WordGraphArcId* arcIdPtr=predArcIds.empty() ? NULL : &predArcIds[0];
+    return std::make_pair(arcIdPtr+predArcOffsets[hypStateIndex],
+                          arcIdPtr+predArcOffsets[hypStateIndex+1]);
+  }
+  else
+    return std::make_pair((const WordGraphArcId*)NULL,(const WordGraphArcId*)NULL);
+}
 
-  getArcIdsToPredStates(hypStateIndex,wgArcIds);
+//---------------------------------------
+WordGraph::ArcIdRange WordGraph::getArcIdRangeToSuccStates(HypStateIndex hypStateIndex)const
+{
+  if(hypStateIndex<numWgStates)
+  {
+    buildAdjacency();
+    const WordGraphArcId* arcIdPtr=succArcIds.empty() ? NULL : &succArcIds[0];
+    return std::make_pair(arcIdPtr+succArcOffsets[hypStateIndex],
+                          arcIdPtr+succArcOffsets[hypStateIndex+1]);
+  }
+  else
+    return std::make_pair((const WordGraphArcId*)NULL,(const WordGraphArcId*)NULL);
+}
 
+//---------------------------------------
+void WordGraph::getArcsToPredStates(HypStateIndex hypStateIndex,
+                                    std::vector<WordGraphArc>& wgArcs)const
+{
   wgArcs.clear();
-  for(unsigned int i=0;i<wgArcIds.size();++i)
+  ArcIdRange range=getArcIdRangeToPredStates(hypStateIndex);
+  for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
   {
-    wgArcs.push_back(wordGraphArcId2WordGraphArc(wgArcIds[i]));
+    if(!arcsPruned[*arcIdPtr])
+      wgArcs.push_back(wordGraphArcs[*arcIdPtr]);
   }  
 }
 
@@ -233,36 +329,25 @@ void WordGraph::getArcsToPredStates(HypStateIndex hypStateIndex,
 void WordGraph::getArcIdsToPredStates(HypStateIndex hypStateIndex,
                                       std::vector<WordGraphArcId>& wgArcIds)const
 {
-  if(hypStateIndex<wordGraphStates.size())
+  wgArcIds.clear();
+  ArcIdRange range=getArcIdRangeToPredStates(hypStateIndex);
+  for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
   {
-    std::vector<WordGraphArcId>::const_iterator arcIdVecIter;
-
-    wgArcIds.clear();
-        // Iterate over the arcs to predecessors
-    for(arcIdVecIter=wordGraphStates[hypStateIndex].arcsToPredStates.begin();arcIdVecIter!=wordGraphStates[hypStateIndex].arcsToPredStates.end();++arcIdVecIter)
-    {
-      if(!arcsPruned[*arcIdVecIter])
-        wgArcIds.push_back(*arcIdVecIter);
-    }
+    if(!arcsPruned[*arcIdPtr])
+      wgArcIds.push_back(*arcIdPtr);
   }
-  else
-  {
-    wgArcIds.clear();
-  }  
 }
 
 //---------------------------------------
 void WordGraph::getArcsToSuccStates(HypStateIndex hypStateIndex,
                                     std::vector<WordGraphArc>& wgArcs)const
 {
-  std::vector<WordGraphArcId> wgArcIds;
-
-  getArcIdsToSuccStates(hypStateIndex,wgArcIds);
-
   wgArcs.clear();
-  for(unsigned int i=0;i<wgArcIds.size();++i)
+  ArcIdRange range=getArcIdRangeToSuccStates(hypStateIndex);
+  for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
   {
-    wgArcs.push_back(wordGraphArcId2WordGraphArc(wgArcIds[i]));
+    if(!arcsPruned[*arcIdPtr])
+      wgArcs.push_back(wordGraphArcs[*arcIdPtr]);
   }  
 }
 
@@ -270,22 +355,55 @@ void WordGraph::getArcsToSuccStates(HypStateIndex hypStateIndex,
 void WordGraph::getArcIdsToSuccStates(HypStateIndex hypStateIndex,
                                       std::vector<WordGraphArcId>& wgArcIds)const
 {
-  if(hypStateIndex<wordGraphStates.size())
+  wgArcIds.clear();
+  ArcIdRange range=getArcIdRangeToSuccStates(hypStateIndex);
+  for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
   {
-    std::vector<WordGraphArcId>::const_iterator arcIdVecIter;
+    if(!arcsPruned[*arcIdPtr])
+      wgArcIds.push_back(*arcIdPtr);
+  }
+}
 
-    wgArcIds.clear();
-        // Iterate over the arcs to succesors
-    for(arcIdVecIter=wordGraphStates[hypStateIndex].arcsToSuccStates.begin();arcIdVecIter!=wordGraphStates[hypStateIndex].arcsToSuccStates.end();++arcIdVecIter)
-    {
-      if(!arcsPruned[*arcIdVecIter])
-        wgArcIds.push_back(*arcIdVecIter);
-    }
+//---------------------------------------
+void WordGraph::buildAdjacency(void)const
+{
+  if(!adjacencyBuilt)
+  {
+    buildAdjacencyArrays(true,predArcOffsets,predArcIds);
+    buildAdjacencyArrays(false,succArcOffsets,succArcIds);
+    adjacencyBuilt=true;
   }
-  else
+}
+
+//---------------------------------------
+void WordGraph::buildAdjacencyArrays(bool pred,
+                                     std::vector<unsigned int>& offsets,
+                                     std::vector<WordGraphArcId>& arcIds)const
+{
+      // Count the arcs of each state
+  offsets.clear();
+  offsets.resize(numWgStates+1,0);
+  for(WordGraphArcId wgArcId=0;wgArcId<wordGraphArcs.size();++wgArcId)
+  {
+    const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
+    HypStateIndex idx=pred ? wgArc.succStateIndex : wgArc.predStateIndex;
+    ++offsets[idx+1];
+  }
+
+      // Obtain offsets from counts
+  for(unsigned int i=1;i<offsets.size();++i)
+    offsets[i]+=offsets[i-1];
+
+      // Store arc identifiers, the arcs are visited in insertion order
+  std::vector<unsigned int> nextPos(offsets.begin(),offsets.end()-1);
+  arcIds.resize(wordGraphArcs.size());
+  for(WordGraphArcId wgArcId=0;wgArcId<wordGraphArcs.size();++wgArcId)
   {
-    wgArcIds.clear();
-  }    
+    const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
+    HypStateIndex idx=pred ? wgArc.succStateIndex : wgArc.predStateIndex;
+    arcIds[nextPos[idx]]=wgArcId;
+    ++nextPos[idx];
+  }
 }
 
 //---------------------------------------
@@ -307,6 +425,55 @@ bool WordGraph::stateIsFinal(HypStateIndex hypStateIndex)const
     return true;
 }
 
+//---------------------------------------
+const std::string& WordGraph::getArcWord(const WordGraphArc& wgArc,
+                                         unsigned int k)const
+{
+  return idxToStrVocab[arcWordIdxVec[wgArc.firstWordPos+k]];
+}
+
+//---------------------------------------
+WordIndex WordGraph::getArcWordIndex(const WordGraphArc& wgArc,
+                                     unsigned int k)const
+{
+  return arcWordIdxVec[wgArc.firstWordPos+k];
+}
+
+//---------------------------------------
+void WordGraph::getArcWords(const WordGraphArc& wgArc,
+                            std::vector<std::string>& words)const
+{
+  words.clear();
+  for(unsigned int k=0;k<wgArc.numWords;++k)
+    words.push_back(getArcWord(wgArc,k));
+}
+
+//---------------------------------------
+size_t WordGraph::getVocabSize(void)const
+{
+  return idxToStrVocab.size();
+}
+
+//---------------------------------------
+const std::string& WordGraph::wordIndexToString(WordIndex w)const
+{
+  return idxToStrVocab[w];
+}
+
+//---------------------------------------
+bool WordGraph::existString(const std::string& word,
+                            WordIndex& w)const
+{
+  StrToIdxVocab::const_iterator iter=strToIdxVocab.find(word);
+  if(iter!=strToIdxVocab.end())
+  {
+    w=iter->second;
+    return true;
+  }
+  else
+    return false;
+}
+
 //---------------------------------------
 unsigned int WordGraph::getNumberOfPrunedAndNonPrunedArcs(void)const
 {
@@ -408,7 +575,7 @@ void WordGraph::obtainNbSearchHeurInfo(std::vector<Score>& heurForEachState)
       // Clear vector
   heurForEachState.clear();
       // Initialize costs
-  heurForEachState.insert(heurForEachState.begin(),wordGraphStates.size(),SMALL_SCORE);
+  heurForEachState.insert(heurForEachState.begin(),numWgStates,SMALL_SCORE);
       // Set zero cost for final states
   FinalStateSet::const_iterator iter;
   for(iter=finalStateSet.begin();iter!=finalStateSet.end();++iter)
@@ -423,7 +590,7 @@ void WordGraph::obtainNbSearchHeurInfo(std::vector<Score>& heurForEachState)
       WordGraphArcId reverseWgArcId=wordGraphArcs.size()-wgArcId-1;
       if(!arcPruned(reverseWgArcId))
       {
-        WordGraphArc wgArc=wordGraphArcId2WordGraphArc(reverseWgArcId);
+        const WordGraphArc& wgArc=wordGraphArcs[reverseWgArcId];
         Score scr=wgArc.arcScore+heurForEachState[wgArc.succStateIndex];
         if(heurForEachState[wgArc.predStateIndex]<scr)
           heurForEachState[wgArc.predStateIndex]=scr;
@@ -482,10 +649,7 @@ void WordGraph::nbSearch(unsigned int len,
         if(scrHypPair.second.empty())
           lastHypStateIndex=INITIAL_STATE;
         else
-        {
-          WordGraphArc wgArc=wordGraphArcId2WordGraphArc(scrHypPair.second.back());
-          lastHypStateIndex=wgArc.succStateIndex;
-        }
+          lastHypStateIndex=wordGraphArcs[scrHypPair.second.back()].succStateIndex;
         
             // Subtract heuristic
         scrHypPair.first-=heurForEachState[lastHypStateIndex];
@@ -509,25 +673,19 @@ void WordGraph::nbSearch(unsigned int len,
             std::cerr<<"- Expanding top of the stack..."<<std::endl;
 
             // Expand hypothesis
-          std::vector<WordGraphArcId> wgArcIds;
-          getArcIdsToSuccStates(lastHypStateIndex,wgArcIds);
-
-          std::vector<std::pair<Score,NbSearchHyp> > scrHypPairVec;
-          for(unsigned int i=0;i<wgArcIds.size();++i)
+          ArcIdRange range=getArcIdRangeToSuccStates(lastHypStateIndex);
+          for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
           {
-            if(!arcPruned(wgArcIds[i]))
+            if(!arcPruned(*arcIdPtr))
             {
-              WordGraphArc wgArc=wordGraphArcId2WordGraphArc(wgArcIds[i]);
-              std::pair<Score,NbSearchHyp> newScrHypPair;
-              newScrHypPair=scrHypPair;
-                  // Obtain new score
-              newScrHypPair.first+=wgArc.arcScore;
-                  // Add heuristic
-              newScrHypPair.first+=heurForEachState[wgArc.succStateIndex];   
+              const WordGraphArc& wgArc=wordGraphArcs[*arcIdPtr];
+              NbSearchHyp newHyp=scrHypPair.second;
+                  // Obtain new score and add heuristic
+              Score newScore=scrHypPair.first+wgArc.arcScore+heurForEachState[wgArc.succStateIndex];
                   // Add new arc
-              newScrHypPair.second.push_back(wgArcIds[i]);
-                  // Push into vector
-              scrHypPairVec.push_back(newScrHypPair);
+              newHyp.push_back(*arcIdPtr);
+                  // Push into the stack
+              nbSearchStack.push(newScore,newHyp);
 
               if(verbosity>=1)
               {
@@ -535,12 +693,6 @@ void WordGraph::nbSearch(unsigned int len,
               }
             }
           }
-          
-            // Push results into the stack
-          for(unsigned int i=0;i<scrHypPairVec.size();++i)
-          {
-            nbSearchStack.push(scrHypPairVec[i].first,scrHypPairVec[i].second);
-          }
         }
       }
       else
@@ -584,8 +736,7 @@ void WordGraph::nbSearch(unsigned int len,
       std::cerr<<scrHypPair.first<<" ||| "<<translation<<" |||";
       for(unsigned int j=0;j<scrHypPair.second.size();++j)
       {
-        WordGraphArc wgArc=wordGraphArcId2WordGraphArc(scrHypPair.second[j]);
-        HypStateIndex hidx=wgArc.succStateIndex;
+        HypStateIndex hidx=wordGraphArcs[scrHypPair.second[j]].succStateIndex;
         std::cerr<<" "<<hidx;
       }
       std::cerr<<std::endl;
@@ -599,8 +750,7 @@ bool WordGraph::hypIsComplete(const NbSearchHyp& nbSearchHyp)
   if(nbSearchHyp.empty()) return false;
   else
   {
-    WordGraphArc wgArc=wordGraphArcId2WordGraphArc(nbSearchHyp.back());
-    HypStateIndex hidx=wgArc.succStateIndex;
+    HypStateIndex hidx=wordGraphArcs[nbSearchHyp.back()].succStateIndex;
     if(stateIsFinal(hidx))
       return true;
     else
@@ -610,23 +760,23 @@ bool WordGraph::hypIsComplete(const NbSearchHyp& nbSearchHyp)
 
 //---------------------------------------
 std::string WordGraph::stringAssociatedToHyp(const NbSearchHyp& nbSearchHyp,
-                                             std::vector<Score>& scoreComps)
+                                             std::vector<Score>& scoreComps)const
 {
   std::string str;
   for(unsigned int i=0;i<nbSearchHyp.size();++i)
   {
     WordGraphArcId wgArcId=nbSearchHyp[i];
-    WordGraphArc wgArc=wordGraphArcId2WordGraphArc(wgArcId);
+    const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
 
         // Add words to str
     if(i!=0)
-      str=str+" ";
+      str+=" ";
     
-    for(unsigned int k=0;k<wgArc.words.size();++k)
+    for(unsigned int k=0;k<wgArc.numWords;++k)
     {
-      str=str+wgArc.words[k];
-      if(k!=wgArc.words.size()-1)
-        str=str+" ";
+      str+=getArcWord(wgArc,k);
+      if(k!=wgArc.numWords-1)
+        str+=" ";
     }
 
         // Sum score components
@@ -654,18 +804,22 @@ void WordGraph::obtainWgComposedOfUsefulStates(void)
     std::map<HypStateIndex,HypStateIndex> remappedStates;
     obtainUsefulStates(stateIsUsefulVec,remappedStates);
 
-        // Save current arc information
-    WordGraphArcs wordGraphArcsAux=wordGraphArcs;
-    FinalStateSet finalStateSetAux=finalStateSet;
-    std::vector<bool> arcsPrunedAux=arcsPruned;
-    std::vector<std::vector<Score> > scrCompsVecAux=scrCompsVec;
+        // Save current arc information (the vocabulary does not
+        // change)
+    WordGraphArcs wordGraphArcsAux;
+    wordGraphArcsAux.swap(wordGraphArcs);
+    FinalStateSet finalStateSetAux;
+    finalStateSetAux.swap(finalStateSet);
+    std::vector<bool> arcsPrunedAux;
+    arcsPrunedAux.swap(arcsPruned);
+    std::vector<std::vector<Score> > scrCompsVecAux;
+    scrCompsVecAux.swap(scrCompsVec);
+    std::vector<WordIndex> arcWordIdxVecAux;
+    arcWordIdxVecAux.swap(arcWordIdxVec);
     
         // Clear information subject to change
-    wordGraphArcs.clear();
-    arcsPruned.clear();
-    wordGraphStates.clear();
-    finalStateSet.clear();
-    scrCompsVec.clear();
+    numWgStates=0;
+    adjacencyBuilt=false;
 
         // Regenerate final states
     FinalStateSet::iterator iter;
@@ -686,8 +840,7 @@ void WordGraph::obtainWgComposedOfUsefulStates(void)
       if(!arcsPrunedAux[arcid])
       {
             // Obtain wordgraph arc information
-        WordGraphArc wgArc=wordGraphArcsAux[arcid];
-        std::vector<Score> scrVec=scrCompsVecAux[arcid];
+        const WordGraphArc& wgArc=wordGraphArcsAux[arcid];
         
             // Check if arc connects two useful states
         if(stateIsUsefulVec[wgArc.predStateIndex] && stateIsUsefulVec[wgArc.succStateIndex])
@@ -702,11 +855,12 @@ void WordGraph::obtainWgComposedOfUsefulStates(void)
           HypStateIndex newSuccStateIndex=iter->second;
 
               // Insert arc
-          addArcWithScrComps(newPredStateIndex,
-                             newSuccStateIndex,
-                             wgArc.words,
-                             wgArc.arcScore,
-                             scrVec);
+          addArcWordIdx(newPredStateIndex,
+                        newSuccStateIndex,
+                        wgArc.numWords==0 ? NULL : &arcWordIdxVecAux[wgArc.firstWordPos],
+                        wgArc.numWords,
+                        wgArc.arcScore);
+          scrCompsVec.back().swap(scrCompsVecAux[arcid]);
         }
       }
     }
@@ -717,52 +871,42 @@ void WordGraph::obtainWgComposedOfUsefulStates(void)
 void WordGraph::orderArcsTopol(void)
 {
       // Define auxiliary variables
-  WordGraphArcs wordGraphArcsAux;
+  std::vector<WordGraphArcId> newArcOrder;
 
   std::vector<bool> arcAdded;
   arcAdded.insert(arcAdded.begin(),wordGraphArcs.size(),false);
   
   std::vector<bool> stateClosed;
-  stateClosed.insert(stateClosed.begin(),wordGraphStates.size(),false);
+  stateClosed.insert(stateClosed.begin(),numWgStates,false);
   
       // Repeat until all arcs has been reintroduced
-  while(wordGraphArcsAux.size()<wordGraphArcs.size())
+  while(newArcOrder.size()<wordGraphArcs.size())
   {
     unsigned int atLeastOneArcAdded=false;
 
-    std::pair<WordGraphArcId,WordGraphArcId> wgArcIdPair=getArcIndexRange();
-
-    for(WordGraphArcId wgArcId=wgArcIdPair.first;wgArcId<=wgArcIdPair.second;++wgArcId)
+    for(WordGraphArcId wgArcId=0;wgArcId<wordGraphArcs.size();++wgArcId)
     {
           // Check if arc has already been added
       if(!arcAdded[wgArcId])
       {
             // Obtain arc info
-        WordGraphArc wgArc=wordGraphArcId2WordGraphArc(wgArcId);
+        const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
 
             // Obtain predecessors of predecessor node
-        std::vector<WordGraphArcId> wgArcIds;
-        getArcIdsToPredStates(wgArc.predStateIndex,wgArcIds);
+        ArcIdRange range=getArcIdRangeToPredStates(wgArc.predStateIndex);
 
-            // Check if all precessor states are closed
+            // Check if all precessor states are closed and all
+            // precessor arcs have been added
         bool allPredStatesClosed=true;
-        for(unsigned int i=0;i<wgArcIds.size();++i)
-        {
-          WordGraphArc wgArcAux=wordGraphArcId2WordGraphArc(wgArcIds[i]);
-          if(!stateClosed[wgArcAux.predStateIndex])
-          {
-            allPredStatesClosed=false;
-            break;
-          }
-        }
-            // Check if all precessor arcs have been added
         bool allPredArcsAdded=true;
-        for(unsigned int i=0;i<wgArcIds.size();++i)
+        for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
         {
-          if(!arcAdded[wgArcIds[i]])
+          if(!arcPruned(*arcIdPtr))
           {
-            allPredArcsAdded=false;
-            break;
+            if(!stateClosed[wordGraphArcs[*arcIdPtr].predStateIndex])
+              allPredStatesClosed=false;
+            if(!arcAdded[*arcIdPtr])
+              allPredArcsAdded=false;
           }
         }
             // If all predecessor states are closed, add arc and close
@@ -772,7 +916,7 @@ void WordGraph::orderArcsTopol(void)
               // Update atLeastOneArcAdded flag
           atLeastOneArcAdded=true;
               // Add arc
-          wordGraphArcsAux.push_back(wgArc);
+          newArcOrder.push_back(wgArcId);
               // Mark arc as added
           arcAdded[wgArcId]=true;
               // Close state
@@ -790,17 +934,29 @@ void WordGraph::orderArcsTopol(void)
     }
   }
       // Check if new arc ordering has been successfully obtained
-  if(wordGraphArcsAux.size()==wordGraphArcs.size())
+  if(newArcOrder.size()==wordGraphArcs.size())
   {
-        // Replace wordGraphArcs with wordGraphArcsAux
-    wordGraphArcs=wordGraphArcsAux;
+        // Reorder arcs and the information associated to them (words
+        // are not moved, since arcs store their position)
+    WordGraphArcs wordGraphArcsAux;
+    std::vector<bool> arcsPrunedAux;
+    std::vector<std::vector<Score> > scrCompsVecAux(newArcOrder.size());
+    for(unsigned int i=0;i<newArcOrder.size();++i)
+    {
+      wordGraphArcsAux.push_back(wordGraphArcs[newArcOrder[i]]);
+      arcsPrunedAux.push_back(arcsPruned[newArcOrder[i]]);
+      scrCompsVecAux[i].swap(scrCompsVec[newArcOrder[i]]);
+    }
+    wordGraphArcs.swap(wordGraphArcsAux);
+    arcsPruned.swap(arcsPrunedAux);
+    scrCompsVec.swap(scrCompsVecAux);
+    adjacencyBuilt=false;
   }
-
 }
 
 //---------------------------------------
 void WordGraph::calcPrevScores(HypStateIndex hypStateIndex,
-                               const std::set<WordGraphArcId>& excludedArcs,
+                               const std::vector<bool>& excludedArcs,
                                std::vector<Score>& prevScores,
                                std::vector<WordGraphArc>& bestPredArcForStateVec)const
 {
@@ -816,7 +972,7 @@ void WordGraph::calcPrevScores(HypStateIndex hypStateIndex,
 
 //---------------------------------------
 void WordGraph::calcPrevScoresWeights(HypStateIndex hypStateIndex,
-                                     const std::set<WordGraphArcId>& excludedArcs,
+                                     const std::vector<bool>& excludedArcs,
                                      const std::vector<float>& altCompWeights,
                                      std::vector<Score>& prevScores,
                                      std::vector<WordGraphArc>& bestPredArcForStateVec)const
@@ -840,11 +996,11 @@ void WordGraph::calcPrevScoresWeights(HypStateIndex hypStateIndex,
 
         // Make room for vectors
     prevScores.clear();
-    prevScores.insert(prevScores.begin(),wordGraphStates.size()-INITIAL_STATE,SMALL_SCORE);
+    prevScores.insert(prevScores.begin(),numWgStates-INITIAL_STATE,SMALL_SCORE);
 
-    WordGraphArc wgArc;
+    WordGraphArc wgArc=wordGraphArcId2WordGraphArc(INVALID_ARCID);
     bestPredArcForStateVec.clear();
-    bestPredArcForStateVec.insert(bestPredArcForStateVec.begin(),wordGraphStates.size()-INITIAL_STATE,wgArc);
+    bestPredArcForStateVec.insert(bestPredArcForStateVec.begin(),numWgStates-INITIAL_STATE,wgArc);
 
         // Set previous score for the initial state
     if(hypStateIndex==INITIAL_STATE)
@@ -854,7 +1010,7 @@ void WordGraph::calcPrevScoresWeights(HypStateIndex hypStateIndex,
 
         // Initialize boolean vector of accessible states
     std::vector<bool> accessibleStateVec;
-    accessibleStateVec.insert(accessibleStateVec.begin(),wordGraphStates.size()-INITIAL_STATE,false);
+    accessibleStateVec.insert(accessibleStateVec.begin(),numWgStates-INITIAL_STATE,false);
     accessibleStateVec[hypStateIndex]=true;
   
         // Iteration over the arcs (arcs are assumed to be topologically
@@ -866,7 +1022,7 @@ void WordGraph::calcPrevScoresWeights(HypStateIndex hypStateIndex,
           // Check if arc has not been pruned
       if(!arcPruned(wgArcId))
       {
-        WordGraphArc wordGraphArc=wordGraphArcId2WordGraphArc(wgArcId);
+        const WordGraphArc& wordGraphArc=wordGraphArcs[wgArcId];
 
             // Check if wordGraphArc.predStateIndex is accessible
         if(accessibleStateVec[wordGraphArc.predStateIndex])
@@ -883,15 +1039,8 @@ void WordGraph::calcPrevScoresWeights(HypStateIndex hypStateIndex,
         
               // Update score
           Score score=arcScore+prevScores[wordGraphArc.predStateIndex];
-          if(!excludedArcs.empty())
-          {
-                // If predecessor state is the initial state, check that the
-                // first word is not contained in the set of rejected words
-            std::set<WordGraphArcId>::const_iterator wgArcIdSetIter;
-            wgArcIdSetIter=excludedArcs.find(wgArcId);
-            if(wgArcIdSetIter!=excludedArcs.end())
-              score=SMALL_SCORE;
-          }
+          if(wgArcId<excludedArcs.size() && excludedArcs[wgArcId])
+            score=SMALL_SCORE;
         
           if(score<SMALL_SCORE) score=SMALL_SCORE;
           if(score>prevScores[wordGraphArc.succStateIndex])
@@ -944,7 +1093,7 @@ void WordGraph::calcRestScores(std::vector<Score>& restScores)const
 {
       // Make room for vector
   restScores.clear();
-  restScores.insert(restScores.begin(),wordGraphStates.size(),SMALL_SCORE);
+  restScores.insert(restScores.begin(),numWgStates,SMALL_SCORE);
   
       // Update rest scores for final states
   FinalStateSet::const_iterator finalStateSetIter;  
@@ -961,7 +1110,7 @@ void WordGraph::calcRestScores(std::vector<Score>& restScores)const
         // Check if arc has not been pruned
     if(!arcPruned(r))
     {
-      WordGraphArc wordGraphArc=wordGraphArcs[r];
+      const WordGraphArc& wordGraphArc=wordGraphArcs[r];
     
       Score score=wordGraphArc.arcScore+restScores[wordGraphArc.succStateIndex];
       if(score<SMALL_SCORE) score=SMALL_SCORE;
@@ -973,7 +1122,7 @@ void WordGraph::calcRestScores(std::vector<Score>& restScores)const
 
 //---------------------------------------
 Score WordGraph::bestPathFromFinalStateToIdx(HypStateIndex hypStateIndex,
-                                             const std::set<WordGraphArcId>& excludedArcs,
+                                             const std::vector<bool>& excludedArcs,
                                              std::vector<WordGraphArc>& arcVec)const
 {
   std::vector<float> altCompWeights;
@@ -986,7 +1135,7 @@ Score WordGraph::bestPathFromFinalStateToIdx(HypStateIndex hypStateIndex,
 
 //---------------------------------------
 Score WordGraph::bestPathFromFinalStateToIdxWeights(HypStateIndex hypStateIndex,
-                                                    const std::set<WordGraphArcId>& excludedArcs,
+                                                    const std::vector<bool>& excludedArcs,
                                                     const std::vector<float>& altCompWeights,
                                                     std::vector<WordGraphArc>& arcVec)const
 {
@@ -1066,11 +1215,11 @@ unsigned int WordGraph::pruneArcsToPredStates(float threshold)
   calcRestScores(restScores);
   
       // Calculate previous scores
-  std::set<WordGraphArcId> emptyWgArcIdSet;
+  std::vector<bool> noExcludedArcs;
   std::vector<Score> prevScores;
   std::vector<WordGraphArc> bestPredArcForStateVec;
   calcPrevScores(INITIAL_STATE,
-                 emptyWgArcIdSet,
+                 noExcludedArcs,
                  prevScores,
                  bestPredArcForStateVec);
 
@@ -1087,16 +1236,14 @@ unsigned int WordGraph::pruneArcsToPredStates(float threshold)
   unsigned int numPrunedArcs=0;
   
       // Explore nodes
-  for(HypStateIndex hidx=0;hidx<wordGraphStates.size();++hidx)  
+  for(HypStateIndex hidx=0;hidx<numWgStates;++hidx)  
   {
-    std::vector<std::pair<Score,WordGraphArcId> > scoreArcIdVec;
-    
         // Iterate over the arcs to predecessors
-    std::vector<WordGraphArcId>::iterator arcIdVecIter;
-    for(arcIdVecIter=wordGraphStates[hidx].arcsToPredStates.begin();arcIdVecIter!=wordGraphStates[hidx].arcsToPredStates.end();++arcIdVecIter)
+    ArcIdRange range=getArcIdRangeToPredStates(hidx);
+    for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
     {
           // Extract relevant arc information
-      WordGraphArcId wordGraphArcId=*arcIdVecIter;
+      WordGraphArcId wordGraphArcId=*arcIdPtr;
       HypStateIndex predStateIndex=wordGraphArcs[wordGraphArcId].predStateIndex;
       HypStateIndex succStateIndex=wordGraphArcs[wordGraphArcId].succStateIndex;
       Score arcScore=wordGraphArcs[wordGraphArcId].arcScore;
@@ -1123,14 +1270,13 @@ unsigned int WordGraph::pruneArcsToPredStates(float threshold)
 bool WordGraph::finalStatePruned(HypStateIndex hypStateIndex)const
 {
       // Obtain arcs to predecessors for final state
-  std::vector<WordGraphArcId> wgArcIds;
-  getArcIdsToPredStates(hypStateIndex,wgArcIds);
+  ArcIdRange range=getArcIdRangeToPredStates(hypStateIndex);
 
       // Verify if there is at least one arc that has not been pruned
   bool finalStatePrunedBool=true;
-  for(unsigned int i=0;i<wgArcIds.size();++i)
+  for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
   {
-    if(!arcPruned(wgArcIds[i]))
+    if(!arcPruned(*arcIdPtr))
     {
       finalStatePrunedBool=false;
       break;
@@ -1145,8 +1291,7 @@ void WordGraph::obtainStatesReachableFromInit(std::vector<bool>& stateReachableF
 {
       // Initialize stateReachableFromInitVec variable
   stateReachableFromInitVec.clear();
-  for(unsigned int i=0;i<wordGraphStates.size();++i)
-    stateReachableFromInitVec.push_back(false);
+  stateReachableFromInitVec.resize(numWgStates,false);
   if(INITIAL_STATE<stateReachableFromInitVec.size())
     stateReachableFromInitVec[INITIAL_STATE]=true;
       // Direct iteration over the arcs (arcs are assumed to be
@@ -1155,7 +1300,7 @@ void WordGraph::obtainStatesReachableFromInit(std::vector<bool>& stateReachableF
   {
     if(!arcPruned(wgArcId))
     {
-      WordGraphArc wgArc=wordGraphArcId2WordGraphArc(wgArcId);
+      const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
       if(stateReachableFromInitVec[wgArc.predStateIndex])
         stateReachableFromInitVec[wgArc.succStateIndex]=true;
     }
@@ -1168,8 +1313,7 @@ void WordGraph::obtainUsefulStates(std::vector<bool>& stateIsUsefulVec,
 {  
       // Initialize vector
   stateIsUsefulVec.clear();
-  for(unsigned int i=0;i<wordGraphStates.size();++i)
-    stateIsUsefulVec.push_back(false);
+  stateIsUsefulVec.resize(numWgStates,false);
 
       // Set vector values for final states
   FinalStateSet::const_iterator fssIter;
@@ -1178,13 +1322,12 @@ void WordGraph::obtainUsefulStates(std::vector<bool>& stateIsUsefulVec,
     bool atLeastOneArcArrivesToState=false;
     
         // Obtain arcs to final state
-    std::vector<WordGraphArcId> wgArcIds;
-    getArcIdsToPredStates(*fssIter,wgArcIds);
+    ArcIdRange range=getArcIdRangeToPredStates(*fssIter);
 
         // Check if there is at least one not pruned arc
-    for(unsigned int j=0;j<wgArcIds.size();++j)
+    for(const WordGraphArcId* arcIdPtr=range.first;arcIdPtr!=range.second;++arcIdPtr)
     {
-      if(!arcPruned(wgArcIds[j]))
+      if(!arcPruned(*arcIdPtr))
       {
         atLeastOneArcArrivesToState=true;
         break;
@@ -1207,7 +1350,7 @@ void WordGraph::obtainUsefulStates(std::vector<bool>& stateIsUsefulVec,
     WordGraphArcId reverseWgArcId=wordGraphArcs.size()-wgArcId-1;
     if(!arcPruned(reverseWgArcId))
     {
-      WordGraphArc wgArc=wordGraphArcId2WordGraphArc(reverseWgArcId);
+      const WordGraphArc& wgArc=wordGraphArcs[reverseWgArcId];
       if(stateReachableFromInitVec[wgArc.predStateIndex] && stateIsUsefulVec[wgArc.succStateIndex])
         stateIsUsefulVec[wgArc.predStateIndex]=true;
     }
@@ -1234,6 +1377,28 @@ void WordGraph::obtainUsefulStates(std::vector<bool>& stateIsUsefulVec,
 
 //---------------------------------------
 bool WordGraph::load(const char * filename)
+{
+  if(isBinWordGraphFile(filename))
+    return loadBin(filename);
+  else
+    return loadText(filename);
+}
+
+//---------------------------------------
+bool WordGraph::isBinWordGraphFile(const char * filename)
+{
+  std::ifstream inF(filename,std::ios::in | std::ios::binary);
+  if(!inF)
+    return false;
+
+  char magic[8];
+  if(!inF.read(magic,sizeof(magic)))
+    return false;
+  return memcmp(magic,WORD_GRAPH_BIN_MAGIC,sizeof(magic))==0;
+}
+
+//---------------------------------------
+bool WordGraph::loadText(const char * filename)
 {
   AwkInputStream awk;
   
@@ -1325,6 +1490,110 @@ bool WordGraph::load(const char * filename)
   }
 }
 
+//---------------------------------------
+bool WordGraph::loadBin(const char * filename)
+{
+  std::ifstream inF(filename,std::ios::in | std::ios::binary);
+  if(!inF)
+  {
+    std::cerr<<"Error while opening word graph file: "<<filename<<"\n";
+    return THOT_ERROR;
+  }
+
+  std::cerr<<"Reading binary word graph from file: "<<filename<<"\n";
+
+      // Clear word graph
+  clear();
+
+      // Read header
+  char magic[8];
+  uint32_t version;
+  if(!inF.read(magic,sizeof(magic)) || !readUInt(inF,version) ||
+     memcmp(magic,WORD_GRAPH_BIN_MAGIC,sizeof(magic))!=0 || version!=WORD_GRAPH_BIN_VERSION)
+  {
+    std::cerr<<"Error: file "<<filename<<" does not contain a binary word graph of version "<<WORD_GRAPH_BIN_VERSION<<"\n";
+    return THOT_ERROR;
+  }
+
+      // Read component weights and initial state score
+  uint32_t n;
+  bool ok=readUInt(inF,n);
+  for(uint32_t i=0;ok && i<n;++i)
+  {
+    std::pair<std::string,float> compWeight;
+    ok=readString(inF,compWeight.first) && inF.read((char*)&compWeight.second,sizeof(float));
+    compWeights.push_back(compWeight);
+  }
+  double scr;
+  ok=ok && readDouble(inF,scr);
+  initialStateScore=scr;
+
+      // Read final states
+  ok=ok && readUInt(inF,n);
+  for(uint32_t i=0;ok && i<n;++i)
+  {
+    uint32_t finalState;
+    ok=readUInt(inF,finalState);
+    finalStateSet.insert(finalState);
+  }
+
+      // Read vocabulary
+  ok=ok && readUInt(inF,n);
+  for(uint32_t i=0;ok && i<n;++i)
+  {
+    std::string word;
+    ok=readString(inF,word);
+    idxToStrVocab.push_back(word);
+    strToIdxVocab.insert(std::make_pair(word,(WordIndex)i));
+  }
+
+      // Read arcs
+  uint32_t numArcsInFile;
+  ok=ok && readUInt(inF,numArcsInFile);
+  std::vector<WordIndex> wordIdxs;
+  for(uint32_t a=0;ok && a<numArcsInFile;++a)
+  {
+    uint32_t predStateIndex;
+    uint32_t succStateIndex;
+    uint32_t numScrComps;
+    uint32_t numWords;
+    ok=readUInt(inF,predStateIndex) && readUInt(inF,succStateIndex) &&
+      readDouble(inF,scr) && readUInt(inF,numScrComps);
+    std::vector<Score> scrVec;
+    for(uint32_t i=0;ok && i<numScrComps;++i)
+    {
+      double comp;
+      ok=readDouble(inF,comp);
+      scrVec.push_back(comp);
+    }
+    ok=ok && readUInt(inF,numWords);
+    wordIdxs.clear();
+    for(uint32_t i=0;ok && i<numWords;++i)
+    {
+      uint32_t w;
+      ok=readUInt(inF,w) && w<idxToStrVocab.size();
+      wordIdxs.push_back(w);
+    }
+    if(ok)
+    {
+      addArcWordIdx(predStateIndex,
+                    succStateIndex,
+                    wordIdxs.empty() ? NULL : &wordIdxs[0],
+                    wordIdxs.size(),
+                    scr);
+      scrCompsVec.back().swap(scrVec);
+    }
+  }
+
+  if(!ok)
+  {
+    std::cerr<<"Error: binary word graph file "<<filename<<" is truncated or corrupted\n";
+    clear();
+    return THOT_ERROR;
+  }
+  return THOT_OK;
+}
+
 //---------------------------------------
 bool WordGraph::print(const char* filename,
                       bool printOnlyUsefulStates/*=false*/)const
@@ -1389,7 +1658,7 @@ void WordGraph::print(std::ostream &outS,
     
     if( (!printOnlyUsefulStates || arcIsUseful) && !arcsPruned[i])
     {
-      WordGraphArc wordGraphArc=wordGraphArcs[i];
+      const WordGraphArc& wordGraphArc=wordGraphArcs[i];
 
           //Print indices
       outS<<wordGraphArc.predStateIndex<<" "<<wordGraphArc.succStateIndex<<" "<<wordGraphArc.arcScore<<" ";
@@ -1405,16 +1674,99 @@ void WordGraph::print(std::ostream &outS,
         outS<<"||| ";
       }
       
-      for(unsigned int i=0;i<wordGraphArc.words.size();++i)
+      for(unsigned int i=0;i<wordGraphArc.numWords;++i)
       {
-        outS<<wordGraphArc.words[i];
-        if(i<wordGraphArc.words.size()-1) outS<<" ";
+        outS<<getArcWord(wordGraphArc,i);
+        if(i<wordGraphArc.numWords-1) outS<<" ";
       }
       outS<<std::endl;
     }
   }
 }
 
+//---------------------------------------
+bool WordGraph::printBin(const char* filename,
+                         bool printOnlyUsefulStates/*=false*/)const
+{
+  std::ofstream outF(filename,std::ios::out | std::ios::trunc | std::ios::binary);
+  if(!outF)
+  {
+    std::cerr<<"Error while printing binary word graph to file."<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Print header
+  char magic[8];
+  memcpy(magic,WORD_GRAPH_BIN_MAGIC,sizeof(magic));
+  outF.write(magic,sizeof(magic));
+  writeUInt(outF,WORD_GRAPH_BIN_VERSION);
+
+      // Print component weights and initial state score
+  writeUInt(outF,compWeights.size());
+  for(unsigned int i=0;i<compWeights.size();++i)
+  {
+    writeString(outF,compWeights[i].first);
+    outF.write((const char*)&compWeights[i].second,sizeof(float));
+  }
+  writeDouble(outF,initialStateScore);
+
+      // Print final states
+  std::vector<HypStateIndex> finalStates;
+  FinalStateSet::const_iterator finalStateSetIter;
+  for(finalStateSetIter=finalStateSet.begin();finalStateSetIter!=finalStateSet.end();++finalStateSetIter)
+  {
+    if(!finalStatePruned(*finalStateSetIter))
+      finalStates.push_back(*finalStateSetIter);
+  }
+  writeUInt(outF,finalStates.size());
+  for(unsigned int i=0;i<finalStates.size();++i)
+    writeUInt(outF,finalStates[i]);
+
+      // Print vocabulary
+  writeUInt(outF,idxToStrVocab.size());
+  for(unsigned int i=0;i<idxToStrVocab.size();++i)
+    writeString(outF,idxToStrVocab[i]);
+
+      // Obtain arcs to be printed (see print() function)
+  std::vector<bool> stateIsUsefulVec;
+  std::map<HypStateIndex,HypStateIndex> remappedStates;
+  if(printOnlyUsefulStates)
+    obtainUsefulStates(stateIsUsefulVec,remappedStates);
+  std::vector<WordGraphArcId> arcIds;
+  for(WordGraphArcId wgArcId=0;wgArcId<wordGraphArcs.size();++wgArcId)
+  {
+    const WordGraphArc& wgArc=wordGraphArcs[wgArcId];
+    bool arcIsUseful=!printOnlyUsefulStates ||
+      (stateIsUsefulVec[wgArc.predStateIndex] && stateIsUsefulVec[wgArc.succStateIndex]);
+    if(arcIsUseful && !arcsPruned[wgArcId])
+      arcIds.push_back(wgArcId);
+  }
+
+      // Print arcs
+  writeUInt(outF,arcIds.size());
+  for(unsigned int i=0;i<arcIds.size();++i)
+  {
+    const WordGraphArc& wgArc=wordGraphArcs[arcIds[i]];
+    writeUInt(outF,wgArc.predStateIndex);
+    writeUInt(outF,wgArc.succStateIndex);
+    writeDouble(outF,wgArc.arcScore);
+    const std::vector<Score>& scrVec=scrCompsVec[arcIds[i]];
+    writeUInt(outF,scrVec.size());
+    for(unsigned int j=0;j<scrVec.size();++j)
+      writeDouble(outF,scrVec[j]);
+    writeUInt(outF,wgArc.numWords);
+    for(unsigned int k=0;k<wgArc.numWords;++k)
+      writeUInt(outF,getArcWordIndex(wgArc,k));
+  }
+
+  if(!outF)
+  {
+    std::cerr<<"Error while printing binary word graph to file."<<std::endl;
+    return THOT_ERROR;
+  }
+  return THOT_OK;
+}
+
 //---------------------------------------
 bool WordGraph::empty(void)const
 {
@@ -1430,7 +1782,7 @@ size_t WordGraph::numArcs(void)const
 //---------------------------------------
 size_t WordGraph::numStates(void)const
 {
-  return wordGraphStates.size();  
+  return numWgStates;
 }
 
 //---------------------------------------
@@ -1438,7 +1790,15 @@ void WordGraph::clear(void)
 {
   wordGraphArcs.clear();
   arcsPruned.clear();
-  wordGraphStates.clear();
+  arcWordIdxVec.clear();
+  idxToStrVocab.clear();
+  strToIdxVocab.clear();
+  numWgStates=0;
+  predArcOffsets.clear();
+  predArcIds.clear();
+  succArcOffsets.clear();
+  succArcIds.clear();
+  adjacencyBuilt=false;
   finalStateSet.clear();
   initialStateScore=0;
   scrCompsVec.clear();
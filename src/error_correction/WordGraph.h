@@ -38,7 +38,10 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <iomanip>
 #include <fstream>
 #include <map>
+#include <string>
+#include <vector>
 #include "ErrorDefs.h"
+#include "WordIndex.h"
 #include "AwkInputStream.h"
 #include "WordGraphArc.h"
 #include "WordGraphArcId.h"
@@ -58,6 +61,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #define DISABLE_WORDGRAPH    2
 #define SMALL_SCORE          -999999999
 #define NBEST_MAX_STACK_SIZE 10000
+#define WORD_GRAPH_BIN_MAGIC   "THOTWGB"
+#define WORD_GRAPH_BIN_VERSION 1
 
 //--------------- Classes --------------------------------------------
 
@@ -65,7 +70,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 /**
  * @brief The WordGraph class implements a word graph for being
- * used in stack decoding.
+ * used in stack decoding. The words of the arcs are stored as indices
+ * of a vocabulary owned by the word graph, and the arcs to predecessor
+ * and successor states are stored in compressed sparse row arrays.
  */
 
 class WordGraph
@@ -73,6 +80,8 @@ class WordGraph
  public:
 
   typedef std::set<HypStateIndex> FinalStateSet;
+  typedef std::pair<const WordGraphArcId*,const WordGraphArcId*> ArcIdRange;
+      // Range [first,second) of arc identifiers
 
       // Constructor
   WordGraph(void);
@@ -96,7 +105,7 @@ class WordGraph
                           HypStateIndex succStateIndex,
                           const std::vector<std::string>& words,
                           Score arcScore,
-                          std::vector<Score> scrVec);
+                          const std::vector<Score>& scrVec);
       // The same as addArc, but a vector of score components is also
       // stored. IMPORTANT: scrVec must be an UNWEIGHTED vector
   void addFinalState(HypStateIndex finalStateIndex);
@@ -114,6 +123,12 @@ class WordGraph
       // should be called first
   WordGraphStateData getWordGraphStateData(HypStateIndex hypStateIndex)const;
   WordGraphArc wordGraphArcId2WordGraphArc(WordGraphArcId wordGraphArcId)const;
+  ArcIdRange getArcIdRangeToPredStates(HypStateIndex hypStateIndex)const;
+  ArcIdRange getArcIdRangeToSuccStates(HypStateIndex hypStateIndex)const;
+      // Return the arcs to the predecessor (successor) states of a
+      // given state without copying them. Unlike the
+      // getArcIdsTo[Pred|Succ]States() functions, pruned arcs are
+      // included
   void getArcsToPredStates(HypStateIndex hypStateIndex,
                            std::vector<WordGraphArc>& wgArcs)const;
   void getArcIdsToPredStates(HypStateIndex hypStateIndex,
@@ -125,15 +140,32 @@ class WordGraph
   FinalStateSet getFinalStateSet(void)const;
   bool stateIsFinal(HypStateIndex hypStateIndex)const;
 
+      // Functions to access the words of the arcs, k should be lower
+      // than the numWords data member of the arc
+  const std::string& getArcWord(const WordGraphArc& wgArc,
+                                unsigned int k)const;
+  WordIndex getArcWordIndex(const WordGraphArc& wgArc,
+                            unsigned int k)const;
+  void getArcWords(const WordGraphArc& wgArc,
+                   std::vector<std::string>& words)const;
+
+      // Functions to access the vocabulary of the word graph
+  size_t getVocabSize(void)const;
+  const std::string& wordIndexToString(WordIndex w)const;
+  bool existString(const std::string& word,
+                   WordIndex& w)const;
+
       // Functions to calculate previous and rest scores for
-      // each state
+      // each state. The arcs to be excluded are given by a bit map
+      // indexed by arc identifier, arcs beyond the size of the bit
+      // map are not excluded (an empty one excludes no arcs)
   void calcPrevScores(HypStateIndex idx,
-                      const std::set<WordGraphArcId>& excludedArcs,
+                      const std::vector<bool>& excludedArcs,
                       std::vector<Score>& prevScores,
                       std::vector<WordGraphArc>& bestPredArcForStateVec)const;
       // Calculate previous scores
   void calcPrevScoresWeights(HypStateIndex idx,
-                             const std::set<WordGraphArcId>& excludedArcs,
+                             const std::vector<bool>& excludedArcs,
                              const std::vector<float>& altCompWeights,
                              std::vector<Score>& prevScores,
                              std::vector<WordGraphArc>& bestPredArcForStateVec)const;
@@ -150,12 +182,12 @@ class WordGraph
 
       // Specific algorithms for word-graphs
   Score bestPathFromFinalStateToIdx(HypStateIndex hypStateIndex,
-                                    const std::set<WordGraphArcId>& excludedArcs,
+                                    const std::vector<bool>& excludedArcs,
                                     std::vector<WordGraphArc>& arcVec)const;
       // Stores best path from state in arcVec. Returns score for best
       // path.
   Score bestPathFromFinalStateToIdxWeights(HypStateIndex hypStateIndex,
-                                           const std::set<WordGraphArcId>& excludedArcs,
+                                           const std::vector<bool>& excludedArcs,
                                            const std::vector<float>& altCompWeights,
                                            std::vector<WordGraphArc>& arcVec)const;
       // The same as the previous one, but it allows to change the weights of
@@ -202,8 +234,10 @@ class WordGraph
       // ordered
   void orderArcsTopol(void);
 
-      // Functions to load word graphs
+      // Functions to load word graphs, the format of the file (text
+      // or binary) is detected automatically
   bool load(const char * filename);
+  static bool isBinWordGraphFile(const char * filename);
 
       // Functions to print word graphs
       //
@@ -215,6 +249,10 @@ class WordGraph
              bool printOnlyUsefulStates=false)const;
   void print(std::ostream &outS,
              bool printOnlyUsefulStates=false)const;
+  bool printBin(const char* filename,
+                bool printOnlyUsefulStates=false)const;
+      // Prints the word graph in binary format, which can be loaded
+      // with the load() function
   
       // size related functions
   bool empty(void)const;
@@ -226,16 +264,52 @@ class WordGraph
 
  protected:
   typedef std::vector<WordGraphArc> WordGraphArcs;
-  typedef std::vector<WordGraphStateData> WordGraphStates;
+  typedef std::map<std::string,WordIndex> StrToIdxVocab;
     
   WordGraphArcs wordGraphArcs;
   std::vector<bool> arcsPruned;
-  WordGraphStates wordGraphStates;
+  std::vector<WordIndex> arcWordIdxVec;
+      // Word indices of the arcs, the words of each arc are stored
+      // contiguously
+  std::vector<std::string> idxToStrVocab;
+  StrToIdxVocab strToIdxVocab;
+  unsigned int numWgStates;
   FinalStateSet finalStateSet;
   Score initialStateScore;
   std::vector<std::pair<std::string,float> > compWeights;
   std::vector<std::vector<Score> > scrCompsVec;
 
+      // Arcs to predecessor and successor states in compressed sparse
+      // row format: the arcs to the predecessors of state s are
+      // stored in predArcIds from position predArcOffsets[s] to
+      // position predArcOffsets[s+1]-1 (the same applies to
+      // successors). The arrays are built the first time that they
+      // are required after adding arcs, arcs of the same state keep
+      // their insertion order
+  mutable std::vector<unsigned int> predArcOffsets;
+  mutable std::vector<WordGraphArcId> predArcIds;
+  mutable std::vector<unsigned int> succArcOffsets;
+  mutable std::vector<WordGraphArcId> succArcIds;
+  mutable bool adjacencyBuilt;
+
+      // Auxiliary functions to add arcs and words
+  WordIndex addWord(const std::string& word);
+  void addArcWordIdx(HypStateIndex predStateIndex,
+                     HypStateIndex succStateIndex,
+                     const WordIndex* wordIdxs,
+                     unsigned int numWords,
+                     Score arcScore);
+
+      // Auxiliary functions for adjacency arrays
+  void buildAdjacency(void)const;
+  void buildAdjacencyArrays(bool pred,
+                            std::vector<unsigned int>& offsets,
+                            std::vector<WordGraphArcId>& arcIds)const;
+
+      // Auxiliary functions to load and print word graphs
+  bool loadText(const char * filename);
+  bool loadBin(const char * filename);
+
       // Auxiliary functions for pruning
   unsigned int pruneArcsToPredStates(float threshold);
   bool finalStatePruned(HypStateIndex hypStateIndex)const;
@@ -253,7 +327,7 @@ class WordGraph
                 int verbosity=false);
   bool hypIsComplete(const NbSearchHyp& nbSearchHyp);
   std::string stringAssociatedToHyp(const NbSearchHyp& nbSearchHyp,
-                                    std::vector<Score>& scoreComps);
+                                    std::vector<Score>& scoreComps)const;
   Score bestPathFromFinalStateToIdxAux(HypStateIndex hypStateIndex,
                                        const std::vector<Score>& prevScores,
                                        const std::vector<WordGraphArc>& bestPredArcForStateVec,
@@ -26,8 +26,6 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #endif /* HAVE_CONFIG_H */
 
 #include "HypStateIndex.h"
-#include <string>
-#include <vector>
 #include "Score.h"
 
 //--------------- Classes --------------------------------------------
@@ -39,7 +37,11 @@ class WordGraphArc
    HypStateIndex predStateIndex;
    HypStateIndex succStateIndex;
    Score arcScore;
-   std::vector<std::string> words;
+       // The words of the arc are stored by the word graph as word
+       // indices, firstWordPos gives the position of the first one
+       // (see WordGraph::getArcWord())
+   unsigned int firstWordPos;
+   unsigned int numWords;
 };
 
 #endif
@@ -94,6 +94,15 @@ int processParameters(thot_wg_proc_pars pars)
       // Load word-graph
   ret=wordGraph.load(pars.w_str.c_str());
   if(ret==THOT_ERROR) return THOT_ERROR;
+
+  if(pars.b_given)
+  {
+        // Print word-graph in binary format
+    std::string wgBinOutFile=pars.o_str;
+    wgBinOutFile=wgBinOutFile+".wgb";
+    ret=wordGraph.printBin(wgBinOutFile.c_str());
+    if(ret==THOT_ERROR) return THOT_ERROR;
+  }
   
   if(pars.wgp_given)
   {
@@ -295,11 +304,11 @@ int process_bp_par(const WordGraph& wordGraph,
                    thot_wg_proc_pars pars)
 {
   std::vector<WordGraphArc> arcVec;
-  std::set<WordGraphArcId> emptyWgArcIdSet;
+  std::vector<bool> noExcludedArcs;
 
       // Obtain best path
   Score bestScore=wordGraph.bestPathFromFinalStateToIdxWeights(pars.hypStateIndex,
-                                                               emptyWgArcIdSet,
+                                                               noExcludedArcs,
                                                                pars.compWeights,
                                                                arcVec);
     
@@ -329,11 +338,11 @@ int process_bp_par(const WordGraph& wordGraph,
       unsigned int r=arcVec.size()-i-1;
       outS<<arcVec[r].predStateIndex<<" -> "<<arcVec[r].succStateIndex;
       if(i!=0) str=str+" ";
-      for(unsigned int j=0;j<arcVec[r].words.size();++j)
+      for(unsigned int j=0;j<arcVec[r].numWords;++j)
       { 
-       str=str+arcVec[r].words[j];
-       if(j!=arcVec[r].words.size()-1) str=str+" ";
-        outS<<" "<<arcVec[r].words[j];
+       str=str+wordGraph.getArcWord(arcVec[r],j);
+       if(j!=arcVec[r].numWords-1) str=str+" ";
+        outS<<" "<<wordGraph.getArcWord(arcVec[r],j);
       }
       outS<<std::endl;
     }
@@ -507,6 +516,13 @@ int takeParameters(int argc,
       ++matched;
     }
 
+        // -b parameter
+    if(argv_stl[i]=="-b" && !matched)
+    {
+      pars.b_given=true;
+      ++matched;
+    }
+
         // -v parameter
     if(argv_stl[i]=="-v" && !matched)
     {
@@ -572,6 +588,9 @@ void printParameters(thot_wg_proc_pars pars)
   if(pars.t_given)
     std::cerr<<"-t"<<std::endl;
 
+  if(pars.b_given)
+    std::cerr<<"-b"<<std::endl;
+
   std::cerr<<"-o: "<<pars.o_str<<std::endl;
 }
 
@@ -580,10 +599,11 @@ void printUsage(void)
 {
   std::cerr<<"Usage: thot_wg_proc        -w <string>\n";
   std::cerr<<"                           [-bp <int> [<float1> ... <floatn>] ]\n";
-  std::cerr<<"                           [-wgp <float>] [-n <int> [-y] ] [-u] [-t]\n";
+  std::cerr<<"                           [-wgp <float>] [-n <int> [-y] ] [-u] [-t] [-b]\n";
   std::cerr<<"                           -o <string>\n";
   std::cerr<<"                           [-v|-v1] [--help] [--version]\n\n";
-  std::cerr<<"-w <string>                File with word-graph to be loaded.\n";
+  std::cerr<<"-w <string>                File with word-graph to be loaded (text or\n";
+  std::cerr<<"                           binary format).\n";
   std::cerr<<"-bp <int> [<float1> ... <floatn>]\n";
   std::cerr<<"                           Obtain best-path from state <int> to a final\n";
   std::cerr<<"                           state. Optionally, a float vector containing the\n";
@@ -602,6 +622,7 @@ void printUsage(void)
   std::cerr<<"-u                         Print word-graph composed of useful states.\n";
   std::cerr<<"                           NOTE: -u and -wgp options can be combined\n";
   std::cerr<<"-t                         Print word-graph with arcs topologically ordered.\n";
+  std::cerr<<"-b                         Print word-graph in binary format.\n";
   std::cerr<<"-o <string>                Set prefix for output files.\n";
   std::cerr<<"-v | -v1                   Verbose modes.\n";
   std::cerr<<"--help                     Display this help and exit.\n";
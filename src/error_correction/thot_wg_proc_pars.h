@@ -44,6 +44,7 @@ struct thot_wg_proc_pars
   unsigned int nbListLen;
   bool u_given;
   bool t_given;
+  bool b_given;
   bool o_given;
   std::string o_str;
   bool v_given;
@@ -62,6 +63,7 @@ struct thot_wg_proc_pars
       n_given=false;
       u_given=false;
       t_given=false;
+      b_given=false;
       o_given=false;
       v_given=false;
       v1_given=false;      
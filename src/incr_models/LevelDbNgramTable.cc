@@ -46,6 +46,11 @@ LevelDbNgramTable::LevelDbNgramTable(void)
 
     std::string null_str(null_vec.begin(), null_vec.end());
     dbNullKey = null_str;
+    dbFormatVersionKey = std::string(1, '\0') + "format_version";
+    formatVersion = LEVELDB_NGRAM_TABLE_FORMAT_VERSION;
+    writeBufferSize = options.write_buffer_size;
+    bulkLoading = false;
+    bulkLoadMaxEntries = LEVELDB_NGRAM_TABLE_BULK_LOAD_MAX_ENTRIES;
 }
 
 //-------------------------
@@ -87,12 +92,74 @@ std::vector<WordIndex> LevelDbNgramTable::stringToVector(const std::string s)con
 
     return vec;
 }
+//-------------------------
+std::string LevelDbNgramTable::countToValue(float count)const
+{
+    if (formatVersion == LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION)
+    {
+        std::stringstream ss;
+        ss << count;
+        return ss.str();
+    }
+    else
+    {
+        // Store the bits of the float in little-endian order
+        uint32_t bits;
+        memcpy(&bits, &count, sizeof(bits));
+
+        char buf[sizeof(bits)];
+        for (size_t i = 0; i < sizeof(bits); i++)
+        {
+            buf[i] = (char) ((bits >> (8 * i)) & 0xff);
+        }
+
+        return std::string(buf, sizeof(bits));
+    }
+}
+
+//-------------------------
+float LevelDbNgramTable::valueToCount(const leveldb::Slice& value)const
+{
+    if (formatVersion == LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION)
+    {
+        return atof(value.ToString().c_str());
+    }
+    else
+    {
+        uint32_t bits = 0;
+        if (value.size() != sizeof(bits))
+            return 0;
+
+        for (size_t i = 0; i < sizeof(bits); i++)
+        {
+            bits |= ((uint32_t) (unsigned char) value[i]) << (8 * i);
+        }
+
+        float count;
+        memcpy(&count, &bits, sizeof(count));
+
+        return count;
+    }
+}
+
 //-------------------------
 std::string LevelDbNgramTable::getDbNullKey(void)const
 {
     return dbNullKey;
 }
 
+//-------------------------
+std::string LevelDbNgramTable::getDbFormatVersionKey(void)const
+{
+    return dbFormatVersionKey;
+}
+
+//-------------------------
+bool LevelDbNgramTable::isReservedKey(const leveldb::Slice& key)const
+{
+    return key == leveldb::Slice(dbNullKey) || key == leveldb::Slice(dbFormatVersionKey);
+}
+
 //-------------------------
 std::vector<WordIndex> LevelDbNgramTable::getVectorDbNullKey(void)const
 {
@@ -117,11 +184,23 @@ bool LevelDbNgramTable::retrieveData(const std::string key, float &count)const
     std::string value_str;
     count = 0;
 
+    // Entries being bulk loaded may not have been written yet
+    if (bulkLoading)
+    {
+        std::map<std::string, std::string>::const_iterator iter = bulkLoadBuffer.find(key);
+
+        if (iter != bulkLoadBuffer.end())
+        {
+            count = valueToCount(iter->second);
+            return true;
+        }
+    }
+
     leveldb::Status result = db->Get(leveldb::ReadOptions(), key, &value_str);  // Read stored src value
 
     if (result.ok())
     {
-        count = atof(value_str.c_str());
+        count = valueToCount(value_str);
         return true;
     }
     else
@@ -149,9 +228,17 @@ bool LevelDbNgramTable::retrieveData(const std::vector<WordIndex>& phrase, float
 //-------------------------
 bool LevelDbNgramTable::storeData(const std::string key, float count)
 {
-    std::stringstream ss;
-    ss << count;
-    std::string count_str = ss.str();
+    std::string count_str = countToValue(count);
+
+    if (bulkLoading)
+    {
+        bulkLoadBuffer[key] = count_str;
+
+        if (bulkLoadBuffer.size() >= bulkLoadMaxEntries)
+            return flushBulkLoadBuffer();
+        else
+            return true;
+    }
 
     leveldb::WriteBatch batch;
     batch.Put(key, count_str);
@@ -181,6 +268,165 @@ bool LevelDbNgramTable::storeData(const std::vector<WordIndex>& phrase, float co
     return storeData(key, count);
 }
 
+//-------------------------
+bool LevelDbNgramTable::flushBulkLoadBuffer(void)const
+{
+    bool ok = true;
+    leveldb::WriteBatch batch;
+    size_t batchSize = 0;
+
+    // The buffer is sorted by key, so each batch covers a contiguous
+    // range of keys
+    for (std::map<std::string, std::string>::const_iterator iter = bulkLoadBuffer.begin(); iter != bulkLoadBuffer.end(); iter++)
+    {
+        batch.Put(iter->first, iter->second);
+        batchSize++;
+
+        if (batchSize == LEVELDB_NGRAM_TABLE_BULK_LOAD_BATCH_SIZE)
+        {
+            leveldb::Status s = db->Write(leveldb::WriteOptions(), &batch);
+            if (!s.ok())
+            {
+                std::cerr << "Storing data status: " << s.ToString() << std::endl;
+                ok = false;
+            }
+            batch.Clear();
+            batchSize = 0;
+        }
+    }
+
+    if (batchSize > 0)
+    {
+        leveldb::Status s = db->Write(leveldb::WriteOptions(), &batch);
+        if (!s.ok())
+        {
+            std::cerr << "Storing data status: " << s.ToString() << std::endl;
+            ok = false;
+        }
+    }
+
+    bulkLoadBuffer.clear();
+
+    return ok;
+}
+
+//-------------------------
+bool LevelDbNgramTable::reopen(size_t _writeBufferSize)
+{
+    if (db != NULL)
+    {
+        delete db;
+        db = NULL;
+    }
+
+    options.write_buffer_size = _writeBufferSize;
+    leveldb::Status status = leveldb::DB::Open(options, dbName, &db);
+
+    if (status.ok())
+    {
+        return THOT_OK;
+    }
+    else
+    {
+        std::cerr << status.ToString() << std::endl;
+
+        return THOT_ERROR;
+    }
+}
+
+//-------------------------
+bool LevelDbNgramTable::startBulkLoad(size_t maxBufferedEntries)
+{
+    if (db == NULL)
+    {
+        std::cerr << "Bulk loading requires an initialized database" << std::endl;
+
+        return THOT_ERROR;
+    }
+
+    bulkLoadMaxEntries = maxBufferedEntries;
+    bulkLoading = true;
+
+    // A larger write buffer reduces the number of compactions
+    return reopen(LEVELDB_NGRAM_TABLE_BULK_LOAD_WRITE_BUFFER_SIZE);
+}
+
+//-------------------------
+bool LevelDbNgramTable::endBulkLoad(void)
+{
+    if (!bulkLoading)
+        return THOT_OK;
+
+    bool ok = flushBulkLoadBuffer();
+    bulkLoading = false;
+
+    if (reopen(writeBufferSize) != THOT_OK || !ok)
+        return THOT_ERROR;
+    else
+        return THOT_OK;
+}
+
+//-------------------------
+unsigned int LevelDbNgramTable::getFormatVersion(void)const
+{
+    return formatVersion;
+}
+
+//-------------------------
+bool LevelDbNgramTable::restoreFormatVersion(void)
+{
+    std::string value_str;
+    leveldb::Status result = db->Get(leveldb::ReadOptions(), dbFormatVersionKey, &value_str);
+
+    if (result.ok())
+    {
+        formatVersion = atoi(value_str.c_str());
+
+        if (formatVersion > LEVELDB_NGRAM_TABLE_FORMAT_VERSION)
+        {
+            std::cerr << "Unsupported format version of LevelDB n-gram table: " << formatVersion << std::endl;
+
+            return THOT_ERROR;
+        }
+
+        return THOT_OK;
+    }
+
+    // Databases without version key are either new or were created
+    // before storing counts in binary format
+    leveldb::Iterator* it = db->NewIterator(leveldb::ReadOptions());
+    it->SeekToFirst();
+    bool empty = !it->Valid();
+    delete it;
+
+    if (empty)
+    {
+        formatVersion = LEVELDB_NGRAM_TABLE_FORMAT_VERSION;
+
+        return storeFormatVersion() ? THOT_OK : THOT_ERROR;
+    }
+    else
+    {
+        formatVersion = LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION;
+
+        return THOT_OK;
+    }
+}
+
+//-------------------------
+bool LevelDbNgramTable::storeFormatVersion(void)
+{
+    std::stringstream ss;
+    ss << formatVersion;
+
+    leveldb::Status s = db->Put(leveldb::WriteOptions(), dbFormatVersionKey, ss.str());
+
+    if(!s.ok())
+        std::cerr << "Storing format version status: " << s.ToString() << std::endl;
+
+    return s.ok();
+}
+
 //-------------------------
 bool LevelDbNgramTable::init(std::string levelDbPath)
 {
@@ -203,6 +449,8 @@ bool LevelDbNgramTable::init(std::string levelDbPath)
 //-------------------------
 bool LevelDbNgramTable::drop()
 {
+    bulkLoadBuffer.clear();
+
     if(db != NULL)
     {
         delete db;
@@ -230,6 +478,7 @@ bool LevelDbNgramTable::load(const char *fileName)
 
     if(db != NULL)
     {
+        flushBulkLoadBuffer();
         delete db;
         db = NULL;
     }
@@ -239,6 +488,10 @@ bool LevelDbNgramTable::load(const char *fileName)
 
     if(status.ok())
     {
+        // Determine how values are stored
+        if (restoreFormatVersion() != THOT_OK)
+            return THOT_ERROR;
+
         // Restore null count
         float null_count;
         retrieveData(dbNullKey, null_count);
@@ -515,6 +768,9 @@ bool LevelDbNgramTable::getEntriesForSource(const std::vector<WordIndex>& s,
     leveldb::Slice start = start_str;
     leveldb::Slice end = end_str;
 
+    if (bulkLoading)
+        flushBulkLoadBuffer();
+
     // Iterate over the defined key range and populate valid results
     leveldb::Iterator* it = db->NewIterator(leveldb::ReadOptions());
     
@@ -528,7 +784,7 @@ bool LevelDbNgramTable::getEntriesForSource(const std::vector<WordIndex>& s,
         {
             pdp.first = vec.back();  // t
             pdp.second.first = s_count;  // count(s)
-            pdp.second.second = Count(atof(it->value().ToString().c_str()));  // sount(s, t)
+            pdp.second.second = Count(valueToCount(it->value()));  // sount(s, t)
 
             if (fabs(pdp.second.second.get_c_st()) < EPSILON)  // Compare to 0
                 continue;
@@ -654,6 +910,10 @@ void LevelDbNgramTable::clear(void)
             exit(3);
         }
 
+        // New databases use the current format
+        formatVersion = LEVELDB_NGRAM_TABLE_FORMAT_VERSION;
+        storeFormatVersion();
+
         // Clear empty key counter
         storeData(dbNullKey, 0);
         srcInfoNull = Count();
@@ -664,7 +924,10 @@ void LevelDbNgramTable::clear(void)
 LevelDbNgramTable::~LevelDbNgramTable(void)
 {
     if(db != NULL)
+    {
+        flushBulkLoadBuffer();
         delete db;
+    }
 
     if(options.filter_policy != NULL)
         delete options.filter_policy;
@@ -676,11 +939,14 @@ LevelDbNgramTable::~LevelDbNgramTable(void)
 //-------------------------
 LevelDbNgramTable::const_iterator LevelDbNgramTable::begin(void)const
 {
+    if (bulkLoading)
+        flushBulkLoadBuffer();
     leveldb::Iterator *local_iter = db->NewIterator(leveldb::ReadOptions());
     local_iter->SeekToFirst();
 
-    // Skip item, if it stores nullInfo, to be compatible with other implementations
-    if (local_iter->Valid() && local_iter->key().ToString() == getDbNullKey())
+    // Skip items storing nullInfo or the format version, to be
+    // compatible with other implementations
+    while (local_iter->Valid() && isReservedKey(local_iter->key()))
     {
         local_iter->Next();
     }
@@ -711,8 +977,9 @@ bool LevelDbNgramTable::const_iterator::operator++(void) //prefix
 {
     internalIter->Next();
 
-    // Skip item, if it stores nullInfo, to be compatible with other implementations
-    if (internalIter->Valid() && internalIter->key().ToString() == ptPtr->getDbNullKey())
+    // Skip items storing nullInfo or the format version, to be
+    // compatible with other implementations
+    while (internalIter->Valid() && ptPtr->isReservedKey(internalIter->key()))
     {
         internalIter->Next();
     }
@@ -759,7 +1026,7 @@ LevelDbNgramTable::const_iterator::operator->(void)
     std::string key = internalIter->key().ToString();
     std::vector<WordIndex> key_vec = ptPtr->keyToVector(key);
 
-    float count = atof(internalIter->value().ToString().c_str());
+    float count = ptPtr->valueToCount(internalIter->value());
 
     dataItem = make_pair(key_vec, Count(count));
 
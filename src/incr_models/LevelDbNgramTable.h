@@ -29,6 +29,16 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #define WORD_INDEX_MODULO_BASE 254
 #define WORD_INDEX_MODULO_BYTES 3
 
+    // Format of the stored values: version 0 stores counts as text,
+    // version 1 stores them as 32-bit little-endian floats
+#define LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION 0
+#define LEVELDB_NGRAM_TABLE_FORMAT_VERSION 1
+
+    // Bulk loading parameters
+#define LEVELDB_NGRAM_TABLE_BULK_LOAD_MAX_ENTRIES 1000000
+#define LEVELDB_NGRAM_TABLE_BULK_LOAD_BATCH_SIZE 100000
+#define LEVELDB_NGRAM_TABLE_BULK_LOAD_WRITE_BUFFER_SIZE (256 * 1048576)
+
 //--------------- Include files --------------------------------------
 
 #if HAVE_CONFIG_H
@@ -39,6 +49,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "leveldb/db.h"
 #include "leveldb/filter_policy.h"
 #include "leveldb/write_batch.h"
+#include <stdint.h>
+#include <string.h>
+#include <map>
 #include <sstream>
 
 #include "BaseIncrCondProbTable.h"
@@ -64,10 +77,28 @@ class LevelDbNgramTable: public BaseIncrCondProbTable<std::vector<WordIndex>, Wo
         leveldb::Options options;
         std::string dbName;
         std::string dbNullKey;
+        std::string dbFormatVersionKey;
+        unsigned int formatVersion;
+        size_t writeBufferSize;
+
+            // Entries stored during bulk loading, sorted by key
+        bool bulkLoading;
+        size_t bulkLoadMaxEntries;
+        mutable std::map<std::string, std::string> bulkLoadBuffer;
 
             // Converters
         std::string vectorToString(const std::vector<WordIndex>& vec)const;
         std::vector<WordIndex> stringToVector(const std::string s)const;
+        std::string countToValue(float count)const;
+        float valueToCount(const leveldb::Slice& value)const;
+
+            // Format version marker
+        bool restoreFormatVersion(void);
+        bool storeFormatVersion(void);
+
+            // Write buffered entries in batches sorted by key
+        bool flushBulkLoadBuffer(void)const;
+        bool reopen(size_t _writeBufferSize);
         
             // Read and write data
         bool retrieveData(const std::string key, float &count)const;
@@ -99,6 +130,19 @@ class LevelDbNgramTable: public BaseIncrCondProbTable<std::vector<WordIndex>, Wo
         bool load(const char *fileName);
         //bool load(std::string fileName);
 
+            // Bulk loading for offline conversions. Entries are kept in
+            // memory and written in large batches sorted by key. They
+            // are visible to lookups, but they are not guaranteed to be
+            // on disk until endBulkLoad() is called. Bulk-load mode is
+            // single-threaded: the const lookups flush the buffer, so
+            // the table must not be shared between threads until
+            // endBulkLoad() returns
+        bool startBulkLoad(size_t maxBufferedEntries = LEVELDB_NGRAM_TABLE_BULK_LOAD_MAX_ENTRIES);
+        bool endBulkLoad(void);
+
+            // Version of the format of the stored values
+        unsigned int getFormatVersion(void)const;
+
           // Basic functions
           // TODO Ordering by n-gram value
 
@@ -187,6 +231,13 @@ class LevelDbNgramTable: public BaseIncrCondProbTable<std::vector<WordIndex>, Wo
         std::string getDbNullKey(void)const;
         std::vector<WordIndex> getVectorDbNullKey(void)const;
 
+        // Key for the format version, it cannot be generated by
+        // vectorToString() since it starts with a zero byte
+        std::string getDbFormatVersionKey(void)const;
+
+        // Returns true for keys not storing n-gram counts
+        bool isReservedKey(const leveldb::Slice& key)const;
+
 };
 
 #endif
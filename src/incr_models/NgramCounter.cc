@@ -0,0 +1,505 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NgramCounter.cc
+ *
+ * @brief Definitions file for NgramCounter.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "NgramCounter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <queue>
+#include <iostream>
+
+//--------------- Constants ------------------------------------------
+
+#define NGRAM_COUNTER_RUN_BUFFER_SIZE 1048576
+
+//--------------- Classes --------------------------------------------
+
+//--------------- Readers of sorted runs
+
+class NgramRunReader
+{
+ public:
+  virtual bool next(NgramCounter::NgramKey& key,
+                    NgramCounter::NgramCount& count)=0;
+  virtual ~NgramRunReader(){};
+};
+
+//---------------
+class NgramMemRunReader: public NgramRunReader
+{
+ public:
+  NgramMemRunReader(const std::vector<std::pair<NgramCounter::NgramKey,NgramCounter::NgramCount> >* _entriesPtr):entriesPtr(_entriesPtr),pos(0){}
+
+  bool next(NgramCounter::NgramKey& key,
+            NgramCounter::NgramCount& count)
+  {
+    if(pos>=entriesPtr->size())
+      return false;
+    key=(*entriesPtr)[pos].first;
+    count=(*entriesPtr)[pos].second;
+    ++pos;
+    return true;
+  }
+
+ private:
+  const std::vector<std::pair<NgramCounter::NgramKey,NgramCounter::NgramCount> >* entriesPtr;
+  size_t pos;
+};
+
+//---------------
+class NgramFileRunReader: public NgramRunReader
+{
+ public:
+  NgramFileRunReader(FILE* _filePtr):filePtr(_filePtr){}
+
+  bool next(NgramCounter::NgramKey& key,
+            NgramCounter::NgramCount& count)
+  {
+    memset(key.words,0,sizeof(key.words));
+    if(fread(&key.len,sizeof(key.len),1,filePtr)!=1)
+      return false;
+    if(key.len>NGRAM_COUNTER_MAX_ORDER ||
+       fread(key.words,sizeof(WordIndex),key.len,filePtr)!=key.len ||
+       fread(&count,sizeof(count),1,filePtr)!=1)
+    {
+      std::cerr<<"Error: temporary file with n-gram counts is corrupted"<<std::endl;
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  FILE* filePtr;
+};
+
+//---------------
+struct NgramRunHeapItem
+{
+  NgramCounter::NgramKey key;
+  NgramCounter::NgramCount count;
+  unsigned int runIdx;
+
+      // Items are compared in reverse order, so the top of a
+      // std::priority_queue contains the smallest key
+  bool operator<(const NgramRunHeapItem& right)const
+  {
+    return right.key<key;
+  }
+};
+
+//--------------- NgramCounter class functions
+
+//---------------------------------------
+bool NgramCounter::NgramKey::operator==(const NgramKey& right)const
+{
+  if(len!=right.len)
+    return false;
+  for(unsigned int i=0;i<len;++i)
+  {
+    if(words[i]!=right.words[i]) return false;
+  }
+  return true;
+}
+
+//---------------------------------------
+bool NgramCounter::NgramKey::operator<(const NgramKey& right)const
+{
+  unsigned int minLen=(len<right.len) ? len : right.len;
+  for(unsigned int i=0;i<minLen;++i)
+  {
+    if(words[i]<right.words[i]) return true;
+    if(right.words[i]<words[i]) return false;
+  }
+  return len<right.len;
+}
+
+//---------------------------------------
+size_t NgramCounter::NgramKeyHashF::operator()(const NgramKey& key)const
+{
+  unsigned long long h=key.len;
+  for(unsigned int i=0;i<key.len;++i)
+  {
+    h=(h^key.words[i])*0x9E3779B97F4A7C15ULL;
+    h^=h>>29;
+  }
+  return (size_t) h;
+}
+
+//---------------------------------------
+NgramCounter::NgramCounter(void)
+{
+  order=3;
+  maxEntriesInMem=NGRAM_COUNTER_MAX_ENTRIES_DEFAULT;
+  tmpDir="/tmp";
+  blockPtr=NULL;
+  clear();
+}
+
+//---------------------------------------
+int NgramCounter::setOrder(unsigned int _order)
+{
+  if(_order==0 || _order>NGRAM_COUNTER_MAX_ORDER)
+  {
+    std::cerr<<"Error: n-gram order should be between 1 and "<<NGRAM_COUNTER_MAX_ORDER<<std::endl;
+    return THOT_ERROR;
+  }
+  order=_order;
+  return THOT_OK;
+}
+
+//---------------------------------------
+void NgramCounter::setNumThreads(unsigned int _numThreads)
+{
+  workerPool.setNumThreads(_numThreads);
+  clear();
+}
+
+//---------------------------------------
+void NgramCounter::setMaxEntriesInMem(size_t _maxEntriesInMem)
+{
+  maxEntriesInMem=_maxEntriesInMem;
+}
+
+//---------------------------------------
+void NgramCounter::setTmpDir(const std::string& _tmpDir)
+{
+  tmpDir=_tmpDir;
+}
+
+//---------------------------------------
+int NgramCounter::addSentences(const std::vector<std::vector<WordIndex> >& sentences)
+{
+  for(unsigned int i=0;i<sentences.size();++i)
+  {
+    numWords+=sentences[i].size()+2;
+    ++numSents;
+  }
+
+      // Extract the n-grams of each slice of the block and add them to
+      // the tables of the shards
+  blockPtr=&sentences;
+  workerPool.run(numShards(),extractNgramsTask,this);
+  workerPool.run(numShards(),addToShardTask,this);
+  blockPtr=NULL;
+
+  if(numEntriesInMem()>maxEntriesInMem)
+    return spill();
+  else
+    return THOT_OK;
+}
+
+//---------------------------------------
+int NgramCounter::extractCounts(NgramCountHandler& handler)
+{
+      // Sort the counts kept in memory
+  workerPool.run(numShards(),sortShardTask,this);
+
+      // Sentence begin and end symbols appear once per sentence
+  std::vector<NgramEntry> sentMarkEntries(2);
+  memset(sentMarkEntries[0].first.words,0,sizeof(sentMarkEntries[0].first.words));
+  sentMarkEntries[0].first.words[0]=S_BEGIN;
+  sentMarkEntries[0].first.len=1;
+  sentMarkEntries[0].second=numSents;
+  sentMarkEntries[1]=sentMarkEntries[0];
+  sentMarkEntries[1].first.words[0]=S_END;
+  std::sort(sentMarkEntries.begin(),sentMarkEntries.end());
+
+      // Open sorted runs
+  std::vector<NgramRunReader*> runReaders;
+  std::vector<FILE*> runFiles;
+  for(unsigned int s=0;s<sortedShards.size();++s)
+    runReaders.push_back(new NgramMemRunReader(&sortedShards[s]));
+  runReaders.push_back(new NgramMemRunReader(&sentMarkEntries));
+  int ret=THOT_OK;
+  for(unsigned int r=0;r<runFileNames.size();++r)
+  {
+    FILE* filePtr=fopen(runFileNames[r].c_str(),"rb");
+    if(filePtr==NULL)
+    {
+      std::cerr<<"Error while opening temporary file "<<runFileNames[r]<<std::endl;
+      ret=THOT_ERROR;
+      break;
+    }
+    setvbuf(filePtr,NULL,_IOFBF,NGRAM_COUNTER_RUN_BUFFER_SIZE);
+    runFiles.push_back(filePtr);
+    runReaders.push_back(new NgramFileRunReader(filePtr));
+  }
+
+      // Merge runs, the counts of equal n-grams are added. Since each
+      // n-gram is preceded by its history, history counts are kept in
+      // a stack indexed by n-gram length
+  if(ret==THOT_OK)
+  {
+    std::priority_queue<NgramRunHeapItem> runHeap;
+    for(unsigned int r=0;r<runReaders.size();++r)
+    {
+      NgramRunHeapItem item;
+      item.runIdx=r;
+      if(runReaders[r]->next(item.key,item.count))
+        runHeap.push(item);
+    }
+
+    std::vector<NgramCount> histCounts(NGRAM_COUNTER_MAX_ORDER,0);
+    while(!runHeap.empty())
+    {
+      NgramKey key=runHeap.top().key;
+      NgramCount count=0;
+      while(!runHeap.empty() && runHeap.top().key==key)
+      {
+        NgramRunHeapItem item=runHeap.top();
+        runHeap.pop();
+        count+=item.count;
+        if(runReaders[item.runIdx]->next(item.key,item.count))
+          runHeap.push(item);
+      }
+
+      NgramCount histCount=(key.len==1) ? numWords : histCounts[key.len-2];
+      histCounts[key.len-1]=count;
+      if(handler.handleNgram(key.words,key.len,histCount,count)==THOT_ERROR)
+      {
+        ret=THOT_ERROR;
+        break;
+      }
+    }
+  }
+
+      // Release runs
+  for(unsigned int r=0;r<runReaders.size();++r)
+    delete runReaders[r];
+  for(unsigned int r=0;r<runFiles.size();++r)
+    fclose(runFiles[r]);
+  clear();
+
+  return ret;
+}
+
+//---------------------------------------
+size_t NgramCounter::numEntriesInMem(void)const
+{
+  size_t n=0;
+  for(unsigned int s=0;s<shardTables.size();++s)
+    n+=shardTables[s].size();
+  return n;
+}
+
+//---------------------------------------
+unsigned int NgramCounter::numRunFiles(void)const
+{
+  return runFileNames.size();
+}
+
+//---------------------------------------
+void NgramCounter::clear(void)
+{
+  for(unsigned int r=0;r<runFileNames.size();++r)
+    unlink(runFileNames[r].c_str());
+  runFileNames.clear();
+
+  shardTables.clear();
+  shardTables.resize(numShards());
+  sortedShards.clear();
+  sortedShards.resize(numShards());
+  workerShardBuffers.clear();
+  workerShardBuffers.resize(numShards(),std::vector<std::vector<NgramKey> >(numShards()));
+  numWords=0;
+  numSents=0;
+}
+
+//---------------------------------------
+unsigned int NgramCounter::numShards(void)const
+{
+  return workerPool.getNumThreads();
+}
+
+//---------------------------------------
+unsigned int NgramCounter::shardOfKey(const NgramKey& key)const
+{
+  NgramKeyHashF hashF;
+  return (hashF(key)>>7)%numShards();
+}
+
+//---------------------------------------
+int NgramCounter::spill(void)
+{
+  unsigned int prevNumRuns=runFileNames.size();
+  runFileNames.resize(prevNumRuns+numShards());
+  spillResults.assign(numShards(),THOT_OK);
+  workerPool.run(numShards(),spillShardTask,this);
+
+      // Shards without entries do not generate runs
+  std::vector<std::string> nonEmptyRunFileNames;
+  for(unsigned int r=0;r<runFileNames.size();++r)
+  {
+    if(!runFileNames[r].empty())
+      nonEmptyRunFileNames.push_back(runFileNames[r]);
+  }
+  runFileNames.swap(nonEmptyRunFileNames);
+
+  if(std::find(spillResults.begin(),spillResults.end(),THOT_ERROR)!=spillResults.end())
+  {
+    std::cerr<<"Error while writing n-gram counts to directory "<<tmpDir<<std::endl;
+    return THOT_ERROR;
+  }
+  else
+    return THOT_OK;
+}
+
+//---------------------------------------
+void NgramCounter::sortShard(unsigned int shard)
+{
+  NgramTable& table=shardTables[shard];
+  std::vector<NgramEntry>& entries=sortedShards[shard];
+  entries.clear();
+  entries.reserve(table.size());
+  for(NgramTable::const_iterator iter=table.begin();iter!=table.end();++iter)
+    entries.push_back(*iter);
+  NgramTable().swap(table);
+  std::sort(entries.begin(),entries.end());
+}
+
+//---------------------------------------
+bool NgramCounter::writeRun(const std::vector<NgramEntry>& entries,
+                            std::string& fileName)
+{
+  std::vector<char> fileNameBuf(tmpDir.begin(),tmpDir.end());
+  const char* suffix="/thot_ngram_counts_XXXXXX";
+  fileNameBuf.insert(fileNameBuf.end(),suffix,suffix+strlen(suffix)+1);
+  int fd=mkstemp(&fileNameBuf[0]);
+  if(fd==-1)
+    return false;
+  fileName=&fileNameBuf[0];
+
+  FILE* filePtr=fdopen(fd,"wb");
+  if(filePtr==NULL)
+  {
+    close(fd);
+    return false;
+  }
+  setvbuf(filePtr,NULL,_IOFBF,NGRAM_COUNTER_RUN_BUFFER_SIZE);
+  bool ok=true;
+  for(size_t i=0;i<entries.size() && ok;++i)
+  {
+    const NgramKey& key=entries[i].first;
+    ok=(fwrite(&key.len,sizeof(key.len),1,filePtr)==1 &&
+        fwrite(key.words,sizeof(WordIndex),key.len,filePtr)==key.len &&
+        fwrite(&entries[i].second,sizeof(NgramCount),1,filePtr)==1);
+  }
+  if(fclose(filePtr)!=0)
+    ok=false;
+  return ok;
+}
+
+//---------------------------------------
+void NgramCounter::extractNgramsTask(void* data,
+                                     unsigned int taskIdx,
+                                     unsigned int /*workerIdx*/)
+{
+  NgramCounter* counterPtr=(NgramCounter*) data;
+  const std::vector<std::vector<WordIndex> >& sentences=*counterPtr->blockPtr;
+  std::vector<std::vector<NgramKey> >& shardBuffers=counterPtr->workerShardBuffers[taskIdx];
+  unsigned int nshards=counterPtr->numShards();
+  size_t first=(sentences.size()*taskIdx)/nshards;
+  size_t last=(sentences.size()*(taskIdx+1))/nshards;
+
+  std::vector<WordIndex> padded;
+  NgramKey key;
+  memset(key.words,0,sizeof(key.words));
+  for(size_t s=first;s<last;++s)
+  {
+        // Positions 0 and nf+1 contain the sentence begin and end
+        // symbols. Unigrams of these symbols are not extracted, their
+        // counts are given by the number of sentences
+    size_t nf=sentences[s].size();
+    padded.clear();
+    padded.push_back(S_BEGIN);
+    padded.insert(padded.end(),sentences[s].begin(),sentences[s].end());
+    padded.push_back(S_END);
+    for(unsigned int i=1;i<=counterPtr->order;++i)
+    {
+      size_t j=(i==1) ? 1 : i-1;
+      size_t rightmost=(i==1) ? nf : nf+1;
+      for(;j<=rightmost;++j)
+      {
+        key.len=i;
+        for(unsigned int k=0;k<i;++k)
+          key.words[k]=padded[j-i+1+k];
+        shardBuffers[counterPtr->shardOfKey(key)].push_back(key);
+      }
+    }
+  }
+}
+
+//---------------------------------------
+void NgramCounter::addToShardTask(void* data,
+                                  unsigned int taskIdx,
+                                  unsigned int /*workerIdx*/)
+{
+  NgramCounter* counterPtr=(NgramCounter*) data;
+  NgramTable& table=counterPtr->shardTables[taskIdx];
+  for(unsigned int w=0;w<counterPtr->workerShardBuffers.size();++w)
+  {
+    std::vector<NgramKey>& buffer=counterPtr->workerShardBuffers[w][taskIdx];
+    for(size_t i=0;i<buffer.size();++i)
+      ++table[buffer[i]];
+    buffer.clear();
+  }
+}
+
+//---------------------------------------
+void NgramCounter::sortShardTask(void* data,
+                                 unsigned int taskIdx,
+                                 unsigned int /*workerIdx*/)
+{
+  NgramCounter* counterPtr=(NgramCounter*) data;
+  counterPtr->sortShard(taskIdx);
+}
+
+//---------------------------------------
+void NgramCounter::spillShardTask(void* data,
+                                  unsigned int taskIdx,
+                                  unsigned int /*workerIdx*/)
+{
+  NgramCounter* counterPtr=(NgramCounter*) data;
+  counterPtr->sortShard(taskIdx);
+  std::vector<NgramEntry>& entries=counterPtr->sortedShards[taskIdx];
+  if(!entries.empty())
+  {
+        // Each shard writes its own positions of runFileNames and
+        // spillResults
+    std::string& fileName=counterPtr->runFileNames[counterPtr->runFileNames.size()-counterPtr->numShards()+taskIdx];
+    if(!counterPtr->writeRun(entries,fileName))
+      counterPtr->spillResults[taskIdx]=THOT_ERROR;
+  }
+  std::vector<NgramEntry>().swap(entries);
+}
+
+//---------------------------------------
+NgramCounter::~NgramCounter()
+{
+  for(unsigned int r=0;r<runFileNames.size();++r)
+    unlink(runFileNames[r].c_str());
+}
@@ -0,0 +1,169 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NgramCounter.h
+ *
+ * @brief Defines the NgramCounter class, which obtains the n-gram
+ * counts of a corpus of encoded sentences using several threads.
+ * Counts are kept in sharded hash tables, which are sorted and written
+ * to temporary files when their size exceeds a given limit. The final
+ * counts are obtained by merging the sorted runs.
+ */
+
+#ifndef _NgramCounter_h
+#define _NgramCounter_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "LM_Defs.h"
+#include "WordIndex.h"
+#include "ErrorDefs.h"
+#include "WorkerThreadPool.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __GNUC__
+#include <ext/hash_map>
+using __gnu_cxx::hash_map;
+#else
+#include <hash_map>
+#endif
+
+//--------------- Constants ------------------------------------------
+
+#define NGRAM_COUNTER_MAX_ORDER             8
+#define NGRAM_COUNTER_MAX_ENTRIES_DEFAULT   50000000
+
+//--------------- Classes --------------------------------------------
+
+//--------------- NgramCounter class
+
+class NgramCounter
+{
+ public:
+
+  typedef unsigned long long NgramCount;
+
+      // Key of the n-gram tables
+  struct NgramKey
+  {
+    WordIndex words[NGRAM_COUNTER_MAX_ORDER];
+    unsigned char len;
+
+    bool operator==(const NgramKey& right)const;
+        // N-grams are sorted lexicographically, so each n-gram is
+        // preceded by its history
+    bool operator<(const NgramKey& right)const;
+  };
+
+  struct NgramKeyHashF
+  {
+    size_t operator()(const NgramKey& key)const;
+  };
+
+      // Class receiving the n-grams obtained by extractCounts()
+  class NgramCountHandler
+  {
+   public:
+        // histCount is the count of the first len-1 words of the
+        // n-gram (the total number of words for unigrams)
+    virtual int handleNgram(const WordIndex* ngram,
+                            unsigned int len,
+                            NgramCount histCount,
+                            NgramCount count)=0;
+    virtual ~NgramCountHandler(){};
+  };
+
+      // Constructor
+  NgramCounter(void);
+
+      // Parameters, they should be set before adding sentences
+  int setOrder(unsigned int _order);
+  void setNumThreads(unsigned int _numThreads);
+  void setMaxEntriesInMem(size_t _maxEntriesInMem);
+  void setTmpDir(const std::string& _tmpDir);
+
+      // Count the n-grams of a block of sentences. Sentences are
+      // extended with the sentence begin and end symbols
+  int addSentences(const std::vector<std::vector<WordIndex> >& sentences);
+
+      // Merge the counts and pass them to handler in lexicographic
+      // order. The counter is cleared afterwards
+  int extractCounts(NgramCountHandler& handler);
+
+  size_t numEntriesInMem(void)const;
+  unsigned int numRunFiles(void)const;
+  void clear(void);
+
+      // Destructor
+  ~NgramCounter();
+
+ private:
+
+  typedef hash_map<NgramKey,NgramCount,NgramKeyHashF> NgramTable;
+  typedef std::pair<NgramKey,NgramCount> NgramEntry;
+
+  unsigned int order;
+  size_t maxEntriesInMem;
+  std::string tmpDir;
+  WorkerThreadPool workerPool;
+
+      // Tables of each shard and names of the sorted runs written to
+      // disk
+  std::vector<NgramTable> shardTables;
+  std::vector<std::string> runFileNames;
+  NgramCount numWords;
+  NgramCount numSents;
+
+      // Data of the current block of sentences. N-grams are extracted
+      // by each worker to a buffer for each shard, and then added to
+      // the table of the shard
+  const std::vector<std::vector<WordIndex> >* blockPtr;
+  std::vector<std::vector<std::vector<NgramKey> > > workerShardBuffers;
+  std::vector<std::vector<NgramEntry> > sortedShards;
+  std::vector<int> spillResults;
+
+  unsigned int numShards(void)const;
+  unsigned int shardOfKey(const NgramKey& key)const;
+  int spill(void);
+  void sortShard(unsigned int shard);
+  bool writeRun(const std::vector<NgramEntry>& entries,
+                std::string& fileName);
+
+      // Functions executed by the worker threads
+  static void extractNgramsTask(void* data,
+                                unsigned int taskIdx,
+                                unsigned int workerIdx);
+  static void addToShardTask(void* data,
+                             unsigned int taskIdx,
+                             unsigned int workerIdx);
+  static void sortShardTask(void* data,
+                            unsigned int taskIdx,
+                            unsigned int workerIdx);
+  static void spillShardTask(void* data,
+                             unsigned int taskIdx,
+                             unsigned int workerIdx);
+};
+
+#endif
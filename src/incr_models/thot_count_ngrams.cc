@@ -0,0 +1,586 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_count_ngrams.cc
+ *
+ * @brief Extracts the n-gram counts of a monolingual corpus using
+ * several threads. The counts are printed in the format generated by
+ * thot_get_ngram_counts or stored in a LevelDB n-gram table.
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "LM_Defs.h"
+  // NOTE: this file should be included first, since it defines the
+  // _FILE_OFFSET_BITS constant. This constant has to be defined
+  // before including any STL header files to avoid conflicts.
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "NgramCounter.h"
+#include "WorkerThreadPool.h"
+#include "lm_ienc.h"
+#include "options.h"
+#include "ErrorDefs.h"
+#include "ctimer.h"
+#ifdef HAVE_LEVELDB_LIB
+#include "LevelDbNgramTable.h"
+#endif
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+//--------------- Constants ------------------------------------------
+
+#define COUNT_NGRAMS_BLOCK_SIZE 100000
+
+//--------------- Type definitions -----------------------------------
+
+struct thot_count_ngrams_pars
+{
+  std::string corpusFileName;
+  std::string outputFileName;
+  std::string levelDbFileName;
+  std::string tmpDir;
+  unsigned int order;
+  unsigned int numThreads;
+  unsigned int maxEntriesInMem;
+  bool unk;
+  int verbosity;
+
+  thot_count_ngrams_pars()
+    {
+      tmpDir="/tmp";
+      numThreads=1;
+      maxEntriesInMem=NGRAM_COUNTER_MAX_ENTRIES_DEFAULT;
+      unk=false;
+      verbosity=0;
+    }
+};
+
+    // Data of the tasks encoding a block of sentences
+struct EncodingTaskData
+{
+  const std::vector<std::string>* linesPtr;
+  std::vector<std::vector<WordIndex> >* sentencesPtr;
+  lm_ienc* encoderPtr;
+  unsigned int numTasks;
+      // Positions (sentence and word) and strings of the words not
+      // found in the vocabulary by each task
+  std::vector<std::vector<std::pair<std::pair<size_t,size_t>,std::string> > > unknownWordsVec;
+};
+
+//--------------- Classes --------------------------------------------
+
+//--------------- NgramCountPrinter class
+
+class NgramCountPrinter: public NgramCounter::NgramCountHandler
+{
+ public:
+  NgramCountPrinter(FILE* _outFile,
+                    const std::vector<std::string>* _vocabStrsPtr):outFile(_outFile),vocabStrsPtr(_vocabStrsPtr){}
+
+  int handleNgram(const WordIndex* ngram,
+                  unsigned int len,
+                  NgramCounter::NgramCount histCount,
+                  NgramCounter::NgramCount count)
+  {
+    for(unsigned int i=0;i<len;++i)
+    {
+      fputs((*vocabStrsPtr)[ngram[i]].c_str(),outFile);
+      fputc(' ',outFile);
+    }
+    if(fprintf(outFile,"%llu %llu\n",histCount,count)<0)
+    {
+      std::cerr<<"Error while writing n-gram counts"<<std::endl;
+      return THOT_ERROR;
+    }
+    return THOT_OK;
+  }
+
+ private:
+  FILE* outFile;
+  const std::vector<std::string>* vocabStrsPtr;
+};
+
+#ifdef HAVE_LEVELDB_LIB
+//--------------- NgramCountLevelDbStorer class
+
+class NgramCountLevelDbStorer: public NgramCounter::NgramCountHandler
+{
+ public:
+  NgramCountLevelDbStorer(LevelDbNgramTable* _levelDbNtPtr):levelDbNtPtr(_levelDbNtPtr){}
+
+  int handleNgram(const WordIndex* ngram,
+                  unsigned int len,
+                  NgramCounter::NgramCount histCount,
+                  NgramCounter::NgramCount count)
+  {
+    std::vector<WordIndex> src(ngram,ngram+len-1);
+    im_pair<Count,Count> inf;
+    inf.first=(float)histCount;
+    inf.second=(float)count;
+    levelDbNtPtr->addTableEntry(src,ngram[len-1],inf);
+    return THOT_OK;
+  }
+
+ private:
+  LevelDbNgramTable* levelDbNtPtr;
+};
+#endif
+
+//--------------- Function Declarations ------------------------------
+
+int count_ngrams(const thot_count_ngrams_pars& pars);
+int read_block(std::ifstream& corpusFile,
+               std::vector<std::string>& lines);
+void encode_block(const std::vector<std::string>& lines,
+                  WorkerThreadPool& workerPool,
+                  lm_ienc& encoder,
+                  WordIndex& maxWordIdx,
+                  std::vector<std::vector<WordIndex> >& sentences);
+void encodingTask(void* data,
+                  unsigned int taskIdx,
+                  unsigned int workerIdx);
+void replace_first_word_occurrences_by_unk(std::vector<std::vector<WordIndex> >& sentences,
+                                           std::vector<bool>& wordSeen);
+void get_vocab_strings(lm_ienc& encoder,
+                       WordIndex maxWordIdx,
+                       std::vector<std::string>& vocabStrs);
+int print_counts(const thot_count_ngrams_pars& pars,
+                 const std::vector<std::string>& vocabStrs,
+                 NgramCounter& ngramCounter);
+#ifdef HAVE_LEVELDB_LIB
+int store_counts_in_leveldb(const thot_count_ngrams_pars& pars,
+                            const std::vector<std::string>& vocabStrs,
+                            NgramCounter& ngramCounter);
+#endif
+int handleParameters(int argc,
+                     char *argv[],
+                     thot_count_ngrams_pars& pars);
+int takeParameters(int argc,
+                   char *argv[],
+                   thot_count_ngrams_pars& pars);
+int checkParameters(const thot_count_ngrams_pars& pars);
+void printUsage(void);
+void version(void);
+
+//--------------- Function Definitions -------------------------------
+
+//--------------- main function
+int main(int argc, char *argv[])
+{
+  thot_count_ngrams_pars pars;
+
+  if(handleParameters(argc,argv,pars)==THOT_ERROR)
+    return THOT_ERROR;
+  else
+    return count_ngrams(pars);
+}
+
+//--------------------------------
+int count_ngrams(const thot_count_ngrams_pars& pars)
+{
+  double prevElapsedTime,elapsedTime,ucpu,scpu;
+  ctimer(&prevElapsedTime,&ucpu,&scpu);
+
+      // Open corpus file
+  std::ifstream corpusFile(pars.corpusFileName.c_str());
+  if(!corpusFile)
+  {
+    std::cerr<<"Error while opening file with training sentences: "<<pars.corpusFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Initialize n-gram counter
+  NgramCounter ngramCounter;
+  if(ngramCounter.setOrder(pars.order)==THOT_ERROR)
+    return THOT_ERROR;
+  ngramCounter.setNumThreads(pars.numThreads);
+  ngramCounter.setMaxEntriesInMem(pars.maxEntriesInMem);
+  ngramCounter.setTmpDir(pars.tmpDir);
+
+      // Count n-grams of each block of sentences
+  WorkerThreadPool workerPool(pars.numThreads);
+  lm_ienc encoder;
+  WordIndex maxWordIdx=SP_SYM1_LM;
+  std::vector<bool> wordSeen;
+  std::vector<std::string> lines;
+  std::vector<std::vector<WordIndex> > sentences;
+  size_t numSents=0;
+  while(read_block(corpusFile,lines))
+  {
+    encode_block(lines,workerPool,encoder,maxWordIdx,sentences);
+    if(pars.unk)
+      replace_first_word_occurrences_by_unk(sentences,wordSeen);
+
+    if(ngramCounter.addSentences(sentences)==THOT_ERROR)
+      return THOT_ERROR;
+
+    numSents+=lines.size();
+    if(pars.verbosity)
+      std::cerr<<"Processed "<<numSents<<" sentences ("<<ngramCounter.numEntriesInMem()<<" n-grams in memory, "<<ngramCounter.numRunFiles()<<" temporary files)"<<std::endl;
+  }
+
+      // Obtain strings of the vocabulary
+  std::vector<std::string> vocabStrs;
+  get_vocab_strings(encoder,maxWordIdx,vocabStrs);
+
+      // Merge and print counts
+  int ret;
+#ifdef HAVE_LEVELDB_LIB
+  if(!pars.levelDbFileName.empty())
+    ret=store_counts_in_leveldb(pars,vocabStrs,ngramCounter);
+  else
+#endif
+    ret=print_counts(pars,vocabStrs,ngramCounter);
+
+  ctimer(&elapsedTime,&ucpu,&scpu);
+  if(pars.verbosity)
+    std::cerr<<"Elapsed time: "<<elapsedTime-prevElapsedTime<<" secs"<<std::endl;
+
+  return ret;
+}
+
+//--------------------------------
+int read_block(std::ifstream& corpusFile,
+               std::vector<std::string>& lines)
+{
+  lines.clear();
+  std::string line;
+  while(lines.size()<COUNT_NGRAMS_BLOCK_SIZE && std::getline(corpusFile,line))
+    lines.push_back(line);
+  return !lines.empty();
+}
+
+//--------------------------------
+void encode_block(const std::vector<std::string>& lines,
+                  WorkerThreadPool& workerPool,
+                  lm_ienc& encoder,
+                  WordIndex& maxWordIdx,
+                  std::vector<std::vector<WordIndex> >& sentences)
+{
+      // Split and encode lines in parallel, words not present in the
+      // vocabulary are collected by each task
+  sentences.resize(lines.size());
+  EncodingTaskData taskData;
+  taskData.linesPtr=&lines;
+  taskData.sentencesPtr=&sentences;
+  taskData.encoderPtr=&encoder;
+  taskData.numTasks=workerPool.getNumThreads();
+  taskData.unknownWordsVec.resize(taskData.numTasks);
+  workerPool.run(taskData.numTasks,encodingTask,&taskData);
+
+      // Add new words to the vocabulary in the order in which they
+      // appear in the corpus
+  for(unsigned int t=0;t<taskData.unknownWordsVec.size();++t)
+  {
+    for(size_t i=0;i<taskData.unknownWordsVec[t].size();++i)
+    {
+      const std::pair<size_t,size_t>& pos=taskData.unknownWordsVec[t][i].first;
+      const std::string& word=taskData.unknownWordsVec[t][i].second;
+      WordIndex wordIdx;
+      if(!encoder.HighTrg_to_Trg(word,wordIdx))
+      {
+        wordIdx=encoder.genHTrgCode(word);
+        encoder.addHTrgCode(word,wordIdx);
+        if(maxWordIdx<wordIdx) maxWordIdx=wordIdx;
+      }
+      sentences[pos.first][pos.second]=wordIdx;
+    }
+  }
+}
+
+//--------------------------------
+void encodingTask(void* data,
+                  unsigned int taskIdx,
+                  unsigned int /*workerIdx*/)
+{
+  EncodingTaskData* taskDataPtr=(EncodingTaskData*) data;
+  const std::vector<std::string>& lines=*taskDataPtr->linesPtr;
+  std::vector<std::pair<std::pair<size_t,size_t>,std::string> >& unknownWords=taskDataPtr->unknownWordsVec[taskIdx];
+  size_t first=(lines.size()*taskIdx)/taskDataPtr->numTasks;
+  size_t last=(lines.size()*(taskIdx+1))/taskDataPtr->numTasks;
+
+  std::string word;
+  for(size_t s=first;s<last;++s)
+  {
+        // Words are separated by blanks
+    std::vector<WordIndex>& sentence=(*taskDataPtr->sentencesPtr)[s];
+    sentence.clear();
+    const std::string& line=lines[s];
+    size_t i=0;
+    while(i<line.size())
+    {
+      while(i<line.size() && (line[i]==' ' || line[i]=='\t'))
+        ++i;
+      size_t start=i;
+      while(i<line.size() && line[i]!=' ' && line[i]!='\t')
+        ++i;
+      if(i>start)
+      {
+        word.assign(line,start,i-start);
+        WordIndex wordIdx;
+        if(!taskDataPtr->encoderPtr->HighTrg_to_Trg(word,wordIdx))
+          unknownWords.push_back(std::make_pair(std::make_pair(s,sentence.size()),word));
+        sentence.push_back(wordIdx);
+      }
+    }
+  }
+}
+
+//--------------------------------
+void replace_first_word_occurrences_by_unk(std::vector<std::vector<WordIndex> >& sentences,
+                                           std::vector<bool>& wordSeen)
+{
+  for(size_t s=0;s<sentences.size();++s)
+  {
+    for(size_t i=0;i<sentences[s].size();++i)
+    {
+      WordIndex wordIdx=sentences[s][i];
+      if(wordIdx>=wordSeen.size())
+        wordSeen.resize(wordIdx+1,false);
+      if(!wordSeen[wordIdx])
+      {
+        wordSeen[wordIdx]=true;
+        sentences[s][i]=UNK_SYMBOL;
+      }
+    }
+  }
+}
+
+//--------------------------------
+void get_vocab_strings(lm_ienc& encoder,
+                       WordIndex maxWordIdx,
+                       std::vector<std::string>& vocabStrs)
+{
+  vocabStrs.clear();
+  vocabStrs.resize(maxWordIdx+1);
+  for(WordIndex wordIdx=0;wordIdx<=maxWordIdx;++wordIdx)
+    encoder.Trg_to_HighTrg(wordIdx,vocabStrs[wordIdx]);
+}
+
+//--------------------------------
+int print_counts(const thot_count_ngrams_pars& pars,
+                 const std::vector<std::string>& vocabStrs,
+                 NgramCounter& ngramCounter)
+{
+  FILE* outFile=stdout;
+  if(!pars.outputFileName.empty())
+  {
+    outFile=fopen(pars.outputFileName.c_str(),"w");
+    if(outFile==NULL)
+    {
+      std::cerr<<"Error while opening output file: "<<pars.outputFileName<<std::endl;
+      return THOT_ERROR;
+    }
+  }
+
+  NgramCountPrinter printer(outFile,&vocabStrs);
+  int ret=ngramCounter.extractCounts(printer);
+
+  if(outFile!=stdout)
+  {
+    if(fclose(outFile)!=0)
+    {
+      std::cerr<<"Error while writing output file: "<<pars.outputFileName<<std::endl;
+      ret=THOT_ERROR;
+    }
+  }
+  else
+    fflush(stdout);
+
+  return ret;
+}
+
+#ifdef HAVE_LEVELDB_LIB
+//--------------------------------
+int store_counts_in_leveldb(const thot_count_ngrams_pars& pars,
+                            const std::vector<std::string>& vocabStrs,
+                            NgramCounter& ngramCounter)
+{
+  LevelDbNgramTable levelDbNt;
+  if(levelDbNt.init(pars.levelDbFileName)==THOT_ERROR)
+  {
+    std::cerr<<"Cannot create or recreate database (LevelDB) for language model"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  levelDbNt.startBulkLoad();
+  NgramCountLevelDbStorer storer(&levelDbNt);
+  if(ngramCounter.extractCounts(storer)==THOT_ERROR)
+    return THOT_ERROR;
+  if(levelDbNt.endBulkLoad()==THOT_ERROR)
+  {
+    std::cerr<<"Error while writing n-gram counts to database (LevelDB)"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Save vocabulary (with the format used by
+      // thot_ngram_to_leveldb)
+  std::map<std::string,WordIndex> vocab;
+  for(WordIndex wordIdx=0;wordIdx<vocabStrs.size();++wordIdx)
+    vocab[vocabStrs[wordIdx]]=wordIdx;
+  std::string vocabFileName=pars.levelDbFileName+".ldb_vcb";
+  std::ofstream vocabFile(vocabFileName.c_str());
+  if(!vocabFile)
+  {
+    std::cerr<<"Error while opening vocabulary file: "<<vocabFileName<<std::endl;
+    return THOT_ERROR;
+  }
+  for(std::map<std::string,WordIndex>::const_iterator iter=vocab.begin();iter!=vocab.end();++iter)
+    vocabFile<<iter->first<<" "<<iter->second<<std::endl;
+
+  return THOT_OK;
+}
+#endif
+
+//--------------------------------
+int handleParameters(int argc,
+                     char *argv[],
+                     thot_count_ngrams_pars& pars)
+{
+  if(argc==1 || readOption(argc,argv,"--version")!=-1)
+  {
+    version();
+    return THOT_ERROR;
+  }
+  if(readOption(argc,argv,"--help")!=-1)
+  {
+    printUsage();
+    return THOT_ERROR;
+  }
+  if(takeParameters(argc,argv,pars)==THOT_ERROR)
+  {
+    return THOT_ERROR;
+  }
+  else
+  {
+    if(checkParameters(pars)==THOT_OK)
+      return THOT_OK;
+    else
+      return THOT_ERROR;
+  }
+}
+
+//--------------------------------
+int takeParameters(int argc,
+                   char *argv[],
+                   thot_count_ngrams_pars& pars)
+{
+  int err=readSTLstring(argc,argv, "-c", &pars.corpusFileName);
+  if(err==-1)
+  {
+    std::cerr<<"Error: parameter -c not given!"<<std::endl;
+    printUsage();
+    return THOT_ERROR;
+  }
+
+  err=readUnsignedInt(argc,argv, "-n", &pars.order);
+  if(err==-1)
+  {
+    std::cerr<<"Error: parameter -n not given!"<<std::endl;
+    printUsage();
+    return THOT_ERROR;
+  }
+
+  readSTLstring(argc,argv, "-o", &pars.outputFileName);
+  readSTLstring(argc,argv, "-ldb", &pars.levelDbFileName);
+  readSTLstring(argc,argv, "-tdir", &pars.tmpDir);
+  readUnsignedInt(argc,argv, "-nt", &pars.numThreads);
+  readUnsignedInt(argc,argv, "-m", &pars.maxEntriesInMem);
+
+  if(readOption(argc,argv,"-unk")!=-1)
+    pars.unk=true;
+
+  if(readOption(argc,argv,"-v")!=-1)
+    pars.verbosity=1;
+
+  return THOT_OK;
+}
+
+//--------------------------------
+int checkParameters(const thot_count_ngrams_pars& pars)
+{
+  if(pars.order==0 || pars.order>NGRAM_COUNTER_MAX_ORDER)
+  {
+    std::cerr<<"Error: the order of the n-grams should be between 1 and "<<NGRAM_COUNTER_MAX_ORDER<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(pars.numThreads==0)
+  {
+    std::cerr<<"Error: the number of threads should be greater than zero"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(!pars.levelDbFileName.empty())
+  {
+#ifdef HAVE_LEVELDB_LIB
+    if(!pars.outputFileName.empty())
+    {
+      std::cerr<<"Error: -o and -ldb parameters cannot be given simultaneously"<<std::endl;
+      return THOT_ERROR;
+    }
+#else
+    std::cerr<<"Error: -ldb parameter given but thot was compiled without LevelDB support"<<std::endl;
+    return THOT_ERROR;
+#endif
+  }
+
+  return THOT_OK;
+}
+
+//--------------------------------
+void printUsage(void)
+{
+  std::cerr<<"thot_count_ngrams -c <string> -n <int> [-unk]"<<std::endl;
+  std::cerr<<"                  [-o <string> | -ldb <string>] [-nt <int>]"<<std::endl;
+  std::cerr<<"                  [-tdir <string>] [-m <int>] [-v]"<<std::endl;
+  std::cerr<<"                  [--help] [--version]"<<std::endl;
+  std::cerr<<std::endl;
+  std::cerr<<"-c <string>     : Corpus file."<<std::endl;
+  std::cerr<<"-n <int>        : Order of the n-grams."<<std::endl;
+  std::cerr<<"-unk            : Reserve probability mass for the unknown word."<<std::endl;
+  std::cerr<<"-o <string>     : Output file with the n-gram counts (they are printed"<<std::endl;
+  std::cerr<<"                  to the standard output if not given)."<<std::endl;
+  std::cerr<<"-ldb <string>   : Store the n-gram counts in a LevelDB language model"<<std::endl;
+  std::cerr<<"                  with the given prefix instead of printing them."<<std::endl;
+  std::cerr<<"-nt <int>       : Number of threads (1 by default)."<<std::endl;
+  std::cerr<<"-tdir <string>  : Directory for temporary files (/tmp by default)."<<std::endl;
+  std::cerr<<"-m <int>        : Maximum number of n-grams kept in memory before they"<<std::endl;
+  std::cerr<<"                  are sorted and written to temporary files ("<<NGRAM_COUNTER_MAX_ENTRIES_DEFAULT<<" by"<<std::endl;
+  std::cerr<<"                  default)."<<std::endl;
+  std::cerr<<"-v              : Verbose mode."<<std::endl;
+  std::cerr<<"--help          : Display this help and exit."<<std::endl;
+  std::cerr<<"--version       : Output version information and exit."<<std::endl;
+}
+
+//--------------------------------
+void version(void)
+{
+  std::cerr<<"thot_count_ngrams is part of the thot package "<<std::endl;
+  std::cerr<<"thot version "<<THOT_VERSION<<std::endl;
+  std::cerr<<"thot is GNU software written by Daniel Ortiz"<<std::endl;
+}
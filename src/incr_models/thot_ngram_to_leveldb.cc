@@ -146,6 +146,9 @@ int process_ttable(void)
             return THOT_ERROR;
         }
 
+        // Entries are written in large batches sorted by key
+        levelDbNt.startBulkLoad();
+
         // Define language model constants
         vocab[UNK_SYMBOL_STR] = UNK_SYMBOL;
         vocab[BOS_STR] = S_BEGIN;
@@ -174,6 +177,12 @@ int process_ttable(void)
                 std::cerr << "Processed " << i << " lines" << std::endl;
         }
 
+        if(levelDbNt.endBulkLoad() == THOT_ERROR)
+        {
+            std::cerr << "Error while writing entries to database (LevelDB)" << std::endl;
+            return THOT_ERROR;
+        }
+
         std::cerr << "levelDB size: " << levelDbNt.size() << std::endl;
 
         // Save vocabulary
@@ -0,0 +1,170 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file ArenaAllocator.h
+ *
+ * @brief Defines the ArenaAllocator class, an allocator for STL
+ * containers that obtains memory from a MonotonicArena. Deallocation
+ * does nothing, memory is reclaimed when the arena is released, so
+ * containers using the allocator should not outlive the data stored
+ * in the arena. Default-constructed allocators are not linked to any
+ * arena and use the global operators new and delete.
+ */
+
+#ifndef _ArenaAllocator_h
+#define _ArenaAllocator_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "MonotonicArena.h"
+#include <stddef.h>
+#include <new>
+#if __cplusplus >= 201103L
+# include <type_traits>
+# include <utility>
+#endif
+
+//--------------- Constants ------------------------------------------
+
+#ifdef __GNUC__
+# define ARENA_ALLOCATOR_ALIGNMENT(T) __alignof__(T)
+#else
+# define ARENA_ALLOCATOR_ALIGNMENT(T) sizeof(double)
+#endif
+
+//--------------- Classes --------------------------------------------
+
+//--------------- ArenaAllocator class
+
+template<class T>
+class ArenaAllocator
+{
+ public:
+
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+#if __cplusplus >= 201103L
+      // The allocator is propagated when the contents of the
+      // containers are moved, so memory is always returned to its
+      // owner. Copies keep their own allocator, since they may
+      // outlive the arena (see select_on_container_copy_construction)
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+#endif
+
+  template<class U>
+  struct rebind
+  {
+    typedef ArenaAllocator<U> other;
+  };
+
+      // Constructors
+  ArenaAllocator(void):arenaPtr(NULL){}
+  explicit ArenaAllocator(MonotonicArena* _arenaPtr):arenaPtr(_arenaPtr){}
+  template<class U>
+  ArenaAllocator(const ArenaAllocator<U>& other):arenaPtr(other.getArenaPtr()){}
+
+      // Allocation functions
+  pointer allocate(size_type n,
+                   const void* /*hint*/=0)
+  {
+    if(arenaPtr)
+      return (pointer) arenaPtr->allocate(n*sizeof(T),ARENA_ALLOCATOR_ALIGNMENT(T));
+    else
+      return (pointer) ::operator new(n*sizeof(T));
+  }
+  void deallocate(pointer p,
+                  size_type /*n*/)
+  {
+    if(!arenaPtr)
+      ::operator delete(p);
+  }
+
+      // Object construction functions
+  void construct(pointer p,
+                 const T& val)
+  {
+    new((void*) p) T(val);
+  }
+  void destroy(pointer p)
+  {
+    p->~T();
+  }
+#if __cplusplus >= 201103L
+  template<class U,class... Args>
+  void construct(U* p,
+                 Args&&... args)
+  {
+    new((void*) p) U(std::forward<Args>(args)...);
+  }
+  template<class U>
+  void destroy(U* p)
+  {
+    p->~U();
+  }
+#endif
+
+  pointer address(reference x)const{return &x;}
+  const_pointer address(const_reference x)const{return &x;}
+  size_type max_size(void)const{return ((size_type)-1)/sizeof(T);}
+
+  MonotonicArena* getArenaPtr(void)const{return arenaPtr;}
+
+      // Copy-constructed containers (e.g. score components stored in
+      // n-best lists or word graphs) use the global operators new and
+      // delete, so they remain valid after the arena is released
+  ArenaAllocator select_on_container_copy_construction(void)const
+  {
+    return ArenaAllocator();
+  }
+
+ private:
+
+  MonotonicArena* arenaPtr;
+};
+
+//--------------- Function definitions
+
+template<class T,class U>
+bool operator==(const ArenaAllocator<T>& left,
+                const ArenaAllocator<U>& right)
+{
+  return left.getArenaPtr()==right.getArenaPtr();
+}
+
+//---------------------------------
+template<class T,class U>
+bool operator!=(const ArenaAllocator<T>& left,
+                const ArenaAllocator<U>& right)
+{
+  return left.getArenaPtr()!=right.getArenaPtr();
+}
+
+#endif
@@ -42,6 +42,28 @@ namespace BasicSocketUtils
 #endif
   }
 
+  //---------------
+  int recvAll(int s,char *buff,int len)
+  {
+    int received=0;
+    while(received<len)
+    {
+      int numbytes=recv(s,buff+received,len-received,0);
+      if(numbytes==-1)
+      {
+        if(errno==EINTR)
+          continue;
+            // recv() call
+        std::cerr<<"recv() error!"<<std::endl;
+        throw std::runtime_error("Socket error: recv() failed");
+      }
+      if(numbytes==0)
+        throw std::runtime_error("Socket error: connection closed by peer");
+      received+=numbytes;
+    }
+    return received;
+  }
+
   //---------------
   int recvStr(int s,char *str)
   {
@@ -50,13 +72,16 @@ namespace BasicSocketUtils
     numbytes=recvInt(s);
     if(numbytes>0)
     {
-      if ((numbytes=recv(s,str,numbytes,0)) == -1)
+      try
+      {
+        recvAll(s,str,numbytes);
+      }
+      catch(const std::exception& e)
       {
-            // recv() call
-        std::cerr<<"recv() error!"<<std::endl;
         throw std::runtime_error("Socket error: Cannot read string");
       }
     }
+    else numbytes=0;
     str[numbytes] = '\0';
     return numbytes;
   }
@@ -65,43 +90,42 @@ namespace BasicSocketUtils
   int recvStlStr(int s,std::string& stlstr)
   {
     int  numbytes;
-    char* str=NULL;
 
     numbytes=recvInt(s);
-    str=(char*) mem_alloc_utils::my_realloc(str,(numbytes+1)*sizeof(char));
     if(numbytes>0)
     {
-      if ((numbytes=recv(s,str,numbytes,0)) == -1)
+      stlstr.resize(numbytes);
+      try
+      {
+        recvAll(s,&stlstr[0],numbytes);
+      }
+      catch(const std::exception& e)
       {
-            // recv() call
-        std::cerr<<"recv() error!"<<std::endl;
-        free(str);
         throw std::runtime_error("Socket error: Cannot read STL string");
       }
     }
-    str[numbytes] = '\0';
-    stlstr=str;
-    free(str);
+    else
+    {
+      numbytes=0;
+      stlstr.clear();
+    }
     return numbytes;
   }
 
   //---------------
   int recvInt(int s)
   {
-    int numbytes;
     int receivedInt;
 
-    if ((numbytes=recv(s,(char*)&receivedInt,sizeof(int),0)) == -1)
+    try
     {
-          // recv() call
-      std::cerr<<"recv() error!"<<std::endl;
-      throw std::runtime_error("Socket error: Cannot read integer");
+      recvAll(s,(char*)&receivedInt,sizeof(int));
     }
-    else
+    catch(const std::exception& e)
     {
-      receivedInt=ntohl(receivedInt);
+      throw std::runtime_error("Socket error: Cannot read integer");
     }
-    return receivedInt;
+    return ntohl(receivedInt);
   }
 
   //---------------
@@ -124,17 +148,42 @@ namespace BasicSocketUtils
   }
 
   //--------------------------
-  int writeInt(int fd,int i)
+  int writeAll(int fd,const char* buff,int len)
   {
-    int ret;
+    int written=0;
+    while(written<len)
+    {
+#ifdef MSG_NOSIGNAL
+          // Writing to a connection closed by the peer should not
+          // raise SIGPIPE
+      int ret=send(fd,buff+written,len-written,MSG_NOSIGNAL);
+#else
+      int ret=write(fd,buff+written,len-written);
+#endif
+      if(ret==-1)
+      {
+        if(errno==EINTR)
+          continue;
+        std::cerr<<"write() error"<<std::endl;
+        throw std::runtime_error("Socket error: write() failed");
+      }
+      written+=ret;
+    }
+    return written;
+  }
 
+  //--------------------------
+  int writeInt(int fd,int i)
+  {
     i=htonl(i);
-    if((ret=write(fd,(char*) &i,sizeof(i)))==-1)
+    try
+    {
+      return writeAll(fd,(char*) &i,sizeof(i));
+    }
+    catch(const std::exception& e)
     {
-      std::cerr<<"write() error"<<std::endl;
       throw std::runtime_error("Socket error: Cannot write integer");
     }
-    return ret;
   }
   //--------------------------
   int writeStr(int fd,const char* s)
@@ -146,15 +195,28 @@ namespace BasicSocketUtils
     ret+=writeInt(fd,numbytes);
     if(numbytes>0)
     {
-     if((ret+=write(fd,(char*) s,numbytes))==-1)
-     {
-       std::cerr<<"write() error"<<std::endl;
-       throw std::runtime_error("Socket error: Cannot write string");
-     }
+      try
+      {
+        ret+=writeAll(fd,s,numbytes);
+      }
+      catch(const std::exception& e)
+      {
+        throw std::runtime_error("Socket error: Cannot write string");
+      }
     }
     return ret;
   }
 
+  //---------------
+  void setTcpNoDelay(int fd)
+  {
+        // Requests and answers are small messages written in several
+        // calls, Nagle's algorithm would delay them when the connection
+        // is kept open between requests
+    int yes=1;
+    setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,(char*) &yes,sizeof(int));
+  }
+
   //---------------
   void connect(const char *dirServ,
                unsigned int port,
@@ -192,6 +254,7 @@ namespace BasicSocketUtils
        std::cerr<<"connect() error\n";
        throw std::runtime_error("Error while establishing connection");
      }
+     setTcpNoDelay(fileDesc);
   }
 
   //---------------
@@ -51,6 +51,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <netdb.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <netinet/tcp.h>
 #endif
 /* netbd.h contains the declaration of the hostent struct */
 
@@ -64,11 +65,16 @@ namespace BasicSocketUtils
 {
       // Basic socket functions
   int init(void);
+      // Read or write exactly len bytes, an exception is thrown if the
+      // connection is closed or an error occurs
+  int recvAll(int s,char *buff,int len);
+  int writeAll(int fd,const char* buff,int len);
   int recvStr(int s,char *str);
   int recvStlStr(int s,std::string& stlstr);
   int recvInt(int s);
   int writeInt(int fd,int i);
   int writeStr(int fd,const char* s);
+  void setTcpNoDelay(int fd);
   void connect(const char *dirServ,
                unsigned int port,
                int& fileDesc);
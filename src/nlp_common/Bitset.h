@@ -41,6 +41,30 @@ bool operator < (const Bitset<N> &left,const Bitset<N> &right);
 template<size_t N>
 bool operator > (const Bitset<N> &left,const Bitset<N> &right);
 
+template<size_t N>
+size_t bitsetHash(const Bitset<N> &bs);
+
+template<size_t N>
+size_t bitsetFindNext(const Bitset<N> &bs,size_t n,bool val);
+
+//-------------------------
+template<size_t N>
+size_t bitsetHash(const Bitset<N> &bs)
+{
+  return std::hash<std::bitset<N> >()(bs);
+}
+
+//-------------------------
+template<size_t N>
+size_t bitsetFindNext(const Bitset<N> &bs,size_t n,bool val)
+{
+  for(;n<N;++n)
+  {
+    if(bs.test(n)==val) return n;
+  }
+  return N;
+}
+
 //-------------------------
 template<size_t N>
 bool operator< (const Bitset<N> &left,const Bitset<N> &right)
@@ -92,6 +116,14 @@ bool operator < (const Bitset<N> &left,const Bitset<N> &right);
 template<size_t N>
 bool operator > (const Bitset<N> &left,const Bitset<N> &right);
 
+template<size_t N>
+size_t bitsetHash(const Bitset<N> &bs);
+
+template<size_t N>
+size_t bitsetFindNext(const Bitset<N> &bs,size_t n,bool val);
+    // Returns the position of the first bit at position n or higher
+    // whose value is val, or N if there is no such bit
+
 //--------------- Classes --------------------------------------------
 
 //--------------- Bitset template class
@@ -108,6 +140,8 @@ class Bitset
   bool operator!= (const Bitset<N> &right)const;
   friend bool operator < <N> (const Bitset<N> &left,const Bitset<N> &right);
   friend bool operator > <N> (const Bitset<N> &left,const Bitset<N> &right);
+  friend size_t bitsetHash <N> (const Bitset<N> &bs);
+  friend size_t bitsetFindNext <N> (const Bitset<N> &bs,size_t n,bool val);
   Bitset<N>& reset(void);
   Bitset<N>& set(void);
   Bitset<N>& reset(size_t n);
@@ -487,6 +521,53 @@ bool operator> (const Bitset<N> &left,const Bitset<N> &right)
  return false;
 }
 
+//-------------------------
+template<size_t N>
+size_t bitsetHash(const Bitset<N> &bs)
+{
+      // Combine the words of the bitset (multiplicative hashing with a
+      // 64-bit odd constant)
+  unsigned long long h=NUM_WORDS(N);
+  for(unsigned int i=0;i<NUM_WORDS(N);++i)
+  {
+    h=(h^bs.words[i])*0x9E3779B97F4A7C15ULL;
+    h^=h>>29;
+  }
+  return (size_t) h;
+}
+
+//-------------------------
+template<size_t N>
+size_t bitsetFindNext(const Bitset<N> &bs,size_t n,bool val)
+{
+  if(n>=N) return N;
+
+      // Scan the bitset one word at a time, the bits of each word are
+      // complemented when searching for unset bits
+  unsigned int i=n/(NUM_BITS_INT);
+  unsigned int w=val ? bs.words[i] : ~bs.words[i];
+  w&=UINT_MAX<<(n%(NUM_BITS_INT));
+  while(w==0)
+  {
+    ++i;
+    if(i>=NUM_WORDS(N)) return N;
+    w=val ? bs.words[i] : ~bs.words[i];
+  }
+
+      // Obtain position of the lowest bit set in w
+  size_t pos=i*NUM_BITS_INT;
+#ifdef __GNUC__
+  pos+=__builtin_ctz(w);
+#else
+  while((w&1)==0)
+  {
+    w=w>>1;
+    ++pos;
+  }
+#endif
+  return pos<N ? pos : N;
+}
+
 //-------------------------
 template<size_t N>
 std::ostream& operator << (std::ostream &outS,const Bitset<N> &bs)
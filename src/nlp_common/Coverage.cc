@@ -0,0 +1,374 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file Coverage.cc
+ *
+ * @brief Definitions file for Coverage.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "Coverage.h"
+
+//--------------- Coverage class functions
+
+Coverage::Coverage(void)
+{
+  numWords=COVERAGE_INLINE_WORDS;
+  for(unsigned int i=0;i<COVERAGE_INLINE_WORDS;++i)
+    inlineWords[i]=0;
+}
+
+//---------------------------------------
+Coverage::Coverage(const Coverage& right)
+{
+  numWords=right.numWords;
+  if(numWords>COVERAGE_INLINE_WORDS)
+    heapWords=new Word[numWords];
+  Word* words=wordPtr();
+  const Word* rightWords=right.wordPtr();
+  for(unsigned int i=0;i<numWords;++i)
+    words[i]=rightWords[i];
+}
+
+//---------------------------------------
+Coverage& Coverage::operator=(const Coverage& right)
+{
+  if(this!=&right)
+  {
+        // Storage is only reallocated if the words of right do not
+        // fit into the current one
+    if(right.numWords>numWords)
+    {
+      if(numWords>COVERAGE_INLINE_WORDS)
+        delete[] heapWords;
+      numWords=right.numWords;
+      heapWords=new Word[numWords];
+    }
+    Word* words=wordPtr();
+    const Word* rightWords=right.wordPtr();
+    for(unsigned int i=0;i<right.numWords;++i)
+      words[i]=rightWords[i];
+    for(unsigned int i=right.numWords;i<numWords;++i)
+      words[i]=0;
+  }
+  return *this;
+}
+
+//---------------------------------------
+bool Coverage::operator==(const Coverage& right)const
+{
+  const Word* words=wordPtr();
+  const Word* rightWords=right.wordPtr();
+  unsigned int i;
+  for(i=0;i<numWords && i<right.numWords;++i)
+  {
+    if(words[i]!=rightWords[i]) return false;
+  }
+  for(;i<numWords;++i)
+  {
+    if(words[i]!=0) return false;
+  }
+  for(;i<right.numWords;++i)
+  {
+    if(rightWords[i]!=0) return false;
+  }
+  return true;
+}
+
+//---------------------------------------
+bool Coverage::operator!=(const Coverage& right)const
+{
+  return !(*this==right);
+}
+
+//---------------------------------------
+bool Coverage::operator<(const Coverage& right)const
+{
+  const Word* words=wordPtr();
+  const Word* rightWords=right.wordPtr();
+  unsigned int n=numWords>right.numWords ? numWords : right.numWords;
+  for(unsigned int i=n;i>0;--i)
+  {
+    Word w=(i<=numWords) ? words[i-1] : 0;
+    Word rightw=(i<=right.numWords) ? rightWords[i-1] : 0;
+    if(w<rightw) return true;
+    if(rightw<w) return false;
+  }
+  return false;
+}
+
+//---------------------------------------
+bool Coverage::operator>(const Coverage& right)const
+{
+  return right<*this;
+}
+
+//---------------------------------------
+Coverage& Coverage::reset(void)
+{
+  Word* words=wordPtr();
+  for(unsigned int i=0;i<numWords;++i)
+    words[i]=0;
+  return *this;
+}
+
+//---------------------------------------
+Coverage& Coverage::setRange(size_t first,size_t last)
+{
+  if(first>last)
+    return *this;
+
+  size_t firstWord=first/COVERAGE_BITS_WORD;
+  size_t lastWord=last/COVERAGE_BITS_WORD;
+  if(lastWord>=numWords)
+    grow(lastWord+1);
+
+  Word* words=wordPtr();
+  Word firstMask=~(Word)0<<(first%COVERAGE_BITS_WORD);
+  Word lastMask=~(Word)0>>(COVERAGE_BITS_WORD-1-last%COVERAGE_BITS_WORD);
+  if(firstWord==lastWord)
+  {
+    words[firstWord]|=firstMask & lastMask;
+  }
+  else
+  {
+    words[firstWord]|=firstMask;
+    for(size_t i=firstWord+1;i<lastWord;++i)
+      words[i]=~(Word)0;
+    words[lastWord]|=lastMask;
+  }
+  return *this;
+}
+
+//---------------------------------------
+bool Coverage::anyInRange(size_t first,size_t last)const
+{
+  if(first>last || first/COVERAGE_BITS_WORD>=numWords)
+    return false;
+
+  size_t firstWord=first/COVERAGE_BITS_WORD;
+  size_t lastWord=last/COVERAGE_BITS_WORD;
+  Word lastMask=~(Word)0>>(COVERAGE_BITS_WORD-1-last%COVERAGE_BITS_WORD);
+  if(lastWord>=numWords)
+  {
+        // Positions beyond the storage are unset
+    lastWord=numWords-1;
+    lastMask=~(Word)0;
+  }
+
+  const Word* words=wordPtr();
+  Word firstMask=~(Word)0<<(first%COVERAGE_BITS_WORD);
+  if(firstWord==lastWord)
+    return (words[firstWord] & firstMask & lastMask)!=0;
+
+  if((words[firstWord] & firstMask)!=0)
+    return true;
+  for(size_t i=firstWord+1;i<lastWord;++i)
+  {
+    if(words[i]!=0) return true;
+  }
+  return (words[lastWord] & lastMask)!=0;
+}
+
+//---------------------------------------
+bool Coverage::allInRange(size_t first,size_t last)const
+{
+  if(first>last)
+    return true;
+  if(last/COVERAGE_BITS_WORD>=numWords)
+    return false;
+
+  size_t firstWord=first/COVERAGE_BITS_WORD;
+  size_t lastWord=last/COVERAGE_BITS_WORD;
+  const Word* words=wordPtr();
+  Word firstMask=~(Word)0<<(first%COVERAGE_BITS_WORD);
+  Word lastMask=~(Word)0>>(COVERAGE_BITS_WORD-1-last%COVERAGE_BITS_WORD);
+  if(firstWord==lastWord)
+    return (words[firstWord] & firstMask & lastMask)==(firstMask & lastMask);
+
+  if((words[firstWord] & firstMask)!=firstMask)
+    return false;
+  for(size_t i=firstWord+1;i<lastWord;++i)
+  {
+    if(words[i]!=~(Word)0) return false;
+  }
+  return (words[lastWord] & lastMask)==lastMask;
+}
+
+//---------------------------------------
+size_t Coverage::count(void)const
+{
+  const Word* words=wordPtr();
+  size_t c=0;
+  for(unsigned int i=0;i<numWords;++i)
+    c+=popcount(words[i]);
+  return c;
+}
+
+//---------------------------------------
+size_t Coverage::count(size_t J)const
+{
+  const Word* words=wordPtr();
+  size_t fullWords=J/COVERAGE_BITS_WORD;
+  size_t c=0;
+  for(size_t i=0;i<fullWords && i<numWords;++i)
+    c+=popcount(words[i]);
+  if(fullWords<numWords && J%COVERAGE_BITS_WORD!=0)
+    c+=popcount(words[fullWords] & ~(~(Word)0<<(J%COVERAGE_BITS_WORD)));
+  return c;
+}
+
+//---------------------------------------
+size_t Coverage::findNext(size_t n,bool val)const
+{
+  size_t i=n/COVERAGE_BITS_WORD;
+  if(i>=numWords)
+    return val ? COVERAGE_NPOS : n;
+
+      // Scan the bitset one word at a time, the bits of each word are
+      // complemented when searching for unset positions
+  const Word* words=wordPtr();
+  Word w=val ? words[i] : ~words[i];
+  w&=~(Word)0<<(n%COVERAGE_BITS_WORD);
+  while(w==0)
+  {
+    ++i;
+    if(i>=numWords)
+      return val ? COVERAGE_NPOS : i*COVERAGE_BITS_WORD;
+    w=val ? words[i] : ~words[i];
+  }
+  return i*COVERAGE_BITS_WORD+lowestBit(w);
+}
+
+//---------------------------------------
+size_t Coverage::hash(void)const
+{
+      // Combine the significant words of the bitset (multiplicative
+      // hashing with a 64-bit odd constant)
+  const Word* words=wordPtr();
+  size_t n=numSignificantWords();
+  uint64_t h=n;
+  for(size_t i=0;i<n;++i)
+  {
+    h=(h^words[i])*0x9E3779B97F4A7C15ULL;
+    h^=h>>29;
+  }
+  return (size_t) h;
+}
+
+//---------------------------------------
+size_t Coverage::capacity(void)const
+{
+  return (size_t)numWords*COVERAGE_BITS_WORD;
+}
+
+//---------------------------------------
+void Coverage::grow(size_t nwords)
+{
+      // Storage is at least doubled to amortize reallocations
+  size_t newNumWords=2*(size_t)numWords;
+  if(newNumWords<nwords)
+    newNumWords=nwords;
+
+  Word* newWords=new Word[newNumWords];
+  const Word* words=wordPtr();
+  for(unsigned int i=0;i<numWords;++i)
+    newWords[i]=words[i];
+  for(size_t i=numWords;i<newNumWords;++i)
+    newWords[i]=0;
+
+  if(numWords>COVERAGE_INLINE_WORDS)
+    delete[] heapWords;
+  heapWords=newWords;
+  numWords=newNumWords;
+}
+
+//---------------------------------------
+size_t Coverage::numSignificantWords(void)const
+{
+  const Word* words=wordPtr();
+  size_t n=numWords;
+  while(n>0 && words[n-1]==0)
+    --n;
+  return n;
+}
+
+//---------------------------------------
+size_t Coverage::popcount(Word w)
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(w);
+#else
+  size_t c=0;
+  while(w!=0)
+  {
+    w&=w-1;
+    ++c;
+  }
+  return c;
+#endif
+}
+
+//---------------------------------------
+size_t Coverage::lowestBit(Word w)
+{
+#ifdef __GNUC__
+  return __builtin_ctzll(w);
+#else
+  size_t pos=0;
+  while((w&1)==0)
+  {
+    w=w>>1;
+    ++pos;
+  }
+  return pos;
+#endif
+}
+
+//---------------------------------------
+std::ostream& operator<<(std::ostream& outS,const Coverage& cov)
+{
+  const Coverage::Word* words=cov.wordPtr();
+  size_t n=cov.numSignificantWords();
+  if(n==0)
+  {
+    outS<<0;
+    return outS;
+  }
+
+      // Print positions from the highest one set
+  size_t j=COVERAGE_BITS_WORD;
+  while(((words[n-1]>>(j-1)) & 1)==0)
+    --j;
+  for(size_t i=n;i>0;--i)
+  {
+    for(;j>0;--j)
+      outS<<((words[i-1]>>(j-1)) & 1);
+    j=COVERAGE_BITS_WORD;
+  }
+  return outS;
+}
+
+//---------------------------------------
+Coverage::~Coverage()
+{
+  if(numWords>COVERAGE_INLINE_WORDS)
+    delete[] heapWords;
+}
@@ -0,0 +1,171 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file Coverage.h
+ *
+ * @brief Defines the Coverage class, a bitset of dynamic length used
+ * to store the source positions covered by a hypothesis. Bits are
+ * stored in 64-bit words and all operations work on whole words.
+ * Sentences of up to MAX_SENTENCE_LENGTH_ALLOWED words are stored in
+ * an inline buffer, longer ones are stored in memory allocated on
+ * demand.
+ */
+
+#ifndef _Coverage_h
+#define _Coverage_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "SmtDefs.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <iostream>
+
+//--------------- Constants ------------------------------------------
+
+#define COVERAGE_BITS_WORD     64
+#define COVERAGE_INLINE_WORDS  ((MAX_SENTENCE_LENGTH_ALLOWED+COVERAGE_BITS_WORD)/COVERAGE_BITS_WORD)
+#define COVERAGE_NPOS          ((size_t)-1)
+
+//--------------- Classes --------------------------------------------
+
+//--------------- Coverage class
+
+class Coverage
+{
+ public:
+
+  typedef uint64_t Word;
+
+      // Constructors
+  Coverage(void);
+  Coverage(const Coverage& right);
+  Coverage& operator=(const Coverage& right);
+
+      // Comparison operators, positions beyond the storage of a
+      // bitset are considered to be unset. Bitsets are ordered by
+      // their numeric value
+  bool operator==(const Coverage& right)const;
+  bool operator!=(const Coverage& right)const;
+  bool operator<(const Coverage& right)const;
+  bool operator>(const Coverage& right)const;
+
+      // Functions to modify the bitset, the storage grows as needed
+  Coverage& reset(void);
+  Coverage& reset(size_t n);
+  Coverage& set(size_t n,int val=1);
+      // Sets the positions in the range [first,last]
+  Coverage& setRange(size_t first,size_t last);
+
+      // Functions to query the bitset
+  bool test(size_t n)const;
+      // Returns true if any (all) of the positions in the range
+      // [first,last] are set
+  bool anyInRange(size_t first,size_t last)const;
+  bool allInRange(size_t first,size_t last)const;
+      // Returns the number of positions set, or the number of
+      // positions lower than J that are set
+  size_t count(void)const;
+  size_t count(size_t J)const;
+      // Returns the first position at n or higher whose value is val,
+      // or COVERAGE_NPOS if there is no such position
+  size_t findNext(size_t n,bool val)const;
+
+      // Returns a hash value, equal bitsets have the same hash value
+      // regardless of their storage
+  size_t hash(void)const;
+
+      // Number of positions that can be set without reallocating
+  size_t capacity(void)const;
+
+      // Prints the bitset as a binary number
+  friend std::ostream& operator<<(std::ostream& outS,const Coverage& cov);
+
+      // Destructor
+  ~Coverage();
+
+ private:
+
+      // Words are stored in inlineWords if numWords is not greater
+      // than COVERAGE_INLINE_WORDS, and in heapWords otherwise
+  union
+  {
+    Word inlineWords[COVERAGE_INLINE_WORDS];
+    Word* heapWords;
+  };
+  unsigned int numWords;
+
+  Word* wordPtr(void);
+  const Word* wordPtr(void)const;
+  void grow(size_t nwords);
+  size_t numSignificantWords(void)const;
+  static size_t popcount(Word w);
+  static size_t lowestBit(Word w);
+};
+
+//--------------- Coverage inline functions
+
+inline Coverage::Word* Coverage::wordPtr(void)
+{
+  return numWords>COVERAGE_INLINE_WORDS ? heapWords : inlineWords;
+}
+
+//---------------------------------------
+inline const Coverage::Word* Coverage::wordPtr(void)const
+{
+  return numWords>COVERAGE_INLINE_WORDS ? heapWords : inlineWords;
+}
+
+//---------------------------------------
+inline bool Coverage::test(size_t n)const
+{
+  size_t i=n/COVERAGE_BITS_WORD;
+  if(i>=numWords)
+    return false;
+  else
+    return (wordPtr()[i]>>(n%COVERAGE_BITS_WORD)) & 1;
+}
+
+//---------------------------------------
+inline Coverage& Coverage::reset(size_t n)
+{
+  size_t i=n/COVERAGE_BITS_WORD;
+  if(i<numWords)
+    wordPtr()[i]&=~((Word)1<<(n%COVERAGE_BITS_WORD));
+  return *this;
+}
+
+//---------------------------------------
+inline Coverage& Coverage::set(size_t n,int val)
+{
+  if(val==0)
+    return reset(n);
+
+  size_t i=n/COVERAGE_BITS_WORD;
+  if(i>=numWords)
+    grow(i+1);
+  wordPtr()[i]|=(Word)1<<(n%COVERAGE_BITS_WORD);
+  return *this;
+}
+
+#endif
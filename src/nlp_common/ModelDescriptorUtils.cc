@@ -255,6 +255,27 @@ bool extractModelEntryInfo(std::string fileName,
     return THOT_ERROR;
 }
 
+//---------------
+void extractSoFileNameAndInitPars(std::string modelInitInfo,
+                                  std::string& soFileName,
+                                  std::string& initPars)
+{
+  std::vector<std::string> strVec=StrProcUtils::stringToStringVector(modelInitInfo);
+  soFileName.clear();
+  initPars.clear();
+  for(unsigned int i=0;i<strVec.size();++i)
+  {
+    if(i==0)
+      soFileName=strVec[i];
+    else
+    {
+      if(i>1)
+        initPars+=" ";
+      initPars+=strVec[i];
+    }
+  }
+}
+
 //---------------
 bool printModelDescriptor(const std::vector<ModelDescriptorEntry>& modelDescEntryVec,
                           std::string fileName)
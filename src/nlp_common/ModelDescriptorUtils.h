@@ -60,6 +60,12 @@ bool fileIsDescriptor(std::string fileName,
                       std::string& mainFileName);
 bool extractModelEntryInfo(std::string fileName,
                            std::vector<ModelDescriptorEntry>& modelDescEntryVec);
+    // Splits the initialization info of a model entry into the so file
+    // name (first field) and the parameters given to the module (the
+    // remaining fields)
+void extractSoFileNameAndInitPars(std::string modelInitInfo,
+                                  std::string& soFileName,
+                                  std::string& initPars);
 bool printModelDescriptor(const std::vector<ModelDescriptorEntry>& modelDescEntryVec,
                           std::string fileName);
 #endif
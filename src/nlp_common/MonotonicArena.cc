@@ -0,0 +1,166 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MonotonicArena.cc
+ * 
+ * @brief Definitions file for MonotonicArena.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "MonotonicArena.h"
+
+//--------------- MonotonicArena class functions
+
+MonotonicArena::MonotonicArena(size_t _blockSize)
+{
+  blockSize=_blockSize;
+  currBlock=0;
+  currOffset=0;
+  usedInPrevBlocks=0;
+  numAllocs=0;
+  numBlockAllocs=0;
+}
+
+//---------------------------------
+MonotonicArena::MonotonicArena(const MonotonicArena& other)
+{
+  blockSize=other.blockSize;
+  currBlock=0;
+  currOffset=0;
+  usedInPrevBlocks=0;
+  numAllocs=0;
+  numBlockAllocs=0;
+}
+
+//---------------------------------
+MonotonicArena& MonotonicArena::operator=(const MonotonicArena& other)
+{
+  if(this!=&other)
+  {
+    clear();
+    blockSize=other.blockSize;
+  }
+  return *this;
+}
+
+//---------------------------------
+void* MonotonicArena::allocate(size_t nbytes,
+                               size_t alignment)
+{
+  ++numAllocs;
+  if(currBlock<blockVec.size())
+  {
+        // Try to allocate memory in current block
+    size_t offset=(currOffset+alignment-1) & ~(alignment-1);
+    if(offset+nbytes<=blockSizeVec[currBlock])
+    {
+      currOffset=offset+nbytes;
+      return blockVec[currBlock]+offset;
+    }
+  }
+  return allocateInNewBlock(nbytes,alignment);
+}
+
+//---------------------------------
+void* MonotonicArena::allocateInNewBlock(size_t nbytes,
+                                         size_t /*alignment*/)
+{
+      // Move to the next block, reusing previously reserved blocks
+      // when they are big enough
+  if(currBlock<blockVec.size())
+  {
+    usedInPrevBlocks+=currOffset;
+    ++currBlock;
+  }
+  while(currBlock<blockVec.size() && blockSizeVec[currBlock]<nbytes)
+    ++currBlock;
+
+  if(currBlock==blockVec.size())
+  {
+        // Reserve new block
+    size_t size=blockSize;
+    if(size<nbytes)
+      size=nbytes;
+    blockVec.push_back(new char[size]);
+    blockSizeVec.push_back(size);
+    ++numBlockAllocs;
+  }
+  
+      // Blocks obtained with new[] are suitably aligned for any
+      // fundamental type
+  currOffset=nbytes;
+  return blockVec[currBlock];
+}
+
+//---------------------------------
+void MonotonicArena::release(void)
+{
+  currBlock=0;
+  currOffset=0;
+  usedInPrevBlocks=0;
+  numAllocs=0;
+  numBlockAllocs=0;
+}
+
+//---------------------------------
+void MonotonicArena::clear(void)
+{
+  for(unsigned int i=0;i<blockVec.size();++i)
+    delete[] blockVec[i];
+  blockVec.clear();
+  blockSizeVec.clear();
+  release();
+}
+
+//---------------------------------
+size_t MonotonicArena::bytesInUse(void)const
+{
+  if(currBlock<blockVec.size())
+    return usedInPrevBlocks+currOffset;
+  else
+    return usedInPrevBlocks;
+}
+
+//---------------------------------
+size_t MonotonicArena::bytesReserved(void)const
+{
+  size_t result=0;
+  for(unsigned int i=0;i<blockSizeVec.size();++i)
+    result+=blockSizeVec[i];
+  return result;
+}
+
+//---------------------------------
+size_t MonotonicArena::numAllocations(void)const
+{
+  return numAllocs;
+}
+
+//---------------------------------
+size_t MonotonicArena::numBlockAllocations(void)const
+{
+  return numBlockAllocs;
+}
+
+//---------------------------------
+MonotonicArena::~MonotonicArena()
+{
+  clear();
+}
@@ -0,0 +1,97 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MonotonicArena.h
+ * 
+ * @brief Defines the MonotonicArena class, a memory pool where
+ * allocations are never freed individually. All the allocated memory
+ * is released in one step, which is useful to store data whose
+ * lifetime is bounded by the translation of a sentence.
+ */
+
+#ifndef _MonotonicArena_h
+#define _MonotonicArena_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stddef.h>
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define MONOTONIC_ARENA_DEFAULT_BLOCK_SIZE 65536
+
+//--------------- Classes --------------------------------------------
+
+//--------------- MonotonicArena class
+
+class MonotonicArena
+{
+ public:
+
+      // Constructors
+  MonotonicArena(size_t _blockSize=MONOTONIC_ARENA_DEFAULT_BLOCK_SIZE);
+      // The copy constructor and the assignment operator do not share
+      // memory blocks, the new object starts with an empty arena
+  MonotonicArena(const MonotonicArena& other);
+  MonotonicArena& operator=(const MonotonicArena& other);
+
+      // Allocation function (the returned memory is aligned to the
+      // given value, which should be a power of two)
+  void* allocate(size_t nbytes,
+                 size_t alignment=sizeof(double));
+
+      // Invalidates all the allocations made so far. Memory blocks
+      // are retained so they can be reused
+  void release(void);
+
+      // Returns memory blocks to the system
+  void clear(void);
+
+      // Functions to obtain information about the arena
+  size_t bytesInUse(void)const;
+  size_t bytesReserved(void)const;
+      // Number of allocations and number of blocks obtained from the
+      // system since the last call to release()
+  size_t numAllocations(void)const;
+  size_t numBlockAllocations(void)const;
+
+      // Destructor
+  ~MonotonicArena();
+  
+ private:
+
+  size_t blockSize;
+  std::vector<char*> blockVec;
+  std::vector<size_t> blockSizeVec;
+  size_t currBlock;
+  size_t currOffset;
+  size_t usedInPrevBlocks;
+  size_t numAllocs;
+  size_t numBlockAllocs;
+
+  void* allocateInNewBlock(size_t nbytes,
+                           size_t alignment);
+};
+
+#endif
@@ -21,6 +21,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- Constants ------------------------------------------
 
+    // Sentences of up to MAX_SENTENCE_LENGTH_ALLOWED words are
+    // translated without allocating memory for coverage vectors,
+    // longer sentences are also accepted
 const unsigned int MAX_SENTENCE_LENGTH_ALLOWED=160;
 
 #endif
@@ -0,0 +1,290 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SocketEventPoller.cc
+ *
+ * @brief Definitions file for SocketEventPoller.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "SocketEventPoller.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <iostream>
+#if THOT_HAVE_SYS_EPOLL_H
+#  include <sys/epoll.h>
+#else
+#  include <poll.h>
+#endif
+
+//--------------- Constants ------------------------------------------
+
+#define SEP_MAX_EVENTS 256
+
+//--------------- SocketEventPoller class functions
+
+SocketEventPoller::SocketEventPoller(void)
+{
+  wakeUpPipe[0]=-1;
+  wakeUpPipe[1]=-1;
+  initialized=false;
+#if THOT_HAVE_SYS_EPOLL_H
+  epollFd=-1;
+#else
+  pthread_mutex_init(&mutex,NULL);
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::init(void)
+{
+  release();
+
+  if(pipe(wakeUpPipe)==-1)
+  {
+    std::cerr<<"Error: pipe() failed while initializing socket event poller"<<std::endl;
+    return THOT_ERROR;
+  }
+      // The read end is drained without blocking after each wake up
+  fcntl(wakeUpPipe[0],F_SETFL,fcntl(wakeUpPipe[0],F_GETFL,0)|O_NONBLOCK);
+  fcntl(wakeUpPipe[1],F_SETFL,fcntl(wakeUpPipe[1],F_GETFL,0)|O_NONBLOCK);
+
+#if THOT_HAVE_SYS_EPOLL_H
+  epollFd=epoll_create(SEP_MAX_EVENTS);
+  if(epollFd==-1)
+  {
+    std::cerr<<"Error: epoll_create() failed while initializing socket event poller"<<std::endl;
+    close(wakeUpPipe[0]);
+    close(wakeUpPipe[1]);
+    wakeUpPipe[0]=-1;
+    wakeUpPipe[1]=-1;
+    return THOT_ERROR;
+  }
+  initialized=true;
+  return addListener(wakeUpPipe[0]);
+#else
+  initialized=true;
+  return THOT_OK;
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::addListener(int fd)
+{
+#if THOT_HAVE_SYS_EPOLL_H
+  struct epoll_event ev;
+  ev.events=EPOLLIN;
+  ev.data.fd=fd;
+  if(epoll_ctl(epollFd,EPOLL_CTL_ADD,fd,&ev)==-1)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+#else
+  pthread_mutex_lock(&mutex);
+  listenerSet.insert(fd);
+  pthread_mutex_unlock(&mutex);
+  return THOT_OK;
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::addConnection(int fd)
+{
+#if THOT_HAVE_SYS_EPOLL_H
+  struct epoll_event ev;
+  ev.events=EPOLLIN|EPOLLONESHOT;
+  ev.data.fd=fd;
+  if(epoll_ctl(epollFd,EPOLL_CTL_ADD,fd,&ev)==-1)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+#else
+  return rearm(fd);
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::rearm(int fd)
+{
+#if THOT_HAVE_SYS_EPOLL_H
+  struct epoll_event ev;
+  ev.events=EPOLLIN|EPOLLONESHOT;
+  ev.data.fd=fd;
+  if(epoll_ctl(epollFd,EPOLL_CTL_MOD,fd,&ev)==-1)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+#else
+  pthread_mutex_lock(&mutex);
+  armedSet.insert(fd);
+  pthread_mutex_unlock(&mutex);
+      // The thread in wait() has to rebuild its descriptor set
+  wakeUp();
+  return THOT_OK;
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::remove(int fd)
+{
+#if THOT_HAVE_SYS_EPOLL_H
+  struct epoll_event ev;
+  ev.events=0;
+  ev.data.fd=fd;
+  if(epoll_ctl(epollFd,EPOLL_CTL_DEL,fd,&ev)==-1)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+#else
+  pthread_mutex_lock(&mutex);
+  listenerSet.erase(fd);
+  armedSet.erase(fd);
+  pthread_mutex_unlock(&mutex);
+  return THOT_OK;
+#endif
+}
+
+//---------------------------------
+int SocketEventPoller::wait(std::vector<int>& readyFdVec,
+                            int timeoutMs)
+{
+  readyFdVec.clear();
+  if(!initialized)
+    return THOT_ERROR;
+
+#if THOT_HAVE_SYS_EPOLL_H
+  struct epoll_event events[SEP_MAX_EVENTS];
+  int n=epoll_wait(epollFd,events,SEP_MAX_EVENTS,timeoutMs);
+  if(n==-1)
+  {
+    if(errno==EINTR)
+      return THOT_OK;
+    else
+      return THOT_ERROR;
+  }
+  for(int i=0;i<n;++i)
+  {
+    if(events[i].data.fd==wakeUpPipe[0])
+      drainWakeUpPipe();
+    else
+      readyFdVec.push_back(events[i].data.fd);
+  }
+  return THOT_OK;
+#else
+      // Build descriptor set
+  std::vector<struct pollfd> pollFdVec;
+  struct pollfd pfd;
+  pfd.events=POLLIN;
+  pfd.revents=0;
+  pfd.fd=wakeUpPipe[0];
+  pollFdVec.push_back(pfd);
+  pthread_mutex_lock(&mutex);
+  std::set<int>::const_iterator iter;
+  for(iter=listenerSet.begin();iter!=listenerSet.end();++iter)
+  {
+    pfd.fd=*iter;
+    pollFdVec.push_back(pfd);
+  }
+  for(iter=armedSet.begin();iter!=armedSet.end();++iter)
+  {
+    pfd.fd=*iter;
+    pollFdVec.push_back(pfd);
+  }
+  pthread_mutex_unlock(&mutex);
+
+  int n=poll(&pollFdVec[0],pollFdVec.size(),timeoutMs);
+  if(n==-1)
+  {
+    if(errno==EINTR)
+      return THOT_OK;
+    else
+      return THOT_ERROR;
+  }
+  if(pollFdVec[0].revents)
+    drainWakeUpPipe();
+
+      // Connection sockets are disarmed once reported
+  pthread_mutex_lock(&mutex);
+  for(unsigned int i=1;i<pollFdVec.size();++i)
+  {
+    if(pollFdVec[i].revents)
+    {
+      readyFdVec.push_back(pollFdVec[i].fd);
+      armedSet.erase(pollFdVec[i].fd);
+    }
+  }
+  pthread_mutex_unlock(&mutex);
+  return THOT_OK;
+#endif
+}
+
+//---------------------------------
+void SocketEventPoller::wakeUp(void)
+{
+  if(wakeUpPipe[1]!=-1)
+  {
+    char c=0;
+    ssize_t ret=write(wakeUpPipe[1],&c,1);
+        // A full pipe means that a wake up is already pending
+    (void) ret;
+  }
+}
+
+//---------------------------------
+void SocketEventPoller::drainWakeUpPipe(void)
+{
+  char buff[64];
+  while(read(wakeUpPipe[0],buff,sizeof(buff))>0) {}
+}
+
+//---------------------------------
+void SocketEventPoller::release(void)
+{
+#if THOT_HAVE_SYS_EPOLL_H
+  if(epollFd!=-1)
+  {
+    close(epollFd);
+    epollFd=-1;
+  }
+#else
+  pthread_mutex_lock(&mutex);
+  listenerSet.clear();
+  armedSet.clear();
+  pthread_mutex_unlock(&mutex);
+#endif
+  if(wakeUpPipe[0]!=-1)
+  {
+    close(wakeUpPipe[0]);
+    close(wakeUpPipe[1]);
+    wakeUpPipe[0]=-1;
+    wakeUpPipe[1]=-1;
+  }
+  initialized=false;
+}
+
+//---------------------------------
+SocketEventPoller::~SocketEventPoller()
+{
+  release();
+#if !THOT_HAVE_SYS_EPOLL_H
+  pthread_mutex_destroy(&mutex);
+#endif
+}
@@ -0,0 +1,106 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SocketEventPoller.h
+ *
+ * @brief Defines the SocketEventPoller class, which waits for
+ * incoming data on a set of sockets. Listening sockets are reported
+ * each time they become readable, whereas connection sockets are
+ * reported only once until they are re-armed. This allows a single
+ * thread to wait on all the connections of a server while the
+ * requests themselves are processed by other threads. epoll is used
+ * when available, poll otherwise.
+ */
+
+#ifndef _SocketEventPoller_h
+#define _SocketEventPoller_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <ErrorDefs.h>
+#include <pthread.h>
+#include <vector>
+#include <set>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- SocketEventPoller class
+
+class SocketEventPoller
+{
+ public:
+
+      // Constructor
+  SocketEventPoller(void);
+
+      // Create the underlying poller, it should be called before any
+      // other function
+  int init(void);
+
+      // Register a socket that is reported every time it becomes
+      // readable (e.g. the socket used to accept connections)
+  int addListener(int fd);
+
+      // Register a connection socket. The socket is reported once, then
+      // it is not reported again until rearm() is called for it
+  int addConnection(int fd);
+
+      // Make a connection socket eligible to be reported again. It can
+      // be called from any thread
+  int rearm(int fd);
+
+      // Unregister a socket. It should be called before closing it
+  int remove(int fd);
+
+      // Wait until some of the sockets is readable or until wakeUp() is
+      // called. timeoutMs equal to -1 waits indefinitely
+  int wait(std::vector<int>& readyFdVec,
+           int timeoutMs=-1);
+
+      // Make the thread blocked in wait() return. It can be called
+      // from any thread
+  void wakeUp(void);
+
+      // Release the resources of the poller
+  void release(void);
+
+      // Destructor
+  ~SocketEventPoller();
+
+ private:
+
+  int wakeUpPipe[2];
+  bool initialized;
+#if THOT_HAVE_SYS_EPOLL_H
+  int epollFd;
+#else
+      // Registered sockets (protected by mutex)
+  pthread_mutex_t mutex;
+  std::set<int> listenerSet;
+  std::set<int> armedSet;
+#endif
+
+  void drainWakeUpPipe(void);
+};
+
+#endif
@@ -0,0 +1,264 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WorkerThreadPool.cc
+ * 
+ * @brief Definitions file for WorkerThreadPool.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "WorkerThreadPool.h"
+#include <stddef.h>
+#include <iostream>
+
+//--------------- WorkerThreadPool class functions
+
+WorkerThreadPool::WorkerThreadPool(unsigned int _numThreads)
+{
+  init();
+  setNumThreads(_numThreads);
+}
+
+//---------------------------------
+WorkerThreadPool::WorkerThreadPool(const WorkerThreadPool& other)
+{
+  init();
+  setNumThreads(other.numThreads);
+}
+
+//---------------------------------
+WorkerThreadPool& WorkerThreadPool::operator=(const WorkerThreadPool& other)
+{
+  if(this!=&other)
+    setNumThreads(other.numThreads);
+  return *this;
+}
+
+//---------------------------------
+void WorkerThreadPool::init(void)
+{
+  numThreads=1;
+  batchId=0;
+  stopThreads=false;
+  batchTaskFunc=NULL;
+  batchData=NULL;
+  batchNumTasks=0;
+  nextTask=0;
+  batchOnEachWorker=false;
+  numPendingWorkers=0;
+  pthread_key_create(&workerIdxKey,NULL);
+  pthread_mutex_init(&mutex,NULL);
+  pthread_cond_init(&batchCond,NULL);
+  pthread_cond_init(&doneCond,NULL);
+}
+
+//---------------------------------
+void WorkerThreadPool::setNumThreads(unsigned int _numThreads)
+{
+  if(_numThreads==0)
+    _numThreads=1;
+  if(_numThreads!=numThreads)
+  {
+    stopAndJoinThreads();
+    numThreads=_numThreads;
+  }
+}
+
+//---------------------------------
+unsigned int WorkerThreadPool::getNumThreads(void)const
+{
+  return numThreads;
+}
+
+//---------------------------------
+void WorkerThreadPool::run(unsigned int numTasks,
+                           task_func_t* taskFunc,
+                           void* data)
+{
+  if(numThreads==1 || numTasks<=1)
+  {
+        // Execute tasks in the calling thread
+    for(unsigned int i=0;i<numTasks;++i)
+      taskFunc(data,i,0);
+  }
+  else
+    execBatch(numTasks,taskFunc,data,false);
+}
+
+//---------------------------------
+void WorkerThreadPool::runOnEachWorker(task_func_t* taskFunc,
+                                       void* data)
+{
+  if(numThreads==1)
+    taskFunc(data,0,0);
+  else
+    execBatch(numThreads,taskFunc,data,true);
+}
+
+//---------------------------------
+unsigned int WorkerThreadPool::getCurrentWorkerIdx(void)const
+{
+  const WorkerArgs* workerArgsPtr=(const WorkerArgs*) pthread_getspecific(workerIdxKey);
+  if(workerArgsPtr==NULL)
+    return 0;
+  else
+    return workerArgsPtr->workerIdx;
+}
+
+//---------------------------------
+void WorkerThreadPool::startThreads(void)
+{
+      // Arguments must be stored before creating the threads so as to
+      // keep their addresses fixed
+  workerArgsVec.resize(numThreads);
+  for(unsigned int i=0;i<numThreads;++i)
+  {
+    workerArgsVec[i].poolPtr=this;
+    workerArgsVec[i].workerIdx=i;
+    workerArgsVec[i].startBatchId=batchId;
+  }
+  
+  stopThreads=false;
+  for(unsigned int i=1;i<numThreads;++i)
+  {
+    pthread_t thread;
+    int ret=pthread_create(&thread,NULL,&WorkerThreadPool::workerThread,(void*) &workerArgsVec[i]);
+    if(ret!=0)
+    {
+      std::cerr<<"Error while creating worker thread, only "<<threadVec.size()+1<<" threads will be used"<<std::endl;
+      numThreads=threadVec.size()+1;
+      break;
+    }
+    threadVec.push_back(thread);
+  }
+}
+
+//---------------------------------
+void WorkerThreadPool::stopAndJoinThreads(void)
+{
+  if(!threadVec.empty())
+  {
+    pthread_mutex_lock(&mutex);
+    stopThreads=true;
+    pthread_cond_broadcast(&batchCond);
+    pthread_mutex_unlock(&mutex);
+
+    for(unsigned int i=0;i<threadVec.size();++i)
+      pthread_join(threadVec[i],NULL);
+    threadVec.clear();
+  }
+}
+
+//---------------------------------
+void WorkerThreadPool::execBatch(unsigned int numTasks,
+                                 task_func_t* taskFunc,
+                                 void* data,
+                                 bool onEachWorker)
+{
+  if(threadVec.empty())
+    startThreads();
+  
+      // Publish batch
+  pthread_mutex_lock(&mutex);
+  batchTaskFunc=taskFunc;
+  batchData=data;
+  batchNumTasks=numTasks;
+  nextTask=0;
+  batchOnEachWorker=onEachWorker;
+  numPendingWorkers=threadVec.size();
+  ++batchId;
+  pthread_cond_broadcast(&batchCond);
+  pthread_mutex_unlock(&mutex);
+
+      // Take part in the batch
+  execTasksOfBatch(0);
+
+      // Wait for the rest of the threads
+  pthread_mutex_lock(&mutex);
+  while(numPendingWorkers>0)
+    pthread_cond_wait(&doneCond,&mutex);
+  pthread_mutex_unlock(&mutex);
+}
+
+//---------------------------------
+void WorkerThreadPool::execTasksOfBatch(unsigned int workerIdx)
+{
+  if(batchOnEachWorker)
+  {
+    batchTaskFunc(batchData,workerIdx,workerIdx);
+  }
+  else
+  {
+    while(true)
+    {
+      pthread_mutex_lock(&mutex);
+      unsigned int taskIdx=nextTask;
+      if(nextTask<batchNumTasks)
+        ++nextTask;
+      pthread_mutex_unlock(&mutex);
+      if(taskIdx>=batchNumTasks)
+        break;
+      batchTaskFunc(batchData,taskIdx,workerIdx);
+    }
+  }
+}
+
+//---------------------------------
+void* WorkerThreadPool::workerThread(void* args)
+{
+  WorkerArgs* workerArgsPtr=(WorkerArgs*) args;
+  WorkerThreadPool* poolPtr=workerArgsPtr->poolPtr;
+  pthread_setspecific(poolPtr->workerIdxKey,args);
+
+  unsigned long lastBatchId=workerArgsPtr->startBatchId;
+  pthread_mutex_lock(&poolPtr->mutex);
+  while(true)
+  {
+        // Wait for a new batch
+    while(!poolPtr->stopThreads && poolPtr->batchId==lastBatchId)
+      pthread_cond_wait(&poolPtr->batchCond,&poolPtr->mutex);
+    if(poolPtr->stopThreads)
+      break;
+    lastBatchId=poolPtr->batchId;
+    pthread_mutex_unlock(&poolPtr->mutex);
+
+        // Execute tasks
+    poolPtr->execTasksOfBatch(workerArgsPtr->workerIdx);
+
+        // Notify that the work has been completed
+    pthread_mutex_lock(&poolPtr->mutex);
+    --poolPtr->numPendingWorkers;
+    if(poolPtr->numPendingWorkers==0)
+      pthread_cond_signal(&poolPtr->doneCond);
+  }
+  pthread_mutex_unlock(&poolPtr->mutex);
+
+  return NULL;
+}
+
+//---------------------------------
+WorkerThreadPool::~WorkerThreadPool()
+{
+  stopAndJoinThreads();
+  pthread_cond_destroy(&doneCond);
+  pthread_cond_destroy(&batchCond);
+  pthread_mutex_destroy(&mutex);
+  pthread_key_delete(workerIdxKey);
+}
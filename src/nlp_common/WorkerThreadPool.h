@@ -0,0 +1,126 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WorkerThreadPool.h
+ * 
+ * @brief Defines the WorkerThreadPool class, a fixed set of threads
+ * that execute batches of independent tasks. The thread requesting
+ * the execution of a batch takes part in it and waits until all of
+ * the tasks have been completed.
+ */
+
+#ifndef _WorkerThreadPool_h
+#define _WorkerThreadPool_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <pthread.h>
+#include <vector>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- WorkerThreadPool class
+
+class WorkerThreadPool
+{
+ public:
+
+      // Type of the functions executed by the pool. taskIdx identifies
+      // the task within the batch and workerIdx identifies the thread
+      // executing it (0 is used for the thread that requested the
+      // batch)
+  typedef void task_func_t(void* data,
+                           unsigned int taskIdx,
+                           unsigned int workerIdx);
+
+      // Constructors
+  WorkerThreadPool(unsigned int _numThreads=1);
+      // The copy constructor and the assignment operator do not share
+      // threads, only the number of threads is copied
+  WorkerThreadPool(const WorkerThreadPool& other);
+  WorkerThreadPool& operator=(const WorkerThreadPool& other);
+
+      // Set the number of threads (including the thread requesting the
+      // batches). Threads are created when the first batch is executed
+  void setNumThreads(unsigned int _numThreads);
+  unsigned int getNumThreads(void)const;
+
+      // Execute tasks 0 to numTasks-1. Tasks are handed out to the
+      // threads in increasing order, the function returns when all of
+      // them have been completed
+  void run(unsigned int numTasks,
+           task_func_t* taskFunc,
+           void* data);
+
+      // Execute taskFunc once in each thread of the pool, with taskIdx
+      // equal to workerIdx. It is useful to initialize or clear
+      // thread-specific data
+  void runOnEachWorker(task_func_t* taskFunc,
+                       void* data);
+
+      // Return the index of the calling thread in the pool (0 if it is
+      // not one of the threads created by the pool)
+  unsigned int getCurrentWorkerIdx(void)const;
+
+      // Destructor
+  ~WorkerThreadPool();
+  
+ private:
+
+  struct WorkerArgs
+  {
+    WorkerThreadPool* poolPtr;
+    unsigned int workerIdx;
+    unsigned long startBatchId;
+  };
+  
+  unsigned int numThreads;
+  std::vector<pthread_t> threadVec;
+  std::vector<WorkerArgs> workerArgsVec;
+  pthread_key_t workerIdxKey;
+
+      // Data of the current batch (protected by mutex)
+  pthread_mutex_t mutex;
+  pthread_cond_t batchCond;
+  pthread_cond_t doneCond;
+  unsigned long batchId;
+  bool stopThreads;
+  task_func_t* batchTaskFunc;
+  void* batchData;
+  unsigned int batchNumTasks;
+  unsigned int nextTask;
+  bool batchOnEachWorker;
+  unsigned int numPendingWorkers;
+
+  void init(void);
+  void startThreads(void);
+  void stopAndJoinThreads(void);
+  void execBatch(unsigned int numTasks,
+                 task_func_t* taskFunc,
+                 void* data,
+                 bool onEachWorker);
+  void execTasksOfBatch(unsigned int workerIdx);
+  static void* workerThread(void* args);
+};
+
+#endif
@@ -25,12 +25,16 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include "HatTriePhraseTable.h"
+#include <algorithm>
+#include <set>
 
 //--------------- Function definitions
 
 //-------------------------
 HatTriePhraseTable::HatTriePhraseTable(void)
 {
+    trgNbestListSize = 0;
+    trgNbestListsValid = true;
 }
 
 //-------------------------
@@ -172,6 +176,19 @@ bool HatTriePhraseTable::getNbestForTrg(const std::vector<WordIndex>& t,
     // Make sure that collection does not contain any old elements
     nbt.clear();
 
+    // Try to answer the query from the n-best list of t
+    if(trgNbestListSize > 0 && trgNbestListsValid)
+    {
+        TrgNbestLists::const_iterator listIter = trgNbestLists.find(vectorToKey(t));
+        if(listIter == trgNbestLists.end())
+            return false;
+
+        bool answered;
+        found = getNbestForTrgFromList(listIter.value(), t, nbt, N, answered);
+        if(answered)
+            return found;
+    }
+
     found = getEntriesForTarget(t, node);
     t_count = cTrg(t);
 
@@ -209,6 +226,233 @@ bool HatTriePhraseTable::getNbestForTrg(const std::vector<WordIndex>& t,
     }
 }
 
+//-------------------------
+bool HatTriePhraseTable::getNbestForTrgFromList(const TrgNbestList& nbList,
+                                                const std::vector<WordIndex>& t,
+                                                NbestTableNode<PhraseTransTableNodeData>& nbt,
+                                                int N,
+                                                bool& answered)
+{
+    const std::vector<std::pair<float, std::vector<WordIndex> > >& entries = nbList.entries;
+
+    answered = true;
+    if(entries.empty())
+        return false;
+
+    // Determine the number of entries to be returned
+    size_t n = entries.size();
+    if(N >= 0 && (size_t) N < entries.size())
+    {
+        n = N;
+        if(n == 0)
+            return true;
+    }
+    else if(nbList.truncated)
+    {
+        // The list does not contain all the requested entries
+        answered = false;
+        return false;
+    }
+
+    // Entries are sorted by decreasing count, so entries obtaining the
+    // same score are contiguous. Within each group of tied entries,
+    // entries are inserted by source phrase, as in the n-best table
+    // built from the whole set of entries
+    Count t_count = cTrg(t);
+    size_t groupBegin = 0;
+    while(groupBegin < n)
+    {
+        // Obtain group of entries tied with the first one
+        LgProb lgProb = log(entries[groupBegin].first / (float) t_count);
+        size_t groupEnd = groupBegin + 1;
+        bool sortedBySrc = true;
+        while(groupEnd < entries.size() &&
+              (double) log(entries[groupEnd].first / (float) t_count) == (double) lgProb)
+        {
+            if(entries[groupEnd].second < entries[groupEnd - 1].second)
+                sortedBySrc = false;
+            ++groupEnd;
+        }
+        if(groupEnd > n && groupEnd == entries.size() && nbList.truncated)
+        {
+            // Ties may continue beyond the end of the list
+            nbt.clear();
+            answered = false;
+            return false;
+        }
+
+        // Insert entries of the group
+        size_t numToInsert = std::min(groupEnd, n) - groupBegin;
+        if(sortedBySrc)
+        {
+            for(size_t i = groupBegin; i < groupBegin + numToInsert; ++i)
+                nbt.insert(lgProb, entries[i].second);
+        }
+        else
+        {
+            // Different counts obtained the same score, select entries
+            // in source phrase order (source phrases of a list are
+            // unique)
+            const std::vector<WordIndex>* prevSrcPtr = NULL;
+            for(size_t k = 0; k < numToInsert; ++k)
+            {
+                const std::vector<WordIndex>* minSrcPtr = NULL;
+                for(size_t i = groupBegin; i < groupEnd; ++i)
+                {
+                    if((prevSrcPtr == NULL || *prevSrcPtr < entries[i].second) &&
+                       (minSrcPtr == NULL || entries[i].second < *minSrcPtr))
+                        minSrcPtr = &entries[i].second;
+                }
+                nbt.insert(lgProb, *minSrcPtr);
+                prevSrcPtr = minSrcPtr;
+            }
+        }
+        groupBegin = groupEnd;
+    }
+
+#   ifdef DO_STABLE_SORT_ON_NBEST_TABLE
+    nbt.stableSort();
+#   endif
+
+    return true;
+}
+
+//-------------------------
+void HatTriePhraseTable::setTrgNbestListSize(unsigned int K)
+{
+    trgNbestListSize = K;
+    buildTrgNbestLists();
+}
+
+//-------------------------
+unsigned int HatTriePhraseTable::getTrgNbestListSize(void)const
+{
+    return trgNbestListSize;
+}
+
+//-------------------------
+void HatTriePhraseTable::buildTrgNbestLists(void)
+{
+    trgNbestLists.clear();
+    trgNbestListsValid = true;
+    if(trgNbestListSize == 0)
+        return;
+
+    // Obtain target phrases from (t, UNUSED_WORD, s) keys
+    std::set<std::vector<WordIndex> > trgSet;
+    for(PhraseTable::const_iterator iter = phraseTable.begin(); iter != phraseTable.end(); iter++)
+    {
+        std::vector<WordIndex> phrase = keyToVector(iter.key());
+        std::vector<WordIndex>::iterator unusedIter = std::find(phrase.begin(), phrase.end(), UNUSED_WORD);
+        if(unusedIter != phrase.end() && unusedIter != phrase.begin())
+            trgSet.insert(std::vector<WordIndex>(phrase.begin(), unusedIter));
+    }
+
+    // Build list for each target phrase
+    for(std::set<std::vector<WordIndex> >::const_iterator trgIter = trgSet.begin(); trgIter != trgSet.end(); ++trgIter)
+    {
+        TrgNbestList nbList;
+        buildTrgNbestList(*trgIter, nbList);
+        if(!nbList.entries.empty())
+            trgNbestLists.insert(vectorToKey(*trgIter), nbList);
+    }
+}
+
+//-------------------------
+void HatTriePhraseTable::buildTrgNbestList(const std::vector<WordIndex>& t,
+                                           TrgNbestList& nbList)
+{
+    // Entries are obtained sorted by source phrase, a stable sort by
+    // count keeps that order for entries with the same count
+    HatTriePhraseTable::SrcTableNode node;
+    getEntriesForTarget(t, node);
+
+    nbList.entries.clear();
+    for(HatTriePhraseTable::SrcTableNode::iterator iter = node.begin(); iter != node.end(); iter++)
+        nbList.entries.push_back(std::make_pair((float) iter->second.second.get_c_st(), iter->first));
+    std::stable_sort(nbList.entries.begin(), nbList.entries.end(), greaterCount);
+
+    nbList.truncated = (nbList.entries.size() > trgNbestListSize);
+    if(nbList.truncated)
+        nbList.entries.resize(trgNbestListSize);
+}
+
+//-------------------------
+bool HatTriePhraseTable::greaterCount(const std::pair<float, std::vector<WordIndex> >& a,
+                                      const std::pair<float, std::vector<WordIndex> >& b)
+{
+    return a.first > b.first;
+}
+
+//-------------------------
+void HatTriePhraseTable::updateTrgNbestList(const std::vector<WordIndex>& s,
+                                            const std::vector<WordIndex>& t,
+                                            float c_st)
+{
+    if(trgNbestListSize == 0 || !trgNbestListsValid)
+        return;
+
+    bool nonZero = (fabs(c_st) >= EPSILON);
+    if(nonZero)
+    {
+        // Entries without source count are not returned by
+        // getEntriesForTarget(), lists are disabled in such case
+        bool found;
+        Count s_count = getSrcInfo(s, found);
+        if(!found || fabs(s_count.get_c_s()) < EPSILON)
+        {
+            trgNbestListsValid = false;
+            trgNbestLists.clear();
+            return;
+        }
+    }
+
+    // Obtain list for t
+    std::string trgKey = vectorToKey(t);
+    TrgNbestLists::iterator listIter = trgNbestLists.find(trgKey);
+    if(listIter == trgNbestLists.end())
+    {
+        if(!nonZero)
+            return;
+        listIter = trgNbestLists.insert(trgKey, TrgNbestList()).first;
+    }
+    TrgNbestList& nbList = listIter.value();
+    std::vector<std::pair<float, std::vector<WordIndex> > >& entries = nbList.entries;
+
+    // Remove old entry for s
+    bool wasInList = false;
+    for(size_t i = 0; i < entries.size(); ++i)
+    {
+        if(entries[i].second == s)
+        {
+            entries.erase(entries.begin() + i);
+            wasInList = true;
+            break;
+        }
+    }
+
+    // Obtain position of the new entry
+    size_t pos = 0;
+    while(pos < entries.size() &&
+          (entries[pos].first > c_st || (entries[pos].first == c_st && entries[pos].second < s)))
+        ++pos;
+
+    if(wasInList && nbList.truncated && (!nonZero || pos == entries.size()))
+    {
+        // Entries not stored in the list may now be ranked above
+        buildTrgNbestList(t, nbList);
+    }
+    else if(nonZero)
+    {
+        entries.insert(entries.begin() + pos, std::make_pair(c_st, s));
+        if(entries.size() > trgNbestListSize)
+        {
+            entries.pop_back();
+            nbList.truncated = true;
+        }
+    }
+}
+
 //-------------------------
 void HatTriePhraseTable::addTableEntry(const std::vector<WordIndex>& s,
                                        const std::vector<WordIndex>& t,
@@ -227,7 +471,16 @@ void HatTriePhraseTable::addSrcInfo(const std::vector<WordIndex>& s,
                                     Count s_inf)
 {
     std::string srcKey = vectorToKey(getSrc(s));
-    phraseTable[srcKey.c_str()] = s_inf;
+    Count& s_count = phraseTable[srcKey.c_str()];
+
+    // Entries of s are no longer returned by getEntriesForTarget() if
+    // its count becomes zero, lists are disabled in such case
+    if(trgNbestListSize > 0 && fabs(s_count.get_c_s()) >= EPSILON && fabs(s_inf.get_c_s()) < EPSILON)
+    {
+        trgNbestListsValid = false;
+        trgNbestLists.clear();
+    }
+    s_count = s_inf;
 }
 
 //-------------------------
@@ -245,6 +498,7 @@ void HatTriePhraseTable::addSrcTrgInfo(const std::vector<WordIndex>& s,
 {
     std::string trgSrcKey = vectorToKey(getTrgSrc(s, t));
     phraseTable[trgSrcKey.c_str()] = st_inf;
+    updateTrgNbestList(s, t, (float) st_inf.get_c_st());
 }
 
 //-------------------------
@@ -531,6 +785,8 @@ size_t HatTriePhraseTable::size(void)
 void HatTriePhraseTable::clear(void)
 {
     phraseTable.clear();
+    trgNbestLists.clear();
+    trgNbestListsValid = true;
 }
 
 //-------------------------
@@ -70,6 +70,17 @@ class HatTriePhraseTable: public BasePhraseTable
             // Returned result types by iterator
         typedef std::pair<std::vector<WordIndex>, Count> PhraseInfoElement;
 
+            // List with the K entries of a target phrase with highest
+            // count, sorted by decreasing count and then by source
+            // phrase. truncated is set when more entries exist
+        struct TrgNbestList
+        {
+            bool truncated;
+            std::vector<std::pair<float, std::vector<WordIndex> > > entries;
+            TrgNbestList(void):truncated(false){}
+        };
+        typedef tsl::htrie_map<char, TrgNbestList> TrgNbestLists;
+
             // Constructor
         HatTriePhraseTable(void);
 
@@ -117,6 +128,17 @@ class HatTriePhraseTable: public BasePhraseTable
         virtual bool getNbestForTrg(const std::vector<WordIndex>& t,
                                     NbestTableNode<PhraseTransTableNodeData>& nbt,
                                     int N=-1);
+            // If the n-best lists of target phrases are enabled, queries
+            // with N<=K (or for target phrases with no more than K
+            // entries) are answered from them
+
+            // Enables the n-best lists of target phrases when K>0,
+            // disables them when K=0 (default). Lists are built from the
+            // current content of the table and then maintained on each
+            // update. Decoders set K through the "-trgnb <int>"
+            // initialization parameter of IncrPhraseModel
+        void setTrgNbestListSize(unsigned int K);
+        unsigned int getTrgNbestListSize(void)const;
 
             // Counts-related functions
         virtual Count cSrcTrg(const std::vector<WordIndex>& s,
@@ -172,6 +194,28 @@ class HatTriePhraseTable: public BasePhraseTable
     protected:
         PhraseTable phraseTable;
 
+            // n-best lists of target phrases, indexed by target key
+        TrgNbestLists trgNbestLists;
+        unsigned int trgNbestListSize;
+            // Set to false when an entry without source count is found,
+            // queries do not use the lists until they are rebuilt
+        bool trgNbestListsValid;
+
+            // Functions to maintain the n-best lists
+        void buildTrgNbestLists(void);
+        void buildTrgNbestList(const std::vector<WordIndex>& t,
+                               TrgNbestList& nbList);
+        void updateTrgNbestList(const std::vector<WordIndex>& s,
+                                const std::vector<WordIndex>& t,
+                                float c_st);
+        bool getNbestForTrgFromList(const TrgNbestList& nbList,
+                                    const std::vector<WordIndex>& t,
+                                    NbestTableNode<PhraseTransTableNodeData>& nbt,
+                                    int N,
+                                    bool& answered);
+        static bool greaterCount(const std::pair<float, std::vector<WordIndex> >& a,
+                                 const std::pair<float, std::vector<WordIndex> >& b);
+
             // Check type of phrase in vector
         bool isTargetPhrase(const std::vector<WordIndex>& vec) const;
 
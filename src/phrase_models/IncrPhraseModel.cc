@@ -95,6 +95,35 @@ void IncrPhraseModel::printTTable(FILE* file)
 
 #endif
 
+//-------------------------
+void IncrPhraseModel::setTrgNbestListSize(unsigned int K)
+{
+#ifdef THOT_HAVE_CXX11
+  HatTriePhraseTable* ptPtr=dynamic_cast<HatTriePhraseTable*>(basePhraseTablePtr);
+  if(ptPtr)
+    ptPtr->setTrgNbestListSize(K);
+#endif
+}
+
+//-------------------------
+bool IncrPhraseModel::load_ttable(const char *phraseTTableFileName)
+{
+#ifdef THOT_HAVE_CXX11
+  HatTriePhraseTable* ptPtr=dynamic_cast<HatTriePhraseTable*>(basePhraseTablePtr);
+  if(ptPtr && ptPtr->getTrgNbestListSize()>0)
+  {
+        // Disable the n-best lists while loading, so they are not
+        // updated for each new entry, and build them afterwards
+    unsigned int K=ptPtr->getTrgNbestListSize();
+    ptPtr->setTrgNbestListSize(0);
+    bool ret=_incrPhraseModel::load_ttable(phraseTTableFileName);
+    ptPtr->setTrgNbestListSize(K);
+    return ret;
+  }
+#endif
+  return _incrPhraseModel::load_ttable(phraseTTableFileName);
+}
+
 //-------------------------
 IncrPhraseModel::~IncrPhraseModel()
 {
@@ -70,6 +70,16 @@ class IncrPhraseModel: public _incrPhraseModel
 
       }
 
+        // Sets the size K of the n-best lists of target phrases kept
+        // by the phrase table, which are used to answer inverse n-best
+        // queries (0 disables them). It has no effect if the phrase
+        // table does not keep such lists
+    void setTrgNbestListSize(unsigned int K);
+
+        // Loads the ttable, building the n-best lists of target
+        // phrases once all the entries have been added
+    bool load_ttable(const char *phraseTTableFileName);
+    
         // Destructor
 	~IncrPhraseModel();
 	
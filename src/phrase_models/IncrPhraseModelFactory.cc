@@ -25,13 +25,37 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include "IncrPhraseModel.h"
+#include "StrProcUtils.h"
+#include <stdlib.h>
+#include <iostream>
 #include <string>
+#include <vector>
 
 //--------------- Function definitions
 
-extern "C" BasePhraseModel* create(const char* /*str*/)
+extern "C" BasePhraseModel* create(const char* str)
 {
-  return new IncrPhraseModel;
+  IncrPhraseModel* incrPhraseModelPtr=new IncrPhraseModel;
+
+      // Process initialization parameters. "-trgnb <int>" sets the size
+      // of the n-best lists of target phrases kept by the phrase table
+  std::vector<std::string> strVec=StrProcUtils::stringToStringVector(str);
+  for(unsigned int i=0;i<strVec.size();++i)
+  {
+    if(strVec[i]=="-trgnb" && i+1<strVec.size())
+    {
+      incrPhraseModelPtr->setTrgNbestListSize(atoi(strVec[i+1].c_str()));
+      ++i;
+    }
+    else
+    {
+      std::cerr<<"Error: invalid initialization parameter for IncrPhraseModel ("<<strVec[i]<<")"<<std::endl;
+      delete incrPhraseModelPtr;
+      return NULL;
+    }
+  }
+  
+  return incrPhraseModelPtr;
 }
 
 //---------------
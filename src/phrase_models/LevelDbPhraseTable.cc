@@ -36,6 +36,11 @@ LevelDbPhraseTable::LevelDbPhraseTable(void)
     options.block_cache = leveldb::NewLRUCache(100 * 1048576);  // 100 MB for cache
     db = NULL;
     dbName = "";
+    dbFormatVersionKey = std::string(1, '\0') + "format_version";
+    formatVersion = LEVELDB_PHRASE_TABLE_FORMAT_VERSION;
+    writeBufferSize = options.write_buffer_size;
+    bulkLoading = false;
+    bulkLoadMaxEntries = LEVELDB_PHRASE_TABLE_BULK_LOAD_MAX_ENTRIES;
 }
 
 //-------------------------
@@ -72,6 +77,52 @@ std::vector<WordIndex> LevelDbPhraseTable::stringToVector(const std::string s)co
     return vec;
 }
 
+//-------------------------
+std::string LevelDbPhraseTable::countToValue(int count)const
+{
+    if (formatVersion == LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION)
+    {
+        std::stringstream ss;
+        ss << count;
+        return ss.str();
+    }
+    else
+    {
+        // Store the count in little-endian order
+        uint32_t bits = (uint32_t) count;
+
+        char buf[sizeof(bits)];
+        for (size_t i = 0; i < sizeof(bits); i++)
+        {
+            buf[i] = (char) ((bits >> (8 * i)) & 0xff);
+        }
+
+        return std::string(buf, sizeof(bits));
+    }
+}
+
+//-------------------------
+int LevelDbPhraseTable::valueToCount(const leveldb::Slice& value)const
+{
+    if (formatVersion == LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION)
+    {
+        return atoi(value.ToString().c_str());
+    }
+    else
+    {
+        uint32_t bits = 0;
+        if (value.size() != sizeof(bits))
+            return 0;
+
+        for (size_t i = 0; i < sizeof(bits); i++)
+        {
+            bits |= ((uint32_t) (unsigned char) value[i]) << (8 * i);
+        }
+
+        return (int) bits;
+    }
+}
+
 //-------------------------
 std::string LevelDbPhraseTable::vectorToKey(const std::vector<WordIndex>& vec)const
 {
@@ -90,11 +141,21 @@ bool LevelDbPhraseTable::retrieveData(const std::vector<WordIndex>& phrase, int
     std::string value_str;
     count = 0;
     std::string key = vectorToString(phrase);
+
+    // Entries being bulk loaded may not have been written yet
+    if (bulkLoading) {
+        std::map<std::string, std::string>::const_iterator iter = bulkLoadBuffer.find(key);
+
+        if (iter != bulkLoadBuffer.end()) {
+            count = valueToCount(iter->second);
+            return true;
+        }
+    }
     
     leveldb::Status result = db->Get(leveldb::ReadOptions(), key, &value_str);  // Read stored src value
 
     if (result.ok()) {
-        count = atoi(value_str.c_str());
+        count = valueToCount(value_str);
         return true;
     } else {
         return false;
@@ -104,9 +165,16 @@ bool LevelDbPhraseTable::retrieveData(const std::vector<WordIndex>& phrase, int
 //-------------------------
 bool LevelDbPhraseTable::storeData(const std::vector<WordIndex>& phrase, int count)const
 {
-    std::stringstream ss;
-    ss << count;
-    std::string count_str = ss.str();
+    std::string count_str = countToValue(count);
+
+    if (bulkLoading) {
+        bulkLoadBuffer[vectorToString(phrase)] = count_str;
+
+        if (bulkLoadBuffer.size() >= bulkLoadMaxEntries)
+            return flushBulkLoadBuffer();
+        else
+            return true;
+    }
 
     leveldb::WriteBatch batch;
     batch.Put(vectorToString(phrase), count_str);
@@ -118,6 +186,160 @@ bool LevelDbPhraseTable::storeData(const std::vector<WordIndex>& phrase, int cou
     return s.ok();
 }
 
+//-------------------------
+bool LevelDbPhraseTable::flushBulkLoadBuffer(void)const
+{
+    bool ok = true;
+    leveldb::WriteBatch batch;
+    size_t batchSize = 0;
+
+    // The buffer is sorted by key, so each batch covers a contiguous
+    // range of keys
+    for (std::map<std::string, std::string>::const_iterator iter = bulkLoadBuffer.begin(); iter != bulkLoadBuffer.end(); iter++)
+    {
+        batch.Put(iter->first, iter->second);
+        batchSize++;
+
+        if (batchSize == LEVELDB_PHRASE_TABLE_BULK_LOAD_BATCH_SIZE)
+        {
+            leveldb::Status s = db->Write(leveldb::WriteOptions(), &batch);
+            if (!s.ok())
+            {
+                std::cerr << "Storing data status: " << s.ToString() << std::endl;
+                ok = false;
+            }
+            batch.Clear();
+            batchSize = 0;
+        }
+    }
+
+    if (batchSize > 0)
+    {
+        leveldb::Status s = db->Write(leveldb::WriteOptions(), &batch);
+        if (!s.ok())
+        {
+            std::cerr << "Storing data status: " << s.ToString() << std::endl;
+            ok = false;
+        }
+    }
+
+    bulkLoadBuffer.clear();
+
+    return ok;
+}
+
+//-------------------------
+bool LevelDbPhraseTable::reopen(size_t _writeBufferSize)
+{
+    if (db != NULL)
+    {
+        delete db;
+        db = NULL;
+    }
+
+    options.write_buffer_size = _writeBufferSize;
+    leveldb::Status status = leveldb::DB::Open(options, dbName, &db);
+
+    if (status.ok())
+    {
+        return THOT_OK;
+    }
+    else
+    {
+        std::cerr << status.ToString() << std::endl;
+        return THOT_ERROR;
+    }
+}
+
+//-------------------------
+bool LevelDbPhraseTable::startBulkLoad(size_t maxBufferedEntries)
+{
+    if (db == NULL)
+    {
+        std::cerr << "Bulk loading requires an initialized database" << std::endl;
+        return THOT_ERROR;
+    }
+
+    bulkLoadMaxEntries = maxBufferedEntries;
+    bulkLoading = true;
+
+    // A larger write buffer reduces the number of compactions
+    return reopen(LEVELDB_PHRASE_TABLE_BULK_LOAD_WRITE_BUFFER_SIZE);
+}
+
+//-------------------------
+bool LevelDbPhraseTable::endBulkLoad(void)
+{
+    if (!bulkLoading)
+        return THOT_OK;
+
+    bool ok = flushBulkLoadBuffer();
+    bulkLoading = false;
+
+    if (reopen(writeBufferSize) != THOT_OK || !ok)
+        return THOT_ERROR;
+    else
+        return THOT_OK;
+}
+
+//-------------------------
+unsigned int LevelDbPhraseTable::getFormatVersion(void)const
+{
+    return formatVersion;
+}
+
+//-------------------------
+bool LevelDbPhraseTable::restoreFormatVersion(void)
+{
+    std::string value_str;
+    leveldb::Status result = db->Get(leveldb::ReadOptions(), dbFormatVersionKey, &value_str);
+
+    if (result.ok())
+    {
+        formatVersion = atoi(value_str.c_str());
+
+        if (formatVersion > LEVELDB_PHRASE_TABLE_FORMAT_VERSION)
+        {
+            std::cerr << "Unsupported format version of LevelDB phrase table: " << formatVersion << std::endl;
+            return THOT_ERROR;
+        }
+
+        return THOT_OK;
+    }
+
+    // Databases without version key are either new or were created
+    // before storing counts in binary format
+    leveldb::Iterator* it = db->NewIterator(leveldb::ReadOptions());
+    it->SeekToFirst();
+    bool empty = !it->Valid();
+    delete it;
+
+    if (empty)
+    {
+        formatVersion = LEVELDB_PHRASE_TABLE_FORMAT_VERSION;
+        return storeFormatVersion() ? THOT_OK : THOT_ERROR;
+    }
+    else
+    {
+        formatVersion = LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION;
+        return THOT_OK;
+    }
+}
+
+//-------------------------
+bool LevelDbPhraseTable::storeFormatVersion(void)
+{
+    std::stringstream ss;
+    ss << formatVersion;
+
+    leveldb::Status s = db->Put(leveldb::WriteOptions(), dbFormatVersionKey, ss.str());
+
+    if(!s.ok())
+        std::cerr << "Storing format version status: " << s.ToString() << std::endl;
+
+    return s.ok();
+}
+
 //-------------------------
 bool LevelDbPhraseTable::init(std::string levelDbPath)
 {
@@ -140,6 +362,8 @@ bool LevelDbPhraseTable::init(std::string levelDbPath)
 //-------------------------
 bool LevelDbPhraseTable::drop()
 {
+    bulkLoadBuffer.clear();
+
     if(db != NULL)
     {
         delete db;
@@ -165,6 +389,7 @@ bool LevelDbPhraseTable::load(std::string levelDbPath)
 {
     if(db != NULL)
     {
+        flushBulkLoadBuffer();
         delete db;
         db = NULL;
     }
@@ -174,7 +399,8 @@ bool LevelDbPhraseTable::load(std::string levelDbPath)
 
     if (status.ok())
     {
-        return THOT_OK;
+        // Determine how values are stored
+        return restoreFormatVersion();
     }
     else
     {
@@ -428,6 +654,8 @@ bool LevelDbPhraseTable::getEntriesForTarget(const std::vector<WordIndex>& t,
     leveldb::Slice start = start_str;
     leveldb::Slice end = end_str;
 
+    if (bulkLoading)
+        flushBulkLoadBuffer();
     leveldb::Iterator* it = db->NewIterator(leveldb::ReadOptions());
     
     srctn.clear();  // Make sure that structure does not keep old values
@@ -533,6 +761,10 @@ void LevelDbPhraseTable::clear(void)
             std::cerr << "Returned status: " << status.ToString() << std::endl;
             exit(3);
         }
+
+        // New databases use the current format
+        formatVersion = LEVELDB_PHRASE_TABLE_FORMAT_VERSION;
+        storeFormatVersion();
     }
 }
 
@@ -540,7 +772,10 @@ void LevelDbPhraseTable::clear(void)
 LevelDbPhraseTable::~LevelDbPhraseTable(void)
 {
     if(db != NULL)
+    {
+        flushBulkLoadBuffer();
         delete db;
+    }
 
     if(options.filter_policy != NULL)
         delete options.filter_policy;
@@ -552,9 +787,16 @@ LevelDbPhraseTable::~LevelDbPhraseTable(void)
 //-------------------------
 LevelDbPhraseTable::const_iterator LevelDbPhraseTable::begin(void)const
 {
+    if (bulkLoading)
+        flushBulkLoadBuffer();
     leveldb::Iterator *local_iter = db->NewIterator(leveldb::ReadOptions());
     local_iter->SeekToFirst();
 
+    // Skip item storing the format version
+    if(local_iter->Valid() && local_iter->key() == leveldb::Slice(dbFormatVersionKey)) {
+        local_iter->Next();
+    }
+
     if(!local_iter->Valid()) {
         delete local_iter;
         local_iter = NULL;
@@ -621,7 +863,7 @@ LevelDbPhraseTable::const_iterator::operator->(void)
     std::string key = internalIter->key().ToString();
     std::vector<WordIndex> key_vec = ptPtr->keyToVector(key);
 
-    int count = atoi(internalIter->value().ToString().c_str());
+    int count = ptPtr->valueToCount(internalIter->value());
 
     dataItem = std::make_pair(key_vec, count);
 
@@ -27,9 +27,21 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #define WORD_INDEX_MODULO_BASE 254
 #define WORD_INDEX_MODULO_BYTES 3
 
+    // Format of the stored values: version 0 stores counts as text,
+    // version 1 stores them as 32-bit little-endian integers
+#define LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION 0
+#define LEVELDB_PHRASE_TABLE_FORMAT_VERSION 1
+
+    // Bulk loading parameters
+#define LEVELDB_PHRASE_TABLE_BULK_LOAD_MAX_ENTRIES 1000000
+#define LEVELDB_PHRASE_TABLE_BULK_LOAD_BATCH_SIZE 100000
+#define LEVELDB_PHRASE_TABLE_BULK_LOAD_WRITE_BUFFER_SIZE (256 * 1048576)
+
 //--------------- Include files --------------------------------------
 
 #include <math.h>
+#include <stdint.h>
+#include <map>
 #include <sstream>
 
 #if HAVE_CONFIG_H
@@ -64,10 +76,29 @@ class LevelDbPhraseTable: public BasePhraseTable
     leveldb::DB* db;
     leveldb::Options options;
     std::string dbName;
+    std::string dbFormatVersionKey;
+    unsigned int formatVersion;
+    size_t writeBufferSize;
+
+        // Entries stored during bulk loading, sorted by key
+    bool bulkLoading;
+    size_t bulkLoadMaxEntries;
+    mutable std::map<std::string, std::string> bulkLoadBuffer;
 
         // Converters
     virtual std::string vectorToString(const std::vector<WordIndex>& vec)const;
     virtual std::vector<WordIndex> stringToVector(const std::string s)const;
+    std::string countToValue(int count)const;
+    int valueToCount(const leveldb::Slice& value)const;
+
+        // Format version marker, its key cannot be generated by
+        // vectorToString() since it starts with a zero byte
+    bool restoreFormatVersion(void);
+    bool storeFormatVersion(void);
+
+        // Write buffered entries in batches sorted by key
+    bool flushBulkLoadBuffer(void)const;
+    bool reopen(size_t _writeBufferSize);
 
         // Read and write data
     virtual bool retrieveData(const std::vector<WordIndex>& phrase, int &count)const;
@@ -98,6 +129,17 @@ class LevelDbPhraseTable: public BasePhraseTable
     virtual bool drop();
         // Wrapper for loading existing levelDB
     virtual bool load(std::string levelDbPath);
+        // Bulk loading for offline conversions. Entries are kept in
+        // memory and written in large batches sorted by key. They are
+        // visible to lookups, but they are not guaranteed to be on
+        // disk until endBulkLoad() is called. Bulk-load mode is
+        // single-threaded: the const lookups flush the buffer, so the
+        // table must not be shared between threads until
+        // endBulkLoad() returns
+    bool startBulkLoad(size_t maxBufferedEntries = LEVELDB_PHRASE_TABLE_BULK_LOAD_MAX_ENTRIES);
+    bool endBulkLoad(void);
+        // Version of the format of the stored values
+    unsigned int getFormatVersion(void)const;
         // Abstract function definitions
     virtual void addTableEntry(const std::vector<WordIndex>& s,
                                const std::vector<WordIndex>& t,
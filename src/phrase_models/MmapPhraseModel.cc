@@ -0,0 +1,99 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseModel.cc
+ *
+ * @brief Definitions file for MmapPhraseModel.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "MmapPhraseModel.h"
+
+
+//--------------- Function definitions
+
+//-------------------------
+MmapPhraseModel::MmapPhraseModel(void):_incrPhraseModel()
+{
+  basePhraseTablePtr=new MmapPhraseTable;
+}
+
+//-------------------------
+bool MmapPhraseModel::load_ttable(const char *phraseTTableFileName)
+{
+  MmapPhraseTable* ptPtr=dynamic_cast<MmapPhraseTable*>(basePhraseTablePtr);
+
+  std::string mmapFileName=phraseTTableFileName;
+  mmapFileName+=MMAP_TTABLE_FILE_SUFFIX;
+  std::cerr<<"Mapping binary phrase ttable from file "<<mmapFileName<<std::endl;
+  if(!MmapPhraseTable::isMmapPhraseTableFile(mmapFileName.c_str()))
+  {
+    std::cerr<<"Error: binary phrase ttable "<<mmapFileName<<" not found, it can be generated from "<<phraseTTableFileName<<" with the thot_ttable_to_mmap tool"<<std::endl;
+    return THOT_ERROR;
+  }
+  if(ptPtr->open(mmapFileName.c_str())==THOT_ERROR)
+    return THOT_ERROR;
+
+      // Register the words of the table in the vocabularies of the
+      // model, which may already contain other words
+  std::vector<WordIndex> srcFileToModel;
+  for(WordIndex w=0;w<ptPtr->getSrcVocabSize();++w)
+    srcFileToModel.push_back(addSrcSymbol(ptPtr->srcWordIndexToString(w)));
+  std::vector<WordIndex> trgFileToModel;
+  for(WordIndex w=0;w<ptPtr->getTrgVocabSize();++w)
+    trgFileToModel.push_back(addTrgSymbol(ptPtr->trgWordIndexToString(w)));
+  ptPtr->setWordIndexMaps(srcFileToModel,trgFileToModel);
+
+  return THOT_OK;
+}
+
+//-------------------------
+void MmapPhraseModel::printTTable(FILE* file)
+{
+  MmapPhraseTable* ptPtr=dynamic_cast<MmapPhraseTable*>(basePhraseTablePtr);
+
+  std::vector<WordIndex> t;
+  for(size_t n=0;n<ptPtr->getNumTrgPhrases();++n)
+  {
+    MmapPhraseTable::SrcTableNode srctn;
+    MmapPhraseTable::SrcTableNode::iterator srctnIter;
+    ptPtr->getTrgPhrase(n,t);
+    ptPtr->getEntriesForTarget(t,srctn);
+
+    for(srctnIter=srctn.begin();srctnIter!=srctn.end();++srctnIter)
+    {
+      std::vector<WordIndex>::const_iterator vectorWordIndexIter;
+      for(vectorWordIndexIter=srctnIter->first.begin();vectorWordIndexIter!=srctnIter->first.end();++vectorWordIndexIter)
+        fprintf(file,"%s ",wordIndexToSrcString(*vectorWordIndexIter).c_str());
+      fprintf(file,"|||");
+      for(vectorWordIndexIter=t.begin();vectorWordIndexIter!=t.end();++vectorWordIndexIter)
+        fprintf(file," %s",wordIndexToTrgString(*vectorWordIndexIter).c_str());
+      fprintf(file," ||| %.8f %.8f\n",(float)srctnIter->second.first.get_c_s(),(float)srctnIter->second.second.get_c_st());
+    }
+  }
+}
+
+//-------------------------
+MmapPhraseModel::~MmapPhraseModel()
+{
+  delete basePhraseTablePtr;  
+}
+
+//-------------------------
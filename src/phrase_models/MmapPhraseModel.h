@@ -0,0 +1,77 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseModel.h
+ *
+ * @brief Defines the MmapPhraseModel class. MmapPhraseModel is a
+ * phrase model whose translation table is a read-only MmapPhraseTable
+ * object. The table is loaded from the file <prefix>.ttable.mmap,
+ * which is generated from the <prefix>.ttable file by means of the
+ * thot_ttable_to_mmap tool.
+ */
+
+#ifndef _MmapPhraseModel_h
+#define _MmapPhraseModel_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "MmapPhraseTable.h"
+#include "_incrPhraseModel.h"
+
+//--------------- Constants ------------------------------------------
+
+#define MMAP_TTABLE_FILE_SUFFIX ".mmap"
+
+//--------------- function declarations ------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+
+//--------------- MmapPhraseModel class
+
+class MmapPhraseModel: public _incrPhraseModel
+{
+ public:
+
+    typedef _incrPhraseModel::SrcTableNode SrcTableNode;
+    typedef _incrPhraseModel::TrgTableNode TrgTableNode;
+
+        // Constructor
+    MmapPhraseModel(void);
+
+        // Loading functions
+    bool load_ttable(const char *phraseTTableFileName);
+        // Maps into memory the binary version of the given
+        // translation table
+
+        // Destructor
+	~MmapPhraseModel();
+	
+ protected:
+
+        // Functions to print models using standard C library
+    void printTTable(FILE* file);
+};
+
+#endif
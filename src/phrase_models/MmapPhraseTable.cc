@@ -0,0 +1,1012 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseTable.cc
+ *
+ * @brief Definitions file for MmapPhraseTable.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "MmapPhraseTable.h"
+#include "SingleWordVocab.h"
+#include "AwkInputStream.h"
+#include "MathDefs.h"
+#include "SmtDefs.h"
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//--------------- Local types ----------------------------------------
+
+namespace
+{
+      // Phrase pair read from the text ttable, phrases are given by
+      // their position in lexicographical order
+  struct MmapPtEntry
+  {
+    uint32_t srcId;
+    uint32_t trgId;
+    float count;
+    uint64_t line;
+    Score score;
+  };
+
+      // Sorts entries by target, source and line
+  bool trgSrcLineOrder(const MmapPtEntry& a,
+                       const MmapPtEntry& b)
+  {
+    if(a.trgId!=b.trgId) return a.trgId<b.trgId;
+    if(a.srcId!=b.srcId) return a.srcId<b.srcId;
+    return a.line<b.line;
+  }
+
+      // Sorts entries by target, decreasing score and source
+  bool trgScoreSrcOrder(const MmapPtEntry& a,
+                        const MmapPtEntry& b)
+  {
+    if(a.trgId!=b.trgId) return a.trgId<b.trgId;
+    if(a.score!=b.score) return a.score>b.score;
+    return a.srcId<b.srcId;
+  }
+
+      // Sorts entries by source and target
+  bool srcTrgOrder(const MmapPtEntry& a,
+                   const MmapPtEntry& b)
+  {
+    if(a.srcId!=b.srcId) return a.srcId<b.srcId;
+    return a.trgId<b.trgId;
+  }
+
+  MmapPhrCountCode encodeCount(const std::vector<float>& codebook,
+                               float count)
+  {
+    std::vector<float>::const_iterator iter=std::lower_bound(codebook.begin(),codebook.end(),count);
+    if(iter==codebook.end())
+      return codebook.size()-1;
+    if(iter!=codebook.begin() && count-*(iter-1)<*iter-count)
+      --iter;
+    return iter-codebook.begin();
+  }
+
+      // Assigns to each phrase its position in lexicographical order
+      // and writes the phrases and their counts
+  void writePhrases(std::ofstream& outF,
+                    const std::map<std::vector<WordIndex>,uint32_t>& phrMap,
+                    const std::vector<float>& tmpCounts,
+                    std::vector<uint32_t>& tmpIdToId,
+                    std::vector<uint64_t>& offsets,
+                    std::vector<float>& counts)
+  {
+    tmpIdToId.resize(phrMap.size());
+    offsets.clear();
+    counts.clear();
+    uint64_t pos=0;
+    offsets.push_back(pos);
+    std::map<std::vector<WordIndex>,uint32_t>::const_iterator mapIter;
+    for(mapIter=phrMap.begin();mapIter!=phrMap.end();++mapIter)
+    {
+      tmpIdToId[mapIter->second]=counts.size();
+      counts.push_back(tmpCounts[mapIter->second]);
+      for(size_t i=0;i<mapIter->first.size();++i)
+      {
+        uint32_t w=mapIter->first[i];
+        outF.write((const char*)&w,sizeof(w));
+      }
+      pos+=mapIter->first.size();
+      offsets.push_back(pos);
+    }
+  }
+
+  template<class T>
+  void writeVector(std::ofstream& outF,
+                   const std::vector<T>& vec)
+  {
+    if(!vec.empty())
+      outF.write((const char*)&vec[0],vec.size()*sizeof(T));
+  }
+}
+
+//--------------- MmapPhraseTable class functions
+
+//-------------------------
+MmapPhraseTable::MmapPhraseTable(void)
+{
+  mapAddr=NULL;
+  mapSize=0;
+  header=NULL;
+  codebook=NULL;
+  resetIndex(srcIndex);
+  resetIndex(trgIndex);
+  readOnlyWarningShown=false;
+}
+
+//-------------------------
+bool MmapPhraseTable::isMmapPhraseTableFile(const char* fileName)
+{
+  std::ifstream inF(fileName,std::ios::in | std::ios::binary);
+  if(!inF)
+    return false;
+
+  char magic[8];
+  if(!inF.read(magic,sizeof(magic)))
+    return false;
+  return memcmp(magic,MMAP_PHRASE_TABLE_MAGIC,sizeof(magic))==0;
+}
+
+//-------------------------
+bool MmapPhraseTable::create(const char* ttableFileName,
+                             const char* outFileName,
+                             int verbose)
+{
+  AwkInputStream awk;
+  if(awk.open(ttableFileName)==THOT_ERROR)
+  {
+    std::cerr<<"Error in ttable file: "<<ttableFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Read text ttable. Phrases are given temporary identifiers in
+      // order of appearance. As when loading the text ttable, source
+      // counts are overwritten, joint counts of repeated entries are
+      // overwritten and target counts accumulate joint counts
+  if(verbose) std::cerr<<"Reading ttable from file "<<ttableFileName<<std::endl;
+  SingleWordVocab swVocab;
+  std::map<std::vector<WordIndex>,uint32_t> srcPhrMap;
+  std::map<std::vector<WordIndex>,uint32_t> trgPhrMap;
+  std::vector<float> srcTmpCounts;
+  std::vector<float> trgTmpCounts;
+  std::vector<MmapPtEntry> entries;
+  std::vector<std::string> s,t;
+  unsigned int numEntry=1;
+  while(awk.getln())
+  {
+    if(awk.FNR>=1 && awk.NF>1)
+    {
+      unsigned int i=1;
+      s.clear();
+      while(i<=awk.NF && strcmp("|||",awk.dollar(i).c_str())!=0)
+      {
+        s.push_back(awk.dollar(i));
+        ++i;
+      }
+      ++i;
+      t.clear();
+      while(i<=awk.NF && strcmp("|||",awk.dollar(i).c_str())!=0)
+      {
+        t.push_back(awk.dollar(i));
+        ++i;
+      }
+      if(i<awk.NF-1 && strcmp("|||",awk.dollar(i).c_str())==0 && !s.empty() && !t.empty())
+      {
+        float c_s=atof(awk.dollar(i+1).c_str());
+        float c_st=atof(awk.dollar(i+2).c_str());
+
+        std::vector<WordIndex> srcPhr=swVocab.strVectorToSrcIndexVector(s);
+        std::vector<WordIndex> trgPhr=swVocab.strVectorToTrgIndexVector(t);
+        std::pair<std::map<std::vector<WordIndex>,uint32_t>::iterator,bool> srcIns=srcPhrMap.insert(std::make_pair(srcPhr,(uint32_t)srcTmpCounts.size()));
+        if(srcIns.second)
+          srcTmpCounts.push_back(0);
+        std::pair<std::map<std::vector<WordIndex>,uint32_t>::iterator,bool> trgIns=trgPhrMap.insert(std::make_pair(trgPhr,(uint32_t)trgTmpCounts.size()));
+        if(trgIns.second)
+          trgTmpCounts.push_back(0);
+
+        srcTmpCounts[srcIns.first->second]=c_s;
+        trgTmpCounts[trgIns.first->second]=(float)(Count(trgTmpCounts[trgIns.first->second])+Count(c_st));
+        MmapPtEntry entry;
+        entry.srcId=srcIns.first->second;
+        entry.trgId=trgIns.first->second;
+        entry.count=c_st;
+        entry.line=numEntry;
+        entry.score=0;
+        entries.push_back(entry);
+      }
+      else
+      {
+        std::cerr<<"Warning: discarding anomalous phrase table entry at line "<<numEntry<<std::endl;
+      }
+    }
+    ++numEntry;
+  }
+  awk.close();
+
+  std::ofstream outF(outFileName,std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!outF)
+  {
+    std::cerr<<"Error while creating binary phrase table file "<<outFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Write provisional header, it is rewritten at the end
+  Header hdr;
+  memset(&hdr,0,sizeof(hdr));
+  memcpy(hdr.magic,MMAP_PHRASE_TABLE_MAGIC,sizeof(hdr.magic));
+  hdr.version=MMAP_PHRASE_TABLE_VERSION;
+  outF.write((const char*)&hdr,sizeof(hdr));
+
+      // Write source and target phrases
+  std::vector<uint32_t> srcTmpIdToId;
+  std::vector<uint32_t> trgTmpIdToId;
+  std::vector<uint64_t> offsets;
+  std::vector<float> srcCounts;
+  std::vector<float> trgCounts;
+  hdr.numSrcPhrases=srcPhrMap.size();
+  hdr.srcWordsPos=outF.tellp();
+  writePhrases(outF,srcPhrMap,srcTmpCounts,srcTmpIdToId,offsets,srcCounts);
+  srcPhrMap.clear();
+  alignOutput(outF);
+  hdr.srcOffsetsPos=outF.tellp();
+  writeVector(outF,offsets);
+  hdr.srcCountsPos=outF.tellp();
+  writeVector(outF,srcCounts);
+  alignOutput(outF);
+
+  hdr.numTrgPhrases=trgPhrMap.size();
+  hdr.trgWordsPos=outF.tellp();
+  writePhrases(outF,trgPhrMap,trgTmpCounts,trgTmpIdToId,offsets,trgCounts);
+  trgPhrMap.clear();
+  alignOutput(outF);
+  hdr.trgOffsetsPos=outF.tellp();
+  writeVector(outF,offsets);
+  hdr.trgCountsPos=outF.tellp();
+  writeVector(outF,trgCounts);
+  alignOutput(outF);
+
+      // Remove repeated entries, keeping the last one
+  for(size_t i=0;i<entries.size();++i)
+  {
+    entries[i].srcId=srcTmpIdToId[entries[i].srcId];
+    entries[i].trgId=trgTmpIdToId[entries[i].trgId];
+  }
+  std::sort(entries.begin(),entries.end(),trgSrcLineOrder);
+  size_t numUniqEntries=0;
+  for(size_t i=0;i<entries.size();++i)
+  {
+    if(i+1<entries.size() && entries[i+1].trgId==entries[i].trgId && entries[i+1].srcId==entries[i].srcId)
+      continue;
+    entries[numUniqEntries++]=entries[i];
+  }
+  entries.resize(numUniqEntries);
+  hdr.numEntries=numUniqEntries;
+
+      // Build codebook of joint counts. Counts are stored exactly if
+      // the number of different values allows it, otherwise the
+      // codebook is given by equally spaced quantiles
+  std::vector<float> countVec;
+  countVec.reserve(entries.size());
+  for(size_t i=0;i<entries.size();++i)
+    countVec.push_back(entries[i].count);
+  std::sort(countVec.begin(),countVec.end());
+  countVec.erase(std::unique(countVec.begin(),countVec.end()),countVec.end());
+  std::vector<float> codebookVec;
+  if(countVec.size()<=MMAP_PHRASE_TABLE_MAX_CODES)
+  {
+    codebookVec.swap(countVec);
+  }
+  else
+  {
+    hdr.flags|=MMAP_PHRASE_TABLE_QUANT_FLAG;
+    for(size_t k=0;k<MMAP_PHRASE_TABLE_MAX_CODES;++k)
+      codebookVec.push_back(countVec[(k*(countVec.size()-1))/(MMAP_PHRASE_TABLE_MAX_CODES-1)]);
+  }
+  hdr.numCodes=codebookVec.size();
+  hdr.codebookPos=outF.tellp();
+  writeVector(outF,codebookVec);
+  alignOutput(outF);
+
+      // Quantize joint counts and compute translation scores, scores
+      // are obtained as in the getNbestForTrg() function
+  std::vector<MmapPhrCountCode> codes;
+  for(size_t i=0;i<entries.size();++i)
+  {
+    entries[i].count=codebookVec[encodeCount(codebookVec,entries[i].count)];
+    LgProb lgProb=log(entries[i].count/trgCounts[entries[i].trgId]);
+    entries[i].score=lgProb;
+  }
+
+      // Write entries of target phrases sorted by score. Entries with
+      // null counts are not returned when querying the table for a
+      // target phrase, so they are not included
+  std::sort(entries.begin(),entries.end(),trgScoreSrcOrder);
+  std::vector<uint32_t> ids;
+  offsets.assign(1,0);
+  for(size_t i=0;i<entries.size();++i)
+  {
+    while(offsets.size()<=entries[i].trgId)
+      offsets.push_back(ids.size());
+    if(fabs(srcCounts[entries[i].srcId])<EPSILON || fabs(entries[i].count)<EPSILON)
+      continue;
+    ids.push_back(entries[i].srcId);
+    codes.push_back(encodeCount(codebookVec,entries[i].count));
+  }
+  while(offsets.size()<=hdr.numTrgPhrases)
+    offsets.push_back(ids.size());
+  hdr.trgEntryOffsetsPos=outF.tellp();
+  writeVector(outF,offsets);
+  hdr.trgEntryIdsPos=outF.tellp();
+  writeVector(outF,ids);
+  alignOutput(outF);
+  hdr.trgEntryCodesPos=outF.tellp();
+  writeVector(outF,codes);
+  alignOutput(outF);
+
+      // Write entries of source phrases sorted by target phrase
+  std::sort(entries.begin(),entries.end(),srcTrgOrder);
+  ids.clear();
+  codes.clear();
+  offsets.assign(1,0);
+  for(size_t i=0;i<entries.size();++i)
+  {
+    while(offsets.size()<=entries[i].srcId)
+      offsets.push_back(ids.size());
+    ids.push_back(entries[i].trgId);
+    codes.push_back(encodeCount(codebookVec,entries[i].count));
+  }
+  while(offsets.size()<=hdr.numSrcPhrases)
+    offsets.push_back(ids.size());
+  hdr.srcEntryOffsetsPos=outF.tellp();
+  writeVector(outF,offsets);
+  hdr.srcEntryIdsPos=outF.tellp();
+  writeVector(outF,ids);
+  alignOutput(outF);
+  hdr.srcEntryCodesPos=outF.tellp();
+  writeVector(outF,codes);
+  alignOutput(outF);
+
+      // Store vocabularies
+  std::vector<std::string> vocab;
+  hdr.srcVocabPos=outF.tellp();
+  hdr.srcVocabSize=swVocab.getSrcVocabSize();
+  for(WordIndex w=0;w<hdr.srcVocabSize;++w)
+    vocab.push_back(swVocab.wordIndexToSrcString(w));
+  writeVocab(outF,vocab);
+  alignOutput(outF);
+  vocab.clear();
+  hdr.trgVocabPos=outF.tellp();
+  hdr.trgVocabSize=swVocab.getTrgVocabSize();
+  for(WordIndex w=0;w<hdr.trgVocabSize;++w)
+    vocab.push_back(swVocab.wordIndexToTrgString(w));
+  writeVocab(outF,vocab);
+  alignOutput(outF);
+  hdr.fileSize=outF.tellp();
+
+      // Rewrite header
+  outF.seekp(0);
+  outF.write((const char*)&hdr,sizeof(hdr));
+  outF.close();
+  if(!outF)
+  {
+    std::cerr<<"Error while writing binary phrase table file "<<outFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(verbose)
+  {
+    std::cerr<<"#Source phrases: "<<hdr.numSrcPhrases<<std::endl;
+    std::cerr<<"#Target phrases: "<<hdr.numTrgPhrases<<std::endl;
+    std::cerr<<"#Phrase pairs: "<<hdr.numEntries<<std::endl;
+    std::cerr<<"Codebook size: "<<hdr.numCodes;
+    if(hdr.flags & MMAP_PHRASE_TABLE_QUANT_FLAG)
+      std::cerr<<" (joint counts were quantized)";
+    std::cerr<<std::endl;
+  }
+  return THOT_OK;
+}
+
+//-------------------------
+void MmapPhraseTable::writeVocab(std::ofstream& outF,
+                                 const std::vector<std::string>& vocab)
+{
+  for(size_t i=0;i<vocab.size();++i)
+    outF.write(vocab[i].c_str(),vocab[i].size()+1);
+}
+
+//-------------------------
+void MmapPhraseTable::alignOutput(std::ofstream& outF)
+{
+  uint64_t pos=outF.tellp();
+  static const char padding[8]={0,0,0,0,0,0,0,0};
+  if(pos%8!=0)
+    outF.write(padding,8-pos%8);
+}
+
+//-------------------------
+bool MmapPhraseTable::open(const char* fileName)
+{
+  clear();
+
+  int fd=::open(fileName,O_RDONLY);
+  if(fd==-1)
+  {
+    std::cerr<<"Error: binary phrase table file "<<fileName<<" does not exist"<<std::endl;
+    return THOT_ERROR;
+  }
+  struct stat st;
+  if(fstat(fd,&st)==-1 || (size_t)st.st_size<sizeof(Header))
+  {
+    std::cerr<<"Error: file "<<fileName<<" is not a valid binary phrase table"<<std::endl;
+    ::close(fd);
+    return THOT_ERROR;
+  }
+  void* addr=mmap(NULL,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+  ::close(fd);
+  if(addr==MAP_FAILED)
+  {
+    std::cerr<<"Error: binary phrase table file "<<fileName<<" could not be mapped into memory"<<std::endl;
+    return THOT_ERROR;
+  }
+  mapAddr=addr;
+  mapSize=st.st_size;
+
+      // Check header
+  header=(const Header*)mapAddr;
+  if(memcmp(header->magic,MMAP_PHRASE_TABLE_MAGIC,sizeof(header->magic))!=0 ||
+     header->version!=MMAP_PHRASE_TABLE_VERSION ||
+     header->fileSize!=mapSize)
+  {
+    std::cerr<<"Error: file "<<fileName<<" is not a valid binary phrase table or it was created by an incompatible version"<<std::endl;
+    clear();
+    return THOT_ERROR;
+  }
+
+      // Set section pointers
+  const unsigned char* base=(const unsigned char*)mapAddr;
+  srcIndex.numPhrases=header->numSrcPhrases;
+  srcIndex.offsets=(const uint64_t*)(base+header->srcOffsetsPos);
+  srcIndex.words=(const uint32_t*)(base+header->srcWordsPos);
+  srcIndex.counts=(const float*)(base+header->srcCountsPos);
+  srcIndex.entryOffsets=(const uint64_t*)(base+header->srcEntryOffsetsPos);
+  srcIndex.entryIds=(const uint32_t*)(base+header->srcEntryIdsPos);
+  srcIndex.entryCodes=(const MmapPhrCountCode*)(base+header->srcEntryCodesPos);
+  trgIndex.numPhrases=header->numTrgPhrases;
+  trgIndex.offsets=(const uint64_t*)(base+header->trgOffsetsPos);
+  trgIndex.words=(const uint32_t*)(base+header->trgWordsPos);
+  trgIndex.counts=(const float*)(base+header->trgCountsPos);
+  trgIndex.entryOffsets=(const uint64_t*)(base+header->trgEntryOffsetsPos);
+  trgIndex.entryIds=(const uint32_t*)(base+header->trgEntryIdsPos);
+  trgIndex.entryCodes=(const MmapPhrCountCode*)(base+header->trgEntryCodesPos);
+  codebook=(const float*)(base+header->codebookPos);
+
+      // Load vocabularies
+  if(loadVocab(header->srcVocabPos,header->srcVocabSize,srcVocab)==THOT_ERROR ||
+     loadVocab(header->trgVocabPos,header->trgVocabSize,trgVocab)==THOT_ERROR)
+  {
+    std::cerr<<"Error: vocabulary of binary phrase table "<<fileName<<" is corrupted"<<std::endl;
+    clear();
+    return THOT_ERROR;
+  }
+
+      // Use the word indices of the file
+  std::vector<WordIndex> srcFileToModel;
+  for(WordIndex w=0;w<srcVocab.size();++w)
+    srcFileToModel.push_back(w);
+  std::vector<WordIndex> trgFileToModel;
+  for(WordIndex w=0;w<trgVocab.size();++w)
+    trgFileToModel.push_back(w);
+  setWordIndexMaps(srcFileToModel,trgFileToModel);
+
+  return THOT_OK;
+}
+
+//-------------------------
+void MmapPhraseTable::resetIndex(PhraseIndex& phrIndex)
+{
+  phrIndex.numPhrases=0;
+  phrIndex.offsets=NULL;
+  phrIndex.words=NULL;
+  phrIndex.counts=NULL;
+  phrIndex.entryOffsets=NULL;
+  phrIndex.entryIds=NULL;
+  phrIndex.entryCodes=NULL;
+  phrIndex.fileToModel.clear();
+  phrIndex.modelToFile.clear();
+}
+
+//-------------------------
+void MmapPhraseTable::setWordIndexMaps(const std::vector<WordIndex>& srcFileToModel,
+                                       const std::vector<WordIndex>& trgFileToModel)
+{
+  setWordIndexMap(srcIndex,srcFileToModel);
+  setWordIndexMap(trgIndex,trgFileToModel);
+}
+
+//-------------------------
+void MmapPhraseTable::setWordIndexMap(PhraseIndex& phrIndex,
+                                      const std::vector<WordIndex>& fileToModel)
+{
+  phrIndex.fileToModel=fileToModel;
+  phrIndex.modelToFile.clear();
+  for(WordIndex w=0;w<fileToModel.size();++w)
+  {
+    if(fileToModel[w]>=phrIndex.modelToFile.size())
+      phrIndex.modelToFile.resize(fileToModel[w]+1,UNUSED_WORD);
+    phrIndex.modelToFile[fileToModel[w]]=w;
+  }
+}
+
+//-------------------------
+bool MmapPhraseTable::loadVocab(uint64_t pos,
+                                uint64_t vocabSize,
+                                std::vector<std::string>& vocab)
+{
+  vocab.clear();
+  vocab.reserve(vocabSize);
+  const char* base=(const char*)mapAddr;
+  for(uint64_t i=0;i<vocabSize;++i)
+  {
+    const char* end=(const char*)memchr(base+pos,0,mapSize-pos);
+    if(end==NULL)
+      return THOT_ERROR;
+    vocab.push_back(std::string(base+pos,end));
+    pos=(end-base)+1;
+  }
+  return THOT_OK;
+}
+
+//-------------------------
+bool MmapPhraseTable::isOpen(void)const
+{
+  return mapAddr!=NULL;
+}
+
+//-------------------------
+size_t MmapPhraseTable::getSrcVocabSize(void)const
+{
+  return srcVocab.size();
+}
+
+//-------------------------
+const std::string& MmapPhraseTable::srcWordIndexToString(WordIndex w)const
+{
+  return srcVocab[w];
+}
+
+//-------------------------
+size_t MmapPhraseTable::getTrgVocabSize(void)const
+{
+  return trgVocab.size();
+}
+
+//-------------------------
+const std::string& MmapPhraseTable::trgWordIndexToString(WordIndex w)const
+{
+  return trgVocab[w];
+}
+
+//-------------------------
+size_t MmapPhraseTable::getNumTrgPhrases(void)const
+{
+  return trgIndex.numPhrases;
+}
+
+//-------------------------
+void MmapPhraseTable::getTrgPhrase(size_t n,
+                                   std::vector<WordIndex>& t)const
+{
+  getPhrase(trgIndex,n,t);
+}
+
+//-------------------------
+uint64_t MmapPhraseTable::findPhrase(const PhraseIndex& phrIndex,
+                                     const std::vector<WordIndex>& phr)const
+{
+      // Obtain word indices of the file, words not included in the
+      // vocabulary of the file cannot be part of the table
+  WordIndex filePhr[MAX_SENTENCE_LENGTH_ALLOWED];
+  if(phr.size()>MAX_SENTENCE_LENGTH_ALLOWED)
+    return phrIndex.numPhrases;
+  for(size_t i=0;i<phr.size();++i)
+  {
+    if(phr[i]>=phrIndex.modelToFile.size() || phrIndex.modelToFile[phr[i]]==UNUSED_WORD)
+      return phrIndex.numPhrases;
+    filePhr[i]=phrIndex.modelToFile[phr[i]];
+  }
+
+  uint64_t left=0;
+  uint64_t right=phrIndex.numPhrases;
+  while(left<right)
+  {
+    uint64_t mid=left+(right-left)/2;
+    const uint32_t* begin=phrIndex.words+phrIndex.offsets[mid];
+    const uint32_t* end=phrIndex.words+phrIndex.offsets[mid+1];
+    if(std::lexicographical_compare(begin,end,filePhr,filePhr+phr.size()))
+      left=mid+1;
+    else
+      right=mid;
+  }
+  if(left<phrIndex.numPhrases &&
+     phrIndex.offsets[left+1]-phrIndex.offsets[left]==phr.size() &&
+     std::equal(filePhr,filePhr+phr.size(),phrIndex.words+phrIndex.offsets[left]))
+    return left;
+  else
+    return phrIndex.numPhrases;
+}
+
+//-------------------------
+void MmapPhraseTable::getPhrase(const PhraseIndex& phrIndex,
+                                uint64_t n,
+                                std::vector<WordIndex>& phr)const
+{
+  phr.clear();
+  for(uint64_t i=phrIndex.offsets[n];i<phrIndex.offsets[n+1];++i)
+    phr.push_back(phrIndex.fileToModel[phrIndex.words[i]]);
+}
+
+//-------------------------
+Count MmapPhraseTable::findSrcTrgCount(uint64_t srcPos,
+                                       uint64_t trgPos,
+                                       bool& found)const
+{
+  const uint32_t* begin=srcIndex.entryIds+srcIndex.entryOffsets[srcPos];
+  const uint32_t* end=srcIndex.entryIds+srcIndex.entryOffsets[srcPos+1];
+  const uint32_t* iter=std::lower_bound(begin,end,(uint32_t)trgPos);
+  if(iter!=end && *iter==trgPos)
+  {
+    found=true;
+    return codebook[srcIndex.entryCodes[iter-srcIndex.entryIds]];
+  }
+  else
+  {
+    found=false;
+    return 0;
+  }
+}
+
+//-------------------------
+void MmapPhraseTable::showReadOnlyWarning(void)
+{
+  if(!readOnlyWarningShown)
+  {
+    std::cerr<<"Warning: memory-mapped phrase tables are read-only, the table will not be modified"<<std::endl;
+    readOnlyWarningShown=true;
+  }
+}
+
+//-------------------------
+void MmapPhraseTable::addTableEntry(const std::vector<WordIndex>& /*s*/,
+                                    const std::vector<WordIndex>& /*t*/,
+                                    PhrasePairInfo /*inf*/)
+{
+  showReadOnlyWarning();
+}
+
+//-------------------------
+void MmapPhraseTable::addSrcInfo(const std::vector<WordIndex>& /*s*/,
+                                 Count /*s_inf*/)
+{
+  showReadOnlyWarning();
+}
+
+//-------------------------
+void MmapPhraseTable::addSrcTrgInfo(const std::vector<WordIndex>& /*s*/,
+                                    const std::vector<WordIndex>& /*t*/,
+                                    Count /*st_inf*/)
+{
+  showReadOnlyWarning();
+}
+
+//-------------------------
+void MmapPhraseTable::incrCountsOfEntry(const std::vector<WordIndex>& /*s*/,
+                                        const std::vector<WordIndex>& /*t*/,
+                                        Count /*c*/)
+{
+  showReadOnlyWarning();
+}
+
+//-------------------------
+PhrasePairInfo MmapPhraseTable::infSrcTrg(const std::vector<WordIndex>& s,
+                                          const std::vector<WordIndex>& t,
+                                          bool& found)
+{
+  PhrasePairInfo ppi;
+
+  ppi.first=getSrcInfo(s,found);
+  if(!found)
+  {
+    ppi.second=0;
+    return ppi;
+  }
+  else
+  {
+    ppi.second=getSrcTrgInfo(s,t,found);
+    return ppi;
+  }
+}
+
+//-------------------------
+Count MmapPhraseTable::getSrcInfo(const std::vector<WordIndex>& s,
+                                  bool &found)
+{
+  uint64_t srcPos=findPhrase(srcIndex,s);
+  if(srcPos==srcIndex.numPhrases)
+  {
+    found=false;
+    return 0;
+  }
+  else
+  {
+    found=true;
+    return srcIndex.counts[srcPos];
+  }
+}
+
+//-------------------------
+Count MmapPhraseTable::getTrgInfo(const std::vector<WordIndex>& t,
+                                  bool &found)
+{
+  uint64_t trgPos=findPhrase(trgIndex,t);
+  if(trgPos==trgIndex.numPhrases)
+  {
+    found=false;
+    return 0;
+  }
+  else
+  {
+    found=true;
+    return trgIndex.counts[trgPos];
+  }
+}
+
+//-------------------------
+Count MmapPhraseTable::getSrcTrgInfo(const std::vector<WordIndex>& s,
+                                     const std::vector<WordIndex>& t,
+                                     bool &found)
+{
+  uint64_t srcPos=findPhrase(srcIndex,s);
+  uint64_t trgPos=findPhrase(trgIndex,t);
+  if(srcPos==srcIndex.numPhrases || trgPos==trgIndex.numPhrases)
+  {
+    found=false;
+    return 0;
+  }
+  else
+    return findSrcTrgCount(srcPos,trgPos,found);
+}
+
+//-------------------------
+Prob MmapPhraseTable::pTrgGivenSrc(const std::vector<WordIndex>& s,
+                                   const std::vector<WordIndex>& t)
+{
+  Count st_count=cSrcTrg(s,t);
+  if((float)st_count>0)
+  {
+    Count s_count=cSrc(s);
+    if((float)s_count>0)
+      return ((float)st_count)/((float)s_count);
+    else
+      return PHRASE_PROB_SMOOTH;
+  }
+  else return PHRASE_PROB_SMOOTH;
+}
+
+//-------------------------
+LgProb MmapPhraseTable::logpTrgGivenSrc(const std::vector<WordIndex>& s,
+                                        const std::vector<WordIndex>& t)
+{
+  return log((double)pTrgGivenSrc(s,t));
+}
+
+//-------------------------
+Prob MmapPhraseTable::pSrcGivenTrg(const std::vector<WordIndex>& s,
+                                   const std::vector<WordIndex>& t)
+{
+  Count st_count=cSrcTrg(s,t);
+  if((float)st_count>0)
+  {
+    Count t_count=cTrg(t);
+    if((float)t_count>0)
+      return ((float)st_count)/((float)t_count);
+    else
+      return PHRASE_PROB_SMOOTH;
+  }
+  else return PHRASE_PROB_SMOOTH;
+}
+
+//-------------------------
+LgProb MmapPhraseTable::logpSrcGivenTrg(const std::vector<WordIndex>& s,
+                                        const std::vector<WordIndex>& t)
+{
+  return log((double)pSrcGivenTrg(s,t));
+}
+
+//-------------------------
+bool MmapPhraseTable::getEntriesForTarget(const std::vector<WordIndex>& t,
+                                          SrcTableNode& srctn)
+{
+  srctn.clear();
+
+  uint64_t trgPos=findPhrase(trgIndex,t);
+  if(trgPos==trgIndex.numPhrases)
+    return false;
+
+  std::vector<WordIndex> s;
+  for(uint64_t e=trgIndex.entryOffsets[trgPos];e<trgIndex.entryOffsets[trgPos+1];++e)
+  {
+    uint32_t srcPos=trgIndex.entryIds[e];
+    getPhrase(srcIndex,srcPos,s);
+    PhrasePairInfo ppi;
+    ppi.first=srcIndex.counts[srcPos];
+    ppi.second=codebook[trgIndex.entryCodes[e]];
+    srctn.insert(std::make_pair(s,ppi));
+  }
+  return srctn.size();
+}
+
+//-------------------------
+bool MmapPhraseTable::getEntriesForSource(const std::vector<WordIndex>& s,
+                                          TrgTableNode& trgtn)
+{
+  trgtn.clear();
+
+  uint64_t srcPos=findPhrase(srcIndex,s);
+  if(srcPos==srcIndex.numPhrases)
+    return false;
+
+  std::vector<WordIndex> t;
+  for(uint64_t e=srcIndex.entryOffsets[srcPos];e<srcIndex.entryOffsets[srcPos+1];++e)
+  {
+    uint32_t trgPos=srcIndex.entryIds[e];
+    PhrasePairInfo ppi;
+    ppi.first=trgIndex.counts[trgPos];
+    ppi.second=codebook[srcIndex.entryCodes[e]];
+    if(fabs(ppi.first.get_c_s())<EPSILON || fabs(ppi.second.get_c_s())<EPSILON)
+      continue;
+    getPhrase(trgIndex,trgPos,t);
+    trgtn.insert(std::make_pair(t,ppi));
+  }
+  return trgtn.size();
+}
+
+//-------------------------
+bool MmapPhraseTable::getNbestForSrc(const std::vector<WordIndex>& s,
+                                     NbestTableNode<PhraseTransTableNodeData>& nbt)
+{
+  nbt.clear();
+
+  TrgTableNode node;
+  if(getEntriesForSource(s,node))
+  {
+    Count s_count=cSrc(s);
+    TrgTableNode::iterator iter;
+    for(iter=node.begin();iter!=node.end();++iter)
+    {
+      float c_st=(float)iter->second.second.get_c_st();
+      LgProb lgProb=log(c_st/(float)s_count);
+      nbt.insert(lgProb,iter->first);
+    }
+#   ifdef DO_STABLE_SORT_ON_NBEST_TABLE
+    nbt.stableSort();
+#   endif
+    return true;
+  }
+  else
+    return false;
+}
+
+//-------------------------
+bool MmapPhraseTable::getNbestForTrg(const std::vector<WordIndex>& t,
+                                     NbestTableNode<PhraseTransTableNodeData>& nbt,
+                                     int N)
+{
+  nbt.clear();
+
+  uint64_t trgPos=findPhrase(trgIndex,t);
+  if(trgPos==trgIndex.numPhrases)
+    return false;
+
+      // Entries are sorted by decreasing score, so the n-best list is
+      // given by the first N entries. Ties are stored in the order of
+      // the word indices of the file, so each group of tied entries
+      // is sorted by the source phrase in the word indices of the
+      // model before being inserted, as done by StlPhraseTable. Only
+      // the groups that are (partially) included in the n-best list
+      // are visited
+  uint64_t begin=trgIndex.entryOffsets[trgPos];
+  uint64_t end=trgIndex.entryOffsets[trgPos+1];
+  if(begin==end)
+    return false;
+  uint64_t numEntries=end-begin;
+  if(N>=0 && numEntries>(uint64_t)N)
+    numEntries=N;
+
+  float t_count=trgIndex.counts[trgPos];
+  std::vector<PhraseTransTableNodeData> tiedVec;
+  uint64_t e=begin;
+  while(e<end && nbt.size()<numEntries)
+  {
+        // Obtain group of entries tied with entry e
+    uint64_t groupEnd=e+1;
+    while(groupEnd<end && trgIndex.entryCodes[groupEnd]==trgIndex.entryCodes[e])
+      ++groupEnd;
+    tiedVec.resize(groupEnd-e);
+    for(uint64_t i=e;i<groupEnd;++i)
+      getPhrase(srcIndex,trgIndex.entryIds[i],tiedVec[i-e]);
+    if(tiedVec.size()>1)
+      std::sort(tiedVec.begin(),tiedVec.end());
+
+        // Insert entries until the n-best list is complete
+    float c_st=codebook[trgIndex.entryCodes[e]];
+    LgProb lgProb=log(c_st/t_count);
+    for(size_t i=0;i<tiedVec.size() && nbt.size()<numEntries;++i)
+      nbt.insert(lgProb,tiedVec[i]);
+    e=groupEnd;
+  }
+  return true;
+}
+
+//-------------------------
+Count MmapPhraseTable::cSrcTrg(const std::vector<WordIndex>& s,
+                               const std::vector<WordIndex>& t)
+{
+  bool found;
+  return getSrcTrgInfo(s,t,found);
+}
+
+//-------------------------
+Count MmapPhraseTable::cSrc(const std::vector<WordIndex>& s)
+{
+  bool found;
+  return getSrcInfo(s,found);
+}
+
+//-------------------------
+Count MmapPhraseTable::cTrg(const std::vector<WordIndex>& t)
+{
+  bool found;
+  return getTrgInfo(t,found);
+}
+
+//-------------------------
+size_t MmapPhraseTable::size(void)
+{
+  if(header)
+    return header->numEntries;
+  else
+    return 0;
+}
+
+//-------------------------
+void MmapPhraseTable::clear(void)
+{
+  if(mapAddr!=NULL)
+  {
+    munmap(mapAddr,mapSize);
+    mapAddr=NULL;
+  }
+  mapSize=0;
+  header=NULL;
+  codebook=NULL;
+  resetIndex(srcIndex);
+  resetIndex(trgIndex);
+  srcVocab.clear();
+  trgVocab.clear();
+}
+
+//-------------------------
+MmapPhraseTable::~MmapPhraseTable()
+{
+  clear();
+}
@@ -0,0 +1,246 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseTable.h
+ *
+ * @brief Defines the MmapPhraseTable class, a read-only phrase table
+ * stored in a binary file that is memory-mapped on load. Source and
+ * target phrases are stored in lexicographical order together with
+ * their counts, so they are located by binary search. The entries of
+ * each target phrase are stored contiguously and pre-sorted by
+ * translation score, and the entries of each source phrase are sorted
+ * by target phrase. Joint counts are stored as 16-bit indices into a
+ * codebook of count values. The binary file is generated from a
+ * plain-text ttable by means of the create() function. Word indices
+ * used by the file can be mapped to those used by the phrase model.
+ */
+
+#ifndef _MmapPhraseTable_h
+#define _MmapPhraseTable_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "BasePhraseTable.h"
+#include "ErrorDefs.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define MMAP_PHRASE_TABLE_MAGIC        "THOTMPT"
+#define MMAP_PHRASE_TABLE_VERSION      1
+#define MMAP_PHRASE_TABLE_QUANT_FLAG   1
+#define MMAP_PHRASE_TABLE_MAX_CODES    65536
+
+//--------------- typedefs -------------------------------------------
+
+typedef uint16_t MmapPhrCountCode;
+
+//--------------- Classes --------------------------------------------
+
+//--------------- MmapPhraseTable class
+
+class MmapPhraseTable: public BasePhraseTable
+{
+ public:
+
+    typedef BasePhraseTable::SrcTableNode SrcTableNode;
+    typedef BasePhraseTable::TrgTableNode TrgTableNode;
+
+        // Constructor
+    MmapPhraseTable(void);
+
+        // Returns true if the given file contains a binary phrase table
+    static bool isMmapPhraseTableFile(const char* fileName);
+
+        // Converts the plain-text ttable given by ttableFileName into
+        // a binary phrase table
+    static bool create(const char* ttableFileName,
+                       const char* outFileName,
+                       int verbose=0);
+
+        // Maps a binary phrase table into memory
+    bool open(const char* fileName);
+    bool isOpen(void)const;
+
+        // Vocabularies stored in the file, the string of each word
+        // index is given
+    size_t getSrcVocabSize(void)const;
+    const std::string& srcWordIndexToString(WordIndex w)const;
+    size_t getTrgVocabSize(void)const;
+    const std::string& trgWordIndexToString(WordIndex w)const;
+
+        // Sets the word index used by the model for each word index of
+        // the file, by default the indices of the file are used
+    void setWordIndexMaps(const std::vector<WordIndex>& srcFileToModel,
+                          const std::vector<WordIndex>& trgFileToModel);
+
+        // Access to the target phrases of the table, n should be in
+        // the range [ 0 , getNumTrgPhrases() )
+    size_t getNumTrgPhrases(void)const;
+    void getTrgPhrase(size_t n,
+                      std::vector<WordIndex>& t)const;
+
+        // Functions to modify the table, they are not available since
+        // the table is read-only
+    void addTableEntry(const std::vector<WordIndex>& s,
+                       const std::vector<WordIndex>& t,
+                       PhrasePairInfo inf);
+    void addSrcInfo(const std::vector<WordIndex>& s,
+                    Count s_inf);
+    void addSrcTrgInfo(const std::vector<WordIndex>& s,
+                       const std::vector<WordIndex>& t,
+                       Count st_inf);
+    void incrCountsOfEntry(const std::vector<WordIndex>& s,
+                           const std::vector<WordIndex>& t,
+                           Count c);
+
+        // Functions to access the table
+    PhrasePairInfo infSrcTrg(const std::vector<WordIndex>& s,
+                             const std::vector<WordIndex>& t,
+                             bool &found);
+    Count getSrcInfo(const std::vector<WordIndex>& s,
+                     bool &found);
+    Count getTrgInfo(const std::vector<WordIndex>& t,
+                     bool &found);
+    Count getSrcTrgInfo(const std::vector<WordIndex>& s,
+                        const std::vector<WordIndex>& t,
+                        bool &found);
+    Prob pTrgGivenSrc(const std::vector<WordIndex>& s,
+                      const std::vector<WordIndex>& t);
+    LgProb logpTrgGivenSrc(const std::vector<WordIndex>& s,
+                           const std::vector<WordIndex>& t);
+    Prob pSrcGivenTrg(const std::vector<WordIndex>& s,
+                      const std::vector<WordIndex>& t);
+    LgProb logpSrcGivenTrg(const std::vector<WordIndex>& s,
+                           const std::vector<WordIndex>& t);
+    bool getEntriesForTarget(const std::vector<WordIndex>& t,
+                             SrcTableNode& srctn);
+    bool getEntriesForSource(const std::vector<WordIndex>& s,
+                             TrgTableNode& trgtn);
+    bool getNbestForSrc(const std::vector<WordIndex>& s,
+                        NbestTableNode<PhraseTransTableNodeData>& nbt);
+    bool getNbestForTrg(const std::vector<WordIndex>& t,
+                        NbestTableNode<PhraseTransTableNodeData>& nbt,
+                        int N=-1);
+        // Since the entries of each target phrase are pre-sorted, the
+        // cost of getNbestForTrg() only depends on N and on the number
+        // of entries tied with the N-th one. The n-best list is cut at
+        // N entries; entries tied in score are ranked by the
+        // lexicographical order of the model word indices of their
+        // source phrases, as in StlPhraseTable
+
+        // Counts-related functions
+    Count cSrcTrg(const std::vector<WordIndex>& s,
+                  const std::vector<WordIndex>& t);
+    Count cSrc(const std::vector<WordIndex>& s);
+    Count cTrg(const std::vector<WordIndex>& t);
+
+        // size and clear functions
+    size_t size(void);
+    void clear(void);
+
+        // Destructor
+    ~MmapPhraseTable();
+
+ private:
+
+        // Header of the binary file, all sections are 8-byte aligned
+    struct Header
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t flags;
+      uint64_t numSrcPhrases;
+      uint64_t numTrgPhrases;
+      uint64_t numEntries;
+      uint64_t numCodes;
+      uint64_t srcOffsetsPos;
+      uint64_t srcWordsPos;
+      uint64_t srcCountsPos;
+      uint64_t srcEntryOffsetsPos;
+      uint64_t srcEntryIdsPos;
+      uint64_t srcEntryCodesPos;
+      uint64_t trgOffsetsPos;
+      uint64_t trgWordsPos;
+      uint64_t trgCountsPos;
+      uint64_t trgEntryOffsetsPos;
+      uint64_t trgEntryIdsPos;
+      uint64_t trgEntryCodesPos;
+      uint64_t codebookPos;
+      uint64_t srcVocabSize;
+      uint64_t srcVocabPos;
+      uint64_t trgVocabSize;
+      uint64_t trgVocabPos;
+      uint64_t fileSize;
+    };
+
+        // Pointers to the sections of a phrase index (source or target)
+    struct PhraseIndex
+    {
+      uint64_t numPhrases;
+      const uint64_t* offsets;
+      const uint32_t* words;
+      const float* counts;
+      const uint64_t* entryOffsets;
+      const uint32_t* entryIds;
+      const MmapPhrCountCode* entryCodes;
+      std::vector<WordIndex> fileToModel;
+      std::vector<WordIndex> modelToFile;
+    };
+
+    void* mapAddr;
+    size_t mapSize;
+    const Header* header;
+    PhraseIndex srcIndex;
+    PhraseIndex trgIndex;
+    const float* codebook;
+    std::vector<std::string> srcVocab;
+    std::vector<std::string> trgVocab;
+    bool readOnlyWarningShown;
+
+        // Returns the position of the phrase (given by model word
+        // indices) in the index or numPhrases if not found
+    uint64_t findPhrase(const PhraseIndex& phrIndex,
+                        const std::vector<WordIndex>& phr)const;
+    void getPhrase(const PhraseIndex& phrIndex,
+                   uint64_t n,
+                   std::vector<WordIndex>& phr)const;
+    Count findSrcTrgCount(uint64_t srcPos,
+                          uint64_t trgPos,
+                          bool& found)const;
+    void showReadOnlyWarning(void);
+    void resetIndex(PhraseIndex& phrIndex);
+    void setWordIndexMap(PhraseIndex& phrIndex,
+                         const std::vector<WordIndex>& fileToModel);
+    bool loadVocab(uint64_t pos,
+                   uint64_t vocabSize,
+                   std::vector<std::string>& vocab);
+    static void writeVocab(std::ofstream& outF,
+                           const std::vector<std::string>& vocab);
+    static void alignOutput(std::ofstream& outF);
+};
+
+#endif
@@ -22,6 +22,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include <string>
+#include <vector>
 
 //--------------- Constants ------------------------------------------
 
@@ -125,6 +125,9 @@ int process_ttable(void)
       std::cerr << "Cannot create or recreate database (LevelDB)" << std::endl;
       return THOT_ERROR;
     }
+
+        // Entries are written in large batches sorted by key
+    levelDbPt.startBulkLoad();
     
         // Process translation table
     int i = 0;
@@ -147,6 +150,12 @@ int process_ttable(void)
         std::cerr << "Processed " << i << " lines" << std::endl;
     }
 
+    if(levelDbPt.endBulkLoad() == THOT_ERROR)
+    {
+      std::cerr << "Error while writing entries to database (LevelDB)" << std::endl;
+      return THOT_ERROR;
+    }
+
     std::cerr << "levelDB size: " << levelDbPt.size() << std::endl;
     
     return THOT_OK;
@@ -0,0 +1,120 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_ttable_to_mmap.cc
+ *
+ * @brief Converts a plain-text translation table into the binary
+ * format used by MmapPhraseModel.
+ */
+
+//--------------- Include files --------------------------------------
+
+#include <iostream>
+#include <stdio.h>
+#include "options.h"
+#include "MmapPhraseModel.h"
+
+//--------------- Function Declarations ------------------------------
+
+int TakeParameters(int argc,char *argv[]);
+void printUsage(void);
+void printDesc(void);
+
+//--------------- Global variables -----------------------------------
+
+std::string ttableFileName;
+std::string outFileName;
+int verbose;
+
+//--------------- Function Definitions -------------------------------
+
+//--------------- main function
+int main(int argc,char *argv[])
+{
+  if(TakeParameters(argc,argv)==THOT_OK)
+  {
+    return MmapPhraseTable::create(ttableFileName.c_str(),
+                                   outFileName.c_str(),
+                                   verbose);
+  }
+  else return THOT_ERROR;
+}
+
+//--------------- TakeParameters function
+int TakeParameters(int argc,char *argv[])
+{
+ int err;
+
+ if(argc==1)
+ {
+   printDesc();
+   return THOT_ERROR;
+ }
+
+     /* Verify --help option */
+ err=readOption(argc,argv,"--help");
+ if(err!=-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+     /* Take the file names */
+ err=readSTLstring(argc,argv, "-i", &ttableFileName);
+ if(err==-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+ err=readSTLstring(argc,argv, "-o", &outFileName);
+ if(err==-1)
+ {
+   outFileName=ttableFileName+MMAP_TTABLE_FILE_SUFFIX;
+ }
+
+     /* Take options */
+ verbose=(readOption(argc,argv,"-v")!=-1);
+
+ return THOT_OK;
+}
+
+//--------------- printDesc() function
+void printDesc(void)
+{
+  printf("thot_ttable_to_mmap written by Daniel Ortiz\n");
+  printf("A tool to convert a translation table into a memory-mappable binary format\n");
+  printf("type \"thot_ttable_to_mmap --help\" to get usage information.\n");
+}
+
+//--------------- printUsage() function
+void printUsage(void)
+{
+  printf("Usage: thot_ttable_to_mmap -i <string> [-o <string>] [-v] [--help]\n\n");
+  printf("-i <string>               Translation table in plain text format.\n");
+  printf("-o <string>               Output file with the binary table (<input>.mmap\n");
+  printf("                          by default, as expected by MmapPhraseModel).\n");
+  printf("-v                        Verbose mode.\n");
+  printf("--help                    Display this help and exit.\n\n");
+  printf("NOTE: joint counts are stored exactly if the table contains at most\n");
+  printf("%d distinct count values. Otherwise they are quantized to %d\n",MMAP_PHRASE_TABLE_MAX_CODES,MMAP_PHRASE_TABLE_MAX_CODES);
+  printf("quantiles, which is lossy.\n\n");
+}
+
+//--------------------------------
@@ -45,7 +45,9 @@ class BaseHypState
 {
   public:
 
-       // Note: Derived classes must define the "less" operator: operator<
+       // Note: Derived classes must define the "less" operator:
+       // operator<, the equality operator: operator==, and a hash
+       // function: size_t hash(void)const
       
        // Destructor
    virtual ~BaseHypState()=0;
@@ -35,7 +35,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #include "Score.h"
 #include "PositionIndex.h"
-#include "Bitset.h"
+#include "Coverage.h"
 #include "SmtDefs.h"
 #include <vector>
 
@@ -77,7 +77,7 @@ class BaseHypothesis
   virtual void subtractHeuristic(Score h)=0;
   virtual DATA_TYPE getData(void)const=0;
   virtual void setData(const DATA_TYPE& _data)=0;
-  virtual Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const=0;
+  virtual Coverage getKey(void)const=0;
       // Returns coverage vector for the hypothesis. This function is
       // required when using multiple stack translators with granularity
       
@@ -67,7 +67,7 @@ class BaseHypothesisRec: public BaseHypothesis<SCORE_INFO,DATA_TYPE,EQCLASS_FUNC
   virtual void subtractHeuristic(Score h)=0;
   virtual DATA_TYPE getData(void)const=0;
   virtual void setData(const DATA_TYPE& _data)=0;
-  virtual Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const=0;
+  virtual Coverage getKey(void)const=0;
       // Returns coverage vector for the hypothesis. This function is
       // required when using multiple stack translators with granularity
 
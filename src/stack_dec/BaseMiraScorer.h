@@ -67,6 +67,21 @@ class BaseMiraScorer: public BaseScorer
                          const std::string& reference,
                          double& score)=0;
 
+    // Functions to work with sufficient statistics. The statistics of
+    // a candidate are stored in getNumSuffStats() consecutive
+    // positions and the statistics of a corpus are obtained by adding
+    // those of its sentences. sentSuffStats() does not modify the
+    // scorer, so it can be called from different threads
+  virtual unsigned int getNumSuffStats(void)=0;
+  virtual void sentSuffStats(const std::string& candidate,
+                             const std::string& reference,
+                             double* stats)=0;
+  virtual void updateBackgroundCorpusFromSuffStats(const double* stats,
+                                                   double decay)=0;
+  virtual double sentBackgroundScoreFromSuffStats(const double* stats)=0;
+  virtual double sentScoreFromSuffStats(const double* stats)=0;
+  virtual double corpusScoreFromSuffStats(const double* stats)=0;
+
     // Destructor
   virtual ~BaseMiraScorer(){};
 };
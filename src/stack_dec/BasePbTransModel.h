@@ -39,6 +39,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "BasePbTransModelStats.h"
 #include "SmtDefs.h"
 #include "StrProcUtils.h"
+#include <limits.h>
 
 //--------------- Constants ------------------------------------------
 
@@ -164,7 +165,7 @@ void BasePbTransModel<HYPOTHESIS>::getPhraseAlignment(const std::vector<std::pai
     {
       unsigned int j=amatrix[i].second;
       while(temp.size()<=j)
-        temp.push_back(std::make_pair(MAX_SENTENCE_LENGTH_ALLOWED+1,0));
+        temp.push_back(std::make_pair(UINT_MAX,0));
       if(temp[j].first>amatrix[i].first)
         temp[j].first=amatrix[i].first;
       if(temp[j].second<amatrix[i].first)
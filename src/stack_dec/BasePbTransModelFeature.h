@@ -34,6 +34,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #endif /* HAVE_CONFIG_H */
 
 #include "PhrHypDataStr.h"
+#include "PhrHypData.h"
+#include "SingleWordVocab.h"
 #include "Score.h"
 #include <set>
 #include <string>
@@ -81,8 +83,29 @@ class BasePbTransModelFeature
                                       const PhrHypDataStr& newHypDataStr,
                                       float weight,
                                       Score& unweightedScore)=0;
+  virtual bool scoresExtensionsGivenIdx(void);
+      // Returns true if the feature redefines extensionScoreGivenIdx(),
+      // so that partial translations are not converted into strings
+  virtual HypScoreInfo extensionScoreGivenIdx(const std::vector<std::string>& srcSent,
+                                              const SingleWordVocab& trgVocab,
+                                              const HypScoreInfo& predHypScrInf,
+                                              const PhrHypData& predHypData,
+                                              const PhrHypData& newHypData,
+                                              float weight,
+                                              Score& unweightedScore);
+      // Same as extensionScore() but the partial translations are given
+      // as indices of trgVocab, the target vocabulary of the
+      // translation model
   virtual Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                           const std::vector<std::string>& trgPhrase)=0;
+  virtual bool isContextFree(void);
+      // Returns true if the unweighted score of an extension is the sum
+      // of scorePhrasePairUnweighted() for the new phrase pairs, so
+      // that it can be computed before the translation starts
+
+      // Function to clear temporary data kept by the feature for the
+      // sentence being translated
+  virtual void clearTempVars(void);
 
       // Functions to obtain translation options
   virtual void obtainTransOptions(const std::vector<std::string>& wordVec,
@@ -109,6 +132,13 @@ bool BasePbTransModelFeature<SCORE_INFO>::scoringIsProcessSafe(void)
   return true;
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool BasePbTransModelFeature<SCORE_INFO>::isContextFree(void)
+{
+  return false;
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 void BasePbTransModelFeature<SCORE_INFO>::setFeatName(std::string fname)
@@ -135,6 +165,46 @@ BasePbTransModelFeature<SCORE_INFO>::nullHypScore(const HypScoreInfo& predHypScr
   return hypScrInf;
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool BasePbTransModelFeature<SCORE_INFO>::scoresExtensionsGivenIdx(void)
+{
+  return false;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+typename BasePbTransModelFeature<SCORE_INFO>::HypScoreInfo
+BasePbTransModelFeature<SCORE_INFO>::extensionScoreGivenIdx(const std::vector<std::string>& srcSent,
+                                                            const SingleWordVocab& trgVocab,
+                                                            const HypScoreInfo& predHypScrInf,
+                                                            const PhrHypData& predHypData,
+                                                            const PhrHypData& newHypData,
+                                                            float weight,
+                                                            Score& unweightedScore)
+{
+      // Convert partial translations into strings
+  PhrHypDataStr predHypDataStr;
+  PhrHypDataStr newHypDataStr;
+  std::vector<WordIndex> ntarget=predHypData.getNtarget();
+  for(unsigned int i=0;i<ntarget.size();++i)
+    predHypDataStr.ntarget.push_back(trgVocab.wordIndexToTrgString(ntarget[i]));
+  predHypData.getPhraseAlign(predHypDataStr.sourceSegmentation,predHypDataStr.targetSegmentCuts);
+  ntarget=newHypData.getNtarget();
+  for(unsigned int i=0;i<ntarget.size();++i)
+    newHypDataStr.ntarget.push_back(trgVocab.wordIndexToTrgString(ntarget[i]));
+  newHypData.getPhraseAlign(newHypDataStr.sourceSegmentation,newHypDataStr.targetSegmentCuts);
+  
+  return extensionScore(srcSent,predHypScrInf,predHypDataStr,newHypDataStr,weight,unweightedScore);
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+void BasePbTransModelFeature<SCORE_INFO>::clearTempVars(void)
+{
+      // By default, features do not keep temporary data
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 void BasePbTransModelFeature<SCORE_INFO>::obtainTransOptions(const std::vector<std::string>& /*wordVec*/,
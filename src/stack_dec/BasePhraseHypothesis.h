@@ -66,7 +66,7 @@ class BasePhraseHypothesis: public BaseHypothesis<SCORE_INFO,DATA_TYPE,EQCLASS_F
                               std::vector<PositionIndex>& targetSegmentCuts)const=0;
   virtual void getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                                     std::vector<WordIndex>& trgPhr)const=0;
-  virtual Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const=0;
+  virtual Coverage getKey(void)const=0;
   virtual std::vector<WordIndex> getPartialTrans(void)const=0;
   virtual unsigned int partialTransLength(void)const=0;
 
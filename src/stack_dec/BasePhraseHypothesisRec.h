@@ -68,7 +68,7 @@ class BasePhraseHypothesisRec: public BaseHypothesisRec<SCORE_INFO,DATA_TYPE,EQC
                               std::vector<PositionIndex>& targetSegmentCuts)const=0;
   virtual void getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                                     std::vector<WordIndex>& trgPhr)const=0;
-  virtual Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const=0;
+  virtual Coverage getKey(void)const=0;
   virtual std::vector<WordIndex> getPartialTrans(void)const=0;
   virtual unsigned int partialTransLength(void)const=0;
 
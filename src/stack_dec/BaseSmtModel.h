@@ -37,8 +37,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "PositionIndex.h"
 #include "Score.h"
 #include "Count.h"
-#include "Bitset.h"
+#include "Coverage.h"
 #include "ErrorDefs.h"
+#include "ArenaAllocator.h"
 #include "OnlineTrainingPars.h"
 #include <iostream>
 #include <iomanip>
@@ -52,6 +53,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- typedefs -------------------------------------------
 
+    // Vector of score components of a hypothesis extension, models
+    // may store them in memory released after each sentence
+typedef std::vector<Score,ArenaAllocator<Score> > ScoreComps;
 
 //--------------- Classes --------------------------------------------
 
@@ -94,16 +98,22 @@ class BaseSmtModel
       // Expansion-related functions
   virtual void expand(const Hypothesis& hyp,
                       std::vector<Hypothesis>& hypVec,
-                      std::vector<std::vector<Score> >& scrCompVec)=0;
+                      std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_ref(const Hypothesis& hyp,
                           std::vector<Hypothesis>& hypVec,
-                          std::vector<std::vector<Score> >& scrCompVec)=0;
+                          std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_ver(const Hypothesis& hyp,
                           std::vector<Hypothesis>& hypVec,
-                          std::vector<std::vector<Score> >& scrCompVec)=0;
+                          std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_prefix(const Hypothesis& hyp,
                              std::vector<Hypothesis>& hypVec,
-                             std::vector<std::vector<Score> >& scrCompVec)=0;
+                             std::vector<ScoreComps>& scrCompVec)=0;
+  virtual void expandHyps(const std::vector<Hypothesis>& hypVec,
+                          std::vector<std::vector<Hypothesis> >& expHypVecs,
+                          std::vector<std::vector<ScoreComps> >& scrCompVecs);
+      // Expand a set of hypotheses. The result is the same as that
+      // obtained by calling expand() for each of them, but the
+      // expansions may be generated in parallel
       
       // Misc. operations with hypothesis
   virtual Hypothesis nullHypothesis(void)=0;
@@ -147,7 +157,7 @@ class BaseSmtModel
   virtual void diffScoreCompsForHyps(const Hypothesis& pred_hyp,
                                      const Hypothesis& succ_hyp,
                                      std::vector<Score>& scoreComponents)=0;
-  virtual void getUnweightedComps(const std::vector<Score>& scrComps,
+  virtual void getUnweightedComps(const ScoreComps& scrComps,
                                   std::vector<Score>& unweightedScrComps)=0;
 
       // Functions for performing on-line training
@@ -187,6 +197,18 @@ void BaseSmtModel<HYPOTHESIS>::getWeights(std::vector<std::pair<std::string,floa
   std::cerr<<"Warning: the functionality provided by getWeights() is not implemented in this class"<<std::endl;
 }
 
+//---------------------------------
+template<class HYPOTHESIS>
+void BaseSmtModel<HYPOTHESIS>::expandHyps(const std::vector<Hypothesis>& hypVec,
+                                          std::vector<std::vector<Hypothesis> >& expHypVecs,
+                                          std::vector<std::vector<ScoreComps> >& scrCompVecs)
+{
+  expHypVecs.resize(hypVec.size());
+  scrCompVecs.resize(hypVec.size());
+  for(unsigned int i=0;i<hypVec.size();++i)
+    expand(hypVec[i],expHypVecs[i],scrCompVecs[i]);
+}
+
 //---------------------------------
 template<class HYPOTHESIS>
 void BaseSmtModel<HYPOTHESIS>::addHeuristicToHyp(Hypothesis& /*hyp*/)
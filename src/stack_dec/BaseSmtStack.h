@@ -32,6 +32,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #  include <thot_config.h>
 #endif /* HAVE_CONFIG_H */
 
+#include <stddef.h>
+
 //--------------- Constants ------------------------------------------
 
 
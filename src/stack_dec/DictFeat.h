@@ -74,6 +74,7 @@ class DictFeat: public BasePbTransModelFeature<SCORE_INFO>
                               Score& unweightedScore);
   Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                   const std::vector<std::string>& trgPhrase);
+  bool isContextFree(void);
 
       // Functions to obtain translation options
   void obtainTransOptions(const std::vector<std::string>& wordVec,
@@ -210,6 +211,13 @@ std::string DictFeat<SCORE_INFO>::getFeatType(void)
   return "DictFeat";
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool DictFeat<SCORE_INFO>::isContextFree(void)
+{
+  return true;
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 Score DictFeat<SCORE_INFO>::scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
@@ -78,6 +78,7 @@ class DirectPhraseModelFeat: public BasePbTransModelFeature<SCORE_INFO>
                               Score& unweightedScore);
   Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                   const std::vector<std::string>& trgPhrase);
+  bool isContextFree(void);
 
       // Functions to obtain translation options
   void obtainTransOptions(const std::vector<std::string>& wordVec,
@@ -139,6 +140,13 @@ std::string DirectPhraseModelFeat<SCORE_INFO>::getFeatType(void)
   return "DirectPhraseModelFeat";
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool DirectPhraseModelFeat<SCORE_INFO>::isContextFree(void)
+{
+  return true;
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 Score DirectPhraseModelFeat<SCORE_INFO>::scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
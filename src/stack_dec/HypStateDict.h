@@ -34,13 +34,16 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #include "HypStateDictData.h"
 #include "ErrorDefs.h"
-#include <map>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 
 //--------------- Constants ------------------------------------------
 
+#define HYP_STATE_DICT_INIT_SLOTS 1024
+#define HYP_STATE_DICT_EMPTY_SLOT -1
 
 //--------------- Classes --------------------------------------------
 
@@ -48,7 +51,10 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 /**
  * @brief The HypStateDict class implements a dictionary of states for
- * being used in stack decoding.
+ * being used in stack decoding. Entries are stored in a vector in the
+ * order in which they are created, so the position of an entry is its
+ * state index. States are found by means of an open-addressing hash
+ * table (linear probing) that stores positions of the vector.
  */
 
 template<class HYPOTHESIS_REC> 
@@ -57,7 +63,7 @@ class HypStateDict
  public:
 
   typedef typename HYPOTHESIS_REC::HypState HypState;
-  typedef std::map<HypState,HypStateDictData > HypStateDictDataMap;
+  typedef std::pair<HypState,HypStateDictData> HypStateDictEntry;
 
       // iterator
   class iterator;
@@ -66,25 +72,24 @@ class HypStateDict
   {
    protected:
     HypStateDict<HYPOTHESIS_REC>* hypstatedictPtr;
-    typename HypStateDictDataMap::iterator hsddIter;
+    size_t entryIdx;
    public:
-    iterator(void){hypstatedictPtr=NULL;}
+    iterator(void){hypstatedictPtr=NULL; entryIdx=0;}
     iterator(HypStateDict<HYPOTHESIS_REC>* hypstatedict,
-             typename HypStateDictDataMap::iterator iter):hypstatedictPtr(hypstatedict)
+             size_t idx):hypstatedictPtr(hypstatedict)
       {
-        hsddIter=iter;
+        entryIdx=idx;
       }  
     bool operator++(void); //prefix
     bool operator++(int);  //postfix
     int operator==(const iterator& right); 
     int operator!=(const iterator& right); 
-    typename HypStateDictDataMap::iterator&
-      operator->(void);
-    std::pair<HypState,HypStateDictData >
-      operator*(void)const;
+    HypStateDictEntry* operator->(void);
+    HypStateDictEntry operator*(void)const;
   };
  
-      // HypStateDict iterator-related functions
+      // HypStateDict iterator-related functions. Entries are traversed
+      // by increasing state index
   iterator begin(void);
   iterator end(void);
 
@@ -93,6 +98,8 @@ class HypStateDict
 
       // Basic functions
   iterator createDictEntry(const HYPOTHESIS_REC& hyp);
+  iterator createDictEntry(const HYPOTHESIS_REC& hyp,
+                           const HypState& hypState);
   iterator find(const HypState& hypstate);
 
       // size() function
@@ -102,7 +109,13 @@ class HypStateDict
 
  protected:
 
-  HypStateDictDataMap hypStateDictDataMap;
+  std::vector<HypStateDictEntry> entryVec;
+  std::vector<size_t> entryHashVec;
+  std::vector<int> slotVec;
+
+  size_t findSlot(const HypState& hypstate,
+                  size_t hashValue)const;
+  void rehash(size_t numSlots);
 };
 
 //--------------- HypStateDict template class function definitions
@@ -110,6 +123,7 @@ class HypStateDict
 template<class HYPOTHESIS_REC> 
 HypStateDict<HYPOTHESIS_REC>::HypStateDict(void)
 {
+  slotVec.resize(HYP_STATE_DICT_INIT_SLOTS,HYP_STATE_DICT_EMPTY_SLOT);
 }
 
 //---------------------------------------
@@ -117,30 +131,46 @@ template<class HYPOTHESIS_REC>
 typename HypStateDict<HYPOTHESIS_REC>::iterator
 HypStateDict<HYPOTHESIS_REC>::createDictEntry(const HYPOTHESIS_REC& hyp)
 {
-  HypState hypState=hyp.getHypState();
-    
-  typename HypStateDictDataMap::iterator hsddIter=hypStateDictDataMap.find(hypState);
-  if(hsddIter==hypStateDictDataMap.end())
+  return createDictEntry(hyp,hyp.getHypState());
+}
+
+//---------------------------------------
+template<class HYPOTHESIS_REC>
+typename HypStateDict<HYPOTHESIS_REC>::iterator
+HypStateDict<HYPOTHESIS_REC>::createDictEntry(const HYPOTHESIS_REC& hyp,
+                                              const HypState& hypState)
+{
+  size_t hashValue=hypState.hash();
+  size_t slot=findSlot(hypState,hashValue);
+  int entryIdx=slotVec[slot];
+  
+  if(entryIdx==HYP_STATE_DICT_EMPTY_SLOT)
   {
         // HypState not present in the dictionary, create index and set
         // score
     HypStateDictData hypStateDictData;
-    hypStateDictData.hypStateIndex=hypStateDictDataMap.size();
+    hypStateDictData.hypStateIndex=entryVec.size();
     hypStateDictData.coverage=hyp.getKey();
     hypStateDictData.score=hyp.getScore();
-    
-    hsddIter=hypStateDictDataMap.insert(std::make_pair(hypState,hypStateDictData)).first;
+
+    entryIdx=entryVec.size();
+    entryVec.push_back(std::make_pair(hypState,hypStateDictData));
+    entryHashVec.push_back(hashValue);
+    slotVec[slot]=entryIdx;
+
+        // Keep load factor of the hash table below 0.5
+    if(2*entryVec.size()>slotVec.size())
+      rehash(2*slotVec.size());
   }
   else
   {
         // Hypstate present in the dictionary, update score
-    hsddIter->second.score=hyp.getScore();
+    entryVec[entryIdx].second.score=hyp.getScore();
   }
 
       // Return iterator
-  typename HypStateDict<HYPOTHESIS_REC>::iterator ret(this,hsddIter);
+  typename HypStateDict<HYPOTHESIS_REC>::iterator ret(this,entryIdx);
   return ret;
-
 }
 
 //---------------------------------------
@@ -148,32 +178,73 @@ template<class HYPOTHESIS_REC>
 typename HypStateDict<HYPOTHESIS_REC>::iterator
 HypStateDict<HYPOTHESIS_REC>::find(const HypState& hypstate)
 {
-  typename HypStateDictDataMap::iterator hsddIter;
-  
-  hsddIter=hypStateDictDataMap.find(hypstate);
-  typename HypStateDict<HYPOTHESIS_REC>::iterator ret(this,hsddIter);
-  return ret;
+  int entryIdx=slotVec[findSlot(hypstate,hypstate.hash())];
+  if(entryIdx==HYP_STATE_DICT_EMPTY_SLOT)
+    return end();
+  else
+  {
+    typename HypStateDict<HYPOTHESIS_REC>::iterator ret(this,entryIdx);
+    return ret;
+  }
 }
 
 //---------------------------------------
 template<class HYPOTHESIS_REC> 
 size_t HypStateDict<HYPOTHESIS_REC>::size(void)
 {
-  return hypStateDictDataMap.size();  
+  return entryVec.size();
 }
 
 //---------------------------------------
 template<class HYPOTHESIS_REC> 
 void HypStateDict<HYPOTHESIS_REC>::clear(void)
 {
-  hypStateDictDataMap.clear();
+      // The hash table keeps its size, so the memory allocated for a
+      // sentence is reused for the next one
+  entryVec.clear();
+  entryHashVec.clear();
+  std::fill(slotVec.begin(),slotVec.end(),HYP_STATE_DICT_EMPTY_SLOT);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS_REC> 
+size_t HypStateDict<HYPOTHESIS_REC>::findSlot(const HypState& hypstate,
+                                              size_t hashValue)const
+{
+      // Return the slot storing hypstate or the empty slot where it
+      // should be inserted (the number of slots is a power of two)
+  size_t mask=slotVec.size()-1;
+  size_t slot=hashValue&mask;
+  while(slotVec[slot]!=HYP_STATE_DICT_EMPTY_SLOT)
+  {
+    int entryIdx=slotVec[slot];
+    if(entryHashVec[entryIdx]==hashValue && entryVec[entryIdx].first==hypstate)
+      return slot;
+    slot=(slot+1)&mask;
+  }
+  return slot;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS_REC> 
+void HypStateDict<HYPOTHESIS_REC>::rehash(size_t numSlots)
+{
+  slotVec.assign(numSlots,HYP_STATE_DICT_EMPTY_SLOT);
+  size_t mask=numSlots-1;
+  for(size_t i=0;i<entryHashVec.size();++i)
+  {
+    size_t slot=entryHashVec[i]&mask;
+    while(slotVec[slot]!=HYP_STATE_DICT_EMPTY_SLOT)
+      slot=(slot+1)&mask;
+    slotVec[slot]=i;
+  }
 }
 
 //--------------------------
 template<class HYPOTHESIS_REC>
 typename HypStateDict<HYPOTHESIS_REC>::iterator HypStateDict<HYPOTHESIS_REC>::begin(void)
 {
- typename HypStateDict<HYPOTHESIS_REC>::iterator iter(this,hypStateDictDataMap.begin());
+ typename HypStateDict<HYPOTHESIS_REC>::iterator iter(this,0);
 	
  return iter;
 }
@@ -181,7 +252,7 @@ typename HypStateDict<HYPOTHESIS_REC>::iterator HypStateDict<HYPOTHESIS_REC>::be
 template<class HYPOTHESIS_REC>
 typename HypStateDict<HYPOTHESIS_REC>::iterator HypStateDict<HYPOTHESIS_REC>::end(void)
 {
- typename HypStateDict<HYPOTHESIS_REC>::iterator iter(this,hypStateDictDataMap.end());
+ typename HypStateDict<HYPOTHESIS_REC>::iterator iter(this,entryVec.size());
 	
  return iter;
 }
@@ -193,8 +264,8 @@ bool HypStateDict<HYPOTHESIS_REC>::iterator::operator++(void) //prefix
 {
  if(hypstatedictPtr!=NULL)
  {
-  ++hsddIter;
-  if(hsddIter==hypstatedictPtr->hypStateDictDataMap.end()) return false;
+  ++entryIdx;
+  if(entryIdx>=hypstatedictPtr->entryVec.size()) return false;
   else return true;	 
  }
  else return false;
@@ -209,7 +280,7 @@ bool HypStateDict<HYPOTHESIS_REC>::iterator::operator++(int)  //postfix
 template<class HYPOTHESIS_REC>
 int HypStateDict<HYPOTHESIS_REC>::iterator::operator==(const iterator& right)
 {
- return (hypstatedictPtr==right.hypstatedictPtr && hsddIter==right.hsddIter);	
+ return (hypstatedictPtr==right.hypstatedictPtr && entryIdx==right.entryIdx);	
 }
 //--------------------------
 template<class HYPOTHESIS_REC>
@@ -219,18 +290,18 @@ int HypStateDict<HYPOTHESIS_REC>::iterator::operator!=(const iterator& right)
 }
 //--------------------------
 template<class HYPOTHESIS_REC>
-typename HypStateDict<HYPOTHESIS_REC>::HypStateDictDataMap::iterator&
+typename HypStateDict<HYPOTHESIS_REC>::HypStateDictEntry*
 HypStateDict<HYPOTHESIS_REC>::iterator::operator->(void)
 {
-  return hsddIter;
+  return &hypstatedictPtr->entryVec[entryIdx];
 }
 
 //--------------------------
 template<class HYPOTHESIS_REC>
-std::pair<typename HypStateDict<HYPOTHESIS_REC>::HypState,HypStateDictData >
+typename HypStateDict<HYPOTHESIS_REC>::HypStateDictEntry
 HypStateDict<HYPOTHESIS_REC>::iterator::operator*(void)const
 {
-   return *hsddIter;
+   return hypstatedictPtr->entryVec[entryIdx];
 }
 
 #endif
@@ -28,7 +28,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "SmtDefs.h"
 #include "HypStateIndex.h"
 #include "Score.h"
-#include "Bitset.h"
+#include "Coverage.h"
 
 //--------------- Classes --------------------------------------------
 
@@ -37,7 +37,7 @@ class HypStateDictData
   public:
 
    HypStateIndex hypStateIndex;
-   Bitset<MAX_SENTENCE_LENGTH_ALLOWED> coverage;	
+   Coverage coverage;	
    Score score;
 };
 
@@ -25,6 +25,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include "KbMiraLlWu.h"
+#include <unistd.h>
 
 //--------------- KbMiraLlWu class functions
 
@@ -33,13 +34,21 @@ KbMiraLlWu::KbMiraLlWu(double C,
                        double gamma,
                        unsigned int J,
                        unsigned int epochs_to_restart,
-                       unsigned int max_restarts)
+                       unsigned int max_restarts,
+                       unsigned int num_threads)
 {
   c = C;
   decay = gamma;
   nIters = J;
   epochsToRestart = epochs_to_restart;
   maxRestarts = max_restarts;
+
+  // use one thread per online processor if not given
+  if (num_threads == 0) {
+    long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
+    num_threads = (nprocs > 0) ? nprocs : 1;
+  }
+  workerPool.setNumThreads(num_threads);
 }
 
 //---------------------------------------
@@ -68,6 +77,10 @@ void KbMiraLlWu::update(const std::string& reference,
 
   assert (nblist.size() == scoreCompsVec.size());
 
+  // sufficient statistics are computed once for all epochs
+  NbestSuffStats nbSuffStats;
+  computeSuffStats(reference, nblist, scoreCompsVec, nbSuffStats);
+
   std::vector<double> max_wAvg;
   double quality, max_quality = 0;
 
@@ -80,40 +93,16 @@ void KbMiraLlWu::update(const std::string& reference,
 
     for(unsigned int j=0; j<nIters; j++) {
       HopeFearData hfd;
-      HopeFear(reference, nblist, scoreCompsVec, wt, &hfd);
-      if (hfd.hopeQuality  > hfd.fearQuality) {
-        std::vector<double> diff(hfd.hopeFeatures.size());
-        for (unsigned int k=0; k<diff.size(); k++)
-          diff[k] = hfd.hopeFeatures[k] - hfd.fearFeatures[k];
-        double delta = hfd.hopeQuality - hfd.fearQuality;
-        double diffScore = 0;
-        for (unsigned int k=0; k<diff.size(); k++)
-          diffScore += wt[k]*diff[k];
-        double loss = delta - diffScore;
-
-        if (loss > 0) {
-          // Update weights
-          double diffNorm = 0;
-          for (unsigned int k=0; k<diff.size(); k++)
-            diffNorm += diff[k]*diff[k];
-          double eta = std::min(c, loss/diffNorm);
-          for (unsigned int k=0; k<diff.size(); k++) {
-            wt[k] += eta*diff[k];
-            wTotals[k] += wt[k];
-          }
-          nUpdates++;
-        }
-        scorer->updateBackgroundCorpus(hfd.hopeQualityStats, decay);
-      }
+      HopeFear(nbSuffStats, wt, &hfd);
+      updateWeights(nbSuffStats, hfd, wt, wTotals, nUpdates);
+
       // average all seen weight vectors
       std::vector<double> wAvg(wTotals.size(), 0);
       for (unsigned int k=0; k<wAvg.size(); k++)
         wAvg[k] = wTotals[k]/nUpdates;
 
       // evaluate bleu of wAvg
-      std::string maxTranslation;
-      MaxTranslation(wAvg, nblist, scoreCompsVec, maxTranslation);
-      scorer->sentScore(maxTranslation, reference, quality);
+      quality = scorer->sentScoreFromSuffStats(MaxTranslation(wAvg, nbSuffStats));
       if (quality > iter_max_quality) {
         iter_max_j = j;
         iter_max_quality = quality;
@@ -145,23 +134,11 @@ void KbMiraLlWu::updateClosedCorpus(const std::vector<std::string>& references,
   assert(nblists.size() == nSents);
   assert(scoreCompsVecs.size() == nSents);
 
-  // //##########################################################################
-  // // evaluate bleu of currWeightsVec
-  // std::cerr << "CW: [ ";
-  // for (unsigned int k=0; k<currWeightsVec.size(); k++)
-  //   std::cerr << currWeightsVec[k] << " ";
-  // std::cerr << "]" << std::endl;
-  // std::string mT;
-  // std::vector<std::string> mTs;
-  // for (unsigned int i=0; i<nSents; i++) {
-  //   MaxTranslation(currWeightsVec, nblists[i], scoreCompsVecs[i], mT);
-  //   mTs.push_back(mT);
-  //   //std::cerr << i << " " << mT << std::endl;
-  // }
-  // double bleu;
-  // scorer->corpusScore(mTs, references, bleu);
-  // std::cerr << bleu << std::endl;
-  // //##########################################################################
+  // sufficient statistics are computed once for all epochs and
+  // restarts
+  std::vector<NbestSuffStats> nbSuffStatsVec;
+  computeSuffStatsClosedCorpus(references, nblists, scoreCompsVecs, nbSuffStatsVec);
+  unsigned int numStats = scorer->getNumSuffStats();
 
   std::vector<double> max_wAvg;
   double quality, max_quality = 0;
@@ -178,40 +155,12 @@ void KbMiraLlWu::updateClosedCorpus(const std::vector<std::string>& references,
       sampleWoReplacement(nSents, indices);
       for (unsigned int z=0; z<nSents; z++) {
         unsigned int i = indices[z];
-        assert (nblists[i].size() == scoreCompsVecs[i].size());
         HopeFearData hfd;
-        HopeFear(references[i], nblists[i], scoreCompsVecs[i], wt, &hfd);
+        HopeFear(nbSuffStatsVec[i], wt, &hfd);
 
         // std::cerr << i << " " << hfd.hopeQuality << " " << hfd.fearQuality << std::endl;
 
-        if (hfd.hopeQuality > hfd.fearQuality) {
-          std::vector<double> diff(hfd.hopeFeatures.size());
-          for (unsigned int k=0; k<diff.size(); k++)
-            diff[k] = hfd.hopeFeatures[k] - hfd.fearFeatures[k];
-          double delta = hfd.hopeQuality - hfd.fearQuality;
-          double diffScore = 0;
-          for (unsigned int k=0; k<diff.size(); k++)
-            diffScore += wt[k]*diff[k];
-          double loss = delta - diffScore;
-          
-          // std::cerr << " - " << loss << std::endl;
-
-          if (loss > 0) {
-            // Update weights
-            double diffNorm = 0;
-            for (unsigned int k=0; k<diff.size(); k++)
-              diffNorm += diff[k]*diff[k];
-            double eta = std::min(c, loss/diffNorm);
-            for (unsigned int k=0; k<diff.size(); k++) {
-              //std::cerr << "WU: " << k << " : " << wt[k];
-              wt[k] += eta*diff[k];
-              //std::cerr << " ( " << eta << " " << diff[k] << " ) " << wt[k] << std::endl;
-              wTotals[k] += wt[k];
-            }
-            nUpdates++;
-          }
-          scorer->updateBackgroundCorpus(hfd.hopeQualityStats, decay);
-        }
+        updateWeights(nbSuffStatsVec[i], hfd, wt, wTotals, nUpdates);
       }
 
       // average all seen weight vectors
@@ -225,13 +174,13 @@ void KbMiraLlWu::updateClosedCorpus(const std::vector<std::string>& references,
       // std::cerr << "]" << std::endl;
 
       // evaluate score of wAvg
-      std::string maxTranslation;
-      std::vector<std::string> maxTranslations;
+      std::vector<double> corpusStats(numStats, 0);
       for (unsigned int i=0; i<nSents; i++) {
-        MaxTranslation(wAvg, nblists[i], scoreCompsVecs[i], maxTranslation);
-        maxTranslations.push_back(maxTranslation);
+        const double* maxStats = MaxTranslation(wAvg, nbSuffStatsVec[i]);
+        for (unsigned int k=0; k<numStats; k++)
+          corpusStats[k] += maxStats[k];
       }
-      scorer->corpusScore(maxTranslations, references, quality);
+      quality = scorer->corpusScoreFromSuffStats(&corpusStats[0]);
       if (quality > iter_max_quality) {
         iter_max_j = j;
         iter_max_quality = quality;
@@ -242,7 +191,6 @@ void KbMiraLlWu::updateClosedCorpus(const std::vector<std::string>& references,
       }
 
       //std::cerr << nReStarts << " " << j << " " << iter_max_j << " " << quality << " " << max_quality << std::endl;
-      //exit(0);
       // restart weights if no improvement in X epochs;
       if (j-iter_max_j > epochsToRestart)
         break;
@@ -252,28 +200,94 @@ void KbMiraLlWu::updateClosedCorpus(const std::vector<std::string>& references,
 }
 
 //---------------------------------------
-void KbMiraLlWu::MaxTranslation(const std::vector<double>& wv,
-                                const std::vector<std::string>& nBest,
-                                const std::vector<std::vector<double> >& nScores,
-                                std::string& maxTranslation)
+void KbMiraLlWu::computeSuffStats(const std::string& reference,
+                                  const std::vector<std::string>& nBest,
+                                  const std::vector<std::vector<double> >& nScores,
+                                  NbestSuffStats& nbSuffStats)
+{
+  assert (nBest.size() == nScores.size());
+
+  nbSuffStats.numEntries = nBest.size();
+  nbSuffStats.numFeats = nScores.empty() ? 0 : nScores[0].size();
+  nbSuffStats.numStats = scorer->getNumSuffStats();
+
+  // store feature vectors
+  nbSuffStats.features.resize(nbSuffStats.numEntries*nbSuffStats.numFeats);
+  for (unsigned int n=0; n<nbSuffStats.numEntries; n++) {
+    assert (nScores[n].size() == nbSuffStats.numFeats);
+    std::copy(nScores[n].begin(), nScores[n].end(),
+              nbSuffStats.features.begin()+n*nbSuffStats.numFeats);
+  }
+
+  // compute statistics
+  nbSuffStats.stats.resize(nbSuffStats.numEntries*nbSuffStats.numStats);
+  for (unsigned int n=0; n<nbSuffStats.numEntries; n++)
+    scorer->sentSuffStats(nBest[n], reference, &nbSuffStats.stats[n*nbSuffStats.numStats]);
+  nbSuffStats.emptyStats.resize(nbSuffStats.numStats);
+  scorer->sentSuffStats("", reference, &nbSuffStats.emptyStats[0]);
+}
+
+//---------------------------------------
+struct SuffStatsTaskData {
+  KbMiraLlWu* kbMiraLlWuPtr;
+  const std::vector<std::string>* referencesPtr;
+  const std::vector<std::vector<std::string> >* nblistsPtr;
+  const std::vector<std::vector<std::vector<double> > >* scoreCompsVecsPtr;
+  std::vector<NbestSuffStats>* nbSuffStatsVecPtr;
+};
+
+//---------------------------------------
+void KbMiraLlWu::computeSuffStatsClosedCorpus(const std::vector<std::string>& references,
+                                              const std::vector<std::vector<std::string> >& nblists,
+                                              const std::vector<std::vector<std::vector<double> > >& scoreCompsVecs,
+                                              std::vector<NbestSuffStats>& nbSuffStatsVec)
+{
+  // each sentence is processed by a different task
+  nbSuffStatsVec.clear();
+  nbSuffStatsVec.resize(references.size());
+
+  SuffStatsTaskData taskData;
+  taskData.kbMiraLlWuPtr = this;
+  taskData.referencesPtr = &references;
+  taskData.nblistsPtr = &nblists;
+  taskData.scoreCompsVecsPtr = &scoreCompsVecs;
+  taskData.nbSuffStatsVecPtr = &nbSuffStatsVec;
+  workerPool.run(references.size(), suffStatsTask, &taskData);
+}
+
+//---------------------------------------
+void KbMiraLlWu::suffStatsTask(void* data,
+                               unsigned int taskIdx,
+                               unsigned int /*workerIdx*/)
+{
+  SuffStatsTaskData* taskDataPtr = (SuffStatsTaskData*) data;
+  taskDataPtr->kbMiraLlWuPtr->computeSuffStats((*taskDataPtr->referencesPtr)[taskIdx],
+                                               (*taskDataPtr->nblistsPtr)[taskIdx],
+                                               (*taskDataPtr->scoreCompsVecsPtr)[taskIdx],
+                                               (*taskDataPtr->nbSuffStatsVecPtr)[taskIdx]);
+}
+
+//---------------------------------------
+const double* KbMiraLlWu::MaxTranslation(const std::vector<double>& wv,
+                                         const NbestSuffStats& nbSuffStats)
 {
+  const double* maxStats = &nbSuffStats.emptyStats[0];
   double max_score=-DBL_MAX;
-  for (unsigned int n=0; n<nBest.size(); n++) {
+  for (unsigned int n=0; n<nbSuffStats.numEntries; n++) {
+    const double* features = &nbSuffStats.features[n*nbSuffStats.numFeats];
     double score = 0;
     for (unsigned int k=0; k<wv.size(); k++)
-      score += wv[k]*nScores[n][k];
-    //cout << " * " << score << " " << nBest[n] << std::endl;
+      score += wv[k]*features[k];
     if (score > max_score) {
         max_score = score;
-        maxTranslation = nBest[n];
+        maxStats = &nbSuffStats.stats[n*nbSuffStats.numStats];
     }
   }
+  return maxStats;
 }
 
 //---------------------------------------
-void KbMiraLlWu::HopeFear(const std::string& reference,
-                          const std::vector<std::string>& nBest,
-                          const std::vector<std::vector<double> >& nScores,
+void KbMiraLlWu::HopeFear(const NbestSuffStats& nbSuffStats,
                           const std::vector<double>& wv,
                           HopeFearData* hopeFear)
 {
@@ -282,49 +296,72 @@ void KbMiraLlWu::HopeFear(const std::string& reference,
   double hope_total_score=-DBL_MAX;
   double fear_total_score=-DBL_MAX;
 
-  //std::cerr << "R: " << reference << std::endl;
+  // no update is done for empty n-best lists
+  hopeFear->hopeIdx = hopeFear->fearIdx = 0;
+  hopeFear->hopeScore = hopeFear->hopeQuality = 0;
+  hopeFear->fearScore = hopeFear->fearQuality = 0;
 
-  for (unsigned int n=0; n<nBest.size(); n++) {
+  for (unsigned int n=0; n<nbSuffStats.numEntries; n++) {
+    const double* features = &nbSuffStats.features[n*nbSuffStats.numFeats];
     double score = 0;
     for (unsigned int k=0; k<wv.size(); k++)
-      score += wv[k]*nScores[n][k];
-    double quality;
-    std::vector<unsigned int> qStats;
-    scorer->sentBackgroundScore(nBest[n], reference, quality, qStats);
-
-    // std::cerr << nBest[n] << std::endl;
-    // std::cerr << reference << std::endl;
-    // std::cerr << quality << " : [ ";
-    // for (unsigned int k=0; k<qStats.size(); k++)
-    //   std::cerr << qStats[k] << " ";
-    // std::cerr << "] " << score << " " << quality;
-    // std::cerr << " ( " << hope_scale*score + quality << " , " << hope_total_score;
-    // std::cerr << " , " << score-quality << " " << fear_total_score << " )" << std::endl;
+      score += wv[k]*features[k];
+    double quality = scorer->sentBackgroundScoreFromSuffStats(&nbSuffStats.stats[n*nbSuffStats.numStats]);
 
     // Hope
     if ((hope_scale*score + quality) > hope_total_score) {
       hope_total_score = hope_scale*score + quality;
-      // std::cerr << "Hope: " << n << " : " << nBest[n] << score << " " << quality << " " << hope_total_score << std::endl;
+      hopeFear->hopeIdx = n;
       hopeFear->hopeScore = score;
-      hopeFear->hopeFeatures.clear();
-      for (unsigned int k=0; k<nScores[n].size(); k++)
-        hopeFear->hopeFeatures.push_back(nScores[n][k]);
       hopeFear->hopeQuality = quality;
-      hopeFear->hopeQualityStats = qStats;
     }
     // Fear
     if ((score - quality) > fear_total_score) {
       fear_total_score = score - quality;
-      // std::cerr << "Fear: " << n << " : " << nBest[n] << score << " " << quality << " " << fear_total_score << std::endl;
+      hopeFear->fearIdx = n;
       hopeFear->fearScore = score;
-      hopeFear->fearFeatures.clear();
-      for (unsigned int k=0; k<nScores[n].size(); k++)
-        hopeFear->fearFeatures.push_back(nScores[n][k]);
       hopeFear->fearQuality = quality;
     }
   }
 }
 
+//---------------------------------------
+void KbMiraLlWu::updateWeights(const NbestSuffStats& nbSuffStats,
+                               const HopeFearData& hfd,
+                               std::vector<double>& wt,
+                               std::vector<double>& wTotals,
+                               unsigned int& nUpdates)
+{
+  if (hfd.hopeQuality > hfd.fearQuality) {
+    const double* hopeFeatures = &nbSuffStats.features[hfd.hopeIdx*nbSuffStats.numFeats];
+    const double* fearFeatures = &nbSuffStats.features[hfd.fearIdx*nbSuffStats.numFeats];
+    std::vector<double> diff(nbSuffStats.numFeats);
+    for (unsigned int k=0; k<diff.size(); k++)
+      diff[k] = hopeFeatures[k] - fearFeatures[k];
+    double delta = hfd.hopeQuality - hfd.fearQuality;
+    double diffScore = 0;
+    for (unsigned int k=0; k<diff.size(); k++)
+      diffScore += wt[k]*diff[k];
+    double loss = delta - diffScore;
+
+    // std::cerr << " - " << loss << std::endl;
+
+    if (loss > 0) {
+      // Update weights
+      double diffNorm = 0;
+      for (unsigned int k=0; k<diff.size(); k++)
+        diffNorm += diff[k]*diff[k];
+      double eta = std::min(c, loss/diffNorm);
+      for (unsigned int k=0; k<diff.size(); k++) {
+        wt[k] += eta*diff[k];
+        wTotals[k] += wt[k];
+      }
+      nUpdates++;
+    }
+    scorer->updateBackgroundCorpusFromSuffStats(&nbSuffStats.stats[hfd.hopeIdx*nbSuffStats.numStats], decay);
+  }
+}
+
 //---------------------------------------
 void KbMiraLlWu::sampleWoReplacement(unsigned int nSamples,
                                      std::vector<unsigned int>& indices)
@@ -35,6 +35,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "BaseLogLinWeightUpdater.h"
 //#include "MiraBleu.h"
 #include "BaseMiraScorer.h"
+#include "WorkerThreadPool.h"
 
 #include <cstdlib>
 #include <cassert>
@@ -49,12 +50,23 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- typedefs -------------------------------------------
 struct HopeFearData {
-  std::vector<double> hopeFeatures, fearFeatures;
-  std::vector<unsigned int> hopeQualityStats;
+  unsigned int hopeIdx, fearIdx;  // positions in the n-best list
   double hopeScore, hopeQuality;
   double fearScore, fearQuality;
 };
 
+// Feature vectors and scorer sufficient statistics of the entries of
+// an n-best list, stored in dense arrays (entry n occupies positions
+// [n*numFeats,(n+1)*numFeats) of features and [n*numStats,
+// (n+1)*numStats) of stats). emptyStats contains the statistics of
+// the empty translation, which are used if the n-best list is empty
+struct NbestSuffStats {
+  unsigned int numEntries, numFeats, numStats;
+  std::vector<double> features;
+  std::vector<double> stats;
+  std::vector<double> emptyStats;
+};
+
 //--------------- Classes --------------------------------------------
 
 //--------------- KbMiraLlWu class
@@ -70,7 +82,8 @@ class KbMiraLlWu: public BaseLogLinWeightUpdater
              double gamma = 0.999,
              unsigned int J = 60,
              unsigned int epochs_to_restart = 20,
-             unsigned int max_restarts = 1);
+             unsigned int max_restarts = 1,
+             unsigned int num_threads = 0);
   ~KbMiraLlWu();
 
       // Function to link scorer
@@ -96,20 +109,39 @@ class KbMiraLlWu: public BaseLogLinWeightUpdater
   unsigned int epochsToRestart; // epochs without improvement before re-start
   unsigned int maxRestarts;     // max number of re-starts
   BaseMiraScorer *scorer;
-
-     // Compute max scoring translaiton according to w
-  void MaxTranslation(const std::vector<double>& w,
-                      const std::vector<std::string>& nBest,
-                      const std::vector<std::vector<double> >& nScores,
-                      std::string &maxTranslation);
+  WorkerThreadPool workerPool;  // threads computing sufficient statistics
+
+     // Compute the sufficient statistics of the n-best lists (in
+     // parallel for closed corpora)
+  void computeSuffStats(const std::string& reference,
+                        const std::vector<std::string>& nBest,
+                        const std::vector<std::vector<double> >& nScores,
+                        NbestSuffStats& nbSuffStats);
+  void computeSuffStatsClosedCorpus(const std::vector<std::string>& references,
+                                    const std::vector<std::vector<std::string> >& nblists,
+                                    const std::vector<std::vector<std::vector<double> > >& scoreCompsVecs,
+                                    std::vector<NbestSuffStats>& nbSuffStatsVec);
+  static void suffStatsTask(void* data,
+                            unsigned int taskIdx,
+                            unsigned int workerIdx);
+
+     // Compute max scoring translation according to w, its
+     // sufficient statistics are returned
+  const double* MaxTranslation(const std::vector<double>& w,
+                               const NbestSuffStats& nbSuffStats);
 
      // Compute hope/fear translations and stores info in hopeFear
-  void HopeFear(const std::string& reference,
-                const std::vector<std::string>& nBest,
-                const std::vector<std::vector<double> >& nScores,
+  void HopeFear(const NbestSuffStats& nbSuffStats,
                 const std::vector<double>& wv,
                 HopeFearData* hopeFear);
 
+     // Update weights given the hope and fear translations
+  void updateWeights(const NbestSuffStats& nbSuffStats,
+                     const HopeFearData& hfd,
+                     std::vector<double>& wt,
+                     std::vector<double>& wTotals,
+                     unsigned int& nUpdates);
+
    //get permutation indices
   void sampleWoReplacement(unsigned int nSamples,
                            std::vector<unsigned int>& indices);
@@ -31,7 +31,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Constants ------------------------------------------
 
 // Set the LM_State type used to represent the word history of an n-gram
-// language model.
+// language model. The content of a state is only interpreted by the
+// language model that created it, the decoder just copies, compares
+// and hashes states.
 
 #define LM_STATE_TYPE_NAME "std::vector<WordIndex>"
 #define LM_STATE_DESC      ""
@@ -28,6 +28,23 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- LangModelFeat class functions
 
+template<>
+LM_State&
+LangModelFeat<PhrScoreInfo>::lmStateOfHypScoreInfo(HypScoreInfo& hypScrInf)
+{
+      // The state of the first language model feature is stored in
+      // lmHist, the rest are stored in extraLmHistVec
+  if(lmStateIdx==0)
+    return hypScrInf.lmHist;
+  else
+  {
+    if(hypScrInf.extraLmHistVec.size()<lmStateIdx)
+      hypScrInf.extraLmHistVec.resize(lmStateIdx);
+    return hypScrInf.extraLmHistVec[lmStateIdx-1];
+  }
+}
+
+//---------------
 template<>
 LangModelFeat<PhrScoreInfo>::HypScoreInfo
 LangModelFeat<PhrScoreInfo>::nullHypScore(const HypScoreInfo& predHypScrInf,
@@ -38,7 +55,7 @@ LangModelFeat<PhrScoreInfo>::nullHypScore(const HypScoreInfo& predHypScrInf,
 
       // Obtain language model state for null hypothesis
   HypScoreInfo hypScrInf=predHypScrInf;
-  lModelPtr->getStateForBeginOfSentence(hypScrInf.lmHist);
+  lModelPtr->getStateForBeginOfSentence(lmStateOfHypScoreInfo(hypScrInf));
   
   return hypScrInf;
 }
@@ -57,15 +74,10 @@ LangModelFeat<PhrScoreInfo>::extensionScore(const std::vector<std::string>& srcS
   HypScoreInfo hypScrInf=predHypScrInf;
   unweightedScore=0;
 
-      // Obtain current partial translation
-  std::vector<std::string> currPartialTrans;
-  obtainCurrPartialTrans(predHypDataStr,currPartialTrans);
-
-      // Initialize state
-  LM_State state;
-  lModelPtr->getStateForBeginOfSentence(state);
-  addWordSeqToStateStr(currPartialTrans,state);
-  
+      // Initialize state from the one of the predecessor hypothesis
+  LM_State& state=lmStateOfHypScoreInfo(hypScrInf);
+  ExtCacheData& extCacheData=getExtCacheData();
+  std::vector<WordIndex>& trgPhraseIdx=extCacheData.lookupKey.second;
   for(unsigned int i=predHypDataStr.sourceSegmentation.size();i<newHypDataStr.sourceSegmentation.size();++i)
   {
         // Initialize variables
@@ -75,12 +87,12 @@ LangModelFeat<PhrScoreInfo>::extensionScore(const std::vector<std::string>& srcS
       trgLeft=1;
     else
       trgLeft=newHypDataStr.targetSegmentCuts[i-1]+1;
-    std::vector<std::string> trgPhrase;
+    trgPhraseIdx.clear();
     for(unsigned int k=trgLeft;k<=trgRight;++k)
-      trgPhrase.push_back(newHypDataStr.ntarget[k]);
+      trgPhraseIdx.push_back(stringToWordIndex(newHypDataStr.ntarget[k]));
       
         // Update score
-    Score iterScore=getNgramScoreGivenState(trgPhrase,state);
+    Score iterScore=getNgramScoreGivenStateCached(extCacheData,state);
     unweightedScore+= iterScore;
     hypScrInf.score+= weight*iterScore;
   }
@@ -92,13 +104,62 @@ LangModelFeat<PhrScoreInfo>::extensionScore(const std::vector<std::string>& srcS
     Score scrCompl=getEosScoreGivenState(state);
     unweightedScore+= scrCompl;
     hypScrInf.score+= weight*scrCompl;
+  }
 
-        // Add end of sentence to current translation
-    currPartialTrans.push_back(EOS_STR);
+  return hypScrInf;
+}
+
+//---------------
+template<>
+LangModelFeat<PhrScoreInfo>::HypScoreInfo
+LangModelFeat<PhrScoreInfo>::extensionScoreGivenIdx(const std::vector<std::string>& srcSent,
+                                                    const SingleWordVocab& trgVocab,
+                                                    const HypScoreInfo& predHypScrInf,
+                                                    const PhrHypData& predHypData,
+                                                    const PhrHypData& newHypData,
+                                                    float weight,
+                                                    Score& unweightedScore)
+{
+      // Obtain score for hypothesis extension
+  HypScoreInfo hypScrInf=predHypScrInf;
+  unweightedScore=0;
+
+      // Initialize state from the one of the predecessor hypothesis
+  LM_State& state=lmStateOfHypScoreInfo(hypScrInf);
+  ExtCacheData& extCacheData=getExtCacheData();
+
+      // Obtain nodes of the new phrases (they are visited from the
+      // last one)
+  std::vector<const PhrHypNode*>& nodePtrVec=extCacheData.nodePtrVec;
+  nodePtrVec.clear();
+  for(const PhrHypNode* nodePtr=newHypData.getLastPhraseNode();
+      nodePtr!=NULL && nodePtr->numPhrases>predHypData.numberOfPhrases();
+      nodePtr=nodePtr->pred)
+    nodePtrVec.push_back(nodePtr);
+
+  std::vector<WordIndex>& trgPhraseIdx=extCacheData.lookupKey.second;
+  for(unsigned int i=nodePtrVec.size();i>0;--i)
+  {
+        // Map target phrase to language model indices
+    const PhrHypNode* nodePtr=nodePtrVec[i-1];
+    trgPhraseIdx.clear();
+    for(PositionIndex k=0;k<nodePtr->trgPhraseLen;++k)
+      trgPhraseIdx.push_back(trgWordIndexToLmWordIndex(extCacheData,trgVocab,nodePtr->trgPhrase[k]));
+
+        // Update score
+    Score iterScore=getNgramScoreGivenStateCached(extCacheData,state);
+    unweightedScore+= iterScore;
+    hypScrInf.score+= weight*iterScore;
+  }
+
+      // Check if new hypothesis is complete
+  if(newHypData.numberOfSrcWordsCovered()==srcSent.size())
+  {
+        // Obtain score contribution for complete hypothesis
+    Score scrCompl=getEosScoreGivenState(state);
+    unweightedScore+= scrCompl;
+    hypScrInf.score+= weight*scrCompl;
   }
 
-      // Set language model history for hypothesis
-  hypScrInf.lmHist=state;
-  
   return hypScrInf;
 }
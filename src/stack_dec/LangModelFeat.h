@@ -39,9 +39,19 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "WordPredictor.h"
 #include "PhrScoreInfo.h"
 #include "BasePbTransModelFeature.h"
+#include <pthread.h>
+#include <vector>
+#if __GNUC__>2
+#include <ext/hash_map>
+using __gnu_cxx::hash_map;
+#else
+#include <hash_map>
+#endif
 
 //--------------- Constants ------------------------------------------
 
+#define LMFEAT_EXT_CACHE_MAX_SIZE 500000
+#define LMFEAT_UNMAPPED_WORD_IDX  ((WordIndex)-1)
 
 //--------------- Classes --------------------------------------------
 
@@ -62,6 +72,9 @@ class LangModelFeat: public BasePbTransModelFeature<SCORE_INFO>
       // Constructor
   LangModelFeat();
 
+      // Destructor
+  ~LangModelFeat();
+
       // Thread/Process safety related functions
   bool scoringIsProcessSafe(void);
 
@@ -78,12 +91,24 @@ class LangModelFeat: public BasePbTransModelFeature<SCORE_INFO>
                               const PhrHypDataStr& newHypDataStr,
                               float weight,
                               Score& unweightedScore);
+  bool scoresExtensionsGivenIdx(void);
+  HypScoreInfo extensionScoreGivenIdx(const std::vector<std::string>& srcSent,
+                                      const SingleWordVocab& trgVocab,
+                                      const HypScoreInfo& predHypScrInf,
+                                      const PhrHypData& predHypData,
+                                      const PhrHypData& newHypData,
+                                      float weight,
+                                      Score& unweightedScore);
   Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                   const std::vector<std::string>& trgPhrase);
   Score scoreTrgSentence(const std::vector<std::string>& trgSent,
                          float weight,
                          std::vector<Score>& cumulativeScoreVec);
 
+      // Function to clear the cache of extension scores and the word
+      // index mapping of the current thread
+  void clearTempVars(void);
+
       // Word predictor related functions
   std::pair<Count,std::string> getBestSuffix(std::string input);
   std::pair<Count,std::string> getBestSuffixGivenHist(std::vector<std::string> hist,
@@ -93,25 +118,88 @@ class LangModelFeat: public BasePbTransModelFeature<SCORE_INFO>
   void link_lm(BaseNgramLM<LM_State>* _lModelPtr);
   BaseNgramLM<LM_State>* get_lmptr(void);
   void link_wp(WordPredictor* _wordPredPtr);
+
+      // Index of the language model state of the feature within the
+      // score information of the hypotheses
+  void setLmStateIdx(unsigned int _lmStateIdx);
+  unsigned int getLmStateIdx(void);
   
  protected:
 
+      // Cache of extension scores, the key is given by the language
+      // model state and the target phrase (language model indices)
+  typedef std::pair<LM_State,std::vector<WordIndex> > ExtCacheKey;
+  struct ExtCacheKeyHashF
+  {
+    size_t operator()(const ExtCacheKey& key)const;
+  };
+  struct ExtCacheEntry
+  {
+    Score score;
+    LM_State state;
+  };
+  typedef hash_map<ExtCacheKey,ExtCacheEntry,ExtCacheKeyHashF> ExtCache;
+
+      // Data kept by each thread
+  struct ExtCacheData
+  {
+    LangModelFeat<SCORE_INFO>* featPtr;
+    ExtCache extCache;
+        // Key used for lookups (reused to avoid allocations)
+    ExtCacheKey lookupKey;
+        // Mapping from target indices of the translation model to
+        // language model indices, and indices mapped so far
+    const SingleWordVocab* trgVocabPtr;
+    std::vector<WordIndex> lmIdxVec;
+    std::vector<WordIndex> mappedIdxVec;
+        // Nodes of the phrases added by an extension
+    std::vector<const PhrHypNode*> nodePtrVec;
+  };
+
   BaseNgramLM<LM_State>* lModelPtr;
   WordPredictor* wordPredPtr;
+  unsigned int lmStateIdx;
+
+      // Key to access the cache of extension scores (the feature is
+      // shared by the models used by different threads, so each
+      // thread has its own cache)
+  pthread_key_t extCacheKey;
+
+      // Data of all threads, released by the destructor of the feature
+      // or when the thread exits
+  std::vector<ExtCacheData*> extCacheDataPtrVec;
+  pthread_mutex_t extCacheDataMut;
+
+      // Cache related functions
+  ExtCacheData& getExtCacheData(void);
+  static void deleteExtCacheData(void* extCacheDataPtr);
+  void clearWordIdxMapping(ExtCacheData& extCacheData);
+  WordIndex trgWordIndexToLmWordIndex(ExtCacheData& extCacheData,
+                                      const SingleWordVocab& trgVocab,
+                                      WordIndex trgWordIdx);
+  Score getNgramScoreGivenStateCached(ExtCacheData& extCacheData,
+                                      LM_State& lmHist);
+      // Obtains the score for the phrase stored in
+      // extCacheData.lookupKey.second
+  
+      // Functions to access language model states of hypotheses
+  LM_State& lmStateOfHypScoreInfo(HypScoreInfo& hypScrInf);
   
       // Functions to access language model parameters
   Score getEosScoreGivenState(LM_State& lmHist);
   Score getNgramScoreGivenState(std::vector<std::string> trgphrase,
                                 LM_State& lmHist);
-  void addWordSeqToStateStr(const std::vector<std::string>& trgPhrase,
-                            LM_State& state);
-  void addNextWordToStateStr(std::string word,
-                             LM_State& state);
+  Score getNgramScoreGivenStateIdx(const std::vector<WordIndex>& trgPhraseIdx,
+                                   LM_State& lmHist);
 
       // Auxiliary functions
-  void obtainCurrPartialTrans(const PhrHypDataStr& predHypDataStr,
-                              std::vector<std::string>& currPartialTrans);
-  WordIndex stringToWordIndex(std::string str);
+  WordIndex stringToWordIndex(const std::string& str);
+
+ private:
+
+      // Features cannot be copied (thread specific data key)
+  LangModelFeat(const LangModelFeat&);
+  LangModelFeat& operator=(const LangModelFeat&);
 };
 
 //--------------- WordPenaltyFeat class functions
@@ -122,6 +210,22 @@ LangModelFeat<SCORE_INFO>::LangModelFeat()
 {
   lModelPtr=NULL;
   wordPredPtr=NULL;
+  lmStateIdx=0;
+  pthread_mutex_init(&extCacheDataMut,NULL);
+  pthread_key_create(&extCacheKey,&LangModelFeat<SCORE_INFO>::deleteExtCacheData);
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+LangModelFeat<SCORE_INFO>::~LangModelFeat()
+{
+      // Release data of the threads that are still alive (data of
+      // finished threads was released by the thread specific data
+      // destructor)
+  pthread_key_delete(extCacheKey);
+  for(unsigned int i=0;i<extCacheDataPtrVec.size();++i)
+    delete extCacheDataPtrVec[i];
+  pthread_mutex_destroy(&extCacheDataMut);
 }
 
 //---------------------------------
@@ -184,6 +288,18 @@ Score LangModelFeat<SCORE_INFO>::scoreTrgSentence(const std::vector<std::string>
   return finalScr;
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+void LangModelFeat<SCORE_INFO>::clearTempVars(void)
+{
+  ExtCacheData* extCacheDataPtr=(ExtCacheData*) pthread_getspecific(extCacheKey);
+  if(extCacheDataPtr!=NULL)
+  {
+    extCacheDataPtr->extCache.clear();
+    clearWordIdxMapping(*extCacheDataPtr);
+  }
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 std::pair<Count,std::string>
@@ -265,6 +381,145 @@ void LangModelFeat<SCORE_INFO>::link_wp(WordPredictor* _wordPredPtr)
   wordPredPtr=_wordPredPtr;
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+void LangModelFeat<SCORE_INFO>::setLmStateIdx(unsigned int _lmStateIdx)
+{
+  lmStateIdx=_lmStateIdx;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+unsigned int LangModelFeat<SCORE_INFO>::getLmStateIdx(void)
+{
+  return lmStateIdx;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+bool LangModelFeat<SCORE_INFO>::scoresExtensionsGivenIdx(void)
+{
+  return true;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+size_t LangModelFeat<SCORE_INFO>::ExtCacheKeyHashF::operator()(const ExtCacheKey& key)const
+{
+  size_t h=key.first.size();
+  for(unsigned int i=0;i<key.first.size();++i)
+    h^=(size_t)key.first[i]+0x9e3779b9+(h<<6)+(h>>2);
+  for(unsigned int i=0;i<key.second.size();++i)
+    h^=(size_t)key.second[i]+0x9e3779b9+(h<<6)+(h>>2);
+  return h;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+typename LangModelFeat<SCORE_INFO>::ExtCacheData&
+LangModelFeat<SCORE_INFO>::getExtCacheData(void)
+{
+  ExtCacheData* extCacheDataPtr=(ExtCacheData*) pthread_getspecific(extCacheKey);
+  if(extCacheDataPtr==NULL)
+  {
+    extCacheDataPtr=new ExtCacheData;
+    extCacheDataPtr->featPtr=this;
+    extCacheDataPtr->trgVocabPtr=NULL;
+    pthread_setspecific(extCacheKey,extCacheDataPtr);
+
+        // Register data so it can be released by the destructor
+    pthread_mutex_lock(&extCacheDataMut);
+    extCacheDataPtrVec.push_back(extCacheDataPtr);
+    pthread_mutex_unlock(&extCacheDataMut);
+  }
+  return *extCacheDataPtr;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+void LangModelFeat<SCORE_INFO>::deleteExtCacheData(void* extCacheDataPtr)
+{
+  ExtCacheData* dataPtr=(ExtCacheData*) extCacheDataPtr;
+  LangModelFeat<SCORE_INFO>* featPtr=dataPtr->featPtr;
+
+      // Unregister data of the finished thread
+  pthread_mutex_lock(&featPtr->extCacheDataMut);
+  for(unsigned int i=0;i<featPtr->extCacheDataPtrVec.size();++i)
+  {
+    if(featPtr->extCacheDataPtrVec[i]==dataPtr)
+    {
+      featPtr->extCacheDataPtrVec[i]=featPtr->extCacheDataPtrVec.back();
+      featPtr->extCacheDataPtrVec.pop_back();
+      break;
+    }
+  }
+  pthread_mutex_unlock(&featPtr->extCacheDataMut);
+  
+  delete dataPtr;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+void LangModelFeat<SCORE_INFO>::clearWordIdxMapping(ExtCacheData& extCacheData)
+{
+      // Only the entries mapped so far are reset
+  for(unsigned int i=0;i<extCacheData.mappedIdxVec.size();++i)
+    extCacheData.lmIdxVec[extCacheData.mappedIdxVec[i]]=LMFEAT_UNMAPPED_WORD_IDX;
+  extCacheData.mappedIdxVec.clear();
+  extCacheData.trgVocabPtr=NULL;
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+WordIndex LangModelFeat<SCORE_INFO>::trgWordIndexToLmWordIndex(ExtCacheData& extCacheData,
+                                                               const SingleWordVocab& trgVocab,
+                                                               WordIndex trgWordIdx)
+{
+      // The mapping is only valid for the vocabulary it was obtained
+      // with
+  if(extCacheData.trgVocabPtr!=&trgVocab)
+  {
+    clearWordIdxMapping(extCacheData);
+    extCacheData.trgVocabPtr=&trgVocab;
+  }
+  
+  if(trgWordIdx>=extCacheData.lmIdxVec.size())
+    extCacheData.lmIdxVec.resize(trgWordIdx+1,LMFEAT_UNMAPPED_WORD_IDX);
+  if(extCacheData.lmIdxVec[trgWordIdx]==LMFEAT_UNMAPPED_WORD_IDX)
+  {
+    extCacheData.lmIdxVec[trgWordIdx]=stringToWordIndex(trgVocab.wordIndexToTrgString(trgWordIdx));
+    extCacheData.mappedIdxVec.push_back(trgWordIdx);
+  }
+  return extCacheData.lmIdxVec[trgWordIdx];
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+Score LangModelFeat<SCORE_INFO>::getNgramScoreGivenStateCached(ExtCacheData& extCacheData,
+                                                               LM_State& lmHist)
+{
+  ExtCache& extCache=extCacheData.extCache;
+  extCacheData.lookupKey.first=lmHist;
+  typename ExtCache::const_iterator iter=extCache.find(extCacheData.lookupKey);
+  if(iter!=extCache.end())
+  {
+        // Score and resulting state found in cache
+    lmHist=iter->second.state;
+    return iter->second.score;
+  }
+  else
+  {
+        // Obtain score and store it in cache
+    ExtCacheEntry entry;
+    entry.score=getNgramScoreGivenStateIdx(extCacheData.lookupKey.second,lmHist);
+    entry.state=lmHist;
+    if(extCache.size()>=LMFEAT_EXT_CACHE_MAX_SIZE)
+      extCache.clear();
+    extCache.insert(std::make_pair(extCacheData.lookupKey,entry));
+    return entry.score;
+  }
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 Score LangModelFeat<SCORE_INFO>::getEosScoreGivenState(LM_State& lmHist)
@@ -281,16 +536,22 @@ template<class SCORE_INFO>
 Score LangModelFeat<SCORE_INFO>::getNgramScoreGivenState(std::vector<std::string> trgphrase,
                                                          LM_State& lmHist)
 {
-        // Score not present in cache table
-  std::vector<WordIndex> trgPhraseIdx;
-  Score result=0;
-
       // trgPhraseIdx stores the target sentence using indices of the language model
+  std::vector<WordIndex> trgPhraseIdx;
   for(unsigned int i=0;i<trgphrase.size();++i)
   {
     trgPhraseIdx.push_back(this->stringToWordIndex(trgphrase[i]));
   }
-      
+
+  return getNgramScoreGivenStateIdx(trgPhraseIdx,lmHist);
+}
+
+//---------------------------------
+template<class SCORE_INFO>
+Score LangModelFeat<SCORE_INFO>::getNgramScoreGivenStateIdx(const std::vector<WordIndex>& trgPhraseIdx,
+                                                            LM_State& lmHist)
+{
+  Score result=0;
   for(unsigned int i=0;i<trgPhraseIdx.size();++i)
   {
 #ifdef WORK_WITH_ZERO_GRAM_PROB
@@ -307,36 +568,7 @@ Score LangModelFeat<SCORE_INFO>::getNgramScoreGivenState(std::vector<std::string
 
 //---------------------------------
 template<class SCORE_INFO>
-void LangModelFeat<SCORE_INFO>::obtainCurrPartialTrans(const PhrHypDataStr& predHypDataStr,
-                                                       std::vector<std::string>& currPartialTrans)
-{
-      // Add current partial translation words
-  currPartialTrans.clear();
-  for(unsigned int i=1;i<predHypDataStr.ntarget.size();++i)
-    currPartialTrans.push_back(predHypDataStr.ntarget[i]);
-}
-
-//---------------------------------
-template<class SCORE_INFO>
-void LangModelFeat<SCORE_INFO>::addWordSeqToStateStr(const std::vector<std::string>& trgPhrase,
-                                                     LM_State& state)
-{
-  for(unsigned int i=0;i<trgPhrase.size();++i)
-    addNextWordToStateStr(trgPhrase[i],state);
-}
-
-//---------------------------------
-template<class SCORE_INFO>
-void LangModelFeat<SCORE_INFO>::addNextWordToStateStr(std::string word,
-                                                      LM_State& state)
-{
-  WordIndex wordIdx=this->stringToWordIndex(word);
-  this->lModelPtr->addNextWordToState(wordIdx,state);
-}
-
-//---------------------------------
-template<class SCORE_INFO>
-WordIndex LangModelFeat<SCORE_INFO>::stringToWordIndex(std::string str)
+WordIndex LangModelFeat<SCORE_INFO>::stringToWordIndex(const std::string& str)
 {
   if(this->lModelPtr->existSymbol(str))
     return this->lModelPtr->stringToWordIndex(str);
@@ -77,6 +77,7 @@ class LevelDbDictFeat: public BasePbTransModelFeature<SCORE_INFO>
                               Score& unweightedScore);
   Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                   const std::vector<std::string>& trgPhrase);
+  bool isContextFree(void);
 
       // Functions to obtain translation options
   void obtainTransOptions(const std::vector<std::string>& wordVec,
@@ -131,6 +132,13 @@ std::string LevelDbDictFeat<SCORE_INFO>::getFeatType(void)
   return "LevelDbDictFeat";
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool LevelDbDictFeat<SCORE_INFO>::isContextFree(void)
+{
+  return true;
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 Score LevelDbDictFeat<SCORE_INFO>::scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
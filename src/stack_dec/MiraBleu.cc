@@ -132,3 +132,63 @@ void MiraBleu::corpusScore(const std::vector<std::string>& candidates,
   bleu = scoreFromStats(corpusStats);
 }
 
+
+//---------------------------------------
+unsigned int MiraBleu::getNumSuffStats(void)
+{
+  return N_STATS;
+}
+
+//---------------------------------------
+void MiraBleu::sentSuffStats(const std::string& candidate,
+                             const std::string& reference,
+                             double* stats)
+{
+  std::vector<std::string> candidate_tokens, reference_tokens;
+  candidate_tokens = StrProcUtils::stringToStringVector(candidate);
+  reference_tokens = StrProcUtils::stringToStringVector(reference);
+
+  std::vector<unsigned int> sentStats;
+  statsForSentence(candidate_tokens, reference_tokens, sentStats);
+  for (unsigned int i=0; i<N_STATS; i++)
+    stats[i] = sentStats[i];
+}
+
+//---------------------------------------
+void MiraBleu::updateBackgroundCorpusFromSuffStats(const double* stats,
+                                                   double decay)
+{
+  for (unsigned int i=0; i<N_STATS; i++)
+    backgroundBleu[i] = decay*backgroundBleu[i] + stats[i];
+}
+
+//---------------------------------------
+double MiraBleu::sentBackgroundScoreFromSuffStats(const double* sentStats)
+{
+  std::vector<unsigned int> stats(N_STATS);
+  for (unsigned int i=0; i<N_STATS; i++)
+    stats[i] = sentStats[i] + backgroundBleu[i];
+
+  // scale bleu to roughly typical margins
+  return scoreFromStats(stats) * stats[1];
+}
+
+//---------------------------------------
+double MiraBleu::sentScoreFromSuffStats(const double* sentStats)
+{
+  std::vector<unsigned int> stats(N_STATS);
+  for (unsigned int i=0; i<N_STATS; i++)
+    stats[i] = sentStats[i] + 1;
+
+  return scoreFromStats(stats);
+}
+
+//---------------------------------------
+double MiraBleu::corpusScoreFromSuffStats(const double* corpusStats)
+{
+  std::vector<unsigned int> stats(N_STATS);
+  for (unsigned int i=0; i<N_STATS; i++)
+    stats[i] = corpusStats[i];
+
+  return scoreFromStats(stats);
+}
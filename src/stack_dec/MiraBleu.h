@@ -72,6 +72,17 @@ public:
                    const std::vector<std::string>& references,
                    double& score);
 
+    // Functions to work with sufficient statistics
+  unsigned int getNumSuffStats(void);
+  void sentSuffStats(const std::string& candidate,
+                     const std::string& reference,
+                     double* stats);
+  void updateBackgroundCorpusFromSuffStats(const double* stats,
+                                           double decay);
+  double sentBackgroundScoreFromSuffStats(const double* stats);
+  double sentScoreFromSuffStats(const double* stats);
+  double corpusScoreFromSuffStats(const double* stats);
+
 private:
   unsigned int N_STATS;
   std::vector <double> backgroundBleu; // background corpus stats for BLEU
@@ -59,3 +59,40 @@ void MiraChrF::corpusScore(const std::vector<std::string>& candidates,
 
     score /= candidates.size();
 }
+
+unsigned int MiraChrF::getNumSuffStats(void)
+{
+    return N_STATS;
+}
+
+void MiraChrF::sentSuffStats(const std::string& candidate,
+                             const std::string& reference,
+                             double* stats)
+{
+    std::vector<std::string> reference_tokens;
+    reference_tokens = StrProcUtils::stringToStringVector(reference);
+
+    sentScore(candidate, reference, stats[0]);
+    stats[1] = reference_tokens.size();
+    stats[2] = 1;
+}
+
+void MiraChrF::updateBackgroundCorpusFromSuffStats(const double* /*stats*/,
+                                                   double /*decay*/)
+{
+}
+
+double MiraChrF::sentBackgroundScoreFromSuffStats(const double* stats)
+{
+    return stats[0] * stats[1];
+}
+
+double MiraChrF::sentScoreFromSuffStats(const double* stats)
+{
+    return stats[0];
+}
+
+double MiraChrF::corpusScoreFromSuffStats(const double* stats)
+{
+    return stats[0] / stats[2];
+}
@@ -39,7 +39,7 @@ class MiraChrF : public BaseMiraScorer
 public:
     // Constructor
     MiraChrF() {
-        N_STATS = 3; // cand_len, ref_len, chrf
+        N_STATS = 3; // chrf, ref_len, number of sentences
         resetBackgroundCorpus();
     }
 
@@ -64,6 +64,17 @@ public:
                      const std::vector<std::string>& references,
                      double& score);
 
+    // Functions to work with sufficient statistics
+    unsigned int getNumSuffStats(void);
+    void sentSuffStats(const std::string& candidate,
+                       const std::string& reference,
+                       double* stats);
+    void updateBackgroundCorpusFromSuffStats(const double* stats,
+                                             double decay);
+    double sentBackgroundScoreFromSuffStats(const double* stats);
+    double sentScoreFromSuffStats(const double* stats);
+    double corpusScoreFromSuffStats(const double* stats);
+
 private:
     unsigned int N_STATS;
 };
@@ -160,6 +160,11 @@ double MiraGtm::scoreFromStats(std::vector<unsigned int>& stats){
   // stats = [matchings, candidate_len, reference_len]
   double pre, rec, f1;
 
+  // No matchings (or an empty candidate) yield a zero F-measure
+  // instead of 0/0
+  if (stats[0] == 0)
+    return 0;
+
   pre = double(stats[0])/stats[1];
   rec = double(stats[0])/stats[2];
 
@@ -222,3 +227,53 @@ void MiraGtm::corpusScore(const std::vector<std::string>& candidates,
   score = scoreFromStats(corpusStats);
 }
 
+
+//---------------------------------------
+unsigned int MiraGtm::getNumSuffStats(void)
+{
+  return N_STATS;
+}
+
+//---------------------------------------
+void MiraGtm::sentSuffStats(const std::string& candidate,
+                            const std::string& reference,
+                            double* stats)
+{
+  std::vector<std::string> candidate_tokens, reference_tokens;
+  candidate_tokens = StrProcUtils::stringToStringVector(candidate);
+  reference_tokens = StrProcUtils::stringToStringVector(reference);
+
+  std::vector<unsigned int> sentStats;
+  statsForSentence(candidate_tokens, reference_tokens, sentStats);
+  for (unsigned int i=0; i<N_STATS; i++)
+    stats[i] = sentStats[i];
+}
+
+//---------------------------------------
+void MiraGtm::updateBackgroundCorpusFromSuffStats(const double* /*stats*/,
+                                                  double /*decay*/)
+{
+}
+
+//---------------------------------------
+double MiraGtm::sentBackgroundScoreFromSuffStats(const double* sentStats)
+{
+  std::vector<unsigned int> stats(sentStats, sentStats+N_STATS);
+
+  // scale score for Mira
+  return scoreFromStats(stats)*stats[2];
+}
+
+//---------------------------------------
+double MiraGtm::sentScoreFromSuffStats(const double* sentStats)
+{
+  std::vector<unsigned int> stats(sentStats, sentStats+N_STATS);
+  return scoreFromStats(stats);
+}
+
+//---------------------------------------
+double MiraGtm::corpusScoreFromSuffStats(const double* corpusStats)
+{
+  std::vector<unsigned int> stats(corpusStats, corpusStats+N_STATS);
+  return scoreFromStats(stats);
+}
@@ -86,6 +86,57 @@ void MiraWer::corpusScore(const std::vector<std::string>& candidates,
     score = 1.0 - double(nedits)/nwords; 
 }
 
+//---------------------------------------
+unsigned int MiraWer::getNumSuffStats(void)
+{
+  // number of edits, number of reference words
+  return 2;
+}
+
+//---------------------------------------
+void MiraWer::sentSuffStats(const std::string& candidate,
+                            const std::string& reference,
+                            double* stats)
+{
+  std::vector<std::string> candidate_tokens, reference_tokens;
+  candidate_tokens = StrProcUtils::stringToStringVector(candidate);
+  reference_tokens = StrProcUtils::stringToStringVector(reference);
+
+  stats[0] = ed(candidate_tokens, reference_tokens);
+  stats[1] = reference_tokens.size();
+}
+
+//---------------------------------------
+void MiraWer::updateBackgroundCorpusFromSuffStats(const double* /*stats*/,
+                                                  double /*decay*/)
+{
+}
+
+//---------------------------------------
+double MiraWer::sentBackgroundScoreFromSuffStats(const double* stats)
+{
+  if (stats[1] == 0)
+    return 0.0;
+  else
+    // Scale score for mira
+    return (1.0 - stats[0]/stats[1]) * stats[1];
+}
+
+//---------------------------------------
+double MiraWer::sentScoreFromSuffStats(const double* stats)
+{
+  if (stats[1] == 0)
+    return 0.0;
+  else
+    return 1.0 - stats[0]/stats[1];
+}
+
+//---------------------------------------
+double MiraWer::corpusScoreFromSuffStats(const double* stats)
+{
+  return sentScoreFromSuffStats(stats);
+}
+
 //---------------------------------------
 int MiraWer::ed(std::vector<std::string>& s1, std::vector<std::string>& s2) 
 {
@@ -36,6 +36,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "PhrNbestTransTablePref.h"
 #include "PhraseCacheTable.h"
 #include "PhrasePairCacheTable.h"
+#include "NbestTransList.h"
+#include <map>
 
 //--------------- Classes --------------------------------------------
 
@@ -52,6 +54,12 @@ class NbestTransCacheData
   PhrNbestTransTableRef cPhrNbestTransTableRef;
   PhrNbestTransTablePref cPhrNbestTransTablePref;
 
+      // Flat versions of the previous tables. Each list is built once
+      // and then accessed by reference
+  std::map<std::pair<PositionIndex,PositionIndex>,NbestTransList> cPhrNbestTransList;
+  std::map<PhrNbestTransTableRefKey,NbestTransList> cPhrNbestTransListRef;
+  std::map<PhrNbestTransTablePrefKey,NbestTransList> cPhrNbestTransListPref;
+
       // Cached n-best translations scores (these cached scores are
       // those generated by the nbestTransScore() and
       // nbestTransScoreLast() functions)
@@ -65,6 +73,9 @@ class NbestTransCacheData
     cPhrNbestTransTable.clear();
     cPhrNbestTransTableRef.clear();
     cPhrNbestTransTablePref.clear();
+    cPhrNbestTransList.clear();
+    cPhrNbestTransListRef.clear();
+    cPhrNbestTransListPref.clear();
     cnbestTransScore.clear();
     cnbestTransScoreLast.clear();
   };
@@ -0,0 +1,81 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NbestTransList.cc
+ *
+ * @brief Definitions file for NbestTransList.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "NbestTransList.h"
+
+//--------------- NbestTransList class functions
+
+NbestTransList::NbestTransList(void)
+{
+}
+
+//---------------------------------
+void NbestTransList::init(NbestTableNode<PhraseTransTableNodeData>& nbt)
+{
+  entryVec.clear();
+  entryVec.reserve(nbt.size());
+  NbestTableNode<PhraseTransTableNodeData>::iterator nbtIter;
+  for(nbtIter=nbt.begin();nbtIter!=nbt.end();++nbtIter)
+    entryVec.push_back(std::make_pair(nbtIter->first,nbtIter->second));
+}
+
+//---------------------------------
+void NbestTransList::initSingle(Score scr,
+                                const PhraseTransTableNodeData& trgPhrase)
+{
+  entryVec.clear();
+  entryVec.push_back(std::make_pair(scr,trgPhrase));
+}
+
+//---------------------------------
+Score NbestTransList::getScore(unsigned int i)const
+{
+  return entryVec[i].first;
+}
+
+//---------------------------------
+const PhraseTransTableNodeData& NbestTransList::getTrgPhrase(unsigned int i)const
+{
+  return entryVec[i].second;
+}
+
+//---------------------------------
+unsigned int NbestTransList::size(void)const
+{
+  return entryVec.size();
+}
+
+//---------------------------------
+bool NbestTransList::empty(void)const
+{
+  return entryVec.empty();
+}
+
+//---------------------------------
+void NbestTransList::clear(void)
+{
+  entryVec.clear();
+}
@@ -0,0 +1,75 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NbestTransList.h
+ *
+ * @brief Defines the NbestTransList class, an immutable list of
+ * translations of a source phrase sorted by score. The list is built
+ * once from an n-best table node and stored as a flat array of
+ * (score, target phrase) entries, so that it can be traversed by
+ * reference each time a gap is expanded, without copying it.
+ */
+
+#ifndef _NbestTransList_h
+#define _NbestTransList_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "NbestTableNode.h"
+#include "PhraseTransTableNodeData.h"
+#include <vector>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- NbestTransList class
+
+class NbestTransList
+{
+ public:
+
+      // Constructor
+  NbestTransList(void);
+
+      // Builds the list from the given n-best table node, keeping the
+      // order in which the node is traversed (best translations first,
+      // ties in insertion order)
+  void init(NbestTableNode<PhraseTransTableNodeData>& nbt);
+
+      // Builds a list with a single translation
+  void initSingle(Score scr,
+                  const PhraseTransTableNodeData& trgPhrase);
+
+      // Access to the entries, i should be in the range [ 0 , size() )
+  Score getScore(unsigned int i)const;
+  const PhraseTransTableNodeData& getTrgPhrase(unsigned int i)const;
+
+  unsigned int size(void)const;
+  bool empty(void)const;
+  void clear(void);
+
+ private:
+
+  std::vector<std::pair<Score,PhraseTransTableNodeData> > entryVec;
+};
+
+#endif
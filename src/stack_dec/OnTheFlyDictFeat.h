@@ -71,6 +71,7 @@ class OnTheFlyDictFeat: public BasePbTransModelFeature<SCORE_INFO>
                               Score& unweightedScore);
   Score scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
                                   const std::vector<std::string>& trgPhrase);
+  bool isContextFree(void);
 
       // Functions to work with translation options
   void obtainTransOptions(const std::vector<std::string>& wordVec,
@@ -113,6 +114,13 @@ std::string OnTheFlyDictFeat<SCORE_INFO>::getFeatType(void)
   return "OnTheFlyDictFeat";
 }
 
+//---------------------------------
+template<class SCORE_INFO>
+bool OnTheFlyDictFeat<SCORE_INFO>::isContextFree(void)
+{
+  return true;
+}
+
 //---------------------------------
 template<class SCORE_INFO>
 Score OnTheFlyDictFeat<SCORE_INFO>::scorePhrasePairUnweighted(const std::vector<std::string>& srcPhrase,
@@ -0,0 +1,88 @@
+/*
+thot package for statistical machine translation
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file OnlineTrainingDelta.h
+ *
+ * @brief Changes to be applied to the models used for translation
+ * after training a sentence pair.
+ */
+
+#ifndef _OnlineTrainingDelta_h
+#define _OnlineTrainingDelta_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "OnlineTrainingPars.h"
+#include "WordIndex.h"
+#include "PhrasePair.h"
+#include <string>
+#include <vector>
+
+//--------------- OnlineTrainingDelta struct
+
+struct OnlineTrainingDelta
+{
+      // The delta has been obtained, and it has been applied to the
+      // models used for translation
+  bool obtained;
+  bool published;
+
+      // Training sentence pair and parameters used to train it
+  std::vector<std::string> srcSentStrVec;
+  std::vector<std::string> refSentStrVec;
+  OnlineTrainingPars onlineTrainingPars;
+
+      // Indices of the samples used to train the single-word models
+      // (in training order)
+  std::vector<unsigned int> trainedSampleVec;
+
+      // Indices assigned to the vocabulary of the sentence pair by the
+      // single-word models
+  std::vector<WordIndex> srcWordIdxVec;
+  std::vector<WordIndex> refWordIdxVec;
+
+      // Increments in the counts of the phrase model entries (in
+      // application order)
+  std::vector<PhrasePair> invPhPairVec;
+  std::vector<int> invPhPairIncrVec;
+
+  OnlineTrainingDelta()
+    {
+      clear();
+    }
+
+  void clear(void)
+    {
+      obtained=false;
+      published=false;
+      srcSentStrVec.clear();
+      refSentStrVec.clear();
+      onlineTrainingPars.default_values();
+      trainedSampleVec.clear();
+      srcWordIdxVec.clear();
+      refWordIdxVec.clear();
+      invPhPairVec.clear();
+      invPhPairIncrVec.clear();
+    }
+};
+
+#endif
@@ -75,19 +75,25 @@ class PbTransModel: public _pbTransModel<PhraseBasedTmHypRec<EQCLASS_FUNC> >
 
       // Misc. operations with hypothesis
   Score nullHypothesisScrComps(Hypothesis& nullHyp,
-                               std::vector<Score>& scoreComponents);
+                               ScoreComps& scoreComponents);
   unsigned int numberOfUncoveredSrcWordsHypData(const HypDataType& hypd)const;
 
       // Scoring functions
   Score incrScore(const Hypothesis& pred_hyp,
                   const HypDataType& new_hypd,
                   Hypothesis& new_hyp,
-                  std::vector<Score>& scoreComponents);
+                  ScoreComps& scoreComponents);
+  const Score* transOptScoresForExtension(const HypDataType& pred_hypd,
+                                          const HypDataType& new_hypd)const;
+      // Return the scores of the context-free features for the phrase
+      // added by new_hypd, or NULL if new_hypd does not extend
+      // pred_hypd with a single option of the translation option table
 
       // Specific phrase-based functions
   void extendHypDataIdx(PositionIndex srcLeft,
                         PositionIndex srcRight,
                         const std::vector<WordIndex>& trgPhraseIdx,
+                        int transOptIdx,
                         HypDataType& hypd);
 
       // Functions for translating with references or prefixes
@@ -96,9 +102,12 @@ class PbTransModel: public _pbTransModel<PhraseBasedTmHypRec<EQCLASS_FUNC> >
 
       // Heuristic related functions
   PositionIndex getLastSrcPosCoveredHypData(const HypDataType& hypd);
+  void updateTmHeurScoreHypData(const HypDataType& pred_hypd,
+                                const HypDataType& new_hypd,
+                                HypScoreInfo& hypScoreInfo)const;
 
       // Auxiliary functions
-  PhrHypDataStr phypd_to_phypdstr(const PhrHypData phypd);
+  PhrHypDataStr phypd_to_phypdstr(const PhrHypData& phypd);
   
 };
 
@@ -121,12 +130,11 @@ BaseSmtModel<PhraseBasedTmHypRec<EQCLASS_FUNC> >* PbTransModel<EQCLASS_FUNC>::cl
 //---------------------------------
 template<class EQCLASS_FUNC>
 Score PbTransModel<EQCLASS_FUNC>::nullHypothesisScrComps(Hypothesis& nullHyp,
-                                                         std::vector<Score>& scoreComponents)
+                                                         ScoreComps& scoreComponents)
 {
       // Initialize variables
   HypScoreInfo hypScoreInfo;
   HypDataType dataType=nullHypothesisHypData();
-  PhrHypDataStr dataTypeStr=phypd_to_phypdstr(dataType);
 
       // Init scoreInfo
   hypScoreInfo.score=0;
@@ -177,11 +185,6 @@ PbTransModel<EQCLASS_FUNC>::nullHypothesisHypData(void)
 {
   HypDataType dataType;
 
-  dataType.ntarget.clear();  
-  dataType.ntarget.push_back(NULL_WORD);
-  dataType.sourceSegmentation.clear();  
-  dataType.targetSegmentCuts.clear();
-
   return dataType;
 }
 
@@ -189,46 +192,10 @@ PbTransModel<EQCLASS_FUNC>::nullHypothesisHypData(void)
 template<class EQCLASS_FUNC>
 bool PbTransModel<EQCLASS_FUNC>::obtainPredecessorHypData(HypDataType& hypd)
 {
-  HypDataType predData;
-
-  predData=hypd;
-      // verify if hyp has a predecessor
-  if(predData.ntarget.size()<=1) return false;
-  else
-  {
-    unsigned int i;
-    unsigned int cuts;
-
-    if(predData.targetSegmentCuts.size()==0)
-    {
-      std::cerr<<"Warning: hypothesis data corrupted"<<std::endl;
-      return false;
-    }
-
-        // get previous ntarget
-    cuts=predData.targetSegmentCuts.size();
-    if(cuts==1)
-    {
-      i=predData.targetSegmentCuts[0];
-    }
-    else
-    {
-      i=predData.targetSegmentCuts[cuts-1]-predData.targetSegmentCuts[cuts-2];
-    }
-    while(i>0)
-    {
-      predData.ntarget.pop_back();
-      --i;
-    }
-        // get previous sourceSegmentation
-    predData.sourceSegmentation.pop_back();
-        // get previous targetSegmentCuts
-    predData.targetSegmentCuts.pop_back();
-        // set data
-    hypd=predData;
-    
-    return true;
-  }  
+      // verify if hyp has a predecessor, the history of the
+      // hypothesis is shared, so it is enough to move to the node of
+      // the previous phrase
+  return hypd.removeLastPhrase();
 }
 
 //---------------------------------
@@ -241,12 +208,11 @@ bool PbTransModel<EQCLASS_FUNC>::isCompleteHypData(const HypDataType& hypd)const
 
 //---------------------------------
 template<class EQCLASS_FUNC>
-PhrHypDataStr PbTransModel<EQCLASS_FUNC>::phypd_to_phypdstr(const PhrHypData phypd)
+PhrHypDataStr PbTransModel<EQCLASS_FUNC>::phypd_to_phypdstr(const PhrHypData& phypd)
 {
   PhrHypDataStr phypdstr;
-  phypdstr.ntarget=this->trgIndexVectorToStrVector(phypd.ntarget);
-  phypdstr.sourceSegmentation=phypd.sourceSegmentation;
-  phypdstr.targetSegmentCuts=phypd.targetSegmentCuts;
+  phypdstr.ntarget=this->trgIndexVectorToStrVector(phypd.getNtarget());
+  phypd.getPhraseAlign(phypdstr.sourceSegmentation,phypdstr.targetSegmentCuts);
   return phypdstr;
 }
 
@@ -255,56 +221,140 @@ template<class EQCLASS_FUNC>
 Score PbTransModel<EQCLASS_FUNC>::incrScore(const Hypothesis& pred_hyp,
                                             const HypDataType& new_hypd,
                                             Hypothesis& new_hyp,
-                                            std::vector<Score>& scoreComponents)
+                                            ScoreComps& scoreComponents)
 {
       // Initialize variables
   HypScoreInfo hypScoreInfo=pred_hyp.getScoreInfo();
   HypDataType pred_hypd=pred_hyp.getData();
-  PhrHypDataStr pred_hypd_str=phypd_to_phypdstr(pred_hypd);
-  PhrHypDataStr new_hypd_str=phypd_to_phypdstr(new_hypd);
+
+      // String versions of the hypothesis data, they are only obtained
+      // if a feature needs them
+  PhrHypDataStr pred_hypd_str;
+  PhrHypDataStr new_hypd_str;
+  bool hypdStrObtained=false;
 
       // Init scoreComponents
   scoreComponents.clear();
 
+      // Obtain scores of context-free features from the translation
+      // option table when possible
+  const Score* transOptScrs=transOptScoresForExtension(pred_hypd,new_hypd);
+  unsigned int featIdx=0;
+
       // Obtain score for standard features
-  for(unsigned int i=0;i<this->standardFeaturesInfoPtr->featPtrVec.size();++i)
+  for(unsigned int i=0;i<this->standardFeaturesInfoPtr->featPtrVec.size();++i,++featIdx)
+  {
+    Score unweightedScore;
+    if(transOptScrs!=NULL && this->transOptScrIdxVec[featIdx]>=0)
+    {
+      unweightedScore=transOptScrs[this->transOptScrIdxVec[featIdx]];
+      hypScoreInfo.score+=this->getStdFeatWeight(i)*unweightedScore;
+    }
+    else if(this->standardFeaturesInfoPtr->featPtrVec[i]->scoresExtensionsGivenIdx())
+    {
+      hypScoreInfo=this->standardFeaturesInfoPtr->featPtrVec[i]->extensionScoreGivenIdx(this->pbtmInputVars.srcSentVec,
+                                                                                        this->singleWordVocab,
+                                                                                        hypScoreInfo,
+                                                                                        pred_hypd,
+                                                                                        new_hypd,
+                                                                                        this->getStdFeatWeight(i),
+                                                                                        unweightedScore);
+    }
+    else
+    {
+      if(!hypdStrObtained)
+      {
+        pred_hypd_str=phypd_to_phypdstr(pred_hypd);
+        new_hypd_str=phypd_to_phypdstr(new_hypd);
+        hypdStrObtained=true;
+      }
+      hypScoreInfo=this->standardFeaturesInfoPtr->featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
+                                                                                hypScoreInfo,
+                                                                                pred_hypd_str,
+                                                                                new_hypd_str,
+                                                                                this->getStdFeatWeight(i),
+                                                                                unweightedScore);
+    }
+    scoreComponents.push_back(unweightedScore);
+  }
+
+      // Obtain score for custom features
+  /* std::cerr<<"*********************** "<<this->customFeaturesInfoPtr->featPtrVec.size()<<std::endl; */
+  for(unsigned int i=0;i<this->customFeaturesInfoPtr->featPtrVec.size();++i,++featIdx)
   {
     Score unweightedScore;
-    hypScoreInfo=this->standardFeaturesInfoPtr->featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
+    if(transOptScrs!=NULL && this->transOptScrIdxVec[featIdx]>=0)
+    {
+      unweightedScore=transOptScrs[this->transOptScrIdxVec[featIdx]];
+      hypScoreInfo.score+=this->getCustomFeatWeight(i)*unweightedScore;
+    }
+    else if(this->customFeaturesInfoPtr->featPtrVec[i]->scoresExtensionsGivenIdx())
+    {
+      hypScoreInfo=this->customFeaturesInfoPtr->featPtrVec[i]->extensionScoreGivenIdx(this->pbtmInputVars.srcSentVec,
+                                                                                      this->singleWordVocab,
+                                                                                      hypScoreInfo,
+                                                                                      pred_hypd,
+                                                                                      new_hypd,
+                                                                                      this->getCustomFeatWeight(i),
+                                                                                      unweightedScore);
+    }
+    else
+    {
+      if(!hypdStrObtained)
+      {
+        pred_hypd_str=phypd_to_phypdstr(pred_hypd);
+        new_hypd_str=phypd_to_phypdstr(new_hypd);
+        hypdStrObtained=true;
+      }
+      hypScoreInfo=this->customFeaturesInfoPtr->featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
                                                                               hypScoreInfo,
                                                                               pred_hypd_str,
                                                                               new_hypd_str,
-                                                                              this->getStdFeatWeight(i),
+                                                                              this->getCustomFeatWeight(i),
                                                                               unweightedScore);
+    }
     scoreComponents.push_back(unweightedScore);
   }
 
-      // Obtain score for custom features
-  /* std::cerr<<"*********************** "<<this->customFeaturesInfoPtr->featPtrVec.size()<<std::endl; */
-  for(unsigned int i=0;i<this->customFeaturesInfoPtr->featPtrVec.size();++i)
+      // Obtain score for on-the-fly features
+  for(unsigned int i=0;i<this->onTheFlyFeaturesInfo.featPtrVec.size();++i,++featIdx)
   {
     Score unweightedScore;
-    hypScoreInfo=this->customFeaturesInfoPtr->featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
+    if(transOptScrs!=NULL && this->transOptScrIdxVec[featIdx]>=0)
+    {
+      unweightedScore=transOptScrs[this->transOptScrIdxVec[featIdx]];
+      hypScoreInfo.score+=this->getOnTheFlyFeatWeight(i)*unweightedScore;
+    }
+    else if(this->onTheFlyFeaturesInfo.featPtrVec[i]->scoresExtensionsGivenIdx())
+    {
+      hypScoreInfo=this->onTheFlyFeaturesInfo.featPtrVec[i]->extensionScoreGivenIdx(this->pbtmInputVars.srcSentVec,
+                                                                                    this->singleWordVocab,
+                                                                                    hypScoreInfo,
+                                                                                    pred_hypd,
+                                                                                    new_hypd,
+                                                                                    this->getOnTheFlyFeatWeight(i),
+                                                                                    unweightedScore);
+    }
+    else
+    {
+      if(!hypdStrObtained)
+      {
+        pred_hypd_str=phypd_to_phypdstr(pred_hypd);
+        new_hypd_str=phypd_to_phypdstr(new_hypd);
+        hypdStrObtained=true;
+      }
+      hypScoreInfo=this->onTheFlyFeaturesInfo.featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
                                                                             hypScoreInfo,
                                                                             pred_hypd_str,
                                                                             new_hypd_str,
-                                                                            this->getCustomFeatWeight(i),
+                                                                            this->getOnTheFlyFeatWeight(i),
                                                                             unweightedScore);
+    }
     scoreComponents.push_back(unweightedScore);
   }
 
-      // Obtain score for on-the-fly features
-  for(unsigned int i=0;i<this->onTheFlyFeaturesInfo.featPtrVec.size();++i)
-  {
-    Score unweightedScore;
-    hypScoreInfo=this->onTheFlyFeaturesInfo.featPtrVec[i]->extensionScore(this->pbtmInputVars.srcSentVec,
-                                                                          hypScoreInfo,
-                                                                          pred_hypd_str,
-                                                                          new_hypd_str,
-                                                                          this->getOnTheFlyFeatWeight(i),
-                                                                          unweightedScore);
-    scoreComponents.push_back(unweightedScore);
-  }
+      // Update heuristic score of the translation model
+  updateTmHeurScoreHypData(pred_hypd,new_hypd,hypScoreInfo);
 
   new_hyp.setScoreInfo(hypScoreInfo);
   new_hyp.setData(new_hypd);
@@ -314,13 +364,55 @@ Score PbTransModel<EQCLASS_FUNC>::incrScore(const Hypothesis& pred_hyp,
 
 //---------------------------------
 template<class EQCLASS_FUNC>
-unsigned int PbTransModel<EQCLASS_FUNC>::numberOfUncoveredSrcWordsHypData(const HypDataType& hypd)const
+void PbTransModel<EQCLASS_FUNC>::updateTmHeurScoreHypData(const HypDataType& pred_hypd,
+                                                          const HypDataType& new_hypd,
+                                                          HypScoreInfo& hypScoreInfo)const
+{
+  if(!hypScoreInfo.tmHeurScoreValid)
+    return;
+
+      // The stored score can only be updated if new_hypd extends
+      // pred_hypd with a single phrase
+  const PhrHypNode* nodePtr=new_hypd.getLastPhraseNode();
+  if(nodePtr==NULL || nodePtr->pred!=pred_hypd.getLastPhraseNode())
+  {
+    hypScoreInfo.tmHeurScoreValid=false;
+    return;
+  }
+
+      // Obtain the gap of pred_hypd containing the new source phrase
+  PositionIndex srcLeft=nodePtr->srcSegm.first;
+  PositionIndex srcRight=nodePtr->srcSegm.second;
+  PositionIndex gapLeft=1;
+  PositionIndex gapRight=this->pbtmInputVars.srcSentVec.size();
+  for(const PhrHypNode* predNodePtr=nodePtr->pred;predNodePtr!=NULL;predNodePtr=predNodePtr->pred)
+  {
+    if(predNodePtr->srcSegm.second<srcLeft && predNodePtr->srcSegm.second>=gapLeft)
+      gapLeft=predNodePtr->srcSegm.second+1;
+    if(predNodePtr->srcSegm.first>srcRight && predNodePtr->srcSegm.first<=gapRight)
+      gapRight=predNodePtr->srcSegm.first-1;
+  }
+  
+  this->updateTmHeurScore(gapLeft,gapRight,srcLeft,srcRight,hypScoreInfo);
+}
+
+//---------------------------------
+template<class EQCLASS_FUNC>
+const Score* PbTransModel<EQCLASS_FUNC>::transOptScoresForExtension(const HypDataType& pred_hypd,
+                                                                    const HypDataType& new_hypd)const
 {
-  unsigned int n=0;
-  for(unsigned int k=0;k<hypd.sourceSegmentation.size();k++)
-	n+=hypd.sourceSegmentation[k].second-hypd.sourceSegmentation[k].first+1; 
+  const PhrHypNode* nodePtr=new_hypd.getLastPhraseNode();
+  if(nodePtr==NULL || nodePtr->pred!=pred_hypd.getLastPhraseNode() || nodePtr->transOptIdx==TRANS_OPT_NOT_FOUND)
+    return NULL;
+  else
+    return this->transOptTable.getScores(nodePtr->transOptIdx);
+}
 
-  return (this->pbtmInputVars.srcSentVec.size()-n);    
+//---------------------------------
+template<class EQCLASS_FUNC>
+unsigned int PbTransModel<EQCLASS_FUNC>::numberOfUncoveredSrcWordsHypData(const HypDataType& hypd)const
+{
+  return (this->pbtmInputVars.srcSentVec.size()-hypd.numberOfSrcWordsCovered());
 }
 
 //---------------------------------
@@ -328,22 +420,12 @@ template<class EQCLASS_FUNC>
 void PbTransModel<EQCLASS_FUNC>::extendHypDataIdx(PositionIndex srcLeft,
                                                   PositionIndex srcRight,
                                                   const std::vector<WordIndex>& trgPhraseIdx,
+                                                  int transOptIdx,
                                                   HypDataType& hypd)
 {
-  std::pair<PositionIndex,PositionIndex> sourceSegm;
-  
-        // Add trgPhraseIdx to the target vector
-  for(unsigned int i=0;i<trgPhraseIdx.size();++i)
-  {
-    hypd.ntarget.push_back(trgPhraseIdx[i]);
-  }
-  
-      // Add source segment and target cut
-  sourceSegm.first=srcLeft;
-  sourceSegm.second=srcRight;
-  hypd.sourceSegmentation.push_back(sourceSegm);
-  
-  hypd.targetSegmentCuts.push_back(hypd.ntarget.size()-1);  
+      // Add new phrase to hypothesis data (new node is stored in the
+      // arena of the model)
+  hypd.extend(srcLeft,srcRight,trgPhraseIdx,this->getHypDataArena(),transOptIdx);
 }
 
 //---------------------------------
@@ -351,13 +433,17 @@ template<class EQCLASS_FUNC>
 bool PbTransModel<EQCLASS_FUNC>::hypDataTransIsPrefixOfTargetRef(const HypDataType& hypd,
                                                                  bool& equal)const
 {
-  PositionIndex ntrgSize=hypd.ntarget.size();
+  PositionIndex ntrgSize=hypd.partialTransLength()+1;
   PositionIndex nrefSentSize=this->pbtmInputVars.nrefSentIdVec.size();	
 	
   if(ntrgSize>nrefSentSize) return false;
-  for(PositionIndex i=1;i<ntrgSize;++i)
+  for(const PhrHypNode* nodePtr=hypd.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(this->pbtmInputVars.nrefSentIdVec[i]!=hypd.ntarget[i]) return false;
+    PositionIndex start=nodePtr->trgCut-nodePtr->trgPhraseLen+1;
+    for(PositionIndex i=0;i<nodePtr->trgPhraseLen;++i)
+    {
+      if(this->pbtmInputVars.nrefSentIdVec[start+i]!=nodePtr->trgPhrase[i]) return false;
+    }
   }
   if(ntrgSize==nrefSentSize) equal=true;
   else equal=false;
@@ -369,12 +455,7 @@ bool PbTransModel<EQCLASS_FUNC>::hypDataTransIsPrefixOfTargetRef(const HypDataTy
 template<class EQCLASS_FUNC>
 PositionIndex PbTransModel<EQCLASS_FUNC>::getLastSrcPosCoveredHypData(const HypDataType& hypd)
 {
-  SourceSegmentation sourceSegmentation;
-
-  sourceSegmentation=hypd.sourceSegmentation;
-  if(sourceSegmentation.size()>0)
-    return sourceSegmentation.back().second;
-  else return 0;
+  return hypd.getLastSrcPosCovered();
 }
 
 //---------------------------------
@@ -33,8 +33,11 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #endif /* HAVE_CONFIG_H */
 
 #include "WordIndex.h"
+#include "PositionIndex.h"
 #include <string>
 #include <vector>
+#include <map>
+#include <utility>
 
 //--------------- Classes --------------------------------------------
 
@@ -58,6 +61,10 @@ class PbTransModelInputVars
   std::vector<std::string> prefSentVec;
   std::vector<WordIndex> nprefSentIdVec;
 
+      // Variable to store the translation constraints of the source
+      // sentence as vectors of target WordIndex
+  std::map<std::pair<PositionIndex,PositionIndex>,std::vector<WordIndex> > constrTrgIdMap;
+
       // Function to clear variables
   void clear(void)
   {
@@ -69,6 +76,7 @@ class PbTransModelInputVars
     lastCharOfPrefIsBlank=false;
     prefSentVec.clear();
     nprefSentIdVec.clear();
+    constrTrgIdMap.clear();
   };
 };
 
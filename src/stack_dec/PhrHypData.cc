@@ -0,0 +1,110 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file PhrHypData.cc
+ * 
+ * @brief Definitions file for PhrHypData.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "PhrHypData.h"
+
+//--------------- PhrHypData class functions
+
+void PhrHypData::extend(PositionIndex srcLeft,
+                        PositionIndex srcRight,
+                        const std::vector<WordIndex>& trgPhrase,
+                        MonotonicArena& arena,
+                        int transOptIdx)
+{
+  PhrHypNode* nodePtr=(PhrHypNode*) arena.allocate(sizeof(PhrHypNode));
+  WordIndex* trgPhrasePtr=(WordIndex*) arena.allocate(trgPhrase.size()*sizeof(WordIndex));
+  for(unsigned int i=0;i<trgPhrase.size();++i)
+    trgPhrasePtr[i]=trgPhrase[i];
+
+  nodePtr->pred=lastNode;
+  nodePtr->srcSegm.first=srcLeft;
+  nodePtr->srcSegm.second=srcRight;
+  nodePtr->trgCut=partialTransLength()+trgPhrase.size();
+  nodePtr->trgPhrase=trgPhrasePtr;
+  nodePtr->trgPhraseLen=trgPhrase.size();
+  nodePtr->transOptIdx=transOptIdx;
+  nodePtr->numPhrases=numberOfPhrases()+1;
+  nodePtr->numSrcWordsCovered=numberOfSrcWordsCovered()+srcRight-srcLeft+1;
+  
+  lastNode=nodePtr;
+}
+
+//---------------------------------
+bool PhrHypData::removeLastPhrase(void)
+{
+  if(lastNode==NULL)
+    return false;
+  else
+  {
+    lastNode=lastNode->pred;
+    return true;
+  }
+}
+
+//---------------------------------
+std::vector<WordIndex> PhrHypData::getNtarget(void)const
+{
+  std::vector<WordIndex> ntarget(partialTransLength()+1);
+  ntarget[0]=NULL_WORD;
+  for(const PhrHypNode* nodePtr=lastNode;nodePtr!=NULL;nodePtr=nodePtr->pred)
+  {
+    PositionIndex start=nodePtr->trgCut-nodePtr->trgPhraseLen+1;
+    for(PositionIndex i=0;i<nodePtr->trgPhraseLen;++i)
+      ntarget[start+i]=nodePtr->trgPhrase[i];
+  }
+  return ntarget;
+}
+
+//---------------------------------
+SourceSegmentation PhrHypData::getSourceSegmentation(void)const
+{
+  SourceSegmentation sourceSegmentation(numberOfPhrases());
+  for(const PhrHypNode* nodePtr=lastNode;nodePtr!=NULL;nodePtr=nodePtr->pred)
+    sourceSegmentation[nodePtr->numPhrases-1]=nodePtr->srcSegm;
+  return sourceSegmentation;
+}
+
+//---------------------------------
+std::vector<PositionIndex> PhrHypData::getTargetSegmentCuts(void)const
+{
+  std::vector<PositionIndex> targetSegmentCuts(numberOfPhrases());
+  for(const PhrHypNode* nodePtr=lastNode;nodePtr!=NULL;nodePtr=nodePtr->pred)
+    targetSegmentCuts[nodePtr->numPhrases-1]=nodePtr->trgCut;
+  return targetSegmentCuts;
+}
+
+//---------------------------------
+void PhrHypData::getPhraseAlign(SourceSegmentation& sourceSegmentation,
+                                std::vector<PositionIndex>& targetSegmentCuts)const
+{
+  sourceSegmentation.resize(numberOfPhrases());
+  targetSegmentCuts.resize(numberOfPhrases());
+  for(const PhrHypNode* nodePtr=lastNode;nodePtr!=NULL;nodePtr=nodePtr->pred)
+  {
+    sourceSegmentation[nodePtr->numPhrases-1]=nodePtr->srcSegm;
+    targetSegmentCuts[nodePtr->numPhrases-1]=nodePtr->trgCut;
+  }
+}
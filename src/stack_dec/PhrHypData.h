@@ -15,6 +15,18 @@ GNU Lesser General Public License for more details.
 You should have received a copy of the GNU Lesser General Public License
 along with this program; If not, see <http://www.gnu.org/licenses/>.
 */
+ 
+/**
+ * @file PhrHypData.h
+ * 
+ * @brief Defines the PhrHypData class, which stores the partial
+ * translation and the segmentation of phrase-based hypotheses.
+ * Hypotheses share their history: each one points to the node of its
+ * last phrase, and nodes point to the node of the predecessor
+ * hypothesis. Nodes are stored in a MonotonicArena owned by the
+ * translation model, which releases them before translating a new
+ * sentence.
+ */
 
 #ifndef _PhrHypData_h
 #define _PhrHypData_h
@@ -27,21 +39,77 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #include "PositionIndex.h"
 #include "WordIndex.h"
+#include "StatModelDefs.h"
 #include "SourceSegmentation.h"
+#include "MonotonicArena.h"
+#include "TransOptionTable.h"
 #include <vector>
 
 //--------------- Classes --------------------------------------------
 
+//--------------- PhrHypNode struct
+
+struct PhrHypNode
+{
+      // Node of the previous phrase (NULL for the first one)
+  const PhrHypNode* pred;
+
+      // Source phrase covered by the node
+  std::pair<PositionIndex,PositionIndex> srcSegm;
+
+      // Position of the last word of the target phrase in the partial
+      // translation
+  PositionIndex trgCut;
+
+      // Target phrase
+  const WordIndex* trgPhrase;
+  PositionIndex trgPhraseLen;
+
+      // Index of the translation option of the phrase in the table of
+      // the model (TRANS_OPT_NOT_FOUND if it was not taken from it)
+  int transOptIdx;
+
+      // Number of phrases and number of source words covered up to
+      // this node
+  PositionIndex numPhrases;
+  PositionIndex numSrcWordsCovered;
+};
+
+//--------------- PhrHypData class
+
 class PhrHypData
 {
   public:
 
-       // Partial translation
-   std::vector<WordIndex> ntarget;
+       // Constructor (creates data for the null hypothesis)
+   PhrHypData(void):lastNode(NULL){}
+
+       // Functions to modify hypothesis data
+   void extend(PositionIndex srcLeft,
+               PositionIndex srcRight,
+               const std::vector<WordIndex>& trgPhrase,
+               MonotonicArena& arena,
+               int transOptIdx=TRANS_OPT_NOT_FOUND);
+   bool removeLastPhrase(void);
+
+       // Constant time queries
+   const PhrHypNode* getLastPhraseNode(void)const{return lastNode;}
+   unsigned int numberOfPhrases(void)const{return lastNode ? lastNode->numPhrases : 0;}
+   unsigned int numberOfSrcWordsCovered(void)const{return lastNode ? lastNode->numSrcWordsCovered : 0;}
+   unsigned int partialTransLength(void)const{return lastNode ? lastNode->trgCut : 0;}
+   PositionIndex getLastSrcPosCovered(void)const{return lastNode ? lastNode->srcSegm.second : 0;}
+
+       // Functions to obtain the full vectors (the partial translation
+       // starts with NULL_WORD)
+   std::vector<WordIndex> getNtarget(void)const;
+   SourceSegmentation getSourceSegmentation(void)const;
+   std::vector<PositionIndex> getTargetSegmentCuts(void)const;
+   void getPhraseAlign(SourceSegmentation& sourceSegmentation,
+                       std::vector<PositionIndex>& targetSegmentCuts)const;
+
+  private:
 
-       // Translation model info
-   SourceSegmentation sourceSegmentation;
-   std::vector<PositionIndex> targetSegmentCuts;
+   const PhrHypNode* lastNode;
 };
 
 #endif
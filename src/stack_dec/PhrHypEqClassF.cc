@@ -34,11 +34,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 PhrHypEqClassF::EqClassType
 PhrHypEqClassF::operator()(const PhrHypData& pbtHypData)
 {
-  EqClassType eqClass=0;
+  EqClassType eqClass=pbtHypData.numberOfSrcWordsCovered();
   
-  for(unsigned int k=0;k<pbtHypData.sourceSegmentation.size();k++)
-  {
-    eqClass+=pbtHypData.sourceSegmentation[k].second-pbtHypData.sourceSegmentation[k].first+1;
-  }
   return eqClass;
 }
@@ -35,34 +35,25 @@ PhrHypNumcovJumpsEqClassF::EqClassType
 PhrHypNumcovJumpsEqClassF::operator()(const PhrHypData& pbtHypData)
 {
   EqClassType eqClass;
-  std::vector<unsigned int> uivec;
   
-  eqClass.first=0;  // eqClass.first will store the number of covered
-                    // words
+      // eqClass.first stores the number of covered words
+  eqClass.first=pbtHypData.numberOfSrcWordsCovered();
   
   eqClass.second=0; // eqClass.second will store the number of jumps in
                     // the alignment
   
-  for(unsigned int k=0;k<pbtHypData.sourceSegmentation.size();k++)
+  for(const PhrHypNode* nodePtr=pbtHypData.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-        // Update first value
-    eqClass.first+=pbtHypData.sourceSegmentation[k].second-pbtHypData.sourceSegmentation[k].first+1;
-
-        // Update second value
-    if(k==0)
+    if(nodePtr->pred==NULL)
     {
-      if(pbtHypData.sourceSegmentation[0].first>1)
+      if(nodePtr->srcSegm.first>1)
         ++eqClass.second;
     }
     else
     {
-      if(pbtHypData.sourceSegmentation[k-1].second+1!=pbtHypData.sourceSegmentation[k].first)
+      if(nodePtr->pred->srcSegm.second+1!=nodePtr->srcSegm.first)
         ++eqClass.second;
     }
-    
-        // Update coverage vector
-    for(unsigned int j=pbtHypData.sourceSegmentation[k].first;j<=pbtHypData.sourceSegmentation[k].second;++j)
-      set(j-1,uivec);
   }
 
       // Transform equivalence class (a virtual function is used to
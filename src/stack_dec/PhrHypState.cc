@@ -26,12 +26,33 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #include "PhrHypState.h"
 
+//--------------- Function definitions ------------------------------
+
+//---------------
+static inline size_t combineHash(size_t seed,
+                                 size_t value)
+{
+  return seed^(value+0x9e3779b9+(seed<<6)+(seed>>2));
+}
+
+//---------------
+static inline size_t lmStateHash(const LM_State& lmState)
+{
+  size_t h=lmState.size();
+  for(LM_State::const_iterator iter=lmState.begin();iter!=lmState.end();++iter)
+    h=combineHash(h,(size_t)*iter);
+  return h;
+}
+
 //--------------- PhrHypState class functions
 
 bool PhrHypState::operator< (const PhrHypState &right)const
 {
   if(lmHist < right.lmHist) return 0; if(right.lmHist < lmHist) return 1;
 
+  if(extraLmHistVec < right.extraLmHistVec) return 0;
+  if(right.extraLmHistVec < extraLmHistVec) return 1;
+
   if(trglen < right.trglen) return 0; if(right.trglen < trglen) return 1;
 
   if(endLastSrcPhrase<right.endLastSrcPhrase) return 0;
@@ -39,3 +60,26 @@ bool PhrHypState::operator< (const PhrHypState &right)const
   
   return sourceWordsAligned<right.sourceWordsAligned;
 }
+
+//---------------------------------
+bool PhrHypState::operator== (const PhrHypState &right)const
+{
+      // Cheap comparisons first
+  return endLastSrcPhrase==right.endLastSrcPhrase &&
+         trglen==right.trglen &&
+         sourceWordsAligned==right.sourceWordsAligned &&
+         lmHist==right.lmHist &&
+         extraLmHistVec==right.extraLmHistVec;
+}
+
+//---------------------------------
+size_t PhrHypState::hash(void)const
+{
+  size_t h=sourceWordsAligned.hash();
+  h=combineHash(h,endLastSrcPhrase);
+  h=combineHash(h,trglen);
+  h=combineHash(h,lmStateHash(lmHist));
+  for(unsigned int i=0;i<extraLmHistVec.size();++i)
+    h=combineHash(h,lmStateHash(extraLmHistVec[i]));
+  return h;
+}
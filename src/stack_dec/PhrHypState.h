@@ -38,7 +38,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "PositionIndex.h"
 #include "SmtDefs.h"
 #include "BaseHypState.h"
-#include "Bitset.h"
+#include "Coverage.h"
+#include <vector>
 
 //--------------- Classes --------------------------------------------
 
@@ -53,6 +54,7 @@ class PhrHypState: public BaseHypState
 
        // Language model info
    LM_State lmHist;
+   std::vector<LM_State> extraLmHistVec;
 
        // Target length
    unsigned int trglen;
@@ -61,10 +63,14 @@ class PhrHypState: public BaseHypState
    PositionIndex endLastSrcPhrase;
 
        // Coverage info
-   Bitset<MAX_SENTENCE_LENGTH_ALLOWED> sourceWordsAligned;	
+   Coverage sourceWordsAligned;	
        
        // Ordering
    bool operator< (const PhrHypState &right)const;
+
+       // Equality and hashing, used for hypotheses recombination
+   bool operator== (const PhrHypState &right)const;
+   size_t hash(void)const;
 };
 
 #endif
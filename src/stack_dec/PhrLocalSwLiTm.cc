@@ -428,57 +428,16 @@ PhrLocalSwLiTm::nullHypothesisHypData(void)
 {
   HypDataType dataType;
 
-  dataType.ntarget.clear();  
-  dataType.ntarget.push_back(NULL_WORD);
-  dataType.sourceSegmentation.clear();  
-  dataType.targetSegmentCuts.clear();
-
   return dataType;
 }
 
 //---------------------------------
 bool PhrLocalSwLiTm::obtainPredecessorHypData(HypDataType& hypd)
 {
-  HypDataType predData;
-
-  predData=hypd;
-      // verify if hyp has a predecessor
-  if(predData.ntarget.size()<=1) return false;
-  else
-  {
-    unsigned int i;
-    unsigned int cuts;
-
-    if(predData.targetSegmentCuts.size()==0)
-    {
-      std::cerr<<"Warning: hypothesis data corrupted"<<std::endl;
-      return false;
-    }
-
-        // get previous ntarget
-    cuts=predData.targetSegmentCuts.size();
-    if(cuts==1)
-    {
-      i=predData.targetSegmentCuts[0];
-    }
-    else
-    {
-      i=predData.targetSegmentCuts[cuts-1]-predData.targetSegmentCuts[cuts-2];
-    }
-    while(i>0)
-    {
-      predData.ntarget.pop_back();
-      --i;
-    }
-        // get previous sourceSegmentation
-    predData.sourceSegmentation.pop_back();
-        // get previous targetSegmentCuts
-    predData.targetSegmentCuts.pop_back();
-        // set data
-    hypd=predData;
-    
-    return true;
-  }
+      // verify if hyp has a predecessor, the history of the
+      // hypothesis is shared, so it is enough to move to the node of
+      // the previous phrase
+  return hypd.removeLastPhrase();
 }
 
 //---------------------------------
@@ -1177,46 +1136,44 @@ std::ostream& PhrLocalSwLiTm::print_lambdas(std::ostream &outS)
 unsigned int
 PhrLocalSwLiTm::numberOfUncoveredSrcWordsHypData(const HypDataType& hypd)const
 {
-  unsigned int k,n;
-
-  n=0;
-  for(k=0;k<hypd.sourceSegmentation.size();k++)
-	n+=hypd.sourceSegmentation[k].second-hypd.sourceSegmentation[k].first+1; 
-
-  return (pbtmInputVars.srcSentVec.size()-n);  
+  return (pbtmInputVars.srcSentVec.size()-hypd.numberOfSrcWordsCovered());
 }
 
 //---------------------------------
 Score PhrLocalSwLiTm::incrScore(const Hypothesis& pred_hyp,
                                 const HypDataType& new_hypd,
                                 Hypothesis& new_hyp,
-                                std::vector<Score>& scoreComponents)
+                                ScoreComps& scoreComponents)
 {
   HypScoreInfo hypScoreInfo=pred_hyp.getScoreInfo();
   HypDataType pred_hypd=pred_hyp.getData();
-  unsigned int trglen=pred_hypd.ntarget.size()-1;
-  Bitset<MAX_SENTENCE_LENGTH_ALLOWED> hypKey=pred_hyp.getKey();
+  unsigned int trglen=pred_hypd.partialTransLength();
+  Coverage hypKey=pred_hyp.getKey();
+  std::vector<WordIndex> new_ntarget=new_hypd.getNtarget();
+  SourceSegmentation new_sourceSegmentation;
+  std::vector<PositionIndex> new_targetSegmentCuts;
+  new_hypd.getPhraseAlign(new_sourceSegmentation,new_targetSegmentCuts);
     
       // Init scoreComponents
   scoreComponents.clear();
   for(unsigned int i=0;i<getNumWeights();++i) scoreComponents.push_back(0);
   
-  for(unsigned int i=pred_hypd.sourceSegmentation.size();i<new_hypd.sourceSegmentation.size();++i)
+  for(unsigned int i=pred_hypd.numberOfPhrases();i<new_sourceSegmentation.size();++i)
   {
         // Source segment is not present in the previous data
-    unsigned int srcLeft=new_hypd.sourceSegmentation[i].first;
-    unsigned int srcRight=new_hypd.sourceSegmentation[i].second;
+    unsigned int srcLeft=new_sourceSegmentation[i].first;
+    unsigned int srcRight=new_sourceSegmentation[i].second;
     unsigned int trgLeft;
     unsigned int trgRight;
     std::vector<WordIndex> trgphrase;
     std::vector<WordIndex> s_;
       
-    trgRight=new_hypd.targetSegmentCuts[i];
+    trgRight=new_targetSegmentCuts[i];
     if(i==0) trgLeft=1;
-    else trgLeft=new_hypd.targetSegmentCuts[i-1]+1;
+    else trgLeft=new_targetSegmentCuts[i-1]+1;
     for(unsigned int k=trgLeft;k<=trgRight;++k)
     {
-      trgphrase.push_back(new_hypd.ntarget[k]);
+      trgphrase.push_back(new_ntarget[k]);
     }
         // Calculate new sum word penalty score
     scoreComponents[WPEN]-=sumWordPenaltyScore(trglen);
@@ -1231,12 +1188,12 @@ Score PhrLocalSwLiTm::incrScore(const Hypothesis& pred_hyp,
         // phrase alignment score      
     int lastSrcPosStart=srcLeft;
     int prevSrcPosEnd;
-    if(i>0) prevSrcPosEnd=new_hypd.sourceSegmentation[i-1].second;
+    if(i>0) prevSrcPosEnd=new_sourceSegmentation[i-1].second;
     else prevSrcPosEnd=0;
     scoreComponents[SJUMP]+=this->srcJumpScore(abs(lastSrcPosStart-(prevSrcPosEnd+1))); 
 
         // source segment length score
-    scoreComponents[SSEGMLEN]+=srcSegmLenScore(i,new_hypd.sourceSegmentation,this->pbtmInputVars.srcSentVec.size(),trgphrase.size());
+    scoreComponents[SSEGMLEN]+=srcSegmLenScore(i,new_sourceSegmentation,this->pbtmInputVars.srcSentVec.size(),trgphrase.size());
 
         // Obtain translation score
     for(unsigned int k=srcLeft;k<=srcRight;++k)
@@ -1256,8 +1213,7 @@ Score PhrLocalSwLiTm::incrScore(const Hypothesis& pred_hyp,
 
         // Calculate sentence length model contribution
     scoreComponents[PTS+logptsScrVec.size()*2]-=sentLenScoreForPartialHyp(hypKey,trglen);
-    for(unsigned int j=srcLeft;j<=srcRight;++j)
-      hypKey.set(j);
+    hypKey.setRange(srcLeft,srcRight);
     scoreComponents[PTS+logptsScrVec.size()*2]+=sentLenScoreForPartialHyp(hypKey,trglen+trgphrase.size());
 
         // Increase trglen
@@ -1424,31 +1380,15 @@ void PhrLocalSwLiTm::extendHypDataIdx(PositionIndex srcLeft,
                                       const std::vector<WordIndex>& trgPhraseIdx,
                                       HypDataType& hypd)
 {
-  std::pair<PositionIndex,PositionIndex> sourceSegm;
-  
-        // Add trgPhraseIdx to the target vector
-  for(unsigned int i=0;i<trgPhraseIdx.size();++i)
-  {
-    hypd.ntarget.push_back(trgPhraseIdx[i]);
-  }
-  
-      // Add source segment and target cut
-  sourceSegm.first=srcLeft;
-  sourceSegm.second=srcRight;
-  hypd.sourceSegmentation.push_back(sourceSegm);
-  
-  hypd.targetSegmentCuts.push_back(hypd.ntarget.size()-1);
+      // Add new phrase to hypothesis data (new node is stored in the
+      // arena of the model)
+  hypd.extend(srcLeft,srcRight,trgPhraseIdx,hypDataArena);
 }
 
 //---------------------------------
 PositionIndex PhrLocalSwLiTm::getLastSrcPosCoveredHypData(const HypDataType& hypd)
 {
-  SourceSegmentation sourceSegmentation;
-
-  sourceSegmentation=hypd.sourceSegmentation;
-  if(sourceSegmentation.size()>0)
-    return sourceSegmentation.back().second;
-  else return 0;
+  return hypd.getLastSrcPosCovered();
 }
 
 //---------------------------------
@@ -1457,13 +1397,17 @@ bool PhrLocalSwLiTm::hypDataTransIsPrefixOfTargetRef(const HypDataType& hypd,
 {
   PositionIndex ntrgSize,nrefSentSize;
   
-  ntrgSize=hypd.ntarget.size();
+  ntrgSize=hypd.partialTransLength()+1;
   nrefSentSize=pbtmInputVars.nrefSentIdVec.size();	
 	
   if(ntrgSize>nrefSentSize) return false;
-  for(PositionIndex i=1;i<ntrgSize;++i)
+  for(const PhrHypNode* nodePtr=hypd.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(pbtmInputVars.nrefSentIdVec[i]!=hypd.ntarget[i]) return false;
+    PositionIndex start=nodePtr->trgCut-nodePtr->trgPhraseLen+1;
+    for(PositionIndex i=0;i<nodePtr->trgPhraseLen;++i)
+    {
+      if(pbtmInputVars.nrefSentIdVec[start+i]!=nodePtr->trgPhrase[i]) return false;
+    }
   }
   if(ntrgSize==nrefSentSize) equal=true;
   else equal=false;
@@ -168,7 +168,7 @@ class PhrLocalSwLiTm: public _phrSwTransModel<PhrLocalSwLiTmHypRec<HypEqClassF>
   Score incrScore(const Hypothesis& prev_hyp,
                   const HypDataType& new_hypd,
                   Hypothesis& new_hyp,
-                  std::vector<Score>& scoreComponents);
+                  ScoreComps& scoreComponents);
       // Phrase model scoring functions
   Score smoothedPhrScore_s_t_(const std::vector<WordIndex>& s_,
                               const std::vector<WordIndex>& t_);
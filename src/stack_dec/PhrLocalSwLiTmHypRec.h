@@ -74,9 +74,9 @@ PhrLocalSwLiTmHypRec<EQCLASS_FUNC>::getHypState(void)const
   typename PhrLocalSwLiTmHypRec::HypState hypState;
 
   hypState.lmHist=this->scoreInfo.lmHist;
-  hypState.trglen=this->data.ntarget.size()-1;
-  if(this->data.sourceSegmentation.size()==0) hypState.endLastSrcPhrase=0;
-  else hypState.endLastSrcPhrase=this->data.sourceSegmentation.back().second;
+  hypState.extraLmHistVec=this->scoreInfo.extraLmHistVec;
+  hypState.trglen=this->data.partialTransLength();
+  hypState.endLastSrcPhrase=this->data.getLastSrcPosCovered();
   hypState.sourceWordsAligned=this->getKey();
   
   return hypState;
@@ -28,6 +28,15 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- PhrScoreInfo class functions
 
+PhrScoreInfo::PhrScoreInfo(void)
+{
+  score=0;
+  heurScore=0;
+  tmHeurScore=0;
+  tmHeurScoreValid=false;
+}
+
+//---------------------------------
 Score PhrScoreInfo::getScore(void)const
 {
   return score;
@@ -44,3 +53,10 @@ void PhrScoreInfo::subtractHeuristic(Score h)
 {
   score=score-h;
 }
+
+//---------------------------------
+void PhrScoreInfo::setHeuristic(Score h)
+{
+  score=score-heurScore+h;
+  heurScore=h;
+}
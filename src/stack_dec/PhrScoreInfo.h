@@ -36,6 +36,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
                          // configure by checking LM_STATE_H
                          // variable (default value: LM_State.h)
 #include "Score.h"
+#include <vector>
 
 //--------------- Classes --------------------------------------------
 
@@ -44,13 +45,30 @@ class PhrScoreInfo
   public:
 
    Score score;
+
+       // Heuristic score included in score (see setHeuristic())
+   Score heurScore;
+
+       // Heuristic score of the translation model for the source words
+       // that are not covered, it is only meaningful if
+       // tmHeurScoreValid is true
+   Score tmHeurScore;
+   bool tmHeurScoreValid;
   
-       // Language model info
+       // Language model info (state of the first language model
+       // feature)
    LM_State lmHist;
 
+       // States of additional language model features
+   std::vector<LM_State> extraLmHistVec;
+
+   PhrScoreInfo(void);
    Score getScore(void)const;
    void addHeuristic(Score h);
    void subtractHeuristic(Score h);
+   void setHeuristic(Score h);
+       // Replaces the heuristic score included in score by h, so the
+       // heuristic does not have to be recalculated to be removed
 };
 
 #endif
@@ -0,0 +1,489 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file SmtHeapStack.h
+ *
+ * @brief The SmtHeapStack class implements a bounded stack to be used
+ * in stack decoding. Hypotheses are stored in a flat vector of slots
+ * and ordered by means of two binary heaps of slot handles, one of
+ * them giving access to the best hypothesis and the other one to the
+ * worst hypothesis.
+ */
+
+#ifndef _SmtHeapStack_h
+#define _SmtHeapStack_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <limits.h>
+#include <vector>
+#include <algorithm>
+#include "Score.h"
+#include "BaseSmtStack.h"
+
+//--------------- Constants ------------------------------------------
+
+#define SMT_HEAP_STACK_NULL_HANDLE UINT_MAX
+
+//--------------- Classes --------------------------------------------
+
+//--------------- SmtHeapStack template class
+
+/**
+ * @brief Bounded statistical machine translation stack based on
+ * binary heaps. Hypotheses are sorted in the same way as in the
+ * SmtStack class: by decreasing score and, in case of ties, by
+ * insertion order.
+ */
+template<class HYPOTHESIS> 
+class SmtHeapStack: public BaseSmtStack<HYPOTHESIS>
+{
+ public:
+
+  typedef unsigned int HypHandle;
+
+      // constructor
+  SmtHeapStack(void);
+
+      // stack size related functions
+  void setMaxStackSize(unsigned int _maxStackSize);
+  unsigned int getMaxStackSize(void);
+
+      // basic functionality
+  HypHandle pushHandle(const HYPOTHESIS& hyp);
+      // push hyp into the stack. pushHandle returns
+      // SMT_HEAP_STACK_NULL_HANDLE if the hyp was not finally pushed
+      // into the stack, the handle remains valid until the
+      // hypothesis is removed
+  HypHandle nullHandle(void);
+  bool push(const HYPOTHESIS& hyp);
+  HYPOTHESIS top(void);
+  HYPOTHESIS pop(void);
+  HYPOTHESIS last(void);
+  void remove(HypHandle handle);
+  void removeLast(void);
+  bool empty(void);
+  size_t size(void);
+  void clear(void);
+      // clear() keeps the allocated slots so they can be reused
+
+      // functions to access hypotheses without copying them
+  HypHandle topHandle(void)const;
+  HypHandle lastHandle(void)const;
+  Score topScore(void)const;
+  Score lastScore(void)const;
+  const HYPOTHESIS& getHyp(HypHandle handle)const;
+  void getSortedHandles(std::vector<HypHandle>& handleVec)const;
+      // Obtain handles of the stored hypotheses sorted from best to
+      // worst
+  
+ protected:
+
+  unsigned int maxStackSize;
+
+      // Slots
+  std::vector<HYPOTHESIS> hypVec;
+  std::vector<Score> scoreVec;
+  std::vector<unsigned long long> seqVec;
+  std::vector<unsigned int> bestHeapPosVec;
+  std::vector<unsigned int> worstHeapPosVec;
+  std::vector<HypHandle> freeHandleVec;
+  unsigned long long seqCounter;
+
+      // Heaps
+  std::vector<HypHandle> bestHeap;
+  std::vector<HypHandle> worstHeap;
+
+      // Sort criterion for handles
+  class HandleSortCriterion
+  {
+   public:
+    const SmtHeapStack<HYPOTHESIS>* stackPtr;
+    HandleSortCriterion(const SmtHeapStack<HYPOTHESIS>* _stackPtr):stackPtr(_stackPtr){}
+    bool operator() (HypHandle h1,HypHandle h2)const
+      {
+        return stackPtr->isBetter(h1,h2);
+      }
+  };
+
+      // auxiliary functions
+  bool isBetter(HypHandle h1,HypHandle h2)const;
+  bool precedes(bool worst,HypHandle h1,HypHandle h2)const;
+  HypHandle allocSlot(const HYPOTHESIS& hyp);
+  void heapInsert(bool worst,HypHandle handle);
+  void heapErase(bool worst,unsigned int pos);
+  void siftUp(bool worst,unsigned int pos);
+  void siftDown(bool worst,unsigned int pos);
+  void heapSet(bool worst,unsigned int pos,HypHandle handle);
+};
+
+//--------------- SmtHeapStack template class function definitions
+
+template<class HYPOTHESIS> 
+SmtHeapStack<HYPOTHESIS>::SmtHeapStack(void)
+{
+# ifdef THOT_STATS
+  this->discardedPushOpsDueToSize=0;
+  this->discardedPushOpsDueToRec=0;
+# endif
+
+  seqCounter=0;
+  setMaxStackSize(1024);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::setMaxStackSize(unsigned int _maxStackSize)
+{
+  maxStackSize=_maxStackSize;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+unsigned int SmtHeapStack<HYPOTHESIS>::getMaxStackSize(void)
+{
+  return maxStackSize;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtHeapStack<HYPOTHESIS>::HypHandle
+SmtHeapStack<HYPOTHESIS>::pushHandle(const HYPOTHESIS& hyp)
+{
+  if(maxStackSize==0) return SMT_HEAP_STACK_NULL_HANDLE;
+  else
+  {
+    while(bestHeap.size()>maxStackSize) removeLast();
+
+    if(bestHeap.size()==maxStackSize &&
+       (double)lastScore()>=(double)hyp.getScore())
+    {
+          // stack has reached its maximum size but the score of hyp is
+          // worse than the score of the last hypothesis
+#    ifdef THOT_STATS
+      ++this->discardedPushOpsDueToSize;
+#    endif
+
+      return SMT_HEAP_STACK_NULL_HANDLE;
+    }
+    else
+    {
+          // hyp is inserted and then the stack is pruned
+      HypHandle handle=allocSlot(hyp);
+      heapInsert(false,handle);
+      heapInsert(true,handle);
+      if(bestHeap.size()>maxStackSize)
+      {
+        removeLast();
+#      ifdef THOT_STATS
+        ++this->discardedPushOpsDueToSize;
+#      endif
+      }
+      return handle;
+    }
+  }
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtHeapStack<HYPOTHESIS>::HypHandle
+SmtHeapStack<HYPOTHESIS>::nullHandle(void)
+{
+  return SMT_HEAP_STACK_NULL_HANDLE;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+bool SmtHeapStack<HYPOTHESIS>::push(const HYPOTHESIS& hyp)
+{
+  if(pushHandle(hyp)==SMT_HEAP_STACK_NULL_HANDLE) return false;
+  else return true;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+HYPOTHESIS SmtHeapStack<HYPOTHESIS>::top(void)
+{
+  return hypVec[bestHeap[0]];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+HYPOTHESIS SmtHeapStack<HYPOTHESIS>::pop(void)
+{
+  HypHandle handle=bestHeap[0];
+  HYPOTHESIS hyp=hypVec[handle];
+  remove(handle);
+  return hyp;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+HYPOTHESIS SmtHeapStack<HYPOTHESIS>::last(void)
+{
+  return hypVec[worstHeap[0]];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::remove(HypHandle handle)
+{
+  if(handle<hypVec.size() && bestHeapPosVec[handle]!=SMT_HEAP_STACK_NULL_HANDLE)
+  {
+    heapErase(false,bestHeapPosVec[handle]);
+    heapErase(true,worstHeapPosVec[handle]);
+    bestHeapPosVec[handle]=SMT_HEAP_STACK_NULL_HANDLE;
+    worstHeapPosVec[handle]=SMT_HEAP_STACK_NULL_HANDLE;
+    freeHandleVec.push_back(handle);
+  }
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::removeLast(void)
+{
+  if(!worstHeap.empty())
+    remove(worstHeap[0]);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+bool SmtHeapStack<HYPOTHESIS>::empty(void)
+{
+  return bestHeap.empty();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+size_t SmtHeapStack<HYPOTHESIS>::size(void)
+{
+  return bestHeap.size();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::clear(void)
+{
+# ifdef THOT_STATS
+  this->discardedPushOpsDueToSize=0;
+  this->discardedPushOpsDueToRec=0;
+# endif
+
+      // Mark all slots as free (hypotheses are kept so as to reuse
+      // their memory when the slots are assigned again)
+  bestHeap.clear();
+  worstHeap.clear();
+  freeHandleVec.clear();
+  for(unsigned int i=hypVec.size();i>0;--i)
+  {
+    bestHeapPosVec[i-1]=SMT_HEAP_STACK_NULL_HANDLE;
+    worstHeapPosVec[i-1]=SMT_HEAP_STACK_NULL_HANDLE;
+    freeHandleVec.push_back(i-1);
+  }
+  seqCounter=0;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtHeapStack<HYPOTHESIS>::HypHandle
+SmtHeapStack<HYPOTHESIS>::topHandle(void)const
+{
+  return bestHeap[0];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtHeapStack<HYPOTHESIS>::HypHandle
+SmtHeapStack<HYPOTHESIS>::lastHandle(void)const
+{
+  return worstHeap[0];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+Score SmtHeapStack<HYPOTHESIS>::topScore(void)const
+{
+  return scoreVec[bestHeap[0]];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+Score SmtHeapStack<HYPOTHESIS>::lastScore(void)const
+{
+  return scoreVec[worstHeap[0]];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+const HYPOTHESIS& SmtHeapStack<HYPOTHESIS>::getHyp(HypHandle handle)const
+{
+  return hypVec[handle];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::getSortedHandles(std::vector<HypHandle>& handleVec)const
+{
+  handleVec=bestHeap;
+  std::sort(handleVec.begin(),handleVec.end(),HandleSortCriterion(this));
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+bool SmtHeapStack<HYPOTHESIS>::isBetter(HypHandle h1,HypHandle h2)const
+{
+      // Hypotheses with the same score are sorted by insertion order
+  if(scoreVec[h1]>scoreVec[h2]) return true;
+  if(scoreVec[h2]>scoreVec[h1]) return false;
+  return seqVec[h1]<seqVec[h2];
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+bool SmtHeapStack<HYPOTHESIS>::precedes(bool worst,
+                                        HypHandle h1,
+                                        HypHandle h2)const
+{
+  if(worst) return isBetter(h2,h1);
+  else return isBetter(h1,h2);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtHeapStack<HYPOTHESIS>::HypHandle
+SmtHeapStack<HYPOTHESIS>::allocSlot(const HYPOTHESIS& hyp)
+{
+  HypHandle handle;
+  if(freeHandleVec.empty())
+  {
+    handle=hypVec.size();
+    hypVec.push_back(hyp);
+    scoreVec.push_back(hyp.getScore());
+    seqVec.push_back(seqCounter);
+    bestHeapPosVec.push_back(SMT_HEAP_STACK_NULL_HANDLE);
+    worstHeapPosVec.push_back(SMT_HEAP_STACK_NULL_HANDLE);
+  }
+  else
+  {
+    handle=freeHandleVec.back();
+    freeHandleVec.pop_back();
+    hypVec[handle]=hyp;
+    scoreVec[handle]=hyp.getScore();
+    seqVec[handle]=seqCounter;
+  }
+  ++seqCounter;
+  return handle;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::heapInsert(bool worst,
+                                          HypHandle handle)
+{
+  std::vector<HypHandle>& heap=(worst ? worstHeap : bestHeap);
+  heap.push_back(handle);
+  heapSet(worst,heap.size()-1,handle);
+  siftUp(worst,heap.size()-1);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::heapErase(bool worst,
+                                         unsigned int pos)
+{
+  std::vector<HypHandle>& heap=(worst ? worstHeap : bestHeap);
+  unsigned int lastPos=heap.size()-1;
+  if(pos==lastPos)
+  {
+    heap.pop_back();
+  }
+  else
+  {
+        // Move last element to the position of the erased one and
+        // restore the heap property
+    heapSet(worst,pos,heap[lastPos]);
+    heap.pop_back();
+    if(pos>0 && precedes(worst,heap[pos],heap[(pos-1)/2]))
+      siftUp(worst,pos);
+    else
+      siftDown(worst,pos);
+  }
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::siftUp(bool worst,
+                                      unsigned int pos)
+{
+  std::vector<HypHandle>& heap=(worst ? worstHeap : bestHeap);
+  HypHandle handle=heap[pos];
+  while(pos>0)
+  {
+    unsigned int parent=(pos-1)/2;
+    if(!precedes(worst,handle,heap[parent])) break;
+    heapSet(worst,pos,heap[parent]);
+    pos=parent;
+  }
+  heapSet(worst,pos,handle);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::siftDown(bool worst,
+                                        unsigned int pos)
+{
+  std::vector<HypHandle>& heap=(worst ? worstHeap : bestHeap);
+  HypHandle handle=heap[pos];
+  unsigned int heapSize=heap.size();
+  while(true)
+  {
+    unsigned int child=2*pos+1;
+    if(child>=heapSize) break;
+    if(child+1<heapSize && precedes(worst,heap[child+1],heap[child]))
+      ++child;
+    if(!precedes(worst,heap[child],handle)) break;
+    heapSet(worst,pos,heap[child]);
+    pos=child;
+  }
+  heapSet(worst,pos,handle);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtHeapStack<HYPOTHESIS>::heapSet(bool worst,
+                                       unsigned int pos,
+                                       HypHandle handle)
+{
+  if(worst)
+  {
+    worstHeap[pos]=handle;
+    worstHeapPosVec[handle]=pos;
+  }
+  else
+  {
+    bestHeap[pos]=handle;
+    bestHeapPosVec[handle]=pos;
+  }
+}
+
+#endif
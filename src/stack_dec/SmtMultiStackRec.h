@@ -44,20 +44,26 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 /**
  * @brief Multiple stack with hypothesis recombination for statistical
- * machine translation.
+ * machine translation. SUBSTACK is the stack class used for each
+ * equivalence class, it should provide the handle-based interface of
+ * SmtHeapStack and SmtStack.
  */
 
-template<class HYPOTHESIS_REC> 
-class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
+template<class HYPOTHESIS_REC,class SUBSTACK=SmtHeapStack<HYPOTHESIS_REC> > 
+class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>
 {
  public:
 
-  typedef typename _smtMultiStack<HYPOTHESIS_REC>::EqClassFunc EqClassFunc;
-  typedef typename _smtMultiStack<HYPOTHESIS_REC>::EqClassType EqClassType;
-  typedef typename _smtMultiStack<HYPOTHESIS_REC>::EqClassTypeHashF EqClassTypeHashF;
-  typedef typename _smtMultiStack<HYPOTHESIS_REC>::MultiContainer MultiContainer;
-  typedef typename _smtMultiStack<HYPOTHESIS_REC>::SortedStacksMap SortedStacksMap;
-  typedef std::map<HypStateIndex,typename SmtStack<HYPOTHESIS_REC>::iterator> RecInfoMap;
+  typedef typename _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::EqClassFunc EqClassFunc;
+  typedef typename _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::EqClassType EqClassType;
+  typedef typename _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::EqClassTypeHashF EqClassTypeHashF;
+  typedef typename _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::MultiContainer MultiContainer;
+  typedef typename _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::SortedStacksMap SortedStacksMap;
+  typedef typename SUBSTACK::HypHandle HypHandle;
+      // Recombination info (stack and handle of the hypothesis stored
+      // for each state), indexed by state index. A NULL stack pointer
+      // indicates that no hypothesis is stored for the state
+  typedef std::vector<std::pair<SUBSTACK*,HypHandle> > RecInfoVec;
 
       // iterator
   class iterator;
@@ -65,11 +71,11 @@ class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
   class iterator
   {
    protected:
-    SmtMultiStackRec<HYPOTHESIS_REC>* smtmstackrecPtr;
+    SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>* smtmstackrecPtr;
     typename MultiContainer::iterator mcIter;
    public:
     iterator(void){smtmstackrecPtr=NULL;}
-    iterator(SmtMultiStackRec<HYPOTHESIS_REC>* smtmstackrec,
+    iterator(SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>* smtmstackrec,
              typename MultiContainer::iterator iter):smtmstackrecPtr(smtmstackrec)
       {
         mcIter=iter;
@@ -80,10 +86,10 @@ class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
     int operator!=(const iterator& right); 
     typename MultiContainer::iterator&
       operator->(void);
-    std::pair<EqClassType,SmtStack<HYPOTHESIS_REC> >
+    std::pair<EqClassType,SUBSTACK>
       operator*(void)const;
 
-    friend void SmtMultiStackRec<HYPOTHESIS_REC>::remove(SmtMultiStackRec<HYPOTHESIS_REC>::iterator iter);
+    friend void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::remove(SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator iter);
   };
  
       // iterator-related functions
@@ -91,10 +97,10 @@ class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
   iterator end(void);
 
       // basic functionality
-  typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator pushIter(const HYPOTHESIS_REC& hyp);
+  typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator pushIter(const HYPOTHESIS_REC& hyp);
   bool push(const HYPOTHESIS_REC& hyp);
   HYPOTHESIS_REC pop(void);
-  void remove(SmtMultiStackRec<HYPOTHESIS_REC>::iterator iter);
+  void remove(SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator iter);
   void removeLast(void);
   void clear(void);
 
@@ -104,7 +110,7 @@ class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
  protected:
 
   HypStateDict<HYPOTHESIS_REC>* hypStateDictPtr;
-  RecInfoMap recInfoMap;
+  RecInfoVec recInfoVec;
 
       // auxiliary functions
   bool pushOnSmtStack(typename MultiContainer::iterator pos,
@@ -118,9 +124,9 @@ class SmtMultiStackRec: public _smtMultiStack<HYPOTHESIS_REC>
 //--------------- SmtMultiStackRec template class function definitions
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator
-SmtMultiStackRec<HYPOTHESIS_REC>::pushIter(const HYPOTHESIS_REC& hyp)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator
+SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::pushIter(const HYPOTHESIS_REC& hyp)
 {
   EqClassType key;
   typename MultiContainer::iterator pos;	
@@ -131,9 +137,7 @@ SmtMultiStackRec<HYPOTHESIS_REC>::pushIter(const HYPOTHESIS_REC& hyp)
   if(pos==this->multiContainer.end())
   {
         // key not found, create new sub-stack
-    SmtStack<HYPOTHESIS_REC> smtStack;
-    smtStack.setMaxStackSize(this->maxStackSize);
-    pos=this->multiContainer.insert(std::make_pair(key,smtStack)).first;
+    pos=this->createSubstack(key);
     this->sortedStacksMap.insert(std::make_pair(key,pos));
   }
   prev_size=pos->second.size();
@@ -142,7 +146,7 @@ SmtMultiStackRec<HYPOTHESIS_REC>::pushIter(const HYPOTHESIS_REC& hyp)
   {
     if(prev_size==0)
       this->sortedStacksMap.insert(std::make_pair(key,pos));
-    typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator ret(this,pos);
+    typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator ret(this,pos);
     return ret;
   }
   else
@@ -157,8 +161,8 @@ SmtMultiStackRec<HYPOTHESIS_REC>::pushIter(const HYPOTHESIS_REC& hyp)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-bool SmtMultiStackRec<HYPOTHESIS_REC>::push(const HYPOTHESIS_REC& hyp)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+bool SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::push(const HYPOTHESIS_REC& hyp)
 {
   iterator smtmsiter;
 
@@ -168,8 +172,8 @@ bool SmtMultiStackRec<HYPOTHESIS_REC>::push(const HYPOTHESIS_REC& hyp)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-HYPOTHESIS_REC SmtMultiStackRec<HYPOTHESIS_REC>::pop(void)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+HYPOTHESIS_REC SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::pop(void)
 {
   HYPOTHESIS_REC result,aux;
   typename SortedStacksMap::iterator sortedStacksMapIter;
@@ -180,8 +184,7 @@ HYPOTHESIS_REC SmtMultiStackRec<HYPOTHESIS_REC>::pop(void)
   sortedStacksMapIter=this->sortedStacksMap.begin();
   pos=sortedStacksMapIter->second;
   posBest=pos;
-  result=pos->second.top();
-  bestScore=result.getScore();
+  bestScore=pos->second.topScore();
 
   if(!this->breadthFirst) 
   {
@@ -190,19 +193,17 @@ HYPOTHESIS_REC SmtMultiStackRec<HYPOTHESIS_REC>::pop(void)
     for(;sortedStacksMapIter!=this->sortedStacksMap.end();++sortedStacksMapIter) 
     {
       pos=sortedStacksMapIter->second;
-      aux=pos->second.top(); 
-      if(aux.getScore()>bestScore)
+      if(pos->second.topScore()>bestScore)
       {
-        result=aux;
-        bestScore=aux.getScore();
+        bestScore=pos->second.topScore();
         posBest=pos;
       }
     }
   }
-      // erase recombination info
-  eraseRecInfo(posBest->second.top().getHypState());
       // pop hypothesis
-  posBest->second.pop();
+  result=posBest->second.pop();
+      // erase recombination info
+  eraseRecInfo(result.getHypState());
   if(posBest->second.size()==0)
     this->sortedStacksMap.erase(posBest->first);
 
@@ -210,8 +211,8 @@ HYPOTHESIS_REC SmtMultiStackRec<HYPOTHESIS_REC>::pop(void)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-void SmtMultiStackRec<HYPOTHESIS_REC>::remove(SmtMultiStackRec<HYPOTHESIS_REC>::iterator iter)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::remove(SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator iter)
 {
   if(iter.smtmstackrecPtr==this)
   {
@@ -225,8 +226,8 @@ void SmtMultiStackRec<HYPOTHESIS_REC>::remove(SmtMultiStackRec<HYPOTHESIS_REC>::
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-void SmtMultiStackRec<HYPOTHESIS_REC>::removeLast(void)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::removeLast(void)
 {
   if(this->breadthFirst) 
   {
@@ -239,7 +240,7 @@ void SmtMultiStackRec<HYPOTHESIS_REC>::removeLast(void)
     --sortedStacksMapIter;
     pos=sortedStacksMapIter->second;
     posWorst=pos;
-    eraseRecInfo(posWorst->second.last().getHypState());
+    eraseRecInfo(posWorst->second.getHyp(posWorst->second.lastHandle()).getHypState());
     posWorst->second.removeLast();
     if(posWorst->second.size()==0)
       this->sortedStacksMap.erase(posWorst->first);
@@ -255,20 +256,20 @@ void SmtMultiStackRec<HYPOTHESIS_REC>::removeLast(void)
     sortedStacksMapIter=this->sortedStacksMap.begin();
     pos=sortedStacksMapIter->second;
     posWorst=pos;
-    worstScore=pos->second.last().getScore();
+    worstScore=pos->second.lastScore();
     
         // For each non-empty stack stored in the map (except the first
         // one)...
     for(;sortedStacksMapIter!=this->sortedStacksMap.end();++sortedStacksMapIter) 
     {
-      if(pos->second.last().getScore()>worstScore)
+      if(pos->second.lastScore()>worstScore)
       {
-        worstScore=pos->second.last().getScore();
+        worstScore=pos->second.lastScore();
         posWorst=pos;
       }
     }
         // erase recombination info
-    eraseRecInfo(posWorst->second.last().getHypState());
+    eraseRecInfo(posWorst->second.getHyp(posWorst->second.lastHandle()).getHypState());
         // remove last hypothesis
     posWorst->second.removeLast();
     if(posWorst->second.size()==0)
@@ -277,29 +278,30 @@ void SmtMultiStackRec<HYPOTHESIS_REC>::removeLast(void)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-void SmtMultiStackRec<HYPOTHESIS_REC>::setHypStateDictPtr(HypStateDict<HYPOTHESIS_REC>* _hypStateDictPtr)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::setHypStateDictPtr(HypStateDict<HYPOTHESIS_REC>* _hypStateDictPtr)
 {
   hypStateDictPtr=_hypStateDictPtr;
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-void SmtMultiStackRec<HYPOTHESIS_REC>::clear(void)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::clear(void)
 {
-  _smtMultiStack<HYPOTHESIS_REC>::clear();
-  recInfoMap.clear();
+  _smtMultiStack<HYPOTHESIS_REC,SUBSTACK>::clear();
+  recInfoVec.clear();
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-bool SmtMultiStackRec<HYPOTHESIS_REC>::pushOnSmtStack(typename MultiContainer::iterator pos,
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+bool SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::pushOnSmtStack(typename MultiContainer::iterator pos,
                                                       const HYPOTHESIS_REC& hyp)
 {
   typename HypStateDict<HYPOTHESIS_REC>::iterator hypStateDictIter;
   typename HYPOTHESIS_REC::HypState hypState;
 
-      // find hypothesis state in the hypothesis state dictionary
+      // find hypothesis state in the hypothesis state dictionary (the
+      // state is obtained only once)
   hypState=hyp.getHypState();
   hypStateDictIter=hypStateDictPtr->find(hypState);
   if(hypStateDictIter!=hypStateDictPtr->end() &&
@@ -320,7 +322,7 @@ bool SmtMultiStackRec<HYPOTHESIS_REC>::pushOnSmtStack(typename MultiContainer::i
     if(hypStateDictIter==hypStateDictPtr->end())
     {
           // create entry in hypothesis state dictionary
-      hypStateDictIter=hypStateDictPtr->createDictEntry(hyp);
+      hypStateDictIter=hypStateDictPtr->createDictEntry(hyp,hypState);
     }
     else
     {
@@ -336,54 +338,47 @@ bool SmtMultiStackRec<HYPOTHESIS_REC>::pushOnSmtStack(typename MultiContainer::i
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC>
-bool SmtMultiStackRec<HYPOTHESIS_REC>::pushOnSmtStackIdx(typename MultiContainer::iterator pos,
+template<class HYPOTHESIS_REC,class SUBSTACK>
+bool SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::pushOnSmtStackIdx(typename MultiContainer::iterator pos,
                                                          const HYPOTHESIS_REC& hyp,
                                                          HypStateIndex hypStateIndex)
 {
-  typename RecInfoMap::iterator recInfoMapIter;
-  typename SmtStack<HYPOTHESIS_REC>::iterator smtStackIter;
+  SUBSTACK& smtStack=pos->second;
 
-      // retrieve pointer to hypothesis in recInfoMap
-  recInfoMapIter=recInfoMap.find(hypStateIndex);
-  if(recInfoMapIter!=recInfoMap.end())
+      // retrieve handle of hypothesis in recInfoVec
+  if(hypStateIndex>=recInfoVec.size())
+    recInfoVec.resize(hypStateIndex+1,std::make_pair((SUBSTACK*)NULL,HypHandle()));
+  else
   {
-        // remove hypothesis with lower score (recInfoMap entry is
-        // also removed)
-    pos->second.remove(recInfoMapIter->second);
-    recInfoMapIter=recInfoMap.end();
+        // remove hypothesis with lower score if it is stored in the
+        // same stack (recInfoVec entry is overwritten below)
+    if(recInfoVec[hypStateIndex].first==&smtStack)
+      smtStack.remove(recInfoVec[hypStateIndex].second);
   }
 
-      // Keep last hypothesis of the container, and the size of the
-      // container before the insertion
-  HYPOTHESIS_REC lastHyp;
-  if(!pos->second.empty()) lastHyp=pos->second.last();
-  size_t prev_stack_size=pos->second.size();
+      // Keep state of the last hypothesis of the container if it may
+      // be pruned, and the size of the container before the insertion
+  typename HYPOTHESIS_REC::HypState lastHypState;
+  size_t prev_stack_size=smtStack.size();
+  if(prev_stack_size>0 && prev_stack_size>=smtStack.getMaxStackSize())
+    lastHypState=smtStack.getHyp(smtStack.lastHandle()).getHypState();
 
       // insert hypothesis into the stack
-  smtStackIter=pos->second.pushIter(hyp);
-  if(smtStackIter!=pos->second.end())
+  HypHandle handle=smtStack.pushHandle(hyp);
+  if(handle!=smtStack.nullHandle())
   {
-        // If hyp was inserted, update pointer to hypothesis in
-        // recInfoMap
-    if(recInfoMapIter!=recInfoMap.end())
-    {
-      recInfoMapIter->second=smtStackIter;
-    }
-    else
-    {
-      recInfoMap[hypStateIndex]=smtStackIter;
-    }
+        // If hyp was inserted, update handle of hypothesis in
+        // recInfoVec
+    recInfoVec[hypStateIndex]=std::make_pair(&smtStack,handle);
+
         // If stack was pruned due to its size, delete the
-        // corresponding entry in recInfoMap
-    if(prev_stack_size==pos->second.size())
+        // corresponding entry in recInfoVec
+    if(prev_stack_size==smtStack.size())
     {
 #     ifdef THOT_STATS
         ++this->discardedPushOpsDueToSize;
 #     endif
-      HypStateIndex hypStateIndex=hypStateDictPtr->find(lastHyp.getHypState())->second.hypStateIndex;
-
-      recInfoMap.erase(hypStateIndex);
+      eraseRecInfo(lastHypState);
     }
     return true;
   }
@@ -399,37 +394,38 @@ bool SmtMultiStackRec<HYPOTHESIS_REC>::pushOnSmtStackIdx(typename MultiContainer
 }
 
 //---------------------------------------
-template<class HYPOTHESIS_REC> 
-void SmtMultiStackRec<HYPOTHESIS_REC>::eraseRecInfo(const typename HYPOTHESIS_REC::HypState& hypState)
+template<class HYPOTHESIS_REC,class SUBSTACK> 
+void SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::eraseRecInfo(const typename HYPOTHESIS_REC::HypState& hypState)
 {
   HypStateIndex hypStateIndex;
   hypStateIndex=hypStateDictPtr->find(hypState)->second.hypStateIndex;
-  recInfoMap.erase(hypStateIndex);
+  if(hypStateIndex<recInfoVec.size())
+    recInfoVec[hypStateIndex].first=NULL;
 }
 
 //--------------------------
-template<class HYPOTHESIS_REC>
-typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator
-SmtMultiStackRec<HYPOTHESIS_REC>::begin(void)
+template<class HYPOTHESIS_REC,class SUBSTACK>
+typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator
+SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::begin(void)
 {
- typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator iter(this,this->multiContainer.begin());
+ typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator iter(this,this->multiContainer.begin());
 	
  return iter;
 }
 //--------------------------
-template<class HYPOTHESIS_REC>
-typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator
-SmtMultiStackRec<HYPOTHESIS_REC>::end(void)
+template<class HYPOTHESIS_REC,class SUBSTACK>
+typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator
+SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::end(void)
 {
- typename SmtMultiStackRec<HYPOTHESIS_REC>::iterator iter(this,this->multiContainer.end());
+ typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator iter(this,this->multiContainer.end());
 	
  return iter;
 }
 
 // Iterator function definitions
 //--------------------------
-template<class HYPOTHESIS_REC>
-bool SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator++(void) //prefix
+template<class HYPOTHESIS_REC,class SUBSTACK>
+bool SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator++(void) //prefix
 {
  if(smtmstackrecPtr!=NULL)
  {
@@ -443,39 +439,39 @@ bool SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator++(void) //prefix
  else return false;
 }
 //--------------------------
-template<class HYPOTHESIS_REC>
-bool SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator++(int)  //postfix
+template<class HYPOTHESIS_REC,class SUBSTACK>
+bool SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator++(int)  //postfix
 {
  return operator++();
 }
 
 //--------------------------
-template<class HYPOTHESIS_REC>
-int SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator==(const iterator& right)
+template<class HYPOTHESIS_REC,class SUBSTACK>
+int SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator==(const iterator& right)
 {
   if(smtmstackrecPtr==right.smtmstackrecPtr && mcIter==right.mcIter) return true;
   else return false;
 }
 
 //--------------------------
-template<class HYPOTHESIS_REC>
-int SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator!=(const iterator& right)
+template<class HYPOTHESIS_REC,class SUBSTACK>
+int SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator!=(const iterator& right)
 {
  return !((*this)==right);	
 }
 
 //--------------------------
-template<class HYPOTHESIS_REC>
-typename SmtMultiStackRec<HYPOTHESIS_REC>::MultiContainer::iterator&
-SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator->(void)
+template<class HYPOTHESIS_REC,class SUBSTACK>
+typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::MultiContainer::iterator&
+SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator->(void)
 {
   return mcIter;
 }
 
 //--------------------------
-template<class HYPOTHESIS_REC>
-std::pair<typename SmtMultiStackRec<HYPOTHESIS_REC>::EqClassType,SmtStack<HYPOTHESIS_REC> >
-SmtMultiStackRec<HYPOTHESIS_REC>::iterator::operator*(void)const
+template<class HYPOTHESIS_REC,class SUBSTACK>
+std::pair<typename SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::EqClassType,SUBSTACK >
+SmtMultiStackRec<HYPOTHESIS_REC,SUBSTACK>::iterator::operator*(void)const
 {
    return *mcIter;
 }
@@ -32,6 +32,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #  include <thot_config.h>
 #endif /* HAVE_CONFIG_H */
 
+#include <vector>
+#include "Score.h"
 #include "_smtStack.h"
 
 //--------------- Constants ------------------------------------------
@@ -50,6 +52,7 @@ class SmtStack: public _smtStack<HYPOTHESIS>
  public:
 
   typedef typename _smtStack<HYPOTHESIS>::Container Container;
+  typedef typename Container::iterator HypHandle;
 
       // iterator
   class iterator;
@@ -89,6 +92,23 @@ class SmtStack: public _smtStack<HYPOTHESIS>
   HYPOTHESIS pop(void);
   void remove(SmtStack<HYPOTHESIS>::iterator iter);
   void removeLast(void);
+
+      // handle-based interface (the same one provided by
+      // SmtHeapStack), handles remain valid until the hypothesis is
+      // removed
+  HypHandle pushHandle(const HYPOTHESIS& hyp);
+      // push hyp into the stack. pushHandle returns nullHandle() if
+      // the hyp was not finally pushed into the stack
+  HypHandle nullHandle(void);
+  void remove(HypHandle handle);
+  HypHandle topHandle(void)const;
+  HypHandle lastHandle(void)const;
+  Score topScore(void)const;
+  Score lastScore(void)const;
+  const HYPOTHESIS& getHyp(HypHandle handle)const;
+  void getSortedHandles(std::vector<HypHandle>& handleVec)const;
+      // Obtain handles of the stored hypotheses sorted from best to
+      // worst
   
  protected:
 
@@ -101,7 +121,16 @@ class SmtStack: public _smtStack<HYPOTHESIS>
 template<class HYPOTHESIS> 
 typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::pushIter(const HYPOTHESIS& hyp)
 {
-  if(this->maxStackSize==0) return end();
+  typename SmtStack<HYPOTHESIS>::iterator ret(this,pushHandle(hyp));
+  return ret;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtStack<HYPOTHESIS>::HypHandle
+SmtStack<HYPOTHESIS>::pushHandle(const HYPOTHESIS& hyp)
+{
+  if(this->maxStackSize==0) return nullHandle();
   else
   {
     HYPOTHESIS hyplast;
@@ -120,7 +149,7 @@ typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::pushIter(const HYP
         ++this->discardedPushOpsDueToSize;
 #      endif
 
-        return end();
+        return nullHandle();
       }
       else
       {
@@ -128,7 +157,6 @@ typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::pushIter(const HYP
         typename Container::iterator msetIt;
         
         msetIt=this->container.insert(hyp);
-        typename SmtStack<HYPOTHESIS>::iterator ret(this,msetIt);
         if(this->container.size()>this->maxStackSize)
         {
           removeLast();
@@ -136,7 +164,7 @@ typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::pushIter(const HYP
           ++this->discardedPushOpsDueToSize;
 #        endif
         }
-        return ret;
+        return msetIt;
       }
     }
     else
@@ -145,9 +173,8 @@ typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::pushIter(const HYP
       typename Container::iterator msetIt;
     
       msetIt=this->container.insert(hyp);
-      typename SmtStack<HYPOTHESIS>::iterator ret(this,msetIt);
       if(this->container.size()>this->maxStackSize) removeLast();
-      return ret;
+      return msetIt;
     }
   }
 }
@@ -200,6 +227,71 @@ void SmtStack<HYPOTHESIS>::removeLast(void)
   }  
 }
 
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtStack<HYPOTHESIS>::HypHandle
+SmtStack<HYPOTHESIS>::nullHandle(void)
+{
+  return this->container.end();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtStack<HYPOTHESIS>::remove(HypHandle handle)
+{
+  this->container.erase(handle);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtStack<HYPOTHESIS>::HypHandle
+SmtStack<HYPOTHESIS>::topHandle(void)const
+{
+  return this->container.begin();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+typename SmtStack<HYPOTHESIS>::HypHandle
+SmtStack<HYPOTHESIS>::lastHandle(void)const
+{
+  typename Container::iterator pos=this->container.end();
+  --pos;
+  return pos;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+Score SmtStack<HYPOTHESIS>::topScore(void)const
+{
+  return topHandle()->getScore();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+Score SmtStack<HYPOTHESIS>::lastScore(void)const
+{
+  return lastHandle()->getScore();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+const HYPOTHESIS& SmtStack<HYPOTHESIS>::getHyp(HypHandle handle)const
+{
+  return *handle;
+}
+
+//---------------------------------------
+template<class HYPOTHESIS> 
+void SmtStack<HYPOTHESIS>::getSortedHandles(std::vector<HypHandle>& handleVec)const
+{
+  typename Container::iterator pos;
+
+  handleVec.clear();
+  for(pos=this->container.begin();pos!=this->container.end();++pos)
+    handleVec.push_back(pos);
+}
+
 //--------------------------
 template<class HYPOTHESIS>
 typename SmtStack<HYPOTHESIS>::iterator SmtStack<HYPOTHESIS>::begin(void)
@@ -29,7 +29,10 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- StdFeatureHandler class functions
 
 StdFeatureHandler::StdFeatureHandler()
-{  
+{
+  trainSwAligModelPtr=NULL;
+  trainInvSwAligModelPtr=NULL;
+  inPlaceOnlineTrain=false;
 }
 
 //---------------
@@ -203,8 +206,28 @@ int StdFeatureHandler::updatePmLinInterpWeights(std::string srcCorpusFileName,
 int StdFeatureHandler::onlineTrainFeats(OnlineTrainingPars onlineTrainingPars,
                                         std::string srcSent,
                                         std::string refSent,
-                                        std::string /*sysSent*/,
+                                        std::string sysSent,
                                         int verbose/*=0*/)
+{
+  int ret=obtainOnlineTrainDelta(onlineTrainingPars,srcSent,refSent,sysSent,verbose);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+  ret=publishOnlineTrainDelta(verbose);
+
+      // Copies are synchronized even if the delta could not be
+      // completely applied, since the single-word models were swapped
+  syncOnlineTrainCopies(verbose);
+
+  return ret;
+}
+
+//---------------
+int StdFeatureHandler::obtainOnlineTrainDelta(OnlineTrainingPars onlineTrainingPars,
+                                              std::string srcSent,
+                                              std::string refSent,
+                                              std::string /*sysSent*/,
+                                              int verbose/*=0*/)
 {
        // Check if input sentences are empty
   if(srcSent.size()==0 || refSent.size()==0)
@@ -213,6 +236,17 @@ int StdFeatureHandler::onlineTrainFeats(OnlineTrainingPars onlineTrainingPars,
     return THOT_ERROR;
   }
 
+      // Check state of previous delta
+  if(onlineTrainingDelta.published)
+  {
+    syncOnlineTrainCopies(verbose);
+  }
+  else if(onlineTrainingDelta.obtained)
+  {
+    std::cerr<<"Error: previous online training delta has not been published"<<std::endl;
+    return THOT_ERROR;
+  }
+
       // Train pair according to chosen algorithm
   switch(onlineTrainingPars.onlineLearningAlgorithm)
   {
@@ -232,34 +266,137 @@ int StdFeatureHandler::onlineTrainFeats(OnlineTrainingPars onlineTrainingPars,
   } 
 }
 
+//---------------
+int StdFeatureHandler::publishOnlineTrainDelta(int verbose/*=0*/)
+{
+  if(!onlineTrainingDelta.obtained || onlineTrainingDelta.published)
+    return THOT_OK;
+
+      // Train single-word models in place if they could not be copied
+  DirectPhraseModelFeat<SmtModel::HypScoreInfo>* dirPmFeatPtr=getDirectPhraseModelFeatPtr(swModelsInfo.featNameVec[0]);
+  InversePhraseModelFeat<SmtModel::HypScoreInfo>* invPmFeatPtr=getInversePhraseModelFeatPtr(swModelsInfo.invFeatNameVec[0]);
+  if(inPlaceOnlineTrain)
+  {
+    trainAligModel(dirPmFeatPtr->get_swmptr(),
+                   invPmFeatPtr->get_swmptr(),
+                   onlineTrainingDelta.onlineTrainingPars,
+                   verbose);
+  }
+
+      // Train language model
+  int ret=trainLangModel(langModelsInfo.lModelPtrVec[0],onlineTrainingDelta.onlineTrainingPars.learnStepSize,onlineTrainingDelta.refSentStrVec,verbose);
+
+      // Add new translation options
+  updatePhrModelVoc(dirPmFeatPtr->get_pmptr());
+  if(verbose) std::cerr<<"Adding new translation options..."<<std::endl;
+  int transOptsRet=addNewTransOpts(dirPmFeatPtr->get_pmptr(),verbose);
+
+      // Swap single-word models with their trained copies
+  if(!inPlaceOnlineTrain)
+  {
+    BaseSwAligModel<PpInfo>* swAligModelPtr=dirPmFeatPtr->get_swmptr();
+    BaseSwAligModel<PpInfo>* invSwAligModelPtr=invPmFeatPtr->get_swmptr();
+    dirPmFeatPtr->link_swm(trainSwAligModelPtr);
+    invPmFeatPtr->link_swm(trainInvSwAligModelPtr);
+    swModelsInfo.swAligModelPtrVec[0]=trainSwAligModelPtr;
+    swModelsInfo.invSwAligModelPtrVec[0]=trainInvSwAligModelPtr;
+    trainSwAligModelPtr=swAligModelPtr;
+    trainInvSwAligModelPtr=invSwAligModelPtr;
+  }
+
+  onlineTrainingDelta.published=true;
+
+  if(ret==THOT_ERROR || transOptsRet==THOT_ERROR)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+}
+
+//---------------
+int StdFeatureHandler::syncOnlineTrainCopies(int verbose/*=0*/)
+{
+  if(!onlineTrainingDelta.published)
+    return THOT_OK;
+
+      // Repeat training on the single-word models that were swapped out
+  if(!inPlaceOnlineTrain)
+  {
+    if(verbose) std::cerr<<"Synchronizing copies of single-word models..."<<std::endl;
+    retrainAligModel(trainSwAligModelPtr,trainInvSwAligModelPtr,verbose);
+  }
+
+  onlineTrainingDelta.clear();
+
+  return THOT_OK;
+}
+
 //---------------------------------
 int StdFeatureHandler::incrTrainFeatsSentPair(OnlineTrainingPars onlineTrainingPars,
                                               std::string srcSent,
                                               std::string refSent,
                                               int verbose/*=0*/)
 {
+      // Create copies of the single-word models the first time they
+      // are required
+  if(!inPlaceOnlineTrain && (trainSwAligModelPtr==NULL || trainInvSwAligModelPtr==NULL))
+  {
+    int ret=createSwModelCopies(verbose);
+    if(ret==THOT_ERROR)
+      return THOT_ERROR;
+  }
+
       // Break input strings into word vectors
-  std::vector<std::string> srcSentStrVec=StrProcUtils::stringToStringVector(srcSent);
-  std::vector<std::string> refSentStrVec=StrProcUtils::stringToStringVector(refSent);
+  onlineTrainingDelta.clear();
+  onlineTrainingDelta.srcSentStrVec=StrProcUtils::stringToStringVector(srcSent);
+  onlineTrainingDelta.refSentStrVec=StrProcUtils::stringToStringVector(refSent);
+  onlineTrainingDelta.onlineTrainingPars=onlineTrainingPars;
+
+      // Train copies of the alignment models and obtain new translation
+      // options. Models without copies are trained when the delta is
+      // published
+  if(!inPlaceOnlineTrain)
+  {
+    trainAligModel(trainSwAligModelPtr,
+                   trainInvSwAligModelPtr,
+                   onlineTrainingPars,
+                   verbose);
+  }
 
-      // Train language model
-  int ret=trainLangModel(langModelsInfo.lModelPtrVec[0],onlineTrainingPars.learnStepSize,refSentStrVec,verbose);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
-  
-      // Train alignment model
-  DirectPhraseModelFeat<SmtModel::HypScoreInfo>* dirPmFeatPtr=getDirectPhraseModelFeatPtr(swModelsInfo.featNameVec[0]);
-  InversePhraseModelFeat<SmtModel::HypScoreInfo>* invPmFeatPtr=getInversePhraseModelFeatPtr(swModelsInfo.invFeatNameVec[0]);
-  ret=trainAligModel(dirPmFeatPtr->get_pmptr(),
-                     dirPmFeatPtr->get_swmptr(),
-                     invPmFeatPtr->get_swmptr(),
-                     onlineTrainingPars,
-                     srcSentStrVec,
-                     refSentStrVec,
-                     verbose);
-  if(ret==THOT_ERROR)
+  onlineTrainingDelta.obtained=true;
+
+  return THOT_OK;
+}
+
+//---------------
+int StdFeatureHandler::createSwModelCopies(int verbose/*=0*/)
+{
+  if(swModelsInfo.swAligModelPtrVec.empty() || swModelsInfo.invSwAligModelPtrVec.empty())
+  {
+    std::cerr<<"Error: single word models are not loaded"<<std::endl;
     return THOT_ERROR;
+  }
 
+      // Copies are obtained from the single-word models of the first
+      // phrase model feature, which are only modified by online
+      // training
+  if(trainSwAligModelPtr==NULL)
+    trainSwAligModelPtr=swModelsInfo.swAligModelPtrVec[0]->clone();
+  if(trainInvSwAligModelPtr==NULL)
+    trainInvSwAligModelPtr=swModelsInfo.invSwAligModelPtrVec[0]->clone();
+
+  if(trainSwAligModelPtr==NULL || trainInvSwAligModelPtr==NULL)
+  {
+        // Models cannot be copied (e.g. their parameters are stored in a
+        // database that cannot be opened twice), they are trained in
+        // place while translation requests are stalled
+    if(verbose) std::cerr<<"Single-word models cannot be copied, they will be trained in place"<<std::endl;
+    delete trainSwAligModelPtr;
+    trainSwAligModelPtr=NULL;
+    delete trainInvSwAligModelPtr;
+    trainInvSwAligModelPtr=NULL;
+    inPlaceOnlineTrain=true;
+  }
+  
   return THOT_OK;
 }
 
@@ -304,25 +441,23 @@ int StdFeatureHandler::trainLangModel(BaseNgramLM<LM_State>* lModelPtr,
 }
 
 //---------------
-int StdFeatureHandler::trainAligModel(BasePhraseModel* invPbModelPtr,
-                                      BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                      BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                      OnlineTrainingPars onlineTrainingPars,
-                                      std::vector<std::string> srcSentStrVec,
-                                      std::vector<std::string> refSentStrVec,
-                                      int verbose/*=0*/)
+void StdFeatureHandler::trainAligModel(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                                       BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                                       OnlineTrainingPars onlineTrainingPars,
+                                       int verbose/*=0*/)
 {
       // Revise vocabularies of the alignment models
-  updateAligModelsSrcVoc(invPbModelPtr,swAligModelPtr,invSwAligModelPtr,srcSentStrVec);
-  updateAligModelsTrgVoc(invPbModelPtr,swAligModelPtr,invSwAligModelPtr,refSentStrVec);
+  updateAligModelsVoc(swAligModelPtr,
+                      invSwAligModelPtr,
+                      onlineTrainingDelta.srcWordIdxVec,
+                      onlineTrainingDelta.refWordIdxVec);
 
       // Add sentence pair to the single word models
   std::pair<unsigned int,unsigned int> sentRange;
-  swAligModelPtr->addSentPair(srcSentStrVec,refSentStrVec,onlineTrainingPars.learnStepSize,sentRange);
-  invSwAligModelPtr->addSentPair(refSentStrVec,srcSentStrVec,onlineTrainingPars.learnStepSize,sentRange);
+  swAligModelPtr->addSentPair(onlineTrainingDelta.srcSentStrVec,onlineTrainingDelta.refSentStrVec,onlineTrainingPars.learnStepSize,sentRange);
+  invSwAligModelPtr->addSentPair(onlineTrainingDelta.refSentStrVec,onlineTrainingDelta.srcSentStrVec,onlineTrainingPars.learnStepSize,sentRange);
 
       // Iterate over E_par interlaced samples
-  int ret=THOT_OK;
   unsigned int curr_sample=sentRange.second;
   unsigned int oldest_sample=curr_sample-onlineTrainingPars.R_par;
   for(unsigned int i=1;i<=onlineTrainingPars.E_par;++i)
@@ -341,9 +476,11 @@ int StdFeatureHandler::trainAligModel(BasePhraseModel* invPbModelPtr,
       if(verbose) std::cerr<<"Training inverse single-word model..."<<std::endl;
       invSwAligModelPtr->trainSentPairRange(std::make_pair(n,n),verbose);
 
-          // Add new translation options
-      if(verbose) std::cerr<<"Adding new translation options..."<<std::endl;
-      ret=addNewTransOpts(invPbModelPtr,swAligModelPtr,invSwAligModelPtr,n,verbose);
+      onlineTrainingDelta.trainedSampleVec.push_back(n);
+
+          // Obtain new translation options
+      if(verbose) std::cerr<<"Obtaining new translation options..."<<std::endl;
+      obtainNewTransOpts(swAligModelPtr,invSwAligModelPtr,n,verbose);
     }
   }
 
@@ -356,128 +493,148 @@ int StdFeatureHandler::trainAligModel(BasePhraseModel* invPbModelPtr,
     if(idx_to_discard>0 && vecVecInvPhPair.size()>(unsigned int)idx_to_discard)
       vecVecInvPhPair[idx_to_discard].clear();
   }
-
-  return ret;
 }
 
 //---------------
-void StdFeatureHandler::updateAligModelsSrcVoc(BasePhraseModel* invPbModelPtr,
-                                               BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                               BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                               std::vector<std::string> srcSentStrVec)
+void StdFeatureHandler::retrainAligModel(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                                         BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                                         int verbose/*=0*/)
 {
-  for(unsigned int i=0;i<srcSentStrVec.size();++i)
+      // Repeat the updates performed by trainAligModel() in the same
+      // order, so both models end in the same state
+  std::vector<WordIndex> srcWordIdxVec;
+  std::vector<WordIndex> refWordIdxVec;
+  updateAligModelsVoc(swAligModelPtr,invSwAligModelPtr,srcWordIdxVec,refWordIdxVec);
+
+  std::pair<unsigned int,unsigned int> sentRange;
+  swAligModelPtr->addSentPair(onlineTrainingDelta.srcSentStrVec,onlineTrainingDelta.refSentStrVec,onlineTrainingDelta.onlineTrainingPars.learnStepSize,sentRange);
+  invSwAligModelPtr->addSentPair(onlineTrainingDelta.refSentStrVec,onlineTrainingDelta.srcSentStrVec,onlineTrainingDelta.onlineTrainingPars.learnStepSize,sentRange);
+
+  for(unsigned int i=0;i<onlineTrainingDelta.trainedSampleVec.size();++i)
   {
-    addSrcSymbolToAligModels(invPbModelPtr,swAligModelPtr,invSwAligModelPtr,srcSentStrVec[i]);
+    unsigned int n=onlineTrainingDelta.trainedSampleVec[i];
+    swAligModelPtr->trainSentPairRange(std::make_pair(n,n),verbose);
+    invSwAligModelPtr->trainSentPairRange(std::make_pair(n,n),verbose);
   }
 }
 
 //---------------
-void StdFeatureHandler::updateAligModelsTrgVoc(BasePhraseModel* invPbModelPtr,
-                                               BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                               BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                               std::vector<std::string> trgSentStrVec)
+void StdFeatureHandler::updateAligModelsVoc(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                                            BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                                            std::vector<WordIndex>& srcWordIdxVec,
+                                            std::vector<WordIndex>& refWordIdxVec)
 {
-  for(unsigned int i=0;i<trgSentStrVec.size();++i)
+  srcWordIdxVec.clear();
+  for(unsigned int i=0;i<onlineTrainingDelta.srcSentStrVec.size();++i)
   {
-    addTrgSymbolToAligModels(invPbModelPtr,swAligModelPtr,invSwAligModelPtr,trgSentStrVec[i]);
+    WordIndex windex_lex=swAligModelPtr->addSrcSymbol(onlineTrainingDelta.srcSentStrVec[i]);
+    WordIndex windex_ilex=invSwAligModelPtr->addTrgSymbol(onlineTrainingDelta.srcSentStrVec[i]);
+    if(windex_lex!=windex_ilex)
+      std::cerr<<"Warning! direct and inverse lexical model vocabularies are now different."<<std::endl;
+    srcWordIdxVec.push_back(windex_lex);
+  }
+
+  refWordIdxVec.clear();
+  for(unsigned int i=0;i<onlineTrainingDelta.refSentStrVec.size();++i)
+  {
+    WordIndex windex_lex=swAligModelPtr->addTrgSymbol(onlineTrainingDelta.refSentStrVec[i]);
+    WordIndex windex_ilex=invSwAligModelPtr->addSrcSymbol(onlineTrainingDelta.refSentStrVec[i]);
+    if(windex_lex!=windex_ilex)
+      std::cerr<<"Warning! direct and inverse lexical model vocabularies are now different."<<std::endl;
+    refWordIdxVec.push_back(windex_lex);
   }
 }
 
 //---------------
-WordIndex StdFeatureHandler::addSrcSymbolToAligModels(BasePhraseModel* invPbModelPtr,
-                                                      BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                                      BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                                      std::string s)
+void StdFeatureHandler::updatePhrModelVoc(BasePhraseModel* invPbModelPtr)
 {
-  WordIndex windex_ipbm=invPbModelPtr->addTrgSymbol(s);
-  WordIndex windex_lex=swAligModelPtr->addSrcSymbol(s);
-  WordIndex windex_ilex=invSwAligModelPtr->addTrgSymbol(s);
-  if(windex_ipbm!=windex_lex || windex_ipbm!=windex_ilex)
+  for(unsigned int i=0;i<onlineTrainingDelta.srcSentStrVec.size();++i)
   {
-    std::cerr<<"Warning! phrase-based model vocabularies are now different from lexical model vocabularies."<<std::endl;
+    WordIndex windex_ipbm=invPbModelPtr->addTrgSymbol(onlineTrainingDelta.srcSentStrVec[i]);
+    if(windex_ipbm!=onlineTrainingDelta.srcWordIdxVec[i])
+      std::cerr<<"Warning! phrase-based model vocabularies are now different from lexical model vocabularies."<<std::endl;
+  }
+
+  for(unsigned int i=0;i<onlineTrainingDelta.refSentStrVec.size();++i)
+  {
+    WordIndex windex_ipbm=invPbModelPtr->addSrcSymbol(onlineTrainingDelta.refSentStrVec[i]);
+    if(windex_ipbm!=onlineTrainingDelta.refWordIdxVec[i])
+      std::cerr<<"Warning! phrase-based model vocabularies are now different from lexical model vocabularies."<<std::endl;
   }
-  
-  return windex_ipbm;
 }
 
 //---------------
-WordIndex StdFeatureHandler::addTrgSymbolToAligModels(BasePhraseModel* invPbModelPtr,
-                                                      BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                                      BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                                      std::string t)
+void StdFeatureHandler::obtainNewTransOpts(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                                           BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                                           int n,
+                                           int verbose/*=0*/)
 {
-  WordIndex windex_ipbm=invPbModelPtr->addSrcSymbol(t);
-  WordIndex windex_lex=swAligModelPtr->addTrgSymbol(t);
-  WordIndex windex_ilex=invSwAligModelPtr->addSrcSymbol(t);
-  if(windex_ipbm!=windex_lex || windex_ipbm!=windex_ilex)
+      // Obtain sentence pair
+  std::vector<std::string> srcSentStrVec;
+  std::vector<std::string> refSentStrVec;
+  Count c;
+  swAligModelPtr->nthSentPair(n,srcSentStrVec,refSentStrVec,c);
+
+      // Extract consistent phrase pairs
+  std::vector<PhrasePair> vecUnfiltInvPhPair;
+  PhraseExtractUtils::extractConsistentPhrasePairs(invSwAligModelPtr,swAligModelPtr,refSentStrVec,srcSentStrVec,vecUnfiltInvPhPair,verbose);
+
+      // Filter phrase pairs
+  std::vector<PhrasePair> vecInvPhPair;
+  PhraseExtractUtils::filterPhrasePairs(vecUnfiltInvPhPair,vecInvPhPair);
+
+      // Obtain mapped_n
+  unsigned int mapped_n=map_n_am_suff_stats(n);
+  
+      // Grow vecVecInvPhPair if necessary
+  std::vector<PhrasePair> vpp;
+  while(vecVecInvPhPair.size()<=mapped_n) vecVecInvPhPair.push_back(vpp);
+    
+      // Subtract current phrase model sufficient statistics
+  for(unsigned int i=0;i<vecVecInvPhPair[mapped_n].size();++i)
+  {
+    onlineTrainingDelta.invPhPairVec.push_back(vecVecInvPhPair[mapped_n][i]);
+    onlineTrainingDelta.invPhPairIncrVec.push_back(-1);
+  }
+
+      // Add new phrase model current sufficient statistics
+  if(verbose) std::cerr<<"List of extracted consistent phrase pairs:"<<std::endl;
+  for(unsigned int i=0;i<vecInvPhPair.size();++i)
   {
-    std::cerr<<"Warning! phrase-based model vocabularies are now different from lexical model vocabularies."<<std::endl;
+    onlineTrainingDelta.invPhPairVec.push_back(vecInvPhPair[i]);
+    onlineTrainingDelta.invPhPairIncrVec.push_back(1);
+    if(verbose)
+    {
+      for(unsigned int j=0;j<vecInvPhPair[i].s_.size();++j) std::cerr<<vecInvPhPair[i].s_[j]<<" ";
+      std::cerr<<"|||";
+      for(unsigned int j=0;j<vecInvPhPair[i].t_.size();++j) std::cerr<<" "<<vecInvPhPair[i].t_[j];
+      std::cerr<<std::endl;
+    }
   }
   
-  return windex_ipbm;
+      // Store new phrase model current sufficient statistics
+  vecVecInvPhPair[mapped_n]=vecInvPhPair;
 }
 
 //---------------
 int StdFeatureHandler::addNewTransOpts(BasePhraseModel* invPbModelPtr,
-                                       BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                       BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                       int n,
-                                       int verbose/*=0*/)
+                                       int /*verbose=0*/)
 {
+  if(onlineTrainingDelta.trainedSampleVec.empty())
+    return THOT_OK;
+  
       // Check if the phrase model is incremental (otherwise, it is not
       // possible to add new translation options)
   BaseIncrPhraseModel* baseIncrPhraseModelPtr=dynamic_cast<BaseIncrPhraseModel* >(invPbModelPtr);
   if(baseIncrPhraseModelPtr)
   {
-        // Obtain sentence pair
-    std::vector<std::string> srcSentStrVec;
-    std::vector<std::string> refSentStrVec;
-    Count c;
-    swAligModelPtr->nthSentPair(n,srcSentStrVec,refSentStrVec,c);
-
-        // Extract consistent phrase pairs
-    std::vector<PhrasePair> vecUnfiltInvPhPair;
-    PhraseExtractUtils::extractConsistentPhrasePairs(invSwAligModelPtr,swAligModelPtr,refSentStrVec,srcSentStrVec,vecUnfiltInvPhPair,verbose);
-
-        // Filter phrase pairs
-    std::vector<PhrasePair> vecInvPhPair;
-    PhraseExtractUtils::filterPhrasePairs(vecUnfiltInvPhPair,vecInvPhPair);
-
-        // Obtain mapped_n
-    unsigned int mapped_n=map_n_am_suff_stats(n);
-  
-        // Grow vecVecInvPhPair if necessary
-    std::vector<PhrasePair> vpp;
-    while(vecVecInvPhPair.size()<=mapped_n) vecVecInvPhPair.push_back(vpp);
-    
-        // Subtract current phrase model sufficient statistics
-    for(unsigned int i=0;i<vecVecInvPhPair[mapped_n].size();++i)
+        // Apply increments in the counts of phrase model entries
+    for(unsigned int i=0;i<onlineTrainingDelta.invPhPairVec.size();++i)
     {
-      baseIncrPhraseModelPtr->strIncrCountsOfEntry(vecVecInvPhPair[mapped_n][i].s_,
-                                                   vecVecInvPhPair[mapped_n][i].t_,
-                                                   -1);
+      baseIncrPhraseModelPtr->strIncrCountsOfEntry(onlineTrainingDelta.invPhPairVec[i].s_,
+                                                   onlineTrainingDelta.invPhPairVec[i].t_,
+                                                   onlineTrainingDelta.invPhPairIncrVec[i]);
     }
-
-        // Add new phrase model current sufficient statistics
-    if(verbose) std::cerr<<"List of extracted consistent phrase pairs:"<<std::endl;
-    for(unsigned int i=0;i<vecInvPhPair.size();++i)
-    {
-      baseIncrPhraseModelPtr->strIncrCountsOfEntry(vecInvPhPair[i].s_,
-                                                   vecInvPhPair[i].t_,
-                                                   1);
-      if(verbose)
-      {
-        for(unsigned int j=0;j<vecInvPhPair[i].s_.size();++j) std::cerr<<vecInvPhPair[i].s_[j]<<" ";
-        std::cerr<<"|||";
-        for(unsigned int j=0;j<vecInvPhPair[i].t_.size();++j) std::cerr<<" "<<vecInvPhPair[i].t_[j];
-        std::cerr<<std::endl;
-      }
-    }
-  
-        // Store new phrase model current sufficient statistics
-    vecVecInvPhPair[mapped_n]=vecInvPhPair;
-
     return THOT_OK;
   }
   else
@@ -565,9 +722,9 @@ int StdFeatureHandler::setDefaultSingleWordSoFile(std::string soFileName)
 }
 
 //--------------------------
-BasePhraseModel* StdFeatureHandler::createPmPtr(std::string soFileName)
+BasePhraseModel* StdFeatureHandler::createPmPtr(std::string modelInitInfo)
 {
-  if(soFileName.empty())
+  if(modelInitInfo.empty())
   {
     std::string initPars;
     BasePhraseModel* basePhrModelPtr=phraseModelsInfo.defaultClassLoader.make_obj(initPars);
@@ -575,6 +732,11 @@ BasePhraseModel* StdFeatureHandler::createPmPtr(std::string soFileName)
   }
   else
   {
+        // Obtain so file name and initialization parameters
+    std::string soFileName;
+    std::string initPars;
+    extractSoFileNameAndInitPars(modelInitInfo,soFileName,initPars);
+    
         // Declare dynamic class loader instance
     SimpleDynClassLoader<BasePhraseModel> simpleDynClassLoader;
   
@@ -587,7 +749,7 @@ BasePhraseModel* StdFeatureHandler::createPmPtr(std::string soFileName)
     }
 
         // Create tm file pointer
-    BasePhraseModel* tmPtr=simpleDynClassLoader.make_obj("");
+    BasePhraseModel* tmPtr=simpleDynClassLoader.make_obj(initPars);
 
     if(tmPtr==NULL)
     {
@@ -992,6 +1154,9 @@ int StdFeatureHandler::createLangModelFeat(std::string featName,
     return THOT_ERROR;
   langModelsInfo.lModelPtrVec.push_back(baseNgLmPtr);
 
+      // Set index of the language model state used by the feature
+  langModelFeatPtr->setLmStateIdx(langModelsInfo.lModelPtrVec.size()-1);
+
       // Add entry information
   langModelsInfo.modelDescEntryVec.push_back(modelDescEntry);
 
@@ -1257,6 +1422,7 @@ void StdFeatureHandler::clear(void)
 {
       // Clear training related data
   vecVecInvPhPair.clear();
+  onlineTrainingDelta.clear();
   
       // Delete model pointers
   deleteWpModelPtr();
@@ -1356,6 +1522,19 @@ void StdFeatureHandler::deleteSwModelPtrs(void)
   swModelsInfo.featNameVec.clear();
   swModelsInfo.invFeatNameVec.clear();
 
+      // Release copies used for online training
+  if(trainSwAligModelPtr!=NULL)
+  {
+    delete trainSwAligModelPtr;
+    trainSwAligModelPtr=NULL;
+  }
+  if(trainInvSwAligModelPtr!=NULL)
+  {
+    delete trainInvSwAligModelPtr;
+    trainInvSwAligModelPtr=NULL;
+  }
+  inPlaceOnlineTrain=false;
+
   int verbosity=false;
   swModelsInfo.defaultClassLoader.close_module(verbosity);
 }
@@ -32,6 +32,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #endif /* HAVE_CONFIG_H */
 
 #include "OnlineTrainingPars.h"
+#include "OnlineTrainingDelta.h"
 #include "WeightUpdateUtils.h"
 #include THOT_SMTMODEL_H // Define SmtModel type. It is set in
                          // configure by checking SMTMODEL_H
@@ -96,12 +97,32 @@ class StdFeatureHandler
                                std::string trgCorpusFileName,
                                int verbose=0);
 
-      // Functions for online training of features
+      // Functions for online training of features. onlineTrainFeats()
+      // performs the three steps below in a row. When models are
+      // shared with translation threads, only
+      // publishOnlineTrainDelta() requires exclusive access to them:
+      // obtainOnlineTrainDelta() trains copies of the single-word
+      // models and obtains the changes for the remaining models,
+      // publishOnlineTrainDelta() applies these changes and swaps the
+      // single-word models with their copies, and
+      // syncOnlineTrainCopies() repeats the training on the swapped
+      // out models so they can be used as copies again. Copies are
+      // obtained in memory with BaseSwAligModel::clone(), single-word
+      // models that cannot be copied are trained in place by
+      // publishOnlineTrainDelta(). Calls to these functions must be
+      // serialized by the caller
   int onlineTrainFeats(OnlineTrainingPars onlineTrainingPars,
                        std::string srcSent,
                        std::string refSent,
                        std::string sysSent,
                        int verbose=0);
+  int obtainOnlineTrainDelta(OnlineTrainingPars onlineTrainingPars,
+                             std::string srcSent,
+                             std::string refSent,
+                             std::string sysSent,
+                             int verbose=0);
+  int publishOnlineTrainDelta(int verbose=0);
+  int syncOnlineTrainCopies(int verbose=0);
 
       // Functions to train word predictor
   void trainWordPred(std::vector<std::string> strVec);
@@ -129,6 +150,12 @@ class StdFeatureHandler
 
       // Training-related data members
   std::vector<std::vector<PhrasePair> > vecVecInvPhPair;
+  BaseSwAligModel<PpInfo>* trainSwAligModelPtr;
+  BaseSwAligModel<PpInfo>* trainInvSwAligModelPtr;
+  bool inPlaceOnlineTrain;
+      // True if the single-word models cannot be copied, then they
+      // are trained in place by publishOnlineTrainDelta()
+  OnlineTrainingDelta onlineTrainingDelta;
 
       // Auxiliary functions
 
@@ -152,7 +179,7 @@ class StdFeatureHandler
   bool loadWordPredInfo(std::string lmFilesPrefix);
 
       // Phrase model-related functions
-  BasePhraseModel* createPmPtr(std::string soFileName);
+  BasePhraseModel* createPmPtr(std::string modelInitInfo);
   unsigned int getFeatureIdx(std::string featName);
   DirectPhraseModelFeat<SmtModel::HypScoreInfo>* getDirectPhraseModelFeatPtr(std::string directPhrModelFeatName);
   InversePhraseModelFeat<SmtModel::HypScoreInfo>* getInversePhraseModelFeatPtr(std::string invPhrModelFeatName);
@@ -187,37 +214,28 @@ class StdFeatureHandler
                              std::string srcSent,
                              std::string refSent,
                              int verbose=0);
+  int createSwModelCopies(int verbose=0);
   int trainLangModel(BaseNgramLM<LM_State>* lModelPtr,
                      float learnStepSize,
                      std::vector<std::string> refSentStrVec,
                      int verbose=0);
-  int trainAligModel(BasePhraseModel* invPbModelPtr,
-                     BaseSwAligModel<PpInfo>* swAligModelPtr,
-                     BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                     OnlineTrainingPars onlineTrainingPars,
-                     std::vector<std::string> srcSentStrVec,
-                     std::vector<std::string> refSentStrVec,
-                     int verbose=0);
-  void updateAligModelsSrcVoc(BasePhraseModel* invPbModelPtr,
-                              BaseSwAligModel<PpInfo>* swAligModelPtr,
-                              BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                              std::vector<std::string> srcSentStrVec);
-  void updateAligModelsTrgVoc(BasePhraseModel* invPbModelPtr,
-                              BaseSwAligModel<PpInfo>* swAligModelPtr,
-                              BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                              std::vector<std::string> trgSentStrVec);
-  WordIndex addSrcSymbolToAligModels(BasePhraseModel* invPbModelPtr,
-                                     BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                     BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                     std::string s);
-  WordIndex addTrgSymbolToAligModels(BasePhraseModel* invPbModelPtr,
-                                     BaseSwAligModel<PpInfo>* swAligModelPtr,
-                                     BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                                     std::string t);
-  int addNewTransOpts(BasePhraseModel* invPbModelPtr,
-                      BaseSwAligModel<PpInfo>* swAligModelPtr,
+  void trainAligModel(BaseSwAligModel<PpInfo>* swAligModelPtr,
                       BaseSwAligModel<PpInfo>* invSwAligModelPtr,
-                      int n,
+                      OnlineTrainingPars onlineTrainingPars,
+                      int verbose=0);
+  void retrainAligModel(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                        BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                        int verbose=0);
+  void updateAligModelsVoc(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                           BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                           std::vector<WordIndex>& srcWordIdxVec,
+                           std::vector<WordIndex>& refWordIdxVec);
+  void updatePhrModelVoc(BasePhraseModel* invPbModelPtr);
+  void obtainNewTransOpts(BaseSwAligModel<PpInfo>* swAligModelPtr,
+                          BaseSwAligModel<PpInfo>* invSwAligModelPtr,
+                          int n,
+                          int verbose=0);
+  int addNewTransOpts(BasePhraseModel* invPbModelPtr,
                       int verbose=0);
   unsigned int map_n_am_suff_stats(unsigned int n);
 
@@ -197,8 +197,10 @@ void ThotDecoder::init_translator_legacy_impl(void)
   pthread_mutex_init(&atomic_op_mut,NULL);
   pthread_mutex_init(&non_atomic_op_mut,NULL);
   pthread_mutex_init(&preproc_mut,NULL);
+  pthread_mutex_init(&online_train_mut,NULL);
   pthread_cond_init(&non_atomic_op_cond,NULL);
   non_atomic_ops_running=0;
+  model_epoch=0;
 }
 
 //--------------------------
@@ -302,8 +304,10 @@ void ThotDecoder::init_translator_feat_impl(void)
   pthread_mutex_init(&atomic_op_mut,NULL);
   pthread_mutex_init(&non_atomic_op_mut,NULL);
   pthread_mutex_init(&preproc_mut,NULL);
+  pthread_mutex_init(&online_train_mut,NULL);
   pthread_cond_init(&non_atomic_op_cond,NULL);
   non_atomic_ops_running=0;
+  model_epoch=0;
 }
 
 //--------------------------
@@ -564,6 +568,7 @@ int ThotDecoder::initUsingCfgFile(std::string cfgFile,
   std::string lm_str="/home/dortiz/traduccion/corpus/Xerox/en_es/v14may2003/simplified2/LM/e_i3_c.lm";
   std::string cf_str;
   unsigned int nomon=TDEC_NOMON_DEFAULT;
+  unsigned int et=TDEC_ET_DEFAULT;
   float W=TDEC_W_DEFAULT;
   unsigned int A=TDEC_A_DEFAULT;
   unsigned int E=TDEC_E_DEFAULT;
@@ -715,6 +720,23 @@ int ThotDecoder::initUsingCfgFile(std::string cfgFile,
       }
     }
 
+        // -et parameter
+    if(argv_stl[i]=="-et" && !matched)
+    {
+      if(i==argc-1)
+      {
+        std::cerr<<"Error: no value for -et parameter."<<std::endl;
+        return THOT_ERROR;
+      }
+      else
+      {
+        std::cerr<<"-et parameter changed from \""<<et<<"\" to \""<<argv_stl[i+1]<<"\""<<std::endl;
+        et=atoi(argv_stl[i+1].c_str());
+        ++matched;
+        ++i;
+      }
+    }
+
         // -be parameter
     if(argv_stl[i]=="-be" && !matched)
     {
@@ -999,6 +1021,9 @@ int ThotDecoder::initUsingCfgFile(std::string cfgFile,
       // Set non-monotonicity level
   setNonMonotonicity(nomon,verbose);
 
+      // Set number of threads used to expand hypotheses
+  setNumExpansionThreads(et,verbose);
+
       // Set W parameter
   set_W(W,verbose);
 
@@ -1033,11 +1058,8 @@ int ThotDecoder::initUserPars(int user_id,
                               const ThotDecoderUserPars& tdup,
                               int verbose)
 {
-  pthread_mutex_lock(&atomic_op_mut);
-  /////////// begin of mutex 
-  
-      // Wait until all non-atomic operations have finished
-  wait_on_non_atomic_op_cond();
+  begin_atomic_op();
+  /////////// begin of atomic operation
 
   if(verbose)
     StdCerrThreadSafe<<"Initializing parameters for user "<<user_id<<" ..."<<std::endl;
@@ -1063,16 +1085,17 @@ int ThotDecoder::initUserPars(int user_id,
       // Load preproc. info if requested
   if(tdup.sp && tdup.uc_str!="")
     ret=use_caseconv(user_id,tdup.uc_str.c_str(),verbose);
-  if(ret==THOT_ERROR) return THOT_ERROR;
+  if(ret==THOT_ERROR)
+  {
+    end_atomic_op();
+    return THOT_ERROR;
+  }
 
       // Set cat weights
   set_catw(user_id,tdup.catWeightsVec,verbose);
 
-      // Unlock non_atomic_op_cond mutex
-  pthread_mutex_unlock(&non_atomic_op_mut);
-
-  /////////// end of mutex 
-  pthread_mutex_unlock(&atomic_op_mut);
+  /////////// end of atomic operation
+  end_atomic_op();
 
   return THOT_OK;
 }
@@ -1215,6 +1238,22 @@ void ThotDecoder::setNonMonotonicity(int nomon,
   tdCommonVars.smtModelPtr->set_U_par(nomon);
 }
 
+//--------------------------
+void ThotDecoder::setNumExpansionThreads(unsigned int et,
+                                         int verbose/*=0*/)
+{
+  if(verbose)
+  {
+    StdCerrThreadSafe<<"Number of expansion threads is now set to "<<et<<std::endl;
+  }
+
+      // Set appropriate model parameters (models of new users are
+      // cloned from the main one)
+  _pbTransModel<SmtModel::Hypothesis>* pbtm_ptr=dynamic_cast<_pbTransModel<SmtModel::Hypothesis>* >(tdCommonVars.smtModelPtr);
+  if(pbtm_ptr)
+    pbtm_ptr->setNumExpansionThreads(et);
+}
+
 //--------------------------
 void ThotDecoder::set_W(float W_par,
                         int verbose/*=0*/)
@@ -1696,9 +1735,14 @@ int ThotDecoder::testModulesInTmDesc(const char* tmDescFileName,
 }
 
 //--------------------------
-int ThotDecoder::testTmModule(std::string soFileName,
+int ThotDecoder::testTmModule(std::string modelInitInfo,
                               int /*verbose=0*/)
 {
+      // Obtain so file name and initialization parameters
+  std::string soFileName;
+  std::string initPars;
+  extractSoFileNameAndInitPars(modelInitInfo,soFileName,initPars);
+
       // Declare dynamic class loader instance
   SimpleDynClassLoader<BasePhraseModel> simpleDynClassLoader;
   
@@ -1711,7 +1755,7 @@ int ThotDecoder::testTmModule(std::string soFileName,
   }
 
       // Create tm file pointer
-  BasePhraseModel* tmPtr=simpleDynClassLoader.make_obj("");
+  BasePhraseModel* tmPtr=simpleDynClassLoader.make_obj(initPars);
   if(tmPtr==NULL)
   {
     std::cerr<<"Error: BasePhraseModel pointer could not be instantiated"<<std::endl;    
@@ -1904,17 +1948,26 @@ int ThotDecoder::onlineTrainSentPair(int user_id,
     StdCerrThreadSafeCond(printTid)<<"Error: one or both of the input sentences to be trained are empty"<<std::endl;
     return THOT_ERROR;
   }
-    
-  pthread_mutex_lock(&atomic_op_mut);
-  /////////// begin of mutex 
 
-      // Wait until all non-atomic operations have finished
-  wait_on_non_atomic_op_cond();
+      // The data required for training (pre-processed sentences, system
+      // translation and new log-linear weights) is obtained as a
+      // non-atomic operation, since it only reads the models. Exclusive
+      // access is only requested to update them, so translation
+      // requests of other users are not stalled while decoding here
 
+      // Increase non_atomic_ops_running variable
+  increase_non_atomic_ops_running();
+  
       // Obtain index vector given user_id
   size_t idx=get_vecidx_for_user_id(user_id);
   if(verbose) StdCerrThreadSafeCond(printTid)<<"user_id: "<<user_id<<", idx: "<<idx<<std::endl;
 
+  pthread_mutex_lock(&per_user_mut[idx]);
+  /////////// begin of user mutex
+
+      // Models cannot change while non-atomic operations are running
+  unsigned long epoch=model_epoch;
+
   if(verbose)
   {
     StdCerrThreadSafeCond(printTid)<<"Training sentence pair:"<<std::endl;
@@ -1923,80 +1976,121 @@ int ThotDecoder::onlineTrainSentPair(int user_id,
   }
 
       // Check if pre/post processing is enabled
+  std::string trainSrcSent=srcSent;
+  std::string trainRefSent=refSent;
   if(tdState.preprocId)
   {
-        // Pre/post processing enabled
-    std::string preprocSrcSent=preprocLine(tdPerUserVarsVec[idx].prePosProcessorPtr,srcSent,tdState.caseconv,false);
-    std::string preprocRefSent=preprocLine(tdPerUserVarsVec[idx].prePosProcessorPtr,refSent,tdState.caseconv,false);
-
-        // Obtain system translation
-    SmtModel::Hypothesis hyp=tdPerUserVarsVec[idx].stackDecoderPtr->translate(preprocSrcSent.c_str());
-    std::string preprocSysSent=tdPerUserVarsVec[idx].smtModelPtr->getTransInPlainText(hyp);
-
+    trainSrcSent=preprocLine(tdPerUserVarsVec[idx].prePosProcessorPtr,srcSent,tdState.caseconv,false);
+    trainRefSent=preprocLine(tdPerUserVarsVec[idx].prePosProcessorPtr,refSent,tdState.caseconv,false);
     if(verbose)
     {
-      StdCerrThreadSafeCond(printTid)<<" - preproc. source: "<<preprocSrcSent<<std::endl;
-      StdCerrThreadSafeCond(printTid)<<" - preproc. reference: "<<preprocRefSent<<std::endl;
-      StdCerrThreadSafeCond(printTid)<<" - preproc. sys translation: "<<preprocSysSent<<std::endl;
+      StdCerrThreadSafeCond(printTid)<<" - preproc. source: "<<trainSrcSent<<std::endl;
+      StdCerrThreadSafeCond(printTid)<<" - preproc. reference: "<<trainRefSent<<std::endl;
     }
-        // Add sentence to word-predictor
-    addSentenceToWordPred(preprocRefSent,externalFuncVerbosity(verbose));
+  }
+  
+      // Obtain system translation
+  std::string sysSent;
+  if(sysTransRequiredForOnlineTrain())
+  {
+#ifdef THOT_ENABLE_UPDATE_LLWEIGHTS
+    if(!tdState.preprocId && tdPerUserVarsVec[idx].stackDecoderRecPtr)
+      tdPerUserVarsVec[idx].stackDecoderRecPtr->enableWordGraph();
+#endif
+    SmtModel::Hypothesis hyp=tdPerUserVarsVec[idx].stackDecoderPtr->translate(trainSrcSent.c_str());
+    sysSent=tdPerUserVarsVec[idx].smtModelPtr->getTransInPlainText(hyp);
+    if(verbose && tdState.preprocId)
+      StdCerrThreadSafeCond(printTid)<<" - preproc. sys translation: "<<sysSent<<std::endl;
+  }
 
-    if(verbose) StdCerrThreadSafeCond(printTid)<<"Training models..."<<std::endl;
+#ifdef THOT_ENABLE_UPDATE_LLWEIGHTS
+      // Obtain new log-linear weights (they are not set until the
+      // models are updated)
+  std::vector<float> newWeights;
+  bool newWeightsObtained=false;
+  if(!tdState.preprocId)
+    newWeightsObtained=obtainLogLinWeightsForOnlineTrain(idx,srcSent,refSent,newWeights,externalFuncVerbosity(verbose));
+#endif
 
-        // Measure training time
-    double prevElapsedTime,elapsedTime,ucpu,scpu;
-    ctimer(&prevElapsedTime,&ucpu,&scpu);
-    
-        // Train generative models
-    ret=onlineTrainFeats(preprocSrcSent,preprocRefSent,preprocSysSent,externalFuncVerbosity(verbose));
+  /////////// end of user mutex 
+  pthread_mutex_unlock(&per_user_mut[idx]);
 
-    ctimer(&elapsedTime,&ucpu,&scpu);
-    if(verbose)
-    {
-      StdCerrThreadSafeCond(printTid)<<"Training process ended."<<std::endl;
-      StdCerrThreadSafeCond(printTid)<<"Training time: "<<elapsedTime-prevElapsedTime<<std::endl;
-    }
-  }
-  else
-  {
-        // Pre/post processing disabled
+      // Decrease non_atomic_ops_running variable
+  decrease_non_atomic_ops_running();
 
-        // Obtain system translation
-    if(tdPerUserVarsVec[idx].stackDecoderRecPtr)
-      tdPerUserVarsVec[idx].stackDecoderRecPtr->enableWordGraph();
+      // Training requests are serialized. The changes to be applied to
+      // the models are obtained before requesting exclusive access, so
+      // translation requests are only stalled while they are applied
+  pthread_mutex_lock(&online_train_mut);
+  /////////// begin of online training mutex
+
+  if(verbose) StdCerrThreadSafeCond(printTid)<<"Training models..."<<std::endl;
 
-    SmtModel::Hypothesis hyp=tdPerUserVarsVec[idx].stackDecoderPtr->translate(srcSent);
-    std::string sysSent=tdPerUserVarsVec[idx].smtModelPtr->getTransInPlainText(hyp);
+      // Measure training time
+  double prevElapsedTime,elapsedTime,ucpu,scpu;
+  ctimer(&prevElapsedTime,&ucpu,&scpu);
 
-        // Add sentence to word-predictor
-    addSentenceToWordPred(refSent,externalFuncVerbosity(verbose));
+      // Obtain changes for generative models
+  ret=obtainOnlineTrainDelta(trainSrcSent,trainRefSent,sysSent,externalFuncVerbosity(verbose));
 
-    if(verbose) StdCerrThreadSafeCond(printTid)<<"Training models..."<<std::endl;
+      // Update models
+  begin_atomic_op();
+  /////////// begin of atomic operation
 
-        // Measure training time
-    double prevElapsedTime,elapsedTime,ucpu,scpu;
-    ctimer(&prevElapsedTime,&ucpu,&scpu);
+      // Add sentence to word-predictor
+  addSentenceToWordPred(trainRefSent,externalFuncVerbosity(verbose));
 
 #ifdef THOT_ENABLE_UPDATE_LLWEIGHTS
+  if(!tdState.preprocId)
+  {
+    if(epoch!=model_epoch)
+    {
+          // Models were modified by other atomic operations after
+          // obtaining the weights, obtain them again
+      idx=get_vecidx_for_user_id(user_id);
+      if(tdPerUserVarsVec[idx].stackDecoderRecPtr)
+        tdPerUserVarsVec[idx].stackDecoderRecPtr->enableWordGraph();
+      tdPerUserVarsVec[idx].stackDecoderPtr->translate(srcSent);
+      newWeightsObtained=obtainLogLinWeightsForOnlineTrain(idx,srcSent,refSent,newWeights,externalFuncVerbosity(verbose));
+    }
+    if(newWeightsObtained)
+      tdCommonVars.smtModelPtr->setWeights(newWeights);
+  }
+#else
+  if(verbose && epoch!=model_epoch)
+    StdCerrThreadSafeCond(printTid)<<"Models were updated while obtaining training data"<<std::endl;
+#endif
 
-    onlineTrainLogLinWeights(srcSent,refSent,externalFuncVerbosity(verbose));
+      // Train generative models
+  if(ret==THOT_OK)
+    ret=publishOnlineTrainDelta(trainSrcSent,trainRefSent,sysSent,externalFuncVerbosity(verbose));
+  ++model_epoch;
   
-#endif
+  /////////// end of atomic operation
+  end_atomic_op();
 
-        // Train generative models
-    ret=onlineTrainFeats(srcSent,refSent,sysSent,externalFuncVerbosity(verbose));
-   
-    ctimer(&elapsedTime,&ucpu,&scpu);
-    if(verbose) StdCerrThreadSafeCond(printTid)<<"Training time: "<<elapsedTime-prevElapsedTime<<std::endl;
+      // Prepare models for the next training request
+  syncOnlineTrainCopies(externalFuncVerbosity(verbose));
+
+  ctimer(&elapsedTime,&ucpu,&scpu);
+  if(verbose)
+  {
+    StdCerrThreadSafeCond(printTid)<<"Training process ended."<<std::endl;
+    StdCerrThreadSafeCond(printTid)<<"Training time: "<<elapsedTime-prevElapsedTime<<std::endl;
   }
 
-      // Unlock non_atomic_op_cond mutex
+      // Update statistics
+  pthread_mutex_lock(&non_atomic_op_mut);
+  ++lockStats.numOnlineTrainOps;
+  lockStats.onlineTrainTime+=elapsedTime-prevElapsedTime;
   pthread_mutex_unlock(&non_atomic_op_mut);
 
-  /////////// end of mutex 
-  pthread_mutex_unlock(&atomic_op_mut);
+  /////////// end of online training mutex
+  pthread_mutex_unlock(&online_train_mut);
 
+  if(verbose)
+    printLockStats();
+  
   return ret;
 }
 
@@ -2015,18 +2109,35 @@ void ThotDecoder::addSentenceToWordPred(std::string sentence,
 }
 
 //--------------------------
-int ThotDecoder::onlineTrainFeats(std::string srcSent,
-                                  std::string refSent,
-                                  std::string sysSent,
-                                  int verbose/*=0*/)
+int ThotDecoder::obtainOnlineTrainDelta(std::string srcSent,
+                                        std::string refSent,
+                                        std::string sysSent,
+                                        int verbose/*=0*/)
+{
+  if(tdCommonVars.featureBasedImplEnabled)
+  {
+    return tdCommonVars.stdFeatureHandler.obtainOnlineTrainDelta(tdCommonVars.onlineTrainingPars,
+                                                              srcSent,
+                                                              refSent,
+                                                              sysSent,
+                                                              verbose);
+  }
+  else
+  {
+        // Legacy implementation is trained in publishOnlineTrainDelta()
+    return THOT_OK;
+  }  
+}
+
+//--------------------------
+int ThotDecoder::publishOnlineTrainDelta(std::string srcSent,
+                                         std::string refSent,
+                                         std::string sysSent,
+                                         int verbose/*=0*/)
 {
   if(tdCommonVars.featureBasedImplEnabled)
   {
-    return tdCommonVars.stdFeatureHandler.onlineTrainFeats(tdCommonVars.onlineTrainingPars,
-                                                        srcSent,
-                                                        refSent,
-                                                        sysSent,
-                                                        verbose);
+    return tdCommonVars.stdFeatureHandler.publishOnlineTrainDelta(verbose);
   }
   else
   {
@@ -2035,10 +2146,30 @@ int ThotDecoder::onlineTrainFeats(std::string srcSent,
 }
 
 //--------------------------
-void ThotDecoder::onlineTrainLogLinWeights(size_t idx,
-                                           const char *srcSent,
-                                           const char *refSent,
-                                           int verbose/*=0*/)
+void ThotDecoder::syncOnlineTrainCopies(int verbose/*=0*/)
+{
+  if(tdCommonVars.featureBasedImplEnabled)
+    tdCommonVars.stdFeatureHandler.syncOnlineTrainCopies(verbose);
+}
+
+//--------------------------
+bool ThotDecoder::sysTransRequiredForOnlineTrain(void)
+{
+#ifdef THOT_ENABLE_UPDATE_LLWEIGHTS
+  return true;
+#else
+      // The system translation is only used by the legacy
+      // implementation
+  return !tdCommonVars.featureBasedImplEnabled;
+#endif
+}
+
+//--------------------------
+bool ThotDecoder::obtainLogLinWeightsForOnlineTrain(size_t idx,
+                                                    const char *srcSent,
+                                                    const char *refSent,
+                                                    std::vector<float>& newWeights,
+                                                    int verbose/*=0*/)
 {
   if(tdPerUserVarsVec[idx].stackDecoderRecPtr)
   {
@@ -2047,29 +2178,23 @@ void ThotDecoder::onlineTrainLogLinWeights(size_t idx,
     std::vector<std::string> sentStrVec=StrProcUtils::stringToStringVector(srcSent);
     bool found;
     std::string wgPathStr=tdCommonVars.wgHandlerPtr->pathAssociatedToSentence(sentStrVec,found);
+    std::vector<std::pair<std::string,float> > compWeights;
+    tdCommonVars.smtModelPtr->getWeights(compWeights);
     if(found)
     {
           // Obtain new weights
       WordGraph wg;
       wg.load(wgPathStr.c_str());
-      std::vector<std::pair<std::string,float> > compWeights;
-      tdCommonVars.smtModelPtr->getWeights(compWeights);
-      std::vector<float> newWeights;
       WeightUpdateUtils::updateLogLinearWeights(refSent,
                                                 &wg,
                                                 tdCommonVars.llWeightUpdaterPtr,
                                                 compWeights,
                                                 newWeights,
                                                 verbose);
-          // Set new weights
-      tdCommonVars.smtModelPtr->setWeights(newWeights);        
     }
     else
     {
           // Obtain new weights
-      std::vector<std::pair<std::string,float> > compWeights;
-      tdCommonVars.smtModelPtr->getWeights(compWeights);
-      std::vector<float> newWeights;
       WordGraph* wgPtr=tdPerUserVarsVec[idx].stackDecoderRecPtr->getWordGraphPtr();
       WeightUpdateUtils::updateLogLinearWeights(refSent,
                                                 wgPtr,
@@ -2077,11 +2202,12 @@ void ThotDecoder::onlineTrainLogLinWeights(size_t idx,
                                                 compWeights,
                                                 newWeights,
                                                 verbose);
-          // Set new weights
-      tdCommonVars.smtModelPtr->setWeights(newWeights);
     }    
     tdPerUserVarsVec[idx].stackDecoderRecPtr->disableWordGraph();
+    return true;
   }
+  else
+    return false;
 }
 
 //--------------------------
@@ -2117,11 +2243,8 @@ int ThotDecoder::trainEcm(int user_id,
   int ret;
   bool printTid=threadIdShouldBePrinted(verbose);
    
-  pthread_mutex_lock(&atomic_op_mut);
-  /////////// begin of mutex 
-
-      // Wait until all non-atomic operations have finished
-  wait_on_non_atomic_op_cond();
+  begin_atomic_op();
+  /////////// begin of atomic operation
 
       // Obtain index vector given user_id
   size_t idx=get_vecidx_for_user_id(user_id);
@@ -2149,12 +2272,10 @@ int ThotDecoder::trainEcm(int user_id,
   {
     ret=tdCommonVars.ecModelPtr->trainStrPair(strx,stry,externalFuncVerbosity(verbose));
   }
+  ++model_epoch;
 
-      // Unlock non_atomic_op_cond mutex
-  pthread_mutex_unlock(&non_atomic_op_mut);
-
-  /////////// end of mutex 
-  pthread_mutex_unlock(&atomic_op_mut);
+  /////////// end of atomic operation
+  end_atomic_op();
 
   return ret;
 }
@@ -2269,16 +2390,16 @@ std::string ThotDecoder::translateSentenceAux(size_t idx,
     }
     
         // Obtain best path
-    std::set<WordGraphArcId> emptyExcludedArcsSet;
+    std::vector<bool> noExcludedArcs;
     std::vector<WordGraphArc> arcVec;
-    wg.bestPathFromFinalStateToIdx(INITIAL_STATE,emptyExcludedArcsSet,arcVec);
+    wg.bestPathFromFinalStateToIdx(INITIAL_STATE,noExcludedArcs,arcVec);
 
         // Obtain translation
     std::vector<std::string> resultVec;
     for(std::vector<WordGraphArc>::reverse_iterator riter=arcVec.rbegin();riter!=arcVec.rend();++riter)
     {
-      for(unsigned int j=0;j<riter->words.size();++j)
-        resultVec.push_back(riter->words[j]);
+      for(unsigned int j=0;j<riter->numWords;++j)
+        resultVec.push_back(wg.getArcWord(*riter,j));
     }
     
         // Return result
@@ -2665,11 +2786,11 @@ int ThotDecoder::use_caseconv(int user_id,
 //--------------------------
 void ThotDecoder::clearTrans(int /*verbose=0*/)
 {
-  pthread_mutex_lock(&atomic_op_mut);
-  /////////// begin of mutex 
-
-      // Wait until all non-atomic operations have finished
-  wait_on_non_atomic_op_cond();
+      // Wait for running training requests, since they access model
+      // copies outside atomic operations
+  pthread_mutex_lock(&online_train_mut);
+  begin_atomic_op();
+  /////////// begin of atomic operation
 
   tdCommonVars.wgHandlerPtr->clear();
   tdCommonVars.smtModelPtr->clear();
@@ -2685,12 +2806,11 @@ void ThotDecoder::clearTrans(int /*verbose=0*/)
   totalPrefixVec.clear();
   userIdToIdx.clear();
   idxDataReleased.clear();
+  ++model_epoch;
 
-      // Unlock non_atomic_op_cond mutex
-  pthread_mutex_unlock(&non_atomic_op_mut);
-
-  /////////// end of mutex 
-  pthread_mutex_unlock(&atomic_op_mut);
+  /////////// end of atomic operation
+  end_atomic_op();
+  pthread_mutex_unlock(&online_train_mut);
 }
 
 //--------------------------
@@ -2842,6 +2962,55 @@ int ThotDecoder::printCatWeights(void)
   return THOT_OK;
 }
 
+//--------------------------
+ThotDecoderLockStats ThotDecoder::getLockStats(void)
+{
+  pthread_mutex_lock(&non_atomic_op_mut);
+  ThotDecoderLockStats stats=lockStats;
+  pthread_mutex_unlock(&non_atomic_op_mut);
+  return stats;
+}
+
+//--------------------------
+void ThotDecoder::printLockStats(void)
+{
+  ThotDecoderLockStats stats=getLockStats();
+  StdCerrThreadSafe<<"Atomic operations: "<<stats.numAtomicOps<<" ; wait time: "<<stats.atomicOpWaitTime<<" secs ; exclusive access time: "<<stats.atomicOpExclTime<<" secs"<<std::endl;
+  StdCerrThreadSafe<<"Non-atomic operations: "<<stats.numNonAtomicOps<<" ; time blocked by atomic operations: "<<stats.nonAtomicOpWaitTime<<" secs (max. "<<stats.nonAtomicOpMaxWaitTime<<" secs)"<<std::endl;
+  StdCerrThreadSafe<<"Online training operations: "<<stats.numOnlineTrainOps<<" ; training time: "<<stats.onlineTrainTime<<" secs"<<std::endl;
+}
+
+//--------------------------
+void ThotDecoder::begin_atomic_op(void)
+{
+  double waitStartTime,ucpu,scpu;
+  ctimer(&waitStartTime,&ucpu,&scpu);
+
+  pthread_mutex_lock(&atomic_op_mut);
+
+      // Wait until all non-atomic operations have finished
+  wait_on_non_atomic_op_cond();
+
+      // Update statistics (non_atomic_op_mut is locked at this point)
+  ctimer(&atomic_op_start_time,&ucpu,&scpu);
+  ++lockStats.numAtomicOps;
+  lockStats.atomicOpWaitTime+=atomic_op_start_time-waitStartTime;
+}
+
+//--------------------------
+void ThotDecoder::end_atomic_op(void)
+{
+      // Update statistics
+  double endTime,ucpu,scpu;
+  ctimer(&endTime,&ucpu,&scpu);
+  lockStats.atomicOpExclTime+=endTime-atomic_op_start_time;
+
+      // Unlock non_atomic_op_cond mutex
+  pthread_mutex_unlock(&non_atomic_op_mut);
+
+  pthread_mutex_unlock(&atomic_op_mut);
+}
+
 //--------------------------
 void ThotDecoder::wait_on_non_atomic_op_cond(void)
 {
@@ -2872,9 +3041,20 @@ void ThotDecoder::wait_on_non_atomic_op_cond(void)
 //--------------------------
 void ThotDecoder::increase_non_atomic_ops_running(void)
 {
+  double waitStartTime,lockTime,ucpu,scpu;
+  ctimer(&waitStartTime,&ucpu,&scpu);
+  
+      // NOTE: non_atomic_op_mut is kept locked during atomic operations
   pthread_mutex_lock(&non_atomic_op_mut);
   /////////// begin of mutex
   ++non_atomic_ops_running;
+
+      // Update statistics
+  ctimer(&lockTime,&ucpu,&scpu);
+  ++lockStats.numNonAtomicOps;
+  lockStats.nonAtomicOpWaitTime+=lockTime-waitStartTime;
+  if(lockTime-waitStartTime>lockStats.nonAtomicOpMaxWaitTime)
+    lockStats.nonAtomicOpMaxWaitTime=lockTime-waitStartTime;
   /////////// end of mutex 
   pthread_mutex_unlock(&non_atomic_op_mut);
 }
@@ -3285,6 +3465,7 @@ void ThotDecoder::destroy_feat_impl(void)
   pthread_mutex_destroy(&atomic_op_mut);
   pthread_mutex_destroy(&non_atomic_op_mut);
   pthread_mutex_destroy(&preproc_mut);
+  pthread_mutex_destroy(&online_train_mut);
   pthread_cond_destroy(&non_atomic_op_cond);
   for(unsigned int i=0;i<per_user_mut.size();++i)
     pthread_mutex_destroy(&per_user_mut[i]);
@@ -3319,6 +3500,7 @@ void ThotDecoder::destroy_legacy_impl(void)
   pthread_mutex_destroy(&atomic_op_mut);
   pthread_mutex_destroy(&non_atomic_op_mut);
   pthread_mutex_destroy(&preproc_mut);
+  pthread_mutex_destroy(&online_train_mut);
   pthread_cond_destroy(&non_atomic_op_cond);
   for(unsigned int i=0;i<per_user_mut.size();++i)
     pthread_mutex_destroy(&per_user_mut[i]);
@@ -52,6 +52,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "ThotDecoderCommonVars.h"
 #include "ThotDecoderPerUserVars.h"
 #include "ThotDecoderState.h"
+#include "ThotDecoderLockStats.h"
 #include "ThotDecoderUserPars.h"
 #include "ModelDescriptorUtils.h"
 
@@ -69,6 +70,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #define TDEC_E_DEFAULT                2
 #define TDEC_HEUR_DEFAULT             LOCAL_TD_HEURISTIC
 #define TDEC_NOMON_DEFAULT            0
+#define TDEC_ET_DEFAULT               1
 
 #define MINIMUM_WORD_LENGTH_TO_EXPAND 1    // Define the minimum
                                            // length in characters that
@@ -163,6 +165,11 @@ class ThotDecoder
   int printModelWeights(void);
   int printCatWeights(void);
 
+      // Counters of the time spent in the mutexes protecting the
+      // models
+  ThotDecoderLockStats getLockStats(void);
+  void printLockStats(void);
+
       // Destructor
   ~ThotDecoder();
 
@@ -181,11 +188,24 @@ class ThotDecoder
   pthread_mutex_t atomic_op_mut;
   pthread_mutex_t non_atomic_op_mut;
   pthread_mutex_t preproc_mut;
+  pthread_mutex_t online_train_mut;
   pthread_cond_t non_atomic_op_cond;
   unsigned int non_atomic_ops_running;
   std::vector<pthread_mutex_t> per_user_mut;
+
+      // Number of atomic operations that have modified the models, it
+      // allows to know whether data obtained during a non-atomic
+      // operation is still consistent with the models (protected by
+      // non_atomic_op_mut)
+  unsigned long model_epoch;
+
+      // Lock statistics (protected by non_atomic_op_mut)
+  ThotDecoderLockStats lockStats;
+  double atomic_op_start_time;
   
       // Mutex- and condition-related functions
+  void begin_atomic_op(void);
+  void end_atomic_op(void);
   void wait_on_non_atomic_op_cond(void);
   void increase_non_atomic_ops_running(void);
   void decrease_non_atomic_ops_running(void);
@@ -220,7 +240,7 @@ class ThotDecoder
   void testSoftwareModulesInMasterIni(void);
   int testModulesInTmDesc(const char* tmDescFileName,
                            int verbose=0);
-  int testTmModule(std::string soFileName,
+  int testTmModule(std::string modelInitInfo,
                    int verbose=0);
   int testModulesInLmDesc(const char* lmDescFileName,
                           int verbose=0);
@@ -244,6 +264,8 @@ class ThotDecoder
       // Functions to set decoder parameters
   void setNonMonotonicity(int nomon,
                           int verbose=0);
+  void setNumExpansionThreads(unsigned int et,
+                              int verbose=0);
   void set_W(float W_par,
              int verbose=0);
   void set_S(int user_id,
@@ -294,14 +316,21 @@ class ThotDecoder
       // Auxiliary functions for online training
   void addSentenceToWordPred(std::string sentence,
                              int verbose=0);
-  int onlineTrainFeats(std::string srcSent,
-                       std::string refSent,
-                       std::string sysSent,
-                       int verbose=0);
-  void onlineTrainLogLinWeights(size_t idx,
-                                const char *srcSent,
-                                const char *refSent,
-                                int verbose=0);
+  int obtainOnlineTrainDelta(std::string srcSent,
+                             std::string refSent,
+                             std::string sysSent,
+                             int verbose=0);
+  int publishOnlineTrainDelta(std::string srcSent,
+                              std::string refSent,
+                              std::string sysSent,
+                              int verbose=0);
+  void syncOnlineTrainCopies(int verbose=0);
+  bool sysTransRequiredForOnlineTrain(void);
+  bool obtainLogLinWeightsForOnlineTrain(size_t idx,
+                                         const char *srcSent,
+                                         const char *refSent,
+                                         std::vector<float>& newWeights,
+                                         int verbose=0);
   
       // Auxiliary functions for assisted translation
   void resetPrefixAux(size_t idx);
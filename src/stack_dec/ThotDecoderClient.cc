@@ -40,6 +40,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 ThotDecoderClient::ThotDecoderClient(void)
 {
  connected=false;
+ port=0;
+ fileDesc=-1;
 }
 
 //--------------------------
@@ -63,25 +65,52 @@ void ThotDecoderClient::connectToTransServer(const char *dirServ,
  }
 }
 
+//--------------------------
+void ThotDecoderClient::checkConnection(void)
+{
+      // Reconnect if the connection was lost in a previous request
+  if(!connected && !serverName.empty())
+  {
+    std::string dirServ=serverName;
+    connectToTransServer(dirServ.c_str(),port);
+  }
+  if(!connected)
+    throw std::runtime_error("ThotDecoderClient not connected");
+}
+
+//--------------------------
+void ThotDecoderClient::closeBrokenConnection(void)
+{
+  if(connected)
+  {
+    close(fileDesc);
+    fileDesc=-1;
+    connected=false;
+  }
+}
+
 //--------------------------
 void ThotDecoderClient::sendSentPairForOlTrain(int user_id,
                                                const char *srcSent,
                                                const char *refSent)
 {
-  if(connected)
+  checkConnection();
+  int ret;
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,OL_TRAIN_PAIR);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::writeStr(fileDesc,srcSent);
     BasicSocketUtils::writeStr(fileDesc,refSent);
-    int ret=BasicSocketUtils::recvInt(fileDesc);
-    if(ret==THOT_ERROR)
-      throw std::runtime_error("Online training request failed");
+    ret=BasicSocketUtils::recvInt(fileDesc);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
+  if(ret==THOT_ERROR)
+    throw std::runtime_error("Online training request failed");
 }
 
 //--------------------------
@@ -89,20 +118,23 @@ void ThotDecoderClient::sendStrPairForTrainEcm(int user_id,
                                                const char *strx,
                                                const char *stry)
 {
-  if(connected)
+  checkConnection();
+  int ret;
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,TRAIN_ECM);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::writeStr(fileDesc,strx);
     BasicSocketUtils::writeStr(fileDesc,stry);
-    int ret=BasicSocketUtils::recvInt(fileDesc);
-    if(ret==THOT_ERROR)
-      throw std::runtime_error("Error correction model training request failed");
+    ret=BasicSocketUtils::recvInt(fileDesc);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
+  if(ret==THOT_ERROR)
+    throw std::runtime_error("Error correction model training request failed");
 }
 
 //--------------------------
@@ -111,7 +143,8 @@ void ThotDecoderClient::sendSentToTranslate(int user_id,
                                             std::string &translatedSentence,
                                             std::string& bestHypInfo)
 {
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,TRANSLATE_SENT);
     BasicSocketUtils::writeInt(fileDesc,user_id);
@@ -119,10 +152,51 @@ void ThotDecoderClient::sendSentToTranslate(int user_id,
     BasicSocketUtils::recvStlStr(fileDesc,translatedSentence);
     BasicSocketUtils::recvStlStr(fileDesc,bestHypInfo);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
-  }    
+    closeBrokenConnection();
+    throw;
+  }
+}
+
+//--------------------------
+void ThotDecoderClient::sendSentsToTranslate(int user_id,
+                                             const std::vector<std::string>& srcSentVec,
+                                             std::vector<std::string>& translatedSentVec,
+                                             std::vector<std::string>& bestHypInfoVec)
+{
+  checkConnection();
+  translatedSentVec.assign(srcSentVec.size(),std::string());
+  bestHypInfoVec.assign(srcSentVec.size(),std::string());
+  try
+  {
+        // Requests are written ahead of the answers, the number of
+        // unanswered requests is bounded so as not to block the server
+        // while writing its answers
+    unsigned int numSent=0;
+    unsigned int numRecv=0;
+    while(numRecv<srcSentVec.size())
+    {
+      if(numSent<srcSentVec.size() && numSent-numRecv<THOTDEC_CLIENT_PIPELINE_WINDOW)
+      {
+        BasicSocketUtils::writeInt(fileDesc,TRANSLATE_SENT);
+        BasicSocketUtils::writeInt(fileDesc,user_id);
+        BasicSocketUtils::writeStr(fileDesc,srcSentVec[numSent].c_str());
+        ++numSent;
+      }
+      else
+      {
+        BasicSocketUtils::recvStlStr(fileDesc,translatedSentVec[numRecv]);
+        BasicSocketUtils::recvStlStr(fileDesc,bestHypInfoVec[numRecv]);
+        ++numRecv;
+      }
+    }
+  }
+  catch(const std::exception& e)
+  {
+    closeBrokenConnection();
+    throw;
+  }
 }
 
 //--------------------------
@@ -131,7 +205,8 @@ void ThotDecoderClient::sendSentPairVerCov(int user_id,
                                            const char *refSent,
                                            std::string &translatedSentence)
 {
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,VERIFY_COV);
     BasicSocketUtils::writeInt(fileDesc,user_id);
@@ -139,9 +214,10 @@ void ThotDecoderClient::sendSentPairVerCov(int user_id,
     BasicSocketUtils::writeStr(fileDesc,refSent);
     BasicSocketUtils::recvStlStr(fileDesc,translatedSentence);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
 }
 
@@ -150,16 +226,18 @@ void ThotDecoderClient::startCat(int user_id,
                                  const char *sentenceToTranslate,
                                  std::string &translatedSentence)
 {
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,START_CAT);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::writeStr(fileDesc,sentenceToTranslate);    
     BasicSocketUtils::recvStlStr(fileDesc,translatedSentence);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
 }
 
@@ -168,63 +246,72 @@ void ThotDecoderClient::addStrToPref(int user_id,
                                      const char* strToAddToPref,
                                      std::string &translatedSentence)
 {
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,ADD_STR_TO_PREF);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::writeStr(fileDesc,strToAddToPref);    
     BasicSocketUtils::recvStlStr(fileDesc,translatedSentence);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
 }
 
 //--------------------------
 void ThotDecoderClient::resetPref(int user_id)
 {    
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,RESET_PREF);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::recvInt(fileDesc);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
-  }        
+    closeBrokenConnection();
+    throw;
+  }
 }
 
 //--------------------------
 void ThotDecoderClient::sendPrintRequest(int user_id)
 {
-  if(connected)
+  checkConnection();
+  int ret;
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,PRINT_MODELS);
     BasicSocketUtils::writeInt(fileDesc,user_id);
-    int ret=BasicSocketUtils::recvInt(fileDesc);
-    if(ret==THOT_ERROR)
-      throw std::runtime_error("Print request failed");
+    ret=BasicSocketUtils::recvInt(fileDesc);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
-  }    
+    closeBrokenConnection();
+    throw;
+  }
+  if(ret==THOT_ERROR)
+    throw std::runtime_error("Print request failed");
 }
 
 //--------------------------
 void ThotDecoderClient::sendEndServerRequest(int user_id)
 {
-  if(connected)
+  checkConnection();
+  try
   {
     BasicSocketUtils::writeInt(fileDesc,END_SERVER);
     BasicSocketUtils::writeInt(fileDesc,user_id);
     BasicSocketUtils::recvInt(fileDesc);
   }
-  else
+  catch(const std::exception& e)
   {
-    throw std::runtime_error("ThotDecoderClient not connected");        
+    closeBrokenConnection();
+    throw;
   }
 }
 
@@ -233,9 +320,25 @@ void ThotDecoderClient::disconnect(int user_id)
 {
  if(connected)
  {
-  BasicSocketUtils::writeInt(fileDesc,END_CLIENT_DIALOG);
-  BasicSocketUtils::writeInt(fileDesc,user_id);
-  close(fileDesc); 
-  connected=false;   
+   try
+   {
+     BasicSocketUtils::writeInt(fileDesc,END_CLIENT_DIALOG);
+     BasicSocketUtils::writeInt(fileDesc,user_id);
+   }
+   catch(const std::exception& e)
+   {
+         // The connection is being closed anyway
+   }
+   close(fileDesc);
+   fileDesc=-1;
+   connected=false;
  }
+     // Do not reconnect in later requests
+ serverName.clear();
+}
+
+//--------------------------
+ThotDecoderClient::~ThotDecoderClient()
+{
+  disconnect(DEFAULT_USER_ID);
 }
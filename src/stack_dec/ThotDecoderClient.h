@@ -36,10 +36,15 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <BasicSocketUtils.h>
 #include <StrProcUtils.h>
 #include <string>
+#include <vector>
 #include <iostream>
 
 //--------------- Constants ------------------------------------------
 
+    // Maximum number of requests sent through the connection before
+    // reading their answers
+#define THOTDEC_CLIENT_PIPELINE_WINDOW 16
+
 
 //--------------- typedefs -------------------------------------------
 
@@ -51,6 +56,12 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 //--------------- ThotDecoderClient class
 
+/**
+ * @brief Client for thot_server. The connection is kept open and
+ * reused by all the requests, if it is broken, a new connection is
+ * established in the next request.
+ */
+
 class ThotDecoderClient
 {
  public:
@@ -69,6 +80,12 @@ class ThotDecoderClient
                              const char *sentenceToTranslate,
                              std::string& translatedSentence,
                              std::string& bestHypInfo);
+        // Translate a set of sentences pipelining the requests through
+        // the connection
+    void sendSentsToTranslate(int user_id,
+                              const std::vector<std::string>& srcSentVec,
+                              std::vector<std::string>& translatedSentVec,
+                              std::vector<std::string>& bestHypInfoVec);
     void sendSentPairVerCov(int user_id,
                             const char *srcSent,
                             const char *refSent,
@@ -83,6 +100,7 @@ class ThotDecoderClient
     void sendPrintRequest(int user_id);
     void sendEndServerRequest(int user_id);
     void disconnect(int user_id);
+    ~ThotDecoderClient();
     
  private:
 
@@ -93,6 +111,9 @@ class ThotDecoderClient
 
     // Data members
     int fileDesc;
+
+    void checkConnection(void);
+    void closeBrokenConnection(void);
 };
 
 #endif
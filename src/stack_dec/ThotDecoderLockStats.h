@@ -0,0 +1,74 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+#ifndef _ThotDecoderLockStats_h
+#define _ThotDecoderLockStats_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+//--------------- Structs --------------------------------------------
+
+/**
+ * @brief Counters measuring the time spent in the mutexes that
+ * serialize model updates (atomic operations) and translation requests
+ * (non-atomic operations) in ThotDecoder. Times are given in seconds.
+ */
+
+struct ThotDecoderLockStats
+{
+      // Atomic operations: time waiting for atomic_op_mut and for the
+      // running non-atomic operations to finish, and time holding
+      // exclusive access to the models
+  unsigned long numAtomicOps;
+  double atomicOpWaitTime;
+  double atomicOpExclTime;
+
+      // Non-atomic operations: time blocked on non_atomic_op_mut while
+      // atomic operations are executed
+  unsigned long numNonAtomicOps;
+  double nonAtomicOpWaitTime;
+  double nonAtomicOpMaxWaitTime;
+
+      // Online training requests: total time spent in training,
+      // including the time holding exclusive access to the models
+  unsigned long numOnlineTrainOps;
+  double onlineTrainTime;
+  
+  ThotDecoderLockStats()
+    {
+      default_values();
+    }
+
+  void default_values(void)
+    {
+      numAtomicOps=0;
+      atomicOpWaitTime=0;
+      atomicOpExclTime=0;
+      numNonAtomicOps=0;
+      nonAtomicOpWaitTime=0;
+      nonAtomicOpMaxWaitTime=0;
+      numOnlineTrainOps=0;
+      onlineTrainTime=0;
+    }
+};
+
+#endif
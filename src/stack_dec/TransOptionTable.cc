@@ -0,0 +1,163 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file TransOptionTable.cc
+ *
+ * @brief Definitions file for TransOptionTable.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "TransOptionTable.h"
+
+//--------------- TransOptionTable class functions
+
+TransOptionTable::TransOptionTable(void)
+{
+  srcSentLen=0;
+  maxSrcPhraseLen=0;
+  numScores=0;
+}
+
+//---------------------------------
+void TransOptionTable::init(PositionIndex _srcSentLen,
+                            PositionIndex _maxSrcPhraseLen,
+                            unsigned int _numScores)
+{
+  clear();
+  srcSentLen=_srcSentLen;
+  maxSrcPhraseLen=_maxSrcPhraseLen;
+  if(maxSrcPhraseLen>srcSentLen)
+    maxSrcPhraseLen=srcSentLen;
+  numScores=_numScores;
+  spanRangeVec.resize((size_t)srcSentLen*maxSrcPhraseLen,std::make_pair(0u,0u));
+}
+
+//---------------------------------
+void TransOptionTable::addOption(PositionIndex srcLeft,
+                                 PositionIndex srcRight,
+                                 const std::vector<WordIndex>& trgPhrase,
+                                 const std::vector<Score>& scoreVec)
+{
+  if(!spanIsValid(srcLeft,srcRight))
+    return;
+
+      // Update range of the span (options of the span are contiguous)
+  std::pair<unsigned int,unsigned int>& spanRange=spanRangeVec[spanIndex(srcLeft,srcRight)];
+  if(spanRange.first==spanRange.second)
+    spanRange.first=transOptVec.size();
+  spanRange.second=transOptVec.size()+1;
+
+      // Store option
+  TransOption transOpt;
+  transOpt.trgBegin=trgWordVec.size();
+  transOpt.trgPhraseLen=trgPhrase.size();
+  transOptVec.push_back(transOpt);
+  trgWordVec.insert(trgWordVec.end(),trgPhrase.begin(),trgPhrase.end());
+  for(unsigned int i=0;i<numScores;++i)
+  {
+    if(i<scoreVec.size())
+      scoreMatrix.push_back(scoreVec[i]);
+    else
+      scoreMatrix.push_back(0);
+  }
+}
+
+//---------------------------------
+int TransOptionTable::getFirstOptionIdx(PositionIndex srcLeft,
+                                        PositionIndex srcRight)const
+{
+  if(getNumOptions(srcLeft,srcRight)==0)
+    return TRANS_OPT_NOT_FOUND;
+  else
+    return spanRangeVec[spanIndex(srcLeft,srcRight)].first;
+}
+
+//---------------------------------
+unsigned int TransOptionTable::getNumOptions(PositionIndex srcLeft,
+                                             PositionIndex srcRight)const
+{
+  if(!spanIsValid(srcLeft,srcRight))
+    return 0;
+
+  const std::pair<unsigned int,unsigned int>& spanRange=spanRangeVec[spanIndex(srcLeft,srcRight)];
+  return spanRange.second-spanRange.first;
+}
+
+//---------------------------------
+const WordIndex* TransOptionTable::getTrgPhrase(int optIdx,
+                                                PositionIndex& trgPhraseLen)const
+{
+  const TransOption& transOpt=transOptVec[optIdx];
+  trgPhraseLen=transOpt.trgPhraseLen;
+  return &trgWordVec[transOpt.trgBegin];
+}
+
+//---------------------------------
+const Score* TransOptionTable::getScores(int optIdx)const
+{
+  if(numScores==0)
+    return NULL;
+  else
+    return &scoreMatrix[(size_t)optIdx*numScores];
+}
+
+//---------------------------------
+unsigned int TransOptionTable::getNumScores(void)const
+{
+  return numScores;
+}
+
+//---------------------------------
+size_t TransOptionTable::size(void)const
+{
+  return transOptVec.size();
+}
+
+//---------------------------------
+bool TransOptionTable::empty(void)const
+{
+  return transOptVec.empty();
+}
+
+//---------------------------------
+void TransOptionTable::clear(void)
+{
+  srcSentLen=0;
+  maxSrcPhraseLen=0;
+  numScores=0;
+  spanRangeVec.clear();
+  transOptVec.clear();
+  trgWordVec.clear();
+  scoreMatrix.clear();
+}
+
+//---------------------------------
+bool TransOptionTable::spanIsValid(PositionIndex srcLeft,
+                                   PositionIndex srcRight)const
+{
+  return srcLeft>=1 && srcLeft<=srcRight && srcRight<=srcSentLen && srcRight-srcLeft<maxSrcPhraseLen;
+}
+
+//---------------------------------
+size_t TransOptionTable::spanIndex(PositionIndex srcLeft,
+                                   PositionIndex srcRight)const
+{
+  return (size_t)(srcLeft-1)*maxSrcPhraseLen+(srcRight-srcLeft);
+}
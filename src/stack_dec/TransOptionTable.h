@@ -0,0 +1,118 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file TransOptionTable.h
+ *
+ * @brief Defines the TransOptionTable class, which stores the
+ * translation options of the sentence being translated. Each option is
+ * given by a source span and a target phrase, and has associated the
+ * unweighted scores of the features whose contribution only depends on
+ * the phrase pair. Options of the same span are stored contiguously,
+ * target phrases share a single array of word indices and scores are
+ * stored as a matrix with one row per option.
+ */
+
+#ifndef _TransOptionTable_h
+#define _TransOptionTable_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "PositionIndex.h"
+#include "WordIndex.h"
+#include "Score.h"
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define TRANS_OPT_NOT_FOUND -1
+
+//--------------- Classes --------------------------------------------
+
+//--------------- TransOptionTable class
+
+class TransOptionTable
+{
+ public:
+
+      // Constructor
+  TransOptionTable(void);
+
+      // Initializes the table for a sentence of srcSentLen words,
+      // storing numScores scores per option. Spans longer than
+      // maxSrcPhraseLen cannot be added
+  void init(PositionIndex srcSentLen,
+            PositionIndex maxSrcPhraseLen,
+            unsigned int numScores);
+
+      // Adds a translation option. All of the options of a given span
+      // have to be added before adding those of a different span
+  void addOption(PositionIndex srcLeft,
+                 PositionIndex srcRight,
+                 const std::vector<WordIndex>& trgPhrase,
+                 const std::vector<Score>& scoreVec);
+
+      // Returns the index of the first option of the given span, or
+      // TRANS_OPT_NOT_FOUND. The k-th option added for the span has
+      // index getFirstOptionIdx()+k
+  int getFirstOptionIdx(PositionIndex srcLeft,
+                        PositionIndex srcRight)const;
+  unsigned int getNumOptions(PositionIndex srcLeft,
+                             PositionIndex srcRight)const;
+
+      // Returns the target phrase of the option with index optIdx
+  const WordIndex* getTrgPhrase(int optIdx,
+                                PositionIndex& trgPhraseLen)const;
+
+      // Returns the scores of the option with index optIdx
+  const Score* getScores(int optIdx)const;
+
+  unsigned int getNumScores(void)const;
+  size_t size(void)const;
+  bool empty(void)const;
+  void clear(void);
+
+ private:
+
+  struct TransOption
+  {
+    size_t trgBegin;
+    PositionIndex trgPhraseLen;
+  };
+
+  PositionIndex srcSentLen;
+  PositionIndex maxSrcPhraseLen;
+  unsigned int numScores;
+
+      // Range of options of each span, indexed by spanIndex()
+  std::vector<std::pair<unsigned int,unsigned int> > spanRangeVec;
+  std::vector<TransOption> transOptVec;
+  std::vector<WordIndex> trgWordVec;
+  std::vector<Score> scoreMatrix;
+
+  bool spanIsValid(PositionIndex srcLeft,
+                   PositionIndex srcRight)const;
+  size_t spanIndex(PositionIndex srcLeft,
+                   PositionIndex srcRight)const;
+};
+
+#endif
@@ -300,9 +300,9 @@ WgUncoupledAssistedTrans<SMT_MODEL>::obtainWgUsingWgHandler(std::string s,
     }
 
         // Obtain best path
-    std::set<WordGraphArcId> emptyExcludedArcsSet;
+    std::vector<bool> noExcludedArcs;
     std::vector<WordGraphArc> arcVec;
-    Score score=wg_ptr->bestPathFromFinalStateToIdx(INITIAL_STATE,emptyExcludedArcsSet,arcVec);
+    Score score=wg_ptr->bestPathFromFinalStateToIdx(INITIAL_STATE,noExcludedArcs,arcVec);
 
     if(score!=SMALL_SCORE)
       completeHypReachable=true;
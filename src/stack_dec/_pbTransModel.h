@@ -38,12 +38,16 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "BasePbTransModel.h"
 #include "PhraseTransTableNodeData.h"
 #include "NbestTableNode.h"
+#include "NbestTransList.h"
 #include "NbestTransTable.h"
 #include "SingleWordVocab.h"
 #include "SourceSegmentation.h"
 #include "WordPredictor.h"
 #include "PbTransModelInputVars.h"
 #include "NbestTransCacheData.h"
+#include "TransOptionTable.h"
+#include "MonotonicArena.h"
+#include "WorkerThreadPool.h"
 #include "StatModelDefs.h"
 #include "Prob.h"
 #include <math.h>
@@ -121,16 +125,25 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // Expansion-related functions
   void expand(const Hypothesis& hyp,
               std::vector<Hypothesis>& hypVec,
-              std::vector<std::vector<Score> >& scrCompVec);
+              std::vector<ScoreComps>& scrCompVec);
   void expand_ref(const Hypothesis& hyp,
                   std::vector<Hypothesis>& hypVec,
-                  std::vector<std::vector<Score> >& scrCompVec);
+                  std::vector<ScoreComps>& scrCompVec);
   void expand_ver(const Hypothesis& hyp,
                   std::vector<Hypothesis>& hypVec,
-                  std::vector<std::vector<Score> >& scrCompVec);
+                  std::vector<ScoreComps>& scrCompVec);
   void expand_prefix(const Hypothesis& hyp,
                      std::vector<Hypothesis>& hypVec,
-                     std::vector<std::vector<Score> >& scrCompVec);
+                     std::vector<ScoreComps>& scrCompVec);
+  void expandHyps(const std::vector<Hypothesis>& hypVec,
+                  std::vector<std::vector<Hypothesis> >& expHypVecs,
+                  std::vector<std::vector<ScoreComps> >& scrCompVecs);
+
+      // Functions to set the number of threads used to expand the
+      // hypotheses of a sentence (the source phrases covered by the
+      // expansions are distributed among the threads)
+  void setNumExpansionThreads(unsigned int numThreads);
+  unsigned int getNumExpansionThreads(void)const;
 
       // Heuristic-related functions
   void setHeuristic(unsigned int _heuristicId);
@@ -148,7 +161,7 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
   void getWeights(std::vector<std::pair<std::string,float> >& compWeights);
   void printWeights(std::ostream &outS);
   unsigned int getNumWeights(void);
-  void getUnweightedComps(const std::vector<Score>& scrComps,
+  void getUnweightedComps(const ScoreComps& scrComps,
                           std::vector<Score>& unweightedScrComps);
   std::vector<Score> scoreCompsForHyp(const Hypothesis& hyp);
 
@@ -158,6 +171,11 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
                      const std::vector<std::string>& trgPhrase,
                      HypDataType& hypd);
 
+# ifdef THOT_STATS
+      // Statistics (also print the use of the per-sentence arenas)
+  std::ostream & printStats(std::ostream &outS);
+# endif
+
       // Destructor
   ~_pbTransModel();
 
@@ -200,6 +218,24 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // Data used to cache n-best translation data
   NbestTransCacheData nbTransCacheData;
 
+      // Translation options of the sentence being translated, storing
+      // the scores of the context-free features. transOptScrIdxVec
+      // gives the position of the score of each feature (standard
+      // features first, then custom and on-the-fly ones), or -1 if the
+      // feature is not context-free
+  TransOptionTable transOptTable;
+  std::vector<int> transOptScrIdxVec;
+
+      // Arena storing hypothesis data for the sentence being
+      // translated
+  MonotonicArena hypDataArena;
+
+      // Thread pool used to expand hypotheses in parallel and arenas
+      // used by its threads (the thread requesting the expansions
+      // uses hypDataArena)
+  WorkerThreadPool expansionPool;
+  std::vector<MonotonicArena> workerHypDataArenaVec;
+
   ////// Weight-related functions
   void initFeatWeights(std::vector<float> wVec);
   float getStdFeatWeight(unsigned int i);
@@ -211,19 +247,61 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // Expansion-related functions
   void extract_gaps(const Hypothesis& hyp,
                     std::vector<std::pair<PositionIndex,PositionIndex> >& gaps);
-  void extract_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey,
+  void extract_gaps(const Coverage& hypKey,
                     std::vector<std::pair<PositionIndex,PositionIndex> >& gaps);
-  unsigned int get_num_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey);
+  unsigned int get_num_gaps(const Coverage& hypKey);
+  void getSrcPhrasesToExpand(const Hypothesis& hyp,
+                             std::vector<std::pair<PositionIndex,PositionIndex> >& srcPhrVec);
+      // Obtain the source phrases that can be covered by the
+      // expansions of hyp
+  void expandSrcPhrase(const Hypothesis& hyp,
+                       PositionIndex srcLeft,
+                       PositionIndex srcRight,
+                       std::vector<HypDataType>& hypDataVec,
+                       std::vector<Hypothesis>& hypVec,
+                       std::vector<ScoreComps>& scrCompVec);
+      // Append to hypVec the expansions of hyp covering the source
+      // phrase given by srcLeft and srcRight (hypDataVec is used as
+      // auxiliary storage)
+
+      // Functions related to parallel expansion
+  struct ExpansionTask
+  {
+    unsigned int hypIdx;
+    std::pair<PositionIndex,PositionIndex> srcPhr;
+    std::vector<Hypothesis> hypVec;
+    std::vector<ScoreComps> scrCompVec;
+  };
+  struct ExpansionBatch
+  {
+    _pbTransModel<HYPOTHESIS>* modelPtr;
+    std::vector<const Hypothesis*> hypPtrVec;
+    std::vector<ExpansionTask> taskVec;
+  };
+  void expandInParallel(const std::vector<const Hypothesis*>& hypPtrVec,
+                        std::vector<std::vector<Hypothesis> >& expHypVecs,
+                        std::vector<std::vector<ScoreComps> >& scrCompVecs);
+      // Expand the given hypotheses using the thread pool. The
+      // expansions of each hypothesis are merged in the same order
+      // used by expand()
+  static void expansionTaskFunc(void* data,
+                                unsigned int taskIdx,
+                                unsigned int workerIdx);
+  MonotonicArena& getHypDataArena(void);
+      // Return the arena to be used by the calling thread
 
       // Misc. operations with hypothesis
   virtual Score nullHypothesisScrComps(Hypothesis& nullHyp,
-                                       std::vector<Score>& scoreComponents)=0;
+                                       ScoreComps& scoreComponents)=0;
 
       // Specific phrase-based functions
   virtual void extendHypDataIdx(PositionIndex srcLeft,
                                 PositionIndex srcRight,
                                 const std::vector<WordIndex>& trgPhraseIdx,
+                                int transOptIdx,
                                 HypDataType& hypd)=0;
+      // transOptIdx is the index of the phrase in transOptTable
+      // (TRANS_OPT_NOT_FOUND if it was not taken from it)
   virtual bool getHypDataVecForGap(const Hypothesis& hyp,
                                    PositionIndex srcLeft,
                                    PositionIndex srcRight,
@@ -256,57 +334,66 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // This function is identical to the previous function but is to
       // be used when the translation process is conducted by a given
       // prefix
-  virtual bool getTransForHypUncovGap(const Hypothesis& hyp,
-                                      PositionIndex srcLeft,
-                                      PositionIndex srcRight,
-                                      NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                      float N);
+  virtual const NbestTransList& getTransForHypUncovGap(const Hypothesis& hyp,
+                                                       PositionIndex srcLeft,
+                                                       PositionIndex srcRight,
+                                                       NbestTransList& auxList,
+                                                       float N);
       // Get N-best translations for a subphrase of the source sentence
       // to be translated .  If N is between 0 and 1 then N represents a
       // threshold.  The result of the search is cached in the data
-      // member cPhrNbestTransTable
-  virtual bool getTransForHypUncovGapRef(const Hypothesis& hyp,
-                                         PositionIndex srcLeft,
-                                         PositionIndex srcRight,
-                                         NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                         float N);
+      // member cPhrNbestTransList. The returned list is either a cached
+      // list or auxList, which is used for translations that are not
+      // cached
+  virtual const NbestTransList& getTransForHypUncovGapRef(const Hypothesis& hyp,
+                                                          PositionIndex srcLeft,
+                                                          PositionIndex srcRight,
+                                                          NbestTransList& auxList,
+                                                          float N);
       // This function is identical to the previous function but is to
       // be used when the translation process is conducted by a given
       // reference sentence
-  void transUncovGapRefNoLastGapCached(const Hypothesis& hyp,
-                                       PositionIndex srcLeft,
-                                       PositionIndex srcRight,
-                                       NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                       float N);
+  const NbestTransList& transUncovGapRefNoLastGapCached(const Hypothesis& hyp,
+                                                        PositionIndex srcLeft,
+                                                        PositionIndex srcRight,
+                                                        float N);
   void transUncovGapRefLastGapCached(const Hypothesis& hyp,
-                                     PositionIndex srcLeft,
-                                     PositionIndex srcRight,
-                                     NbestTableNode<PhraseTransTableNodeData>& nbt);
-  virtual bool getTransForHypUncovGapVer(const Hypothesis& hyp,
-                                         PositionIndex srcLeft,
-                                         PositionIndex srcRight,
-                                         NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                         float N);
+                               PositionIndex srcLeft,
+                               PositionIndex srcRight,
+                               NbestTransList& auxList);
+  virtual const NbestTransList& getTransForHypUncovGapVer(const Hypothesis& hyp,
+                                                          PositionIndex srcLeft,
+                                                          PositionIndex srcRight,
+                                                          NbestTransList& auxList,
+                                                          float N);
       // This function is identical to the previous function but is to
       // be used when the translation process is performed to verify the
       // coverage of the model given a reference sentence
-  virtual bool getTransForHypUncovGapPref(const Hypothesis& hyp,
-                                          PositionIndex srcLeft,
-                                          PositionIndex srcRight,
-                                          NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                          float N);
+  virtual const NbestTransList& getTransForHypUncovGapPref(const Hypothesis& hyp,
+                                                           PositionIndex srcLeft,
+                                                           PositionIndex srcRight,
+                                                           NbestTransList& auxList,
+                                                           float N);
       // This function is identical to the previous function but is to
       // be used when the translation process is conducted by a given
       // prefix
 
+      // Functions related to translation constraints
+  void initConstrTrgIdMap(void);
+      // Store the translation constraints of the source sentence as
+      // vectors of target WordIndex
+  bool lastPhraseSatisfiesConstraints(const HypDataType& hypd)const;
+      // Verify that the last phrase of hypd satisfies the translation
+      // constraints. The rest of phrases are assumed to satisfy them,
+      // as it happens when hypotheses are extended one phrase at a time
+
       // Functions for translating with references or prefixes
   virtual bool hypDataTransIsPrefixOfTargetRef(const HypDataType& hypd,
                                                bool& equal)const=0;
-  void transUncovGapPrefNoGenCached(const Hypothesis& hyp,
-                                    PositionIndex srcLeft,
-                                    PositionIndex srcRight,
-                                    NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                    float N);
+  const NbestTransList& transUncovGapPrefNoGenCached(const Hypothesis& hyp,
+                                                     PositionIndex srcLeft,
+                                                     PositionIndex srcRight,
+                                                     float N);
   void transUncovGapPrefNoGen(const Hypothesis& hyp,
                               PositionIndex srcLeft,
                               PositionIndex srcRight,
@@ -322,15 +409,22 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // returns true if target word vector wiVec1 is a prefix of wiVec2
 
       // Functions to generate translation lists
-  bool getNbestTransForSrcPhraseCached(PositionIndex srcLeft,
-                                       PositionIndex srcRight,
-                                       NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                       float N);
+  const NbestTransList& getNbestTransForSrcPhraseCached(PositionIndex srcLeft,
+                                                        PositionIndex srcRight,
+                                                        float N);
   virtual bool getNbestTransForSrcPhrase(std::vector<WordIndex> srcPhrase,
                                          NbestTableNode<PhraseTransTableNodeData>& nbt,
                                          float N);
       // Get N-best translations for a given source phrase srcPhrase.
       // If N is between 0 and 1 then N represents a threshold
+  bool getNbestTransForSrcPhraseStr(const std::vector<std::string>& srcPhraseStr,
+                                    NbestTableNode<PhraseTransTableNodeData>& nbt,
+                                    float N,
+                                    std::map<std::vector<WordIndex>,std::vector<Score> >* unweightedScrMapPtr);
+      // Same as getNbestTransForSrcPhrase() but the source phrase is
+      // given as a string vector. If unweightedScrMapPtr is not NULL,
+      // it stores the unweighted scores of the features for every
+      // translation
       // Functions to generate translation lists
   bool getTransForSrcPhrase(const std::vector<WordIndex>& srcPhrase,
                             std::set<std::vector<WordIndex> >& transSet);
@@ -344,6 +438,11 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
       // Functions to score n-best translations lists
   Score nbestTransScore(const std::vector<WordIndex>& srcPhrase,
                         const std::vector<WordIndex>& trgPhrase);
+  Score nbestTransScoreStr(const std::vector<std::string>& srcPhraseStr,
+                           const std::vector<std::string>& trgPhraseStr,
+                           std::vector<Score>& unweightedScoreVec);
+      // Returns the weighted score of the phrase pair and the
+      // unweighted score of each feature in unweightedScoreVec
   Score nbestTransScoreLast(const std::vector<WordIndex>& srcPhrase,
                             const std::vector<WordIndex>& t_);
       // Cached functions to score n-best translations lists
@@ -373,6 +472,16 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
   Score heuristicLocalt(const Hypothesis& hyp);
   Score heuristicLocaltd(const Hypothesis& hyp);
   Score getLocalTmHeurScore(const Hypothesis& hyp);
+  Score getGapTmHeurScore(PositionIndex gapLeft,
+                          PositionIndex gapRight)const;
+  void updateTmHeurScore(PositionIndex gapLeft,
+                         PositionIndex gapRight,
+                         PositionIndex srcLeft,
+                         PositionIndex srcRight,
+                         HypScoreInfo& hypScoreInfo)const;
+      // Updates the heuristic score of the translation model stored in
+      // hypScoreInfo when the source phrase [srcLeft,srcRight] is
+      // covered within the gap [gapLeft,gapRight]
   Score getDistortionHeurScore(const Hypothesis& hyp);
   PositionIndex getLastSrcPosCovered(const Hypothesis& hyp);
       // Get the index of last source position which was covered
@@ -382,6 +491,14 @@ class _pbTransModel: public BasePbTransModel<HYPOTHESIS>
 
       // Functions related to pre_trans_actions
   virtual void clearTempVars(void);
+  void clearFeatsTempVars(void);
+  static void clearFeatsTempVarsTaskFunc(void* data,
+                                         unsigned int taskIdx,
+                                         unsigned int workerIdx);
+  void fillTransOptionTable(void);
+      // Obtain the translations of every source phrase in advance and
+      // score them with the context-free features. The n-best cache is
+      // also filled, so that it is only read when expanding in parallel
   void verifyDictCoverageForSentence(const std::vector<std::string>& sentenceVec,
                                      int maxSrcPhraseLength=MAX_SENTENCE_LENGTH_ALLOWED);
   bool srcPhrHasAtLeastOneValidTranslation(const std::vector<std::string> srcPhraseStr,
@@ -518,6 +635,12 @@ void _pbTransModel<HYPOTHESIS>::pre_trans_actions(std::string srcsent)
     pbtmInputVars.nsrcSentIdVec.push_back(w);
   }
 
+      // Store translation constraints as vectors of WordIndex
+  initConstrTrgIdMap();
+
+      // Obtain translation options in advance
+  fillTransOptionTable();
+
       // Initialize heuristic (the source sentence must be previously
       // stored)
   if(this->verbosity>0)
@@ -756,72 +879,41 @@ void _pbTransModel<HYPOTHESIS>::extract_gaps(const Hypothesis& hyp,
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _pbTransModel<HYPOTHESIS>::extract_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey,
+void _pbTransModel<HYPOTHESIS>::extract_gaps(const Coverage& hypKey,
                                              std::vector<std::pair<PositionIndex,PositionIndex> >& gaps)
 {
-      // Extract all uncovered gaps
-  std::pair<PositionIndex,PositionIndex> gap;
-  unsigned int srcSentLen=this->numberOfUncoveredSrcWordsHypData(this->nullHypothesisHypData());
-  unsigned int j;
+      // Extract all uncovered gaps, the limits of each gap are found
+      // by scanning the coverage vector one word at a time
+  size_t srcSentLen=pbtmInputVars.srcSentVec.size();
   
-      // Extract gaps
   gaps.clear();
-  bool crossing_a_gap=false;	
-	
-  for(j=1;j<=srcSentLen;++j)
+  size_t gapLeft=hypKey.findNext(1,false);
+  while(gapLeft<=srcSentLen)
   {
-    if(crossing_a_gap==false && hypKey.test(j)==0)
-    {
-      crossing_a_gap=true;
-      gap.first=j;
-    }
-	
-    if(crossing_a_gap==true && hypKey.test(j)==1)
-    {
-      crossing_a_gap=false;
-      gap.second=j-1;
-      gaps.push_back(gap);	
-    }	
-  }
-  if(crossing_a_gap==true)
-  {
-    gap.second=j-1;
-    gaps.push_back(gap);
+    size_t gapEnd=hypKey.findNext(gapLeft,true);
+    if(gapEnd>srcSentLen)
+      gapEnd=srcSentLen+1;
+    gaps.push_back(std::make_pair((PositionIndex)gapLeft,(PositionIndex)(gapEnd-1)));
+    gapLeft=hypKey.findNext(gapEnd,false);
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-unsigned int _pbTransModel<HYPOTHESIS>::get_num_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey)
+unsigned int _pbTransModel<HYPOTHESIS>::get_num_gaps(const Coverage& hypKey)
 {
       // Count all uncovered gaps
+  size_t srcSentLen=pbtmInputVars.srcSentVec.size();
   unsigned int result=0;
-  unsigned int j;
-  bool crossing_a_gap;
-  unsigned int srcSentLen;
-  HypDataType nullHypData=this->nullHypothesisHypData();
-
-  srcSentLen=this->numberOfUncoveredSrcWordsHypData(nullHypData);
   
-      // count gaps	
-  crossing_a_gap=false;	
-	
-  for(j=1;j<=srcSentLen;++j)
-  {
-    if(crossing_a_gap==false && hypKey.test(j)==0)
-    {
-      crossing_a_gap=true;
-    }
-	
-    if(crossing_a_gap==true && hypKey.test(j)==1)
-    {
-      crossing_a_gap=false;
-      ++result;	
-    }	
-  }
-  if(crossing_a_gap==true)
+  size_t gapLeft=hypKey.findNext(1,false);
+  while(gapLeft<=srcSentLen)
   {
     ++result;
+    size_t gapEnd=hypKey.findNext(gapLeft,true);
+    if(gapEnd>srcSentLen)
+      break;
+    gapLeft=hypKey.findNext(gapEnd,false);
   }
   return result;
 }
@@ -831,7 +923,7 @@ template<class HYPOTHESIS>
 typename _pbTransModel<HYPOTHESIS>::Hypothesis
 _pbTransModel<HYPOTHESIS>::nullHypothesis(void)
 {
-  std::vector<Score> scrComp;
+  ScoreComps scrComp;
   Hypothesis nullHyp;
   nullHypothesisScrComps(nullHyp,scrComp);
   return nullHyp;
@@ -841,16 +933,65 @@ _pbTransModel<HYPOTHESIS>::nullHypothesis(void)
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::expand(const Hypothesis& hyp,
                                        std::vector<Hypothesis>& hypVec,
-                                       std::vector<std::vector<Score> >& scrCompVec)
+                                       std::vector<ScoreComps>& scrCompVec)
 {
-  std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
-  std::vector<WordIndex> srcPhrase;
-  Hypothesis extHyp;
-  std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  if(expansionPool.getNumThreads()>1)
+  {
+        // Expand hypothesis in parallel
+    std::vector<const Hypothesis*> hypPtrVec(1,&hyp);
+    std::vector<std::vector<Hypothesis> > expHypVecs;
+    std::vector<std::vector<ScoreComps> > scrCompVecs;
+    expandInParallel(hypPtrVec,expHypVecs,scrCompVecs);
+    hypVec.swap(expHypVecs[0]);
+    scrCompVec.swap(scrCompVecs[0]);
+  }
+  else
+  {
+    std::vector<std::pair<PositionIndex,PositionIndex> > srcPhrVec;
+    std::vector<HypDataType> hypDataVec;
   
-  hypVec.clear();
-  scrCompVec.clear();
+    hypVec.clear();
+    scrCompVec.clear();
+
+        // Generate new hypotheses completing the gaps
+    getSrcPhrasesToExpand(hyp,srcPhrVec);
+    for(unsigned int i=0;i<srcPhrVec.size();++i)
+      expandSrcPhrase(hyp,srcPhrVec[i].first,srcPhrVec[i].second,hypDataVec,hypVec,scrCompVec);
+  }
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::expandHyps(const std::vector<Hypothesis>& hypVec,
+                                           std::vector<std::vector<Hypothesis> >& expHypVecs,
+                                           std::vector<std::vector<ScoreComps> >& scrCompVecs)
+{
+  if(expansionPool.getNumThreads()>1 && hypVec.size()>1)
+  {
+        // Expand all of the hypotheses in the same parallel batch
+    std::vector<const Hypothesis*> hypPtrVec;
+    for(unsigned int i=0;i<hypVec.size();++i)
+      hypPtrVec.push_back(&hypVec[i]);
+    expandInParallel(hypPtrVec,expHypVecs,scrCompVecs);
+  }
+  else
+  {
+    expHypVecs.resize(hypVec.size());
+    scrCompVecs.resize(hypVec.size());
+    for(unsigned int i=0;i<hypVec.size();++i)
+      expand(hypVec[i],expHypVecs[i],scrCompVecs[i]);
+  }
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::getSrcPhrasesToExpand(const Hypothesis& hyp,
+                                                      std::vector<std::pair<PositionIndex,PositionIndex> >& srcPhrVec)
+{
+  std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
+  bool sentHasConstraints=!pbtmInputVars.constrTrgIdMap.empty();
+
+  srcPhrVec.clear();
   
       // Extract gaps
   extract_gaps(hyp,gaps);
@@ -859,13 +1000,12 @@ void _pbTransModel<HYPOTHESIS>::expand(const Hypothesis& hyp,
     std::cerr<<"  gaps: "<<gaps.size()<<std::endl;
   }
    
-      // Generate new hypotheses completing the gaps
+      // Obtain source phrases completing the gaps
   for(unsigned int k=0;k<gaps.size();++k)
   {
     unsigned int gap_length=gaps[k].second-gaps[k].first+1;
     for(unsigned int x=0;x<gap_length;++x)
     {
-      srcPhrase.clear();
       if(x<=this->pbTransModelPars.U) // x should be lower than U, which is the maximum
                // number of words that can be jUmped
       {
@@ -873,49 +1013,144 @@ void _pbTransModel<HYPOTHESIS>::expand(const Hypothesis& hyp,
         {
           unsigned int segmRightMostj=gaps[k].first+y;
           unsigned int segmLeftMostj=gaps[k].first+x;
-          bool srcPhraseIsAffectedByConstraint=this->trMetadataPtr->srcPhrAffectedByConstraint(std::make_pair(segmLeftMostj,segmRightMostj));
+          bool srcPhraseIsAffectedByConstraint=sentHasConstraints && this->trMetadataPtr->srcPhrAffectedByConstraint(std::make_pair(segmLeftMostj,segmRightMostj));
               // Verify that the source phrase length does not exceed
               // the limit. The limit can be exceeded when the source
               // phrase is affected by a translation constraint
           if((segmRightMostj-segmLeftMostj)+1 > this->pbTransModelPars.A && !srcPhraseIsAffectedByConstraint)
             break;
-              // Obtain hypothesis data vector
-          getHypDataVecForGap(hyp,segmLeftMostj,segmRightMostj,hypDataVec,this->pbTransModelPars.W);
-          if(hypDataVec.size()!=0)
-          {
-            for(unsigned int i=0;i<hypDataVec.size();++i)
-            {
-                  // Create hypothesis extension
-              this->incrScore(hyp,hypDataVec[i],extHyp,scoreComponents);
-                  // Obtain information about hypothesis extension
-              SourceSegmentation srcSegm;
-              std::vector<PositionIndex> trgSegmCuts;
-              extHyp.getPhraseAlign(srcSegm,trgSegmCuts);
-              std::vector<std::string> targetWordVec=this->getTransInPlainTextVec(extHyp);
-              if(this->trMetadataPtr->translationSatisfiesConstraints(srcSegm,trgSegmCuts,targetWordVec))
-              {
-                hypVec.push_back(extHyp);
-                scrCompVec.push_back(scoreComponents);
-              }
-            }
-          }
+          srcPhrVec.push_back(std::make_pair(segmLeftMostj,segmRightMostj));
         }
       }
     }
   }
 }
 
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::expandSrcPhrase(const Hypothesis& hyp,
+                                                PositionIndex srcLeft,
+                                                PositionIndex srcRight,
+                                                std::vector<HypDataType>& hypDataVec,
+                                                std::vector<Hypothesis>& hypVec,
+                                                std::vector<ScoreComps>& scrCompVec)
+{
+  bool sentHasConstraints=!pbtmInputVars.constrTrgIdMap.empty();
+
+      // Obtain hypothesis data vector
+  getHypDataVecForGap(hyp,srcLeft,srcRight,hypDataVec,this->pbTransModelPars.W);
+  for(unsigned int i=0;i<hypDataVec.size();++i)
+  {
+        // Discard extensions violating translation constraints (only
+        // the new phrase needs to be checked)
+    if(sentHasConstraints && !lastPhraseSatisfiesConstraints(hypDataVec[i]))
+      continue;
+        // Create hypothesis extension in place
+    hypVec.push_back(Hypothesis());
+    scrCompVec.push_back(ScoreComps(ArenaAllocator<Score>(&getHypDataArena())));
+    this->incrScore(hyp,hypDataVec[i],hypVec.back(),scrCompVec.back());
+  }
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::expandInParallel(const std::vector<const Hypothesis*>& hypPtrVec,
+                                                 std::vector<std::vector<Hypothesis> >& expHypVecs,
+                                                 std::vector<std::vector<ScoreComps> >& scrCompVecs)
+{
+  ExpansionBatch batch;
+  std::vector<std::pair<PositionIndex,PositionIndex> > srcPhrVec;
+
+      // Create one task per hypothesis and source phrase
+  batch.modelPtr=this;
+  batch.hypPtrVec=hypPtrVec;
+  for(unsigned int i=0;i<hypPtrVec.size();++i)
+  {
+    getSrcPhrasesToExpand(*hypPtrVec[i],srcPhrVec);
+    for(unsigned int j=0;j<srcPhrVec.size();++j)
+    {
+      batch.taskVec.push_back(ExpansionTask());
+      batch.taskVec.back().hypIdx=i;
+      batch.taskVec.back().srcPhr=srcPhrVec[j];
+    }
+  }
+
+      // Execute tasks
+  expansionPool.run(batch.taskVec.size(),&_pbTransModel<HYPOTHESIS>::expansionTaskFunc,(void*) &batch);
+
+      // Merge results following the order of the tasks
+  expHypVecs.clear();
+  expHypVecs.resize(hypPtrVec.size());
+  scrCompVecs.clear();
+  scrCompVecs.resize(hypPtrVec.size());
+  for(unsigned int t=0;t<batch.taskVec.size();++t)
+  {
+    ExpansionTask& task=batch.taskVec[t];
+    std::vector<Hypothesis>& hypVec=expHypVecs[task.hypIdx];
+    std::vector<ScoreComps>& scrCompVec=scrCompVecs[task.hypIdx];
+    hypVec.insert(hypVec.end(),task.hypVec.begin(),task.hypVec.end());
+    for(unsigned int i=0;i<task.scrCompVec.size();++i)
+    {
+      scrCompVec.push_back(ScoreComps());
+      scrCompVec.back().swap(task.scrCompVec[i]);
+    }
+  }
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::expansionTaskFunc(void* data,
+                                                  unsigned int taskIdx,
+                                                  unsigned int /*workerIdx*/)
+{
+  ExpansionBatch* batchPtr=(ExpansionBatch*) data;
+  ExpansionTask& task=batchPtr->taskVec[taskIdx];
+  std::vector<HypDataType> hypDataVec;
+  batchPtr->modelPtr->expandSrcPhrase(*batchPtr->hypPtrVec[task.hypIdx],
+                                      task.srcPhr.first,
+                                      task.srcPhr.second,
+                                      hypDataVec,
+                                      task.hypVec,
+                                      task.scrCompVec);
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+MonotonicArena& _pbTransModel<HYPOTHESIS>::getHypDataArena(void)
+{
+  unsigned int workerIdx=expansionPool.getCurrentWorkerIdx();
+  if(workerIdx==0)
+    return hypDataArena;
+  else
+    return workerHypDataArenaVec[workerIdx];
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::setNumExpansionThreads(unsigned int numThreads)
+{
+  expansionPool.setNumThreads(numThreads);
+  workerHypDataArenaVec.resize(expansionPool.getNumThreads());
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+unsigned int _pbTransModel<HYPOTHESIS>::getNumExpansionThreads(void)const
+{
+  return expansionPool.getNumThreads();
+}
+
 //---------------------------------
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::expand_ref(const Hypothesis& hyp,
                                            std::vector<Hypothesis>& hypVec,
-                                           std::vector<std::vector<Score> >& scrCompVec)
+                                           std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> srcPhrase;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -962,13 +1197,13 @@ void _pbTransModel<HYPOTHESIS>::expand_ref(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::expand_ver(const Hypothesis& hyp,
                                            std::vector<Hypothesis>& hypVec,
-                                           std::vector<std::vector<Score> >& scrCompVec)
+                                           std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> srcPhrase;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -1015,13 +1250,13 @@ void _pbTransModel<HYPOTHESIS>::expand_ver(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::expand_prefix(const Hypothesis& hyp,
                                               std::vector<Hypothesis>& hypVec,
-                                              std::vector<std::vector<Score> >& scrCompVec)
+                                              std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> srcPhrase;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -1068,14 +1303,26 @@ void _pbTransModel<HYPOTHESIS>::expand_prefix(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::addHeuristicToHyp(Hypothesis& hyp)
 {
-  hyp.addHeuristic(calcHeuristicScore(hyp));
+      // Store the heuristic score of the translation model in the
+      // hypothesis if not present, its extensions will update it
+      // incrementally (see updateTmHeurScore())
+  if(heuristicId!=NO_HEURISTIC && state==MODEL_TRANS_STATE && !hyp.getScoreInfoRef().tmHeurScoreValid)
+  {
+    HypScoreInfo hypScoreInfo=hyp.getScoreInfo();
+    hypScoreInfo.tmHeurScore=getLocalTmHeurScore(hyp);
+    hypScoreInfo.tmHeurScoreValid=true;
+    hyp.setScoreInfo(hypScoreInfo);
+  }
+  hyp.setHeuristic(calcHeuristicScore(hyp));
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::subtractHeuristicToHyp(Hypothesis& hyp)
 {
-  hyp.subtractHeuristic(calcHeuristicScore(hyp));
+      // The heuristic score added by addHeuristicToHyp() is stored in
+      // the hypothesis
+  hyp.setHeuristic(0);
 }
 
 //---------------------------------
@@ -1097,6 +1344,108 @@ void _pbTransModel<HYPOTHESIS>::clearTempVars(void)
 
       // Clear n-best translation cache data
   nbTransCacheData.clear();
+
+      // Clear translation options
+  transOptTable.clear();
+  transOptScrIdxVec.clear();
+
+      // Release hypothesis data of the previous sentence
+  hypDataArena.release();
+  for(unsigned int i=0;i<workerHypDataArenaVec.size();++i)
+    workerHypDataArenaVec[i].release();
+
+      // Clear temporary data of standard and custom features. Such
+      // data can be thread-specific, so it is cleared in each thread
+      // used to expand hypotheses
+  expansionPool.runOnEachWorker(&_pbTransModel<HYPOTHESIS>::clearFeatsTempVarsTaskFunc,(void*) this);
+}
+
+//---------------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::clearFeatsTempVars(void)
+{
+      // Clear temporary data of standard and custom features
+      // (on-the-fly features are created for each sentence)
+  if(standardFeaturesInfoPtr!=NULL)
+  {
+    for(unsigned int i=0;i<standardFeaturesInfoPtr->featPtrVec.size();++i)
+      standardFeaturesInfoPtr->featPtrVec[i]->clearTempVars();
+  }
+  if(customFeaturesInfoPtr!=NULL)
+  {
+    for(unsigned int i=0;i<customFeaturesInfoPtr->featPtrVec.size();++i)
+      customFeaturesInfoPtr->featPtrVec[i]->clearTempVars();
+  }
+}
+
+//---------------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::clearFeatsTempVarsTaskFunc(void* data,
+                                                           unsigned int /*taskIdx*/,
+                                                           unsigned int /*workerIdx*/)
+{
+  ((_pbTransModel<HYPOTHESIS>*) data)->clearFeatsTempVars();
+}
+
+//---------------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::fillTransOptionTable(void)
+{
+      // Collect features in the order used to score hypotheses
+  std::vector<BasePbTransModelFeature<HypScoreInfo>*> featPtrVec;
+  if(standardFeaturesInfoPtr!=NULL)
+    featPtrVec.insert(featPtrVec.end(),standardFeaturesInfoPtr->featPtrVec.begin(),standardFeaturesInfoPtr->featPtrVec.end());
+  if(customFeaturesInfoPtr!=NULL)
+    featPtrVec.insert(featPtrVec.end(),customFeaturesInfoPtr->featPtrVec.begin(),customFeaturesInfoPtr->featPtrVec.end());
+  featPtrVec.insert(featPtrVec.end(),onTheFlyFeaturesInfo.featPtrVec.begin(),onTheFlyFeaturesInfo.featPtrVec.end());
+
+      // Assign a score position to each context-free feature
+  std::vector<BasePbTransModelFeature<HypScoreInfo>*> ctxFreeFeatPtrVec;
+  transOptScrIdxVec.clear();
+  for(unsigned int i=0;i<featPtrVec.size();++i)
+  {
+    if(featPtrVec[i]->isContextFree())
+    {
+      transOptScrIdxVec.push_back(ctxFreeFeatPtrVec.size());
+      ctxFreeFeatPtrVec.push_back(featPtrVec[i]);
+    }
+    else
+      transOptScrIdxVec.push_back(-1);
+  }
+
+      // Obtain translation options for every source phrase. The
+      // feature scores obtained to build the n-best lists of the spans
+      // are reused for the options
+  PositionIndex srcSentLen=pbtmInputVars.srcSentVec.size();
+  transOptTable.init(srcSentLen,this->pbTransModelPars.A,ctxFreeFeatPtrVec.size());
+  std::vector<std::string> srcPhraseStr;
+  std::vector<Score> scoreVec(ctxFreeFeatPtrVec.size());
+  std::map<std::vector<WordIndex>,std::vector<Score> > unweightedScrMap;
+  for(PositionIndex srcLeft=1;srcLeft<=srcSentLen;++srcLeft)
+  {
+    srcPhraseStr.clear();
+    for(PositionIndex srcRight=srcLeft;srcRight<=srcSentLen && srcRight-srcLeft+1<=this->pbTransModelPars.A;++srcRight)
+    {
+      srcPhraseStr.push_back(pbtmInputVars.srcSentVec[srcRight-1]);
+      NbestTableNode<PhraseTransTableNodeData> nbt;
+      getNbestTransForSrcPhraseStr(srcPhraseStr,nbt,this->pbTransModelPars.W,ctxFreeFeatPtrVec.empty() ? NULL : &unweightedScrMap);
+      NbestTransList& nbtList=nbTransCacheData.cPhrNbestTransList[std::make_pair(srcLeft,srcRight)];
+      nbtList.init(nbt);
+      if(ctxFreeFeatPtrVec.empty())
+        continue;
+
+      for(unsigned int k=0;k<nbtList.size();++k)
+      {
+        const std::vector<Score>& unweightedScoreVec=unweightedScrMap[nbtList.getTrgPhrase(k)];
+        for(unsigned int i=0;i<transOptScrIdxVec.size();++i)
+        {
+          if(transOptScrIdxVec[i]>=0)
+            scoreVec[transOptScrIdxVec[i]]=unweightedScoreVec[i];
+        }
+        transOptTable.addOption(srcLeft,srcRight,nbtList.getTrgPhrase(k),scoreVec);
+      }
+    }
+  }
 }
 
 //---------------------------------------
@@ -1204,8 +1553,7 @@ template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::initHeuristicLocalt(int maxSrcPhraseLength)
 {
   std::vector<Score> row;
-  NbestTableNode<PhraseTransTableNodeData> ttNode;
-  NbestTableNode<PhraseTransTableNodeData>::iterator ttNodeIter;
+  unsigned int numTrans;
   Score compositionProduct;
   Score bestScore_ts=0;
   Score score_ts;
@@ -1229,7 +1577,7 @@ void _pbTransModel<HYPOTHESIS>::initHeuristicLocalt(int maxSrcPhraseLength)
           // obtain score for best translation
       if((segmRightMostj-segmLeftMostj)+1>(unsigned int)maxSrcPhraseLength)
       {
-        ttNode.clear();
+        numTrans=0;
       }
       else
       {
@@ -1238,17 +1586,19 @@ void _pbTransModel<HYPOTHESIS>::initHeuristicLocalt(int maxSrcPhraseLength)
           srcPhrase.push_back(pbtmInputVars.nsrcSentIdVec[j]);
   
             // Obtain translations for srcPhrase
-        getNbestTransForSrcPhraseCached(segmLeftMostj,segmRightMostj,ttNode,this->pbTransModelPars.W);
-        if(ttNode.size()!=0) // Obtain best p(srcPhrase|t_)
+        const NbestTransList& nbtList=getNbestTransForSrcPhraseCached(segmLeftMostj,segmRightMostj,this->pbTransModelPars.W);
+        numTrans=nbtList.size();
+        if(numTrans!=0) // Obtain best p(srcPhrase|t_)
         {
           bestScore_ts=-FLT_MAX;
-          for(ttNodeIter=ttNode.begin();ttNodeIter!=ttNode.end();++ttNodeIter)
+          for(unsigned int k=0;k<numTrans;++k)
           {
                 // Obtain phrase to phrase translation probability
-            score_ts=heurDirectPmScoreLt(srcPhrase,ttNodeIter->second)+heurInversePmScoreLt(srcPhrase,ttNodeIter->second);
+            const PhraseTransTableNodeData& trgPhrase=nbtList.getTrgPhrase(k);
+            score_ts=heurDirectPmScoreLt(srcPhrase,trgPhrase)+heurInversePmScoreLt(srcPhrase,trgPhrase);
 
                 // Obtain language model heuristic estimation
-            score_ts+=heurLmScoreLtNoAdmiss(ttNodeIter->second);
+            score_ts+=heurLmScoreLtNoAdmiss(trgPhrase);
             
             if(bestScore_ts<score_ts) bestScore_ts=score_ts;
           }
@@ -1259,7 +1609,7 @@ void _pbTransModel<HYPOTHESIS>::initHeuristicLocalt(int maxSrcPhraseLength)
       if(x==J-y-1)
       {
             // source phrase has only one word
-        if(ttNode.size()!=0)
+        if(numTrans!=0)
         {
           heuristicScoreVec[y][x]=bestScore_ts;
         }
@@ -1271,7 +1621,7 @@ void _pbTransModel<HYPOTHESIS>::initHeuristicLocalt(int maxSrcPhraseLength)
       else
       {
             // source phrase has more than one word
-        if(ttNode.size()!=0)
+        if(numTrans!=0)
         {
           heuristicScoreVec[y][x]=bestScore_ts;
         }
@@ -1504,18 +1854,50 @@ Score _pbTransModel<HYPOTHESIS>::heuristicLocaltd(const Hypothesis& hyp)
 template<class HYPOTHESIS>
 Score _pbTransModel<HYPOTHESIS>::getLocalTmHeurScore(const Hypothesis& hyp)
 {
+  const HypScoreInfo& hypScoreInfo=hyp.getScoreInfoRef();
+  if(hypScoreInfo.tmHeurScoreValid)
+    return hypScoreInfo.tmHeurScore;
+  
   Score result=0;  
-  unsigned int J=pbtmInputVars.srcSentVec.size();
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   this->extract_gaps(hyp,gaps);
   for(unsigned int i=0;i<gaps.size();++i)
   {
-    result+=heuristicScoreVec[gaps[i].second-1][J-gaps[i].first];	
+    result+=getGapTmHeurScore(gaps[i].first,gaps[i].second);
   }
   
   return result;
 }
 
+//---------------------------------
+template<class HYPOTHESIS>
+Score _pbTransModel<HYPOTHESIS>::getGapTmHeurScore(PositionIndex gapLeft,
+                                                   PositionIndex gapRight)const
+{
+  unsigned int J=pbtmInputVars.srcSentVec.size();
+  return heuristicScoreVec[gapRight-1][J-gapLeft];
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+void _pbTransModel<HYPOTHESIS>::updateTmHeurScore(PositionIndex gapLeft,
+                                                  PositionIndex gapRight,
+                                                  PositionIndex srcLeft,
+                                                  PositionIndex srcRight,
+                                                  HypScoreInfo& hypScoreInfo)const
+{
+  if(!hypScoreInfo.tmHeurScoreValid)
+    return;
+  
+      // Replace the score of the gap by those of the gaps it is split
+      // into
+  hypScoreInfo.tmHeurScore-=getGapTmHeurScore(gapLeft,gapRight);
+  if(gapLeft<srcLeft)
+    hypScoreInfo.tmHeurScore+=getGapTmHeurScore(gapLeft,srcLeft-1);
+  if(srcRight<gapRight)
+    hypScoreInfo.tmHeurScore+=getGapTmHeurScore(srcRight+1,gapRight);
+}
+
 //---------------------------------
 template<class HYPOTHESIS>
 Score _pbTransModel<HYPOTHESIS>::getDistortionHeurScore(const Hypothesis& hyp)
@@ -1562,12 +1944,12 @@ void _pbTransModel<HYPOTHESIS>::printHyp(const Hypothesis& hyp,
 
       // Obtain null hypothesis score components
   Hypothesis nullHyp;
-  std::vector<Score> nullHypScoreComponents;
+  ScoreComps nullHypScoreComponents;
   this->nullHypothesisScrComps(nullHyp,nullHypScoreComponents);
   
       // Obtain extension score components
   Hypothesis auxHyp;
-  std::vector<Score> extScoreComponents;
+  ScoreComps extScoreComponents;
   HypDataType hypDataType=hyp.getData();
   this->incrScore(nullHyp,hypDataType,auxHyp,extScoreComponents);
 
@@ -1951,10 +2333,10 @@ unsigned int _pbTransModel<HYPOTHESIS>::getNumWeights(void)
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _pbTransModel<HYPOTHESIS>::getUnweightedComps(const std::vector<Score>& scrComps,
+void _pbTransModel<HYPOTHESIS>::getUnweightedComps(const ScoreComps& scrComps,
                                                    std::vector<Score>& unweightedScrComps)
 {
-  unweightedScrComps=scrComps;
+  unweightedScrComps.assign(scrComps.begin(),scrComps.end());
 }
 
 //---------------------------------
@@ -1968,7 +2350,7 @@ void _pbTransModel<HYPOTHESIS>::extendHypData(PositionIndex srcLeft,
   
   for(unsigned int i=0;i<trgPhrase.size();++i)
     trgPhraseIdx.push_back(stringToTrgWordIndex(trgPhrase[i]));
-  extendHypDataIdx(srcLeft,srcRight,trgPhraseIdx,hypd);
+  extendHypDataIdx(srcLeft,srcRight,trgPhraseIdx,TRANS_OPT_NOT_FOUND,hypd);
 }
 
 //---------------------------------
@@ -1985,31 +2367,39 @@ bool _pbTransModel<HYPOTHESIS>::getHypDataVecForGap(const Hypothesis& hyp,
   hypDataTypeVec.clear();
 
       // Obtain translations for gap
-  NbestTableNode<PhraseTransTableNodeData> ttNode;
-  getTransForHypUncovGap(hyp,srcLeft,srcRight,ttNode,N);
+  NbestTransList auxList;
+  const NbestTransList& nbtList=getTransForHypUncovGap(hyp,srcLeft,srcRight,auxList,N);
 
   if(this->verbosity>=2)
   {
     std::cerr<<"  trying to cover from src. pos. "<<srcLeft<<" to "<<srcRight<<"; ";
-    std::cerr<<"Filtered "<<ttNode.size()<<" translations"<<std::endl;
+    std::cerr<<"Filtered "<<nbtList.size()<<" translations"<<std::endl;
   }
 
+      // Options of the list are stored in the translation option
+      // table when it is taken from the cache of the span
+  int firstOptIdx=TRANS_OPT_NOT_FOUND;
+  if(&nbtList!=&auxList && transOptTable.getNumOptions(srcLeft,srcRight)==nbtList.size())
+    firstOptIdx=transOptTable.getFirstOptionIdx(srcLeft,srcRight);
+
       // Generate hypothesis data for translations
-  NbestTableNode<PhraseTransTableNodeData>::iterator ttNodeIter;
-  for(ttNodeIter=ttNode.begin();ttNodeIter!=ttNode.end();++ttNodeIter)
+  for(unsigned int k=0;k<nbtList.size();++k)
   {
+    const PhraseTransTableNodeData& trgPhrase=nbtList.getTrgPhrase(k);
     if(this->verbosity>=3)
     {
       std::cerr<<"   ";
       for(unsigned int i=srcLeft;i<=srcRight;++i) std::cerr<<this->pbtmInputVars.srcSentVec[i-1]<<" ";
       std::cerr<<"||| ";
-      for(unsigned int i=0;i<ttNodeIter->second.size();++i)
-        std::cerr<<this->wordIndexToTrgString(ttNodeIter->second[i])<<" ";
-      std::cerr<<"||| "<<ttNodeIter->first<<std::endl;
+      for(unsigned int i=0;i<trgPhrase.size();++i)
+        std::cerr<<this->wordIndexToTrgString(trgPhrase[i])<<" ";
+      std::cerr<<"||| "<<nbtList.getScore(k)<<std::endl;
     }
 
     newHypData=hypData;
-    extendHypDataIdx(srcLeft,srcRight,ttNodeIter->second,newHypData);
+    extendHypDataIdx(srcLeft,srcRight,trgPhrase,
+                     firstOptIdx==TRANS_OPT_NOT_FOUND ? TRANS_OPT_NOT_FOUND : firstOptIdx+(int)k,
+                     newHypData);
     hypDataTypeVec.push_back(newHypData);
   }
 
@@ -2032,31 +2422,31 @@ bool _pbTransModel<HYPOTHESIS>::getHypDataVecForGapRef(const Hypothesis& hyp,
   hypDataTypeVec.clear();
 
       // Obtain translation for gap
-  NbestTableNode<PhraseTransTableNodeData> ttNode;
-  getTransForHypUncovGapRef(hyp,srcLeft,srcRight,ttNode,N);
+  NbestTransList auxList;
+  const NbestTransList& nbtList=getTransForHypUncovGapRef(hyp,srcLeft,srcRight,auxList,N);
 
   if(this->verbosity>=2)
   {
     std::cerr<<"  trying to cover from src. pos. "<<srcLeft<<" to "<<srcRight<<"; ";
-    std::cerr<<"Filtered "<<ttNode.size()<<" translations"<<std::endl;
+    std::cerr<<"Filtered "<<nbtList.size()<<" translations"<<std::endl;
   }
 
       // Generate hypothesis data for translations
-  NbestTableNode<PhraseTransTableNodeData>::iterator ttNodeIter;
-  for(ttNodeIter=ttNode.begin();ttNodeIter!=ttNode.end();++ttNodeIter)
+  for(unsigned int k=0;k<nbtList.size();++k)
   {
+    const PhraseTransTableNodeData& trgPhrase=nbtList.getTrgPhrase(k);
     if(this->verbosity>=3)
     {
       std::cerr<<"   ";
       for(unsigned int i=srcLeft;i<=srcRight;++i) std::cerr<<this->pbtmInputVars.srcSentVec[i-1]<<" ";
       std::cerr<<"||| ";
-      for(unsigned int i=0;i<ttNodeIter->second.size();++i)
-        std::cerr<<this->wordIndexToTrgString(ttNodeIter->second[i])<<" ";
-      std::cerr<<"||| "<<ttNodeIter->first<<std::endl;
+      for(unsigned int i=0;i<trgPhrase.size();++i)
+        std::cerr<<this->wordIndexToTrgString(trgPhrase[i])<<" ";
+      std::cerr<<"||| "<<nbtList.getScore(k)<<std::endl;
     }
 
     newHypData=hypData;
-    extendHypDataIdx(srcLeft,srcRight,ttNodeIter->second,newHypData);
+    extendHypDataIdx(srcLeft,srcRight,trgPhrase,TRANS_OPT_NOT_FOUND,newHypData);
     bool equal;
     if(hypDataTransIsPrefixOfTargetRef(newHypData,equal))
     {
@@ -2084,31 +2474,31 @@ bool _pbTransModel<HYPOTHESIS>::getHypDataVecForGapVer(const Hypothesis& hyp,
   hypDataTypeVec.clear();
   
       // Obtain translation for gap
-  NbestTableNode<PhraseTransTableNodeData> ttNode;
-  getTransForHypUncovGapVer(hyp,srcLeft,srcRight,ttNode,N);
+  NbestTransList auxList;
+  const NbestTransList& nbtList=getTransForHypUncovGapVer(hyp,srcLeft,srcRight,auxList,N);
 
   if(this->verbosity>=2)
   {
     std::cerr<<"  trying to cover from src. pos. "<<srcLeft<<" to "<<srcRight<<"; ";
-    std::cerr<<"Filtered "<<ttNode.size()<<" translations"<<std::endl;
+    std::cerr<<"Filtered "<<nbtList.size()<<" translations"<<std::endl;
   }
 
       // Generate hypothesis data for translations
-  NbestTableNode<PhraseTransTableNodeData>::iterator ttNodeIter;
-  for(ttNodeIter=ttNode.begin();ttNodeIter!=ttNode.end();++ttNodeIter)
+  for(unsigned int k=0;k<nbtList.size();++k)
   {
+    const PhraseTransTableNodeData& trgPhrase=nbtList.getTrgPhrase(k);
     if(this->verbosity>=3)
     {
       std::cerr<<"   ";
       for(unsigned int i=srcLeft;i<=srcRight;++i) std::cerr<<this->pbtmInputVars.srcSentVec[i-1]<<" ";
       std::cerr<<"||| ";
-      for(unsigned int i=0;i<ttNodeIter->second.size();++i)
-        std::cerr<<this->wordIndexToTrgString(ttNodeIter->second[i])<<" ";
-      std::cerr<<"||| "<<ttNodeIter->first<<std::endl;
+      for(unsigned int i=0;i<trgPhrase.size();++i)
+        std::cerr<<this->wordIndexToTrgString(trgPhrase[i])<<" ";
+      std::cerr<<"||| "<<nbtList.getScore(k)<<std::endl;
     }
 
     newHypData=hypData;
-    extendHypDataIdx(srcLeft,srcRight,ttNodeIter->second,newHypData);
+    extendHypDataIdx(srcLeft,srcRight,trgPhrase,TRANS_OPT_NOT_FOUND,newHypData);
     bool equal;
     if(hypDataTransIsPrefixOfTargetRef(newHypData,equal))
     {
@@ -2136,31 +2526,31 @@ bool _pbTransModel<HYPOTHESIS>::getHypDataVecForGapPref(const Hypothesis& hyp,
   hypDataTypeVec.clear();
   
       // Obtain translation for gap
-  NbestTableNode<PhraseTransTableNodeData> ttNode;
-  getTransForHypUncovGapPref(hyp,srcLeft,srcRight,ttNode,N);
+  NbestTransList auxList;
+  const NbestTransList& nbtList=getTransForHypUncovGapPref(hyp,srcLeft,srcRight,auxList,N);
 
   if(this->verbosity>=2)
   {
     std::cerr<<"  trying to cover from src. pos. "<<srcLeft<<" to "<<srcRight<<"; ";
-    std::cerr<<"Filtered "<<ttNode.size()<<" translations"<<std::endl;
+    std::cerr<<"Filtered "<<nbtList.size()<<" translations"<<std::endl;
   }
 
       // Generate hypothesis data for translations
-  NbestTableNode<PhraseTransTableNodeData>::iterator ttNodeIter;
-  for(ttNodeIter=ttNode.begin();ttNodeIter!=ttNode.end();++ttNodeIter)
+  for(unsigned int k=0;k<nbtList.size();++k)
   {
+    const PhraseTransTableNodeData& trgPhrase=nbtList.getTrgPhrase(k);
     if(this->verbosity>=3)
     {
       std::cerr<<"   ";
       for(unsigned int i=srcLeft;i<=srcRight;++i) std::cerr<<this->pbtmInputVars.srcSentVec[i-1]<<" ";
       std::cerr<<"||| ";
-      for(unsigned int i=0;i<ttNodeIter->second.size();++i)
-        std::cerr<<this->wordIndexToTrgString(ttNodeIter->second[i])<<" ";
-      std::cerr<<"||| "<<ttNodeIter->first<<std::endl;
+      for(unsigned int i=0;i<trgPhrase.size();++i)
+        std::cerr<<this->wordIndexToTrgString(trgPhrase[i])<<" ";
+      std::cerr<<"||| "<<nbtList.getScore(k)<<std::endl;
     }
 
     newHypData=hypData;
-    extendHypDataIdx(srcLeft,srcRight,ttNodeIter->second,newHypData);
+    extendHypDataIdx(srcLeft,srcRight,trgPhrase,TRANS_OPT_NOT_FOUND,newHypData);
     hypDataTypeVec.push_back(newHypData);
   }
 
@@ -2345,29 +2735,42 @@ std::vector<std::string> _pbTransModel<HYPOTHESIS>::getLogLinFeatNamesForPhrTran
 template<class HYPOTHESIS>
 Score _pbTransModel<HYPOTHESIS>::nbestTransScore(const std::vector<WordIndex>& srcPhrase,
                                                  const std::vector<WordIndex>& trgPhrase)
+{
+      // Features score phrase pairs given as strings
+  std::vector<Score> unweightedScoreVec;
+  return nbestTransScoreStr(srcIndexVectorToStrVector(srcPhrase),
+                            trgIndexVectorToStrVector(trgPhrase),
+                            unweightedScoreVec);
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+Score _pbTransModel<HYPOTHESIS>::nbestTransScoreStr(const std::vector<std::string>& srcPhraseStr,
+                                                    const std::vector<std::string>& trgPhraseStr,
+                                                    std::vector<Score>& unweightedScoreVec)
 {
   Score result=0;
-  
-      // Obtain string vectors
-  std::vector<std::string> srcPhraseStr=srcIndexVectorToStrVector(srcPhrase);
-  std::vector<std::string> trgPhraseStr=trgIndexVectorToStrVector(trgPhrase);
+  unweightedScoreVec.clear();
   
       // Obtain score for each standard feature
   for(unsigned int i=0;i<this->standardFeaturesInfoPtr->featPtrVec.size();++i)
   {
-    result+=getStdFeatWeight(i) * this->standardFeaturesInfoPtr->featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr);
+    unweightedScoreVec.push_back(this->standardFeaturesInfoPtr->featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr));
+    result+=getStdFeatWeight(i) * unweightedScoreVec.back();
   }
 
       // Obtain score for each custom feature
   for(unsigned int i=0;i<this->customFeaturesInfoPtr->featPtrVec.size();++i)
   {
-    result+=getCustomFeatWeight(i) * this->customFeaturesInfoPtr->featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr);
+    unweightedScoreVec.push_back(this->customFeaturesInfoPtr->featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr));
+    result+=getCustomFeatWeight(i) * unweightedScoreVec.back();
   }
 
       // Obtain score for each on-the-fly feature
   for(unsigned int i=0;i<this->onTheFlyFeaturesInfo.featPtrVec.size();++i)
   {
-    result+=getOnTheFlyFeatWeight(i) * this->onTheFlyFeaturesInfo.featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr);
+    unweightedScoreVec.push_back(this->onTheFlyFeaturesInfo.featPtrVec[i]->scorePhrasePairUnweighted(srcPhraseStr,trgPhraseStr));
+    result+=getOnTheFlyFeatWeight(i) * unweightedScoreVec.back();
   }
 
   return result;
@@ -2383,18 +2786,16 @@ Score _pbTransModel<EQCLASS_FUNC>::nbestTransScoreLast(const std::vector<WordInd
 
 //---------------------------------
 template<class HYPOTHESIS>
-bool _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhraseCached(PositionIndex srcLeft,
-                                                                PositionIndex srcRight,
-                                                                NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                                float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhraseCached(PositionIndex srcLeft,
+                                                                                 PositionIndex srcRight,
+                                                                                 float N)
 {
-  NbestTableNode<PhraseTransTableNodeData>* transTableNodePtr=nbTransCacheData.cPhrNbestTransTable.getTranslationsForKey(std::make_pair(srcLeft,srcRight));
-  if(transTableNodePtr!=NULL)
+  std::pair<PositionIndex,PositionIndex> key=std::make_pair(srcLeft,srcRight);
+  std::map<std::pair<PositionIndex,PositionIndex>,NbestTransList>::const_iterator mapIter=nbTransCacheData.cPhrNbestTransList.find(key);
+  if(mapIter!=nbTransCacheData.cPhrNbestTransList.end())
   {
         // translation present in the cache translation table
-    nbt=*transTableNodePtr;
-    if(nbt.size()==0) return false;
-    else return true;
+    return mapIter->second;
   }
   else
   {
@@ -2404,10 +2805,11 @@ bool _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhraseCached(PositionIndex sr
     {
       srcPhrase.push_back(pbtmInputVars.nsrcSentIdVec[i]);
     }
+    NbestTableNode<PhraseTransTableNodeData> nbt;
     getNbestTransForSrcPhrase(srcPhrase,nbt,N);
-    nbTransCacheData.cPhrNbestTransTable.insertEntry(std::make_pair(srcLeft,srcRight),nbt);
-    if(nbt.size()==0) return false;
-    else return true;
+    NbestTransList& nbtList=nbTransCacheData.cPhrNbestTransList[key];
+    nbtList.init(nbt);
+    return nbtList;
   }
 }
 
@@ -2417,27 +2819,42 @@ bool _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhrase(std::vector<WordIndex>
                                                           NbestTableNode<PhraseTransTableNodeData>& nbt,
                                                           float N)
 {
-  BasePhraseModel::SrcTableNode srctn;
-  BasePhraseModel::SrcTableNode::iterator srctnIter;
-  bool ret;
+  return getNbestTransForSrcPhraseStr(srcIndexVectorToStrVector(srcPhrase),nbt,N,NULL);
+}
 
-      // Obtain the whole list of translations
+//---------------------------------
+template<class HYPOTHESIS>
+bool _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhraseStr(const std::vector<std::string>& srcPhraseStr,
+                                                             NbestTableNode<PhraseTransTableNodeData>& nbt,
+                                                             float N,
+                                                             std::map<std::vector<WordIndex>,std::vector<Score> >* unweightedScrMapPtr)
+{
+      // Obtain the whole list of translations (the translations are
+      // scored following the order of their word indices)
   nbt.clear();
-  std::set<std::vector<WordIndex> > transSet;
-  ret=getTransForSrcPhrase(srcPhrase,transSet);
-  if(!ret) return false;
-  else
+  if(unweightedScrMapPtr)
+    unweightedScrMapPtr->clear();
+  std::set<std::vector<std::string> > transSetStr;
+  getTransForSrcPhraseStr(srcPhraseStr,transSetStr);
+  std::map<std::vector<WordIndex>,const std::vector<std::string>*> transMap;
+  std::set<std::vector<std::string> >::const_iterator setIter;
+  for(setIter=transSetStr.begin();setIter!=transSetStr.end();++setIter)
+    transMap[strVectorToTrgIndexVector(*setIter)]=&(*setIter);
+  if(transMap.empty())
+    return false;
+  
+      // This loop may become a bottleneck if the number of translation
+      // options is high
+  std::vector<Score> unweightedScoreVec;
+  std::map<std::vector<WordIndex>,const std::vector<std::string>*>::const_iterator mapIter;
+  for(mapIter=transMap.begin();mapIter!=transMap.end();++mapIter)
   {
-    Score scr;
-
-        // This loop may become a bottleneck if the number of translation
-        // options is high
-    for(std::set<std::vector<WordIndex> >::iterator transSetIter=transSet.begin();transSetIter!=transSet.end();++transSetIter)
-    {
-      scr=nbestTransScoreCached(srcPhrase,*transSetIter);
-      nbt.insert(scr,*transSetIter);
-    }
+    Score scr=nbestTransScoreStr(srcPhraseStr,*mapIter->second,unweightedScoreVec);
+    nbt.insert(scr,mapIter->first);
+    if(unweightedScrMapPtr)
+      (*unweightedScrMapPtr)[mapIter->first]=unweightedScoreVec;
   }
+
       // Prune the list depending on the value of N
       // retrieve translations from table
   if(N>=1)
@@ -2452,11 +2869,61 @@ bool _pbTransModel<HYPOTHESIS>::getNbestTransForSrcPhrase(std::vector<WordIndex>
 
 //---------------------------------
 template<class HYPOTHESIS>
-bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGap(const Hypothesis& /*hyp*/,
-                                                       PositionIndex srcLeft,
-                                                       PositionIndex srcRight,
-                                                       NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                       float N)
+void _pbTransModel<HYPOTHESIS>::initConstrTrgIdMap(void)
+{
+  pbtmInputVars.constrTrgIdMap.clear();
+  std::set<std::pair<PositionIndex,PositionIndex> > srcPhrSet=this->trMetadataPtr->getConstrainedSrcPhrases();
+  std::set<std::pair<PositionIndex,PositionIndex> >::const_iterator const_iter;
+  for(const_iter=srcPhrSet.begin();const_iter!=srcPhrSet.end();++const_iter)
+  {
+    std::vector<std::string> trgPhr=this->trMetadataPtr->getTransForSrcPhr(*const_iter);
+    std::vector<WordIndex>& trgWiVec=pbtmInputVars.constrTrgIdMap[*const_iter];
+    for(unsigned int i=0;i<trgPhr.size();++i)
+      trgWiVec.push_back(stringToTrgWordIndex(trgPhr[i]));
+  }
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+bool _pbTransModel<HYPOTHESIS>::lastPhraseSatisfiesConstraints(const HypDataType& hypd)const
+{
+  const PhrHypNode* node=hypd.getLastPhraseNode();
+  if(node==NULL)
+    return true;
+
+      // Check the constraints whose first source position is covered
+      // by the last phrase
+  std::map<std::pair<PositionIndex,PositionIndex>,std::vector<WordIndex> >::const_iterator const_iter;
+  const_iter=pbtmInputVars.constrTrgIdMap.lower_bound(std::make_pair(node->srcSegm.first,(PositionIndex)0));
+  for(;const_iter!=pbtmInputVars.constrTrgIdMap.end() && const_iter->first.first<=node->srcSegm.second;++const_iter)
+  {
+        // The constrained source phrase has to be translated as a
+        // whole by the last phrase
+    if(const_iter->first!=node->srcSegm)
+      return false;
+
+        // The target phrase has to be equal to the constrained one.
+        // Unknown words are accepted since they are replaced by the
+        // constrained words when the translation is generated
+    const std::vector<WordIndex>& trgWiVec=const_iter->second;
+    if(trgWiVec.size()!=node->trgPhraseLen)
+      return false;
+    for(unsigned int i=0;i<trgWiVec.size();++i)
+    {
+      if(node->trgPhrase[i]!=trgWiVec[i] && node->trgPhrase[i]!=UNK_WORD)
+        return false;
+    }
+  }
+  return true;
+}
+
+//---------------------------------
+template<class HYPOTHESIS>
+const NbestTransList& _pbTransModel<HYPOTHESIS>::getTransForHypUncovGap(const Hypothesis& /*hyp*/,
+                                                                        PositionIndex srcLeft,
+                                                                        PositionIndex srcRight,
+                                                                        NbestTransList& auxList,
+                                                                        float N)
 {
         // Check if gap is affected by translation constraints
   if(this->trMetadataPtr->srcPhrAffectedByConstraint(std::make_pair(srcLeft,srcRight)))
@@ -2473,16 +2940,15 @@ bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGap(const Hypothesis& /*hyp*/
         trgWiVec.push_back(w);
       }
       
-          // Insert translation into n-best table
-      nbt.clear();      
-      nbt.insert(0,trgWiVec);      
-      return true;
+          // Insert translation into n-best list
+      auxList.initSingle(0,trgWiVec);
+      return auxList;
     }
     else
     {
           // No constrained target translation was found
-      nbt.clear();
-      return false;
+      auxList.clear();
+      return auxList;
     }
   }
   else
@@ -2495,54 +2961,51 @@ bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGap(const Hypothesis& /*hyp*/
     {
       std::vector<WordIndex> unkWordVec;
       unkWordVec.push_back(UNK_WORD);
-      nbt.clear();
-      nbt.insert(0,unkWordVec);
-      return false;
+      auxList.initSingle(0,unkWordVec);
+      return auxList;
     }
     else
     {
           // search translations for source phrase in translation table
-      return getNbestTransForSrcPhraseCached(srcLeft,srcRight,nbt,N);
+      return getNbestTransForSrcPhraseCached(srcLeft,srcRight,N);
     }
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapRef(const Hypothesis& hyp,
-                                                          PositionIndex srcLeft,
-                                                          PositionIndex srcRight,
-                                                          NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                          float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapRef(const Hypothesis& hyp,
+                                                                           PositionIndex srcLeft,
+                                                                           PositionIndex srcRight,
+                                                                           NbestTransList& auxList,
+                                                                           float N)
 {  
   if(hyp.getPartialTrans().size()>pbtmInputVars.nrefSentIdVec.size())
-    return false;
+  {
+    auxList.clear();
+    return auxList;
+  }
   
   if(this->numberOfUncoveredSrcWords(hyp)-(srcRight-srcLeft+1)>0)
   {
         // This is not the last gap to be covered
-    transUncovGapRefNoLastGapCached(hyp,srcLeft,srcRight,nbt,N);
-    if(nbt.size()==0) return false;
-    else return true;
+    return transUncovGapRefNoLastGapCached(hyp,srcLeft,srcRight,N);
   }
   else
   {
         // The last gap will be covered
-    transUncovGapRefLastGapCached(hyp,srcLeft,srcRight,nbt);
-    if(nbt.size()==0) return false;
-    else return true;
+    transUncovGapRefLastGapCached(hyp,srcLeft,srcRight,auxList);
+    return auxList;
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _pbTransModel<HYPOTHESIS>::transUncovGapRefNoLastGapCached(const Hypothesis& hyp,
-                                                                PositionIndex srcLeft,
-                                                                PositionIndex srcRight,
-                                                                NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                                float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::transUncovGapRefNoLastGapCached(const Hypothesis& hyp,
+                                                                                 PositionIndex srcLeft,
+                                                                                 PositionIndex srcRight,
+                                                                                 float N)
 {
-  nbt.clear();
   std::vector<WordIndex> srcPhrase;
   std::vector<WordIndex> trgPhrase;
   std::vector<WordIndex> ntarget=hyp.getPartialTrans();
@@ -2570,22 +3033,23 @@ void _pbTransModel<HYPOTHESIS>::transUncovGapRefNoLastGapCached(const Hypothesis
     pNbtRefKey.numGaps=1;
   else
   {
-    Bitset<MAX_SENTENCE_LENGTH_ALLOWED> key=hyp.getKey();
-    for(unsigned int i=srcLeft;i<=srcRight;++i) key.set(i);
+    Coverage key=hyp.getKey();
+    key.setRange(srcLeft,srcRight);
     pNbtRefKey.numGaps=this->get_num_gaps(key);
   }
      
       // Search the required translations in the cache translation
       // table    
-  NbestTableNode<PhraseTransTableNodeData>* transTableNodePtr=nbTransCacheData.cPhrNbestTransTableRef.getTranslationsForKey(pNbtRefKey);
-  if(transTableNodePtr!=NULL)
+  std::map<PhrNbestTransTableRefKey,NbestTransList>::const_iterator mapIter=nbTransCacheData.cPhrNbestTransListRef.find(pNbtRefKey);
+  if(mapIter!=nbTransCacheData.cPhrNbestTransListRef.end())
   {
         // translations present in the cache translation table
-    nbt=*transTableNodePtr;
+    return mapIter->second;
   }
   else
   {
         // translations not present in the cache translation table
+    NbestTableNode<PhraseTransTableNodeData> nbt;
     for(PositionIndex i=ntarget.size();i<pbtmInputVars.nrefSentIdVec.size()-pNbtRefKey.numGaps;++i)
     {
       trgPhrase.push_back(pbtmInputVars.nrefSentIdVec[i]);
@@ -2603,19 +3067,21 @@ void _pbTransModel<HYPOTHESIS>::transUncovGapRefNoLastGapCached(const Hypothesis
       Score bscr=nbt.getScoreOfBestElem();
       nbt.pruneGivenThreshold(bscr+(double)log(N));
     }
-        // Store the list in cPhrNbestTransTableRef
-    nbTransCacheData.cPhrNbestTransTableRef.insertEntry(pNbtRefKey,nbt);
+        // Store the list in cPhrNbestTransListRef
+    NbestTransList& nbtList=nbTransCacheData.cPhrNbestTransListRef[pNbtRefKey];
+    nbtList.init(nbt);
+    return nbtList;
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
 void _pbTransModel<HYPOTHESIS>::transUncovGapRefLastGapCached(const Hypothesis& hyp,
-                                                              PositionIndex srcLeft,
-                                                              PositionIndex srcRight,
-                                                              NbestTableNode<PhraseTransTableNodeData>& nbt)
+                                                        PositionIndex srcLeft,
+                                                        PositionIndex srcRight,
+                                                        NbestTransList& auxList)
 {
-  nbt.clear();
+  auxList.clear();
   std::vector<WordIndex> srcPhrase;
   std::vector<WordIndex> trgPhrase;
   std::vector<WordIndex> ntarget=hyp.getPartialTrans();
@@ -2639,52 +3105,49 @@ void _pbTransModel<HYPOTHESIS>::transUncovGapRefLastGapCached(const Hypothesis&
   if(trgPhrase.size()>=minTrgSize && trgPhrase.size()<=maxTrgSize)
   {
     Score scr=nbestTransScoreCached(srcPhrase,trgPhrase);
-    nbt.insert(scr,trgPhrase);
+    auxList.initSingle(scr,trgPhrase);
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapVer(const Hypothesis& hyp,
-                                                          PositionIndex srcLeft,
-                                                          PositionIndex srcRight,
-                                                          NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                          float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapVer(const Hypothesis& hyp,
+                                                                           PositionIndex srcLeft,
+                                                                           PositionIndex srcRight,
+                                                                           NbestTransList& auxList,
+                                                                           float N)
 {
-  return getTransForHypUncovGap(hyp,srcLeft,srcRight,nbt,N);
+  return getTransForHypUncovGap(hyp,srcLeft,srcRight,auxList,N);
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-bool _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapPref(const Hypothesis& hyp,
-                                                           PositionIndex srcLeft,
-                                                           PositionIndex srcRight,
-                                                           NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                           float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::getTransForHypUncovGapPref(const Hypothesis& hyp,
+                                                                            PositionIndex srcLeft,
+                                                                            PositionIndex srcRight,
+                                                                            NbestTransList& auxList,
+                                                                            float N)
 {
   unsigned int ntrgSize=hyp.getPartialTrans().size();
       // Check if the prefix has been generated
   if(ntrgSize<pbtmInputVars.nprefSentIdVec.size())
   {
-    transUncovGapPrefNoGenCached(hyp,srcLeft,srcRight,nbt,N);
-    if(nbt.size()==0) return false;
-    else return true;
+    return transUncovGapPrefNoGenCached(hyp,srcLeft,srcRight,N);
   }
   else
   {
         // The prefix has been completely generated, the nbest list
         // is obtained as if no prefix was given
-    return getTransForHypUncovGap(hyp,srcLeft,srcRight,nbt,N);
+    return getTransForHypUncovGap(hyp,srcLeft,srcRight,auxList,N);
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _pbTransModel<HYPOTHESIS>::transUncovGapPrefNoGenCached(const Hypothesis& hyp,
-                                                             PositionIndex srcLeft,
-                                                             PositionIndex srcRight,
-                                                             NbestTableNode<PhraseTransTableNodeData>& nbt,
-                                                             float N)
+const NbestTransList& _pbTransModel<HYPOTHESIS>::transUncovGapPrefNoGenCached(const Hypothesis& hyp,
+                                                                              PositionIndex srcLeft,
+                                                                              PositionIndex srcRight,
+                                                                              float N)
 {
       // Initialize variables
   PhrNbestTransTablePrefKey pNbtPrefKey;
@@ -2697,15 +3160,16 @@ void _pbTransModel<HYPOTHESIS>::transUncovGapPrefNoGenCached(const Hypothesis& h
   
       // Search the required translations in the cache translation
       // table
-  NbestTableNode<PhraseTransTableNodeData>* transTableNodePtr=nbTransCacheData.cPhrNbestTransTablePref.getTranslationsForKey(pNbtPrefKey);
-  if(transTableNodePtr!=NULL)
+  std::map<PhrNbestTransTablePrefKey,NbestTransList>::const_iterator mapIter=nbTransCacheData.cPhrNbestTransListPref.find(pNbtPrefKey);
+  if(mapIter!=nbTransCacheData.cPhrNbestTransListPref.end())
   {
         // translations present in the cache translation table
-    nbt=*transTableNodePtr;
+    return mapIter->second;
   }
   else
   {
         // Obtain list
+    NbestTableNode<PhraseTransTableNodeData> nbt;
     transUncovGapPrefNoGen(hyp,srcLeft,srcRight,nbt);
     
         // Prune the list
@@ -2716,8 +3180,10 @@ void _pbTransModel<HYPOTHESIS>::transUncovGapPrefNoGenCached(const Hypothesis& h
       Score bscr=nbt.getScoreOfBestElem();
       nbt.pruneGivenThreshold(bscr+(double)log(N));
     }
-        // Store the list in cPhrNbestTransTablePref
-    nbTransCacheData.cPhrNbestTransTablePref.insertEntry(pNbtPrefKey,nbt);
+        // Store the list in cPhrNbestTransListPref
+    NbestTransList& nbtList=nbTransCacheData.cPhrNbestTransListPref[pNbtPrefKey];
+    nbtList.init(nbt);
+    return nbtList;
   }
 }
 
@@ -2911,12 +3377,12 @@ _pbTransModel<HYPOTHESIS>::scoreCompsForHyp(const _pbTransModel::Hypothesis& hyp
 {
       // Obtain null hypothesis score components
   Hypothesis nullHyp;
-  std::vector<Score> nullHypScoreComponents;
+  ScoreComps nullHypScoreComponents;
   nullHypothesisScrComps(nullHyp,nullHypScoreComponents);
   
       // Obtain score components
   Hypothesis auxHyp;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
   HypDataType hypDataType=hyp.getData();
   this->incrScore(nullHyp,hypDataType,auxHyp,scoreComponents);
 
@@ -3012,6 +3478,32 @@ std::vector<WordIndex> _pbTransModel<HYPOTHESIS>::strVectorToTrgIndexVector(std:
   return trgidxVec;
 }
 
+# ifdef THOT_STATS
+//---------------------------------
+template<class HYPOTHESIS>
+std::ostream & _pbTransModel<HYPOTHESIS>::printStats(std::ostream &outS)
+{
+  BasePbTransModel<HYPOTHESIS>::printStats(outS);
+
+      // Accumulate the use of the arenas of all threads
+  size_t bytesInUse=hypDataArena.bytesInUse();
+  size_t bytesReserved=hypDataArena.bytesReserved();
+  size_t numAllocs=hypDataArena.numAllocations();
+  size_t numBlockAllocs=hypDataArena.numBlockAllocations();
+  for(unsigned int i=0;i<workerHypDataArenaVec.size();++i)
+  {
+    bytesInUse+=workerHypDataArenaVec[i].bytesInUse();
+    bytesReserved+=workerHypDataArenaVec[i].bytesReserved();
+    numAllocs+=workerHypDataArenaVec[i].numAllocations();
+    numBlockAllocs+=workerHypDataArenaVec[i].numBlockAllocations();
+  }
+  outS<< " * Arena allocations              : " << numAllocs <<"\n";
+  outS<< " * Arena blocks obtained          : " << numBlockAllocs <<"\n";
+  outS<< " * Arena bytes in use / reserved  : " << bytesInUse << " / " << bytesReserved <<"\n";
+  return outS;
+}
+# endif
+
 //---------------------------------
 template<class HYPOTHESIS>
 _pbTransModel<HYPOTHESIS>::~_pbTransModel()
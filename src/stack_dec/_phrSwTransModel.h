@@ -122,14 +122,14 @@ class _phrSwTransModel: public _phraseBasedTransModel<HYPOTHESIS>
   
       // Sentence length scoring functions
   Score sentLenScore(unsigned int slen,unsigned int tlen);
-  Score sentLenScoreForPartialHyp(Bitset<MAX_SENTENCE_LENGTH_ALLOWED> key,
+  Score sentLenScoreForPartialHyp(Coverage key,
                                   unsigned int curr_tlen);
   Prob sumSentLenProb(unsigned int slen,unsigned int tlen);
       // Returns p(sl=slen|tl<=tlen)
   Score sumSentLenScoreRange(unsigned int slen,
                              uint_pair range);
       // Returns p(sl=slen|tl\in range)
-  uint_pair obtainLengthRangeForGaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey);
+  uint_pair obtainLengthRangeForGaps(const Coverage& hypKey);
   void initLenRangeForGapsVec(int maxSrcPhraseLength);
   
       // Functions related to pre_trans_actions
@@ -390,7 +390,7 @@ Score _phrSwTransModel<HYPOTHESIS>::sentLenScore(unsigned int slen,
 
 //---------------------------------
 template<class HYPOTHESIS>
-Score _phrSwTransModel<HYPOTHESIS>::sentLenScoreForPartialHyp(Bitset<MAX_SENTENCE_LENGTH_ALLOWED> key,
+Score _phrSwTransModel<HYPOTHESIS>::sentLenScoreForPartialHyp(Coverage key,
                                                               unsigned int curr_tlen)
 {
   if(this->state==MODEL_TRANS_STATE)
@@ -427,11 +427,14 @@ Score _phrSwTransModel<HYPOTHESIS>::sentLenScoreForPartialHyp(Bitset<MAX_SENTENC
       {
             // The prefix has not been generated yet.  The predicted
             // sentence range is (length(prefix),MAX_SENTENCE_LENGTH_ALLOWED),
+            // or (length(prefix),length(prefix)) for longer prefixes,
             // the prediction can be improved but the required code
             // could be complex.
         uint_pair range;
         range.first=this->pbtmInputVars.prefSentVec.size();
-        range.second=MAX_SENTENCE_LENGTH_ALLOWED;      
+        range.second=MAX_SENTENCE_LENGTH_ALLOWED;
+        if(range.second<range.first)
+          range.second=range.first;
         return sumSentLenScoreRange(this->pbtmInputVars.srcSentVec.size(),range);
       }
     }
@@ -487,7 +490,7 @@ Score _phrSwTransModel<HYPOTHESIS>::sumSentLenScoreRange(unsigned int slen,
 
 //---------------------------------
 template<class HYPOTHESIS>
-uint_pair _phrSwTransModel<HYPOTHESIS>::obtainLengthRangeForGaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey)
+uint_pair _phrSwTransModel<HYPOTHESIS>::obtainLengthRangeForGaps(const Coverage& hypKey)
 {
   unsigned int J;
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
@@ -37,6 +37,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "LangModelInfo.h"
 #include "SourceSegmentation.h"
 #include "NbestTransCacheData.h"
+#include "MonotonicArena.h"
 #include "PbTransModelInputVars.h"
 #include "PhrasePairCacheTable.h"
 #include "ScoreCompDefs.h"
@@ -118,16 +119,16 @@ class _phraseBasedTransModel: public BasePbTransModel<HYPOTHESIS>
       // Expansion-related functions
   void expand(const Hypothesis& hyp,
               std::vector<Hypothesis>& hypVec,
-              std::vector<std::vector<Score> >& scrCompVec);
+              std::vector<ScoreComps>& scrCompVec);
   void expand_ref(const Hypothesis& hyp,
                   std::vector<Hypothesis>& hypVec,
-                  std::vector<std::vector<Score> >& scrCompVec);
+                  std::vector<ScoreComps>& scrCompVec);
   void expand_ver(const Hypothesis& hyp,
                   std::vector<Hypothesis>& hypVec,
-                  std::vector<std::vector<Score> >& scrCompVec);
+                  std::vector<ScoreComps>& scrCompVec);
   void expand_prefix(const Hypothesis& hyp,
                      std::vector<Hypothesis>& hypVec,
-                     std::vector<std::vector<Score> >& scrCompVec);
+                     std::vector<ScoreComps>& scrCompVec);
 
       // Heuristic-related functions
   void setHeuristic(unsigned int _heuristicId);
@@ -141,7 +142,7 @@ class _phraseBasedTransModel: public BasePbTransModel<HYPOTHESIS>
   std::vector<std::string> getTransInPlainTextVec(const Hypothesis& hyp)const;
       
       // Model weights functions
-  void getUnweightedComps(const std::vector<Score>& scrComps,
+  void getUnweightedComps(const ScoreComps& scrComps,
                           std::vector<Score>& unweightedScrComps);
   std::vector<Score> scoreCompsForHyp(const Hypothesis& hyp);
   
@@ -173,6 +174,10 @@ class _phraseBasedTransModel: public BasePbTransModel<HYPOTHESIS>
 
       // Data used to cache n-best translation scores
   NbestTransCacheData nbTransCacheData;
+
+      // Arena storing hypothesis data for the sentence being
+      // translated
+  MonotonicArena hypDataArena;
   
       // Set of unseen words
   std::set<std::string> unseenWordsSet;
@@ -212,9 +217,9 @@ class _phraseBasedTransModel: public BasePbTransModel<HYPOTHESIS>
       // Expansion-related functions
   void extract_gaps(const Hypothesis& hyp,
                     std::vector<std::pair<PositionIndex,PositionIndex> >& gaps);
-  void extract_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey,
+  void extract_gaps(const Coverage& hypKey,
                     std::vector<std::pair<PositionIndex,PositionIndex> >& gaps);
-  unsigned int get_num_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey);
+  unsigned int get_num_gaps(const Coverage& hypKey);
 
       // Specific phrase-based functions
   virtual void extendHypDataIdx(PositionIndex srcLeft,
@@ -762,6 +767,9 @@ void _phraseBasedTransModel<HYPOTHESIS>::clearTempVars(void)
 
       // Clear temporary variables of the phrase model
   this->phrModelInfoPtr->invPbModelPtr->clearTempVars();
+
+      // Release hypothesis data of the previous sentence
+  hypDataArena.release();
 }
 
 //---------------------------------------
@@ -1639,13 +1647,13 @@ _phraseBasedTransModel<HYPOTHESIS>::getBestSuffixGivenHist(std::vector<std::stri
 template<class HYPOTHESIS>
 void _phraseBasedTransModel<HYPOTHESIS>::expand(const Hypothesis& hyp,
                                                 std::vector<Hypothesis>& hypVec,
-                                                std::vector<std::vector<Score> >& scrCompVec)
+                                                std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> s_;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
   
   hypVec.clear();
   scrCompVec.clear();
@@ -1712,13 +1720,13 @@ void _phraseBasedTransModel<HYPOTHESIS>::expand(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _phraseBasedTransModel<HYPOTHESIS>::expand_ref(const Hypothesis& hyp,
                                                     std::vector<Hypothesis>& hypVec,
-                                                    std::vector<std::vector<Score> >& scrCompVec)
+                                                    std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> s_;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -1769,13 +1777,13 @@ void _phraseBasedTransModel<HYPOTHESIS>::expand_ref(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _phraseBasedTransModel<HYPOTHESIS>::expand_ver(const Hypothesis& hyp,
                                                     std::vector<Hypothesis>& hypVec,
-                                                    std::vector<std::vector<Score> >& scrCompVec)
+                                                    std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> s_;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -1826,13 +1834,13 @@ void _phraseBasedTransModel<HYPOTHESIS>::expand_ver(const Hypothesis& hyp,
 template<class HYPOTHESIS>
 void _phraseBasedTransModel<HYPOTHESIS>::expand_prefix(const Hypothesis& hyp,
                                                        std::vector<Hypothesis>& hypVec,
-                                                       std::vector<std::vector<Score> >& scrCompVec)
+                                                       std::vector<ScoreComps>& scrCompVec)
 {
   std::vector<std::pair<PositionIndex,PositionIndex> > gaps;
   std::vector<WordIndex> s_;
   Hypothesis extHyp;
   std::vector<HypDataType> hypDataVec;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   hypVec.clear();
   scrCompVec.clear();
@@ -1889,73 +1897,42 @@ void _phraseBasedTransModel<HYPOTHESIS>::extract_gaps(const Hypothesis& hyp,
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _phraseBasedTransModel<HYPOTHESIS>::extract_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey,
+void _phraseBasedTransModel<HYPOTHESIS>::extract_gaps(const Coverage& hypKey,
                                                       std::vector<std::pair<PositionIndex,PositionIndex> >& gaps)
 {
-      // Extract all uncovered gaps
-  std::pair<PositionIndex,PositionIndex> gap;
-  unsigned int srcSentLen=this->numberOfUncoveredSrcWordsHypData(this->nullHypothesisHypData());
-  unsigned int j;
+      // Extract all uncovered gaps, the limits of each gap are found
+      // by scanning the coverage vector one word at a time
+  size_t srcSentLen=this->numberOfUncoveredSrcWordsHypData(this->nullHypothesisHypData());
   
-      // Extract gaps
   gaps.clear();
-  bool crossing_a_gap=false;	
-	
-  for(j=1;j<=srcSentLen;++j)
-  {
-    if(crossing_a_gap==false && hypKey.test(j)==0)
-    {
-      crossing_a_gap=true;
-      gap.first=j;
-    }
-	
-    if(crossing_a_gap==true && hypKey.test(j)==1)
-    {
-      crossing_a_gap=false;
-      gap.second=j-1;
-      gaps.push_back(gap);	
-    }	
-  }
-  if(crossing_a_gap==true)
+  size_t gapLeft=hypKey.findNext(1,false);
+  while(gapLeft<=srcSentLen)
   {
-    gap.second=j-1;
-    gaps.push_back(gap);
+    size_t gapEnd=hypKey.findNext(gapLeft,true);
+    if(gapEnd>srcSentLen)
+      gapEnd=srcSentLen+1;
+    gaps.push_back(std::make_pair((PositionIndex)gapLeft,(PositionIndex)(gapEnd-1)));
+    gapLeft=hypKey.findNext(gapEnd,false);
   }
 }
 
 //---------------------------------
 template<class HYPOTHESIS>
 unsigned int
-_phraseBasedTransModel<HYPOTHESIS>::get_num_gaps(const Bitset<MAX_SENTENCE_LENGTH_ALLOWED>& hypKey)
+_phraseBasedTransModel<HYPOTHESIS>::get_num_gaps(const Coverage& hypKey)
 {
       // Count all uncovered gaps
+  size_t srcSentLen=this->numberOfUncoveredSrcWordsHypData(this->nullHypothesisHypData());
   unsigned int result=0;
-  unsigned int j;
-  bool crossing_a_gap;
-  unsigned int srcSentLen;
-  HypDataType nullHypData=this->nullHypothesisHypData();
-
-  srcSentLen=this->numberOfUncoveredSrcWordsHypData(nullHypData);
   
-      // count gaps	
-  crossing_a_gap=false;	
-	
-  for(j=1;j<=srcSentLen;++j)
-  {
-    if(crossing_a_gap==false && hypKey.test(j)==0)
-    {
-      crossing_a_gap=true;
-    }
-	
-    if(crossing_a_gap==true && hypKey.test(j)==1)
-    {
-      crossing_a_gap=false;
-      ++result;	
-    }	
-  }
-  if(crossing_a_gap==true)
+  size_t gapLeft=hypKey.findNext(1,false);
+  while(gapLeft<=srcSentLen)
   {
     ++result;
+    size_t gapEnd=hypKey.findNext(gapLeft,true);
+    if(gapEnd>srcSentLen)
+      break;
+    gapLeft=hypKey.findNext(gapEnd,false);
   }
   return result;
 }
@@ -2269,8 +2246,8 @@ bool _phraseBasedTransModel<HYPOTHESIS>::getTransForHypUncovGapRef(const Hypothe
       pNbtRefKey.numGaps=1;
     else
     {
-      Bitset<MAX_SENTENCE_LENGTH_ALLOWED> key=hyp.getKey();
-      for(unsigned int i=srcLeft;i<=srcRight;++i) key.set(i);
+      Coverage key=hyp.getKey();
+      key.setRange(srcLeft,srcRight);
       pNbtRefKey.numGaps=this->get_num_gaps(key);
     }
      
@@ -2699,7 +2676,7 @@ void _phraseBasedTransModel<HYPOTHESIS>::printHyp(const Hypothesis& hyp,
 
       // Obtain score components
   Hypothesis auxHyp;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
   HypDataType hypDataType=hyp.getData();
   this->incrScore(this->nullHypothesis(),hypDataType,auxHyp,scoreComponents);
 
@@ -2758,11 +2735,11 @@ void _phraseBasedTransModel<HYPOTHESIS>::printHyp(const Hypothesis& hyp,
     auxHyp=hyp;
     while(this->obtainPredecessor(auxHyp))
     {
-      scoreComponents=scoreCompsForHyp(auxHyp);
+      std::vector<Score> stepScoreComponents=scoreCompsForHyp(auxHyp);
       outS<<"Step "<<numSteps<<" : ";
-      for(unsigned int i=0;i<scoreComponents.size();++i)
+      for(unsigned int i=0;i<stepScoreComponents.size();++i)
       {
-        outS<<scoreComponents[i]<<" ";
+        outS<<stepScoreComponents[i]<<" ";
       }
       outS<<std::endl;
       --numSteps;
@@ -2964,7 +2941,7 @@ std::vector<std::string> _phraseBasedTransModel<HYPOTHESIS>::getTransInPlainText
 
 //---------------------------------
 template<class HYPOTHESIS>
-void _phraseBasedTransModel<HYPOTHESIS>::getUnweightedComps(const std::vector<Score>& scrComps,
+void _phraseBasedTransModel<HYPOTHESIS>::getUnweightedComps(const ScoreComps& scrComps,
                                                             std::vector<Score>& unweightedScrComps)
 {
       // Obtain weights
@@ -2989,13 +2966,13 @@ _phraseBasedTransModel<HYPOTHESIS>::scoreCompsForHyp(const _phraseBasedTransMode
 {
   HypDataType hypDataType;
   Hypothesis auxHyp;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
   
       // Obtain score components
   hypDataType=hyp.getData();
   this->incrScore(this->nullHypothesis(),hypDataType,auxHyp,scoreComponents);
 
-  return scoreComponents;
+  return std::vector<Score>(scoreComponents.begin(),scoreComponents.end());
 }
 
 //---------------------------------
@@ -71,7 +71,7 @@ class _phraseHypothesis: public BasePhraseHypothesis<SCORE_INFO,PhrHypData,EQCLA
                       std::vector<PositionIndex>& targetSegmentCuts)const;
   void getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                             std::vector<WordIndex>& trgPhr)const;
-  Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const;
+  Coverage getKey(void)const;
   std::vector<WordIndex> getPartialTrans(void)const;
   unsigned int partialTransLength(void)const;
 
@@ -139,10 +139,10 @@ void _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::setData(const PhrHypData& _data
 template<class SCORE_INFO,class EQCLASS_FUNC>
 bool _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::isAligned(PositionIndex srcPos)const
 {
-  for(unsigned int k=0;k<this->data.sourceSegmentation.size();k++)
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(srcPos>=this->data.sourceSegmentation[k].first &&
-       srcPos<=this->data.sourceSegmentation[k].second)
+    if(srcPos>=nodePtr->srcSegm.first &&
+       srcPos<=nodePtr->srcSegm.second)
       return true;
   }
   return false;  
@@ -153,22 +153,14 @@ template<class SCORE_INFO,class EQCLASS_FUNC>
 bool _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::areAligned(PositionIndex srcPos,
                                                             PositionIndex trgPos)const
 {
-  for(unsigned int k=0;k<this->data.sourceSegmentation.size();k++)
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(srcPos>=this->data.sourceSegmentation[k].first &&
-       srcPos<=this->data.sourceSegmentation[k].second)
+    if(srcPos>=nodePtr->srcSegm.first &&
+       srcPos<=nodePtr->srcSegm.second)
     {
-      if(k==0)
-      {
-        if(trgPos>=1 && trgPos<=this->data.targetSegmentCuts[k])
-          return true;
-      }
-      else
-      {
-        if(trgPos>=this->data.targetSegmentCuts[k-1]+1 &&
-           trgPos<=this->data.targetSegmentCuts[k])
-          return true;
-      }
+      if(trgPos>=nodePtr->trgCut-nodePtr->trgPhraseLen+1 &&
+         trgPos<=nodePtr->trgCut)
+        return true;
     }
   }
   return false;
@@ -179,8 +171,7 @@ template<class SCORE_INFO,class EQCLASS_FUNC>
 void _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::getPhraseAlign(SourceSegmentation& sourceSegmentation,
                                                                 std::vector<PositionIndex>& targetSegmentCuts)const
 {
-  sourceSegmentation=data.sourceSegmentation;
-  targetSegmentCuts=data.targetSegmentCuts;
+  data.getPhraseAlign(sourceSegmentation,targetSegmentCuts);
 }
 
 //---------------------------------------
@@ -188,50 +179,29 @@ template<class SCORE_INFO,class EQCLASS_FUNC>
 void _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                                                                       std::vector<WordIndex>& trgPhr)const
 {
-      // Search source phrase in segmentation
-  unsigned int k;
-  bool srcPhrFound=false;
-  for(unsigned int i=0;i<data.sourceSegmentation.size();++i)
-  {
-    if(srcPhrPos==data.sourceSegmentation[i])
-    {
-      k=i;
-      srcPhrFound=true;
-    }
-  }
+  trgPhr.clear();
 
-      // Obtain target translation
-  if(srcPhrFound)
+      // Search source phrase in segmentation and obtain target
+      // translation
+  for(const PhrHypNode* nodePtr=data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    trgPhr.clear();
-    unsigned int i=0;
-    if(k>0)
-      i=data.targetSegmentCuts[k-1];
-    for(;i<data.targetSegmentCuts[k];++i)
+    if(srcPhrPos==nodePtr->srcSegm)
     {
-      trgPhr.push_back(data.ntarget[i+1]);
+      trgPhr.assign(nodePtr->trgPhrase,nodePtr->trgPhrase+nodePtr->trgPhraseLen);
+      break;
     }
   }
-  else
-  {
-    trgPhr.clear();
-  }
 }
 
 //---------------------------------------
 template<class SCORE_INFO,class EQCLASS_FUNC>
-Bitset<MAX_SENTENCE_LENGTH_ALLOWED>
+Coverage
 _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::getKey(void)const
 {
-  unsigned int k,j;
-  Bitset<MAX_SENTENCE_LENGTH_ALLOWED> b;
+  Coverage b;
 
-  b.reset();
-  for(k=0;k<this->data.sourceSegmentation.size();k++)
-  {
-    for(j=this->data.sourceSegmentation[k].first;j<=this->data.sourceSegmentation[k].second;j++) 
-      b.set( (size_t) j);
-  }
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
+    b.setRange(nodePtr->srcSegm.first,nodePtr->srcSegm.second);
   return b;	  
 }
 
@@ -239,14 +209,14 @@ _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::getKey(void)const
 template<class SCORE_INFO,class EQCLASS_FUNC>
 std::vector<WordIndex> _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::getPartialTrans(void)const
 {
-  return this->data.ntarget;
+  return this->data.getNtarget();
 }
 
 //---------------------------------------
 template<class SCORE_INFO,class EQCLASS_FUNC>
 unsigned int _phraseHypothesis<SCORE_INFO,EQCLASS_FUNC>::partialTransLength(void)const
 {
-  return this->data.ntarget.size()-1;
+  return this->data.partialTransLength();
 }
 
 //---------------------------------
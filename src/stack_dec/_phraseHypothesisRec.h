@@ -60,8 +60,12 @@ class _phraseHypothesisRec: public BasePhraseHypothesisRec<SCORE_INFO,PhrHypData
   Score getScore(void)const;
   void setScoreInfo(const ScoreInfo& _scoreInfo);
   ScoreInfo getScoreInfo(void)const;
+  const ScoreInfo& getScoreInfoRef(void)const;
+      // Returns the score information without copying it
   void addHeuristic(Score h);
   void subtractHeuristic(Score h);
+  void setHeuristic(Score h);
+      // Replaces the heuristic score added to the hypothesis by h
   PhrHypData getData(void)const;
   void setData(const PhrHypData& _data);
 
@@ -72,7 +76,7 @@ class _phraseHypothesisRec: public BasePhraseHypothesisRec<SCORE_INFO,PhrHypData
                       std::vector<PositionIndex>& targetSegmentCuts)const;
   void getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                             std::vector<WordIndex>& trgPhr)const;
-  Bitset<MAX_SENTENCE_LENGTH_ALLOWED> getKey(void)const;
+  Coverage getKey(void)const;
   std::vector<WordIndex> getPartialTrans(void)const;
   unsigned int partialTransLength(void)const;
 
@@ -107,6 +111,13 @@ void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::subtractHeuristic(S
   scoreInfo.subtractHeuristic(h);    
 }
 
+//---------------------------------------
+template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
+void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::setHeuristic(Score h)
+{
+  scoreInfo.setHeuristic(h);
+}
+
 //---------------------------------------
 template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 PhrHypData _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getData(void)const
@@ -129,6 +140,14 @@ _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getScoreInfo(void)const
   return scoreInfo;
 }
 
+//---------------------------------------
+template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
+const typename _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::ScoreInfo&
+_phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getScoreInfoRef(void)const
+{
+  return scoreInfo;
+}
+
 //---------------------------------------
 template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::setData(const PhrHypData& _data)
@@ -140,10 +159,10 @@ void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::setData(const PhrHy
 template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 bool _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::isAligned(PositionIndex i)const
 {
-  for(unsigned int k=0;k<this->data.sourceSegmentation.size();k++)
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(i>=this->data.sourceSegmentation[k].first &&
-       i<=this->data.sourceSegmentation[k].second)
+    if(i>=nodePtr->srcSegm.first &&
+       i<=nodePtr->srcSegm.second)
       return true;
   }
   return false;  
@@ -154,22 +173,14 @@ template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 bool _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::areAligned(PositionIndex i,
                                                                         PositionIndex j)const
 {
-  for(unsigned int k=0;k<this->data.sourceSegmentation.size();k++)
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    if(i>=this->data.sourceSegmentation[k].first &&
-       i<=this->data.sourceSegmentation[k].second)
+    if(i>=nodePtr->srcSegm.first &&
+       i<=nodePtr->srcSegm.second)
     {
-      if(k==0)
-      {
-        if(j>=1 && j<=this->data.targetSegmentCuts[k])
-          return true;
-      }
-      else
-      {
-        if(j>=this->data.targetSegmentCuts[k-1]+1 &&
-           j<=this->data.targetSegmentCuts[k])
-          return true;
-      }
+      if(j>=nodePtr->trgCut-nodePtr->trgPhraseLen+1 &&
+         j<=nodePtr->trgCut)
+        return true;
     }
   }
   return false;
@@ -180,8 +191,7 @@ template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getPhraseAlign(SourceSegmentation& sourceSegmentation,
                                                                             std::vector<PositionIndex>& targetSegmentCuts)const
 {
-  sourceSegmentation=data.sourceSegmentation;
-  targetSegmentCuts=data.targetSegmentCuts;
+  data.getPhraseAlign(sourceSegmentation,targetSegmentCuts);
 }
 
 //---------------------------------------
@@ -189,50 +199,29 @@ template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 void _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getTrgTransForSrcPhr(std::pair<PositionIndex,PositionIndex> srcPhrPos,
                                                                                   std::vector<WordIndex>& trgPhr)const
 {
-      // Search source phrase in segmentation
-  unsigned int k;
-  bool srcPhrFound=false;
-  for(unsigned int i=0;i<data.sourceSegmentation.size();++i)
-  {
-    if(srcPhrPos==data.sourceSegmentation[i])
-    {
-      k=i;
-      srcPhrFound=true;
-    }
-  }
+  trgPhr.clear();
 
-      // Obtain target translation
-  if(srcPhrFound)
+      // Search source phrase in segmentation and obtain target
+      // translation
+  for(const PhrHypNode* nodePtr=data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
   {
-    trgPhr.clear();
-    unsigned int i=0;
-    if(k>0)
-      i=data.targetSegmentCuts[k-1];
-    for(;i<data.targetSegmentCuts[k];++i)
+    if(srcPhrPos==nodePtr->srcSegm)
     {
-      trgPhr.push_back(data.ntarget[i+1]);
+      trgPhr.assign(nodePtr->trgPhrase,nodePtr->trgPhrase+nodePtr->trgPhraseLen);
+      break;
     }
   }
-  else
-  {
-    trgPhr.clear();
-  }
 }
 
 //---------------------------------------
 template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
-Bitset<MAX_SENTENCE_LENGTH_ALLOWED>
+Coverage
 _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getKey(void)const
 {
-  unsigned int k,j;
-  Bitset<MAX_SENTENCE_LENGTH_ALLOWED> b;
+  Coverage b;
 
-  b.reset();
-  for(k=0;k<this->data.sourceSegmentation.size();k++)
-  {
-    for(j=this->data.sourceSegmentation[k].first;j<=this->data.sourceSegmentation[k].second;j++) 
-      b.set( (size_t) j);
-  }
+  for(const PhrHypNode* nodePtr=this->data.getLastPhraseNode();nodePtr!=NULL;nodePtr=nodePtr->pred)
+    b.setRange(nodePtr->srcSegm.first,nodePtr->srcSegm.second);
   return b;	  
 }
 
@@ -241,7 +230,7 @@ template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 std::vector<WordIndex>
 _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::getPartialTrans(void)const
 {
-  return this->data.ntarget;
+  return this->data.getNtarget();
 }
 
 //---------------------------------------
@@ -249,7 +238,7 @@ template<class SCORE_INFO,class EQCLASS_FUNC,class HYPSTATE>
 unsigned int
 _phraseHypothesisRec<SCORE_INFO,EQCLASS_FUNC,HYPSTATE>::partialTransLength(void)const
 {
-  return this->data.ntarget.size()-1;
+  return this->data.partialTransLength();
 }
 
 //---------------------------------
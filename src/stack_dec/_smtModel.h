@@ -86,16 +86,16 @@ class _smtModel: public BaseSmtModel<HYPOTHESIS>
         // Expansion-related functions
   virtual void expand(const Hypothesis& hyp,
                       std::vector<Hypothesis>& hypVec,
-                      std::vector<std::vector<Score> >& scrCompVec)=0;
+                      std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_ref(const Hypothesis& hyp,
                           std::vector<Hypothesis>& hypVec,
-                          std::vector<std::vector<Score> >& scrCompVec)=0;
+                          std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_ver(const Hypothesis& hyp,
                           std::vector<Hypothesis>& hypVec,
-                          std::vector<std::vector<Score> >& scrCompVec)=0;
+                          std::vector<ScoreComps>& scrCompVec)=0;
   virtual void expand_prefix(const Hypothesis& hyp,
                              std::vector<Hypothesis>& hypVec,
-                             std::vector<std::vector<Score> >& scrCompVec)=0;
+                             std::vector<ScoreComps>& scrCompVec)=0;
 
       // Functions for performing on-line training
   void setOnlineTrainingPars(OnlineTrainingPars _onlineTrainingPars,
@@ -135,7 +135,7 @@ class _smtModel: public BaseSmtModel<HYPOTHESIS>
   virtual Score incrScore(const Hypothesis& prev_hyp,
                           const HypDataType& new_hypd,
                           Hypothesis& new_hyp,
-                          std::vector<Score>& scoreComponents)=0;
+                          ScoreComps& scoreComponents)=0;
 
       // Helper functions
   float smoothLlWeight(float weight);
@@ -171,7 +171,7 @@ template<class HYPOTHESIS>
 bool _smtModel<HYPOTHESIS>::obtainPredecessor(Hypothesis& hyp)
 {
   typename Hypothesis::DataType predData;
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
 
   predData=hyp.getData();
   if(!this->obtainPredecessorHypData(predData)) return false;
@@ -189,7 +189,7 @@ template<class HYPOTHESIS>
 void _smtModel<HYPOTHESIS>::obtainHypFromHypData(const HypDataType& hypDataType,
                                                  Hypothesis& hyp)
 {
-  std::vector<Score> scoreComponents;
+  ScoreComps scoreComponents;
   
   incrScore(this->nullHypothesis(),hypDataType,hyp,scoreComponents);
 }
@@ -202,7 +202,9 @@ void _smtModel<HYPOTHESIS>::diffScoreCompsForHyps(const Hypothesis& pred_hyp,
 {
   typename Hypothesis::DataType succ_hypd=succ_hyp.getData();
   Hypothesis aux;
-  incrScore(pred_hyp,succ_hypd,aux,scoreComponents);
+  ScoreComps scrComps;
+  incrScore(pred_hyp,succ_hypd,aux,scrComps);
+  scoreComponents.assign(scrComps.begin(),scrComps.end());
 }
 
 //--------------------------
@@ -37,8 +37,10 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <Score.h>
 #include <BaseSmtMultiStack.h>
 #include <SmtStack.h>
+#include <SmtHeapStack.h>
 
 #include <map>
+#include <vector>
 #if __GNUC__>2
 #include <ext/hash_map>
 using __gnu_cxx::hash_map;
@@ -48,6 +50,7 @@ using __gnu_cxx::hash_map;
 
 //--------------- Constants ------------------------------------------
 
+#define SMT_MULTI_STACK_MAX_FREE_SUBSTACKS 256
 
 //--------------- Classes --------------------------------------------
 
@@ -55,10 +58,11 @@ using __gnu_cxx::hash_map;
 
 /**
  * @brief Predecessor class for implementing a multiple stack to be used
- * in stack decoding.
+ * in stack decoding. The SUBSTACK parameter gives the stack class used
+ * for each equivalence class (SmtHeapStack or SmtStack).
  */
 
-template<class HYPOTHESIS> 
+template<class HYPOTHESIS,class SUBSTACK=SmtHeapStack<HYPOTHESIS> > 
 class _smtMultiStack: public BaseSmtMultiStack<HYPOTHESIS>
 {
  public:
@@ -66,7 +70,8 @@ class _smtMultiStack: public BaseSmtMultiStack<HYPOTHESIS>
   typedef typename HYPOTHESIS::EqClassFunc EqClassFunc;
   typedef typename EqClassFunc::EqClassType EqClassType;
   typedef typename EqClassFunc::EqClassTypeHashF EqClassTypeHashF;  
-  typedef hash_map<EqClassType,SmtStack<HYPOTHESIS>,EqClassTypeHashF> MultiContainer;
+  typedef SUBSTACK SubStack;
+  typedef hash_map<EqClassType,SUBSTACK,EqClassTypeHashF> MultiContainer;
   typedef std::map<EqClassType,typename MultiContainer::iterator,std::less<EqClassType> > SortedStacksMap;
 
       // constructor
@@ -94,14 +99,21 @@ class _smtMultiStack: public BaseSmtMultiStack<HYPOTHESIS>
   MultiContainer multiContainer;
   SortedStacksMap sortedStacksMap;
   bool breadthFirst;
+
+      // Substacks released by clear(), kept so as to reuse their
+      // storage (at most SMT_MULTI_STACK_MAX_FREE_SUBSTACKS are kept)
+  std::vector<SUBSTACK> freeSubstackVec;
+
+      // auxiliary functions
+  typename MultiContainer::iterator createSubstack(const EqClassType& key);
 };
 
 //--------------- _smtMultiStack template class function definitions
 
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-_smtMultiStack<HYPOTHESIS>::_smtMultiStack(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+_smtMultiStack<HYPOTHESIS,SUBSTACK>::_smtMultiStack(void)
 {
   maxStackSize=64;
   breadthFirst=false;
@@ -113,8 +125,8 @@ _smtMultiStack<HYPOTHESIS>::_smtMultiStack(void)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-void _smtMultiStack<HYPOTHESIS>::setMaxStackSize(unsigned int _maxStackSize)
+template<class HYPOTHESIS,class SUBSTACK> 
+void _smtMultiStack<HYPOTHESIS,SUBSTACK>::setMaxStackSize(unsigned int _maxStackSize)
 {
   typename MultiContainer::iterator pos;	
 
@@ -128,15 +140,15 @@ void _smtMultiStack<HYPOTHESIS>::setMaxStackSize(unsigned int _maxStackSize)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-unsigned int _smtMultiStack<HYPOTHESIS>::getMaxStackSize(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+unsigned int _smtMultiStack<HYPOTHESIS,SUBSTACK>::getMaxStackSize(void)
 {
   return maxStackSize;
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-HYPOTHESIS _smtMultiStack<HYPOTHESIS>::top(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+HYPOTHESIS _smtMultiStack<HYPOTHESIS,SUBSTACK>::top(void)
 {
   HYPOTHESIS result,aux;
   typename SortedStacksMap::iterator sortedStacksMapIter;
@@ -170,8 +182,8 @@ HYPOTHESIS _smtMultiStack<HYPOTHESIS>::top(void)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-HYPOTHESIS _smtMultiStack<HYPOTHESIS>::last(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+HYPOTHESIS _smtMultiStack<HYPOTHESIS,SUBSTACK>::last(void)
 {
   if(breadthFirst) 
   {
@@ -216,31 +228,45 @@ HYPOTHESIS _smtMultiStack<HYPOTHESIS>::last(void)
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-void _smtMultiStack<HYPOTHESIS>::set_bf(bool _breadthFirst)
+template<class HYPOTHESIS,class SUBSTACK> 
+void _smtMultiStack<HYPOTHESIS,SUBSTACK>::set_bf(bool _breadthFirst)
 {
   breadthFirst=_breadthFirst;
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-bool _smtMultiStack<HYPOTHESIS>::empty(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+bool _smtMultiStack<HYPOTHESIS,SUBSTACK>::empty(void)
 {
   if(sortedStacksMap.size()==0) return true;
   else return false;
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-size_t _smtMultiStack<HYPOTHESIS>::size(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+size_t _smtMultiStack<HYPOTHESIS,SUBSTACK>::size(void)
 {
   return sortedStacksMap.size();  
 }
 
 //---------------------------------------
-template<class HYPOTHESIS> 
-void _smtMultiStack<HYPOTHESIS>::clear(void)
+template<class HYPOTHESIS,class SUBSTACK> 
+void _smtMultiStack<HYPOTHESIS,SUBSTACK>::clear(void)
 {
+  typename MultiContainer::iterator pos;	
+
+      // Stacks are emptied and moved to the pool of free substacks,
+      // so their storage can be reused when translating the next
+      // sentence whatever their equivalence class is
+  for(pos=multiContainer.begin();pos!=multiContainer.end();++pos) 
+  {
+    if(freeSubstackVec.size()<SMT_MULTI_STACK_MAX_FREE_SUBSTACKS)
+    {
+      pos->second.clear();
+      freeSubstackVec.push_back(SUBSTACK());
+      std::swap(freeSubstackVec.back(),pos->second);
+    }
+  }
   multiContainer.clear();
   sortedStacksMap.clear();
 # ifdef THOT_STATS
@@ -249,4 +275,21 @@ void _smtMultiStack<HYPOTHESIS>::clear(void)
 # endif
 }
 
+//---------------------------------------
+template<class HYPOTHESIS,class SUBSTACK> 
+typename _smtMultiStack<HYPOTHESIS,SUBSTACK>::MultiContainer::iterator
+_smtMultiStack<HYPOTHESIS,SUBSTACK>::createSubstack(const EqClassType& key)
+{
+  typename MultiContainer::iterator pos;
+
+  pos=multiContainer.insert(std::make_pair(key,SUBSTACK())).first;
+  if(!freeSubstackVec.empty())
+  {
+    std::swap(pos->second,freeSubstackVec.back());
+    freeSubstackVec.pop_back();
+  }
+  pos->second.setMaxStackSize(maxStackSize);
+  return pos;
+}
+
 #endif
@@ -33,7 +33,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #  include <thot_config.h>
 #endif /* HAVE_CONFIG_H */
 
-#include "Bitset.h"
+#include "Coverage.h"
 #include "PositionIndex.h"
 #include "WordIndex.h"
 #include "Prob.h"
@@ -205,7 +205,7 @@ class _stackDecoder: public BaseStackDecoder<SMT_MODEL>
       // the pop function also subtracts a heuristic value to hyp
   
   virtual bool pushGivenPredHyp(const Hypothesis& pred_hyp,
-                                const std::vector<Score>& scrComps,
+                                const ScoreComps& scrComps,
                                 const Hypothesis& succ_hyp);
       // Push hypothesis succ_hyp given its predecessor pred_hyp. This
       // function can be overridden by derived classes which use
@@ -428,15 +428,6 @@ _stackDecoder<SMT_MODEL>::translateWithRef(std::string s,
         // Verify sentence length
     unsigned int srcSize=StrProcUtils::stringToStringVector(s).size();
     unsigned int refSize=StrProcUtils::stringToStringVector(ref).size();
-    if(srcSize>=MAX_SENTENCE_LENGTH_ALLOWED || refSize>=MAX_SENTENCE_LENGTH_ALLOWED)
-    {
-      std::cerr<<"Error: input sentences are too long (MAX= "<<MAX_SENTENCE_LENGTH_ALLOWED<<" words)"<<std::endl;
-      init_state();
-      Hypothesis nullHyp;
-      nullHyp=smtm_ptr->nullHypothesis();
-      return nullHyp;
-    }
-
     if(srcSize==0 || refSize==0)
     {
       std::cerr<<"Warning: input sentences empty"<<std::endl;
@@ -480,15 +471,6 @@ _stackDecoder<SMT_MODEL>::verifyCoverageForRef(std::string s,
         // Verify sentence length
     unsigned int srcSize=StrProcUtils::stringToStringVector(s).size();
     unsigned int refSize=StrProcUtils::stringToStringVector(ref).size();
-    if(srcSize>=MAX_SENTENCE_LENGTH_ALLOWED || refSize>=MAX_SENTENCE_LENGTH_ALLOWED)
-    {
-      std::cerr<<"Error: input sentences are too long (MAX= "<<MAX_SENTENCE_LENGTH_ALLOWED<<" words)"<<std::endl;
-      init_state();
-      Hypothesis nullHyp;
-      nullHyp=smtm_ptr->nullHypothesis();
-      return nullHyp;
-    }
-
     if(srcSize==0 || refSize==0)
     {
       std::cerr<<"Warning: input sentences empty"<<std::endl;
@@ -532,15 +514,6 @@ _stackDecoder<SMT_MODEL>::translateWithPrefix(std::string s,
         // Verify sentence length
     unsigned int srcSize=StrProcUtils::stringToStringVector(s).size();
     unsigned int prefSize=StrProcUtils::stringToStringVector(pref).size();
-    if(srcSize>=MAX_SENTENCE_LENGTH_ALLOWED || prefSize>=MAX_SENTENCE_LENGTH_ALLOWED)
-    {
-      std::cerr<<"Error: input sentences are too long (MAX= "<<MAX_SENTENCE_LENGTH_ALLOWED<<" words)"<<std::endl;
-      init_state();
-      Hypothesis nullHyp;
-      nullHyp=smtm_ptr->nullHypothesis();
-      return nullHyp;
-    }
-
     if(srcSize==0 || prefSize==0)
     {
       std::cerr<<"Warning: input sentences empty"<<std::endl;
@@ -667,12 +640,9 @@ int _stackDecoder<SMT_MODEL>::pre_trans_actions(std::string srcsent)
       // metadata information may affect the length)
   std::string modelSrcSent=smtm_ptr->getCurrentSrcSent();
   unsigned int srcSize=StrProcUtils::stringToStringVector(modelSrcSent).size();
-  if(srcSize==0 || srcSize>=MAX_SENTENCE_LENGTH_ALLOWED)
+  if(srcSize==0)
   {
-    if(srcSize==0)
-      std::cerr<<"Warning: the sentence to translate is empty"<<std::endl;
-    else
-      std::cerr<<"Error: the sentence to translate is too long (MAX= "<<MAX_SENTENCE_LENGTH_ALLOWED<<" words)"<<std::endl;
+    std::cerr<<"Warning: the sentence to translate is empty"<<std::endl;
     return THOT_ERROR;
   }
 
@@ -848,7 +818,7 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::pop(void
 //---------------------------------------
 template<class SMT_MODEL>
 bool _stackDecoder<SMT_MODEL>::pushGivenPredHyp(const Hypothesis& /*pred_hyp*/,
-                                                const std::vector<Score>& /*scrComps*/,
+                                                const ScoreComps& /*scrComps*/,
                                                 const Hypothesis& succ_hyp)
 {
   return push(succ_hyp);
@@ -860,6 +830,9 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decode(v
 {
   bool end=false;
   std::vector<Hypothesis> hypsToExpand;
+  std::vector<Hypothesis> incompleteHyps;
+  std::vector<std::vector<Hypothesis> > expandedHypVecs;
+  std::vector<std::vector<ScoreComps> > scrCompVecs;
   Hypothesis result=smtm_ptr->nullHypothesis();
   unsigned int iterNo=1;
     
@@ -897,6 +870,20 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decode(v
     else	   
     {
           // There are hypotheses to be expanded
+
+          // Obtain the expansions of the hypotheses that are not
+          // complete (the model may generate them in parallel, they
+          // are pushed into the stack in the same order used when
+          // they are expanded one by one)
+      incompleteHyps.clear();
+      for(unsigned int i=0;i<hypsToExpand.size();++i)
+      {
+        if(!smtm_ptr->isComplete(hypsToExpand[i]))
+          incompleteHyps.push_back(hypsToExpand[i]);
+      }
+      smtm_ptr->expandHyps(incompleteHyps,expandedHypVecs,scrCompVecs);
+
+      unsigned int incompleteIdx=0;
       for(unsigned int i=0;i<hypsToExpand.size();++i)
       {
             // If the hypothesis is complete, finish the decoding
@@ -926,10 +913,10 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decode(v
             smtm_ptr->printHyp(hypsToExpand[i],std::cerr);
           }
           
-          std::vector<Hypothesis> expandedHyps;
-          std::vector<std::vector<Score> > scrCompVec;
+          std::vector<Hypothesis>& expandedHyps=expandedHypVecs[incompleteIdx];
+          std::vector<ScoreComps>& scrCompVec=scrCompVecs[incompleteIdx];
+          ++incompleteIdx;
           int numExpHyp=0;
-          smtm_ptr->expand(hypsToExpand[i],expandedHyps,scrCompVec);
 
               // Update result variable (choose hypothesis further to
               // null hypothesis with a higher score)
@@ -1045,7 +1032,7 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decodeWi
           }
 
           std::vector<Hypothesis> expandedHyps;
-          std::vector<std::vector<Score> > scrCompVec;
+          std::vector<ScoreComps> scrCompVec;
           int numExpHyp=0;
           smtm_ptr->expand_ref(hypsToExpand[i],expandedHyps,scrCompVec);
 
@@ -1152,7 +1139,7 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decodeVe
           }
 
           std::vector<Hypothesis> expandedHyps;
-          std::vector<std::vector<Score> > scrCompVec;
+          std::vector<ScoreComps> scrCompVec;
           int numExpHyp=0;
           smtm_ptr->expand_ver(hypsToExpand[i],expandedHyps,scrCompVec);
           
@@ -1258,7 +1245,7 @@ typename _stackDecoder<SMT_MODEL>::Hypothesis _stackDecoder<SMT_MODEL>::decodeWi
           }
 
           std::vector<Hypothesis> expandedHyps;
-          std::vector<std::vector<Score> > scrCompVec;
+          std::vector<ScoreComps> scrCompVec;
           int numExpHyp=0;
           smtm_ptr->expand_prefix(hypsToExpand[i],expandedHyps,scrCompVec);
 
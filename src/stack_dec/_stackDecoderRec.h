@@ -101,11 +101,11 @@ class _stackDecoderRec: public _stackDecoder<SMT_MODEL>
   void post_trans_actions(const Hypothesis& result);
 
   bool pushGivenPredHyp(const Hypothesis& pred_hyp,
-                        const std::vector<Score>& scrComps,
+                        const ScoreComps& scrComps,
                         const Hypothesis& succ_hyp);
       // Overriden function to allow word-graph generation
   void addArcToWordGraph(Hypothesis pred_hyp,
-                         const std::vector<Score>& scrComps,
+                         const ScoreComps& scrComps,
                          Hypothesis succ_hyp);
       // Add an arc to the recombination graph.
   HypStateIndex getHypStateIndex(const Hypothesis& hyp,
@@ -241,7 +241,7 @@ void _stackDecoderRec<SMT_MODEL>::post_trans_actions(const Hypothesis& result)
 //---------------------------------------
 template<class SMT_MODEL>
 bool _stackDecoderRec<SMT_MODEL>::pushGivenPredHyp(const Hypothesis& pred_hyp,
-                                                   const std::vector<Score>& scrComps,
+                                                   const ScoreComps& scrComps,
                                                    const Hypothesis& succ_hyp)
 
 {
@@ -254,7 +254,7 @@ bool _stackDecoderRec<SMT_MODEL>::pushGivenPredHyp(const Hypothesis& pred_hyp,
 //---------------------------------------
 template<class SMT_MODEL>
 void _stackDecoderRec<SMT_MODEL>::addArcToWordGraph(Hypothesis pred_hyp,
-                                                    const std::vector<Score>& scrComps,
+                                                    const ScoreComps& scrComps,
                                                     Hypothesis succ_hyp)
 {
   if(wordGraphEnabled)
@@ -36,6 +36,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #define DEFAULT_USER_ID           0
 #define DEFAULT_SERVER_PORT    4550
+#define DEFAULT_SERVER_NUM_WORKERS   4
+#define DEFAULT_SERVER_QUEUE_DEPTH 256
 
 #define VERIFY_COV                1
 #define TRANSLATE_SENT            2
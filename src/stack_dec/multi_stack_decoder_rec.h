@@ -46,15 +46,19 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 /**
  * @brief The multi_stack_decoder_rec template class is derived from the
  * _stackDecoderRec class and implements a multiple-stack decoder with
- * hypothesis recombination.
+ * hypothesis recombination. SUBSTACK_TYPE selects the stack class used
+ * for each equivalence class (SmtHeapStack by default, SmtStack gives
+ * the multiset-based stacks).
  */
 
-template<class SMT_MODEL>
+template<class SMT_MODEL,
+         template<class> class SUBSTACK_TYPE=SmtHeapStack>
 class multi_stack_decoder_rec: public _stackDecoderRec<SMT_MODEL>
 {
  public:
 
   typedef typename BaseStackDecoder<SMT_MODEL>::Hypothesis Hypothesis;
+  typedef SmtMultiStackRec<Hypothesis,SUBSTACK_TYPE<Hypothesis> > MultiStackRec;
   
   multi_stack_decoder_rec(void); 
       // Constructor. 
@@ -74,39 +78,40 @@ class multi_stack_decoder_rec: public _stackDecoderRec<SMT_MODEL>
 
 
 //---------------------------------------
-template<class SMT_MODEL>
-multi_stack_decoder_rec<SMT_MODEL>::multi_stack_decoder_rec(void):_stackDecoderRec<SMT_MODEL>()
+template<class SMT_MODEL,template<class> class SUBSTACK_TYPE>
+multi_stack_decoder_rec<SMT_MODEL,SUBSTACK_TYPE>::multi_stack_decoder_rec(void):_stackDecoderRec<SMT_MODEL>()
 {
-  SmtMultiStackRec<Hypothesis>* smtMultiStackRecPtr;
+  MultiStackRec* smtMultiStackRecPtr;
 
       // Create stack container
-  this->stack_ptr=new SmtMultiStackRec<Hypothesis>();
+  this->stack_ptr=new MultiStackRec();
   
       // Link hypothesis state dictionary to the stack container
-  smtMultiStackRecPtr=dynamic_cast<SmtMultiStackRec<Hypothesis>*>(this->stack_ptr);
+  smtMultiStackRecPtr=dynamic_cast<MultiStackRec*>(this->stack_ptr);
   smtMultiStackRecPtr->setHypStateDictPtr(this->hypStateDictPtr);
 }
 
 //---------------------------------------
-template<class SMT_MODEL>
-void multi_stack_decoder_rec<SMT_MODEL>::printSearchGraphStream(std::ostream &outS)
+template<class SMT_MODEL,template<class> class SUBSTACK_TYPE>
+void multi_stack_decoder_rec<SMT_MODEL,SUBSTACK_TYPE>::printSearchGraphStream(std::ostream &outS)
 {
-  SmtMultiStackRec<Hypothesis>* smtMultiStackRecPtr;
-  typename SmtMultiStackRec<Hypothesis>::iterator mStackIter;
+  MultiStackRec* smtMultiStackRecPtr;
+  typename MultiStackRec::iterator mStackIter;
   Hypothesis nullHyp=this->smtm_ptr->nullHypothesis();
 
-  smtMultiStackRecPtr=dynamic_cast<SmtMultiStackRec<Hypothesis>*>(this->stack_ptr);
+  smtMultiStackRecPtr=dynamic_cast<MultiStackRec*>(this->stack_ptr);
 
   outS<<"SrcLen= "<<StrProcUtils::stringToStringVector(this->srcSentence).size()<<std::endl;
   for(mStackIter=smtMultiStackRecPtr->begin();mStackIter!=smtMultiStackRecPtr->end();++mStackIter)
   {
-    typename SmtStack<Hypothesis>::iterator stackIter;
+    std::vector<typename MultiStackRec::HypHandle> handleVec;
 
-    for(stackIter=mStackIter->second.begin();stackIter!=mStackIter->second.end();++stackIter)
+    mStackIter->second.getSortedHandles(handleVec);
+    for(unsigned int i=0;i<handleVec.size();++i)
     {
       Hypothesis hyp;
 
-      hyp=*stackIter;
+      hyp=mStackIter->second.getHyp(handleVec[i]);
       outS<<"Stack ID. "<<mStackIter->first<<std::endl;
       this->smtm_ptr->subtractHeuristicToHyp(hyp);
       this->subtractgToHyp(hyp);
@@ -116,8 +121,8 @@ void multi_stack_decoder_rec<SMT_MODEL>::printSearchGraphStream(std::ostream &ou
 }
 
 //---------------------------------------
-template<class SMT_MODEL>
-multi_stack_decoder_rec<SMT_MODEL>::~multi_stack_decoder_rec()
+template<class SMT_MODEL,template<class> class SUBSTACK_TYPE>
+multi_stack_decoder_rec<SMT_MODEL,SUBSTACK_TYPE>::~multi_stack_decoder_rec()
 {
   delete this->stack_ptr;
 }
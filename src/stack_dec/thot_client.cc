@@ -173,8 +173,8 @@ void process_request(const thot_client_pars& tdcPars)
     std::cerr<<"Elapsed time (connection + request latencies): " << connection_latency+request_latency << " secs\n";
   }
 
-      //thotDecoderClient.disconnect(); // (disconnect is not required since the server only
-      //                                   dispatch one request per client execution)
+      // End dialog so that the server closes the connection
+  thotDecoderClient.disconnect(tdcPars.user_id);
 }
 
 //---------------
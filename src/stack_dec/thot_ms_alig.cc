@@ -775,13 +775,16 @@ void print_alig_a3_final(std::string srcstr,
   else
   {
     unsigned int i;
+    SourceSegmentation sourceSegmentation;
+    std::vector<PositionIndex> targetSegmentCuts;
+    dataType.getPhraseAlign(sourceSegmentation,targetSegmentCuts);
     i=1;
-    for(unsigned int k=0;k<dataType.targetSegmentCuts.size();++k)
+    for(unsigned int k=0;k<targetSegmentCuts.size();++k)
     {
-      for(;i<=dataType.targetSegmentCuts[k];++i)
+      for(;i<=targetSegmentCuts[k];++i)
       {
         std::cout<<" "<<sysTrgVec[i-1]<<" ({ ";
-        for(unsigned int j=dataType.sourceSegmentation[k].first;j<=dataType.sourceSegmentation[k].second;++j)
+        for(unsigned int j=sourceSegmentation[k].first;j<=sourceSegmentation[k].second;++j)
         {
           std::cout<<j<<" ";
         }
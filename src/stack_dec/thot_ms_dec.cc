@@ -23,135 +23,80 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
  * using a multiple-stack decoder.
  */
 
-//--------------- Include files --------------------------------------
 
-#if HAVE_CONFIG_H
-#  include <thot_config.h>
-#endif /* HAVE_CONFIG_H */
+//--------------- Include files --------------------------------------
 
-#include "_stackDecoderRec.h"
-#include "BaseStackDecoder.h"
-#include THOT_SMTMODEL_H // Define SmtModel type. It is set in
-                         // configure by checking SMTMODEL_H
-                         // variable (default value: SmtModel.h)
-#include "CustomFeatureHandler.h"
-#include "StdFeatureHandler.h"
-#include "_pbTransModel.h"
-#include "_phrSwTransModel.h"
-#include "_phraseBasedTransModel.h"
-#include "BasePbTransModel.h"
-#include "SwModelInfo.h"
-#include "PhraseModelInfo.h"
-#include "LangModelInfo.h"
-#include "BaseTranslationMetadata.h"
-#include "BaseLogLinWeightUpdater.h"
-#include "ModelDescriptorUtils.h"
-#include "DynClassFactoryHandler.h"
+#include "thot_ms_dec_common.h"
 #include "ctimer.h"
 #include "options.h"
 #include "ErrorDefs.h"
+#include <pthread.h>
 #include <iostream>
 #include <iomanip>
-#include <stdlib.h>
+#include <sstream>
+#include <fstream>
+#include <stdio.h>
 #include <vector>
 #include <string>
-#include <map>
-#include <set>
-
-//--------------- Constants ------------------------------------------
-
-#define PMSTACK_W_DEFAULT 10
-
-#ifdef MULTI_STACK_USE_GRAN
- #define PMSTACK_S_DEFAULT 128
-#else
- #define PMSTACK_S_DEFAULT 10
-#endif
-
-#define PMSTACK_A_DEFAULT 10
-#define PMSTACK_I_DEFAULT 1
-#define PMSTACK_G_DEFAULT 0
-#define PMSTACK_H_DEFAULT LOCAL_TD_HEURISTIC
-#define PMSTACK_NOMON_DEFAULT 0
 
 //--------------- Type definitions -----------------------------------
 
-struct thot_ms_dec_pars
+struct thot_ms_dec_pars: public thot_ms_dec_common_pars
 {
-  bool be;
-  float W;
-  int A,nomon,S,I,G,heuristic,verbosity;
-  std::string sourceSentencesFile;
-  std::string languageModelFileName;
-  std::string transModelPref;
-  std::string customFeatsFile;
   std::string wordGraphFileName;
-  std::string outFile;
   float wgPruningThreshold;
-  std::vector<float> weightVec;
 
   thot_ms_dec_pars()
     {
-      W=PMSTACK_W_DEFAULT;
-      S=PMSTACK_S_DEFAULT;
-      A=PMSTACK_A_DEFAULT;
-      nomon=PMSTACK_NOMON_DEFAULT;
-      I=PMSTACK_I_DEFAULT;
-      G=PMSTACK_G_DEFAULT;
-      heuristic=PMSTACK_H_DEFAULT;
-      be=0;
-      wgPruningThreshold=DISABLE_WORDGRAPH;
       wgPruningThreshold=UNLIMITED_DENSITY;
-      verbosity=0;
     }
+
+  void takeParametersGivenArgcArgv(int argc,
+                                   char *argv[]);
+};
+
+    // Data shared by the translation threads
+struct CorpusTranslationData
+{
+  const thot_ms_dec_pars* tdpPtr;
+  std::vector<std::string> srcSentVec;
+  std::vector<std::string> transVec;
+  std::vector<std::string> logVec;
+  std::vector<bool> transReady;
+  unsigned int nextSentIdx;
+  double total_time;
+  pthread_mutex_t mut;
+  pthread_cond_t cond;
+};
+
+    // Arguments given to each translation thread
+struct TranslationThreadArgs
+{
+  DecoderWorkerData* dwdPtr;
+  CorpusTranslationData* ctdPtr;
 };
 
 //--------------- Function Declarations ------------------------------
 
-int init_translator_legacy_impl(const thot_ms_dec_pars& tdp);
-void set_default_models(void);
-int add_model_features(const thot_ms_dec_pars& tdp);
-int init_translator_feat_impl(const thot_ms_dec_pars& tdp);
-bool featureBasedImplIsEnabled(void);
-int init_translator(const thot_ms_dec_pars& tdp);
-void release_translator_legacy_impl(void);
-void release_translator_feat_impl(void);
-void release_translator(void);
+void translate_sentence(const DecoderWorkerData& dwd,
+                        const thot_ms_dec_pars& tdp,
+                        int sentNo,
+                        const std::string& srcSentenceString,
+                        std::string& trans,
+                        std::ostream& logS,
+                        double& elapsedTime);
 int translate_corpus(const thot_ms_dec_pars& tdp);
-std::vector<std::string> stringToStringVector(std::string s);
+int translate_corpus_seq(const thot_ms_dec_pars& tdp);
+int translate_corpus_mt(const thot_ms_dec_pars& tdp);
+void* translation_thread(void* args);
 void version(void);
 int handleParameters(int argc,
                      char *argv[],
                      thot_ms_dec_pars& pars);
-int takeParameters(int argc,
-                   char *argv[],
-                   thot_ms_dec_pars& tdp);
-int takeParametersFromCfgFile(std::string cfgFileName,
-                              thot_ms_dec_pars& tdp);
-void takeParametersGivenArgcArgv(int argc,
-                                 char *argv[],
-                                 thot_ms_dec_pars& tdp);
 int checkParameters(const thot_ms_dec_pars& tdp);
 void printParameters(const thot_ms_dec_pars& tdp);
 void printUsage(void);
 
-//--------------- Global variables -----------------------------------
-
-DynClassFactoryHandler dynClassFactoryHandler;
-LangModelInfo* langModelInfoPtr;
-PhraseModelInfo* phrModelInfoPtr;
-SwModelInfo* swModelInfoPtr;
-BaseTranslationMetadata<SmtModel::HypScoreInfo> * trMetadataPtr;
-BaseLogLinWeightUpdater* llWeightUpdaterPtr;
-BasePbTransModel<SmtModel::Hypothesis>* smtModelPtr;
-BaseStackDecoder<SmtModel>* stackDecoderPtr;
-_stackDecoderRec<SmtModel>* stackDecoderRecPtr;
-
-    // Variables related to feature-based implementation
-StdFeatureHandler stdFeatureHandler;
-CustomFeatureHandler customFeatureHandler;
-bool featureBasedImplEnabled;
-
 //--------------- Function Definitions -------------------------------
 
 //--------------- main function
@@ -165,6 +110,11 @@ int main(int argc, char *argv[])
   }
   else
   {
+        // Best score pruning is only applied if word graphs are
+        // disabled
+    tdp.bestScorePruning=(tdp.wgPruningThreshold==DISABLE_WORDGRAPH);
+    tdp.wordGraph=(tdp.wordGraphFileName!="" && tdp.wgPruningThreshold!=DISABLE_WORDGRAPH);
+    
         // init translator    
     if(init_translator(tdp)==THOT_ERROR)
     {      
@@ -182,447 +132,244 @@ int main(int argc, char *argv[])
 }
 
 //---------------
-int init_translator(const thot_ms_dec_pars& tdp)
+void translate_sentence(const DecoderWorkerData& dwd,
+                        const thot_ms_dec_pars& tdp,
+                        int sentNo,
+                        const std::string& srcSentenceString,
+                        std::string& trans,
+                        std::ostream& logS,
+                        double& elapsedTime)
 {
-      // Print library directory path for so files
-  std::cerr<<StrProcUtils::getLibDirVarNameValue()<<" = "<<StrProcUtils::getLibDir()<<std::endl;
-
-      // Determine which implementation is being used
-  featureBasedImplEnabled=featureBasedImplIsEnabled();
-
-      // Call the appropriate initialization for current implementation
-  if(featureBasedImplEnabled)
-    return init_translator_feat_impl(tdp);
-  else
-    return init_translator_legacy_impl(tdp);
-}
-
-//--------------------------
-bool featureBasedImplIsEnabled(void)
-{
-  BasePbTransModel<SmtModel::Hypothesis>* tmpSmtModelPtr=new SmtModel();
-  _pbTransModel<SmtModel::Hypothesis>* pbtm_ptr=dynamic_cast<_pbTransModel<SmtModel::Hypothesis>* >(tmpSmtModelPtr);
-  if(pbtm_ptr)
-  {
-    delete tmpSmtModelPtr;
-    return true;
-  }
-  else
-  {
-    delete tmpSmtModelPtr;
-    return false;
-  }
-}
-
-//---------------
-int init_translator_legacy_impl(const thot_ms_dec_pars& tdp)
-{
-  int ret;
-  
-  std::cerr<<"\n- Initializing translator...\n\n";
-
-      // Show static types
-  std::cerr<<"Static types:"<<std::endl;
-  std::cerr<<"- SMT model type (SmtModel): "<<SMT_MODEL_TYPE_NAME<<" ("<<THOT_SMTMODEL_H<<")"<<std::endl;
-  std::cerr<<"- Language model state (LM_Hist): "<<LM_STATE_TYPE_NAME<<" ("<<THOT_LM_STATE_H<<")"<<std::endl;
-  std::cerr<<"- Partial probability information for single word models (PpInfo): "<<PPINFO_TYPE_NAME<<" ("<<THOT_PPINFO_H<<")"<<std::endl;
-
-      // Obtain info about translation model entries
-  unsigned int numTransModelEntries;
-  std::vector<ModelDescriptorEntry> modelDescEntryVec;
-  if(extractModelEntryInfo(tdp.transModelPref.c_str(),modelDescEntryVec)==THOT_OK)
-    numTransModelEntries=modelDescEntryVec.size();
-  else
-    numTransModelEntries=1;
-
-      // Initialize class factories
-  ret=dynClassFactoryHandler.init_smt(THOT_MASTER_INI_PATH);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
+  double elapsed_ant=0,elapsed=0,ucpu,scpu;
 
-      // Create decoder variables
-  langModelInfoPtr=new LangModelInfo;
-  langModelInfoPtr->wpModelPtr=dynClassFactoryHandler.baseWordPenaltyModelDynClassLoader.make_obj(dynClassFactoryHandler.baseWordPenaltyModelInitPars);
-  if(langModelInfoPtr->wpModelPtr==NULL)
+  if(tdp.verbosity)
   {
-    std::cerr<<"Error: BaseWordPenaltyModel pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
+    logS<<sentNo<<std::endl<<srcSentenceString<<std::endl;
+    ctimer(&elapsed_ant,&ucpu,&scpu);
   }
+       
+      //------- Translate sentence
+  SmtModel::Hypothesis result=dwd.stackDecoderPtr->translate(srcSentenceString);
 
-  langModelInfoPtr->lModelPtr=dynClassFactoryHandler.baseNgramLMDynClassLoader.make_obj(dynClassFactoryHandler.baseNgramLMInitPars);
-  if(langModelInfoPtr->lModelPtr==NULL)
-  {
-    std::cerr<<"Error: BaseNgramLM pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
+      //--------------------------
+  if(tdp.verbosity) ctimer(&elapsed,&ucpu,&scpu);
 
-  phrModelInfoPtr=new PhraseModelInfo;
-  phrModelInfoPtr->invPbModelPtr=dynClassFactoryHandler.basePhraseModelDynClassLoader.make_obj(dynClassFactoryHandler.basePhraseModelInitPars);
-  if(phrModelInfoPtr->invPbModelPtr==NULL)
+  trans=dwd.smtModelPtr->getTransInPlainText(result);
+          
+  if(tdp.verbosity)
   {
-    std::cerr<<"Error: BasePhraseModel pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
+    dwd.smtModelPtr->printHyp(result,logS,tdp.verbosity);
+#     ifdef THOT_STATS
+    dwd.stackDecoderPtr->printStats();
+#     endif
 
-      // Add one swm pointer per each translation model entry
-  swModelInfoPtr=new SwModelInfo;
-  for(unsigned int i=0;i<numTransModelEntries;++i)
-  {
-    swModelInfoPtr->swAligModelPtrVec.push_back(dynClassFactoryHandler.baseSwAligModelDynClassLoader.make_obj(dynClassFactoryHandler.baseSwAligModelInitPars));
-    if(swModelInfoPtr->swAligModelPtrVec[i]==NULL)
-    {
-      std::cerr<<"Error: BaseSwAligModel pointer could not be instantiated"<<std::endl;
-      return THOT_ERROR;
-    }
+    logS<<"- Elapsed Time: "<<elapsed-elapsed_ant<<std::endl<<std::endl;
   }
+  elapsedTime=elapsed-elapsed_ant;
 
-      // Add one inverse swm pointer per each translation model entry
-  for(unsigned int i=0;i<numTransModelEntries;++i)
+  if(dwd.stackDecoderRecPtr)
   {
-    swModelInfoPtr->invSwAligModelPtrVec.push_back(dynClassFactoryHandler.baseSwAligModelDynClassLoader.make_obj(dynClassFactoryHandler.baseSwAligModelInitPars));
-    if(swModelInfoPtr->invSwAligModelPtrVec[i]==NULL)
+        // Print wordgraph if the -wg option was given
+    if(tdp.wordGraphFileName!="")
     {
-      std::cerr<<"Error: BaseSwAligModel pointer could not be instantiated"<<std::endl;
-      return THOT_ERROR;
+      char wgFileNameForSent[256];
+      sprintf(wgFileNameForSent,"%s_%06d",tdp.wordGraphFileName.c_str(),sentNo);
+      dwd.stackDecoderRecPtr->pruneWordGraph(tdp.wgPruningThreshold);
+      dwd.stackDecoderRecPtr->printWordGraph(wgFileNameForSent);
     }
   }
 
-  llWeightUpdaterPtr=dynClassFactoryHandler.baseLogLinWeightUpdaterDynClassLoader.make_obj(dynClassFactoryHandler.baseLogLinWeightUpdaterInitPars);
-  if(llWeightUpdaterPtr==NULL)
+#ifdef THOT_ENABLE_GRAPH
+  char printGraphFileName[256];
+  std::ofstream graphOutS;
+  sprintf(printGraphFileName,"sent%d.graph_file",sentNo);
+  graphOutS.open(printGraphFileName,std::ios::out);
+  if(!graphOutS) std::cerr<<"Error while printing search graph to file."<<std::endl;
+  else
   {
-    std::cerr<<"Error: BaseLogLinWeightUpdater pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
+    dwd.stackDecoderPtr->printSearchGraphStream(graphOutS);
+    graphOutS<<"Stack ID. Out\n";
+    dwd.stackDecoderPtr->printGraphForHyp(result,graphOutS);
+    graphOutS.close();        
   }
+#endif        
+}
 
-  trMetadataPtr=dynClassFactoryHandler.baseTranslationMetadataDynClassLoader.make_obj(dynClassFactoryHandler.baseTranslationMetadataInitPars);
-  if(trMetadataPtr==NULL)
-  {
-    std::cerr<<"Error: BaseTranslationMetadata pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
+//---------------
+int translate_corpus(const thot_ms_dec_pars& tdp)
+{
+  if(tdp.numThreads>1)
+    return translate_corpus_mt(tdp);
+  else
+    return translate_corpus_seq(tdp);
+}
 
-      // Instantiate smt model
-  smtModelPtr=new SmtModel();
+//---------------
+int translate_corpus_seq(const thot_ms_dec_pars& tdp)
+{
+  int sentNo=0;    
+  double elapsedTime,total_time=0;
+      
+  std::ifstream testCorpusFile;                // Test corpus file stream
+  std::string srcSentenceString,trans;
   
-      // Link translation constraints
-  smtModelPtr->link_trans_metadata(trMetadataPtr);
+      // Decoder instance created during initialization
+  DecoderWorkerData dwd;
+  get_main_decoder(dwd);
+    
+      // Open test corpus file
+  testCorpusFile.open(tdp.sourceSentencesFile.c_str());    
+  testCorpusFile.seekg(0, std::ios::beg);
 
-      // Link language model, phrase model and single word model if
-      // appliable
-  _phraseBasedTransModel<SmtModel::Hypothesis>* phrbtm_ptr=dynamic_cast<_phraseBasedTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
-  if(phrbtm_ptr)
-  {
-    phrbtm_ptr->link_lm_info(langModelInfoPtr);
-    phrbtm_ptr->link_pm_info(phrModelInfoPtr);
-  }
-  _phrSwTransModel<SmtModel::Hypothesis>* base_pbswtm_ptr=dynamic_cast<_phrSwTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
-  if(base_pbswtm_ptr)
+  std::cerr<<"\n- Translating test corpus sentences...\n\n";
+
+  if(!testCorpusFile)
   {
-    base_pbswtm_ptr->link_swm_info(swModelInfoPtr);
+    std::cerr<<"Test corpus error!"<<std::endl;
+    return THOT_ERROR;
   }
-
-  if(phrbtm_ptr)
+  else
   {
-    ret=phrbtm_ptr->loadLangModel(tdp.languageModelFileName.c_str());
-    if(ret==THOT_ERROR)
+        // Open output file if required
+    std::ofstream outS;
+    if(!tdp.outFile.empty())
     {
-      release_translator();
-      return THOT_ERROR;
+      outS.open(tdp.outFile.c_str(),std::ios::out);
+      if(!outS) std::cerr<<"Error while opening output file."<<std::endl;
     }
     
-    ret=phrbtm_ptr->loadAligModel(tdp.transModelPref.c_str());
-    if(ret==THOT_ERROR)
+        // Translate corpus sentences
+    while(!testCorpusFile.eof())
     {
-      release_translator();
-      return THOT_ERROR;
-    }
-  }
-
-      // Set heuristic
-  smtModelPtr->setHeuristic(tdp.heuristic);
-
-      // Set weights
-  smtModelPtr->setWeights(tdp.weightVec);
-  smtModelPtr->printWeights(std::cerr);
-  std::cerr<<std::endl;
+      getline(testCorpusFile,srcSentenceString);
 
-      // Set model parameters
-  smtModelPtr->set_W_par(tdp.W);
-  smtModelPtr->set_A_par(tdp.A);
-  smtModelPtr->set_U_par(tdp.nomon);
+          // Discard last sentence if it is empty
+      if(srcSentenceString=="" && testCorpusFile.eof())
+        break;
+      
+      ++sentNo;
 
-      // Set verbosity
-  smtModelPtr->setVerbosity(tdp.verbosity);
-    
-      // Create a translator instance
-  stackDecoderPtr=dynClassFactoryHandler.baseStackDecoderDynClassLoader.make_obj(dynClassFactoryHandler.baseStackDecoderInitPars);
-  if(stackDecoderPtr==NULL)
-  {
-    std::cerr<<"Error: BaseStackDecoder pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
+      translate_sentence(dwd,tdp,sentNo,srcSentenceString,trans,std::cerr,elapsedTime);
+      total_time+=elapsedTime;
 
-      // Determine if the translator incorporates hypotheses recombination
-  stackDecoderRecPtr=dynamic_cast<_stackDecoderRec<SmtModel>*>(stackDecoderPtr);
+      if(tdp.outFile.empty())
+        std::cout<<trans<<std::endl;
+      else
+        outS<<trans<<std::endl;
+    }
+        // Close output file
+    if(!tdp.outFile.empty())
+    {
+      outS.close();
+    }
 
-      // Link translation model
-  ret=stackDecoderPtr->link_smt_model(smtModelPtr);
-  if(ret==THOT_ERROR)
-  {
-    std::cerr<<"Error while linking smt model to decoder, revise master.ini file"<<std::endl;
-    return THOT_ERROR;
+        // Close test corpus file
+    testCorpusFile.close();
   }
-  
-      // Set translator parameters
-  stackDecoderPtr->set_S_par(tdp.S);
-  stackDecoderPtr->set_I_par(tdp.I);
-  stackDecoderPtr->set_G_par(tdp.G);
-
-      // Enable best score pruning if the decoder is not going to obtain
-      // n-best translations or word-graphs
-  if(tdp.wgPruningThreshold==DISABLE_WORDGRAPH)
-    stackDecoderPtr->useBestScorePruning(true);
 
-      // Set breadthFirst flag
-  stackDecoderPtr->set_breadthFirst(!tdp.be);
-
-  if(stackDecoderRecPtr)
+  if(tdp.verbosity)
   {
-        // Enable word graph according to wgPruningThreshold
-    if(tdp.wordGraphFileName!="")
-    {
-      if(tdp.wgPruningThreshold!=DISABLE_WORDGRAPH)
-        stackDecoderRecPtr->enableWordGraph();
-    }
+    std::cerr<<"- Time per sentence: "<<total_time/sentNo<<std::endl;
   }
-      // Set translator verbosity
-  stackDecoderPtr->setVerbosity(tdp.verbosity);
 
   return THOT_OK;
 }
 
 //---------------
-void set_default_models(void)
-{
-  stdFeatureHandler.setWordPenSoFile(dynClassFactoryHandler.baseWordPenaltyModelSoFileName);
-  stdFeatureHandler.setDefaultLangSoFile(dynClassFactoryHandler.baseNgramLMSoFileName);
-  stdFeatureHandler.setDefaultTransSoFile(dynClassFactoryHandler.basePhraseModelSoFileName);
-  stdFeatureHandler.setDefaultSingleWordSoFile(dynClassFactoryHandler.baseSwAligModelSoFileName);
-}
-
-//---------------
-int load_model_features(const thot_ms_dec_pars& tdp)
+void* translation_thread(void* args)
 {
-      // Load monolingual log-linear model features
-  int ret=stdFeatureHandler.loadMonolingualFeats(tdp.languageModelFileName,tdp.verbosity);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
-
-      // Load bilingual log-linear model features
-  ret=stdFeatureHandler.loadBilingualFeats(tdp.transModelPref,tdp.verbosity);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
-
-  return THOT_OK;
+  TranslationThreadArgs* ttaPtr=(TranslationThreadArgs*) args;
+  CorpusTranslationData* ctdPtr=ttaPtr->ctdPtr;
+  const thot_ms_dec_pars& tdp=*ctdPtr->tdpPtr;
+
+  while(true)
+  {
+        // Obtain index of next sentence to be translated
+    pthread_mutex_lock(&ctdPtr->mut);
+    unsigned int sentIdx=ctdPtr->nextSentIdx;
+    if(sentIdx<ctdPtr->srcSentVec.size())
+      ++ctdPtr->nextSentIdx;
+    pthread_mutex_unlock(&ctdPtr->mut);
+
+    if(sentIdx>=ctdPtr->srcSentVec.size())
+      break;
+
+        // Translate sentence
+    std::string trans;
+    std::ostringstream logS;
+    double elapsedTime;
+    translate_sentence(*ttaPtr->dwdPtr,tdp,sentIdx+1,ctdPtr->srcSentVec[sentIdx],trans,logS,elapsedTime);
+
+        // Store results and notify output thread
+    pthread_mutex_lock(&ctdPtr->mut);
+    ctdPtr->transVec[sentIdx]=trans;
+    ctdPtr->logVec[sentIdx]=logS.str();
+    ctdPtr->transReady[sentIdx]=true;
+    ctdPtr->total_time+=elapsedTime;
+    pthread_cond_broadcast(&ctdPtr->cond);
+    pthread_mutex_unlock(&ctdPtr->mut);
+  }
+  
+  return NULL;
 }
 
 //---------------
-int init_translator_feat_impl(const thot_ms_dec_pars& tdp)
+int translate_corpus_mt(const thot_ms_dec_pars& tdp)
 {
-  int ret;
-  
-  std::cerr<<"\n- Initializing translator...\n\n";
-
-      // Show static types
-  std::cerr<<"Static types:"<<std::endl;
-  std::cerr<<"- SMT model type (SmtModel): "<<SMT_MODEL_TYPE_NAME<<" ("<<THOT_SMTMODEL_H<<")"<<std::endl;
-  std::cerr<<"- Language model state (LM_Hist): "<<LM_STATE_TYPE_NAME<<" ("<<THOT_LM_STATE_H<<")"<<std::endl;
-  std::cerr<<"- Partial probability information for single word models (PpInfo): "<<PPINFO_TYPE_NAME<<" ("<<THOT_PPINFO_H<<")"<<std::endl;
-
-      // Initialize class factories
-  ret=dynClassFactoryHandler.init_smt(THOT_MASTER_INI_PATH);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
-
-      // Create decoder variables
-  llWeightUpdaterPtr=dynClassFactoryHandler.baseLogLinWeightUpdaterDynClassLoader.make_obj(dynClassFactoryHandler.baseLogLinWeightUpdaterInitPars);
-  if(llWeightUpdaterPtr==NULL)
-  {
-    std::cerr<<"Error: BaseLogLinWeightUpdater pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
-
-  trMetadataPtr=dynClassFactoryHandler.baseTranslationMetadataDynClassLoader.make_obj(dynClassFactoryHandler.baseTranslationMetadataInitPars);
-  if(trMetadataPtr==NULL)
-  {
-    std::cerr<<"Error: BaseTranslationMetadata pointer could not be instantiated"<<std::endl;
-    return THOT_ERROR;
-  }
-
-      // Instantiate smt model
-  smtModelPtr=new SmtModel();
-  
-      // Link translation constraints
-  smtModelPtr->link_trans_metadata(trMetadataPtr);
-
-      // Link standard features information
-  _pbTransModel<SmtModel::Hypothesis>* pbtm_ptr=dynamic_cast<_pbTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
-  if(pbtm_ptr)
-    pbtm_ptr->link_std_feats_info(stdFeatureHandler.getFeatureInfoPtr());
-
-      // Set default models for standard feature handler
-  set_default_models();
-  
-      // Load model features
-  ret=load_model_features(tdp);
-  if(ret==THOT_ERROR)
-    return THOT_ERROR;
-
-      // Load custom features if they were provided
-  if(!tdp.customFeatsFile.empty())
-  {
-    ret=customFeatureHandler.loadCustomFeats(tdp.customFeatsFile,tdp.verbosity);
-    if(ret==THOT_ERROR) return THOT_ERROR;
-  }
-  
-      // Link custom features information
-  if(pbtm_ptr)
-    pbtm_ptr->link_custom_feats_info(customFeatureHandler.getFeatureInfoPtr());
-
-      // Set heuristic
-  smtModelPtr->setHeuristic(tdp.heuristic);
+  CorpusTranslationData ctd;
+  std::ifstream testCorpusFile;                // Test corpus file stream
+  std::string srcSentenceString;
+  double elapsed_ant,elapsed,ucpu,scpu;
 
-      // Set weights
-  smtModelPtr->setWeights(tdp.weightVec);
-  smtModelPtr->printWeights(std::cerr);
-  std::cerr<<std::endl;
+      // Open test corpus file
+  testCorpusFile.open(tdp.sourceSentencesFile.c_str());    
 
-      // Set model parameters
-  smtModelPtr->set_W_par(tdp.W);
-  smtModelPtr->set_A_par(tdp.A);
-  smtModelPtr->set_U_par(tdp.nomon);
+  std::cerr<<"\n- Translating test corpus sentences ("<<tdp.numThreads<<" threads)...\n\n";
 
-      // Set verbosity
-  smtModelPtr->setVerbosity(tdp.verbosity);
-    
-      // Create a translator instance
-  stackDecoderPtr=dynClassFactoryHandler.baseStackDecoderDynClassLoader.make_obj(dynClassFactoryHandler.baseStackDecoderInitPars);
-  if(stackDecoderPtr==NULL)
+  if(!testCorpusFile)
   {
-    std::cerr<<"Error: BaseStackDecoder pointer could not be instantiated"<<std::endl;
+    std::cerr<<"Test corpus error!"<<std::endl;
     return THOT_ERROR;
   }
 
-      // Determine if the translator incorporates hypotheses recombination
-  stackDecoderRecPtr=dynamic_cast<_stackDecoderRec<SmtModel>*>(stackDecoderPtr);
-
-      // Link translation model
-  ret=stackDecoderPtr->link_smt_model(smtModelPtr);
-  if(ret==THOT_ERROR)
+      // Read test corpus
+  while(!testCorpusFile.eof())
   {
-    std::cerr<<"Error while linking smt model to decoder, revise master.ini file"<<std::endl;
-    return THOT_ERROR;
+    getline(testCorpusFile,srcSentenceString);
+        // Discard last sentence if it is empty
+    if(srcSentenceString=="" && testCorpusFile.eof())
+      break;
+    ctd.srcSentVec.push_back(srcSentenceString);
   }
+  testCorpusFile.close();
 
-      // Set translator parameters
-  stackDecoderPtr->set_S_par(tdp.S);
-  stackDecoderPtr->set_I_par(tdp.I);
-  stackDecoderPtr->set_G_par(tdp.G);
-
-      // Enable best score pruning if the decoder is not going to obtain
-      // n-best translations or word-graphs
-  if(tdp.wgPruningThreshold==DISABLE_WORDGRAPH)
-    stackDecoderPtr->useBestScorePruning(true);
+      // Initialize shared data
+  ctd.tdpPtr=&tdp;
+  ctd.transVec.resize(ctd.srcSentVec.size());
+  ctd.logVec.resize(ctd.srcSentVec.size());
+  ctd.transReady.resize(ctd.srcSentVec.size(),false);
+  ctd.nextSentIdx=0;
+  ctd.total_time=0;
+  pthread_mutex_init(&ctd.mut,NULL);
+  pthread_cond_init(&ctd.cond,NULL);
 
-      // Set breadthFirst flag
-  stackDecoderPtr->set_breadthFirst(!tdp.be);
-
-  if(stackDecoderRecPtr)
+      // Create one decoder instance per thread, the first thread uses
+      // the decoder created during initialization
+  std::vector<DecoderWorkerData> dwdVec(tdp.numThreads);
+  get_main_decoder(dwdVec[0]);
+  int ret=THOT_OK;
+  for(unsigned int i=1;i<dwdVec.size();++i)
   {
-        // Enable word graph according to wgPruningThreshold
-    if(tdp.wordGraphFileName!="")
+    if(create_worker_decoder(tdp,dwdVec[i])==THOT_ERROR)
     {
-      if(tdp.wgPruningThreshold!=DISABLE_WORDGRAPH)
-        stackDecoderRecPtr->enableWordGraph();
+      for(unsigned int j=1;j<=i;++j)
+        release_worker_decoder(dwdVec[j]);
+      ret=THOT_ERROR;
+      break;
     }
   }
-      // Set translator verbosity
-  stackDecoderPtr->setVerbosity(tdp.verbosity);
-  
-  return THOT_OK;
-}
 
-//---------------
-void release_translator(void)
-{
-  if(featureBasedImplEnabled)
-    release_translator_feat_impl();
-  else
-    release_translator_legacy_impl();
-}
-
-//---------------
-void release_translator_legacy_impl(void)
-{
-  delete langModelInfoPtr->lModelPtr;
-  delete langModelInfoPtr->wpModelPtr;
-  delete langModelInfoPtr;
-  delete phrModelInfoPtr->invPbModelPtr;
-  delete phrModelInfoPtr;
-  for(unsigned int i=0;i<swModelInfoPtr->swAligModelPtrVec.size();++i)
-    delete swModelInfoPtr->swAligModelPtrVec[i];
-  for(unsigned int i=0;i<swModelInfoPtr->invSwAligModelPtrVec.size();++i)
-    delete swModelInfoPtr->invSwAligModelPtrVec[i];
-  delete swModelInfoPtr;
-  delete stackDecoderPtr;
-  delete llWeightUpdaterPtr;
-  delete trMetadataPtr;
-  delete smtModelPtr;
-
-      // Release class factory handler
-  dynClassFactoryHandler.release_smt();
-}
-
-//---------------
-void release_translator_feat_impl(void)
-{
-  delete stackDecoderPtr;
-  delete llWeightUpdaterPtr;
-  delete trMetadataPtr;
-  delete smtModelPtr;
-
-      // Delete features information
-  stdFeatureHandler.clear();
-  customFeatureHandler.clear();
-  
-      // Release class factory handler
-  dynClassFactoryHandler.release_smt();
-}
-
-//---------------
-int translate_corpus(const thot_ms_dec_pars& tdp)
-{
-  SmtModel::Hypothesis result;     // Results of the translation
-  SmtModel::Hypothesis anotherTrans;     // Another results of the translation
-  int sentNo=0;    
-  double elapsed_ant,elapsed,ucpu,scpu,total_time=0;
-      
-  std::ifstream testCorpusFile;                // Test corpus file stream
-  std::string srcSentenceString,s;
-  
-    
-      // Open test corpus file
-  testCorpusFile.open(tdp.sourceSentencesFile.c_str());    
-  testCorpusFile.seekg(0, std::ios::beg);
-
-  std::cerr<<"\n- Translating test corpus sentences...\n\n";
-
-  if(!testCorpusFile)
-  {
-    std::cerr<<"Test corpus error!"<<std::endl;
-    return THOT_ERROR;
-  }
-  else
+  if(ret==THOT_OK)
   {
         // Open output file if required
     std::ofstream outS;
@@ -631,89 +378,79 @@ int translate_corpus(const thot_ms_dec_pars& tdp)
       outS.open(tdp.outFile.c_str(),std::ios::out);
       if(!outS) std::cerr<<"Error while opening output file."<<std::endl;
     }
-    
-        // Translate corpus sentences
-    while(!testCorpusFile.eof())
-    {
-      getline(testCorpusFile,srcSentenceString);
-
-          // Discard last sentence if it is empty
-      if(srcSentenceString=="" && testCorpusFile.eof())
-        break;
-      
-      ++sentNo;
-        
-      if(tdp.verbosity)
-      {
-        std::cerr<<sentNo<<std::endl<<srcSentenceString<<std::endl;
-        ctimer(&elapsed_ant,&ucpu,&scpu);
-      }
-       
-          //------- Translate sentence
-      result=stackDecoderPtr->translate(srcSentenceString);
-
-          //--------------------------
-      if(tdp.verbosity) ctimer(&elapsed,&ucpu,&scpu);
-
-      if(tdp.outFile.empty())
-        std::cout<<smtModelPtr->getTransInPlainText(result)<<std::endl;
-      else
-        outS<<smtModelPtr->getTransInPlainText(result)<<std::endl;
-          
-      if(tdp.verbosity)
-      {
-        smtModelPtr->printHyp(result,std::cerr,tdp.verbosity);
-#         ifdef THOT_STATS
-        stackDecoderPtr->printStats();
-#         endif
 
-        std::cerr<<"- Elapsed Time: "<<elapsed-elapsed_ant<<std::endl<<std::endl;
-        total_time+=elapsed-elapsed_ant;
-      }
+        // Initialize timer before creating threads
+    ctimer(&elapsed_ant,&ucpu,&scpu);
 
-      if(stackDecoderRecPtr)
+        // Launch translation threads
+    std::vector<TranslationThreadArgs> ttaVec(dwdVec.size());
+    std::vector<pthread_t> tidVec(dwdVec.size());
+    unsigned int numLaunched=0;
+    for(unsigned int i=0;i<dwdVec.size();++i)
+    {
+      ttaVec[i].dwdPtr=&dwdVec[i];
+      ttaVec[i].ctdPtr=&ctd;
+      if(pthread_create(&tidVec[i],NULL,translation_thread,(void*) &ttaVec[i])!=0)
       {
-            // Print wordgraph if the -wg option was given
-        if(tdp.wordGraphFileName!="")
-        {
-          char wgFileNameForSent[256];
-          sprintf(wgFileNameForSent,"%s_%06d",tdp.wordGraphFileName.c_str(),sentNo);
-          stackDecoderRecPtr->pruneWordGraph(tdp.wgPruningThreshold);
-          stackDecoderRecPtr->printWordGraph(wgFileNameForSent);
-        }
+        std::cerr<<"Error while creating translation thread"<<std::endl;
+        break;
       }
+      ++numLaunched;
+    }
 
-#ifdef THOT_ENABLE_GRAPH
-      char printGraphFileName[256];
-      ofstream graphOutS;
-      sprintf(printGraphFileName,"sent%d.graph_file",sentNo);
-      graphOutS.open(printGraphFileName,ios::out);
-      if(!graphOutS) std::cerr<<"Error while printing search graph to file."<<std::endl;
-      else
+    if(numLaunched==0)
+    {
+      ret=THOT_ERROR;
+    }
+    else
+    {
+          // Print translations following the order of the test corpus
+      for(unsigned int n=0;n<ctd.srcSentVec.size();++n)
       {
-        stackDecoderPtr->printSearchGraphStream(graphOutS);
-        graphOutS<<"Stack ID. Out\n";
-        stackDecoderPtr->printGraphForHyp(result,graphOutS);
-        graphOutS.close();        
+        pthread_mutex_lock(&ctd.mut);
+        while(!ctd.transReady[n])
+          pthread_cond_wait(&ctd.cond,&ctd.mut);
+        std::string trans;
+        std::string log;
+        trans.swap(ctd.transVec[n]);
+        log.swap(ctd.logVec[n]);
+        pthread_mutex_unlock(&ctd.mut);
+
+        std::cerr<<log;
+        if(tdp.outFile.empty())
+          std::cout<<trans<<std::endl;
+        else
+          outS<<trans<<std::endl;
       }
-#endif        
     }
+
+        // Wait for translation threads
+    for(unsigned int i=0;i<numLaunched;++i)
+      pthread_join(tidVec[i],NULL);
+
+    ctimer(&elapsed,&ucpu,&scpu);
+
         // Close output file
     if(!tdp.outFile.empty())
     {
       outS.close();
     }
 
-        // Close test corpus file
-    testCorpusFile.close();
-  }
+    if(tdp.verbosity && !ctd.srcSentVec.empty())
+    {
+      std::cerr<<"- Time per sentence: "<<ctd.total_time/ctd.srcSentVec.size()<<std::endl;
+      std::cerr<<"- Wall-clock time per sentence: "<<(elapsed-elapsed_ant)/ctd.srcSentVec.size()<<std::endl;
+    }
 
-  if(tdp.verbosity)
-  {
-    std::cerr<<"- Time per sentence: "<<total_time/sentNo<<std::endl;
+        // Release decoder instances
+    for(unsigned int i=1;i<dwdVec.size();++i)
+      release_worker_decoder(dwdVec[i]);
   }
 
-  return THOT_OK;
+  pthread_mutex_destroy(&ctd.mut);
+  pthread_cond_destroy(&ctd.cond);
+
+  return ret;
 }
 
 //---------------
@@ -750,195 +487,31 @@ int handleParameters(int argc,
 }
 
 //---------------
-int takeParameters(int argc,
-                   char *argv[],
-                   thot_ms_dec_pars& tdp)
+void thot_ms_dec_pars::takeParametersGivenArgcArgv(int argc,
+                                                   char *argv[])
 {
-      // Check if a configuration file was provided
-  std::string cfgFileName;
-  int err=readSTLstring(argc,argv, "-c", &cfgFileName);
-  if(!err)
-  {
-        // Process configuration file
-    err=takeParametersFromCfgFile(cfgFileName,tdp);
-    if(err==THOT_ERROR) return THOT_ERROR;
-  }
-      // process command line parameters
-  takeParametersGivenArgcArgv(argc,argv,tdp);
-  return THOT_OK;
-}
-
-//---------------
-int takeParametersFromCfgFile(std::string cfgFileName,
-                              thot_ms_dec_pars& tdp)
-{
-  std::cerr<<"Processing configuration file ("<<cfgFileName<<")"<<std::endl;
-  
-      // Extract parameters from configuration file
-  std::string comment="#";
-  int cfgFileArgc;
-  std::vector<std::string> cfgFileArgvStl;
-  int ret=extractParsFromFile(cfgFileName.c_str(),cfgFileArgc,cfgFileArgvStl,comment);
-  if(ret==THOT_ERROR) return THOT_ERROR;
-
-      // Create argv for cfg file
-  char** cfgFileArgv=(char**) malloc(cfgFileArgc*sizeof(char*));
-  for(unsigned int i=0;i<cfgFileArgvStl.size();++i)
-  {
-    cfgFileArgv[i]=(char*) malloc((cfgFileArgvStl[i].size()+1)*sizeof(char));
-    strcpy(cfgFileArgv[i],cfgFileArgvStl[i].c_str());
-  }
-      // Process extracted parameters
-  takeParametersGivenArgcArgv(cfgFileArgc,cfgFileArgv,tdp);
-
-      // Release allocated memory
-  for(unsigned int i=0;i<cfgFileArgvStl.size();++i)
-  {
-    free(cfgFileArgv[i]);
-  }
-  free(cfgFileArgv);
-
-      // Return without error
-  return THOT_OK;
-}
-
-//---------------
-void takeParametersGivenArgcArgv(int argc,
-                                 char *argv[],
-                                 thot_ms_dec_pars& tdp)
-{
-     // Takes W 
- int err=readFloat(argc,argv, "-W", &tdp.W);
-
-     // Takes S parameter 
- err=readInt(argc,argv, "-S", &tdp.S);
-
-     // Takes A parameter 
- err=readInt(argc,argv, "-A", &tdp.A);
-
-     // Takes U parameter 
- err=readInt(argc,argv, "-nomon", &tdp.nomon);
-
-     // Takes I parameter 
- err=readInt(argc,argv, "-I", &tdp.I);
-
-     // Takes I parameter 
- err=readInt(argc,argv, "-G", &tdp.G);
-
-     // Takes h parameter 
- err=readInt(argc,argv, "-h", &tdp.heuristic);
-
-     // Take language model file name
- err=readSTLstring(argc,argv, "-lm", &tdp.languageModelFileName);
-
-     // Take read table prefix 
- err=readSTLstring(argc,argv, "-tm", &tdp.transModelPref);
-
-     // Take custom features file 
- err=readSTLstring(argc,argv, "-cf", &tdp.customFeatsFile);
-
-     // Take file name with the sentences to be translated 
- err=readSTLstring(argc,argv, "-t",&tdp.sourceSentencesFile);
-
-      // Take output file name
- err=readSTLstring(argc,argv, "-o",&tdp.outFile);
- 
-       // read -be option
- err=readOption(argc,argv,"-be");
- if(err!=-1)
- {
-   tdp.be=1;
- }      
-     
-     // Take -tmw parameter
- err=readFloatSeq(argc,argv, "-tmw", tdp.weightVec);
+     // Take common parameters
+ thot_ms_dec_common_pars::takeParametersGivenArgcArgv(argc,argv);
 
      // Take -wg parameter
- err=readSTLstring(argc,argv, "-wg", &tdp.wordGraphFileName);
+ int err=readSTLstring(argc,argv, "-wg", &wordGraphFileName);
  if(err!=-1)
  {
        // Take -wgp parameter 
-   err=readFloat(argc,argv, "-wgp", &tdp.wgPruningThreshold);
- }
-
-     // Take verbosity parameter
- err=readOption(argc,argv,"-v");
- if(err==-1)
- {
-       // -v not found
-   err=readOption(argc,argv,"-v1");
-   if(err==-1)
-   {
-         // -v1 not found
-     err=readOption(argc,argv,"-v2");
-     if(err==-1)
-     {
-           // -v2 not found
-       tdp.verbosity=0;
-     }
-     else
-     {
-           // -v2 found
-       tdp.verbosity=3;
-     }
-   }
-   else
-   {
-         // -v1 found
-     tdp.verbosity=2;
-   }
- }
- else
- {
-       // -v found
-   tdp.verbosity=1;
+   err=readFloat(argc,argv, "-wgp", &wgPruningThreshold);
  }
 }
 
 //---------------
 int checkParameters(const thot_ms_dec_pars& tdp)
 {
-  if(tdp.languageModelFileName.empty())
-  {
-    std::cerr<<"Error: parameter -lm not given!"<<std::endl;
-    return THOT_ERROR;   
-  }
-  
-  if(tdp.transModelPref.empty())
-  {
-    std::cerr<<"Error: parameter -tm not given!"<<std::endl;
-    return THOT_ERROR;   
-  }
-
-  if(tdp.sourceSentencesFile.empty())
-  {
-    std::cerr<<"Error: parameter -t not given!"<<std::endl;
-    return THOT_ERROR;   
-  }
-  
-  return THOT_OK;
+  return checkCommonParameters(tdp);
 }
 
 //---------------
 void printParameters(const thot_ms_dec_pars& tdp)
 {
- std::cerr<<"W: "<<tdp.W<<std::endl;   
- std::cerr<<"S: "<<tdp.S<<std::endl;   
- std::cerr<<"A: "<<tdp.A<<std::endl;
- std::cerr<<"I: "<<tdp.I<<std::endl;
-#ifdef MULTI_STACK_USE_GRAN
- std::cerr<<"G: "<<tdp.G<<std::endl;
-#endif
- std::cerr<<"h: "<<tdp.heuristic<<std::endl;
- std::cerr<<"be: "<<tdp.be<<std::endl;
- std::cerr<<"nomon: "<<tdp.nomon<<std::endl;
- std::cerr<<"weight vector:";
- for(unsigned int i=0;i<tdp.weightVec.size();++i)
-   std::cerr<<" "<<tdp.weightVec[i];
- std::cerr<<std::endl;
- std::cerr<<"lmfile: "<<tdp.languageModelFileName<<std::endl;   
- std::cerr<<"tm files prefix: "<<tdp.transModelPref<<std::endl;
- std::cerr<<"test file: "<<tdp.sourceSentencesFile<<std::endl;
+ printCommonParameters(tdp);
  if(tdp.wordGraphFileName!="")
  {
    std::cerr<<"word graph file prefix: "<<tdp.wordGraphFileName<<std::endl;
@@ -954,28 +527,11 @@ void printParameters(const thot_ms_dec_pars& tdp)
  std::cerr<<"verbosity level: "<<tdp.verbosity<<std::endl;
 }
 
-//---------------
-std::vector<std::string> stringToStringVector(std::string s)
-{
- std::vector<std::string> vs;	
- std::string aux="";
- unsigned int i;	
-
- for(i=0;i<s.size();++i)
-    {
-	 if(s[i]!=' ') aux+=s[i];
-         else if(aux!="") {vs.push_back(aux); aux="";}		 
-	}
- 
- if(aux!="") vs.push_back(aux); 	
- return vs;	
-}
-
 //---------------
 void printUsage(void)
 {
   std::cerr << "thot_ms_dec      [-c <string>] [-tm <string>] [-lm <string>]"<<std::endl;
-  std::cerr << "                 -t <string> [-o <string>]"<<std::endl;
+  std::cerr << "                 -t <string> [-o <string>] [-nt <int>] [-et <int>]"<<std::endl;
   std::cerr << "                 [-W <float>] [-S <int>] [-A <int>]"<<std::endl;
   std::cerr << "                 [-I <int>] [-G <int>] [-h <int>]"<<std::endl;
   std::cerr << "                 [-be] [ -nomon <int>] [-tmw <float> ... <float>]"<<std::endl;
@@ -989,6 +545,12 @@ void printUsage(void)
   std::cerr << " -t <string>           : File with the test sentences."<<std::endl;
   std::cerr << " -o <string>           : File to store translations (if not given, they are"<<std::endl;
   std::cerr << "                         printed to the standard output)."<<std::endl;
+  std::cerr << " -nt <int>             : Number of translation threads. Models are loaded only"<<std::endl;
+  std::cerr << "                         once and shared by the threads, translations are"<<std::endl;
+  std::cerr << "                         printed in the order of the test file ("<<PMSTACK_NT_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -et <int>             : Number of threads used to expand the hypotheses of"<<std::endl;
+  std::cerr << "                         each sentence. Results do not depend on this value"<<std::endl;
+  std::cerr << "                         ("<<PMSTACK_ET_DEFAULT<<" by default)."<<std::endl;
   std::cerr << " -W <float>            : Maximum number of translation options to be considered"<<std::endl;
   std::cerr << "                         per each source phrase ("<<PMSTACK_W_DEFAULT<<" by default)."<<std::endl;
   std::cerr << " -S <int>              : Maximum number of hypotheses that can be stored in"<<std::endl;
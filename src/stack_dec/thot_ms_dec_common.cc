@@ -0,0 +1,787 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_ms_dec_common.cc
+ *
+ * @brief Definitions file for thot_ms_dec_common.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "thot_ms_dec_common.h"
+#include "CustomFeatureHandler.h"
+#include "StdFeatureHandler.h"
+#include "_pbTransModel.h"
+#include "_phrSwTransModel.h"
+#include "_phraseBasedTransModel.h"
+#include "SwModelInfo.h"
+#include "PhraseModelInfo.h"
+#include "LangModelInfo.h"
+#include "ModelDescriptorUtils.h"
+#include "options.h"
+#include "ErrorDefs.h"
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+
+//--------------- Function Declarations ------------------------------
+
+bool featureBasedImplIsEnabled(void);
+int init_translator_legacy_impl(const thot_ms_dec_common_pars& pars);
+void set_default_models(void);
+int load_model_features(const thot_ms_dec_common_pars& pars);
+int init_translator_feat_impl(const thot_ms_dec_common_pars& pars);
+void release_translator_legacy_impl(void);
+void release_translator_feat_impl(void);
+int takeParametersFromCfgFile(std::string cfgFileName,
+                              thot_ms_dec_common_pars& pars);
+
+//--------------- Global variables -----------------------------------
+
+DynClassFactoryHandler dynClassFactoryHandler;
+LangModelInfo* langModelInfoPtr;
+PhraseModelInfo* phrModelInfoPtr;
+SwModelInfo* swModelInfoPtr;
+BaseTranslationMetadata<SmtModel::HypScoreInfo> * trMetadataPtr;
+BaseLogLinWeightUpdater* llWeightUpdaterPtr;
+BasePbTransModel<SmtModel::Hypothesis>* smtModelPtr;
+BaseStackDecoder<SmtModel>* stackDecoderPtr;
+_stackDecoderRec<SmtModel>* stackDecoderRecPtr;
+
+    // Variables related to feature-based implementation
+StdFeatureHandler stdFeatureHandler;
+CustomFeatureHandler customFeatureHandler;
+bool featureBasedImplEnabled;
+
+//--------------- Function Definitions -------------------------------
+
+//---------------
+thot_ms_dec_common_pars::thot_ms_dec_common_pars()
+{
+  W=PMSTACK_W_DEFAULT;
+  S=PMSTACK_S_DEFAULT;
+  A=PMSTACK_A_DEFAULT;
+  nomon=PMSTACK_NOMON_DEFAULT;
+  I=PMSTACK_I_DEFAULT;
+  G=PMSTACK_G_DEFAULT;
+  heuristic=PMSTACK_H_DEFAULT;
+  be=0;
+  numThreads=PMSTACK_NT_DEFAULT;
+  numExpansionThreads=PMSTACK_ET_DEFAULT;
+  verbosity=0;
+  bestScorePruning=false;
+  wordGraph=false;
+}
+
+//---------------
+int init_translator(const thot_ms_dec_common_pars& pars)
+{
+      // Print library directory path for so files
+  std::cerr<<StrProcUtils::getLibDirVarNameValue()<<" = "<<StrProcUtils::getLibDir()<<std::endl;
+
+      // Determine which implementation is being used
+  featureBasedImplEnabled=featureBasedImplIsEnabled();
+
+      // Call the appropriate initialization for current implementation
+  if(featureBasedImplEnabled)
+    return init_translator_feat_impl(pars);
+  else
+    return init_translator_legacy_impl(pars);
+}
+
+//--------------------------
+bool featureBasedImplIsEnabled(void)
+{
+  BasePbTransModel<SmtModel::Hypothesis>* tmpSmtModelPtr=new SmtModel();
+  _pbTransModel<SmtModel::Hypothesis>* pbtm_ptr=dynamic_cast<_pbTransModel<SmtModel::Hypothesis>* >(tmpSmtModelPtr);
+  if(pbtm_ptr)
+  {
+    delete tmpSmtModelPtr;
+    return true;
+  }
+  else
+  {
+    delete tmpSmtModelPtr;
+    return false;
+  }
+}
+
+//---------------
+int init_translator_legacy_impl(const thot_ms_dec_common_pars& pars)
+{
+  int ret;
+  
+  std::cerr<<"\n- Initializing translator...\n\n";
+
+      // Show static types
+  std::cerr<<"Static types:"<<std::endl;
+  std::cerr<<"- SMT model type (SmtModel): "<<SMT_MODEL_TYPE_NAME<<" ("<<THOT_SMTMODEL_H<<")"<<std::endl;
+  std::cerr<<"- Language model state (LM_Hist): "<<LM_STATE_TYPE_NAME<<" ("<<THOT_LM_STATE_H<<")"<<std::endl;
+  std::cerr<<"- Partial probability information for single word models (PpInfo): "<<PPINFO_TYPE_NAME<<" ("<<THOT_PPINFO_H<<")"<<std::endl;
+
+      // Obtain info about translation model entries
+  unsigned int numTransModelEntries;
+  std::vector<ModelDescriptorEntry> modelDescEntryVec;
+  if(extractModelEntryInfo(pars.transModelPref.c_str(),modelDescEntryVec)==THOT_OK)
+    numTransModelEntries=modelDescEntryVec.size();
+  else
+    numTransModelEntries=1;
+
+      // Initialize class factories
+  ret=dynClassFactoryHandler.init_smt(THOT_MASTER_INI_PATH);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+      // Create decoder variables
+  langModelInfoPtr=new LangModelInfo;
+  langModelInfoPtr->wpModelPtr=dynClassFactoryHandler.baseWordPenaltyModelDynClassLoader.make_obj(dynClassFactoryHandler.baseWordPenaltyModelInitPars);
+  if(langModelInfoPtr->wpModelPtr==NULL)
+  {
+    std::cerr<<"Error: BaseWordPenaltyModel pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  langModelInfoPtr->lModelPtr=dynClassFactoryHandler.baseNgramLMDynClassLoader.make_obj(dynClassFactoryHandler.baseNgramLMInitPars);
+  if(langModelInfoPtr->lModelPtr==NULL)
+  {
+    std::cerr<<"Error: BaseNgramLM pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  phrModelInfoPtr=new PhraseModelInfo;
+  phrModelInfoPtr->invPbModelPtr=dynClassFactoryHandler.basePhraseModelDynClassLoader.make_obj(dynClassFactoryHandler.basePhraseModelInitPars);
+  if(phrModelInfoPtr->invPbModelPtr==NULL)
+  {
+    std::cerr<<"Error: BasePhraseModel pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Add one swm pointer per each translation model entry
+  swModelInfoPtr=new SwModelInfo;
+  for(unsigned int i=0;i<numTransModelEntries;++i)
+  {
+    swModelInfoPtr->swAligModelPtrVec.push_back(dynClassFactoryHandler.baseSwAligModelDynClassLoader.make_obj(dynClassFactoryHandler.baseSwAligModelInitPars));
+    if(swModelInfoPtr->swAligModelPtrVec[i]==NULL)
+    {
+      std::cerr<<"Error: BaseSwAligModel pointer could not be instantiated"<<std::endl;
+      return THOT_ERROR;
+    }
+  }
+
+      // Add one inverse swm pointer per each translation model entry
+  for(unsigned int i=0;i<numTransModelEntries;++i)
+  {
+    swModelInfoPtr->invSwAligModelPtrVec.push_back(dynClassFactoryHandler.baseSwAligModelDynClassLoader.make_obj(dynClassFactoryHandler.baseSwAligModelInitPars));
+    if(swModelInfoPtr->invSwAligModelPtrVec[i]==NULL)
+    {
+      std::cerr<<"Error: BaseSwAligModel pointer could not be instantiated"<<std::endl;
+      return THOT_ERROR;
+    }
+  }
+
+  llWeightUpdaterPtr=dynClassFactoryHandler.baseLogLinWeightUpdaterDynClassLoader.make_obj(dynClassFactoryHandler.baseLogLinWeightUpdaterInitPars);
+  if(llWeightUpdaterPtr==NULL)
+  {
+    std::cerr<<"Error: BaseLogLinWeightUpdater pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  trMetadataPtr=dynClassFactoryHandler.baseTranslationMetadataDynClassLoader.make_obj(dynClassFactoryHandler.baseTranslationMetadataInitPars);
+  if(trMetadataPtr==NULL)
+  {
+    std::cerr<<"Error: BaseTranslationMetadata pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Instantiate smt model
+  smtModelPtr=new SmtModel();
+  
+      // Link translation constraints
+  smtModelPtr->link_trans_metadata(trMetadataPtr);
+
+      // Link language model, phrase model and single word model if
+      // appliable
+  _phraseBasedTransModel<SmtModel::Hypothesis>* phrbtm_ptr=dynamic_cast<_phraseBasedTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
+  if(phrbtm_ptr)
+  {
+    phrbtm_ptr->link_lm_info(langModelInfoPtr);
+    phrbtm_ptr->link_pm_info(phrModelInfoPtr);
+  }
+  _phrSwTransModel<SmtModel::Hypothesis>* base_pbswtm_ptr=dynamic_cast<_phrSwTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
+  if(base_pbswtm_ptr)
+  {
+    base_pbswtm_ptr->link_swm_info(swModelInfoPtr);
+  }
+
+  if(phrbtm_ptr)
+  {
+    ret=phrbtm_ptr->loadLangModel(pars.languageModelFileName.c_str());
+    if(ret==THOT_ERROR)
+    {
+      release_translator();
+      return THOT_ERROR;
+    }
+    
+    ret=phrbtm_ptr->loadAligModel(pars.transModelPref.c_str());
+    if(ret==THOT_ERROR)
+    {
+      release_translator();
+      return THOT_ERROR;
+    }
+  }
+
+      // Set heuristic
+  smtModelPtr->setHeuristic(pars.heuristic);
+
+      // Set weights
+  smtModelPtr->setWeights(pars.weightVec);
+  smtModelPtr->printWeights(std::cerr);
+  std::cerr<<std::endl;
+
+      // Set model parameters
+  smtModelPtr->set_W_par(pars.W);
+  smtModelPtr->set_A_par(pars.A);
+  smtModelPtr->set_U_par(pars.nomon);
+
+      // Set verbosity
+  smtModelPtr->setVerbosity(pars.verbosity);
+    
+      // Create a translator instance
+  stackDecoderPtr=dynClassFactoryHandler.baseStackDecoderDynClassLoader.make_obj(dynClassFactoryHandler.baseStackDecoderInitPars);
+  if(stackDecoderPtr==NULL)
+  {
+    std::cerr<<"Error: BaseStackDecoder pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Determine if the translator incorporates hypotheses recombination
+  stackDecoderRecPtr=dynamic_cast<_stackDecoderRec<SmtModel>*>(stackDecoderPtr);
+
+      // Link translation model
+  ret=stackDecoderPtr->link_smt_model(smtModelPtr);
+  if(ret==THOT_ERROR)
+  {
+    std::cerr<<"Error while linking smt model to decoder, revise master.ini file"<<std::endl;
+    return THOT_ERROR;
+  }
+  
+      // Set translator parameters
+  stackDecoderPtr->set_S_par(pars.S);
+  stackDecoderPtr->set_I_par(pars.I);
+  stackDecoderPtr->set_G_par(pars.G);
+
+      // Enable best score pruning if the decoder is not going to obtain
+      // n-best translations or word-graphs
+  if(pars.bestScorePruning)
+    stackDecoderPtr->useBestScorePruning(true);
+
+      // Set breadthFirst flag
+  stackDecoderPtr->set_breadthFirst(!pars.be);
+
+      // Enable word graph if required
+  if(stackDecoderRecPtr && pars.wordGraph)
+    stackDecoderRecPtr->enableWordGraph();
+
+      // Set translator verbosity
+  stackDecoderPtr->setVerbosity(pars.verbosity);
+
+  return THOT_OK;
+}
+
+//---------------
+void set_default_models(void)
+{
+  stdFeatureHandler.setWordPenSoFile(dynClassFactoryHandler.baseWordPenaltyModelSoFileName);
+  stdFeatureHandler.setDefaultLangSoFile(dynClassFactoryHandler.baseNgramLMSoFileName);
+  stdFeatureHandler.setDefaultTransSoFile(dynClassFactoryHandler.basePhraseModelSoFileName);
+  stdFeatureHandler.setDefaultSingleWordSoFile(dynClassFactoryHandler.baseSwAligModelSoFileName);
+}
+
+//---------------
+int load_model_features(const thot_ms_dec_common_pars& pars)
+{
+      // Load monolingual log-linear model features
+  int ret=stdFeatureHandler.loadMonolingualFeats(pars.languageModelFileName,pars.verbosity);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+      // Load bilingual log-linear model features
+  ret=stdFeatureHandler.loadBilingualFeats(pars.transModelPref,pars.verbosity);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+  return THOT_OK;
+}
+
+//---------------
+int init_translator_feat_impl(const thot_ms_dec_common_pars& pars)
+{
+  int ret;
+  
+  std::cerr<<"\n- Initializing translator...\n\n";
+
+      // Show static types
+  std::cerr<<"Static types:"<<std::endl;
+  std::cerr<<"- SMT model type (SmtModel): "<<SMT_MODEL_TYPE_NAME<<" ("<<THOT_SMTMODEL_H<<")"<<std::endl;
+  std::cerr<<"- Language model state (LM_Hist): "<<LM_STATE_TYPE_NAME<<" ("<<THOT_LM_STATE_H<<")"<<std::endl;
+  std::cerr<<"- Partial probability information for single word models (PpInfo): "<<PPINFO_TYPE_NAME<<" ("<<THOT_PPINFO_H<<")"<<std::endl;
+
+      // Initialize class factories
+  ret=dynClassFactoryHandler.init_smt(THOT_MASTER_INI_PATH);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+      // Create decoder variables
+  llWeightUpdaterPtr=dynClassFactoryHandler.baseLogLinWeightUpdaterDynClassLoader.make_obj(dynClassFactoryHandler.baseLogLinWeightUpdaterInitPars);
+  if(llWeightUpdaterPtr==NULL)
+  {
+    std::cerr<<"Error: BaseLogLinWeightUpdater pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  trMetadataPtr=dynClassFactoryHandler.baseTranslationMetadataDynClassLoader.make_obj(dynClassFactoryHandler.baseTranslationMetadataInitPars);
+  if(trMetadataPtr==NULL)
+  {
+    std::cerr<<"Error: BaseTranslationMetadata pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Instantiate smt model
+  smtModelPtr=new SmtModel();
+  
+      // Link translation constraints
+  smtModelPtr->link_trans_metadata(trMetadataPtr);
+
+      // Link standard features information
+  _pbTransModel<SmtModel::Hypothesis>* pbtm_ptr=dynamic_cast<_pbTransModel<SmtModel::Hypothesis>* >(smtModelPtr);
+  if(pbtm_ptr)
+    pbtm_ptr->link_std_feats_info(stdFeatureHandler.getFeatureInfoPtr());
+
+      // Set default models for standard feature handler
+  set_default_models();
+  
+      // Load model features
+  ret=load_model_features(pars);
+  if(ret==THOT_ERROR)
+    return THOT_ERROR;
+
+      // Load custom features if they were provided
+  if(!pars.customFeatsFile.empty())
+  {
+    ret=customFeatureHandler.loadCustomFeats(pars.customFeatsFile,pars.verbosity);
+    if(ret==THOT_ERROR) return THOT_ERROR;
+  }
+  
+      // Link custom features information
+  if(pbtm_ptr)
+    pbtm_ptr->link_custom_feats_info(customFeatureHandler.getFeatureInfoPtr());
+
+      // Set heuristic
+  smtModelPtr->setHeuristic(pars.heuristic);
+
+      // Set weights
+  smtModelPtr->setWeights(pars.weightVec);
+  smtModelPtr->printWeights(std::cerr);
+  std::cerr<<std::endl;
+
+      // Set model parameters
+  smtModelPtr->set_W_par(pars.W);
+  smtModelPtr->set_A_par(pars.A);
+  smtModelPtr->set_U_par(pars.nomon);
+
+      // Set number of threads used to expand the hypotheses of each
+      // sentence
+  if(pbtm_ptr)
+    pbtm_ptr->setNumExpansionThreads(pars.numExpansionThreads);
+
+      // Set verbosity
+  smtModelPtr->setVerbosity(pars.verbosity);
+    
+      // Create a translator instance
+  stackDecoderPtr=dynClassFactoryHandler.baseStackDecoderDynClassLoader.make_obj(dynClassFactoryHandler.baseStackDecoderInitPars);
+  if(stackDecoderPtr==NULL)
+  {
+    std::cerr<<"Error: BaseStackDecoder pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Determine if the translator incorporates hypotheses recombination
+  stackDecoderRecPtr=dynamic_cast<_stackDecoderRec<SmtModel>*>(stackDecoderPtr);
+
+      // Link translation model
+  ret=stackDecoderPtr->link_smt_model(smtModelPtr);
+  if(ret==THOT_ERROR)
+  {
+    std::cerr<<"Error while linking smt model to decoder, revise master.ini file"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Set translator parameters
+  stackDecoderPtr->set_S_par(pars.S);
+  stackDecoderPtr->set_I_par(pars.I);
+  stackDecoderPtr->set_G_par(pars.G);
+
+      // Enable best score pruning if the decoder is not going to obtain
+      // n-best translations or word-graphs
+  if(pars.bestScorePruning)
+    stackDecoderPtr->useBestScorePruning(true);
+
+      // Set breadthFirst flag
+  stackDecoderPtr->set_breadthFirst(!pars.be);
+
+      // Enable word graph if required
+  if(stackDecoderRecPtr && pars.wordGraph)
+    stackDecoderRecPtr->enableWordGraph();
+
+      // Set translator verbosity
+  stackDecoderPtr->setVerbosity(pars.verbosity);
+  
+  return THOT_OK;
+}
+
+//---------------
+void release_translator(void)
+{
+  if(featureBasedImplEnabled)
+    release_translator_feat_impl();
+  else
+    release_translator_legacy_impl();
+}
+
+//---------------
+void release_translator_legacy_impl(void)
+{
+  delete langModelInfoPtr->lModelPtr;
+  delete langModelInfoPtr->wpModelPtr;
+  delete langModelInfoPtr;
+  delete phrModelInfoPtr->invPbModelPtr;
+  delete phrModelInfoPtr;
+  for(unsigned int i=0;i<swModelInfoPtr->swAligModelPtrVec.size();++i)
+    delete swModelInfoPtr->swAligModelPtrVec[i];
+  for(unsigned int i=0;i<swModelInfoPtr->invSwAligModelPtrVec.size();++i)
+    delete swModelInfoPtr->invSwAligModelPtrVec[i];
+  delete swModelInfoPtr;
+  delete stackDecoderPtr;
+  delete llWeightUpdaterPtr;
+  delete trMetadataPtr;
+  delete smtModelPtr;
+
+      // Release class factory handler
+  dynClassFactoryHandler.release_smt();
+}
+
+//---------------
+void release_translator_feat_impl(void)
+{
+  delete stackDecoderPtr;
+  delete llWeightUpdaterPtr;
+  delete trMetadataPtr;
+  delete smtModelPtr;
+
+      // Delete features information
+  stdFeatureHandler.clear();
+  customFeatureHandler.clear();
+  
+      // Release class factory handler
+  dynClassFactoryHandler.release_smt();
+}
+
+//---------------
+int create_worker_decoder(const thot_ms_dec_common_pars& pars,
+                          DecoderWorkerData& dwd)
+{
+      // Create statistical machine translation model instance (it is
+      // cloned from the main one, so models are shared)
+  BaseSmtModel<SmtModel::Hypothesis>* baseSmtModelPtr=smtModelPtr->clone();
+  dwd.smtModelPtr=dynamic_cast<BasePbTransModel<SmtModel::Hypothesis>* >(baseSmtModelPtr);
+  if(dwd.smtModelPtr==NULL)
+  {
+    std::cerr<<"Error: SMT model could not be cloned"<<std::endl;
+    delete baseSmtModelPtr;
+    return THOT_ERROR;
+  }
+
+      // Create translation metadata object
+  dwd.trMetadataPtr=dynClassFactoryHandler.baseTranslationMetadataDynClassLoader.make_obj(dynClassFactoryHandler.baseTranslationMetadataInitPars);
+  if(dwd.trMetadataPtr==NULL)
+  {
+    std::cerr<<"Error: BaseTranslationMetadata pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Link translation metadata
+  dwd.smtModelPtr->link_trans_metadata(dwd.trMetadataPtr);
+
+      // Create a translator instance
+  dwd.stackDecoderPtr=dynClassFactoryHandler.baseStackDecoderDynClassLoader.make_obj(dynClassFactoryHandler.baseStackDecoderInitPars);
+  if(dwd.stackDecoderPtr==NULL)
+  {
+    std::cerr<<"Error: BaseStackDecoder pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Determine if the translator incorporates hypotheses recombination
+  dwd.stackDecoderRecPtr=dynamic_cast<_stackDecoderRec<SmtModel>*>(dwd.stackDecoderPtr);
+
+      // Link translation model
+  int ret=dwd.stackDecoderPtr->link_smt_model(dwd.smtModelPtr);
+  if(ret==THOT_ERROR)
+  {
+    std::cerr<<"Error while linking smt model to decoder, revise master.ini file"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Set translator parameters (they are the same used for the main
+      // translator instance)
+  dwd.stackDecoderPtr->set_S_par(pars.S);
+  dwd.stackDecoderPtr->set_I_par(pars.I);
+  dwd.stackDecoderPtr->set_G_par(pars.G);
+  if(pars.bestScorePruning)
+    dwd.stackDecoderPtr->useBestScorePruning(true);
+  dwd.stackDecoderPtr->set_breadthFirst(!pars.be);
+  if(dwd.stackDecoderRecPtr && pars.wordGraph)
+    dwd.stackDecoderRecPtr->enableWordGraph();
+  dwd.stackDecoderPtr->setVerbosity(pars.verbosity);
+  
+  return THOT_OK;
+}
+
+//---------------
+void release_worker_decoder(DecoderWorkerData& dwd)
+{
+  delete dwd.stackDecoderPtr;
+  delete dwd.smtModelPtr;
+  delete dwd.trMetadataPtr;
+  dwd=DecoderWorkerData();
+}
+
+//---------------
+void get_main_decoder(DecoderWorkerData& dwd)
+{
+      // The main decoder instance uses the models created by
+      // init_translator(), it is released by release_translator()
+  dwd.smtModelPtr=smtModelPtr;
+  dwd.trMetadataPtr=trMetadataPtr;
+  dwd.stackDecoderPtr=stackDecoderPtr;
+  dwd.stackDecoderRecPtr=stackDecoderRecPtr;
+}
+
+//---------------
+int takeParameters(int argc,
+                   char *argv[],
+                   thot_ms_dec_common_pars& pars)
+{
+      // Check if a configuration file was provided
+  std::string cfgFileName;
+  int err=readSTLstring(argc,argv, "-c", &cfgFileName);
+  if(!err)
+  {
+        // Process configuration file
+    err=takeParametersFromCfgFile(cfgFileName,pars);
+    if(err==THOT_ERROR) return THOT_ERROR;
+  }
+      // process command line parameters
+  pars.takeParametersGivenArgcArgv(argc,argv);
+  return THOT_OK;
+}
+
+//---------------
+int takeParametersFromCfgFile(std::string cfgFileName,
+                              thot_ms_dec_common_pars& pars)
+{
+  std::cerr<<"Processing configuration file ("<<cfgFileName<<")"<<std::endl;
+  
+      // Extract parameters from configuration file
+  std::string comment="#";
+  int cfgFileArgc;
+  std::vector<std::string> cfgFileArgvStl;
+  int ret=extractParsFromFile(cfgFileName.c_str(),cfgFileArgc,cfgFileArgvStl,comment);
+  if(ret==THOT_ERROR) return THOT_ERROR;
+
+      // Create argv for cfg file
+  char** cfgFileArgv=(char**) malloc(cfgFileArgc*sizeof(char*));
+  for(unsigned int i=0;i<cfgFileArgvStl.size();++i)
+  {
+    cfgFileArgv[i]=(char*) malloc((cfgFileArgvStl[i].size()+1)*sizeof(char));
+    strcpy(cfgFileArgv[i],cfgFileArgvStl[i].c_str());
+  }
+      // Process extracted parameters
+  pars.takeParametersGivenArgcArgv(cfgFileArgc,cfgFileArgv);
+
+      // Release allocated memory
+  for(unsigned int i=0;i<cfgFileArgvStl.size();++i)
+  {
+    free(cfgFileArgv[i]);
+  }
+  free(cfgFileArgv);
+
+      // Return without error
+  return THOT_OK;
+}
+
+//---------------
+void thot_ms_dec_common_pars::takeParametersGivenArgcArgv(int argc,
+                                                         char *argv[])
+{
+     // Takes W 
+ int err=readFloat(argc,argv, "-W", &W);
+
+     // Takes S parameter 
+ err=readInt(argc,argv, "-S", &S);
+
+     // Takes A parameter 
+ err=readInt(argc,argv, "-A", &A);
+
+     // Takes U parameter 
+ err=readInt(argc,argv, "-nomon", &nomon);
+
+     // Takes I parameter 
+ err=readInt(argc,argv, "-I", &I);
+
+     // Takes I parameter 
+ err=readInt(argc,argv, "-G", &G);
+
+     // Takes h parameter 
+ err=readInt(argc,argv, "-h", &heuristic);
+
+     // Take language model file name
+ err=readSTLstring(argc,argv, "-lm", &languageModelFileName);
+
+     // Take read table prefix 
+ err=readSTLstring(argc,argv, "-tm", &transModelPref);
+
+     // Take custom features file 
+ err=readSTLstring(argc,argv, "-cf", &customFeatsFile);
+
+     // Take file name with the source sentences
+ err=readSTLstring(argc,argv, "-t",&sourceSentencesFile);
+
+      // Take output file name
+ err=readSTLstring(argc,argv, "-o",&outFile);
+
+     // Take number of translation threads
+ err=readInt(argc,argv, "-nt", &numThreads);
+
+     // Take number of expansion threads
+ err=readInt(argc,argv, "-et", &numExpansionThreads);
+ 
+       // read -be option
+ err=readOption(argc,argv,"-be");
+ if(err!=-1)
+ {
+   be=1;
+ }      
+     
+     // Take -tmw parameter
+ err=readFloatSeq(argc,argv, "-tmw", weightVec);
+
+     // Take verbosity parameter
+ err=readOption(argc,argv,"-v");
+ if(err==-1)
+ {
+       // -v not found
+   err=readOption(argc,argv,"-v1");
+   if(err==-1)
+   {
+         // -v1 not found
+     err=readOption(argc,argv,"-v2");
+     if(err==-1)
+     {
+           // -v2 not found
+       verbosity=0;
+     }
+     else
+     {
+           // -v2 found
+       verbosity=3;
+     }
+   }
+   else
+   {
+         // -v1 found
+     verbosity=2;
+   }
+ }
+ else
+ {
+       // -v found
+   verbosity=1;
+ }
+}
+
+
+//---------------
+int checkCommonParameters(const thot_ms_dec_common_pars& pars)
+{
+  if(pars.languageModelFileName.empty())
+  {
+    std::cerr<<"Error: parameter -lm not given!"<<std::endl;
+    return THOT_ERROR;   
+  }
+  
+  if(pars.transModelPref.empty())
+  {
+    std::cerr<<"Error: parameter -tm not given!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(pars.sourceSentencesFile.empty())
+  {
+    std::cerr<<"Error: parameter -t not given!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(pars.numThreads<1)
+  {
+    std::cerr<<"Error: value of -nt parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(pars.numExpansionThreads<1)
+  {
+    std::cerr<<"Error: value of -et parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;   
+  }
+  
+  return THOT_OK;
+}
+
+//---------------
+void printCommonParameters(const thot_ms_dec_common_pars& pars)
+{
+ std::cerr<<"W: "<<pars.W<<std::endl;   
+ std::cerr<<"S: "<<pars.S<<std::endl;   
+ std::cerr<<"A: "<<pars.A<<std::endl;
+ std::cerr<<"I: "<<pars.I<<std::endl;
+#ifdef MULTI_STACK_USE_GRAN
+ std::cerr<<"G: "<<pars.G<<std::endl;
+#endif
+ std::cerr<<"h: "<<pars.heuristic<<std::endl;
+ std::cerr<<"be: "<<pars.be<<std::endl;
+ std::cerr<<"nomon: "<<pars.nomon<<std::endl;
+ std::cerr<<"weight vector:";
+ for(unsigned int i=0;i<pars.weightVec.size();++i)
+   std::cerr<<" "<<pars.weightVec[i];
+ std::cerr<<std::endl;
+ std::cerr<<"lmfile: "<<pars.languageModelFileName<<std::endl;   
+ std::cerr<<"tm files prefix: "<<pars.transModelPref<<std::endl;
+ std::cerr<<"test file: "<<pars.sourceSentencesFile<<std::endl;
+ std::cerr<<"number of threads: "<<pars.numThreads<<std::endl;
+ std::cerr<<"number of expansion threads: "<<pars.numExpansionThreads<<std::endl;
+}
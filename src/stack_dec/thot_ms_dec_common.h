@@ -0,0 +1,141 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_ms_dec_common.h
+ *
+ * @brief Parameters, model loading and decoder creation shared by the
+ * tools based on the multiple-stack decoder (thot_ms_dec and
+ * thot_ms_tune).
+ */
+
+#ifndef _thot_ms_dec_common_h
+#define _thot_ms_dec_common_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "_stackDecoderRec.h"
+#include "BaseStackDecoder.h"
+#include THOT_SMTMODEL_H // Define SmtModel type. It is set in
+                         // configure by checking SMTMODEL_H
+                         // variable (default value: SmtModel.h)
+#include "BasePbTransModel.h"
+#include "BaseTranslationMetadata.h"
+#include "BaseLogLinWeightUpdater.h"
+#include "DynClassFactoryHandler.h"
+#include <string>
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define PMSTACK_W_DEFAULT 10
+
+#ifdef MULTI_STACK_USE_GRAN
+ #define PMSTACK_S_DEFAULT 128
+#else
+ #define PMSTACK_S_DEFAULT 10
+#endif
+
+#define PMSTACK_A_DEFAULT 10
+#define PMSTACK_I_DEFAULT 1
+#define PMSTACK_G_DEFAULT 0
+#define PMSTACK_H_DEFAULT LOCAL_TD_HEURISTIC
+#define PMSTACK_NOMON_DEFAULT 0
+#define PMSTACK_NT_DEFAULT 1
+#define PMSTACK_ET_DEFAULT 1
+
+//--------------- Type definitions -----------------------------------
+
+    // Parameters shared by the multiple-stack decoder tools. Tools
+    // taking additional parameters derive from this class and redefine
+    // takeParametersGivenArgcArgv()
+struct thot_ms_dec_common_pars
+{
+  bool be;
+  float W;
+  int A,nomon,S,I,G,heuristic,verbosity;
+  int numThreads;
+  int numExpansionThreads;
+  std::string sourceSentencesFile;
+  std::string languageModelFileName;
+  std::string transModelPref;
+  std::string customFeatsFile;
+  std::string outFile;
+  std::vector<float> weightVec;
+
+      // Decoder options determined by each tool
+  bool bestScorePruning;
+  bool wordGraph;
+
+  thot_ms_dec_common_pars();
+  virtual ~thot_ms_dec_common_pars(){}
+
+  virtual void takeParametersGivenArgcArgv(int argc,
+                                           char *argv[]);
+};
+
+    // Decoder instance owned by a translation thread. Models are shared
+    // by all the instances, while hypothesis-related data is private
+struct DecoderWorkerData
+{
+  BasePbTransModel<SmtModel::Hypothesis>* smtModelPtr;
+  BaseTranslationMetadata<SmtModel::HypScoreInfo>* trMetadataPtr;
+  BaseStackDecoder<SmtModel>* stackDecoderPtr;
+  _stackDecoderRec<SmtModel>* stackDecoderRecPtr;
+
+  DecoderWorkerData()
+    {
+      smtModelPtr=NULL;
+      trMetadataPtr=NULL;
+      stackDecoderPtr=NULL;
+      stackDecoderRecPtr=NULL;
+    }
+};
+
+//--------------- Global variables -----------------------------------
+
+extern DynClassFactoryHandler dynClassFactoryHandler;
+extern BaseTranslationMetadata<SmtModel::HypScoreInfo>* trMetadataPtr;
+extern BaseLogLinWeightUpdater* llWeightUpdaterPtr;
+extern BasePbTransModel<SmtModel::Hypothesis>* smtModelPtr;
+extern BaseStackDecoder<SmtModel>* stackDecoderPtr;
+extern _stackDecoderRec<SmtModel>* stackDecoderRecPtr;
+
+//--------------- Function Declarations ------------------------------
+
+    // Model loading and decoder creation
+int init_translator(const thot_ms_dec_common_pars& pars);
+void release_translator(void);
+int create_worker_decoder(const thot_ms_dec_common_pars& pars,
+                          DecoderWorkerData& dwd);
+void release_worker_decoder(DecoderWorkerData& dwd);
+void get_main_decoder(DecoderWorkerData& dwd);
+
+    // Process the configuration file given with -c (if any) and then
+    // the command line parameters
+int takeParameters(int argc,
+                   char *argv[],
+                   thot_ms_dec_common_pars& pars);
+int checkCommonParameters(const thot_ms_dec_common_pars& pars);
+void printCommonParameters(const thot_ms_dec_common_pars& pars);
+
+#endif
@@ -0,0 +1,758 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_ms_tune.cc
+ * 
+ * @brief Tunes the log-linear weights of a multiple-stack decoder
+ * without reloading the models. At each iteration, the development
+ * corpus is translated, the n-best lists obtained from the word graphs
+ * are merged with those of previous iterations and new weights are
+ * obtained from the accumulated n-best lists.
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "thot_ms_dec_common.h"
+#include "BaseScorer.h"
+#include "WordGraph.h"
+#include "StdCerrThreadSafePrint.h"
+#include "ctimer.h"
+#include "options.h"
+#include "ErrorDefs.h"
+#include <pthread.h>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <set>
+
+//--------------- Constants ------------------------------------------
+
+#define TUNE_NBEST_DEFAULT 100
+#define TUNE_ITERS_DEFAULT 10
+
+//--------------- Type definitions -----------------------------------
+
+struct thot_ms_tune_pars: public thot_ms_dec_common_pars
+{
+  int nbListLen;
+  int maxIters;
+  std::string refSentencesFile;
+
+  thot_ms_tune_pars()
+    {
+      nbListLen=TUNE_NBEST_DEFAULT;
+      maxIters=TUNE_ITERS_DEFAULT;
+    }
+
+  void takeParametersGivenArgcArgv(int argc,
+                                   char *argv[]);
+};
+
+    // Set of entries (translation and score components) of an n-best
+    // list, used to detect repeated entries when merging n-best lists
+typedef std::set<std::pair<std::string,std::vector<double> > > NbestEntrySet;
+
+    // Data of the development corpus shared by the translation
+    // threads. N-best lists are accumulated across tuning iterations,
+    // each sentence is only modified by the thread translating it
+struct DevCorpusTuningData
+{
+  const thot_ms_tune_pars* tdpPtr;
+  std::vector<std::string> srcSentVec;
+  std::vector<std::string> refSentVec;
+  std::vector<std::string> transVec;
+  std::vector<std::vector<std::string> > nbTransVecs;
+  std::vector<std::vector<std::vector<double> > > nbScoreCompsVecs;
+  std::vector<NbestEntrySet> nbEntrySets;
+  unsigned int nextSentIdx;
+  unsigned int numNewEntries;
+  double total_time;
+  pthread_mutex_t mut;
+};
+
+    // Arguments given to each translation thread
+struct TuningThreadArgs
+{
+  DecoderWorkerData* dwdPtr;
+  DevCorpusTuningData* dctdPtr;
+};
+
+
+//--------------- Function Declarations ------------------------------
+
+int init_scorer(void);
+void release_scorer(void);
+int check_word_graph_support(const DecoderWorkerData& dwd);
+int read_dev_corpus(const thot_ms_tune_pars& tdp,
+                    DevCorpusTuningData& dctd);
+unsigned int translate_dev_sentence(const DecoderWorkerData& dwd,
+                                    DevCorpusTuningData& dctd,
+                                    unsigned int sentIdx,
+                                    double& elapsedTime);
+void* tuning_thread(void* args);
+int translate_dev_corpus(std::vector<DecoderWorkerData>& dwdVec,
+                         DevCorpusTuningData& dctd);
+void set_weights(std::vector<DecoderWorkerData>& dwdVec,
+                 const std::vector<float>& weightVec);
+void obtain_new_weights(const DevCorpusTuningData& dctd,
+                        const std::vector<float>& currWeightVec,
+                        std::vector<float>& newWeightVec);
+int print_weights(const thot_ms_tune_pars& tdp,
+                  const std::vector<float>& weightVec);
+int tune_weights(const thot_ms_tune_pars& tdp);
+void version(void);
+int handleParameters(int argc,
+                     char *argv[],
+                     thot_ms_tune_pars& pars);
+int checkParameters(const thot_ms_tune_pars& tdp);
+void printParameters(const thot_ms_tune_pars& tdp);
+void printUsage(void);
+
+//--------------- Global variables -----------------------------------
+
+BaseScorer* scorerPtr;
+
+//--------------- Function Definitions -------------------------------
+
+//--------------- main function
+int main(int argc, char *argv[])
+{
+      // Take and check parameters
+  thot_ms_tune_pars tdp;
+  if(handleParameters(argc,argv,tdp)==THOT_ERROR)
+  {
+    return THOT_ERROR;
+  }
+  else
+  {
+        // N-best lists are obtained from word graphs, so best score
+        // pruning cannot be used
+    tdp.bestScorePruning=false;
+    tdp.wordGraph=true;
+    
+        // init translator (models are loaded only once)
+    if(init_translator(tdp)==THOT_ERROR)
+    {      
+      std::cerr<<"Error during the initialization of the translator"<<std::endl;
+      return THOT_ERROR;
+    }
+    else
+    {
+      int ret=init_scorer();
+      if(ret==THOT_OK)
+        ret=tune_weights(tdp);
+          // The scorer is released before the translator, since the
+          // latter unloads the shared libraries implementing them
+      release_scorer();
+      release_translator();
+      if(ret==THOT_ERROR) return THOT_ERROR;
+      else return THOT_OK;
+    }
+  }
+}
+
+//---------------
+int init_scorer(void)
+{
+      // Create scorer
+  scorerPtr=dynClassFactoryHandler.baseScorerDynClassLoader.make_obj(dynClassFactoryHandler.baseScorerInitPars);
+  if(scorerPtr==NULL)
+  {
+    std::cerr<<"Error: BaseScorer pointer could not be instantiated"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Link scorer to weight updater
+  if(!llWeightUpdaterPtr->link_scorer(scorerPtr))
+  {
+    std::cerr<<"Error: Scorer class could not be linked to log-linear weight updater"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  return THOT_OK;
+}
+
+//---------------
+void release_scorer(void)
+{
+  delete scorerPtr;
+  scorerPtr=NULL;
+}
+
+//---------------
+int check_word_graph_support(const DecoderWorkerData& dwd)
+{
+      // N-best lists are obtained from the word graphs generated by
+      // the decoder
+  if(dwd.stackDecoderRecPtr==NULL)
+  {
+    std::cerr<<"Error: the decoder does not generate word graphs, revise master.ini file"<<std::endl;
+    return THOT_ERROR;
+  }
+  else
+    return THOT_OK;
+}
+
+//---------------
+int read_dev_corpus(const thot_ms_tune_pars& tdp,
+                    DevCorpusTuningData& dctd)
+{
+  std::string sentenceString;
+
+      // Read source sentences
+  std::ifstream srcFile;
+  srcFile.open(tdp.sourceSentencesFile.c_str());
+  if(!srcFile)
+  {
+    std::cerr<<"Error while opening file with source sentences: "<<tdp.sourceSentencesFile<<std::endl;
+    return THOT_ERROR;
+  }
+  while(!srcFile.eof())
+  {
+    getline(srcFile,sentenceString);
+        // Discard last sentence if it is empty
+    if(sentenceString=="" && srcFile.eof())
+      break;
+    dctd.srcSentVec.push_back(sentenceString);
+  }
+  srcFile.close();
+
+      // Read references
+  std::ifstream refFile;
+  refFile.open(tdp.refSentencesFile.c_str());
+  if(!refFile)
+  {
+    std::cerr<<"Error while opening file with references: "<<tdp.refSentencesFile<<std::endl;
+    return THOT_ERROR;
+  }
+  while(!refFile.eof())
+  {
+    getline(refFile,sentenceString);
+        // Discard last sentence if it is empty
+    if(sentenceString=="" && refFile.eof())
+      break;
+    dctd.refSentVec.push_back(sentenceString);
+  }
+  refFile.close();
+
+  if(dctd.srcSentVec.size()!=dctd.refSentVec.size())
+  {
+    std::cerr<<"Error: source and reference files do not have the same number of sentences"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(dctd.srcSentVec.empty())
+  {
+    std::cerr<<"Error: development corpus is empty"<<std::endl;
+    return THOT_ERROR;
+  }
+  
+  return THOT_OK;
+}
+
+//---------------
+unsigned int translate_dev_sentence(const DecoderWorkerData& dwd,
+                                    DevCorpusTuningData& dctd,
+                                    unsigned int sentIdx,
+                                    double& elapsedTime)
+{
+  double elapsed_ant,elapsed,ucpu,scpu;
+  const thot_ms_tune_pars& tdp=*dctd.tdpPtr;
+
+  ctimer(&elapsed_ant,&ucpu,&scpu);
+  
+      // Translate sentence
+  SmtModel::Hypothesis result=dwd.stackDecoderPtr->translate(dctd.srcSentVec[sentIdx]);
+  dctd.transVec[sentIdx]=dwd.smtModelPtr->getTransInPlainText(result);
+
+      // Obtain n-best list from word graph
+  std::vector<std::pair<Score,std::string> > nblist;
+  std::vector<NbSearchHighLevelHyp> highLevelHypList;
+  std::vector<std::vector<Score> > scoreCompsVec;
+  WordGraph* wgPtr=dwd.stackDecoderRecPtr->getWordGraphPtr();
+  wgPtr->obtainNbestList(tdp.nbListLen,nblist,highLevelHypList,scoreCompsVec);
+
+      // Merge n-best list with the one accumulated in previous
+      // iterations
+  unsigned int numNewEntries=0;
+  for(unsigned int i=0;i<nblist.size();++i)
+  {
+    std::pair<std::string,std::vector<double> > entry(nblist[i].second,scoreCompsVec[i]);
+    if(dctd.nbEntrySets[sentIdx].insert(entry).second)
+    {
+      dctd.nbTransVecs[sentIdx].push_back(nblist[i].second);
+      dctd.nbScoreCompsVecs[sentIdx].push_back(scoreCompsVec[i]);
+      ++numNewEntries;
+    }
+  }
+  
+  ctimer(&elapsed,&ucpu,&scpu);
+  elapsedTime=elapsed-elapsed_ant;
+
+  if(tdp.verbosity>1)
+  {
+    StdCerrThreadSafe<<"Sentence "<<sentIdx+1<<": "<<dctd.transVec[sentIdx]<<" ; new n-best entries: "<<numNewEntries<<" ; time: "<<elapsedTime<<std::endl;
+  }
+  
+  return numNewEntries;
+}
+
+//---------------
+void* tuning_thread(void* args)
+{
+  TuningThreadArgs* ttaPtr=(TuningThreadArgs*) args;
+  DevCorpusTuningData* dctdPtr=ttaPtr->dctdPtr;
+
+  while(true)
+  {
+        // Obtain index of next sentence to be translated
+    pthread_mutex_lock(&dctdPtr->mut);
+    unsigned int sentIdx=dctdPtr->nextSentIdx;
+    if(sentIdx<dctdPtr->srcSentVec.size())
+      ++dctdPtr->nextSentIdx;
+    pthread_mutex_unlock(&dctdPtr->mut);
+
+    if(sentIdx>=dctdPtr->srcSentVec.size())
+      break;
+
+        // Translate sentence and update its n-best list
+    double elapsedTime;
+    unsigned int numNewEntries=translate_dev_sentence(*ttaPtr->dwdPtr,*dctdPtr,sentIdx,elapsedTime);
+
+        // Update counters
+    pthread_mutex_lock(&dctdPtr->mut);
+    dctdPtr->numNewEntries+=numNewEntries;
+    dctdPtr->total_time+=elapsedTime;
+    pthread_mutex_unlock(&dctdPtr->mut);
+  }
+  
+  return NULL;
+}
+
+//---------------
+int translate_dev_corpus(std::vector<DecoderWorkerData>& dwdVec,
+                         DevCorpusTuningData& dctd)
+{
+  dctd.nextSentIdx=0;
+  dctd.numNewEntries=0;
+  dctd.total_time=0;
+
+  std::vector<TuningThreadArgs> ttaVec(dwdVec.size());
+  for(unsigned int i=0;i<dwdVec.size();++i)
+  {
+    ttaVec[i].dwdPtr=&dwdVec[i];
+    ttaVec[i].dctdPtr=&dctd;
+  }
+
+      // The corpus is translated by the calling thread if only one
+      // decoder instance is available
+  if(dwdVec.size()==1)
+  {
+    tuning_thread((void*) &ttaVec[0]);
+    return THOT_OK;
+  }
+  
+      // Launch translation threads
+  std::vector<pthread_t> tidVec(dwdVec.size());
+  unsigned int numLaunched=0;
+  for(unsigned int i=0;i<dwdVec.size();++i)
+  {
+    if(pthread_create(&tidVec[i],NULL,tuning_thread,(void*) &ttaVec[i])!=0)
+    {
+      std::cerr<<"Error while creating translation thread"<<std::endl;
+      break;
+    }
+    ++numLaunched;
+  }
+
+      // Wait for translation threads
+  for(unsigned int i=0;i<numLaunched;++i)
+    pthread_join(tidVec[i],NULL);
+
+  if(numLaunched==0)
+    return THOT_ERROR;
+  else
+    return THOT_OK;
+}
+
+//---------------
+void set_weights(std::vector<DecoderWorkerData>& dwdVec,
+                 const std::vector<float>& weightVec)
+{
+      // Weights are stored by each model instance
+  for(unsigned int i=0;i<dwdVec.size();++i)
+    dwdVec[i].smtModelPtr->setWeights(weightVec);
+}
+
+//---------------
+void obtain_new_weights(const DevCorpusTuningData& dctd,
+                        const std::vector<float>& currWeightVec,
+                        std::vector<float>& newWeightVec)
+{
+  std::vector<double> currWeightsDouble(currWeightVec.begin(),currWeightVec.end());
+  std::vector<double> newWeightsDouble;
+
+      // Check if there are sentences with empty n-best lists
+  bool emptyNbestLists=false;
+  for(unsigned int i=0;i<dctd.nbTransVecs.size();++i)
+  {
+    if(dctd.nbTransVecs[i].empty())
+      emptyNbestLists=true;
+  }
+
+  if(!emptyNbestLists)
+  {
+    llWeightUpdaterPtr->updateClosedCorpus(dctd.refSentVec,
+                                           dctd.nbTransVecs,
+                                           dctd.nbScoreCompsVecs,
+                                           currWeightsDouble,
+                                           newWeightsDouble);
+  }
+  else
+  {
+        // Sentences with empty n-best lists are not given to the
+        // weight updater
+    std::vector<std::string> refSentVec;
+    std::vector<std::vector<std::string> > nbTransVecs;
+    std::vector<std::vector<std::vector<double> > > nbScoreCompsVecs;
+    for(unsigned int i=0;i<dctd.nbTransVecs.size();++i)
+    {
+      if(!dctd.nbTransVecs[i].empty())
+      {
+        refSentVec.push_back(dctd.refSentVec[i]);
+        nbTransVecs.push_back(dctd.nbTransVecs[i]);
+        nbScoreCompsVecs.push_back(dctd.nbScoreCompsVecs[i]);
+      }
+    }
+    llWeightUpdaterPtr->updateClosedCorpus(refSentVec,
+                                           nbTransVecs,
+                                           nbScoreCompsVecs,
+                                           currWeightsDouble,
+                                           newWeightsDouble);
+  }
+  
+  newWeightVec.assign(newWeightsDouble.begin(),newWeightsDouble.end());
+}
+
+//---------------
+int print_weights(const thot_ms_tune_pars& tdp,
+                  const std::vector<float>& weightVec)
+{
+  std::ofstream outS;
+  outS.open(tdp.outFile.c_str(),std::ios::out);
+  if(!outS)
+  {
+    std::cerr<<"Error while opening output file: "<<tdp.outFile<<std::endl;
+    return THOT_ERROR;
+  }
+
+  for(unsigned int i=0;i<weightVec.size();++i)
+  {
+    if(i!=0) outS<<" ";
+    outS<<weightVec[i];
+  }
+  outS<<std::endl;
+  outS.close();
+  
+  return THOT_OK;
+}
+
+//---------------
+int tune_weights(const thot_ms_tune_pars& tdp)
+{
+  double elapsed_ant,elapsed,ucpu,scpu;
+  
+      // Read development corpus
+  DevCorpusTuningData dctd;
+  dctd.tdpPtr=&tdp;
+  if(read_dev_corpus(tdp,dctd)==THOT_ERROR)
+    return THOT_ERROR;
+  dctd.transVec.resize(dctd.srcSentVec.size());
+  dctd.nbTransVecs.resize(dctd.srcSentVec.size());
+  dctd.nbScoreCompsVecs.resize(dctd.srcSentVec.size());
+  dctd.nbEntrySets.resize(dctd.srcSentVec.size());
+  pthread_mutex_init(&dctd.mut,NULL);
+  
+      // Create one decoder instance per thread, the first thread uses
+      // the decoder created during initialization. Decoder instances
+      // are reused across tuning iterations
+  std::vector<DecoderWorkerData> dwdVec(tdp.numThreads);
+  get_main_decoder(dwdVec[0]);
+  int ret=check_word_graph_support(dwdVec[0]);
+  for(unsigned int i=1;ret==THOT_OK && i<dwdVec.size();++i)
+  {
+    if(create_worker_decoder(tdp,dwdVec[i])==THOT_ERROR)
+    {
+      for(unsigned int j=1;j<=i;++j)
+        release_worker_decoder(dwdVec[j]);
+      dwdVec.resize(1);
+      ret=THOT_ERROR;
+      break;
+    }
+  }
+
+  if(ret==THOT_OK)
+  {
+        // Obtain initial weights
+    std::vector<std::pair<std::string,float> > compWeights;
+    smtModelPtr->getWeights(compWeights);
+    std::vector<float> currWeightVec;
+    for(unsigned int i=0;i<compWeights.size();++i)
+      currWeightVec.push_back(compWeights[i].second);
+
+    std::cerr<<"\n- Tuning log-linear weights ("<<dctd.srcSentVec.size()<<" sentences, "<<tdp.numThreads<<" threads)...\n\n";
+    
+        // Tuning iterations
+    std::vector<float> bestWeightVec=currWeightVec;
+    double bestScore=0;
+    for(int iter=1;iter<=tdp.maxIters;++iter)
+    {
+      ctimer(&elapsed_ant,&ucpu,&scpu);
+      
+          // Translate development corpus using current weights
+      set_weights(dwdVec,currWeightVec);
+      ret=translate_dev_corpus(dwdVec,dctd);
+      if(ret==THOT_ERROR)
+        break;
+
+          // Evaluate translations
+      double score;
+      scorerPtr->corpusScore(dctd.transVec,dctd.refSentVec,score);
+      if(iter==1 || score>bestScore)
+      {
+        bestScore=score;
+        bestWeightVec=currWeightVec;
+      }
+
+      ctimer(&elapsed,&ucpu,&scpu);
+      
+          // Print iteration information
+      std::cerr<<"Iteration "<<iter<<": score= "<<score<<" ; new n-best entries= "<<dctd.numNewEntries;
+      std::cerr<<" ; weights=";
+      for(unsigned int i=0;i<currWeightVec.size();++i)
+        std::cerr<<" "<<currWeightVec[i];
+      std::cerr<<" ; decoding time= "<<elapsed-elapsed_ant<<std::endl;
+      if(tdp.verbosity)
+      {
+        std::cerr<<"- Time per sentence: "<<dctd.total_time/dctd.srcSentVec.size()<<std::endl;
+      }
+
+          // Finish if the n-best lists did not change or if the last
+          // iteration was reached
+      if(dctd.numNewEntries==0)
+      {
+        std::cerr<<"N-best lists did not change, tuning finished"<<std::endl;
+        break;
+      }
+      if(iter==tdp.maxIters)
+        break;
+
+          // Obtain new weights from accumulated n-best lists
+      ctimer(&elapsed_ant,&ucpu,&scpu);
+      std::vector<float> newWeightVec;
+      obtain_new_weights(dctd,currWeightVec,newWeightVec);
+      currWeightVec=newWeightVec;
+      ctimer(&elapsed,&ucpu,&scpu);
+      if(tdp.verbosity)
+        std::cerr<<"- Weight update time: "<<elapsed-elapsed_ant<<std::endl;
+    }
+
+    if(ret==THOT_OK)
+    {
+          // Print weights obtaining the best score
+      std::cerr<<"Best score: "<<bestScore<<" ; weights:";
+      for(unsigned int i=0;i<bestWeightVec.size();++i)
+        std::cerr<<" "<<bestWeightVec[i];
+      std::cerr<<std::endl;
+      ret=print_weights(tdp,bestWeightVec);
+    }
+    
+        // Release decoder instances
+    for(unsigned int i=1;i<dwdVec.size();++i)
+      release_worker_decoder(dwdVec[i]);
+  }
+
+  pthread_mutex_destroy(&dctd.mut);
+
+  return ret;
+}
+
+//---------------
+int handleParameters(int argc,
+                     char *argv[],
+                     thot_ms_tune_pars& tdp)
+{
+  if(argc==1 || readOption(argc,argv,"--version")!=-1)
+  {
+    version();
+    return THOT_ERROR;
+  }
+  if(readOption(argc,argv,"--help")!=-1)
+  {
+    printUsage();
+    return THOT_ERROR;   
+  }
+  if(takeParameters(argc,argv,tdp)==THOT_ERROR)
+  {
+    return THOT_ERROR;
+  }
+  else
+  {
+    if(checkParameters(tdp)==THOT_OK)
+    {
+      printParameters(tdp);
+      return THOT_OK;
+    }
+    else
+    {
+      return THOT_ERROR;
+    }
+  }
+}
+
+//---------------
+void thot_ms_tune_pars::takeParametersGivenArgcArgv(int argc,
+                                                    char *argv[])
+{
+     // Take common parameters
+ thot_ms_dec_common_pars::takeParametersGivenArgcArgv(argc,argv);
+
+     // Take file name with the references of the development corpus
+ readSTLstring(argc,argv, "-r",&refSentencesFile);
+
+     // Take size of the n-best lists
+ readInt(argc,argv, "-n", &nbListLen);
+
+     // Take maximum number of tuning iterations
+ readInt(argc,argv, "-iters", &maxIters);
+}
+
+//---------------
+int checkParameters(const thot_ms_tune_pars& tdp)
+{
+  if(checkCommonParameters(tdp)==THOT_ERROR)
+    return THOT_ERROR;
+  
+  if(tdp.refSentencesFile.empty())
+  {
+    std::cerr<<"Error: parameter -r not given!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(tdp.outFile.empty())
+  {
+    std::cerr<<"Error: parameter -o not given!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(tdp.nbListLen<1)
+  {
+    std::cerr<<"Error: value of -n parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;   
+  }
+
+  if(tdp.maxIters<1)
+  {
+    std::cerr<<"Error: value of -iters parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;   
+  }
+  
+  return THOT_OK;
+}
+
+//---------------
+void printParameters(const thot_ms_tune_pars& tdp)
+{
+ printCommonParameters(tdp);
+ std::cerr<<"reference dev. file: "<<tdp.refSentencesFile<<std::endl;
+ std::cerr<<"output file: "<<tdp.outFile<<std::endl;
+ std::cerr<<"n-best list size: "<<tdp.nbListLen<<std::endl;
+ std::cerr<<"maximum number of iterations: "<<tdp.maxIters<<std::endl;
+ std::cerr<<"verbosity level: "<<tdp.verbosity<<std::endl;
+}
+
+//---------------
+//---------------
+void printUsage(void)
+{
+  std::cerr << "thot_ms_tune     [-c <string>] [-tm <string>] [-lm <string>]"<<std::endl;
+  std::cerr << "                 -t <string> -r <string> -o <string>"<<std::endl;
+  std::cerr << "                 [-n <int>] [-iters <int>] [-nt <int>] [-et <int>]"<<std::endl;
+  std::cerr << "                 [-W <float>] [-S <int>] [-A <int>]"<<std::endl;
+  std::cerr << "                 [-I <int>] [-G <int>] [-h <int>]"<<std::endl;
+  std::cerr << "                 [-be] [ -nomon <int>] [-tmw <float> ... <float>]"<<std::endl;
+  std::cerr << "                 [-v|-v1|-v2]"<<std::endl;
+  std::cerr << "                 [--help] [--version]"<<std::endl<<std::endl;
+  std::cerr << " -c <string>           : Configuration file (command-line options override"<<std::endl;
+  std::cerr << "                         configuration file options)."<<std::endl;
+  std::cerr << " -tm <string>          : Prefix of translation model files or model descriptor."<<std::endl;
+  std::cerr << " -lm <string>          : Language model file name or model descriptor."<<std::endl;
+  std::cerr << " -t <string>           : File with the source sentences of the development"<<std::endl;
+  std::cerr << "                         corpus."<<std::endl;
+  std::cerr << " -r <string>           : File with the references of the development corpus."<<std::endl;
+  std::cerr << " -o <string>           : File to store the tuned weights (the weights obtaining"<<std::endl;
+  std::cerr << "                         the best score for the development corpus)."<<std::endl;
+  std::cerr << " -n <int>              : Size of the n-best lists obtained at each iteration"<<std::endl;
+  std::cerr << "                         ("<<TUNE_NBEST_DEFAULT<<" by default). N-best lists are merged with"<<std::endl;
+  std::cerr << "                         those of previous iterations."<<std::endl;
+  std::cerr << " -iters <int>          : Maximum number of tuning iterations ("<<TUNE_ITERS_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << "                         Tuning finishes before if the n-best lists do not"<<std::endl;
+  std::cerr << "                         change."<<std::endl;
+  std::cerr << " -nt <int>             : Number of translation threads. Models are loaded only"<<std::endl;
+  std::cerr << "                         once and shared by the threads ("<<PMSTACK_NT_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -et <int>             : Number of threads used to expand the hypotheses of"<<std::endl;
+  std::cerr << "                         each sentence ("<<PMSTACK_ET_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -W <float>            : Maximum number of translation options to be considered"<<std::endl;
+  std::cerr << "                         per each source phrase ("<<PMSTACK_W_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -S <int>              : Maximum number of hypotheses that can be stored in"<<std::endl;
+  std::cerr << "                         each stack ("<<PMSTACK_S_DEFAULT<<" by default)."<<std::endl;    
+  std::cerr << " -A <int>              : Maximum length in words of the source phrases to be"<<std::endl;
+  std::cerr << "                         translated ("<<PMSTACK_A_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -I <int>              : Number of hypotheses expanded at each iteration"<<std::endl;
+  std::cerr << "                         ("<<PMSTACK_I_DEFAULT<<" by default)."<<std::endl;
+#ifdef MULTI_STACK_USE_GRAN
+  std::cerr << " -G <int>              : Granularity parameter ("<<PMSTACK_G_DEFAULT<<"by default)."<<std::endl;
+#else
+  std::cerr << " -G <int>              : Parameter not available with the given configuration."<<std::endl;
+#endif
+  std::cerr << " -h <int>              : Heuristic function used: "<<NO_HEURISTIC<<"->None, "<<LOCAL_T_HEURISTIC<<"->LOCAL_T, "<<std::endl;
+  std::cerr << "                         "<<LOCAL_TD_HEURISTIC<<"->LOCAL_TD ("<<PMSTACK_H_DEFAULT<<" by default)."<<std::endl;
+  std::cerr << " -be                   : Execute a best-first algorithm (breadth-first search"<<std::endl;
+  std::cerr << "                         is executed by default)."<<std::endl;
+  std::cerr << " -nomon <int>          : Perform a non-monotonic search, allowing the decoder"<<std::endl;
+  std::cerr << "                         to skip up to <int> words from the last aligned source"<<std::endl;
+  std::cerr << "                         words. If <int> is equal to zero, then a monotonic"<<std::endl;
+  std::cerr << "                         search is performed ("<<PMSTACK_NOMON_DEFAULT<<" is the default value)."<<std::endl;
+  std::cerr << " -tmw <float>...<float>: Set initial model weights, the number of weights and"<<std::endl;
+  std::cerr << "                         their meaning depends on the model type."<<std::endl;
+  std::cerr << " -v|-v1|-v2            : verbose modes."<<std::endl;
+  std::cerr << " --help                : Display this help and exit."<<std::endl;
+  std::cerr << " --version             : Output version information and exit."<<std::endl;
+}
+
+//---------------
+void version(void)
+{
+  std::cerr<<"thot_ms_tune is part of the thot package "<<std::endl;
+  std::cerr<<"thot version "<<THOT_VERSION<<std::endl;
+  std::cerr<<"thot is GNU software written by Daniel Ortiz"<<std::endl;
+}
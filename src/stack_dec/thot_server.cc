@@ -34,6 +34,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <ErrorDefs.h>
 #include <StrProcUtils.h>
 #include <BasicSocketUtils.h>
+#include <SocketEventPoller.h>
 #include "thot_server_pars.h"
 #include "client_server_defs.h"
 #include <math.h>
@@ -41,6 +42,8 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <fstream>
 #include <iomanip>
 #include <set>
+#include <map>
+#include <deque>
 #include "options.h"
 #include "ctimer.h"
 #include <stdio.h>
@@ -51,6 +54,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <sys/wait.h>
 #include <signal.h>
 #include <pthread.h>
+#include <fcntl.h>
 
 //--------------- Constants ------------------------------------------
 
@@ -60,6 +64,9 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 
 #define DEFAULT_USER_ID             0
 
+#define RECV_CHUNK_SIZE          4096     // Number of bytes read from a
+                                          // connection at a time
+
 //--------------- Type definitions ------------------------------------
 
 struct request_data
@@ -68,25 +75,49 @@ struct request_data
   struct in_addr sin_addr;
   int request_type;
   int user_id;
+  std::vector<std::string> strVec;
+};
+
+struct connection_data
+{
+  struct in_addr sin_addr;
+  std::string buff;  // Data received that does not form a complete
+                     // request yet
 };
 
 //--------------- Function Declarations -------------------------------
 
 int processParameters(void);
 int start_server(void);
-int get_request_type(int sockd,
-                   int& request_type);
-int get_user_id(int sockd,
-                int& user_id);
-void* process_request(void* rdata_ptr);
+void accept_connections(int sockfd);
+void close_connection(int sockd);
+void close_all_connections(void);
+int read_available_data(int sockd);
+bool extract_request(int sockd,
+                     request_data& rdata);
+void dispatch_request_or_rearm(int sockd);
+void release_connection(int sockd);
+void dispatch_released_connections(void);
+bool get_int_from_buffer(const std::string& buff,
+                         size_t& pos,
+                         int& value);
+bool get_str_from_buffer(const std::string& buff,
+                         size_t& pos,
+                         std::string& str);
+unsigned int get_num_request_strs(int request_type);
+void* worker_thread(void* void_ptr);
+bool process_request(const request_data& rdata);
 void process_request_switch(int sockd,
                             int user_id,
                             int server_request_type,
+                            const std::vector<std::string>& strVec,
                             int verbose);
 int init_user_pars_if_required(int user_id);
-void increase_num_threads_var(void);
-void decrease_num_threads_var(void);
-void wait_on_num_threads_var_cond(void);
+void push_request(const request_data& rdata);
+bool pop_request(request_data& rdata);
+void close_request_queue(void);
+void set_end_server(void);
+bool end_server_requested(void);
 void sigchld_handler(int s);
 int handleParameters(int argc,
                      char *argv[]);
@@ -107,12 +138,22 @@ ThotDecoder* thotDecoderPtr;
     // (it is a costly process that otherwise would be executed even if
     // only the help message is to be printed)
 
-    // Mutexes and conditions
-pthread_mutex_t num_threads_var_mut;
-pthread_cond_t num_threads_var_cond;
-int num_threads;
+    // Connections and requests
+SocketEventPoller event_poller;
+std::map<int,connection_data> conn_map;
+std::vector<int> released_conn_vec;
+std::deque<request_data> request_queue;
+bool request_queue_closed;
+bool end_server;
 std::set<int> user_set;
 
+    // Mutexes and conditions
+pthread_mutex_t conn_map_mut;
+pthread_mutex_t request_queue_mut;
+pthread_cond_t request_queue_not_empty_cond;
+pthread_cond_t request_queue_not_full_cond;
+pthread_mutex_t user_set_mut;
+
 //--------------- Function Definitions --------------------------------
 
 
@@ -188,6 +229,8 @@ int processParameters(void)
       }
           // Start server
       int retCode=start_server();
+      if(ts_pars.v_given || ts_pars.vd_given)
+        thotDecoderPtr->printLockStats();
       delete thotDecoderPtr;
       return retCode;
     }
@@ -234,6 +277,10 @@ int start_server(void)
     exit(1);
   }
 
+      // Connections are accepted from the event loop, so the listening
+      // socket must not block
+  fcntl(sockfd,F_SETFL,fcntl(sockfd,F_GETFL,0)|O_NONBLOCK);
+
   sa.sa_handler = sigchld_handler; // kill inactive processes
   sigemptyset(&sa.sa_mask);
   sa.sa_flags = SA_RESTART;
@@ -244,151 +291,353 @@ int start_server(void)
   }
 
       // Initialize mutexes and conditions
-  num_threads=0;
-  pthread_mutex_init(&num_threads_var_mut,NULL);
-  pthread_cond_init(&num_threads_var_cond,NULL);
+  request_queue_closed=false;
+  end_server=false;
+  pthread_mutex_init(&conn_map_mut,NULL);
+  pthread_mutex_init(&request_queue_mut,NULL);
+  pthread_cond_init(&request_queue_not_empty_cond,NULL);
+  pthread_cond_init(&request_queue_not_full_cond,NULL);
+  pthread_mutex_init(&user_set_mut,NULL);
+
+      // Initialize event poller
+  if(event_poller.init()==THOT_ERROR || event_poller.addListener(sockfd)==THOT_ERROR)
+  {
+    StdCerrThreadSafe<<"Error while initializing event poller"<<std::endl;
+    exit(1);
+  }
+
+      // Start worker threads
+  std::vector<pthread_t> worker_tids;
+  for(unsigned int i=0;i<ts_pars.num_workers;++i)
+  {
+    pthread_t tid;
+    if(pthread_create(&tid,NULL,worker_thread,NULL)==0)
+      worker_tids.push_back(tid);
+    else
+      StdCerrThreadSafe<<"Warning: call to pthread_create failed"<<std::endl;
+  }
+  if(worker_tids.empty())
+  {
+    StdCerrThreadSafe<<"Error: no worker threads could be created"<<std::endl;
+    exit(1);
+  }
 
   StdCerrThreadSafe<<"Listening to port "<< ts_pars.server_port <<"..."<<std::endl;
   
-      // main accept() loop
-  bool end_server=false;
-  while(!end_server)
+      // Main event loop. Connections are kept open between requests.
+      // The data of each connection is read without blocking and
+      // buffered until it forms a complete request, then the request
+      // is handed to the workers, so slow clients do not hold a
+      // worker. A connection is not watched again until its request
+      // has been processed, so requests sent through the same
+      // connection are answered in order
+  while(!end_server_requested())
   {
-        // accept connection
-    struct sockaddr_in their_addr; // information about client addresses
-    int sin_size = sizeof(struct sockaddr_in);
-    int new_fd;
-    if ((new_fd = accept(sockfd,(struct sockaddr *)&their_addr,(socklen_t *)&sin_size)) == -1)
+    std::vector<int> readyFdVec;
+    if(event_poller.wait(readyFdVec)==THOT_ERROR)
     {
-      StdCerrThreadSafe<<"accept error"<<std::endl;
-      continue;
+      StdCerrThreadSafe<<"Error while waiting for socket events"<<std::endl;
+      break;
     }
 
-        // Obtain request type
-    int request_type;
-    int ret=get_request_type(new_fd,request_type);
-    if(ret==THOT_ERROR)
-    {
-      StdCerrThreadSafe<<"Error while obtaining request type"<<std::endl;
-      close(new_fd);
-      continue;
-    }
+        // Serve connections whose previous request has been processed
+    dispatch_released_connections();
 
-        // Check if server should be finished
-    if(request_type==END_SERVER)
-      end_server=true;
-      
-        // Obtain user identifier
-    int user_id;
-    ret=get_user_id(new_fd,user_id);
-    if(ret==THOT_ERROR)
+    for(unsigned int i=0;i<readyFdVec.size();++i)
     {
-      StdCerrThreadSafe<<"Error while obtaining user identifier"<<std::endl;
-      close(new_fd);
-      continue;
+      if(readyFdVec[i]==sockfd)
+      {
+        accept_connections(sockfd);
+      }
+      else
+      {
+        if(read_available_data(readyFdVec[i])==THOT_ERROR)
+          close_connection(readyFdVec[i]);
+        else
+          dispatch_request_or_rearm(readyFdVec[i]);
+      }
     }
+  }
 
-        // Init user parameters if required
-    ret=init_user_pars_if_required(user_id);
-    if(ret==THOT_ERROR)
+      // Wait for workers to process the queued requests
+  close_request_queue();
+  for(unsigned int i=0;i<worker_tids.size();++i)
+    pthread_join(worker_tids[i],NULL);
+
+  if(ts_pars.v_given || ts_pars.vd_given)
+    StdCerrThreadSafe<<"Server: shutting down"<<std::endl;
+
+      // Close connections
+  event_poller.remove(sockfd);
+  close(sockfd);
+  close_all_connections();
+  event_poller.release();
+  
+      // Destroy mutexes and conditions
+  pthread_mutex_destroy(&conn_map_mut);
+  pthread_mutex_destroy(&request_queue_mut);
+  pthread_cond_destroy(&request_queue_not_empty_cond);
+  pthread_cond_destroy(&request_queue_not_full_cond);
+  pthread_mutex_destroy(&user_set_mut);
+
+  return THOT_OK;
+}
+
+//---------------
+void accept_connections(int sockfd)
+{
+  while(true)
+  {
+    struct sockaddr_in their_addr; // information about client addresses
+    int sin_size = sizeof(struct sockaddr_in);
+    int new_fd;
+    if ((new_fd = accept(sockfd,(struct sockaddr *)&their_addr,(socklen_t *)&sin_size)) == -1)
     {
-      StdCerrThreadSafe<<"Error while initializing server parameters"<<std::endl;
-      close(new_fd);
-      continue;
+      if(errno!=EAGAIN && errno!=EWOULDBLOCK && errno!=EINTR)
+        StdCerrThreadSafe<<"accept error"<<std::endl;
+      return;
     }
-    
-        // Prepare request data (memory is released by thread provided
-        // it is sucessfully created)
-    request_data* rdata_ptr=new request_data;
-    rdata_ptr->sockd=new_fd;
-    rdata_ptr->sin_addr=their_addr.sin_addr;
-    rdata_ptr->request_type=request_type;
-    rdata_ptr->user_id=user_id;
-    
-        // Process request
-    pthread_t      tid;  // thread ID
-    pthread_attr_t attr; // thread attribute
-
-    pthread_attr_init(&attr);
-    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-    int thread_err=pthread_create(&tid, &attr, process_request, (void*) rdata_ptr);
-    if(thread_err>0)
+
+        // Accepted sockets may inherit the non-blocking flag of the
+        // listening socket. Answers are written by the workers in
+        // blocking mode, whereas requests are read by the event loop
+        // without blocking (see read_available_data())
+    fcntl(new_fd,F_SETFL,fcntl(new_fd,F_GETFL,0)&~O_NONBLOCK);
+    BasicSocketUtils::setTcpNoDelay(new_fd);
+
+    pthread_mutex_lock(&conn_map_mut);
+    conn_map[new_fd].sin_addr=their_addr.sin_addr;
+    conn_map[new_fd].buff.clear();
+    pthread_mutex_unlock(&conn_map_mut);
+
+    if(event_poller.addConnection(new_fd)==THOT_ERROR)
     {
-          // Release memory since thread was not created
-      delete rdata_ptr;
-      
-      StdCerrThreadSafe<<"Warning: call to pthread_create failed"<<std::endl;
+      StdCerrThreadSafe<<"Error while registering new connection"<<std::endl;
+      close_connection(new_fd);
     }
-    else
-    {
-          // Thread created successfully
+  }
+}
 
-          // Increase variable with number of threads being executed
-          // NOTE: this cannot be done inside process_request function.
-          // Otherwise, when waiting for threads to finish during shutting
-          // down, some threads may become blocked
-      increase_num_threads_var();
-    }
+//---------------
+void close_connection(int sockd)
+{
+  pthread_mutex_lock(&conn_map_mut);
+  /////////// begin of mutex
+      // NOTE: the descriptor is closed while holding the mutex, so its
+      // number cannot be reused by a new connection before the map is
+      // updated
+  event_poller.remove(sockd);
+  conn_map.erase(sockd);
+  close(sockd);
+  /////////// end of mutex 
+  pthread_mutex_unlock(&conn_map_mut);
+}
+
+//---------------
+void close_all_connections(void)
+{
+  pthread_mutex_lock(&conn_map_mut);
+  std::map<int,connection_data>::const_iterator iter;
+  for(iter=conn_map.begin();iter!=conn_map.end();++iter)
+  {
+    event_poller.remove(iter->first);
+    close(iter->first);
   }
+  conn_map.clear();
+  released_conn_vec.clear();
+  pthread_mutex_unlock(&conn_map_mut);
+}
 
-      // Wait for threads to finish
-  wait_on_num_threads_var_cond();
+//---------------
+void sigchld_handler(int /*s*/)
+{
+  while(wait(NULL) > 0){};
+}
 
-  if(ts_pars.v_given || ts_pars.vd_given)
-    StdCerrThreadSafe<<"Server: shutting down"<<std::endl;
+//---------------
+int read_available_data(int sockd)
+{
+      // Read all the data available in the connection without
+      // blocking. An error is returned if the connection was closed by
+      // the client
+  std::string data;
+  char chunk[RECV_CHUNK_SIZE];
+  while(true)
+  {
+    int numbytes=recv(sockd,chunk,RECV_CHUNK_SIZE,MSG_DONTWAIT);
+    if(numbytes==-1)
+    {
+      if(errno==EINTR)
+        continue;
+      if(errno==EAGAIN || errno==EWOULDBLOCK)
+        break;
+      return THOT_ERROR;
+    }
+    if(numbytes==0)
+      return THOT_ERROR;
+    data.append(chunk,numbytes);
+  }
 
-      // Destroy mutexes and conditions
-  pthread_mutex_destroy(&num_threads_var_mut);
-  pthread_cond_destroy(&num_threads_var_cond);
+  pthread_mutex_lock(&conn_map_mut);
+  conn_map[sockd].buff+=data;
+  pthread_mutex_unlock(&conn_map_mut);
 
   return THOT_OK;
 }
 
 //---------------
-void sigchld_handler(int /*s*/)
+bool extract_request(int sockd,
+                     request_data& rdata)
 {
-  while(wait(NULL) > 0){};
+  pthread_mutex_lock(&conn_map_mut);
+  /////////// begin of mutex
+  connection_data& cdata=conn_map[sockd];
+
+      // Requests are composed of the request type, the user identifier
+      // and the strings required by the request type, as they are sent
+      // by BasicSocketUtils
+  size_t pos=0;
+  bool complete=get_int_from_buffer(cdata.buff,pos,rdata.request_type) &&
+                get_int_from_buffer(cdata.buff,pos,rdata.user_id);
+  if(complete)
+  {
+    unsigned int numStrs=get_num_request_strs(rdata.request_type);
+    rdata.strVec.resize(numStrs);
+    for(unsigned int i=0;i<numStrs && complete;++i)
+      complete=get_str_from_buffer(cdata.buff,pos,rdata.strVec[i]);
+  }
+
+  if(complete)
+  {
+    rdata.sockd=sockd;
+    rdata.sin_addr=cdata.sin_addr;
+    cdata.buff.erase(0,pos);
+  }
+  /////////// end of mutex 
+  pthread_mutex_unlock(&conn_map_mut);
+
+  return complete;
 }
 
 //---------------
-int get_request_type(int sockd,
-                   int& request_type)
+void dispatch_request_or_rearm(int sockd)
 {
-  try
+  request_data rdata;
+  if(extract_request(sockd,rdata))
   {
-    request_type=BasicSocketUtils::recvInt(sockd);
+        // Queue request (blocks if the queue is full, then no more
+        // data is read from the clients until the workers catch up)
+    push_request(rdata);
   }
-  catch(const std::exception& e)
+  else
   {
-    return THOT_ERROR;
+        // Watch connection again to wait for the rest of the request
+    if(event_poller.rearm(sockd)==THOT_ERROR)
+      close_connection(sockd);
   }
-  
-  return THOT_OK;
 }
 
 //---------------
-int get_user_id(int sockd,
-                int& user_id)
+void release_connection(int sockd)
 {
-  try
+      // The connection is handed back to the event loop, since its
+      // buffer may already contain the next request
+  pthread_mutex_lock(&conn_map_mut);
+  released_conn_vec.push_back(sockd);
+  pthread_mutex_unlock(&conn_map_mut);
+
+  event_poller.wakeUp();
+}
+
+//---------------
+void dispatch_released_connections(void)
+{
+  std::vector<int> sockdVec;
+  pthread_mutex_lock(&conn_map_mut);
+  sockdVec.swap(released_conn_vec);
+  pthread_mutex_unlock(&conn_map_mut);
+
+  for(unsigned int i=0;i<sockdVec.size();++i)
+    dispatch_request_or_rearm(sockdVec[i]);
+}
+
+//---------------
+bool get_int_from_buffer(const std::string& buff,
+                         size_t& pos,
+                         int& value)
+{
+  if(buff.size()<pos+sizeof(int))
+    return false;
+
+  int netValue;
+  memcpy(&netValue,buff.data()+pos,sizeof(int));
+  value=ntohl(netValue);
+  pos+=sizeof(int);
+  return true;
+}
+
+//---------------
+bool get_str_from_buffer(const std::string& buff,
+                         size_t& pos,
+                         std::string& str)
+{
+  size_t auxPos=pos;
+  int numbytes;
+  if(!get_int_from_buffer(buff,auxPos,numbytes))
+    return false;
+
+  if(numbytes>0)
   {
-    user_id=BasicSocketUtils::recvInt(sockd);
+    if(buff.size()<auxPos+numbytes)
+      return false;
+    str.assign(buff,auxPos,numbytes);
+    auxPos+=numbytes;
   }
-  catch(const std::exception& e)
+  else
+    str.clear();
+
+  pos=auxPos;
+  return true;
+}
+
+//---------------
+unsigned int get_num_request_strs(int request_type)
+{
+  switch(request_type)
   {
-    return THOT_ERROR;
+    case OL_TRAIN_PAIR:
+    case TRAIN_ECM:
+    case VERIFY_COV:
+      return 2;
+    case TRANSLATE_SENT:
+    case TRANSLATE_SENT_HYPINFO:
+    case START_CAT:
+    case ADD_STR_TO_PREF:
+      return 1;
+    default:
+      return 0;
   }
-  
-  return THOT_OK;
 }
 
 //---------------
-void* process_request(void* void_ptr)
+void* worker_thread(void* /*void_ptr*/)
+{
+  request_data rdata;
+  while(pop_request(rdata))
+  {
+    if(process_request(rdata))
+      release_connection(rdata.sockd);
+    else
+    {
+      close_connection(rdata.sockd);
+    }
+  }
+  return NULL;
+}
+
+//---------------
+bool process_request(const request_data& rdata)
 {
-      // Read request data and release memory
-  request_data rdata=*(request_data*) void_ptr;
-  delete (request_data*) void_ptr;
-    
       // Initialize variables
   int verbose=THOTDEC_NON_VERBOSE_MODE;
   if(ts_pars.v_given)
@@ -399,6 +648,22 @@ void* process_request(void* void_ptr)
   bool printTid=true;
   if(verbose==THOTDEC_DEBUG_VERBOSE_MODE)
     printTid=false;
+
+      // The request has been completely received by the event loop
+  int request_type=rdata.request_type;
+  int user_id=rdata.user_id;
+
+      // Check if the client ends the dialog
+  if(request_type==END_CLIENT_DIALOG)
+    return false;
+
+      // Init user parameters if required
+  int ret=init_user_pars_if_required(user_id);
+  if(ret==THOT_ERROR)
+  {
+    StdCerrThreadSafe<<"Error while initializing server parameters"<<std::endl;
+    return false;
+  }
   
   if(verbose)
   {
@@ -410,7 +675,7 @@ void* process_request(void* void_ptr)
     StdCerrThreadSafeCond(printTid)<<"Processing new request..."<<std::endl;
     StdCerrThreadSafeCond(printTid)<<"Current time: "<<asctime(localtm);
     StdCerrThreadSafeCond(printTid)<<"Origin: "<<inet_ntoa(rdata.sin_addr)<<std::endl;
-    StdCerrThreadSafeCond(printTid)<<"Request type: "<<rdata.request_type<<std::endl;
+    StdCerrThreadSafeCond(printTid)<<"Request type: "<<request_type<<std::endl;
   }
 
   try
@@ -419,7 +684,7 @@ void* process_request(void* void_ptr)
     double elapsed_prev,elapsed,ucpu,scpu;
     ctimer(&elapsed_prev,&ucpu,&scpu);
 
-    process_request_switch(rdata.sockd,rdata.user_id,rdata.request_type,verbose);
+    process_request_switch(rdata.sockd,user_id,request_type,rdata.strVec,verbose);
 
     ctimer(&elapsed,&ucpu,&scpu);
 
@@ -432,27 +697,25 @@ void* process_request(void* void_ptr)
   {
         // Clean after failure
     if(verbose) StdCerrThreadSafeCond(printTid) << e.what() << std::endl;
-    close(rdata.sockd);
-    decrease_num_threads_var();
-    pthread_exit(NULL);
+    if(request_type==END_SERVER)
+      set_end_server();
+    return false;
   }
 
-  close(rdata.sockd);
-  decrease_num_threads_var();
-  pthread_exit(NULL);
+      // Check if server should be finished
+  if(request_type==END_SERVER)
+    set_end_server();
+
+  return true;
 }
 
 //---------------
 void process_request_switch(int sockd,
                             int user_id,
                             int server_request_type,
+                            const std::vector<std::string>& strVec,
                             int verbose)
 {
-  std::string stlStr;
-  std::string stlStr1;
-  std::string stlStr2;
-  std::string stlStrSrc;
-  std::string stlStrRef;
   std::string result;
   std::string bestHypInfo;
   std::string catResult;
@@ -463,53 +726,43 @@ void process_request_switch(int sockd,
   switch(server_request_type)
   {
     case OL_TRAIN_PAIR:
-      BasicSocketUtils::recvStlStr(sockd,stlStrSrc);
-      BasicSocketUtils::recvStlStr(sockd,stlStrRef);
-      ret=thotDecoderPtr->onlineTrainSentPair(user_id,stlStrSrc.c_str(),stlStrRef.c_str(),verbose);
+      ret=thotDecoderPtr->onlineTrainSentPair(user_id,strVec[0].c_str(),strVec[1].c_str(),verbose);
       BasicSocketUtils::writeInt(sockd,ret);
       if(ret==THOT_ERROR)
         throw std::runtime_error("Online training request failed");
       break;
 
     case TRAIN_ECM:
-      BasicSocketUtils::recvStlStr(sockd,stlStr1);
-      BasicSocketUtils::recvStlStr(sockd,stlStr2);
-      ret=thotDecoderPtr->trainEcm(user_id,stlStr1.c_str(),stlStr2.c_str(),verbose);
+      ret=thotDecoderPtr->trainEcm(user_id,strVec[0].c_str(),strVec[1].c_str(),verbose);
       BasicSocketUtils::writeInt(sockd,ret);
       if(ret==THOT_ERROR)
         throw std::runtime_error("Error correction model training request failed");
       break;
 
     case TRANSLATE_SENT:
-      BasicSocketUtils::recvStlStr(sockd,stlStr);
-      thotDecoderPtr->translateSentence(user_id,stlStr.c_str(),result,bestHypInfo,verbose);
+      thotDecoderPtr->translateSentence(user_id,strVec[0].c_str(),result,bestHypInfo,verbose);
       BasicSocketUtils::writeStr(sockd,result.c_str());
       BasicSocketUtils::writeStr(sockd,bestHypInfo.c_str());
       break;
 
     case TRANSLATE_SENT_HYPINFO:
-      BasicSocketUtils::recvStlStr(sockd,stlStr);
-      thotDecoderPtr->translateSentence(user_id,stlStr.c_str(),result,bestHypInfo,verbose);
+      thotDecoderPtr->translateSentence(user_id,strVec[0].c_str(),result,bestHypInfo,verbose);
       BasicSocketUtils::writeStr(sockd,result.c_str());
       BasicSocketUtils::writeStr(sockd,bestHypInfo.c_str());
       break;
 
     case VERIFY_COV:
-      BasicSocketUtils::recvStlStr(sockd,stlStrSrc);
-      BasicSocketUtils::recvStlStr(sockd,stlStrRef);
-      thotDecoderPtr->sentPairVerCov(user_id,stlStrSrc.c_str(),stlStrRef.c_str(),result,verbose);
+      thotDecoderPtr->sentPairVerCov(user_id,strVec[0].c_str(),strVec[1].c_str(),result,verbose);
       BasicSocketUtils::writeStr(sockd,result.c_str());
       break;
 
     case START_CAT:
-      BasicSocketUtils::recvStlStr(sockd,stlStr);
-      thotDecoderPtr->startCat(user_id,stlStr.c_str(),catResult,verbose);
+      thotDecoderPtr->startCat(user_id,strVec[0].c_str(),catResult,verbose);
       BasicSocketUtils::writeStr(sockd,catResult.c_str());
       break;
 
     case ADD_STR_TO_PREF:
-      BasicSocketUtils::recvStlStr(sockd,stlStr);
-      thotDecoderPtr->addStrToPref(user_id,stlStr.c_str(),emptyRejWordsSet,catResult,verbose);
+      thotDecoderPtr->addStrToPref(user_id,strVec[0].c_str(),emptyRejWordsSet,catResult,verbose);
       BasicSocketUtils::writeStr(sockd,catResult.c_str());
       break;
 
@@ -539,6 +792,8 @@ void process_request_switch(int sockd,
 int init_user_pars_if_required(int user_id)
 {
   int ret=THOT_OK;
+  pthread_mutex_lock(&user_set_mut);
+  /////////// begin of mutex
   std::set<int>::const_iterator user_set_iter=user_set.find(user_id);
   if(user_set_iter==user_set.end())
   {
@@ -550,59 +805,74 @@ int init_user_pars_if_required(int user_id)
         // Initialize parameters
     ret=thotDecoderPtr->initUserPars(user_id,tdu_pars,ts_pars.v_given);
   }
+  /////////// end of mutex 
+  pthread_mutex_unlock(&user_set_mut);
   return ret;
 }
 
 //---------------
-void increase_num_threads_var(void)
+void push_request(const request_data& rdata)
 {
-  pthread_mutex_lock(&num_threads_var_mut);
+  pthread_mutex_lock(&request_queue_mut);
   /////////// begin of mutex
-  ++num_threads;
+  while(request_queue.size()>=ts_pars.queue_depth)
+    pthread_cond_wait(&request_queue_not_full_cond,&request_queue_mut);
+  request_queue.push_back(rdata);
+  pthread_cond_signal(&request_queue_not_empty_cond);
   /////////// end of mutex 
-  pthread_mutex_unlock(&num_threads_var_mut);
+  pthread_mutex_unlock(&request_queue_mut);
 }
 
 //---------------
-void decrease_num_threads_var(void)
+bool pop_request(request_data& rdata)
 {
-  pthread_mutex_lock(&num_threads_var_mut);
+  pthread_mutex_lock(&request_queue_mut);
   /////////// begin of mutex
-  --num_threads;
-
-      // Restart threads waiting on condition
-  if(num_threads==0)
-    pthread_cond_broadcast(&num_threads_var_cond);
-      // The pthread_cond_broadcast() function shall unblock all threads
-      // currently blocked on the specified condition variable.
-
+  while(request_queue.empty() && !request_queue_closed)
+    pthread_cond_wait(&request_queue_not_empty_cond,&request_queue_mut);
+  if(request_queue.empty())
+  {
+        // Queue is closed and there are no pending requests
+    pthread_mutex_unlock(&request_queue_mut);
+    return false;
+  }
+  rdata=request_queue.front();
+  request_queue.pop_front();
+  pthread_cond_signal(&request_queue_not_full_cond);
   /////////// end of mutex 
-  pthread_mutex_unlock(&num_threads_var_mut);
+  pthread_mutex_unlock(&request_queue_mut);
+  return true;
 }
 
 //---------------
-void wait_on_num_threads_var_cond(void)
+void close_request_queue(void)
 {
-  pthread_mutex_lock(&num_threads_var_mut);
+  pthread_mutex_lock(&request_queue_mut);
   /////////// begin of mutex
-  while(num_threads>0)
-  {
-    pthread_cond_wait(&num_threads_var_cond,&num_threads_var_mut);
-        // The pthread_cond_wait() function is used to block on a
-        // condition variable. It is called with mutex locked by the
-        // calling thread or undefined behaviour will result.
+  request_queue_closed=true;
+  pthread_cond_broadcast(&request_queue_not_empty_cond);
+  /////////// end of mutex 
+  pthread_mutex_unlock(&request_queue_mut);
+}
 
-        // This function atomically release mutex and cause the calling
-        // thread to block on the condition variable
+//---------------
+void set_end_server(void)
+{
+  pthread_mutex_lock(&request_queue_mut);
+  end_server=true;
+  pthread_mutex_unlock(&request_queue_mut);
 
-        // Upon successful return, the mutex has been locked and is
-        // owned by the calling thread.
-  }
+      // Make the event loop notice the request
+  event_poller.wakeUp();
+}
 
-      // NOTE: num_threads_var_mut mutex is intentionally kept locked at
-      // the end of this function, preventing execution of new server
-      // request threads (however, with current implementation this is
-      // no longer possible)
+//---------------
+bool end_server_requested(void)
+{
+  pthread_mutex_lock(&request_queue_mut);
+  bool ret=end_server;
+  pthread_mutex_unlock(&request_queue_mut);
+  return ret;
 }
 
 //---------------
@@ -691,6 +961,38 @@ int takeParameters(int argc,
       }
     }
 
+        // -nw parameter
+    if(argv_stl[i]=="-nw" && !matched)
+    {
+      if(i==argc-1)
+      {
+        std::cerr<<"Error: no value for -nw parameter."<<std::endl;
+        return THOT_ERROR;
+      }
+      else
+      {
+        ts_pars.num_workers=atoi(argv_stl[i+1].c_str());
+        ++matched;
+        ++i;
+      }
+    }
+
+        // -qd parameter
+    if(argv_stl[i]=="-qd" && !matched)
+    {
+      if(i==argc-1)
+      {
+        std::cerr<<"Error: no value for -qd parameter."<<std::endl;
+        return THOT_ERROR;
+      }
+      else
+      {
+        ts_pars.queue_depth=atoi(argv_stl[i+1].c_str());
+        ++matched;
+        ++i;
+      }
+    }
+
         // -w parameter
     if(argv_stl[i]=="-w" && !matched)
     {
@@ -763,6 +1065,18 @@ int checkParameters(void)
     return THOT_ERROR;
   }
 
+  if(ts_pars.num_workers==0)
+  {
+    std::cerr<<"Error: the value of -nw parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(ts_pars.queue_depth==0)
+  {
+    std::cerr<<"Error: the value of -qd parameter should be greater than zero!"<<std::endl;
+    return THOT_ERROR;
+  }
+
   return THOT_OK;
 }
 
@@ -772,6 +1086,8 @@ void printParameters(void)
   std::cerr<<"-i: "<<ts_pars.i_given<<std::endl;
   std::cerr<<"-c: "<<ts_pars.c_given<<std::endl;
   std::cerr<<"-p: "<<ts_pars.server_port<<std::endl;
+  std::cerr<<"-nw: "<<ts_pars.num_workers<<std::endl;
+  std::cerr<<"-qd: "<<ts_pars.queue_depth<<std::endl;
   std::cerr<<"-w: "<<ts_pars.w_given<<std::endl;
   std::cerr<<"-v: "<<ts_pars.v_given<<std::endl;
   std::cerr<<"-vd: "<<ts_pars.vd_given<<std::endl;
@@ -781,11 +1097,17 @@ void printParameters(void)
 void printUsage(void)
 {
   std::cerr<<"Usage: thot_server    -i | -c <string>"<<std::endl;
-  std::cerr<<"                      [-p <int>] [ -w | -t ] [ -v | -vd ] [--help] [--version]"<<std::endl;
+  std::cerr<<"                      [-p <int>] [-nw <int>] [-qd <int>]"<<std::endl;
+  std::cerr<<"                      [ -w | -t ] [ -v | -vd ] [--help] [--version]"<<std::endl;
   std::cerr<<std::endl;
   std::cerr<<"-i             Test server initialization using master.ini and exit"<<std::endl<<std::endl;
   std::cerr<<"-c <string>    Configuration file"<<std::endl<<std::endl;
   std::cerr<<"-p <int>       Port used by the server"<<std::endl<<std::endl;
+  std::cerr<<"-nw <int>      Number of worker threads processing requests ("<<DEFAULT_SERVER_NUM_WORKERS<<" by"<<std::endl;
+  std::cerr<<"               default)"<<std::endl<<std::endl;
+  std::cerr<<"-qd <int>      Maximum number of requests waiting for a worker ("<<DEFAULT_SERVER_QUEUE_DEPTH<<" by"<<std::endl;
+  std::cerr<<"               default). When it is reached, the server stops reading"<<std::endl;
+  std::cerr<<"               from the clients until some request is processed"<<std::endl<<std::endl;
   std::cerr<<"-w             Print model weights and exit"<<std::endl<<std::endl;
   std::cerr<<"-t             Test software modules incorporated in model descriptors and exit"<<std::endl<<std::endl;
   std::cerr<<"-v             Verbose mode"<<std::endl<<std::endl;
@@ -36,6 +36,8 @@ struct thot_server_pars
   std::string c_str;
   bool p_given;
   unsigned int server_port;
+  unsigned int num_workers;
+  unsigned int queue_depth;
   bool w_given;
   bool t_given;
   bool v_given;
@@ -52,6 +54,8 @@ struct thot_server_pars
       c_given=false;
       p_given=false;
       server_port=DEFAULT_SERVER_PORT;
+      num_workers=DEFAULT_SERVER_NUM_WORKERS;
+      queue_depth=DEFAULT_SERVER_QUEUE_DEPTH;
       w_given=false;
       t_given=false;
       v_given=false;
@@ -0,0 +1,191 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+ 
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+ 
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file thot_stack_bench.cc
+ * 
+ * @brief Microbenchmark comparing the throughput of push and pop
+ * operations for the SmtStack and SmtHeapStack classes.
+ */
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "SmtStack.h"
+#include "SmtHeapStack.h"
+#include "WordIndex.h"
+#include "Score.h"
+#include "ctimer.h"
+#include "options.h"
+#include "ErrorDefs.h"
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define BENCH_DEFAULT_NUM_OPS    2000000
+#define BENCH_PUSHES_PER_SLOT    4
+#define BENCH_HYP_PAYLOAD_SIZE   8
+
+//--------------- Type definitions -----------------------------------
+
+// Hypothesis type used in the benchmark, the payload simulates the
+// cost of copying the language model history of actual hypotheses
+
+class BenchHyp
+{
+ public:
+  Score score;
+  std::vector<WordIndex> payload;
+
+  Score getScore(void)const{return score;}
+};
+
+//--------------- Function Declarations ------------------------------
+
+void printUsage(void);
+template<class STACK>
+unsigned int runBench(STACK& stack,
+                      unsigned int maxStackSize,
+                      const std::vector<BenchHyp>& hypVec,
+                      unsigned int numOps,
+                      Score& checkSum);
+
+//--------------- Function Definitions -------------------------------
+
+//--------------- main function
+int main(int argc, char *argv[])
+{
+  if(readOption(argc,argv,"--help")!=-1)
+  {
+    printUsage();
+    return THOT_OK;
+  }
+
+      // Take parameters
+  unsigned int numOps=BENCH_DEFAULT_NUM_OPS;
+  readUnsignedInt(argc,argv,"-n",&numOps);
+  std::vector<unsigned int> stackSizeVec;
+  unsigned int stackSize;
+  if(readUnsignedInt(argc,argv,"-S",&stackSize)!=-1)
+  {
+    stackSizeVec.push_back(stackSize);
+  }
+  else
+  {
+    stackSizeVec.push_back(100);
+    stackSizeVec.push_back(1000);
+    stackSizeVec.push_back(10000);
+  }
+
+      // Generate hypotheses
+  std::vector<BenchHyp> hypVec;
+  srand(31415);
+  for(unsigned int i=0;i<numOps;++i)
+  {
+    BenchHyp hyp;
+    hyp.score=-((double)rand()/RAND_MAX)*100;
+    hyp.payload.resize(BENCH_HYP_PAYLOAD_SIZE,i);
+    hypVec.push_back(hyp);
+  }
+
+      // Run benchmark
+  std::cout<<std::setw(8)<<"S"<<std::setw(16)<<"container"<<std::setw(12)<<"ops"<<std::setw(12)<<"secs"<<std::setw(12)<<"Mops/s"<<std::endl;
+  for(unsigned int i=0;i<stackSizeVec.size();++i)
+  {
+    Score checkSumMs=0;
+    Score checkSumHeap=0;
+    double elapsed_ant,elapsed,ucpu,scpu;
+    unsigned int ops;
+
+        // SmtStack (std::multiset)
+    SmtStack<BenchHyp> smtStack;
+    ctimer(&elapsed_ant,&ucpu,&scpu);
+    ops=runBench(smtStack,stackSizeVec[i],hypVec,numOps,checkSumMs);
+    ctimer(&elapsed,&ucpu,&scpu);
+    std::cout<<std::setw(8)<<stackSizeVec[i]<<std::setw(16)<<"SmtStack"<<std::setw(12)<<ops<<std::setw(12)<<elapsed-elapsed_ant<<std::setw(12)<<ops/(elapsed-elapsed_ant)/1e6<<std::endl;
+
+        // SmtHeapStack
+    SmtHeapStack<BenchHyp> smtHeapStack;
+    ctimer(&elapsed_ant,&ucpu,&scpu);
+    ops=runBench(smtHeapStack,stackSizeVec[i],hypVec,numOps,checkSumHeap);
+    ctimer(&elapsed,&ucpu,&scpu);
+    std::cout<<std::setw(8)<<stackSizeVec[i]<<std::setw(16)<<"SmtHeapStack"<<std::setw(12)<<ops<<std::setw(12)<<elapsed-elapsed_ant<<std::setw(12)<<ops/(elapsed-elapsed_ant)/1e6<<std::endl;
+
+        // Both containers should pop the same hypotheses
+    if(checkSumMs!=checkSumHeap)
+    {
+      std::cerr<<"Error: popped hypotheses differ for S= "<<stackSizeVec[i]<<std::endl;
+      return THOT_ERROR;
+    }
+  }
+  return THOT_OK;
+}
+
+//--------------- runBench function
+template<class STACK>
+unsigned int runBench(STACK& stack,
+                      unsigned int maxStackSize,
+                      const std::vector<BenchHyp>& hypVec,
+                      unsigned int numOps,
+                      Score& checkSum)
+{
+      // Each round pushes a number of hypotheses larger than the
+      // maximum stack size and then pops half of the stack, the
+      // stack is cleared every few rounds as in the decoder
+  unsigned int ops=0;
+  unsigned int hypIdx=0;
+  unsigned int round=0;
+  stack.setMaxStackSize(maxStackSize);
+  checkSum=0;
+  while(ops<numOps)
+  {
+    for(unsigned int i=0;i<BENCH_PUSHES_PER_SLOT*maxStackSize && ops<numOps;++i)
+    {
+      stack.push(hypVec[hypIdx]);
+      hypIdx=(hypIdx+1)%hypVec.size();
+      ++ops;
+    }
+    unsigned int numPops=stack.size()/2;
+    for(unsigned int i=0;i<numPops;++i)
+    {
+      BenchHyp hyp=stack.pop();
+      checkSum+=hyp.score*(double)hyp.payload[0];
+      ++ops;
+    }
+    ++round;
+    if(round%4==0) stack.clear();
+  }
+  return ops;
+}
+
+//--------------- printUsage function
+void printUsage(void)
+{
+  std::cerr<<"thot_stack_bench [-S <int>] [-n <int>] [--help]"<<std::endl;
+  std::cerr<<std::endl;
+  std::cerr<<"-S <int>   : Maximum stack size (by default, 100, 1000 and 10000 are"<<std::endl;
+  std::cerr<<"             evaluated)."<<std::endl;
+  std::cerr<<"-n <int>   : Number of push and pop operations per run ("<<BENCH_DEFAULT_NUM_OPS<<" by default)."<<std::endl;
+  std::cerr<<"--help     : Display this help and exit."<<std::endl;
+}
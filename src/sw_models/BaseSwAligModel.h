@@ -72,6 +72,12 @@ class BaseSwAligModel
 
     // Thread/Process safety related functions
     virtual bool modelReadsAreProcessSafe(void);
+
+    // Copy function
+    virtual BaseSwAligModel<PPINFO>* clone(void)const;
+        // Returns a copy of the model obtained in memory, or NULL if the
+        // model does not support it (e.g. models whose parameters are
+        // stored in a database that only one instance can open)
     
     // Functions to read and add sentence pairs
 	virtual bool readSentencePairs(const char *srcFileName,
@@ -269,6 +275,13 @@ bool BaseSwAligModel<PPINFO>::modelReadsAreProcessSafe(void)
   return true;
 }
 
+//-------------------------
+template<class PPINFO>
+BaseSwAligModel<PPINFO>* BaseSwAligModel<PPINFO>::clone(void)const
+{
+  return NULL;
+}
+
 //-------------------------
 template<class PPINFO>
 void BaseSwAligModel<PPINFO>::trainSentPairRange(std::pair<unsigned int,unsigned int> /*sentPairRange*/,
@@ -0,0 +1,466 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file BinParallelCorpus.cc
+ *
+ * @brief Definitions file for BinParallelCorpus.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "BinParallelCorpus.h"
+#include "AwkInputStream.h"
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//--------------- BinParallelCorpus class functions
+
+//-------------------------
+BinParallelCorpus::BinParallelCorpus(void)
+{
+  mapAddr=NULL;
+  mapSize=0;
+  header=NULL;
+  srcOffsets=NULL;
+  srcData=NULL;
+  trgOffsets=NULL;
+  trgData=NULL;
+  counts=NULL;
+}
+
+//-------------------------
+BinParallelCorpus::BinParallelCorpus(const BinParallelCorpus& other)
+{
+  mapAddr=NULL;
+  mapSize=0;
+  header=NULL;
+  srcOffsets=NULL;
+  srcData=NULL;
+  trgOffsets=NULL;
+  trgData=NULL;
+  counts=NULL;
+  if(other.isOpen())
+    open(other.mapFileName.c_str());
+}
+
+//-------------------------
+bool BinParallelCorpus::isBinCorpusFile(const char* fileName)
+{
+  std::ifstream inF(fileName,std::ios::in | std::ios::binary);
+  if(!inF)
+    return false;
+
+  char magic[8];
+  if(!inF.read(magic,sizeof(magic)))
+    return false;
+  return memcmp(magic,BIN_CORPUS_MAGIC,sizeof(magic))==0;
+}
+
+//-------------------------
+bool BinParallelCorpus::create(const char* srcFileName,
+                               const char* trgFileName,
+                               const char* sentCountsFile,
+                               const char* outFileName,
+                               bool varint,
+                               int verbose)
+{
+  std::ofstream outF(outFileName,std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!outF)
+  {
+    std::cerr<<"Error while creating binary corpus file "<<outFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Write provisional header, it is rewritten at the end
+  Header hdr;
+  memset(&hdr,0,sizeof(hdr));
+  memcpy(hdr.magic,BIN_CORPUS_MAGIC,sizeof(hdr.magic));
+  hdr.version=BIN_CORPUS_VERSION;
+  if(varint)
+    hdr.flags|=BIN_CORPUS_VARINT_FLAG;
+  outF.write((const char*)&hdr,sizeof(hdr));
+
+      // Encode source and target sentences
+  std::vector<std::string> srcVocab;
+  std::vector<std::string> trgVocab;
+  uint64_t numTrgSents;
+  if(verbose) std::cerr<<"Encoding source sentences from "<<srcFileName<<std::endl;
+  if(encodeSide(srcFileName,varint,outF,hdr.numSentPairs,hdr.srcOffsetsPos,hdr.srcDataPos,srcVocab)==THOT_ERROR)
+    return THOT_ERROR;
+  if(verbose) std::cerr<<"Encoding target sentences from "<<trgFileName<<std::endl;
+  if(encodeSide(trgFileName,varint,outF,numTrgSents,hdr.trgOffsetsPos,hdr.trgDataPos,trgVocab)==THOT_ERROR)
+    return THOT_ERROR;
+  if(hdr.numSentPairs!=numTrgSents)
+  {
+    std::cerr<<"Error: the number of source and target sentences differ!"<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Store sentence pair counts
+  if(strlen(sentCountsFile)!=0)
+  {
+    AwkInputStream awk;
+    if(awk.open(sentCountsFile)==THOT_ERROR)
+    {
+      std::cerr<<"Error: file with sentence counts "<<sentCountsFile<<" does not exist"<<std::endl;
+      return THOT_ERROR;
+    }
+    if(verbose) std::cerr<<"Encoding sentence pair counts from "<<sentCountsFile<<std::endl;
+    alignOutput(outF);
+    hdr.countsPos=outF.tellp();
+    for(uint64_t n=0;n<hdr.numSentPairs;++n)
+    {
+      if(!awk.getln())
+      {
+        std::cerr<<"Error: the number of sentence pairs and counts differ!"<<std::endl;
+        return THOT_ERROR;
+      }
+      float c=atof(awk.dollar(1).c_str());
+      outF.write((const char*)&c,sizeof(c));
+    }
+    hdr.flags|=BIN_CORPUS_COUNTS_FLAG;
+  }
+
+      // Store vocabularies
+  alignOutput(outF);
+  hdr.srcVocabPos=outF.tellp();
+  hdr.srcVocabSize=srcVocab.size();
+  writeVocab(outF,srcVocab);
+  alignOutput(outF);
+  hdr.trgVocabPos=outF.tellp();
+  hdr.trgVocabSize=trgVocab.size();
+  writeVocab(outF,trgVocab);
+  alignOutput(outF);
+  hdr.fileSize=outF.tellp();
+
+      // Rewrite header
+  outF.seekp(0);
+  outF.write((const char*)&hdr,sizeof(hdr));
+  outF.close();
+  if(!outF)
+  {
+    std::cerr<<"Error while writing binary corpus file "<<outFileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(verbose)
+  {
+    std::cerr<<"#Sentence pairs: "<<hdr.numSentPairs<<std::endl;
+    std::cerr<<"Source vocabulary size: "<<hdr.srcVocabSize<<std::endl;
+    std::cerr<<"Target vocabulary size: "<<hdr.trgVocabSize<<std::endl;
+  }
+  return THOT_OK;
+}
+
+//-------------------------
+bool BinParallelCorpus::encodeSide(const char* fileName,
+                                   bool varint,
+                                   std::ofstream& outF,
+                                   uint64_t& numSents,
+                                   uint64_t& offsetsPos,
+                                   uint64_t& dataPos,
+                                   std::vector<std::string>& vocab)
+{
+  AwkInputStream awk;
+  if(awk.open(fileName)==THOT_ERROR)
+  {
+    std::cerr<<"Error in file with sentences: "<<fileName<<std::endl;
+    return THOT_ERROR;
+  }
+
+      // Write word identifiers. Offsets are given in words for fixed
+      // length identifiers and in bytes for variable length ones
+  std::map<std::string,BinCorpusWordId> vocabMap;
+  std::vector<uint64_t> offsets;
+  uint64_t pos=0;
+  offsets.push_back(pos);
+  alignOutput(outF);
+  dataPos=outF.tellp();
+  while(awk.getln())
+  {
+    for(unsigned int i=1;i<=awk.NF;++i)
+    {
+      std::string word=awk.dollar(i);
+      std::map<std::string,BinCorpusWordId>::iterator mapIter=vocabMap.find(word);
+      BinCorpusWordId id;
+      if(mapIter==vocabMap.end())
+      {
+        id=vocab.size();
+        vocabMap[word]=id;
+        vocab.push_back(word);
+      }
+      else
+        id=mapIter->second;
+
+      if(varint)
+      {
+        unsigned char buff[8];
+        unsigned int nbytes=0;
+        while(id>=0x80)
+        {
+          buff[nbytes++]=(unsigned char)(id|0x80);
+          id>>=7;
+        }
+        buff[nbytes++]=(unsigned char)id;
+        outF.write((const char*)buff,nbytes);
+        pos+=nbytes;
+      }
+      else
+      {
+        outF.write((const char*)&id,sizeof(id));
+        pos+=1;
+      }
+    }
+    offsets.push_back(pos);
+  }
+  numSents=offsets.size()-1;
+
+      // Write sentence offsets
+  alignOutput(outF);
+  offsetsPos=outF.tellp();
+  outF.write((const char*)&offsets[0],offsets.size()*sizeof(uint64_t));
+
+  return THOT_OK;
+}
+
+//-------------------------
+void BinParallelCorpus::writeVocab(std::ofstream& outF,
+                                   const std::vector<std::string>& vocab)
+{
+  for(size_t i=0;i<vocab.size();++i)
+    outF.write(vocab[i].c_str(),vocab[i].size()+1);
+}
+
+//-------------------------
+void BinParallelCorpus::alignOutput(std::ofstream& outF)
+{
+  uint64_t pos=outF.tellp();
+  static const char padding[8]={0,0,0,0,0,0,0,0};
+  if(pos%8!=0)
+    outF.write(padding,8-pos%8);
+}
+
+//-------------------------
+bool BinParallelCorpus::open(const char* fileName)
+{
+  close();
+
+  int fd=::open(fileName,O_RDONLY);
+  if(fd==-1)
+  {
+    std::cerr<<"Error: binary corpus file "<<fileName<<" does not exist"<<std::endl;
+    return THOT_ERROR;
+  }
+  struct stat st;
+  if(fstat(fd,&st)==-1 || (size_t)st.st_size<sizeof(Header))
+  {
+    std::cerr<<"Error: file "<<fileName<<" is not a valid binary corpus"<<std::endl;
+    ::close(fd);
+    return THOT_ERROR;
+  }
+  void* addr=mmap(NULL,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+  ::close(fd);
+  if(addr==MAP_FAILED)
+  {
+    std::cerr<<"Error: binary corpus file "<<fileName<<" could not be mapped into memory"<<std::endl;
+    return THOT_ERROR;
+  }
+  mapFileName=fileName;
+  mapAddr=addr;
+  mapSize=st.st_size;
+
+      // Check header
+  header=(const Header*)mapAddr;
+  if(memcmp(header->magic,BIN_CORPUS_MAGIC,sizeof(header->magic))!=0 ||
+     header->version!=BIN_CORPUS_VERSION ||
+     header->fileSize!=mapSize)
+  {
+    std::cerr<<"Error: file "<<fileName<<" is not a valid binary corpus or it was created by an incompatible version"<<std::endl;
+    close();
+    return THOT_ERROR;
+  }
+
+      // Set section pointers
+  const unsigned char* base=(const unsigned char*)mapAddr;
+  srcOffsets=(const uint64_t*)(base+header->srcOffsetsPos);
+  srcData=base+header->srcDataPos;
+  trgOffsets=(const uint64_t*)(base+header->trgOffsetsPos);
+  trgData=base+header->trgDataPos;
+  if(header->flags & BIN_CORPUS_COUNTS_FLAG)
+    counts=(const float*)(base+header->countsPos);
+  else
+    counts=NULL;
+
+      // Load vocabularies
+  if(loadVocab(header->srcVocabPos,header->srcVocabSize,srcVocab)==THOT_ERROR ||
+     loadVocab(header->trgVocabPos,header->trgVocabSize,trgVocab)==THOT_ERROR)
+  {
+    std::cerr<<"Error: vocabulary of binary corpus "<<fileName<<" is corrupted"<<std::endl;
+    close();
+    return THOT_ERROR;
+  }
+
+  return THOT_OK;
+}
+
+//-------------------------
+bool BinParallelCorpus::loadVocab(uint64_t pos,
+                                  uint64_t vocabSize,
+                                  std::vector<std::string>& vocab)
+{
+  vocab.clear();
+  vocab.reserve(vocabSize);
+  const char* base=(const char*)mapAddr;
+  for(uint64_t i=0;i<vocabSize;++i)
+  {
+    const char* end=(const char*)memchr(base+pos,0,mapSize-pos);
+    if(end==NULL)
+      return THOT_ERROR;
+    vocab.push_back(std::string(base+pos,end));
+    pos=(end-base)+1;
+  }
+  return THOT_OK;
+}
+
+//-------------------------
+bool BinParallelCorpus::isOpen(void)const
+{
+  return mapAddr!=NULL;
+}
+
+//-------------------------
+size_t BinParallelCorpus::numSentPairs(void)const
+{
+  if(header)
+    return header->numSentPairs;
+  else
+    return 0;
+}
+
+//-------------------------
+void BinParallelCorpus::getSrcSent(size_t n,
+                                   std::vector<BinCorpusWordId>& srcSent)const
+{
+  getSent(srcOffsets,srcData,n,srcSent);
+}
+
+//-------------------------
+void BinParallelCorpus::getTrgSent(size_t n,
+                                   std::vector<BinCorpusWordId>& trgSent)const
+{
+  getSent(trgOffsets,trgData,n,trgSent);
+}
+
+//-------------------------
+void BinParallelCorpus::getSent(const uint64_t* offsets,
+                                const unsigned char* data,
+                                size_t n,
+                                std::vector<BinCorpusWordId>& sent)const
+{
+  sent.clear();
+  if(header->flags & BIN_CORPUS_VARINT_FLAG)
+  {
+    const unsigned char* ptr=data+offsets[n];
+    const unsigned char* end=data+offsets[n+1];
+    while(ptr<end)
+    {
+      BinCorpusWordId id=0;
+      unsigned int shift=0;
+      while(*ptr & 0x80)
+      {
+        id|=(BinCorpusWordId)(*ptr & 0x7f)<<shift;
+        shift+=7;
+        ++ptr;
+      }
+      id|=(BinCorpusWordId)(*ptr)<<shift;
+      ++ptr;
+      sent.push_back(id);
+    }
+  }
+  else
+  {
+    const BinCorpusWordId* ids=(const BinCorpusWordId*)data;
+    sent.assign(ids+offsets[n],ids+offsets[n+1]);
+  }
+}
+
+//-------------------------
+Count BinParallelCorpus::getCount(size_t n)const
+{
+  if(counts)
+    return counts[n];
+  else
+    return 1;
+}
+
+//-------------------------
+size_t BinParallelCorpus::getSrcVocabSize(void)const
+{
+  return srcVocab.size();
+}
+
+//-------------------------
+const std::string& BinParallelCorpus::srcWordIdToString(BinCorpusWordId id)const
+{
+  return srcVocab[id];
+}
+
+//-------------------------
+size_t BinParallelCorpus::getTrgVocabSize(void)const
+{
+  return trgVocab.size();
+}
+
+//-------------------------
+const std::string& BinParallelCorpus::trgWordIdToString(BinCorpusWordId id)const
+{
+  return trgVocab[id];
+}
+
+//-------------------------
+void BinParallelCorpus::close(void)
+{
+  if(mapAddr!=NULL)
+  {
+    munmap(mapAddr,mapSize);
+    mapAddr=NULL;
+  }
+  mapFileName.clear();
+  mapSize=0;
+  header=NULL;
+  srcOffsets=NULL;
+  srcData=NULL;
+  trgOffsets=NULL;
+  trgData=NULL;
+  counts=NULL;
+  srcVocab.clear();
+  trgVocab.clear();
+}
+
+//-------------------------
+BinParallelCorpus::~BinParallelCorpus()
+{
+  close();
+}
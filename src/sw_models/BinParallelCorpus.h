@@ -0,0 +1,163 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file BinParallelCorpus.h
+ *
+ * @brief Defines the BinParallelCorpus class, which gives random
+ * access to a parallel corpus stored in a binary file. The words of
+ * the corpus are encoded as identifiers local to the file (assigned in
+ * order of first appearance), each side stores an array of word
+ * identifiers and the offsets of the sentences, optionally compressed
+ * as variable-length integers. The file is memory-mapped, so any
+ * sentence pair is accessed in constant time without parsing text.
+ */
+
+#ifndef _BinParallelCorpus_h
+#define _BinParallelCorpus_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "ErrorDefs.h"
+#include "Count.h"
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//--------------- Constants ------------------------------------------
+
+#define BIN_CORPUS_MAGIC          "THOTBPC"
+#define BIN_CORPUS_VERSION        1
+#define BIN_CORPUS_VARINT_FLAG    1
+#define BIN_CORPUS_COUNTS_FLAG    2
+
+//--------------- typedefs -------------------------------------------
+
+typedef uint32_t BinCorpusWordId;
+
+//--------------- Classes --------------------------------------------
+
+//--------------- BinParallelCorpus class
+
+class BinParallelCorpus
+{
+ public:
+
+      // Constructors. Copies map the file of the corpus again, so the
+      // data is shared through the page cache
+  BinParallelCorpus(void);
+  BinParallelCorpus(const BinParallelCorpus& other);
+
+      // Returns true if the given file contains a binary corpus
+  static bool isBinCorpusFile(const char* fileName);
+
+      // Converts the text corpus given by the source, target and
+      // (optional) count files into a binary corpus
+  static bool create(const char* srcFileName,
+                     const char* trgFileName,
+                     const char* sentCountsFile,
+                     const char* outFileName,
+                     bool varint,
+                     int verbose=0);
+
+      // Maps a binary corpus into memory
+  bool open(const char* fileName);
+  bool isOpen(void)const;
+
+      // Access to the sentence pairs, n should be in the range
+      // [ 0 , numSentPairs() )
+  size_t numSentPairs(void)const;
+  void getSrcSent(size_t n,
+                  std::vector<BinCorpusWordId>& srcSent)const;
+  void getTrgSent(size_t n,
+                  std::vector<BinCorpusWordId>& trgSent)const;
+  Count getCount(size_t n)const;
+
+      // Vocabularies of the corpus
+  size_t getSrcVocabSize(void)const;
+  const std::string& srcWordIdToString(BinCorpusWordId id)const;
+  size_t getTrgVocabSize(void)const;
+  const std::string& trgWordIdToString(BinCorpusWordId id)const;
+
+      // Unmaps the corpus
+  void close(void);
+
+      // Destructor
+  ~BinParallelCorpus();
+
+ private:
+
+      // Assignment is not supported
+  BinParallelCorpus& operator=(const BinParallelCorpus& other);
+
+      // Header of the binary file, all sections are 8-byte aligned
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t numSentPairs;
+    uint64_t srcVocabSize;
+    uint64_t trgVocabSize;
+    uint64_t srcOffsetsPos;
+    uint64_t srcDataPos;
+    uint64_t trgOffsetsPos;
+    uint64_t trgDataPos;
+    uint64_t countsPos;
+    uint64_t srcVocabPos;
+    uint64_t trgVocabPos;
+    uint64_t fileSize;
+  };
+
+  std::string mapFileName;
+  void* mapAddr;
+  size_t mapSize;
+  const Header* header;
+  const uint64_t* srcOffsets;
+  const unsigned char* srcData;
+  const uint64_t* trgOffsets;
+  const unsigned char* trgData;
+  const float* counts;
+  std::vector<std::string> srcVocab;
+  std::vector<std::string> trgVocab;
+
+  void getSent(const uint64_t* offsets,
+               const unsigned char* data,
+               size_t n,
+               std::vector<BinCorpusWordId>& sent)const;
+  bool loadVocab(uint64_t pos,
+                 uint64_t vocabSize,
+                 std::vector<std::string>& vocab);
+  static bool encodeSide(const char* fileName,
+                         bool varint,
+                         std::ofstream& outF,
+                         uint64_t& numSents,
+                         uint64_t& offsetsPos,
+                         uint64_t& dataPos,
+                         std::vector<std::string>& vocab);
+  static void writeVocab(std::ofstream& outF,
+                         const std::vector<std::string>& vocab);
+  static void alignOutput(std::ofstream& outF);
+};
+
+#endif
@@ -35,3 +35,16 @@ IncrHmmAligModel::IncrHmmAligModel() : _incrHmmAligModel()
   incrLexTable = new IncrLexTable();
   lexNumDenFileExtension = ".hmm_lexnd";
 }
+
+//-------------------------
+IncrHmmAligModel::IncrHmmAligModel(const IncrHmmAligModel& other) : _incrHmmAligModel(other)
+{
+      // Copy table with lexical parameters
+  incrLexTable = new IncrLexTable(*static_cast<IncrLexTable*>(other.incrLexTable));
+}
+
+//-------------------------
+IncrHmmAligModel* IncrHmmAligModel::clone(void)const
+{
+  return new IncrHmmAligModel(*this);
+}
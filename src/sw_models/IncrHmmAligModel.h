@@ -51,8 +51,12 @@ class IncrHmmAligModel : public _incrHmmAligModel
 {
   public:
   
-   // Constructor
+   // Constructors
    IncrHmmAligModel();
+   IncrHmmAligModel(const IncrHmmAligModel& other);
+
+   // Copy function
+   IncrHmmAligModel* clone(void)const;
 
 };
 
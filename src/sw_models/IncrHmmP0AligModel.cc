@@ -35,3 +35,16 @@ IncrHmmP0AligModel::IncrHmmP0AligModel() : _incrHmmP0AligModel()
   incrLexTable = new IncrLexTable();
   lexNumDenFileExtension = ".hmm_lexnd";
 }
+
+//-------------------------
+IncrHmmP0AligModel::IncrHmmP0AligModel(const IncrHmmP0AligModel& other) : _incrHmmP0AligModel(other)
+{
+      // Copy table with lexical parameters
+  incrLexTable = new IncrLexTable(*static_cast<IncrLexTable*>(other.incrLexTable));
+}
+
+//-------------------------
+IncrHmmP0AligModel* IncrHmmP0AligModel::clone(void)const
+{
+  return new IncrHmmP0AligModel(*this);
+}
@@ -50,8 +50,12 @@ class IncrHmmP0AligModel : public _incrHmmP0AligModel
 {
   public:
 
-      // Constructor
+      // Constructors
    IncrHmmP0AligModel();
+   IncrHmmP0AligModel(const IncrHmmP0AligModel& other);
+
+      // Copy function
+   IncrHmmP0AligModel* clone(void)const;
 };
 
 #endif
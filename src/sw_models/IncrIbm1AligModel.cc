@@ -110,7 +110,7 @@ void IncrIbm1AligModel::clearInfoAboutSentRange(void)
       // Clear info about sentence range
   sentenceHandler.clear();
   anji.clear();
-  anji_aux.clear();
+  getIbm1EStepVars().anji_aux.clear();
 }
 
 //-------------------------
@@ -119,6 +119,9 @@ std::vector<WordIndex> IncrIbm1AligModel::getSrcSent(unsigned int n)
   std::vector<std::string> srcsStr;
   std::vector<WordIndex> result;
 
+  if(getBinCorpusSrcSent(n,result))
+    return result;
+
   sentenceHandler.getSrcSent(n,srcsStr);
   for(unsigned int i=0;i<srcsStr.size();++i)
   {
@@ -142,6 +145,9 @@ std::vector<WordIndex> IncrIbm1AligModel::getTrgSent(unsigned int n)
   std::vector<std::string> trgsStr;
   std::vector<WordIndex> trgs;
 
+  if(getBinCorpusTrgSent(n,trgs))
+    return trgs;
+
   sentenceHandler.getTrgSent(n,trgsStr);
   for(unsigned int i=0;i<trgsStr.size();++i)
   {
@@ -166,48 +172,115 @@ bool IncrIbm1AligModel::sentenceLengthIsOk(const std::vector<WordIndex> sentence
 void IncrIbm1AligModel::calcNewLocalSuffStats(std::pair<unsigned int,unsigned int> sentPairRange,
                                               int verbosity)
 {
+  if(eStepIsParallel(sentPairRange))
+  {
+    calcNewLocalSuffStatsParallel(sentPairRange,verbosity);
+    return;
+  }
+  
       // Iterate over the training samples
   for(unsigned int n=sentPairRange.first;n<=sentPairRange.second;++n)
   {
-        // Calculate sufficient statistics
+        // Calculate sufficient statistics for n'th sample
+    EStepSentPair sentPair;
+    if(initEStepSentPair(n,sentPair,verbosity))
+      calcEStepSentPair(sentPair,getEStepVars());
+  }
+}
+
+//-------------------------
+IncrIbm1AligModel::Ibm1EStepVars& IncrIbm1AligModel::getIbm1EStepVars(void)
+{
+  return static_cast<Ibm1EStepVars&>(getEStepVars());
+}
+
+//-------------------------
+_incrSwAligModel<std::vector<Prob> >::EStepVars* IncrIbm1AligModel::createEStepVars(void)
+{
+  return new Ibm1EStepVars;
+}
 
-        // Init vars for n'th sample
-    std::vector<WordIndex> srcSent=getSrcSent(n);
-    std::vector<WordIndex> nsrcSent=extendWithNullWord(srcSent);
-    std::vector<WordIndex> trgSent=getTrgSent(n);
+//-------------------------
+unsigned int IncrIbm1AligModel::getExpValMaxNSize(void)
+{
+  return anji.get_maxnsize();
+}
 
-    Count weight;
-    sentenceHandler.getCount(n,weight);
+//-------------------------
+bool IncrIbm1AligModel::initEStepSentPair(unsigned int n,
+                                          EStepSentPair& sentPair,
+                                          int verbosity)
+{
+      // Init vars for n'th sample
+  std::vector<WordIndex> srcSent=getSrcSent(n);
+  sentPair.nsrcSent=extendWithNullWord(srcSent);
+  sentPair.trgSent=getTrgSent(n);
+  sentenceHandler.getCount(n,sentPair.weight);
 
-        // Process sentence pair only if both sentences are not empty
-    if(sentenceLengthIsOk(srcSent) && sentenceLengthIsOk(trgSent))
+      // Process sentence pair only if both sentences are not empty
+  if(sentenceLengthIsOk(srcSent) && sentenceLengthIsOk(sentPair.trgSent))
+  {
+        // Initialize anji
+    anji.init_nth_entry(n,sentPair.nsrcSent.size(),sentPair.trgSent.size(),sentPair.mapped_n);
+    return true;
+  }
+  else
+  {
+    if(verbosity)
     {
-          // Calculate sufficient statistics for anji values
-      calc_anji(n,nsrcSent,trgSent,weight);
+      std::cerr<<"Warning, training pair "<<n+1<<" discarded due to sentence length (slen: "<<srcSent.size()<<" , tlen: "<<sentPair.trgSent.size()<<")"<<std::endl;
     }
-    else
+    return false;
+  }
+}
+
+//-------------------------
+void IncrIbm1AligModel::calcEStepSentPair(const EStepSentPair& sentPair,
+                                          EStepVars& vars)
+{
+      // Calculate sufficient statistics for anji values
+  calc_anji(sentPair.mapped_n,sentPair.nsrcSent,sentPair.trgSent,sentPair.weight,static_cast<Ibm1EStepVars&>(vars));
+}
+
+//-------------------------
+void IncrIbm1AligModel::accumulateEStepContribs(EStepVars& vars)
+{
+  Ibm1EStepVars& ibm1Vars=static_cast<Ibm1EStepVars&>(vars);
+  LexAuxVar& lexAuxVar=getIbm1EStepVars().lexAuxVar;
+  for(unsigned int k=0;k<ibm1Vars.lexContribVec.size();++k)
+    addLexContrib(ibm1Vars.lexContribVec[k],lexAuxVar);
+}
+
+//-------------------------
+void IncrIbm1AligModel::mergeEStepVars(EStepVars& vars)
+{
+  Ibm1EStepVars& ibm1Vars=static_cast<Ibm1EStepVars&>(vars);
+  LexAuxVar& lexAuxVar=getIbm1EStepVars().lexAuxVar;
+  for(unsigned int i=0;i<ibm1Vars.lexAuxVar.size();++i)
+  {
+    for(LexAuxVarElem::iterator lexAuxVarElemIter=ibm1Vars.lexAuxVar[i].begin();lexAuxVarElemIter!=ibm1Vars.lexAuxVar[i].end();++lexAuxVarElemIter)
     {
-      if(verbosity)
-      {
-        std::cerr<<"Warning, training pair "<<n+1<<" discarded due to sentence length (slen: "<<srcSent.size()<<" , tlen: "<<trgSent.size()<<")"<<std::endl;
-      }
+      LexContrib contrib;
+      contrib.s=i;
+      contrib.t=lexAuxVarElemIter->first;
+      contrib.weighted_curr_lanji=lexAuxVarElemIter->second.first;
+      contrib.weighted_new_lanji=lexAuxVarElemIter->second.second;
+      addLexContrib(contrib,lexAuxVar);
     }
   }
 }
 
 //-------------------------   
-void IncrIbm1AligModel::calc_anji(unsigned int n,
+void IncrIbm1AligModel::calc_anji(unsigned int mapped_n,
                                   const std::vector<WordIndex>& nsrcSent,
                                   const std::vector<WordIndex>& trgSent,
-                                  const Count& weight)
+                                  const Count& weight,
+                                  Ibm1EStepVars& vars)
 {
-      // Initialize anji and anji_aux
-  unsigned int mapped_n;
-  anji.init_nth_entry(n,nsrcSent.size(),trgSent.size(),mapped_n);
-    
+      // Initialize anji_aux
   unsigned int n_aux=1;
   unsigned int mapped_n_aux;
-  anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
+  vars.anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
 
       // Calculate new estimation of anji
   for(unsigned int j=1;j<=trgSent.size();++j)
@@ -228,26 +301,26 @@ void IncrIbm1AligModel::calc_anji(unsigned int n,
         // Set value of anji_aux
     for(unsigned int i=0;i<nsrcSent.size();++i)
     {
-      anji_aux.set_fast(mapped_n_aux,j,i,numVec[i]/sum_anji_num_forall_s);
+      vars.anji_aux.set_fast(mapped_n_aux,j,i,numVec[i]/sum_anji_num_forall_s);
     }
   }
 
       // Gather sufficient statistics
-  if(anji_aux.n_size()!=0)
+  if(vars.anji_aux.n_size()!=0)
   {
     for(unsigned int j=1;j<=trgSent.size();++j)
     {
       for(unsigned int i=0;i<nsrcSent.size();++i)
       {
             // Fill variables for n_aux,j,i
-        fillEmAuxVars(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight);
+        fillEmAuxVars(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight,vars);
 
             // Update anji
-        anji.set_fast(mapped_n,j,i,anji_aux.get_invp(n_aux,j,i));
+        anji.set_fast(mapped_n,j,i,vars.anji_aux.get_invp(n_aux,j,i));
       }
     }
         // clear anji_aux data structure
-    anji_aux.clear();
+    vars.anji_aux.clear();
   }
 }
 
@@ -281,7 +354,8 @@ void IncrIbm1AligModel::fillEmAuxVars(unsigned int mapped_n,
                                       PositionIndex j,
                                       const std::vector<WordIndex>& nsrcSent,
                                       const std::vector<WordIndex>& trgSent,
-                                      const Count& weight)
+                                      const Count& weight,
+                                      Ibm1EStepVars& vars)
 {
       // Init vars
   float weighted_curr_anji=0;
@@ -293,45 +367,57 @@ void IncrIbm1AligModel::fillEmAuxVars(unsigned int mapped_n,
       weighted_curr_anji=SMOOTHING_WEIGHTED_ANJI;
   }
 
-  float weighted_new_anji=(float)weight*anji_aux.get_invp_fast(mapped_n_aux,j,i);
+  float weighted_new_anji=(float)weight*vars.anji_aux.get_invp_fast(mapped_n_aux,j,i);
   if(weighted_new_anji!=0 && weighted_new_anji<SMOOTHING_WEIGHTED_ANJI)
     weighted_new_anji=SMOOTHING_WEIGHTED_ANJI;
 
-  WordIndex s=nsrcSent[i];
-  WordIndex t=trgSent[j-1];
+  LexContrib contrib;
+  contrib.s=nsrcSent[i];
+  contrib.t=trgSent[j-1];
   
       // Obtain logarithms
-  float weighted_curr_lanji;
   if(weighted_curr_anji==0)
-    weighted_curr_lanji=SMALL_LG_NUM;
+    contrib.weighted_curr_lanji=SMALL_LG_NUM;
   else
-    weighted_curr_lanji=log(weighted_curr_anji);
+    contrib.weighted_curr_lanji=log(weighted_curr_anji);
   
-  float weighted_new_lanji=log(weighted_new_anji);
+  contrib.weighted_new_lanji=log(weighted_new_anji);
 
       // Store contributions
-  while(lexAuxVar.size()<=s)
+  if(vars.bufferContribs)
+    vars.lexContribVec.push_back(contrib);
+  else
+    addLexContrib(contrib,vars.lexAuxVar);
+}
+
+//-------------------------   
+void IncrIbm1AligModel::addLexContrib(const LexContrib& contrib,
+                                      LexAuxVar& lexAuxVar)
+{
+  while(lexAuxVar.size()<=contrib.s)
   {
     LexAuxVarElem lexAuxVarElem;
     lexAuxVar.push_back(lexAuxVarElem);
   }
   
-  LexAuxVarElem::iterator lexAuxVarElemIter=lexAuxVar[s].find(t);
-  if(lexAuxVarElemIter!=lexAuxVar[s].end())
+  LexAuxVarElem::iterator lexAuxVarElemIter=lexAuxVar[contrib.s].find(contrib.t);
+  if(lexAuxVarElemIter!=lexAuxVar[contrib.s].end())
   {
-    if(weighted_curr_lanji!=SMALL_LG_NUM)
-      lexAuxVarElemIter->second.first=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.first,weighted_curr_lanji);
-    lexAuxVarElemIter->second.second=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.second,weighted_new_lanji);
+    if(contrib.weighted_curr_lanji!=SMALL_LG_NUM)
+      lexAuxVarElemIter->second.first=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.first,contrib.weighted_curr_lanji);
+    lexAuxVarElemIter->second.second=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.second,contrib.weighted_new_lanji);
   }
   else
   {
-    lexAuxVar[s][t]=std::make_pair(weighted_curr_lanji,weighted_new_lanji);
+    lexAuxVar[contrib.s][contrib.t]=std::make_pair(contrib.weighted_curr_lanji,contrib.weighted_new_lanji);
   }
 }
 
 //-------------------------   
 void IncrIbm1AligModel::updatePars(void)
 {
+  LexAuxVar& lexAuxVar=getIbm1EStepVars().lexAuxVar;
+
       // Update parameters
   for(unsigned int i=0;i<lexAuxVar.size();++i)
   {
@@ -883,11 +969,19 @@ void IncrIbm1AligModel::clear(void)
 {
   _swAligModel<std::vector<Prob> >::clear();
   anji.clear();
-  anji_aux.clear();
+  getIbm1EStepVars().anji_aux.clear();
   incrLexTable.clear();
   sentLengthModel.clear();
 }
 
+//-------------------------
+void IncrIbm1AligModel::Ibm1EStepVars::clear(void)
+{
+  anji_aux.clear();
+  lexAuxVar.clear();
+  lexContribVec.clear();
+}
+
 //-------------------------
 void IncrIbm1AligModel::clearTempVars(void)
 {
@@ -181,11 +181,29 @@ class IncrIbm1AligModel: public _incrSwAligModel<std::vector<Prob> >
    WeightedIncrNormSlm sentLengthModel;
 
    anjiMatrix anji;
-   anjiMatrix anji_aux;
-       // Data structures for manipulating expected values
-
-   LexAuxVar lexAuxVar;
-       // EM algorithm auxiliary variables
+       // Data structure for manipulating expected values
+
+       // Contribution of a sentence pair to the lexical sufficient
+       // statistics
+   struct LexContrib
+   {
+     WordIndex s;
+     WordIndex t;
+     float weighted_curr_lanji;
+     float weighted_new_lanji;
+   };
+
+       // Variables used to gather sufficient statistics
+   class Ibm1EStepVars: public EStepVars
+   {
+    public:
+     anjiMatrix anji_aux;
+     LexAuxVar lexAuxVar;
+         // EM algorithm auxiliary variables
+     std::vector<LexContrib> lexContribVec;
+
+     void clear(void);
+   };
    
    IncrLexTable incrLexTable;
 
@@ -222,10 +240,11 @@ class IncrIbm1AligModel: public _incrSwAligModel<std::vector<Prob> >
    // EM-related functions
    void calcNewLocalSuffStats(std::pair<unsigned int,unsigned int> sentPairRange,
                               int verbosity=0);
-   void calc_anji(unsigned int n,
+   void calc_anji(unsigned int mapped_n,
                   const std::vector<WordIndex>& nsrcSent,
                   const std::vector<WordIndex>& trgSent,
-                  const Count& weight);
+                  const Count& weight,
+                  Ibm1EStepVars& vars);
    virtual double calc_anji_num(const std::vector<WordIndex>& nsrcSent,
                                 const std::vector<WordIndex>& trgSent,
                                 unsigned int i,
@@ -236,8 +255,23 @@ class IncrIbm1AligModel: public _incrSwAligModel<std::vector<Prob> >
                               PositionIndex j,
                               const std::vector<WordIndex>& nsrcSent,
                               const std::vector<WordIndex>& trgSent,
-                              const Count& weight);
+                              const Count& weight,
+                              Ibm1EStepVars& vars);
+   void addLexContrib(const LexContrib& contrib,
+                      LexAuxVar& lexAuxVar);
    virtual void updatePars(void);
+
+   // Functions to gather sufficient statistics in parallel
+   Ibm1EStepVars& getIbm1EStepVars(void);
+   EStepVars* createEStepVars(void);
+   unsigned int getExpValMaxNSize(void);
+   bool initEStepSentPair(unsigned int n,
+                          EStepSentPair& sentPair,
+                          int verbosity);
+   void calcEStepSentPair(const EStepSentPair& sentPair,
+                          EStepVars& vars);
+   void accumulateEStepContribs(EStepVars& vars);
+   void mergeEStepVars(EStepVars& vars);
    virtual float obtainLogNewSuffStat(float lcurrSuffStat,
                                       float lLocalSuffStatCurr,
                                       float lLocalSuffStatNew);
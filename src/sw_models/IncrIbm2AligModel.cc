@@ -98,10 +98,11 @@ void IncrIbm2AligModel::fillEmAuxVars(unsigned int mapped_n,
                                       PositionIndex j,
                                       const std::vector<WordIndex>& nsrcSent,
                                       const std::vector<WordIndex>& trgSent,
-                                      const Count& weight)
+                                      const Count& weight,
+                                      Ibm1EStepVars& vars)
 {
-  IncrIbm1AligModel::fillEmAuxVars(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight);
-  fillEmAuxVarsAlig(mapped_n,mapped_n_aux,i,j,nsrcSent.size()-1,trgSent.size(),weight);
+  IncrIbm1AligModel::fillEmAuxVars(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight,vars);
+  fillEmAuxVarsAlig(mapped_n,mapped_n_aux,i,j,nsrcSent.size()-1,trgSent.size(),weight,static_cast<Ibm2EStepVars&>(vars));
 }
 
 //-------------------------   
@@ -111,7 +112,8 @@ void IncrIbm2AligModel::fillEmAuxVarsAlig(unsigned int mapped_n,
                                           PositionIndex j,
                                           PositionIndex slen,
                                           PositionIndex tlen,
-                                          const Count& weight)
+                                          const Count& weight,
+                                          Ibm2EStepVars& vars)
 {
       // Init vars
   float curr_anji=anji.get_fast(mapped_n,j,i);
@@ -123,37 +125,88 @@ void IncrIbm2AligModel::fillEmAuxVarsAlig(unsigned int mapped_n,
       weighted_curr_anji=SMOOTHING_WEIGHTED_ANJI;
   }
 
-  float weighted_new_anji=(float)weight*anji_aux.get_invp_fast(mapped_n_aux,j,i);
+  float weighted_new_anji=(float)weight*vars.anji_aux.get_invp_fast(mapped_n_aux,j,i);
   if(weighted_new_anji<SMOOTHING_WEIGHTED_ANJI)
     weighted_new_anji=SMOOTHING_WEIGHTED_ANJI;
   
       // Init aSource data structure
-  aSource as;
-  as.j=j;
-  as.slen=slen;
-  as.tlen=tlen;
-  aSourceMask(as);
+  AligContrib contrib;
+  contrib.as.j=j;
+  contrib.as.slen=slen;
+  contrib.as.tlen=tlen;
+  aSourceMask(contrib.as);
+  contrib.i=i;
 
       // Obtain logarithms
-  float weighted_curr_lanji;
   if(weighted_curr_anji==0)
-    weighted_curr_lanji=SMALL_LG_NUM;
+    contrib.weighted_curr_lanji=SMALL_LG_NUM;
   else
-    weighted_curr_lanji=log(weighted_curr_anji);
+    contrib.weighted_curr_lanji=log(weighted_curr_anji);
   
-  float weighted_new_lanji=log(weighted_new_anji);
+  contrib.weighted_new_lanji=log(weighted_new_anji);
 
       // Store contributions
-  AligAuxVar::iterator aligAuxVarIter=aligAuxVar.find(std::make_pair(as,i));
+  if(vars.bufferContribs)
+    vars.aligContribVec.push_back(contrib);
+  else
+    addAligContrib(contrib,vars.aligAuxVar);
+}
+
+//-------------------------   
+void IncrIbm2AligModel::addAligContrib(const AligContrib& contrib,
+                                       AligAuxVar& aligAuxVar)
+{
+  AligAuxVar::iterator aligAuxVarIter=aligAuxVar.find(std::make_pair(contrib.as,contrib.i));
   if(aligAuxVarIter!=aligAuxVar.end())
   {
-    if(weighted_curr_lanji!=SMALL_LG_NUM)
-      aligAuxVarIter->second.first=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.first,weighted_curr_lanji);
-    aligAuxVarIter->second.second=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.second,weighted_new_lanji);
+    if(contrib.weighted_curr_lanji!=SMALL_LG_NUM)
+      aligAuxVarIter->second.first=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.first,contrib.weighted_curr_lanji);
+    aligAuxVarIter->second.second=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.second,contrib.weighted_new_lanji);
   }
   else
   {
-    aligAuxVar[std::make_pair(as,i)]=std::make_pair(weighted_curr_lanji,weighted_new_lanji);
+    aligAuxVar[std::make_pair(contrib.as,contrib.i)]=std::make_pair(contrib.weighted_curr_lanji,contrib.weighted_new_lanji);
+  }
+}
+
+//-------------------------
+IncrIbm2AligModel::Ibm2EStepVars& IncrIbm2AligModel::getIbm2EStepVars(void)
+{
+  return static_cast<Ibm2EStepVars&>(getEStepVars());
+}
+
+//-------------------------
+_incrSwAligModel<std::vector<Prob> >::EStepVars* IncrIbm2AligModel::createEStepVars(void)
+{
+  return new Ibm2EStepVars;
+}
+
+//-------------------------
+void IncrIbm2AligModel::accumulateEStepContribs(EStepVars& vars)
+{
+  IncrIbm1AligModel::accumulateEStepContribs(vars);
+
+  Ibm2EStepVars& ibm2Vars=static_cast<Ibm2EStepVars&>(vars);
+  AligAuxVar& aligAuxVar=getIbm2EStepVars().aligAuxVar;
+  for(unsigned int k=0;k<ibm2Vars.aligContribVec.size();++k)
+    addAligContrib(ibm2Vars.aligContribVec[k],aligAuxVar);
+}
+
+//-------------------------
+void IncrIbm2AligModel::mergeEStepVars(EStepVars& vars)
+{
+  IncrIbm1AligModel::mergeEStepVars(vars);
+
+  Ibm2EStepVars& ibm2Vars=static_cast<Ibm2EStepVars&>(vars);
+  AligAuxVar& aligAuxVar=getIbm2EStepVars().aligAuxVar;
+  for(AligAuxVar::iterator aligAuxVarIter=ibm2Vars.aligAuxVar.begin();aligAuxVarIter!=ibm2Vars.aligAuxVar.end();++aligAuxVarIter)
+  {
+    AligContrib contrib;
+    contrib.as=aligAuxVarIter->first.first;
+    contrib.i=aligAuxVarIter->first.second;
+    contrib.weighted_curr_lanji=aligAuxVarIter->second.first;
+    contrib.weighted_new_lanji=aligAuxVarIter->second.second;
+    addAligContrib(contrib,aligAuxVar);
   }
 }
 
@@ -167,6 +220,8 @@ void IncrIbm2AligModel::updatePars(void)
 //-------------------------   
 void IncrIbm2AligModel::updateParsAlig(void)
 {
+  AligAuxVar& aligAuxVar=getIbm2EStepVars().aligAuxVar;
+
         // Update parameters
   for(AligAuxVar::iterator aligAuxVarIter=aligAuxVar.begin();aligAuxVarIter!=aligAuxVar.end();++aligAuxVarIter)
   {
@@ -508,6 +563,14 @@ LgProb IncrIbm2AligModel::lexAligM2LpForBestAlig(std::vector<WordIndex> nSrcSent
   return aligLgProb;
 }
 
+//-------------------------
+void IncrIbm2AligModel::Ibm2EStepVars::clear(void)
+{
+  Ibm1EStepVars::clear();
+  aligAuxVar.clear();
+  aligContribVec.clear();
+}
+
 //-------------------------
 void IncrIbm2AligModel::aSourceMask(aSource &/*as*/)
 {
@@ -132,8 +132,27 @@ class IncrIbm2AligModel: public IncrIbm1AligModel
    IncrIbm2AligTable incrIbm2AligTable;
 
    typedef std::map<std::pair<aSource,PositionIndex>,std::pair<float,float> > AligAuxVar;
-   AligAuxVar aligAuxVar;
-       // EM algorithm auxiliary variables
+
+       // Contribution of a sentence pair to the alignment sufficient
+       // statistics
+   struct AligContrib
+   {
+     aSource as;
+     PositionIndex i;
+     float weighted_curr_lanji;
+     float weighted_new_lanji;
+   };
+
+       // Variables used to gather sufficient statistics
+   class Ibm2EStepVars: public Ibm1EStepVars
+   {
+    public:
+     AligAuxVar aligAuxVar;
+         // EM algorithm auxiliary variables
+     std::vector<AligContrib> aligContribVec;
+
+     void clear(void);
+   };
 
    // Auxiliar scoring functions
    virtual double unsmoothed_aProb(PositionIndex j,
@@ -162,17 +181,27 @@ class IncrIbm2AligModel: public IncrIbm1AligModel
                       PositionIndex j,
                       const std::vector<WordIndex>& nsrcSent,
                       const std::vector<WordIndex>& trgSent,
-                      const Count& weight);
+                      const Count& weight,
+                      Ibm1EStepVars& vars);
    void fillEmAuxVarsAlig(unsigned int mapped_n,
                           unsigned int mapped_n_aux,
                           PositionIndex i,
                           PositionIndex j,
                           PositionIndex slen,
                           PositionIndex tlen,
-                          const Count& weight);
+                          const Count& weight,
+                          Ibm2EStepVars& vars);
+   void addAligContrib(const AligContrib& contrib,
+                       AligAuxVar& aligAuxVar);
    void updatePars(void);
    void updateParsAlig(void);
 
+   // Functions to gather sufficient statistics in parallel
+   Ibm2EStepVars& getIbm2EStepVars(void);
+   EStepVars* createEStepVars(void);
+   void accumulateEStepContribs(EStepVars& vars);
+   void mergeEStepVars(EStepVars& vars);
+
    // Mask for aSource. This function makes it possible to affect the
    // estimation of the alignment probabilities by setting to zero the
    // components of 'as'
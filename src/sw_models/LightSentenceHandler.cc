@@ -36,6 +36,20 @@ LightSentenceHandler::LightSentenceHandler(void)
   currFileSentIdx=0;
 }
 
+//-------------------------
+LightSentenceHandler::LightSentenceHandler(const LightSentenceHandler& other):BaseSentenceHandler(other),binCorpus(other.binCorpus)
+{
+      // File streams are positioned at the same line as those of other
+  awkSrc=other.awkSrc;
+  awkTrg=other.awkTrg;
+  awkSrcTrgC=other.awkSrcTrgC;
+  countFileExists=other.countFileExists;
+  nsPairsInFiles=other.nsPairsInFiles;
+  currFileSentIdx=other.currFileSentIdx;
+  sentPairCont=other.sentPairCont;
+  sentPairCount=other.sentPairCount;
+}
+
 //-------------------------
 bool LightSentenceHandler::readSentencePairs(const char *srcFileName,
                                              const char *trgFileName,
@@ -49,6 +63,19 @@ bool LightSentenceHandler::readSentencePairs(const char *srcFileName,
      // Fill first field of sentRange
  sentRange.first=0;
 
+     // Check if sentence pairs are stored in a binary corpus
+ if(BinParallelCorpus::isBinCorpusFile(srcFileName))
+ {
+   std::cerr<<"Reading sentence pairs from binary corpus: "<<srcFileName<<std::endl;
+   if(binCorpus.open(srcFileName)==THOT_ERROR)
+     return THOT_ERROR;
+   nsPairsInFiles=binCorpus.numSentPairs();
+   if(nsPairsInFiles>0)
+     std::cerr<<"#Sentence pairs in files: "<<nsPairsInFiles<<std::endl;
+   sentRange.second=nsPairsInFiles-1;
+   return THOT_OK;
+ }
+
      // Open source file
  if(awkSrc.open(srcFileName)==THOT_ERROR)
  {
@@ -198,6 +225,21 @@ int LightSentenceHandler::nthSentPairFromFiles(unsigned int n,
       // Check if entry is contained in files
   if(n>=nsPairsInFiles)
     return THOT_ERROR;
+
+  if(binCorpus.isOpen())
+  {
+    std::vector<BinCorpusWordId> sent;
+    binCorpus.getSrcSent(n,sent);
+    srcSentStr.clear();
+    for(unsigned int i=0;i<sent.size();++i)
+      srcSentStr.push_back(binCorpus.srcWordIdToString(sent[i]));
+    binCorpus.getTrgSent(n,sent);
+    trgSentStr.clear();
+    for(unsigned int i=0;i<sent.size();++i)
+      trgSentStr.push_back(binCorpus.trgWordIdToString(sent[i]));
+    c=binCorpus.getCount(n);
+    return THOT_OK;
+  }
   
       // Find corresponding entries
   if(currFileSentIdx>n)
@@ -287,6 +329,12 @@ int LightSentenceHandler::getTrgSent(unsigned int n,
 int LightSentenceHandler::getCount(unsigned int n,
                                    Count& c)
 {
+  if(getBinCorpusForSent(n))
+  {
+    c=binCorpus.getCount(n);
+    return THOT_OK;
+  }
+
   std::vector<std::string> srcSentStr;
   std::vector<std::string> trgSentStr;
 
@@ -295,6 +343,15 @@ int LightSentenceHandler::getCount(unsigned int n,
   return ret;  
 }
 
+//-------------------------
+const BinParallelCorpus* LightSentenceHandler::getBinCorpusForSent(unsigned int n)const
+{
+  if(binCorpus.isOpen() && n<nsPairsInFiles)
+    return &binCorpus;
+  else
+    return NULL;
+}
+
 //-------------------------
 bool LightSentenceHandler::printSentPairs(const char *srcSentFile,
                                           const char *trgSentFile,
@@ -374,6 +431,7 @@ void LightSentenceHandler::clear(void)
   awkSrc.close();
   awkTrg.close();
   awkSrcTrgC.close();
+  binCorpus.close();
   countFileExists=false;
   currFileSentIdx=0;
 }
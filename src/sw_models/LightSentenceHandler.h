@@ -37,6 +37,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include <fstream>
 #include <string.h>
 #include "BaseSentenceHandler.h"
+#include "BinParallelCorpus.h"
 
 //--------------- Constants ------------------------------------------
 
@@ -53,8 +54,10 @@ class LightSentenceHandler: public BaseSentenceHandler
 {
   public:
 
-       // Constructor
+       // Constructors. Copies open the files of the sentence pairs
+       // again, so they can be read independently
    LightSentenceHandler(void);   
+   LightSentenceHandler(const LightSentenceHandler& other);
 
        // Functions to read and add sentence pairs
    bool readSentencePairs(const char *srcFileName,
@@ -62,7 +65,10 @@ class LightSentenceHandler: public BaseSentenceHandler
                           const char *sentCountsFile,
                           std::pair<unsigned int,unsigned int>& sentRange);
        // NOTE: when function readSentencePairs() is invoked, previously
-       //       seen sentence pairs are removed
+       //       seen sentence pairs are removed. If srcFileName is a
+       //       binary corpus (see BinParallelCorpus), both sides and
+       //       the counts are taken from it, and trgFileName and
+       //       sentCountsFile are ignored
 
    void addSentPair(std::vector<std::string> srcSentStr,
                     std::vector<std::string> trgSentStr,
@@ -82,6 +88,10 @@ class LightSentenceHandler: public BaseSentenceHandler
    int getCount(unsigned int n,
                 Count& c);
 
+       // Give access to the sentence pairs stored in a binary corpus
+       // (it returns NULL if sentence n is not stored there)
+   const BinParallelCorpus* getBinCorpusForSent(unsigned int n)const;
+
        // Functions to print sentence pairs
    bool printSentPairs(const char *srcSentFile,
                        const char *trgSentFile,
@@ -95,6 +105,7 @@ class LightSentenceHandler: public BaseSentenceHandler
    AwkInputStream awkSrc;
    AwkInputStream awkTrg;
    AwkInputStream awkSrcTrgC;
+   BinParallelCorpus binCorpus;
 
    bool countFileExists;
    size_t nsPairsInFiles;
@@ -42,6 +42,20 @@ _incrHmmAligModel::_incrHmmAligModel()
   lexSmoothInterpFactor=DEFAULT_LEX_SMOOTH_INTERP_FACTOR;
 }
 
+//-------------------------
+_incrHmmAligModel::_incrHmmAligModel(const _incrHmmAligModel& other):_incrSwAligModel<std::vector<Prob> >(other),lanji(other.lanji),lanjm1ip_anji(other.lanjm1ip_anji),lexNumDenFileExtension(other.lexNumDenFileExtension),incrHmmAligTable(other.incrHmmAligTable),sentLengthModel(other.sentLengthModel)
+{
+  incrLexTable=NULL;
+
+      // Link pointers of the copied sentence length model with the
+      // data of this model
+  sentLengthModel.linkVocabPtr(&swVocab);
+  sentLengthModel.linkSentPairInfo(&sentenceHandler);
+
+  aligSmoothInterpFactor=other.aligSmoothInterpFactor;
+  lexSmoothInterpFactor=other.lexSmoothInterpFactor;
+}
+
 //-------------------------
 void _incrHmmAligModel::set_expval_maxnsize(unsigned int _expval_maxnsize)
 {
@@ -151,9 +165,9 @@ void _incrHmmAligModel::clearInfoAboutSentRange(void)
       // Clear info about sentence range
   sentenceHandler.clear();
   lanji.clear();
-  lanji_aux.clear();
   lanjm1ip_anji.clear();
-  lanjm1ip_anji_aux.clear();
+  getHmmEStepVars().lanji_aux.clear();
+  getHmmEStepVars().lanjm1ip_anji_aux.clear();
 }
 
 //-------------------------
@@ -270,9 +284,10 @@ double _incrHmmAligModel::cached_logaProb(PositionIndex prev_i,
                                           PositionIndex slen,
                                           PositionIndex i,
                                           const std::vector<WordIndex>& /*nsrcSent*/,
-                                          const std::vector<WordIndex>& /*trgSent*/)
+                                          const std::vector<WordIndex>& /*trgSent*/,
+                                          HmmEStepVars& vars)
 {
-  double d=cachedAligLogProbs.get(prev_i,slen,i);
+  double d=vars.cachedAligLogProbs.get(prev_i,slen,i);
   if(d<CACHED_HMM_ALIG_LGPROB_VIT_INVALID_VAL)
   {
     return d;
@@ -280,7 +295,7 @@ double _incrHmmAligModel::cached_logaProb(PositionIndex prev_i,
   else
   {
     double d=(double)logaProb(prev_i,slen,i);
-    cachedAligLogProbs.set(prev_i,slen,i,d);
+    vars.cachedAligLogProbs.set(prev_i,slen,i,d);
     return d;
   }
 }
@@ -337,6 +352,9 @@ std::vector<WordIndex> _incrHmmAligModel::getSrcSent(unsigned int n)
   std::vector<std::string> srcsStr;
   std::vector<WordIndex> result;
 
+  if(getBinCorpusSrcSent(n,result))
+    return result;
+
   sentenceHandler.getSrcSent(n,srcsStr);
   for(unsigned int i=0;i<srcsStr.size();++i)
   {
@@ -388,6 +406,9 @@ std::vector<WordIndex> _incrHmmAligModel::getTrgSent(unsigned int n)
   std::vector<std::string> trgsStr;
   std::vector<WordIndex> trgs;
 
+  if(getBinCorpusTrgSent(n,trgs))
+    return trgs;
+
   sentenceHandler.getTrgSent(n,trgsStr);
   for(unsigned int i=0;i<trgsStr.size();++i)
   {
@@ -539,53 +560,145 @@ void _incrHmmAligModel::initCachedLexicalLps(const std::vector<WordIndex>& nSrcS
 void _incrHmmAligModel::calcNewLocalSuffStats(std::pair<unsigned int,unsigned int> sentPairRange,
                                               int verbosity)
 {
-      // Iterate over the training samples
-  for(unsigned int n=sentPairRange.first;n<=sentPairRange.second;++n)
+  if(eStepIsParallel(sentPairRange))
   {
-        // Init vars for n'th sample
-    std::vector<WordIndex> srcSent=getSrcSent(n);
-    std::vector<WordIndex> nsrcSent=extendWithNullWord(srcSent);
-    std::vector<WordIndex> trgSent=getTrgSent(n);
+    calcNewLocalSuffStatsParallel(sentPairRange,verbosity);
+  }
+  else
+  {
+        // Iterate over the training samples
+    for(unsigned int n=sentPairRange.first;n<=sentPairRange.second;++n)
+    {
+          // Calculate sufficient statistics for n'th sample
+      EStepSentPair sentPair;
+      if(initEStepSentPair(n,sentPair,verbosity))
+        calcEStepSentPair(sentPair,getEStepVars());
+    }
+  }
+      // Clear cached alignment log probs
+  getHmmEStepVars().cachedAligLogProbs.clear();
+}
 
-        // Do not process sentence pair if sentences are empty or exceed the maximum length
-    if(sentenceLengthIsOk(srcSent) && sentenceLengthIsOk(trgSent))
+//-------------------------
+_incrHmmAligModel::HmmEStepVars& _incrHmmAligModel::getHmmEStepVars(void)
+{
+  return static_cast<HmmEStepVars&>(getEStepVars());
+}
+
+//-------------------------
+_incrSwAligModel<std::vector<Prob> >::EStepVars* _incrHmmAligModel::createEStepVars(void)
+{
+  return new HmmEStepVars;
+}
+
+//-------------------------
+unsigned int _incrHmmAligModel::getExpValMaxNSize(void)
+{
+  return lanji.get_maxnsize();
+}
+
+//-------------------------
+bool _incrHmmAligModel::initEStepSentPair(unsigned int n,
+                                          EStepSentPair& sentPair,
+                                          int verbosity)
+{
+      // Init vars for n'th sample
+  std::vector<WordIndex> srcSent=getSrcSent(n);
+  sentPair.nsrcSent=extendWithNullWord(srcSent);
+  sentPair.trgSent=getTrgSent(n);
+
+      // Do not process sentence pair if sentences are empty or exceed the maximum length
+  if(sentenceLengthIsOk(srcSent) && sentenceLengthIsOk(sentPair.trgSent))
+  {
+    sentenceHandler.getCount(n,sentPair.weight);
+    sentPair.nsrcSentAlig=extendWithNullWordAlig(srcSent);
+
+        // Initialize data structures for expected values
+    lanji.init_nth_entry(n,sentPair.nsrcSent.size(),sentPair.trgSent.size(),sentPair.mapped_n);
+    lanjm1ip_anji.init_nth_entry(n,sentPair.nsrcSentAlig.size(),sentPair.trgSent.size(),sentPair.mapped_n_alig);
+    return true;
+  }
+  else
+  {
+    if(verbosity)
     {
-      Count weight;
-      sentenceHandler.getCount(n,weight);
+      std::cerr<<"Warning, training pair "<<n+1<<" discarded due to sentence length (slen: "<<srcSent.size()<<" , tlen: "<<sentPair.trgSent.size()<<")"<<std::endl;
+    }
+    return false;
+  }
+}
 
-          // Initialize data structure to cache lexical log-probs
-      initCachedLexicalLps(nsrcSent,trgSent,cachedLexLogProbs);
+//-------------------------
+void _incrHmmAligModel::calcEStepSentPair(const EStepSentPair& sentPair,
+                                          EStepVars& vars)
+{
+  HmmEStepVars& hmmVars=static_cast<HmmEStepVars&>(vars);
 
-          // Make room for data structure to cache alignment log-probs
-      cachedAligLogProbs.makeRoomGivenNSrcSentLen(nsrcSent.size());
+      // Initialize data structure to cache lexical log-probs
+  initCachedLexicalLps(sentPair.nsrcSent,sentPair.trgSent,hmmVars.cachedLexLogProbs);
 
-          // Calculate alpha and beta matrices
-      calcAlphaMatrix(n,nsrcSent,trgSent);
-      calcBetaMatrix(n,nsrcSent,trgSent);
+      // Make room for data structure to cache alignment log-probs
+  hmmVars.cachedAligLogProbs.makeRoomGivenNSrcSentLen(sentPair.nsrcSent.size());
 
-          // Calculate sufficient statistics for anji values
-      calc_lanji(n,nsrcSent,trgSent,weight);
+      // Calculate alpha and beta matrices
+  calcAlphaMatrix(0,sentPair.nsrcSent,sentPair.trgSent,hmmVars);
+  calcBetaMatrix(0,sentPair.nsrcSent,sentPair.trgSent,hmmVars);
 
-          // Calculate sufficient statistics for anjm1ip_anji values
-      calc_lanjm1ip_anji(n,extendWithNullWordAlig(srcSent),trgSent,weight);
+      // Calculate sufficient statistics for anji values
+  calc_lanji(sentPair.mapped_n,sentPair.nsrcSent,sentPair.trgSent,sentPair.weight,hmmVars);
 
-          // Clear cached alpha and beta values
-      alphaMatrix.clear();
-      betaMatrix.clear();
+      // Calculate sufficient statistics for anjm1ip_anji values
+  calc_lanjm1ip_anji(sentPair.mapped_n_alig,sentPair.nsrcSentAlig,sentPair.trgSent,sentPair.weight,hmmVars);
 
-          // Clear cached lexical log prob
-      cachedLexLogProbs.clear();
-    }
-    else
+      // Clear cached alpha and beta values
+  hmmVars.alphaMatrix.clear();
+  hmmVars.betaMatrix.clear();
+
+      // Clear cached lexical log prob
+  hmmVars.cachedLexLogProbs.clear();
+}
+
+//-------------------------
+void _incrHmmAligModel::accumulateEStepContribs(EStepVars& vars)
+{
+  HmmEStepVars& hmmVars=static_cast<HmmEStepVars&>(vars);
+  HmmEStepVars& mainVars=getHmmEStepVars();
+  for(unsigned int k=0;k<hmmVars.lexContribVec.size();++k)
+    addLexContrib(hmmVars.lexContribVec[k],mainVars.lexAuxVar);
+  for(unsigned int k=0;k<hmmVars.aligContribVec.size();++k)
+    addAligContrib(hmmVars.aligContribVec[k],mainVars.aligAuxVar);
+}
+
+//-------------------------
+void _incrHmmAligModel::mergeEStepVars(EStepVars& vars)
+{
+  HmmEStepVars& hmmVars=static_cast<HmmEStepVars&>(vars);
+  HmmEStepVars& mainVars=getHmmEStepVars();
+
+      // Merge lexical sufficient statistics
+  for(unsigned int i=0;i<hmmVars.lexAuxVar.size();++i)
+  {
+    for(LexAuxVarElem::iterator lexAuxVarElemIter=hmmVars.lexAuxVar[i].begin();lexAuxVarElemIter!=hmmVars.lexAuxVar[i].end();++lexAuxVarElemIter)
     {
-      if(verbosity)
-      {
-        std::cerr<<"Warning, training pair "<<n+1<<" discarded due to sentence length (slen: "<<srcSent.size()<<" , tlen: "<<trgSent.size()<<")"<<std::endl;
-      }
+      LexContrib contrib;
+      contrib.s=i;
+      contrib.t=lexAuxVarElemIter->first;
+      contrib.weighted_curr_lanji=lexAuxVarElemIter->second.first;
+      contrib.weighted_new_lanji=lexAuxVarElemIter->second.second;
+      addLexContrib(contrib,mainVars.lexAuxVar);
     }
   }
-      // Clear cached alignment log probs
-  cachedAligLogProbs.clear();
+
+      // Merge alignment sufficient statistics
+  for(AligAuxVar::iterator aligAuxVarIter=hmmVars.aligAuxVar.begin();aligAuxVarIter!=hmmVars.aligAuxVar.end();++aligAuxVarIter)
+  {
+    AligContrib contrib;
+    contrib.asHmm=aligAuxVarIter->first.first;
+    contrib.i=aligAuxVarIter->first.second;
+    contrib.weighted_curr_lanjm1ip_anji=aligAuxVarIter->second.first;
+    contrib.weighted_new_lanjm1ip_anji=aligAuxVarIter->second.second;
+    addAligContrib(contrib,mainVars.aligAuxVar);
+  }
 }
 
 //-------------------------
@@ -637,8 +750,12 @@ void _incrHmmAligModel::calcNewLocalSuffStatsVit(std::pair<unsigned int,unsigned
 //-------------------------
 void _incrHmmAligModel::calcAlphaMatrix(unsigned int /*n*/,
                                         const std::vector<WordIndex>& nsrcSent,
-                                        const std::vector<WordIndex>& trgSent)
+                                        const std::vector<WordIndex>& trgSent,
+                                        HmmEStepVars& vars)
 {
+  std::vector<std::vector<double> >& alphaMatrix=vars.alphaMatrix;
+  std::vector<std::vector<double> >& cachedLexLogProbs=vars.cachedLexLogProbs;
+
       // Obtain slen
   PositionIndex slen=getSrcLen(nsrcSent);
 
@@ -655,7 +772,7 @@ void _incrHmmAligModel::calcAlphaMatrix(unsigned int /*n*/,
     {
       if(j==1)
       {
-        alphaMatrix[i][j]=cached_logaProb(0,slen,i,nsrcSent,trgSent)+
+        alphaMatrix[i][j]=cached_logaProb(0,slen,i,nsrcSent,trgSent,vars)+
           cachedLexLogProbs[i][j];
       }
       else
@@ -663,7 +780,7 @@ void _incrHmmAligModel::calcAlphaMatrix(unsigned int /*n*/,
         for(PositionIndex i_tilde=1;i_tilde<=nsrcSent.size();++i_tilde)
         {
           double lp=alphaMatrix[i_tilde][j-1]+
-            cached_logaProb(i_tilde,slen,i,nsrcSent,trgSent)+
+            cached_logaProb(i_tilde,slen,i,nsrcSent,trgSent,vars)+
             cachedLexLogProbs[i][j];
           if(i_tilde==1)
             alphaMatrix[i][j]=lp;
@@ -678,8 +795,12 @@ void _incrHmmAligModel::calcAlphaMatrix(unsigned int /*n*/,
 //-------------------------
 void _incrHmmAligModel::calcBetaMatrix(unsigned int /*n*/,
                                        const std::vector<WordIndex>& nsrcSent,
-                                       const std::vector<WordIndex>& trgSent)
+                                       const std::vector<WordIndex>& trgSent,
+                                       HmmEStepVars& vars)
 {
+  std::vector<std::vector<double> >& betaMatrix=vars.betaMatrix;
+  std::vector<std::vector<double> >& cachedLexLogProbs=vars.cachedLexLogProbs;
+
       // Obtain slen
   PositionIndex slen=getSrcLen(nsrcSent);
 
@@ -703,7 +824,7 @@ void _incrHmmAligModel::calcBetaMatrix(unsigned int /*n*/,
         for(PositionIndex i_tilde=1;i_tilde<=nsrcSent.size();++i_tilde)
         {
           double lp=betaMatrix[i_tilde][j+1]+
-            cached_logaProb(i,slen,i_tilde,nsrcSent,trgSent)+
+            cached_logaProb(i,slen,i_tilde,nsrcSent,trgSent,vars)+
             cachedLexLogProbs[i_tilde][j+1];
           if(i_tilde==1)
             betaMatrix[i][j]=lp;
@@ -716,20 +837,18 @@ void _incrHmmAligModel::calcBetaMatrix(unsigned int /*n*/,
 }
 
 //-------------------------
-void _incrHmmAligModel::calc_lanji(unsigned int n,
+void _incrHmmAligModel::calc_lanji(unsigned int mapped_n,
                                    const std::vector<WordIndex>& nsrcSent,
                                    const std::vector<WordIndex>& trgSent,
-                                   const Count& weight)
+                                   const Count& weight,
+                                   HmmEStepVars& vars)
 {
   PositionIndex slen=getSrcLen(nsrcSent);
 
         // Initialize data structures
-  unsigned int mapped_n;
-  lanji.init_nth_entry(n,nsrcSent.size(),trgSent.size(),mapped_n);
-
   unsigned int n_aux=1;
   unsigned int mapped_n_aux;
-  lanji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
+  vars.lanji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
 
   std::vector<double> numVec(nsrcSent.size()+1,0);
 
@@ -741,7 +860,7 @@ void _incrHmmAligModel::calc_lanji(unsigned int n,
     for(unsigned int i=1;i<=nsrcSent.size();++i)
     {
           // Obtain numerator
-      double d=calc_lanji_num(slen,i,j,nsrcSent,trgSent);
+      double d=calc_lanji_num(slen,i,j,nsrcSent,trgSent,vars);
 
           // Add contribution to sum
       if(sum_lanji_num_forall_s==INVALID_ANJI_VAL)
@@ -760,14 +879,14 @@ void _incrHmmAligModel::calc_lanji(unsigned int n,
       if(lanji_val>EXP_VAL_LOG_MAX) lanji_val=EXP_VAL_LOG_MAX;
       if(lanji_val<EXP_VAL_LOG_MIN) lanji_val=EXP_VAL_LOG_MIN;
           // Store expected value
-      lanji_aux.set_fast(mapped_n_aux,j,i,lanji_val);
+      vars.lanji_aux.set_fast(mapped_n_aux,j,i,lanji_val);
     }
   }
       // Gather lexical sufficient statistics
-  gatherLexSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight);
+  gatherLexSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight,vars);
 
       // clear lanji_aux data structure
-  lanji_aux.clear();
+  vars.lanji_aux.clear();
 }
 
 //-------------------------
@@ -777,13 +896,15 @@ void _incrHmmAligModel::calc_lanji_vit(unsigned int n,
                                        const std::vector<PositionIndex>& bestAlig,
                                        const Count& weight)
 {
+  HmmEStepVars& vars=getHmmEStepVars();
+
         // Initialize data structures
   unsigned int mapped_n;
   lanji.init_nth_entry(n,nsrcSent.size(),trgSent.size(),mapped_n);
 
   unsigned int n_aux=1;
   unsigned int mapped_n_aux;
-  lanji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
+  vars.lanji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
 
       // Calculate new estimation of lanji
   for(unsigned int j=1;j<=trgSent.size();++j)
@@ -796,16 +917,16 @@ void _incrHmmAligModel::calc_lanji_vit(unsigned int n,
             // Obtain expected value
         double lanji_val=0;
             // Store expected value
-        lanji_aux.set_fast(mapped_n_aux,j,i,lanji_val);
+        vars.lanji_aux.set_fast(mapped_n_aux,j,i,lanji_val);
       }
     }
   }
 
       // Gather lexical sufficient statistics
-  gatherLexSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight);
+  gatherLexSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight,vars);
 
       // clear lanji_aux data structure
-  lanji_aux.clear();
+  vars.lanji_aux.clear();
 }
 
 //-------------------------
@@ -813,7 +934,8 @@ void _incrHmmAligModel::gatherLexSuffStats(unsigned int mapped_n,
                                            unsigned int mapped_n_aux,
                                            const std::vector<WordIndex>& nsrcSent,
                                            const std::vector<WordIndex>& trgSent,
-                                           const Count& weight)
+                                           const Count& weight,
+                                           HmmEStepVars& vars)
 {
       // Gather lexical sufficient statistics
   for(unsigned int j=1;j<=trgSent.size();++j)
@@ -821,10 +943,10 @@ void _incrHmmAligModel::gatherLexSuffStats(unsigned int mapped_n,
     for(unsigned int i=1;i<=nsrcSent.size();++i)
     {
           // Reestimate lexical parameters
-      fillEmAuxVarsLex(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight);
+      fillEmAuxVarsLex(mapped_n,mapped_n_aux,i,j,nsrcSent,trgSent,weight,vars);
 
           // Update lanji
-      lanji.set_fast(mapped_n,j,i,lanji_aux.get_invlogp(mapped_n_aux,j,i));
+      lanji.set_fast(mapped_n,j,i,vars.lanji_aux.get_invlogp(mapped_n_aux,j,i));
     }
   }
 }
@@ -836,7 +958,8 @@ void _incrHmmAligModel::fillEmAuxVarsLex(unsigned int mapped_n,
                                          PositionIndex j,
                                          const std::vector<WordIndex>& nsrcSent,
                                          const std::vector<WordIndex>& trgSent,
-                                         const Count& weight)
+                                         const Count& weight,
+                                         HmmEStepVars& vars)
 {
       // Init vars
   float curr_lanji=lanji.get_fast(mapped_n,j,i);
@@ -848,48 +971,59 @@ void _incrHmmAligModel::fillEmAuxVarsLex(unsigned int mapped_n,
       weighted_curr_lanji=SMALL_LG_NUM;
   }
 
-  float weighted_new_lanji=(float)log((float)weight)+lanji_aux.get_invlogp_fast(mapped_n_aux,j,i);
+  float weighted_new_lanji=(float)log((float)weight)+vars.lanji_aux.get_invlogp_fast(mapped_n_aux,j,i);
   if(weighted_new_lanji<SMALL_LG_NUM)
     weighted_new_lanji=SMALL_LG_NUM;
 
-  WordIndex s=nsrcSent[i-1];
-  WordIndex t=trgSent[j-1];
+  LexContrib contrib;
+  contrib.s=nsrcSent[i-1];
+  contrib.t=trgSent[j-1];
+  contrib.weighted_curr_lanji=weighted_curr_lanji;
+  contrib.weighted_new_lanji=weighted_new_lanji;
 
       // Store contributions
-  while(lexAuxVar.size()<=s)
+  if(vars.bufferContribs)
+    vars.lexContribVec.push_back(contrib);
+  else
+    addLexContrib(contrib,vars.lexAuxVar);
+}
+
+//-------------------------
+void _incrHmmAligModel::addLexContrib(const LexContrib& contrib,
+                                      LexAuxVar& lexAuxVar)
+{
+  while(lexAuxVar.size()<=contrib.s)
   {
     LexAuxVarElem lexAuxVarElem;
     lexAuxVar.push_back(lexAuxVarElem);
   }
 
-  LexAuxVarElem::iterator lexAuxVarElemIter=lexAuxVar[s].find(t);
-  if(lexAuxVarElemIter!=lexAuxVar[s].end())
+  LexAuxVarElem::iterator lexAuxVarElemIter=lexAuxVar[contrib.s].find(contrib.t);
+  if(lexAuxVarElemIter!=lexAuxVar[contrib.s].end())
   {
-    if(weighted_curr_lanji!=SMALL_LG_NUM)
-      lexAuxVarElemIter->second.first=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.first,weighted_curr_lanji);
-    lexAuxVarElemIter->second.second=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.second,weighted_new_lanji);
+    if(contrib.weighted_curr_lanji!=SMALL_LG_NUM)
+      lexAuxVarElemIter->second.first=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.first,contrib.weighted_curr_lanji);
+    lexAuxVarElemIter->second.second=MathFuncs::lns_sumlog_float(lexAuxVarElemIter->second.second,contrib.weighted_new_lanji);
   }
   else
   {
-    lexAuxVar[s][t]=std::make_pair(weighted_curr_lanji,weighted_new_lanji);
+    lexAuxVar[contrib.s][contrib.t]=std::make_pair(contrib.weighted_curr_lanji,contrib.weighted_new_lanji);
   }
 }
 
 //-------------------------
-void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int n,
+void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int mapped_n,
                                            const std::vector<WordIndex>& nsrcSent,
                                            const std::vector<WordIndex>& trgSent,
-                                           const Count& weight)
+                                           const Count& weight,
+                                           HmmEStepVars& vars)
 {
   PositionIndex slen=getSrcLen(nsrcSent);
 
       // Initialize data structures
-  unsigned int mapped_n;
-  lanjm1ip_anji.init_nth_entry(n,nsrcSent.size(),trgSent.size(),mapped_n);
-
   unsigned int n_aux=1;
   unsigned int mapped_n_aux;
-  lanjm1ip_anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
+  vars.lanjm1ip_anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
 
   std::vector<double> numVec(nsrcSent.size()+1,0);
   std::vector<std::vector<double> > numVecVec(nsrcSent.size()+1,numVec);
@@ -913,10 +1047,10 @@ void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int n,
         if(nullAlig)
         {
           if(isFirstNullAligPar(0,slen,i))
-            d=calc_lanjm1ip_anji_num_je1(slen,i,nsrcSent,trgSent);
+            d=calc_lanjm1ip_anji_num_je1(slen,i,nsrcSent,trgSent,vars);
           else d=numVecVec[slen+1][0];
         }
-        else d=calc_lanjm1ip_anji_num_je1(slen,i,nsrcSent,trgSent);
+        else d=calc_lanjm1ip_anji_num_je1(slen,i,nsrcSent,trgSent,vars);
             // Add contribution to sum
         if(sum_lanjm1ip_anji_num_forall_i_ip==INVALID_ANJM1IP_ANJI_VAL)
           sum_lanjm1ip_anji_num_forall_i_ip=d;
@@ -940,7 +1074,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int n,
           }
           else
           {
-            d=calc_lanjm1ip_anji_num_jg1(ip,slen,i,j,nsrcSent,trgSent);
+            d=calc_lanjm1ip_anji_num_jg1(ip,slen,i,j,nsrcSent,trgSent,vars);
           }
               // Add contribution to sum
           if(sum_lanjm1ip_anji_num_forall_i_ip==INVALID_ANJM1IP_ANJI_VAL)
@@ -964,7 +1098,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int n,
         if(lanjm1ip_anji_val>EXP_VAL_LOG_MAX) lanjm1ip_anji_val=EXP_VAL_LOG_MAX;
         if(lanjm1ip_anji_val<EXP_VAL_LOG_MIN) lanjm1ip_anji_val=EXP_VAL_LOG_MIN;
             // Store expected value
-        lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,0,lanjm1ip_anji_val);
+        vars.lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,0,lanjm1ip_anji_val);
       }
       else
       {
@@ -979,17 +1113,17 @@ void _incrHmmAligModel::calc_lanjm1ip_anji(unsigned int n,
                 // Smooth expected value
             if(lanjm1ip_anji_val>EXP_VAL_LOG_MAX) lanjm1ip_anji_val=EXP_VAL_LOG_MAX;
             if(lanjm1ip_anji_val<EXP_VAL_LOG_MIN) lanjm1ip_anji_val=EXP_VAL_LOG_MIN;
-            lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,ip,lanjm1ip_anji_val);
+            vars.lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,ip,lanjm1ip_anji_val);
           }
         }
       }
     }
   }
       // Gather alignment sufficient statistics
-  gatherAligSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight);
+  gatherAligSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight,vars);
 
       // clear lanjm1ip_anji_aux data structure
-  lanjm1ip_anji_aux.clear();
+  vars.lanjm1ip_anji_aux.clear();
 }
 
 //-------------------------
@@ -999,6 +1133,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji_vit(unsigned int n,
                                                const std::vector<PositionIndex>& bestAlig,
                                                const Count& weight)
 {
+  HmmEStepVars& vars=getHmmEStepVars();
   PositionIndex slen=getSrcLen(nsrcSent);
 
       // Initialize data structures
@@ -1007,7 +1142,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji_vit(unsigned int n,
 
   unsigned int n_aux=1;
   unsigned int mapped_n_aux;
-  lanjm1ip_anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
+  vars.lanjm1ip_anji_aux.init_nth_entry(n_aux,nsrcSent.size(),trgSent.size(),mapped_n_aux);
 
       // Calculate new estimation of lanjm1ip_anji
   for(unsigned int j=1;j<=trgSent.size();++j)
@@ -1020,7 +1155,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji_vit(unsigned int n,
         {
           double lanjm1ip_anji_val=0;
               // Store expected value
-          lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,0,lanjm1ip_anji_val);
+          vars.lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,0,lanjm1ip_anji_val);
         }
       }
       else
@@ -1033,7 +1168,7 @@ void _incrHmmAligModel::calc_lanjm1ip_anji_vit(unsigned int n,
           {
             double lanjm1ip_anji_val=0;
                 // Store expected value
-            lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,ip,lanjm1ip_anji_val);
+            vars.lanjm1ip_anji_aux.set_fast(mapped_n_aux,j,i,ip,lanjm1ip_anji_val);
           }
         }
       }
@@ -1041,10 +1176,10 @@ void _incrHmmAligModel::calc_lanjm1ip_anji_vit(unsigned int n,
   }
 
       // Gather alignment sufficient statistics
-  gatherAligSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight);
+  gatherAligSuffStats(mapped_n,mapped_n_aux,nsrcSent,trgSent,weight,vars);
 
       // clear lanjm1ip_anji_aux data structure
-  lanjm1ip_anji_aux.clear();
+  vars.lanjm1ip_anji_aux.clear();
 }
 
 //-------------------------
@@ -1052,7 +1187,8 @@ void _incrHmmAligModel::gatherAligSuffStats(unsigned int mapped_n,
                                             unsigned int mapped_n_aux,
                                             const std::vector<WordIndex>& nsrcSent,
                                             const std::vector<WordIndex>& trgSent,
-                                            const Count& weight)
+                                            const Count& weight,
+                                            HmmEStepVars& vars)
 {
   PositionIndex slen=getSrcLen(nsrcSent);
 
@@ -1064,10 +1200,10 @@ void _incrHmmAligModel::gatherAligSuffStats(unsigned int mapped_n,
       if(j==1)
       {
             // Reestimate alignment parameters
-        fillEmAuxVarsAlig(mapped_n,mapped_n_aux,slen,0,i,j,weight);
+        fillEmAuxVarsAlig(mapped_n,mapped_n_aux,slen,0,i,j,weight,vars);
 
             // Update lanjm1ip_anji
-        lanjm1ip_anji.set_fast(mapped_n,j,i,0,lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,0));
+        lanjm1ip_anji.set_fast(mapped_n,j,i,0,vars.lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,0));
       }
       else
       {
@@ -1078,9 +1214,9 @@ void _incrHmmAligModel::gatherAligSuffStats(unsigned int mapped_n,
           if(validAlig)
           {
                 // Reestimate alignment parameters
-            fillEmAuxVarsAlig(mapped_n,mapped_n_aux,slen,ip,i,j,weight);
+            fillEmAuxVarsAlig(mapped_n,mapped_n_aux,slen,ip,i,j,weight,vars);
                 // Update lanjm1ip_anji
-            lanjm1ip_anji.set_fast(mapped_n,j,i,ip,lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,ip));
+            lanjm1ip_anji.set_fast(mapped_n,j,i,ip,vars.lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,ip));
           }
         }
       }
@@ -1095,7 +1231,8 @@ void _incrHmmAligModel::fillEmAuxVarsAlig(unsigned int mapped_n,
                                           PositionIndex ip,
                                           PositionIndex i,
                                           PositionIndex j,
-                                          const Count& weight)
+                                          const Count& weight,
+                                          HmmEStepVars& vars)
 {
       // Init vars
   float curr_lanjm1ip_anji=lanjm1ip_anji.get_fast(mapped_n,j,i,ip);
@@ -1107,26 +1244,39 @@ void _incrHmmAligModel::fillEmAuxVarsAlig(unsigned int mapped_n,
       weighted_curr_lanjm1ip_anji=SMALL_LG_NUM;
   }
 
-  float weighted_new_lanjm1ip_anji=(float)log((float)weight)+lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,ip);
+  float weighted_new_lanjm1ip_anji=(float)log((float)weight)+vars.lanjm1ip_anji_aux.get_invlogp_fast(mapped_n_aux,j,i,ip);
   if(weighted_new_lanjm1ip_anji<SMALL_LG_NUM)
     weighted_new_lanjm1ip_anji=SMALL_LG_NUM;
 
       // Init aSourceHmm data structure
-  aSourceHmm asHmm;
-  asHmm.prev_i=ip;
-  asHmm.slen=slen;
+  AligContrib contrib;
+  contrib.asHmm.prev_i=ip;
+  contrib.asHmm.slen=slen;
+  contrib.i=i;
+  contrib.weighted_curr_lanjm1ip_anji=weighted_curr_lanjm1ip_anji;
+  contrib.weighted_new_lanjm1ip_anji=weighted_new_lanjm1ip_anji;
 
       // Gather local suff. statistics
-  AligAuxVar::iterator aligAuxVarIter=aligAuxVar.find(std::make_pair(asHmm,i));
+  if(vars.bufferContribs)
+    vars.aligContribVec.push_back(contrib);
+  else
+    addAligContrib(contrib,vars.aligAuxVar);
+}
+
+//-------------------------
+void _incrHmmAligModel::addAligContrib(const AligContrib& contrib,
+                                       AligAuxVar& aligAuxVar)
+{
+  AligAuxVar::iterator aligAuxVarIter=aligAuxVar.find(std::make_pair(contrib.asHmm,contrib.i));
   if(aligAuxVarIter!=aligAuxVar.end())
   {
-    if(weighted_curr_lanjm1ip_anji!=SMALL_LG_NUM)
-      aligAuxVarIter->second.first=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.first,weighted_curr_lanjm1ip_anji);
-   aligAuxVarIter->second.second=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.second,weighted_new_lanjm1ip_anji);
+    if(contrib.weighted_curr_lanjm1ip_anji!=SMALL_LG_NUM)
+      aligAuxVarIter->second.first=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.first,contrib.weighted_curr_lanjm1ip_anji);
+   aligAuxVarIter->second.second=MathFuncs::lns_sumlog_float(aligAuxVarIter->second.second,contrib.weighted_new_lanjm1ip_anji);
   }
   else
   {
-    aligAuxVar[std::make_pair(asHmm,i)]=std::make_pair(weighted_curr_lanjm1ip_anji,weighted_new_lanjm1ip_anji);
+    aligAuxVar[std::make_pair(contrib.asHmm,contrib.i)]=std::make_pair(contrib.weighted_curr_lanjm1ip_anji,contrib.weighted_new_lanjm1ip_anji);
   }
 }
 
@@ -1154,9 +1304,10 @@ double _incrHmmAligModel::calc_lanji_num(PositionIndex slen,
                                          PositionIndex i,
                                          PositionIndex j,
                                          const std::vector<WordIndex>& nsrcSent,
-                                         const std::vector<WordIndex>& trgSent)
+                                         const std::vector<WordIndex>& trgSent,
+                                         HmmEStepVars& vars)
 {
-  double result=log_alpha(slen,i,j,nsrcSent,trgSent)+log_beta(slen,i,j,nsrcSent,trgSent);
+  double result=log_alpha(slen,i,j,nsrcSent,trgSent,vars)+log_beta(slen,i,j,nsrcSent,trgSent,vars);
   if(result<SMALL_LG_NUM) result=SMALL_LG_NUM;
   return result;
 }
@@ -1165,11 +1316,12 @@ double _incrHmmAligModel::calc_lanji_num(PositionIndex slen,
 double _incrHmmAligModel::calc_lanjm1ip_anji_num_je1(PositionIndex slen,
                                                      PositionIndex i,
                                                      const std::vector<WordIndex>& nsrcSent,
-                                                     const std::vector<WordIndex>& trgSent)
+                                                     const std::vector<WordIndex>& trgSent,
+                                                     HmmEStepVars& vars)
 {
-  double result=cached_logaProb(0,slen,i,nsrcSent,trgSent)+
-    cachedLexLogProbs[i][1]+
-    log_beta(slen,i,1,nsrcSent,trgSent);
+  double result=cached_logaProb(0,slen,i,nsrcSent,trgSent,vars)+
+    vars.cachedLexLogProbs[i][1]+
+    log_beta(slen,i,1,nsrcSent,trgSent,vars);
   if(result<SMALL_LG_NUM) result=SMALL_LG_NUM;
   return result;
 }
@@ -1180,12 +1332,13 @@ double _incrHmmAligModel::calc_lanjm1ip_anji_num_jg1(PositionIndex ip,
                                                      PositionIndex i,
                                                      PositionIndex j,
                                                      const std::vector<WordIndex>& nsrcSent,
-                                                     const std::vector<WordIndex>& trgSent)
+                                                     const std::vector<WordIndex>& trgSent,
+                                                     HmmEStepVars& vars)
 {
-  double result=log_alpha(slen,ip,j-1,nsrcSent,trgSent)+
-    cached_logaProb(ip,slen,i,nsrcSent,trgSent)+
-    cachedLexLogProbs[i][j]+
-    log_beta(slen,i,j,nsrcSent,trgSent);
+  double result=log_alpha(slen,ip,j-1,nsrcSent,trgSent,vars)+
+    cached_logaProb(ip,slen,i,nsrcSent,trgSent,vars)+
+    vars.cachedLexLogProbs[i][j]+
+    log_beta(slen,i,j,nsrcSent,trgSent,vars);
   if(result<SMALL_LG_NUM) result=SMALL_LG_NUM;
   return result;
 }
@@ -1258,9 +1411,10 @@ double _incrHmmAligModel::log_alpha(PositionIndex /*slen*/,
                                     PositionIndex i,
                                     PositionIndex j,
                                     const std::vector<WordIndex>& /*nsrcSent*/,
-                                    const std::vector<WordIndex>& /*trgSent*/)
+                                    const std::vector<WordIndex>& /*trgSent*/,
+                                    HmmEStepVars& vars)
 {
-  return alphaMatrix[i][j];
+  return vars.alphaMatrix[i][j];
 }
 
 //-------------------------
@@ -1268,14 +1422,17 @@ double _incrHmmAligModel::log_beta(PositionIndex /*slen*/,
                                    PositionIndex i,
                                    PositionIndex j,
                                    const std::vector<WordIndex>& /*nsrcSent*/,
-                                   const std::vector<WordIndex>& /*trgSent*/)
+                                   const std::vector<WordIndex>& /*trgSent*/,
+                                   HmmEStepVars& vars)
 {
-  return betaMatrix[i][j];
+  return vars.betaMatrix[i][j];
 }
 
 //-------------------------
 void _incrHmmAligModel::updateParsLex(void)
 {
+  LexAuxVar& lexAuxVar=getHmmEStepVars().lexAuxVar;
+
         // Update parameters
   for(unsigned int i=0;i<lexAuxVar.size();++i)
   {
@@ -1318,6 +1475,8 @@ void _incrHmmAligModel::updateParsLex(void)
 //-------------------------
 void _incrHmmAligModel::updateParsAlig(void)
 {
+  AligAuxVar& aligAuxVar=getHmmEStepVars().aligAuxVar;
+
       // Update parameters
   for(AligAuxVar::iterator aligAuxVarIter=aligAuxVar.begin();aligAuxVarIter!=aligAuxVar.end();++aligAuxVarIter)
   {
@@ -2008,16 +2167,31 @@ void _incrHmmAligModel::clear(void)
 {
   _swAligModel<std::vector<Prob> >::clear();
   lanji.clear();
-  lanji_aux.clear();
   lanjm1ip_anji.clear();
-  lanjm1ip_anji_aux.clear();
-  alphaMatrix.clear();
-  betaMatrix.clear();
+  getHmmEStepVars().lanji_aux.clear();
+  getHmmEStepVars().lanjm1ip_anji_aux.clear();
+  getHmmEStepVars().alphaMatrix.clear();
+  getHmmEStepVars().betaMatrix.clear();
   incrLexTable->clear();
   incrHmmAligTable.clear();
   sentLengthModel.clear();
 }
 
+//-------------------------
+void _incrHmmAligModel::HmmEStepVars::clear(void)
+{
+  lanji_aux.clear();
+  lanjm1ip_anji_aux.clear();
+  alphaMatrix.clear();
+  betaMatrix.clear();
+  lexAuxVar.clear();
+  cachedLexLogProbs.clear();
+  aligAuxVar.clear();
+  cachedAligLogProbs.clear();
+  lexContribVec.clear();
+  aligContribVec.clear();
+}
+
 //-------------------------
 void _incrHmmAligModel::clearTempVars(void)
 {
@@ -78,8 +78,11 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
    typedef _incrSwAligModel<std::vector<Prob> >::PpInfo PpInfo;
    typedef std::map<WordIndex,Prob> SrcTableNode;
 
-   // Constructor
+   // Constructors
    _incrHmmAligModel();
+   _incrHmmAligModel(const _incrHmmAligModel& other);
+       // The table of lexical parameters is not copied, derived classes
+       // are in charge of creating it
 
    void set_expval_maxnsize(unsigned int _expval_maxnsize);
        // Function to set a maximum size for the matrices of expected
@@ -204,24 +207,49 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
   protected:
 
    anjiMatrix lanji;
-   anjiMatrix lanji_aux;
    anjm1ip_anjiMatrix lanjm1ip_anji;
-   anjm1ip_anjiMatrix lanjm1ip_anji_aux;
-   std::vector<std::vector<double> > alphaMatrix;
-   std::vector<std::vector<double> > betaMatrix;
        // Data structures for manipulating expected values
 
    std::string lexNumDenFileExtension;
        // Extensions for input files for loading
 
-   LexAuxVar lexAuxVar;
-   std::vector<std::vector<double> > cachedLexLogProbs;
-       // EM algorithm auxiliary variables
-
    typedef hash_map<std::pair<aSourceHmm,PositionIndex>,std::pair<float,float>,ashPidxPairHashF> AligAuxVar;
-   AligAuxVar aligAuxVar;
-   CachedHmmAligLgProb cachedAligLogProbs;
-       // EM algorithm auxiliary variables
+
+       // Contributions of a sentence pair to the sufficient statistics
+   struct LexContrib
+   {
+     WordIndex s;
+     WordIndex t;
+     float weighted_curr_lanji;
+     float weighted_new_lanji;
+   };
+   struct AligContrib
+   {
+     aSourceHmm asHmm;
+     PositionIndex i;
+     float weighted_curr_lanjm1ip_anji;
+     float weighted_new_lanjm1ip_anji;
+   };
+
+       // Variables used to gather sufficient statistics
+   class HmmEStepVars: public EStepVars
+   {
+    public:
+     anjiMatrix lanji_aux;
+     anjm1ip_anjiMatrix lanjm1ip_anji_aux;
+     std::vector<std::vector<double> > alphaMatrix;
+     std::vector<std::vector<double> > betaMatrix;
+         // Data structures for manipulating expected values
+     LexAuxVar lexAuxVar;
+     std::vector<std::vector<double> > cachedLexLogProbs;
+     AligAuxVar aligAuxVar;
+     CachedHmmAligLgProb cachedAligLogProbs;
+         // EM algorithm auxiliary variables
+     std::vector<LexContrib> lexContribVec;
+     std::vector<AligContrib> aligContribVec;
+
+     void clear(void);
+   };
 
    _incrLexTable* incrLexTable;
        // Pointer to table with lexical parameters
@@ -275,7 +303,8 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
                           PositionIndex slen,
                           PositionIndex i,
                           const std::vector<WordIndex>& nsrcSent,
-                          const std::vector<WordIndex>& trgSent);
+                          const std::vector<WordIndex>& trgSent,
+                          HmmEStepVars& vars);
    void nullAligSpecialPar(unsigned int ip,
                            unsigned int slen,
                            aSourceHmm& asHmm,
@@ -332,14 +361,17 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
                                  int verbosity=0);
    void calcAlphaMatrix(unsigned int n,
                         const std::vector<WordIndex>& nsrcSent,
-                        const std::vector<WordIndex>& trgSent);
+                        const std::vector<WordIndex>& trgSent,
+                        HmmEStepVars& vars);
    void calcBetaMatrix(unsigned int n,
                        const std::vector<WordIndex>& nsrcSent,
-                       const std::vector<WordIndex>& trgSent);
-   void calc_lanji(unsigned int n,
+                       const std::vector<WordIndex>& trgSent,
+                       HmmEStepVars& vars);
+   void calc_lanji(unsigned int mapped_n,
                    const std::vector<WordIndex>& nsrcSent,
                    const std::vector<WordIndex>& trgSent,
-                   const Count& weight);
+                   const Count& weight,
+                   HmmEStepVars& vars);
    void calc_lanji_vit(unsigned int n,
                        const std::vector<WordIndex>& nsrcSent,
                        const std::vector<WordIndex>& trgSent,
@@ -351,11 +383,15 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
                          PositionIndex j,
                          const std::vector<WordIndex>& nsrcSent,
                          const std::vector<WordIndex>& trgSent,
-                         const Count& weight);
-   void calc_lanjm1ip_anji(unsigned int n,
+                         const Count& weight,
+                         HmmEStepVars& vars);
+   void addLexContrib(const LexContrib& contrib,
+                      LexAuxVar& lexAuxVar);
+   void calc_lanjm1ip_anji(unsigned int mapped_n,
                            const std::vector<WordIndex>& nsrcSent,
                            const std::vector<WordIndex>& trgSent,
-                           const Count& weight);
+                           const Count& weight,
+                           HmmEStepVars& vars);
    void calc_lanjm1ip_anji_vit(unsigned int n,
                                const std::vector<WordIndex>& nsrcSent,
                                const std::vector<WordIndex>& trgSent,
@@ -368,34 +404,42 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
                          PositionIndex i,
                          PositionIndex j,
                          const std::vector<WordIndex>& nsrcSent,
-                         const std::vector<WordIndex>& trgSent);
+                         const std::vector<WordIndex>& trgSent,
+                         HmmEStepVars& vars);
    double calc_lanjm1ip_anji_num_je1(PositionIndex slen,
                                      PositionIndex i,
                                      const std::vector<WordIndex>& nsrcSent,
-                                     const std::vector<WordIndex>& trgSent);
+                                     const std::vector<WordIndex>& trgSent,
+                                     HmmEStepVars& vars);
    double calc_lanjm1ip_anji_num_jg1(PositionIndex ip,
                                      PositionIndex slen,
                                      PositionIndex i,
                                      PositionIndex j,
                                      const std::vector<WordIndex>& nsrcSent,
-                                     const std::vector<WordIndex>& trgSent);
+                                     const std::vector<WordIndex>& trgSent,
+                                     HmmEStepVars& vars);
    void gatherLexSuffStats(unsigned int mapped_n,
                            unsigned int mapped_n_aux,
                            const std::vector<WordIndex>& nsrcSent,
                            const std::vector<WordIndex>& trgSent,
-                           const Count& weight);
+                           const Count& weight,
+                           HmmEStepVars& vars);
    void gatherAligSuffStats(unsigned int mapped_n,
                             unsigned int mapped_n_aux,
                             const std::vector<WordIndex>& nsrcSent,
                             const std::vector<WordIndex>& trgSent,
-                            const Count& weight);
+                            const Count& weight,
+                            HmmEStepVars& vars);
    void fillEmAuxVarsAlig(unsigned int mapped_n,
                           unsigned int mapped_n_aux,
                           PositionIndex slen,
                           PositionIndex ip,
                           PositionIndex i,
                           PositionIndex j,
-                          const Count& weight);
+                          const Count& weight,
+                          HmmEStepVars& vars);
+   void addAligContrib(const AligContrib& contrib,
+                       AligAuxVar& aligAuxVar);
    void getHmmAligInfo(PositionIndex ip,
                        unsigned int slen,
                        PositionIndex i,
@@ -413,17 +457,31 @@ class _incrHmmAligModel: public _incrSwAligModel<std::vector<Prob> >
                     PositionIndex i,
                     PositionIndex j,
                     const std::vector<WordIndex>& nsrcSent,
-                    const std::vector<WordIndex>& trgSent);
+                    const std::vector<WordIndex>& trgSent,
+                    HmmEStepVars& vars);
    double log_beta(PositionIndex slen,
                    PositionIndex i,
                    PositionIndex j,
                    const std::vector<WordIndex>& nsrcSent,
-                   const std::vector<WordIndex>& trgSent);
+                   const std::vector<WordIndex>& trgSent,
+                   HmmEStepVars& vars);
    void updateParsLex(void);
    void updateParsAlig(void);
    virtual float obtainLogNewSuffStat(float lcurrSuffStat,
                                       float lLocalSuffStatCurr,
                                       float lLocalSuffStatNew);
+
+   // Functions to gather sufficient statistics in parallel
+   HmmEStepVars& getHmmEStepVars(void);
+   EStepVars* createEStepVars(void);
+   unsigned int getExpValMaxNSize(void);
+   bool initEStepSentPair(unsigned int n,
+                          EStepSentPair& sentPair,
+                          int verbosity);
+   void calcEStepSentPair(const EStepSentPair& sentPair,
+                          EStepVars& vars);
+   void accumulateEStepContribs(EStepVars& vars);
+   void mergeEStepVars(EStepVars& vars);
 };
 
 #endif
@@ -35,9 +35,13 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #endif /* HAVE_CONFIG_H */
 
 #include "_swAligModel.h"
+#include "WorkerThreadPool.h"
 
 //--------------- Constants ------------------------------------------
 
+#define SW_ESTEP_BLOCK_SIZE         1024
+#define SW_ESTEP_TASKS_PER_THREAD   4
+
 
 //--------------- typedefs -------------------------------------------
 
@@ -57,6 +61,12 @@ class _incrSwAligModel: public _swAligModel<PPINFO>
 
   typedef typename _swAligModel<PPINFO>::PpInfo PpInfo;
 
+  // Constructors
+  _incrSwAligModel(void);
+  _incrSwAligModel(const _incrSwAligModel& other);
+      // The variables of the E step are not copied, they are created
+      // again when needed
+
   virtual void set_expval_maxnsize(unsigned int _anji_maxnsize)=0;
       // Function to set a maximum size for the vector of expected
       // values anji (by default the size is not restricted)
@@ -64,10 +74,120 @@ class _incrSwAligModel: public _swAligModel<PPINFO>
   virtual void efficientBatchTrainingForRange(std::pair<unsigned int,unsigned int> sentPairRange,
                                               int verbosity=0);
   void efficientBatchTrainingForAllSents(int verbosity=0);
+
+  // Functions to gather sufficient statistics in parallel
+  void setNumEStepThreads(unsigned int numThreads);
+      // Set the number of threads used in the E step (1 by default)
+  void setDeterministicEStep(bool deterministic);
+      // If true, the contributions of the sentence pairs are
+      // accumulated in the same order as in a sequential execution,
+      // giving exactly the same parameters at the expense of speed.
+      // Otherwise, the statistics of each task are merged in order of
+      // task, the result does not depend on thread scheduling but
+      // has rounding differences with respect to the sequential one
+
+  // Destructor
+  virtual ~_incrSwAligModel();
+
+ protected:
+
+      // Variables used to gather sufficient statistics. Each task of
+      // the parallel E step works with its own instance. If
+      // bufferContribs is true, the contributions of the sentence
+      // pairs are stored instead of being accumulated
+  class EStepVars
+  {
+   public:
+    bool bufferContribs;
+
+    EStepVars(void){bufferContribs=false;}
+    virtual void clear(void)=0;
+    virtual ~EStepVars(){}
+  };
+
+      // Sentence pair prepared to be processed in the E step
+  struct EStepSentPair
+  {
+    std::vector<WordIndex> nsrcSent;
+    std::vector<WordIndex> nsrcSentAlig;
+    std::vector<WordIndex> trgSent;
+    Count weight;
+    unsigned int mapped_n;
+    unsigned int mapped_n_alig;
+  };
+
+  WorkerThreadPool eStepThreadPool;
+  bool deterministicEStep;
+  EStepVars* eStepVarsPtr;
+      // Variables used by the sequential E step, they also store the
+      // result of the parallel one
+  std::vector<EStepVars*> eStepTaskVarsVec;
+      // Variables used by each task of the parallel E step
+
+  EStepVars& getEStepVars(void);
+  bool eStepIsParallel(std::pair<unsigned int,unsigned int> sentPairRange);
+  void calcNewLocalSuffStatsParallel(std::pair<unsigned int,unsigned int> sentPairRange,
+                                     int verbosity);
+      // Gather sufficient statistics for the given range in blocks of
+      // sentence pairs. The pairs of each block are prepared
+      // sequentially (vocabulary and matrices of expected values are
+      // updated there) and then split into a fixed number of tasks
+      // executed by the threads, whose statistics are added to the
+      // variables returned by getEStepVars() in order of task
+  void releaseEStepVars(void);
+
+  // Functions that the models implement to support the parallel E step
+  virtual EStepVars* createEStepVars(void)=0;
+  virtual unsigned int getExpValMaxNSize(void)=0;
+      // Returns the maximum size of the matrices of expected values,
+      // the pairs of a block cannot exceed it
+  virtual bool initEStepSentPair(unsigned int n,
+                                 EStepSentPair& sentPair,
+                                 int verbosity)=0;
+      // Sequential preparation of the n'th sentence pair, returns false
+      // if the pair should be discarded
+  virtual void calcEStepSentPair(const EStepSentPair& sentPair,
+                                 EStepVars& vars)=0;
+      // Gather sufficient statistics for a prepared sentence pair, it
+      // is executed concurrently with different vars
+  virtual void accumulateEStepContribs(EStepVars& vars)=0;
+      // Accumulate the contributions buffered in vars into the
+      // variables returned by getEStepVars()
+  virtual void mergeEStepVars(EStepVars& vars)=0;
+      // Merge the statistics accumulated in vars into the variables
+      // returned by getEStepVars()
+
+ private:
+
+  struct EStepTaskData
+  {
+    _incrSwAligModel<PPINFO>* modelPtr;
+    const std::vector<EStepSentPair>* sentPairVecPtr;
+    unsigned int numTasks;
+  };
+  static void eStepTask(void* data,
+                        unsigned int taskIdx,
+                        unsigned int workerIdx);
 };
 
 //--------------- _incrSwAligModel class method definitions
 
+//-------------------------
+template<class PPINFO>
+_incrSwAligModel<PPINFO>::_incrSwAligModel(void)
+{
+  deterministicEStep=false;
+  eStepVarsPtr=NULL;
+}
+
+//-------------------------
+template<class PPINFO>
+_incrSwAligModel<PPINFO>::_incrSwAligModel(const _incrSwAligModel& other):_swAligModel<PPINFO>(other),eStepThreadPool(other.eStepThreadPool)
+{
+  deterministicEStep=other.deterministicEStep;
+  eStepVarsPtr=NULL;
+}
+
 //-------------------------
 template<class PPINFO>
 void _incrSwAligModel<PPINFO>::efficientBatchTrainingForRange(std::pair<unsigned int,unsigned int> /*sentPairRange*/,
@@ -83,6 +203,130 @@ void _incrSwAligModel<PPINFO>::efficientBatchTrainingForAllSents(int verbosity/*
   efficientBatchTrainingForRange(std::make_pair(0,this->numSentPairs()-1),verbosity);
 }
 
+//-------------------------
+template<class PPINFO>
+void _incrSwAligModel<PPINFO>::setNumEStepThreads(unsigned int numThreads)
+{
+  eStepThreadPool.setNumThreads(numThreads);
+}
+
+//-------------------------
+template<class PPINFO>
+void _incrSwAligModel<PPINFO>::setDeterministicEStep(bool deterministic)
+{
+  deterministicEStep=deterministic;
+}
+
+//-------------------------
+template<class PPINFO>
+typename _incrSwAligModel<PPINFO>::EStepVars& _incrSwAligModel<PPINFO>::getEStepVars(void)
+{
+  if(eStepVarsPtr==NULL)
+    eStepVarsPtr=createEStepVars();
+  return *eStepVarsPtr;
+}
+
+//-------------------------
+template<class PPINFO>
+bool _incrSwAligModel<PPINFO>::eStepIsParallel(std::pair<unsigned int,unsigned int> sentPairRange)
+{
+  return eStepThreadPool.getNumThreads()>1 && sentPairRange.second>sentPairRange.first;
+}
+
+//-------------------------
+template<class PPINFO>
+void _incrSwAligModel<PPINFO>::calcNewLocalSuffStatsParallel(std::pair<unsigned int,unsigned int> sentPairRange,
+                                                             int verbosity)
+{
+      // Two pairs of the same block cannot share an entry of the
+      // matrices of expected values
+  unsigned int blockSize=SW_ESTEP_BLOCK_SIZE;
+  unsigned int maxnsize=getExpValMaxNSize();
+  if(maxnsize>0 && maxnsize<blockSize)
+    blockSize=maxnsize;
+
+      // Obtain variables for the tasks. The number of tasks only
+      // depends on the number of threads, so the statistics are merged
+      // in the same way in every EM iteration
+  unsigned int numTasks=eStepThreadPool.getNumThreads()*SW_ESTEP_TASKS_PER_THREAD;
+  getEStepVars();
+  while(eStepTaskVarsVec.size()<numTasks)
+    eStepTaskVarsVec.push_back(createEStepVars());
+  for(unsigned int i=0;i<eStepTaskVarsVec.size();++i)
+    eStepTaskVarsVec[i]->bufferContribs=deterministicEStep;
+
+      // Process blocks of sentence pairs
+  std::vector<EStepSentPair> sentPairVec;
+  unsigned int n=sentPairRange.first;
+  while(n<=sentPairRange.second)
+  {
+        // Prepare sentence pairs of block
+    sentPairVec.clear();
+    unsigned int numPrepared=0;
+    while(numPrepared<blockSize && n<=sentPairRange.second)
+    {
+      sentPairVec.resize(sentPairVec.size()+1);
+      if(!initEStepSentPair(n,sentPairVec.back(),verbosity))
+        sentPairVec.pop_back();
+      ++numPrepared;
+      ++n;
+    }
+
+        // Gather sufficient statistics
+    EStepTaskData taskData;
+    taskData.modelPtr=this;
+    taskData.sentPairVecPtr=&sentPairVec;
+    taskData.numTasks=numTasks;
+    eStepThreadPool.run(numTasks,&eStepTask,(void*)&taskData);
+
+        // Add statistics of the tasks
+    for(unsigned int i=0;i<numTasks;++i)
+    {
+      if(deterministicEStep)
+        accumulateEStepContribs(*eStepTaskVarsVec[i]);
+      else
+        mergeEStepVars(*eStepTaskVarsVec[i]);
+      eStepTaskVarsVec[i]->clear();
+    }
+  }
+}
+
+//-------------------------
+template<class PPINFO>
+void _incrSwAligModel<PPINFO>::eStepTask(void* data,
+                                         unsigned int taskIdx,
+                                         unsigned int /*workerIdx*/)
+{
+  EStepTaskData* taskDataPtr=(EStepTaskData*) data;
+  _incrSwAligModel<PPINFO>* modelPtr=taskDataPtr->modelPtr;
+  const std::vector<EStepSentPair>& sentPairVec=*taskDataPtr->sentPairVecPtr;
+  EStepVars& vars=*modelPtr->eStepTaskVarsVec[taskIdx];
+
+      // Process the contiguous portion of the block assigned to the task
+  size_t begin=(sentPairVec.size()*taskIdx)/taskDataPtr->numTasks;
+  size_t end=(sentPairVec.size()*(taskIdx+1))/taskDataPtr->numTasks;
+  for(size_t i=begin;i<end;++i)
+    modelPtr->calcEStepSentPair(sentPairVec[i],vars);
+}
+
+//-------------------------
+template<class PPINFO>
+void _incrSwAligModel<PPINFO>::releaseEStepVars(void)
+{
+  for(unsigned int i=0;i<eStepTaskVarsVec.size();++i)
+    delete eStepTaskVarsVec[i];
+  eStepTaskVarsVec.clear();
+  delete eStepVarsPtr;
+  eStepVarsPtr=NULL;
+}
+
+//-------------------------
+template<class PPINFO>
+_incrSwAligModel<PPINFO>::~_incrSwAligModel()
+{
+  releaseEStepVars();
+}
+
 //-------------------------
 
 #endif
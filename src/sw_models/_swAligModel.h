@@ -122,6 +122,20 @@ class _swAligModel: public BaseSwAligModel<PPINFO>
 	SingleWordVocab swVocab;
 
     LightSentenceHandler sentenceHandler;
+
+        // Map the identifiers of the binary corpus (if any) to word
+        // indices, entries equal to UNK_WORD have not been resolved yet
+    std::vector<WordIndex> binCorpusSrcWidxVec;
+    std::vector<WordIndex> binCorpusTrgWidxVec;
+
+        // Obtain sentence n of a binary corpus without string
+        // conversions, they return false if n is not stored in a
+        // binary corpus
+    bool getBinCorpusSrcSent(unsigned int n,
+                             std::vector<WordIndex>& srcSent);
+    bool getBinCorpusTrgSent(unsigned int n,
+                             std::vector<WordIndex>& trgSent);
+    void clearBinCorpusMaps(void);
 };
 
 //--------------- _swAligModel class method definitions
@@ -139,6 +153,7 @@ bool _swAligModel<PPINFO>::readSentencePairs(const char *srcFileName,
                                              const char *sentCountsFile,
                                              std::pair<unsigned int,unsigned int>& sentRange)
 {
+  clearBinCorpusMaps();
   return sentenceHandler.readSentencePairs(srcFileName,trgFileName,sentCountsFile,sentRange);
 }
 
@@ -173,6 +188,7 @@ int _swAligModel<PPINFO>::nthSentPair(unsigned int n,
 template<class PPINFO>
 bool _swAligModel<PPINFO>::loadGIZASrcVocab(const char *srcInputVocabFileName)
 {
+ clearBinCorpusMaps();
  return swVocab.loadGIZASrcVocab(srcInputVocabFileName);
 }
 
@@ -180,6 +196,7 @@ bool _swAligModel<PPINFO>::loadGIZASrcVocab(const char *srcInputVocabFileName)
 template<class PPINFO>
 bool _swAligModel<PPINFO>::loadGIZATrgVocab(const char *trgInputVocabFileName)
 {
+ clearBinCorpusMaps();
  return swVocab.loadGIZATrgVocab(trgInputVocabFileName);
 }
 
@@ -295,6 +312,75 @@ void _swAligModel<PPINFO>::clear(void)
 {
  swVocab.clear();
  sentenceHandler.clear();
+ clearBinCorpusMaps();
+}
+
+//-------------------------
+template<class PPINFO>
+bool _swAligModel<PPINFO>::getBinCorpusSrcSent(unsigned int n,
+                                               std::vector<WordIndex>& srcSent)
+{
+  const BinParallelCorpus* binCorpusPtr=sentenceHandler.getBinCorpusForSent(n);
+  if(binCorpusPtr==NULL)
+    return false;
+
+  std::vector<BinCorpusWordId> idVec;
+  binCorpusPtr->getSrcSent(n,idVec);
+  if(binCorpusSrcWidxVec.size()!=binCorpusPtr->getSrcVocabSize())
+    binCorpusSrcWidxVec.assign(binCorpusPtr->getSrcVocabSize(),UNK_WORD);
+  srcSent.resize(idVec.size());
+  for(unsigned int i=0;i<idVec.size();++i)
+  {
+    WordIndex& widx=binCorpusSrcWidxVec[idVec[i]];
+    if(widx==UNK_WORD)
+    {
+          // Words are added in order of appearance, as it is done for
+          // text corpora
+      const std::string& word=binCorpusPtr->srcWordIdToString(idVec[i]);
+      widx=stringToSrcWordIndex(word);
+      if(widx==UNK_WORD)
+        widx=addSrcSymbol(word);
+    }
+    srcSent[i]=widx;
+  }
+  return true;
+}
+
+//-------------------------
+template<class PPINFO>
+bool _swAligModel<PPINFO>::getBinCorpusTrgSent(unsigned int n,
+                                               std::vector<WordIndex>& trgSent)
+{
+  const BinParallelCorpus* binCorpusPtr=sentenceHandler.getBinCorpusForSent(n);
+  if(binCorpusPtr==NULL)
+    return false;
+
+  std::vector<BinCorpusWordId> idVec;
+  binCorpusPtr->getTrgSent(n,idVec);
+  if(binCorpusTrgWidxVec.size()!=binCorpusPtr->getTrgVocabSize())
+    binCorpusTrgWidxVec.assign(binCorpusPtr->getTrgVocabSize(),UNK_WORD);
+  trgSent.resize(idVec.size());
+  for(unsigned int i=0;i<idVec.size();++i)
+  {
+    WordIndex& widx=binCorpusTrgWidxVec[idVec[i]];
+    if(widx==UNK_WORD)
+    {
+      const std::string& word=binCorpusPtr->trgWordIdToString(idVec[i]);
+      widx=stringToTrgWordIndex(word);
+      if(widx==UNK_WORD)
+        widx=addTrgSymbol(word);
+    }
+    trgSent[i]=widx;
+  }
+  return true;
+}
+
+//-------------------------
+template<class PPINFO>
+void _swAligModel<PPINFO>::clearBinCorpusMaps(void)
+{
+  binCorpusSrcWidxVec.clear();
+  binCorpusTrgWidxVec.clear();
 }
 
 //-------------------------
@@ -0,0 +1,140 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file thot_gen_bin_corpus.cc
+ *
+ * @brief Converts a parallel corpus in text format into a binary
+ * corpus that can be given to thot_gen_sw_model.
+ */
+
+//--------------- Include files --------------------------------------
+
+#include <iostream>
+#include <stdio.h>
+#include "options.h"
+#include "BinParallelCorpus.h"
+
+//--------------- Function Declarations ------------------------------
+
+int TakeParameters(int argc,char *argv[]);
+void printUsage(void);
+void printDesc(void);
+
+//--------------- Global variables -----------------------------------
+
+std::string srcFileName;
+std::string trgFileName;
+std::string countsFileName;
+std::string outFileName;
+bool varint;
+int verbose;
+
+//--------------- Function Definitions -------------------------------
+
+//--------------- main function
+int main(int argc,char *argv[])
+{
+  if(TakeParameters(argc,argv)==THOT_OK)
+  {
+    return BinParallelCorpus::create(srcFileName.c_str(),
+                                     trgFileName.c_str(),
+                                     countsFileName.c_str(),
+                                     outFileName.c_str(),
+                                     varint,
+                                     verbose);
+  }
+  else return THOT_ERROR;
+}
+
+//--------------- TakeParameters function
+int TakeParameters(int argc,char *argv[])
+{
+ int err;
+
+ if(argc==1)
+ {
+   printDesc();
+   return THOT_ERROR;
+ }
+
+     /* Verify --help option */
+ err=readOption(argc,argv,"--help");
+ if(err!=-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+     /* Take the file names */
+ err=readSTLstring(argc,argv, "-s", &srcFileName);
+ if(err==-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+ err=readSTLstring(argc,argv, "-t", &trgFileName);
+ if(err==-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+ err=readSTLstring(argc,argv, "-o", &outFileName);
+ if(err==-1)
+ {
+   printUsage();
+   return THOT_ERROR;
+ }
+
+ err=readSTLstring(argc,argv, "-c", &countsFileName);
+ if(err==-1)
+   countsFileName="";
+
+     /* Take options */
+ varint=(readOption(argc,argv,"-z")!=-1);
+ verbose=(readOption(argc,argv,"-v")!=-1);
+
+ return THOT_OK;
+}
+
+//--------------- printDesc() function
+void printDesc(void)
+{
+  printf("thot_gen_bin_corpus written by Daniel Ortiz\n");
+  printf("A tool to convert a parallel corpus into binary format\n");
+  printf("type \"thot_gen_bin_corpus --help\" to get usage information.\n");
+}
+
+//--------------- printUsage() function
+void printUsage(void)
+{
+  printf("Usage: thot_gen_bin_corpus -s <string> -t <string> [-c <string>]\n");
+  printf("                           -o <string> [-z] [-v] [--help]\n\n");
+  printf("-s <string>               File with source sentences.\n");
+  printf("-t <string>               File with target sentences.\n");
+  printf("-c <string>               File with sentence pair counts.\n");
+  printf("-o <string>               Output file with the binary corpus.\n");
+  printf("-z                        Compress word identifiers using variable-length\n");
+  printf("                          integers.\n");
+  printf("-v                        Verbose mode.\n");
+  printf("--help                    Display this help and exit.\n\n");
+}
+
+//--------------------------------
@@ -35,6 +35,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 #include "_incrSwAligModel.h"
 #include "BaseStepwiseAligModel.h"
 #include "BaseSwAligModel.h"
+#include "BinParallelCorpus.h"
 #include "thot_gen_sw_model_pars.h"
 #include "DynClassFileHandler.h"
 #include "SimpleDynClassLoader.h"
@@ -173,6 +174,13 @@ int processParameters(thot_gen_sw_model_pars pars)
     if(pars.r_given)
     {
       _incrSwAligModelPtr->set_expval_maxnsize(pars.r);
+    }
+
+        // Set number of threads used to gather sufficient statistics
+    if(pars.nt_given)
+    {
+      _incrSwAligModelPtr->setNumEStepThreads(pars.nt);
+      _incrSwAligModelPtr->setDeterministicEStep(pars.dt_given);
     }
   }
 
@@ -719,6 +727,38 @@ int takeParameters(int argc,
       }
     }
 
+        // -nt parameter
+    if(argv_stl[i]=="-nt" && !matched)
+    {
+      pars.nt_given=true;
+      if(i==argc-1)
+      {
+        std::cerr<<"Error: no value for -nt parameter."<<std::endl;
+        return THOT_ERROR;
+      }
+      else
+      {
+            // Parse value as a signed integer, negative values would
+            // wrap around when stored in pars.nt
+        int nt=atoi(argv_stl[i+1].c_str());
+        if(nt<=0)
+        {
+          std::cerr<<"Error: value of -nt parameter should be greater than zero"<<std::endl;
+          return THOT_ERROR;
+        }
+        pars.nt=nt;
+        ++matched;
+        ++i;
+      }
+    }
+
+        // -dt parameter
+    if(argv_stl[i]=="-dt" && !matched)
+    {
+      pars.dt_given=true;
+      ++matched;
+    }
+
         // -o parameter
     if(argv_stl[i]=="-o" && !matched)
     {
@@ -772,7 +812,7 @@ int checkParameters(thot_gen_sw_model_pars& pars)
       return THOT_ERROR;
     }
 
-    if(!pars.t_given)
+    if(!pars.t_given && !BinParallelCorpus::isBinCorpusFile(pars.s_str.c_str()))
     {
       std::cerr<<"Error: -t parameter not given!"<<std::endl;
       return THOT_ERROR;
@@ -832,6 +872,18 @@ int checkParameters(thot_gen_sw_model_pars& pars)
     std::cerr<<"Error: parameter -in cannot be used without -i parameter"<<std::endl;
     return THOT_ERROR;
   }
+
+  if(pars.nt_given && pars.nt==0)
+  {
+    std::cerr<<"Error: value of -nt parameter should be greater than zero"<<std::endl;
+    return THOT_ERROR;
+  }
+
+  if(pars.dt_given && !pars.nt_given)
+  {
+    std::cerr<<"Error: parameter -dt cannot be used without -nt parameter"<<std::endl;
+    return THOT_ERROR;
+  }
   
       // Check invalid options when using non-incremental sw models
   if(init_swm(false)==THOT_ERROR)
@@ -840,10 +892,10 @@ int checkParameters(thot_gen_sw_model_pars& pars)
   _incrSwAligModel<std::vector<Prob> >* _incrSwAligModelPtr=dynamic_cast<_incrSwAligModel<std::vector<Prob> >*>(swAligModelPtr);
   if(!_incrSwAligModelPtr)
   {
-    if(pars.eb_given || pars.i_given || pars.c_given || pars.r_given || pars.mb_given || pars.in_given)
+    if(pars.eb_given || pars.i_given || pars.c_given || pars.r_given || pars.mb_given || pars.in_given || pars.nt_given)
     {
       release_swm(false);
-      std::cerr<<"Error: parameters -eb, -mb, -i, -c, -r and -in cannot be used with non-incremental single word models"<<std::endl;
+      std::cerr<<"Error: parameters -eb, -mb, -i, -c, -r, -in and -nt cannot be used with non-incremental single word models"<<std::endl;
       return THOT_ERROR;
     }
   }
@@ -883,6 +935,9 @@ void printParameters(thot_gen_sw_model_pars pars)
     std::cerr<<"-lf: "<<pars.lf_val<<std::endl;
   if(pars.af_given)
     std::cerr<<"-af: "<<pars.af_val<<std::endl;
+  if(pars.nt_given)
+    std::cerr<<"-nt: "<<pars.nt<<std::endl;
+  std::cerr<<"-dt: "<<pars.dt_given<<std::endl;
   std::cerr<<"Output files prefix: "<<pars.o_str<<std::endl;
   std::cerr<<"-v: "<<pars.v_given<<std::endl;
   std::cerr<<"-v1: "<<pars.v1_given<<std::endl;
@@ -896,9 +951,12 @@ void printUsage(void)
   std::cerr<<"                      [-eb | -mb <int> [-lr <int> [<float1>...<floatn>] ] \n";
   std::cerr<<"                      | -i [-c] [-r <int> [-in]] ]\n";
   std::cerr<<"                      [-np <float>] [-lf <float>] [-af <float>]\n";
-  std::cerr<<"                      -o <string>\n";
+  std::cerr<<"                      [-nt <int> [-dt]] -o <string>\n";
   std::cerr<<"                      [-v|-v1] [--help] [--version]\n\n";
   std::cerr<<"-s <string>           File with source training sentences.\n";
+  std::cerr<<"                      NOTE: if it is a binary corpus generated by\n";
+  std::cerr<<"                      thot_gen_bin_corpus, both sides are read from it\n";
+  std::cerr<<"                      and -t is not required.\n";
   std::cerr<<"-t <string>           File with target training sentences.\n";
   std::cerr<<"-l <string>           Prefix of the model files to be loaded.\n";
   std::cerr<<"-n <int>              Number of EM iterations.\n";
@@ -932,6 +990,12 @@ void printUsage(void)
   std::cerr<<"                      with fixed p0 probability).\n";
   std::cerr<<"                      NOTE: this option has no effect when combined with\n";
   std::cerr<<"                      the -l option.\n";
+  std::cerr<<"-nt <int>             Number of threads used to gather the sufficient\n";
+  std::cerr<<"                      statistics of the EM algorithm, 1 by default\n";
+  std::cerr<<"                      (only available for incremental models).\n";
+  std::cerr<<"-dt                   Accumulate the statistics in the same order as\n";
+  std::cerr<<"                      in a sequential execution, so the resulting model\n";
+  std::cerr<<"                      does not depend on the value of -nt.\n";
   std::cerr<<"-o <string>           Set prefix for output files.\n";
   std::cerr<<"-v | -v1              Verbose modes.\n";
   std::cerr<<"--help                Display this help and exit.\n";
@@ -0,0 +1,161 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file BinParallelCorpusTest.cc
+ * 
+ * @brief Definitions file for BinParallelCorpusTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "BinParallelCorpusTest.h"
+#include <fstream>
+#include <stdio.h>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( BinParallelCorpusTest );
+
+//--------------- BinParallelCorpusTest class functions
+//
+
+//---------------------------------------
+void BinParallelCorpusTest::setUp()
+{
+  srcFileName="/tmp/thot_bin_corpus_unit_test.src";
+  trgFileName="/tmp/thot_bin_corpus_unit_test.trg";
+  countsFileName="/tmp/thot_bin_corpus_unit_test.cnt";
+  binFileName="/tmp/thot_bin_corpus_unit_test.bin";
+
+  std::ofstream srcF(srcFileName.c_str());
+  std::ofstream trgF(trgFileName.c_str());
+  std::ofstream countsF(countsFileName.c_str());
+  srcF<<"la casa verde"<<std::endl;
+  trgF<<"the green house"<<std::endl;
+  countsF<<"2"<<std::endl;
+  srcF<<std::endl;
+  trgF<<"empty"<<std::endl;
+  countsF<<"0.5"<<std::endl;
+      // Enough different words to require multi-byte identifiers
+  for(unsigned int i=0;i<300;++i)
+  {
+    srcF<<"w"<<i<<" casa ";
+    trgF<<"house ";
+  }
+  srcF<<std::endl;
+  trgF<<std::endl;
+  countsF<<"1"<<std::endl;
+}
+
+//---------------------------------------
+void BinParallelCorpusTest::tearDown()
+{
+  remove(srcFileName.c_str());
+  remove(trgFileName.c_str());
+  remove(countsFileName.c_str());
+  remove(binFileName.c_str());
+}
+
+//---------------------------------------
+void BinParallelCorpusTest::checkCorpus(bool varint)
+{
+  CPPUNIT_ASSERT( BinParallelCorpus::create(srcFileName.c_str(),trgFileName.c_str(),countsFileName.c_str(),binFileName.c_str(),varint) == THOT_OK );
+  CPPUNIT_ASSERT( BinParallelCorpus::isBinCorpusFile(binFileName.c_str()) );
+  CPPUNIT_ASSERT( !BinParallelCorpus::isBinCorpusFile(srcFileName.c_str()) );
+
+  BinParallelCorpus binCorpus;
+  CPPUNIT_ASSERT( binCorpus.open(binFileName.c_str()) == THOT_OK );
+  CPPUNIT_ASSERT( binCorpus.numSentPairs() == 3 );
+  CPPUNIT_ASSERT( binCorpus.getSrcVocabSize() == 303 );
+  CPPUNIT_ASSERT( binCorpus.getTrgVocabSize() == 4 );
+
+      // Identifiers are assigned in order of appearance
+  std::vector<BinCorpusWordId> sent;
+  binCorpus.getSrcSent(0,sent);
+  CPPUNIT_ASSERT( sent.size() == 3 );
+  CPPUNIT_ASSERT( sent[0] == 0 && sent[1] == 1 && sent[2] == 2 );
+  CPPUNIT_ASSERT( binCorpus.srcWordIdToString(sent[1]) == "casa" );
+  binCorpus.getTrgSent(0,sent);
+  CPPUNIT_ASSERT( binCorpus.trgWordIdToString(sent[2]) == "house" );
+
+  binCorpus.getSrcSent(1,sent);
+  CPPUNIT_ASSERT( sent.empty() );
+  binCorpus.getTrgSent(1,sent);
+  CPPUNIT_ASSERT( sent.size() == 1 );
+
+  binCorpus.getSrcSent(2,sent);
+  CPPUNIT_ASSERT( sent.size() == 600 );
+  CPPUNIT_ASSERT( binCorpus.srcWordIdToString(sent[598]) == "w299" );
+  CPPUNIT_ASSERT( sent[599] == 1 );
+
+  CPPUNIT_ASSERT( (float)binCorpus.getCount(0) == 2 );
+  CPPUNIT_ASSERT( (float)binCorpus.getCount(1) == 0.5 );
+}
+
+//---------------------------------------
+void BinParallelCorpusTest::testFixedLengthIds()
+{
+  checkCorpus(false);
+}
+
+//---------------------------------------
+void BinParallelCorpusTest::testVarintIds()
+{
+  checkCorpus(true);
+}
+
+//---------------------------------------
+void BinParallelCorpusTest::testSentenceHandler()
+{
+  CPPUNIT_ASSERT( BinParallelCorpus::create(srcFileName.c_str(),trgFileName.c_str(),countsFileName.c_str(),binFileName.c_str(),true) == THOT_OK );
+
+      // Sentence pairs read from text and binary corpora are equal
+  LightSentenceHandler textHandler;
+  LightSentenceHandler binHandler;
+  std::pair<unsigned int,unsigned int> textRange;
+  std::pair<unsigned int,unsigned int> binRange;
+  CPPUNIT_ASSERT( textHandler.readSentencePairs(srcFileName.c_str(),trgFileName.c_str(),countsFileName.c_str(),textRange) == THOT_OK );
+  CPPUNIT_ASSERT( binHandler.readSentencePairs(binFileName.c_str(),"","",binRange) == THOT_OK );
+  CPPUNIT_ASSERT( textRange == binRange );
+  CPPUNIT_ASSERT( binHandler.numSentPairs() == 3 );
+  CPPUNIT_ASSERT( binHandler.getBinCorpusForSent(2) != NULL );
+  CPPUNIT_ASSERT( textHandler.getBinCorpusForSent(2) == NULL );
+
+      // Access in reverse order
+  for(int n=2;n>=0;--n)
+  {
+    std::vector<std::string> textSrc,textTrg,binSrc,binTrg;
+    Count textCount,binCount;
+    CPPUNIT_ASSERT( textHandler.nthSentPair(n,textSrc,textTrg,textCount) == THOT_OK );
+    CPPUNIT_ASSERT( binHandler.nthSentPair(n,binSrc,binTrg,binCount) == THOT_OK );
+    CPPUNIT_ASSERT( textSrc == binSrc );
+    CPPUNIT_ASSERT( textTrg == binTrg );
+    CPPUNIT_ASSERT( (float)textCount == (float)binCount );
+  }
+
+      // Sentence pairs added afterwards are kept in memory
+  std::vector<std::string> src(1,"nueva");
+  std::vector<std::string> trg(1,"new");
+  std::pair<unsigned int,unsigned int> sentRange;
+  binHandler.addSentPair(src,trg,1,sentRange);
+  CPPUNIT_ASSERT( sentRange.first == 3 );
+  CPPUNIT_ASSERT( binHandler.getBinCorpusForSent(3) == NULL );
+  std::vector<std::string> srcSent;
+  CPPUNIT_ASSERT( binHandler.getSrcSent(3,srcSent) == THOT_OK );
+  CPPUNIT_ASSERT( srcSent == src );
+}
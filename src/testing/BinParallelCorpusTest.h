@@ -0,0 +1,78 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file BinParallelCorpusTest.h
+ *
+ * @brief Declares the BinParallelCorpusTest class implementing unit
+ * tests for the BinParallelCorpus class.
+ */
+
+#ifndef _BinParallelCorpusTest_h
+#define _BinParallelCorpusTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "BinParallelCorpus.h"
+#include "LightSentenceHandler.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- BinParallelCorpusTest class
+
+/**
+ * @brief Class implementing tests for BinParallelCorpus.
+ */
+
+class BinParallelCorpusTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( BinParallelCorpusTest );
+  CPPUNIT_TEST( testFixedLengthIds );
+  CPPUNIT_TEST( testVarintIds );
+  CPPUNIT_TEST( testSentenceHandler );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testFixedLengthIds();
+  void testVarintIds();
+  void testSentenceHandler();
+
+ private:
+  std::string srcFileName;
+  std::string trgFileName;
+  std::string countsFileName;
+  std::string binFileName;
+
+  void checkCorpus(bool varint);
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file CoverageTest.cc
+ * 
+ * @brief Definitions file for CoverageTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "CoverageTest.h"
+#include <sstream>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( CoverageTest );
+
+//--------------- CoverageTest class functions
+//
+
+//---------------------------------------
+void CoverageTest::setUp()
+{
+}
+
+//---------------------------------------
+void CoverageTest::tearDown()
+{
+}
+
+//---------------------------------------
+void CoverageTest::testSetAndTest()
+{
+  Coverage cov;
+  cov.set(1);
+  cov.set(63);
+  cov.set(64);
+  cov.set(130);
+
+  CPPUNIT_ASSERT( cov.test(1) );
+  CPPUNIT_ASSERT( !cov.test(2) );
+  CPPUNIT_ASSERT( cov.test(63) );
+  CPPUNIT_ASSERT( cov.test(64) );
+  CPPUNIT_ASSERT( cov.test(130) );
+  CPPUNIT_ASSERT( cov.count() == 4 );
+  CPPUNIT_ASSERT( cov.count(64) == 2 );
+  CPPUNIT_ASSERT( cov.count(65) == 3 );
+
+  cov.reset(63);
+  cov.set(64,0);
+  CPPUNIT_ASSERT( !cov.test(63) );
+  CPPUNIT_ASSERT( !cov.test(64) );
+  CPPUNIT_ASSERT( cov.count() == 2 );
+
+  std::ostringstream outS;
+  cov.reset();
+  cov.set(1);
+  cov.set(3);
+  outS<<cov;
+  CPPUNIT_ASSERT( outS.str() == "1010" );
+}
+
+//---------------------------------------
+void CoverageTest::testRanges()
+{
+  Coverage cov;
+  cov.setRange(60,70);
+
+  CPPUNIT_ASSERT( cov.count() == 11 );
+  CPPUNIT_ASSERT( !cov.test(59) );
+  CPPUNIT_ASSERT( cov.test(60) );
+  CPPUNIT_ASSERT( cov.test(70) );
+  CPPUNIT_ASSERT( !cov.test(71) );
+
+  CPPUNIT_ASSERT( cov.anyInRange(1,60) );
+  CPPUNIT_ASSERT( !cov.anyInRange(1,59) );
+  CPPUNIT_ASSERT( cov.anyInRange(70,500) );
+  CPPUNIT_ASSERT( !cov.anyInRange(71,500) );
+  CPPUNIT_ASSERT( cov.allInRange(60,70) );
+  CPPUNIT_ASSERT( cov.allInRange(63,65) );
+  CPPUNIT_ASSERT( !cov.allInRange(59,70) );
+  CPPUNIT_ASSERT( !cov.allInRange(60,71) );
+}
+
+//---------------------------------------
+void CoverageTest::testFindNext()
+{
+  Coverage cov;
+  cov.setRange(1,3);
+  cov.setRange(64,100);
+
+  CPPUNIT_ASSERT( cov.findNext(1,false) == 4 );
+  CPPUNIT_ASSERT( cov.findNext(4,true) == 64 );
+  CPPUNIT_ASSERT( cov.findNext(64,false) == 101 );
+  CPPUNIT_ASSERT( cov.findNext(101,true) == COVERAGE_NPOS );
+      // Positions beyond the storage are unset
+  CPPUNIT_ASSERT( cov.findNext(1000,false) == 1000 );
+}
+
+//---------------------------------------
+void CoverageTest::testComparisons()
+{
+  Coverage cov1;
+  Coverage cov2;
+  cov1.set(2);
+  cov2.set(2);
+  CPPUNIT_ASSERT( cov1 == cov2 );
+  CPPUNIT_ASSERT( cov1.hash() == cov2.hash() );
+
+      // Bitsets are ordered by their numeric value
+  cov2.set(1);
+  CPPUNIT_ASSERT( cov1 != cov2 );
+  CPPUNIT_ASSERT( cov1 < cov2 );
+  cov1.set(100);
+  CPPUNIT_ASSERT( cov2 < cov1 );
+  CPPUNIT_ASSERT( cov1 > cov2 );
+
+      // The storage of a bitset does not affect comparisons
+  Coverage cov3;
+  cov3.set(1000);
+  cov3.reset(1000);
+  cov3.set(2);
+  cov3.set(100);
+  CPPUNIT_ASSERT( cov3.capacity() > cov1.capacity() );
+  CPPUNIT_ASSERT( cov1 == cov3 );
+  CPPUNIT_ASSERT( !(cov1 < cov3) && !(cov3 < cov1) );
+  CPPUNIT_ASSERT( cov1.hash() == cov3.hash() );
+}
+
+//---------------------------------------
+void CoverageTest::testLongSentences()
+{
+  Coverage cov;
+  size_t len=3*MAX_SENTENCE_LENGTH_ALLOWED;
+  cov.setRange(1,len);
+  cov.reset(MAX_SENTENCE_LENGTH_ALLOWED+10);
+  CPPUNIT_ASSERT( cov.count() == len-1 );
+  CPPUNIT_ASSERT( cov.findNext(1,false) == MAX_SENTENCE_LENGTH_ALLOWED+10 );
+  CPPUNIT_ASSERT( cov.findNext(MAX_SENTENCE_LENGTH_ALLOWED+11,false) == len+1 );
+
+      // Copies own their storage
+  Coverage covCopy(cov);
+  Coverage covAssig;
+  covAssig=cov;
+  cov.reset();
+  CPPUNIT_ASSERT( covCopy.count() == len-1 );
+  CPPUNIT_ASSERT( covAssig == covCopy );
+  CPPUNIT_ASSERT( !covAssig.test(MAX_SENTENCE_LENGTH_ALLOWED+10) );
+  CPPUNIT_ASSERT( covAssig.test(len) );
+}
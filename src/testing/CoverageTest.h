@@ -0,0 +1,67 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file CoverageTest.h
+ *
+ * @brief Declares the CoverageTest class implementing unit tests for
+ * the Coverage class.
+ */
+
+#ifndef _CoverageTest_h
+#define _CoverageTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "Coverage.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- CoverageTest class
+
+/**
+ * @brief Class implementing tests for Coverage.
+ */
+
+class CoverageTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( CoverageTest );
+  CPPUNIT_TEST( testSetAndTest );
+  CPPUNIT_TEST( testRanges );
+  CPPUNIT_TEST( testFindNext );
+  CPPUNIT_TEST( testComparisons );
+  CPPUNIT_TEST( testLongSentences );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testSetAndTest();
+  void testRanges();
+  void testFindNext();
+  void testComparisons();
+  void testLongSentences();
+};
+
+#endif
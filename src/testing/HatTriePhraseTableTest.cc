@@ -25,6 +25,7 @@ along with this program; If not, see <http://www.gnu.org/licenses/>.
 //--------------- Include files --------------------------------------
 
 #include "HatTriePhraseTableTest.h"
+#include <math.h>
 
 // Registers the fixture into the 'registry'
 CPPUNIT_TEST_SUITE_REGISTRATION( HatTriePhraseTableTest );
@@ -199,3 +200,109 @@ void HatTriePhraseTableTest::testIteratorsOperatorsEqualNotEqual()
     CPPUNIT_ASSERT( !(iter1 == iter2) );
     CPPUNIT_ASSERT( iter1 != iter2 );
 }
+
+//---------------------------------------
+void HatTriePhraseTableTest::testGetNbestForTrgFromLists()
+{
+    /* TEST:
+       Check that n-best lists of target phrases return the same
+       entries as the whole table after updating counts
+    */
+    std::vector<std::vector<WordIndex> > srcVec;
+    srcVec.push_back(getVector("dom"));
+    srcVec.push_back(getVector("domek"));
+    srcVec.push_back(getVector("dom rodzinny"));
+    srcVec.push_back(getVector("budynek"));
+    srcVec.push_back(getVector("chata"));
+    std::vector<WordIndex> t = getVector("house");
+
+    HatTriePhraseTable refTab;
+    tab->clear();
+    tabHatTrie->setTrgNbestListSize(2);
+
+    // Increase and decrease counts, leaving ties and zero counts
+    int countVec[] = {3, 1, 2, 2, 5, -2, 4, -2, 1, -1, 2, -4};
+    for(unsigned int i = 0; i < sizeof(countVec) / sizeof(int); ++i)
+    {
+        const std::vector<WordIndex>& s = srcVec[(i * 3) % srcVec.size()];
+        tab->incrCountsOfEntry(s, t, Count(countVec[i]));
+        refTab.incrCountsOfEntry(s, t, Count(countVec[i]));
+
+        for(int N = -1; N <= 4; ++N)
+        {
+            NbestTableNode<PhraseTransTableNodeData> node;
+            NbestTableNode<PhraseTransTableNodeData> refNode;
+            bool found = tab->getNbestForTrg(t, node, N);
+            bool refFound = refTab.getNbestForTrg(t, refNode, N);
+
+            CPPUNIT_ASSERT( found == refFound );
+            CPPUNIT_ASSERT_EQUAL(refNode.size(), node.size());
+
+            NbestTableNode<PhraseTransTableNodeData>::iterator iter = node.begin();
+            NbestTableNode<PhraseTransTableNodeData>::iterator refIter = refNode.begin();
+            for(; iter != node.end(); ++iter, ++refIter)
+            {
+                CPPUNIT_ASSERT( iter->second == refIter->second );
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((double) refIter->first, (double) iter->first, EPSILON);
+            }
+        }
+    }
+
+    tabHatTrie->setTrgNbestListSize(0);
+}
+
+//---------------------------------------
+void HatTriePhraseTableTest::testGetNbestForTrgFromListsTiedScores()
+{
+    /* TEST:
+       Check that entries with different counts obtaining the same score
+       are returned in the same order as from the whole table, that is,
+       sorted by source phrase
+    */
+    std::vector<WordIndex> s1 = getVector("dom");
+    std::vector<WordIndex> s2 = getVector("domek");
+    std::vector<WordIndex> s3 = getVector("budynek");
+    std::vector<WordIndex> t = getVector("house");
+    if(s2 < s1)
+        std::swap(s1, s2);
+
+    // s2 obtains a greater count than s1, but both counts give the same
+    // score once divided by the count of t
+    float c1 = 3;
+    float c2 = nextafterf(c1, 4);
+
+    for(unsigned int K = 2; K <= 3; ++K)
+    {
+        HatTriePhraseTable refTab;
+        tab->clear();
+        tabHatTrie->setTrgNbestListSize(K);
+
+        tab->incrCountsOfEntry(s1, t, Count(c1));
+        tab->incrCountsOfEntry(s2, t, Count(c2));
+        tab->incrCountsOfEntry(s3, t, Count(4));
+        refTab.incrCountsOfEntry(s1, t, Count(c1));
+        refTab.incrCountsOfEntry(s2, t, Count(c2));
+        refTab.incrCountsOfEntry(s3, t, Count(4));
+
+        for(int N = -1; N <= 3; ++N)
+        {
+            NbestTableNode<PhraseTransTableNodeData> node;
+            NbestTableNode<PhraseTransTableNodeData> refNode;
+            bool found = tab->getNbestForTrg(t, node, N);
+            bool refFound = refTab.getNbestForTrg(t, refNode, N);
+
+            CPPUNIT_ASSERT( found == refFound );
+            CPPUNIT_ASSERT_EQUAL(refNode.size(), node.size());
+
+            NbestTableNode<PhraseTransTableNodeData>::iterator iter = node.begin();
+            NbestTableNode<PhraseTransTableNodeData>::iterator refIter = refNode.begin();
+            for(; iter != node.end(); ++iter, ++refIter)
+            {
+                CPPUNIT_ASSERT( iter->second == refIter->second );
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((double) refIter->first, (double) iter->first, EPSILON);
+            }
+        }
+    }
+
+    tabHatTrie->setTrgNbestListSize(0);
+}
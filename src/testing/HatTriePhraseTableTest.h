@@ -68,6 +68,8 @@ class HatTriePhraseTableTest: public _phraseTableTest
     CPPUNIT_TEST( testIteratorsLoop );
     CPPUNIT_TEST( testIteratorsOperatorsPlusPlusStar );
     CPPUNIT_TEST( testIteratorsOperatorsEqualNotEqual );
+    CPPUNIT_TEST( testGetNbestForTrgFromLists );
+    CPPUNIT_TEST( testGetNbestForTrgFromListsTiedScores );
     CPPUNIT_TEST( testAddingSameSrcAndTrg );
     CPPUNIT_TEST( testSize );
     CPPUNIT_TEST( testSubkeys );
@@ -87,6 +89,8 @@ class HatTriePhraseTableTest: public _phraseTableTest
         void testIteratorsLoop();
         void testIteratorsOperatorsPlusPlusStar();
         void testIteratorsOperatorsEqualNotEqual();
+        void testGetNbestForTrgFromLists();
+        void testGetNbestForTrgFromListsTiedScores();
 };
 
 #endif
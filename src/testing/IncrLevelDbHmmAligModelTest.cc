@@ -0,0 +1,172 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file IncrLevelDbHmmAligModelTest.cc
+ * 
+ * @brief Definitions file for IncrLevelDbHmmAligModelTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "IncrLevelDbHmmAligModelTest.h"
+#include <fstream>
+#include <stdio.h>
+
+//--------------- Constants ------------------------------------------
+
+#define LDB_HMM_TEST_NUM_SENTS  50
+#define LDB_HMM_TEST_NUM_ITERS  2
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( IncrLevelDbHmmAligModelTest );
+
+//--------------- IncrLevelDbHmmAligModelTest class functions
+//
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::setUp()
+{
+  srcFileName="/tmp/thot_ldb_hmm_unit_test.src";
+  trgFileName="/tmp/thot_ldb_hmm_unit_test.trg";
+
+      // Generate a small corpus with pairs of different lengths
+  const char* srcWords[]={"la","casa","verde","el","perro","come","un","libro"};
+  const char* trgWords[]={"the","house","green","the","dog","eats","a","book"};
+  std::ofstream srcF(srcFileName.c_str());
+  std::ofstream trgF(trgFileName.c_str());
+  for(unsigned int n=0;n<LDB_HMM_TEST_NUM_SENTS;++n)
+  {
+    unsigned int len=2+n%5;
+    for(unsigned int k=0;k<len;++k)
+    {
+      unsigned int w=(n*3+k*5)%8;
+      if(k>0)
+      {
+        srcF<<" ";
+        trgF<<" ";
+      }
+      srcF<<srcWords[w];
+      trgF<<trgWords[(w+(n%2)*k)%8];
+    }
+    srcF<<std::endl;
+    trgF<<std::endl;
+  }
+
+  ldbModelPtr=new IncrLevelDbHmmP0AligModel();
+  CPPUNIT_ASSERT( ldbModelPtr->init(getDbNamePrefix().c_str()) == THOT_OK );
+}
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::tearDown()
+{
+  remove(srcFileName.c_str());
+  remove(trgFileName.c_str());
+
+      // Remove the database once the model has released it
+  delete ldbModelPtr;
+  IncrLexLevelDbTable lexTable;
+  lexTable.init(getDbNamePrefix().c_str());
+  lexTable.drop();
+}
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::train(_incrHmmAligModel& model)
+{
+  std::pair<unsigned int,unsigned int> sentRange;
+  CPPUNIT_ASSERT( model.readSentencePairs(srcFileName.c_str(),trgFileName.c_str(),"",sentRange) == THOT_OK );
+  for(unsigned int i=0;i<LDB_HMM_TEST_NUM_ITERS;++i)
+    model.trainAllSents();
+}
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::trainPair(_incrHmmAligModel& model)
+{
+      // Train a sentence pair with new words in the same way as the
+      // online training of the decoder does
+  std::vector<std::string> srcSentStrVec;
+  srcSentStrVec.push_back("la");
+  srcSentStrVec.push_back("casa");
+  srcSentStrVec.push_back("azul");
+  std::vector<std::string> trgSentStrVec;
+  trgSentStrVec.push_back("the");
+  trgSentStrVec.push_back("blue");
+  trgSentStrVec.push_back("house");
+
+  std::pair<unsigned int,unsigned int> sentRange;
+  model.addSentPair(srcSentStrVec,trgSentStrVec,1,sentRange);
+  model.trainSentPairRange(sentRange);
+}
+
+//---------------------------------------
+double IncrLevelDbHmmAligModelTest::maxParDiff(_incrHmmAligModel& model1,
+                                               _incrHmmAligModel& model2)
+{
+  double maxDiff=0;
+  for(WordIndex s=0;s<model1.getSrcVocabSize();++s)
+  {
+    for(WordIndex t=0;t<model1.getTrgVocabSize();++t)
+    {
+      double diff=fabs((double)model1.pts(s,t)-(double)model2.pts(s,t));
+      if(diff>maxDiff) maxDiff=diff;
+    }
+  }
+  for(PositionIndex slen=2;slen<=6;++slen)
+  {
+    for(PositionIndex prev_i=0;prev_i<=slen;++prev_i)
+    {
+      for(PositionIndex i=1;i<=slen;++i)
+      {
+        double diff=fabs((double)model1.aProb(prev_i,slen,i)-(double)model2.aProb(prev_i,slen,i));
+        if(diff>maxDiff) maxDiff=diff;
+      }
+    }
+  }
+  return maxDiff;
+}
+
+//---------------------------------------
+std::string IncrLevelDbHmmAligModelTest::getDbNamePrefix(void)
+{
+  return "/tmp/thot_ldb_hmm_unit_test";
+}
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::testCloneNotSupported()
+{
+      // The database of the model can only be opened once, so the
+      // model cannot be copied
+  train(*ldbModelPtr);
+  CPPUNIT_ASSERT( ldbModelPtr->clone() == NULL );
+}
+
+//---------------------------------------
+void IncrLevelDbHmmAligModelTest::testOnlineTrainPair()
+{
+      // An online training pair is trained in place, giving the same
+      // parameters as the in-memory model
+  IncrHmmP0AligModel model;
+  train(*ldbModelPtr);
+  train(model);
+  trainPair(*ldbModelPtr);
+  trainPair(model);
+
+  CPPUNIT_ASSERT( ldbModelPtr->numSentPairs() == model.numSentPairs() );
+  CPPUNIT_ASSERT( ldbModelPtr->existSrcSymbol("azul") );
+  CPPUNIT_ASSERT( maxParDiff(*ldbModelPtr,model) == 0 );
+}
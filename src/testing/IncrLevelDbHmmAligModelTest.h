@@ -0,0 +1,81 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file IncrLevelDbHmmAligModelTest.h
+ *
+ * @brief Declares the IncrLevelDbHmmAligModelTest class implementing
+ * unit tests for the online training of the LevelDB-based HMM
+ * alignment models.
+ */
+
+#ifndef _IncrLevelDbHmmAligModelTest_h
+#define _IncrLevelDbHmmAligModelTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "IncrHmmP0AligModel.h"
+#include "IncrLevelDbHmmP0AligModel.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- IncrLevelDbHmmAligModelTest class
+
+/**
+ * @brief Class implementing tests for the online training of
+ * IncrLevelDbHmmP0AligModel.
+ */
+
+class IncrLevelDbHmmAligModelTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( IncrLevelDbHmmAligModelTest );
+  CPPUNIT_TEST( testCloneNotSupported );
+  CPPUNIT_TEST( testOnlineTrainPair );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testCloneNotSupported();
+  void testOnlineTrainPair();
+
+ private:
+  std::string srcFileName;
+  std::string trgFileName;
+  IncrLevelDbHmmP0AligModel* ldbModelPtr;
+
+  std::string getDbNamePrefix(void);
+  void train(_incrHmmAligModel& model);
+  void trainPair(_incrHmmAligModel& model);
+  double maxParDiff(_incrHmmAligModel& model1,
+                    _incrHmmAligModel& model2);
+};
+
+#endif
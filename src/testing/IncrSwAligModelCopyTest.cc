@@ -0,0 +1,178 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file IncrSwAligModelCopyTest.cc
+ * 
+ * @brief Definitions file for IncrSwAligModelCopyTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "IncrSwAligModelCopyTest.h"
+#include <fstream>
+#include <stdio.h>
+
+//--------------- Constants ------------------------------------------
+
+#define COPY_TEST_NUM_SENTS  50
+#define COPY_TEST_NUM_ITERS  2
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( IncrSwAligModelCopyTest );
+
+//--------------- IncrSwAligModelCopyTest class functions
+//
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::setUp()
+{
+  srcFileName="/tmp/thot_swm_copy_unit_test.src";
+  trgFileName="/tmp/thot_swm_copy_unit_test.trg";
+
+      // Generate a small corpus with pairs of different lengths
+  const char* srcWords[]={"la","casa","verde","el","perro","come","un","libro"};
+  const char* trgWords[]={"the","house","green","the","dog","eats","a","book"};
+  std::ofstream srcF(srcFileName.c_str());
+  std::ofstream trgF(trgFileName.c_str());
+  for(unsigned int n=0;n<COPY_TEST_NUM_SENTS;++n)
+  {
+    unsigned int len=2+n%5;
+    for(unsigned int k=0;k<len;++k)
+    {
+      unsigned int w=(n*3+k*5)%8;
+      if(k>0)
+      {
+        srcF<<" ";
+        trgF<<" ";
+      }
+      srcF<<srcWords[w];
+      trgF<<trgWords[(w+(n%2)*k)%8];
+    }
+    srcF<<std::endl;
+    trgF<<std::endl;
+  }
+}
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::tearDown()
+{
+  remove(srcFileName.c_str());
+  remove(trgFileName.c_str());
+}
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::train(_incrHmmAligModel& model)
+{
+  std::pair<unsigned int,unsigned int> sentRange;
+  CPPUNIT_ASSERT( model.readSentencePairs(srcFileName.c_str(),trgFileName.c_str(),"",sentRange) == THOT_OK );
+  for(unsigned int i=0;i<COPY_TEST_NUM_ITERS;++i)
+    model.trainAllSents();
+}
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::trainPair(_incrHmmAligModel& model)
+{
+      // Train a sentence pair with new words in the same way as the
+      // online training of the decoder does
+  std::vector<std::string> srcSentStrVec;
+  srcSentStrVec.push_back("la");
+  srcSentStrVec.push_back("casa");
+  srcSentStrVec.push_back("azul");
+  std::vector<std::string> trgSentStrVec;
+  trgSentStrVec.push_back("the");
+  trgSentStrVec.push_back("blue");
+  trgSentStrVec.push_back("house");
+
+  std::pair<unsigned int,unsigned int> sentRange;
+  model.addSentPair(srcSentStrVec,trgSentStrVec,1,sentRange);
+  model.trainSentPairRange(sentRange);
+}
+
+//---------------------------------------
+double IncrSwAligModelCopyTest::maxParDiff(_incrHmmAligModel& model1,
+                                           _incrHmmAligModel& model2)
+{
+  double maxDiff=0;
+  for(WordIndex s=0;s<model1.getSrcVocabSize();++s)
+  {
+    for(WordIndex t=0;t<model1.getTrgVocabSize();++t)
+    {
+      double diff=fabs((double)model1.pts(s,t)-(double)model2.pts(s,t));
+      if(diff>maxDiff) maxDiff=diff;
+    }
+  }
+  for(PositionIndex slen=2;slen<=6;++slen)
+  {
+    for(PositionIndex prev_i=0;prev_i<=slen;++prev_i)
+    {
+      for(PositionIndex i=1;i<=slen;++i)
+      {
+        double diff=fabs((double)model1.aProb(prev_i,slen,i)-(double)model2.aProb(prev_i,slen,i));
+        if(diff>maxDiff) maxDiff=diff;
+      }
+    }
+  }
+  return maxDiff;
+}
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::testCloneIsIndependent()
+{
+  IncrHmmP0AligModel model;
+  train(model);
+  IncrHmmP0AligModel* copyPtr=model.clone();
+  CPPUNIT_ASSERT( copyPtr != NULL );
+  CPPUNIT_ASSERT( maxParDiff(model,*copyPtr) == 0 );
+
+      // Training the copy does not modify the original model
+  unsigned int numSentPairs=model.numSentPairs();
+  Prob prob=model.pts(model.stringToSrcWordIndex("casa"),model.stringToTrgWordIndex("house"));
+  trainPair(*copyPtr);
+  CPPUNIT_ASSERT( copyPtr->numSentPairs() == numSentPairs+1 );
+  CPPUNIT_ASSERT( model.numSentPairs() == numSentPairs );
+  CPPUNIT_ASSERT( !model.existSrcSymbol("azul") );
+  CPPUNIT_ASSERT( (double)model.pts(model.stringToSrcWordIndex("casa"),model.stringToTrgWordIndex("house")) == (double)prob );
+
+  delete copyPtr;
+
+      // The original model can still be trained after deleting the
+      // copy
+  model.trainAllSents();
+}
+
+//---------------------------------------
+void IncrSwAligModelCopyTest::testCloneOnlineTrainPair()
+{
+  IncrHmmP0AligModel model;
+  train(model);
+  IncrHmmP0AligModel* copyPtr=model.clone();
+  CPPUNIT_ASSERT( copyPtr != NULL );
+
+      // The copy and the original model end in the same state after
+      // training the same pair, and after retraining the pairs read
+      // from the corpus files
+  trainPair(*copyPtr);
+  trainPair(model);
+  CPPUNIT_ASSERT( maxParDiff(model,*copyPtr) == 0 );
+  copyPtr->trainAllSents();
+  model.trainAllSents();
+  CPPUNIT_ASSERT( maxParDiff(model,*copyPtr) == 0 );
+
+  delete copyPtr;
+}
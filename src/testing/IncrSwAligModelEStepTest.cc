@@ -0,0 +1,193 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file IncrSwAligModelEStepTest.cc
+ * 
+ * @brief Definitions file for IncrSwAligModelEStepTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "IncrSwAligModelEStepTest.h"
+#include <fstream>
+#include <stdio.h>
+
+//--------------- Constants ------------------------------------------
+
+#define ESTEP_TEST_NUM_SENTS  200
+#define ESTEP_TEST_NUM_ITERS  3
+#define ESTEP_TEST_TOLERANCE  1e-3
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( IncrSwAligModelEStepTest );
+
+//--------------- IncrSwAligModelEStepTest class functions
+//
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::setUp()
+{
+  srcFileName="/tmp/thot_estep_unit_test.src";
+  trgFileName="/tmp/thot_estep_unit_test.trg";
+
+      // Generate a corpus with pairs of different lengths
+  const char* srcWords[]={"la","casa","verde","el","perro","come","un","libro"};
+  const char* trgWords[]={"the","house","green","the","dog","eats","a","book"};
+  std::ofstream srcF(srcFileName.c_str());
+  std::ofstream trgF(trgFileName.c_str());
+  for(unsigned int n=0;n<ESTEP_TEST_NUM_SENTS;++n)
+  {
+    unsigned int len=2+n%5;
+    for(unsigned int k=0;k<len;++k)
+    {
+      unsigned int w=(n*3+k*5)%8;
+      if(k>0)
+      {
+        srcF<<" ";
+        trgF<<" ";
+      }
+      srcF<<srcWords[w];
+      trgF<<trgWords[(w+(n%2)*k)%8];
+    }
+    srcF<<std::endl;
+    trgF<<std::endl;
+  }
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::tearDown()
+{
+  remove(srcFileName.c_str());
+  remove(trgFileName.c_str());
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::train(_incrSwAligModel<std::vector<Prob> >& model,
+                                     unsigned int numThreads,
+                                     bool deterministic)
+{
+  std::pair<unsigned int,unsigned int> sentRange;
+  CPPUNIT_ASSERT( model.readSentencePairs(srcFileName.c_str(),trgFileName.c_str(),"",sentRange) == THOT_OK );
+  model.setNumEStepThreads(numThreads);
+  model.setDeterministicEStep(deterministic);
+  for(unsigned int i=0;i<ESTEP_TEST_NUM_ITERS;++i)
+    model.trainAllSents();
+}
+
+//---------------------------------------
+double IncrSwAligModelEStepTest::maxParDiff(IncrIbm2AligModel& model1,
+                                            IncrIbm2AligModel& model2)
+{
+  double maxDiff=0;
+  for(WordIndex s=0;s<model1.getSrcVocabSize();++s)
+  {
+    for(WordIndex t=0;t<model1.getTrgVocabSize();++t)
+    {
+      double diff=fabs((double)model1.pts(s,t)-(double)model2.pts(s,t));
+      if(diff>maxDiff) maxDiff=diff;
+    }
+  }
+  for(PositionIndex slen=2;slen<=6;++slen)
+  {
+    for(PositionIndex j=1;j<=slen;++j)
+    {
+      for(PositionIndex i=0;i<=slen;++i)
+      {
+        double diff=fabs((double)model1.aProb(j,slen,slen,i)-(double)model2.aProb(j,slen,slen,i));
+        if(diff>maxDiff) maxDiff=diff;
+      }
+    }
+  }
+  return maxDiff;
+}
+
+//---------------------------------------
+double IncrSwAligModelEStepTest::maxParDiff(IncrHmmAligModel& model1,
+                                            IncrHmmAligModel& model2)
+{
+  double maxDiff=0;
+  for(WordIndex s=0;s<model1.getSrcVocabSize();++s)
+  {
+    for(WordIndex t=0;t<model1.getTrgVocabSize();++t)
+    {
+      double diff=fabs((double)model1.pts(s,t)-(double)model2.pts(s,t));
+      if(diff>maxDiff) maxDiff=diff;
+    }
+  }
+  for(PositionIndex slen=2;slen<=6;++slen)
+  {
+    for(PositionIndex prev_i=0;prev_i<=slen;++prev_i)
+    {
+      for(PositionIndex i=1;i<=slen;++i)
+      {
+        double diff=fabs((double)model1.aProb(prev_i,slen,i)-(double)model2.aProb(prev_i,slen,i));
+        if(diff>maxDiff) maxDiff=diff;
+      }
+    }
+  }
+  return maxDiff;
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::testIbm2DeterministicEStep()
+{
+  IncrIbm2AligModel serialModel;
+  IncrIbm2AligModel parallelModel;
+  train(serialModel,1,false);
+  train(parallelModel,3,true);
+
+      // Contributions are accumulated in sequential order
+  CPPUNIT_ASSERT( maxParDiff(serialModel,parallelModel) == 0 );
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::testIbm2ParallelEStep()
+{
+  IncrIbm2AligModel serialModel;
+  IncrIbm2AligModel parallelModel;
+  train(serialModel,1,false);
+  train(parallelModel,3,false);
+
+      // Merging statistics only introduces rounding differences
+  CPPUNIT_ASSERT( maxParDiff(serialModel,parallelModel) < ESTEP_TEST_TOLERANCE );
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::testHmmDeterministicEStep()
+{
+  IncrHmmAligModel serialModel;
+  IncrHmmAligModel parallelModel;
+  train(serialModel,1,false);
+  train(parallelModel,3,true);
+
+      // Contributions are accumulated in sequential order
+  CPPUNIT_ASSERT( maxParDiff(serialModel,parallelModel) == 0 );
+}
+
+//---------------------------------------
+void IncrSwAligModelEStepTest::testHmmParallelEStep()
+{
+  IncrHmmAligModel serialModel;
+  IncrHmmAligModel parallelModel;
+  train(serialModel,1,false);
+  train(parallelModel,3,false);
+
+      // Merging statistics only introduces rounding differences
+  CPPUNIT_ASSERT( maxParDiff(serialModel,parallelModel) < ESTEP_TEST_TOLERANCE );
+}
@@ -0,0 +1,86 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+ 
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+ 
+/**
+ * @file IncrSwAligModelEStepTest.h
+ *
+ * @brief Declares the IncrSwAligModelEStepTest class implementing unit
+ * tests for the multi-threaded E step of the incremental single word
+ * alignment models.
+ */
+
+#ifndef _IncrSwAligModelEStepTest_h
+#define _IncrSwAligModelEStepTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "IncrIbm2AligModel.h"
+#include "IncrHmmAligModel.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- IncrSwAligModelEStepTest class
+
+/**
+ * @brief Class implementing tests for the E step of the incremental
+ * single word alignment models.
+ */
+
+class IncrSwAligModelEStepTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( IncrSwAligModelEStepTest );
+  CPPUNIT_TEST( testIbm2DeterministicEStep );
+  CPPUNIT_TEST( testIbm2ParallelEStep );
+  CPPUNIT_TEST( testHmmDeterministicEStep );
+  CPPUNIT_TEST( testHmmParallelEStep );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testIbm2DeterministicEStep();
+  void testIbm2ParallelEStep();
+  void testHmmDeterministicEStep();
+  void testHmmParallelEStep();
+
+ private:
+  std::string srcFileName;
+  std::string trgFileName;
+
+  void train(_incrSwAligModel<std::vector<Prob> >& model,
+             unsigned int numThreads,
+             bool deterministic);
+  double maxParDiff(IncrIbm2AligModel& model1,
+                    IncrIbm2AligModel& model2);
+  double maxParDiff(IncrHmmAligModel& model1,
+                    IncrHmmAligModel& model2);
+};
+
+#endif
@@ -821,6 +821,97 @@ void LevelDbNgramTableTest::testLoadedDataNullCount()
     CPPUNIT_ASSERT_DOUBLES_EQUAL(16.0, tab->cSrc(s3).get_c_st(), EPSILON);
 }
 
+//---------------------------------------
+void LevelDbNgramTableTest::testBulkLoad()
+{
+    //  TEST:
+    //    Check that entries stored during bulk loading
+    //    can be retrieved before and after writing them
+    //
+    bool result;
+
+    tab->clear();
+    CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_NGRAM_TABLE_FORMAT_VERSION, tab->getFormatVersion());
+
+    // Use a small buffer to write several batches
+    result = tab->startBulkLoad(3);
+    CPPUNIT_ASSERT( result == THOT_OK );
+
+    std::vector<WordIndex> s1;
+    s1.push_back(1000);
+    s1.push_back(2000);
+    std::vector<WordIndex> s2;
+    s2.push_back(3000);
+
+    im_pair<Count, Count> ppi;
+    ppi.first = Count(10);
+    ppi.second = Count(4);
+    tab->addTableEntry(s1, 22000, ppi);
+    ppi.second = Count(6);
+    tab->addTableEntry(s1, 33000, ppi);
+    ppi.first = Count(3);
+    ppi.second = Count(1.5);
+    tab->addTableEntry(s2, 44000, ppi);
+    tab->incrCountsOfEntryLog(s2, 44000, LogCount(log(2)));
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, tab->cSrc(s1).get_c_s(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, tab->cSrcTrg(s2, 44000).get_c_st(), EPSILON);
+
+    result = tab->endBulkLoad();
+    CPPUNIT_ASSERT( result == THOT_OK );
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, tab->size());
+
+    // Check count values after loading the table from disk
+    result = tab->load(getDbName().c_str());
+    CPPUNIT_ASSERT( result == THOT_OK );
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, tab->size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, tab->cSrc(s1).get_c_s(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, tab->cSrcTrg(s1, 22000).get_c_st(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, tab->cSrcTrg(s1, 33000).get_c_st(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, tab->cSrc(s2).get_c_s(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, tab->cSrcTrg(s2, 44000).get_c_st(), EPSILON);
+}
+
+//---------------------------------------
+void LevelDbNgramTableTest::testLoadingTextFormat()
+{
+    //  TEST:
+    //    Check that databases storing counts as text,
+    //    which do not contain format version, can be loaded
+    //
+    bool result;
+
+    std::vector<WordIndex> s;
+    s.push_back(1000);
+    s.push_back(2000);
+    std::vector<WordIndex> st = tab->getSrcTrg(s, 22000);
+
+    // Create database with counts stored as text
+    tab->drop();
+    leveldb::DB* db;
+    leveldb::Options options;
+    options.create_if_missing = true;
+    leveldb::Status status = leveldb::DB::Open(options, getDbName(), &db);
+    CPPUNIT_ASSERT( status.ok() );
+    db->Put(leveldb::WriteOptions(), tab->vectorToKey(s), "3");
+    db->Put(leveldb::WriteOptions(), tab->vectorToKey(st), "1.5");
+    delete db;
+
+    result = tab->load(getDbName().c_str());
+    CPPUNIT_ASSERT( result == THOT_OK );
+    CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION, tab->getFormatVersion());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, tab->cSrc(s).get_c_s(), EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, tab->cSrcTrg(s, 22000).get_c_st(), EPSILON);
+
+    // New counts are stored with the format of the database
+    tab->incrCountsOfEntryLog(s, 22000, LogCount(log(2)));
+    result = tab->load(getDbName().c_str());
+    CPPUNIT_ASSERT( result == THOT_OK );
+    CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_NGRAM_TABLE_TEXT_FORMAT_VERSION, tab->getFormatVersion());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, tab->cSrcTrg(s, 22000).get_c_st(), EPSILON);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, tab->size());
+}
+
 //---------------------------------------
 std::string LevelDbNgramTableTest::getDbName(void)
 {
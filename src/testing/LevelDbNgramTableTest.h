@@ -76,6 +76,8 @@ class LevelDbNgramTableTest: public CppUnit::TestFixture
         CPPUNIT_TEST( testLoadingLevelDb );
         CPPUNIT_TEST( testLoadedDataCorrectness );
         CPPUNIT_TEST( testLoadedDataNullCount );
+        CPPUNIT_TEST( testBulkLoad );
+        CPPUNIT_TEST( testLoadingTextFormat );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -109,6 +111,8 @@ class LevelDbNgramTableTest: public CppUnit::TestFixture
         void testLoadingLevelDb();
         void testLoadedDataCorrectness();
         void testLoadedDataNullCount();
+        void testBulkLoad();
+        void testLoadingTextFormat();
 };
 
 #endif
@@ -307,6 +307,93 @@ void LevelDbPhraseTableTest::testLoadedDataCorrectness()
   CPPUNIT_ASSERT_EQUAL((size_t) 0, tab->size());
 }
 
+//---------------------------------------
+void LevelDbPhraseTableTest::testBulkLoad()
+{
+  /* TEST:
+     Check that entries stored during bulk loading
+     can be retrieved before and after writing them
+  */
+  bool result;
+
+  tab->clear();
+  CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_PHRASE_TABLE_FORMAT_VERSION, tabLdb->getFormatVersion());
+
+  // Use a small buffer to write several batches
+  result = tabLdb->startBulkLoad(2);
+  CPPUNIT_ASSERT( result == THOT_OK );
+
+  std::vector<WordIndex> s1 = getVector("Pan Samochodzik");
+  std::vector<WordIndex> t1_1 = getVector("Mr Car");
+  std::vector<WordIndex> t1_2 = getVector("Mister Automobile");
+  std::vector<WordIndex> s2 = getVector("Wyspa Zloczyncow");
+  std::vector<WordIndex> t2 = getVector("Island of Criminals");
+
+  tab->incrCountsOfEntry(s1, t1_1, Count(1));
+  tab->incrCountsOfEntry(s1, t1_2, Count(20));
+  tab->incrCountsOfEntry(s2, t2, Count(3));
+  tab->incrCountsOfEntry(s1, t1_1, Count(2));
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(23, tab->cSrc(s1).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cSrcTrg(s1, t1_1).get_c_st(), EPSILON);
+
+  result = tabLdb->endBulkLoad();
+  CPPUNIT_ASSERT( result == THOT_OK );
+  CPPUNIT_ASSERT_EQUAL((size_t) 8, tab->size());
+
+  // Check count values after loading the table from disk
+  result = tabLdb->load(getDbName());
+  CPPUNIT_ASSERT( result == THOT_OK );
+  CPPUNIT_ASSERT_EQUAL((size_t) 8, tab->size());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(23, tab->cSrc(s1).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cTrg(t1_1).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cSrcTrg(s1, t1_1).get_c_st(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(20, tab->cSrcTrg(s1, t1_2).get_c_st(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cSrc(s2).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cSrcTrg(s2, t2).get_c_st(), EPSILON);
+}
+
+//---------------------------------------
+void LevelDbPhraseTableTest::testLoadingTextFormat()
+{
+  /* TEST:
+     Check that databases storing counts as text,
+     which do not contain format version, can be loaded
+  */
+  bool result;
+
+  std::vector<WordIndex> s = getVector("Pan Samochodzik");
+  std::vector<WordIndex> t = getVector("Mr Car");
+
+  // Create database with counts stored as text
+  tabLdb->drop();
+  leveldb::DB* db;
+  leveldb::Options options;
+  options.create_if_missing = true;
+  leveldb::Status status = leveldb::DB::Open(options, getDbName(), &db);
+  CPPUNIT_ASSERT( status.ok() );
+  db->Put(leveldb::WriteOptions(), tabLdb->vectorToKey(tabLdb->encodeSrc(s)), "5");
+  db->Put(leveldb::WriteOptions(), tabLdb->vectorToKey(t), "4");
+  db->Put(leveldb::WriteOptions(), tabLdb->vectorToKey(tabLdb->encodeTrgSrc(s, t)), "2");
+  delete db;
+
+  result = tabLdb->load(getDbName());
+  CPPUNIT_ASSERT( result == THOT_OK );
+  CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION, tabLdb->getFormatVersion());
+  CPPUNIT_ASSERT_EQUAL((size_t) 3, tab->size());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(5, tab->cSrc(s).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4, tab->cTrg(t).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2, tab->cSrcTrg(s, t).get_c_st(), EPSILON);
+
+  // New counts are stored with the format of the database
+  tab->incrCountsOfEntry(s, t, Count(1));
+  result = tabLdb->load(getDbName());
+  CPPUNIT_ASSERT( result == THOT_OK );
+  CPPUNIT_ASSERT_EQUAL((unsigned int) LEVELDB_PHRASE_TABLE_TEXT_FORMAT_VERSION, tabLdb->getFormatVersion());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(6, tab->cSrc(s).get_c_s(), EPSILON);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3, tab->cSrcTrg(s, t).get_c_st(), EPSILON);
+}
+
 //---------------------------------------
 std::string LevelDbPhraseTableTest::getDbName(void)
 {
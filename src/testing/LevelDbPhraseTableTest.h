@@ -78,6 +78,8 @@ class LevelDbPhraseTableTest: public _phraseTableTest
   CPPUNIT_TEST( test32bitRange );
   CPPUNIT_TEST( testByteMax );
   CPPUNIT_TEST( testByteMin );
+  CPPUNIT_TEST( testBulkLoad );
+  CPPUNIT_TEST( testLoadingTextFormat );
   CPPUNIT_TEST_SUITE_END();
 
  private:
@@ -96,6 +98,8 @@ class LevelDbPhraseTableTest: public _phraseTableTest
   void testIteratorsOperatorsEqualNotEqual();
   void testLoadingLevelDb();
   void testLoadedDataCorrectness();
+  void testBulkLoad();
+  void testLoadingTextFormat();
 };
 
 #endif
@@ -96,4 +96,31 @@ void MiraChrFTest::testCorpusLevel()
     double score;
     chrf_metric->corpusScore(system_sentences, reference_sentences, score);
     CPPUNIT_ASSERT(floor(score*100)/100 == 0.71);
-}
\ No newline at end of file
+}
+
+void MiraChrFTest::testSuffStats()
+{
+    // Scores obtained from sufficient statistics are equal to those
+    // obtained from the sentences
+    unsigned int numStats = chrf_metric->getNumSuffStats();
+    std::vector<double> corpusStats(numStats, 0);
+    for (unsigned int i=0; i<system_sentences.size(); i++) {
+        std::vector<double> stats(numStats);
+        chrf_metric->sentSuffStats(system_sentences[i], reference_sentences[i], &stats[0]);
+
+        double score;
+        chrf_metric->sentScore(system_sentences[i], reference_sentences[i], score);
+        CPPUNIT_ASSERT(chrf_metric->sentScoreFromSuffStats(&stats[0]) == score);
+
+        std::vector<unsigned int> bgStats;
+        chrf_metric->sentBackgroundScore(system_sentences[i], reference_sentences[i], score, bgStats);
+        CPPUNIT_ASSERT(chrf_metric->sentBackgroundScoreFromSuffStats(&stats[0]) == score);
+
+        for (unsigned int k=0; k<numStats; k++)
+            corpusStats[k] += stats[k];
+    }
+
+    double score;
+    chrf_metric->corpusScore(system_sentences, reference_sentences, score);
+    CPPUNIT_ASSERT(chrf_metric->corpusScoreFromSuffStats(&corpusStats[0]) == score);
+}
@@ -41,6 +41,7 @@ class MiraChrFTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE( MiraChrFTest );
     CPPUNIT_TEST( testSentenceLevel );
     CPPUNIT_TEST( testCorpusLevel );
+    CPPUNIT_TEST( testSuffStats );
     CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -54,6 +55,7 @@ class MiraChrFTest: public CppUnit::TestFixture
 
         void testSentenceLevel();
         void testCorpusLevel();
+        void testSuffStats();
 };
 
 #endif
@@ -0,0 +1,118 @@
+/*
+thot package for statistical machine translation
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MiraSuffStatsTest.cc
+ *
+ * @brief Definitions file for MiraSuffStatsTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "MiraSuffStatsTest.h"
+#include "stack_dec/MiraBleu.h"
+#include "stack_dec/MiraGtm.h"
+#include "stack_dec/MiraWer.h"
+
+#define SUFF_STATS_TEST_EPSILON 1e-9
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( MiraSuffStatsTest );
+
+//---------------------------------------
+void MiraSuffStatsTest::setUp()
+{
+    system_sentences.push_back("colourless green ideas sleep furiously");
+    system_sentences.push_back("colourless green ideas sleep furiously");
+    system_sentences.push_back(".");
+    system_sentences.push_back("colourless green ideas sleep furiously");
+    system_sentences.push_back("colorless greeny idea sleeps furious");
+    system_sentences.push_back("the ideas sleep green ideas");
+    system_sentences.push_back("");
+
+    reference_sentences.push_back("colourless green ideas sleep furiously");
+    reference_sentences.push_back("colourless green ideas");
+    reference_sentences.push_back(".");
+    reference_sentences.push_back("colourless green ideas sleepfuriously");
+    reference_sentences.push_back("colourless green ideas sleep furiously");
+    reference_sentences.push_back("green ideas sleep");
+    reference_sentences.push_back("colourless green ideas sleep furiously");
+}
+
+//---------------------------------------
+void MiraSuffStatsTest::tearDown()
+{
+}
+
+//---------------------------------------
+void MiraSuffStatsTest::checkSuffStats(BaseMiraScorer* scorer,
+                                       BaseMiraScorer* suffStatsScorer)
+{
+    unsigned int numStats = suffStatsScorer->getNumSuffStats();
+    std::vector<double> corpusStats(numStats, 0);
+    scorer->resetBackgroundCorpus();
+    suffStatsScorer->resetBackgroundCorpus();
+
+    for (unsigned int i=0; i<system_sentences.size(); i++) {
+        std::vector<double> stats(numStats);
+        suffStatsScorer->sentSuffStats(system_sentences[i], reference_sentences[i], &stats[0]);
+
+        double score;
+        scorer->sentScore(system_sentences[i], reference_sentences[i], score);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(score, suffStatsScorer->sentScoreFromSuffStats(&stats[0]), SUFF_STATS_TEST_EPSILON);
+
+        std::vector<unsigned int> bgStats;
+        scorer->sentBackgroundScore(system_sentences[i], reference_sentences[i], score, bgStats);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(score, suffStatsScorer->sentBackgroundScoreFromSuffStats(&stats[0]), SUFF_STATS_TEST_EPSILON);
+
+        // Background scores of the next sentences also depend on the
+        // statistics of this one
+        scorer->updateBackgroundCorpus(bgStats, 0.9);
+        suffStatsScorer->updateBackgroundCorpusFromSuffStats(&stats[0], 0.9);
+
+        for (unsigned int k=0; k<numStats; k++)
+            corpusStats[k] += stats[k];
+    }
+
+    double score;
+    scorer->corpusScore(system_sentences, reference_sentences, score);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(score, suffStatsScorer->corpusScoreFromSuffStats(&corpusStats[0]), SUFF_STATS_TEST_EPSILON);
+}
+
+//---------------------------------------
+void MiraSuffStatsTest::testBleuSuffStats()
+{
+    MiraBleu scorer;
+    MiraBleu suffStatsScorer;
+    checkSuffStats(&scorer, &suffStatsScorer);
+}
+
+//---------------------------------------
+void MiraSuffStatsTest::testGtmSuffStats()
+{
+    MiraGtm scorer;
+    MiraGtm suffStatsScorer;
+    checkSuffStats(&scorer, &suffStatsScorer);
+}
+
+//---------------------------------------
+void MiraSuffStatsTest::testWerSuffStats()
+{
+    MiraWer scorer;
+    MiraWer suffStatsScorer;
+    checkSuffStats(&scorer, &suffStatsScorer);
+}
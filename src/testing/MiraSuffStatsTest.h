@@ -0,0 +1,68 @@
+/*
+thot package for statistical machine translation
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "MiraChrFTest.h"
+
+/**
+ * @file MiraSuffStatsTest.h
+ *
+ * @brief Declares the MiraSuffStatsTest class implementing unit tests
+ * for the sufficient statistics of the MiraBleu, MiraGtm and MiraWer
+ * scorers.
+ */
+
+#ifndef _MiraSuffStatsTest_h
+#define _MiraSuffStatsTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "stack_dec/BaseMiraScorer.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+class MiraSuffStatsTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( MiraSuffStatsTest );
+    CPPUNIT_TEST( testBleuSuffStats );
+    CPPUNIT_TEST( testGtmSuffStats );
+    CPPUNIT_TEST( testWerSuffStats );
+    CPPUNIT_TEST_SUITE_END();
+
+    private:
+        std::vector<std::string> system_sentences;
+        std::vector<std::string> reference_sentences;
+
+        // Checks that the sentence, background and corpus scores
+        // obtained from sufficient statistics are equal to those
+        // obtained from the sentences. Background corpora of both
+        // scorers are updated in the same way
+        void checkSuffStats(BaseMiraScorer* scorer,
+                            BaseMiraScorer* suffStatsScorer);
+
+    public:
+        void setUp();
+        void tearDown();
+
+        void testBleuSuffStats();
+        void testGtmSuffStats();
+        void testWerSuffStats();
+};
+
+#endif
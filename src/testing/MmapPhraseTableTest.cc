@@ -0,0 +1,250 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseTableTest.cc
+ * 
+ * @brief Definitions file for MmapPhraseTableTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "MmapPhraseTableTest.h"
+#include <fstream>
+#include <stdio.h>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( MmapPhraseTableTest );
+
+//--------------- MmapPhraseTableTest class functions
+//
+
+//---------------------------------------
+void MmapPhraseTableTest::setUp()
+{
+  ttableFileName="/tmp/thot_mmap_phrase_table_unit_test.ttable";
+  binFileName="/tmp/thot_mmap_phrase_table_unit_test.ttable.mmap";
+
+      // The same entries are stored in a text ttable and in a
+      // conventional phrase table
+  swVocab.clear();
+  stlTable.clear();
+  std::ofstream ttableF(ttableFileName.c_str());
+  addEntry(ttableF,"the house","la casa",10,6);
+  addEntry(ttableF,"house","la casa",20,1);
+  addEntry(ttableF,"home","la casa",4,2);
+  addEntry(ttableF,"the home","la casa",3,2);
+  addEntry(ttableF,"house","casa",20,12);
+  addEntry(ttableF,"home","casa",4,2);
+  addEntry(ttableF,"green","verde",5,5);
+  addEntry(ttableF,"the","la",50,0);
+  ttableF.close();
+
+  CPPUNIT_ASSERT( MmapPhraseTable::create(ttableFileName.c_str(),binFileName.c_str()) == THOT_OK );
+  CPPUNIT_ASSERT( MmapPhraseTable::isMmapPhraseTableFile(binFileName.c_str()) );
+  CPPUNIT_ASSERT( !MmapPhraseTable::isMmapPhraseTableFile(ttableFileName.c_str()) );
+  CPPUNIT_ASSERT( mmapTable.open(binFileName.c_str()) == THOT_OK );
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::tearDown()
+{
+  mmapTable.clear();
+  remove(ttableFileName.c_str());
+  remove(binFileName.c_str());
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::addEntry(std::ofstream& ttableF,
+                                   const std::string& s,
+                                   const std::string& t,
+                                   float c_s,
+                                   float c_st)
+{
+  ttableF<<s<<" ||| "<<t<<" ||| "<<c_s<<" "<<c_st<<std::endl;
+  PhrasePairInfo ppi;
+  ppi.first=c_s;
+  ppi.second=c_st;
+  stlTable.addTableEntry(srcPhrase(s),trgPhrase(t),ppi);
+}
+
+//---------------------------------------
+std::vector<WordIndex> MmapPhraseTableTest::srcPhrase(const std::string& s)
+{
+  return swVocab.strVectorToSrcIndexVector(StrProcUtils::stringToStringVector(s));
+}
+
+//---------------------------------------
+std::vector<WordIndex> MmapPhraseTableTest::trgPhrase(const std::string& t)
+{
+  return swVocab.strVectorToTrgIndexVector(StrProcUtils::stringToStringVector(t));
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::testCounts()
+{
+      // Vocabularies are the same as when loading the text ttable
+  CPPUNIT_ASSERT( mmapTable.getSrcVocabSize() == swVocab.getSrcVocabSize() );
+  CPPUNIT_ASSERT( mmapTable.getTrgVocabSize() == swVocab.getTrgVocabSize() );
+  for(WordIndex w=0;w<swVocab.getSrcVocabSize();++w)
+    CPPUNIT_ASSERT( mmapTable.srcWordIndexToString(w) == swVocab.wordIndexToSrcString(w) );
+
+  CPPUNIT_ASSERT( (float)mmapTable.cSrc(srcPhrase("house")) == 20 );
+  CPPUNIT_ASSERT( (float)mmapTable.cTrg(trgPhrase("la casa")) == 11 );
+  CPPUNIT_ASSERT( (float)mmapTable.cTrg(trgPhrase("la casa")) == (float)stlTable.cTrg(trgPhrase("la casa")) );
+  CPPUNIT_ASSERT( (float)mmapTable.cSrcTrg(srcPhrase("house"),trgPhrase("casa")) == 12 );
+  CPPUNIT_ASSERT( (float)mmapTable.cSrcTrg(srcPhrase("green"),trgPhrase("casa")) == 0 );
+  CPPUNIT_ASSERT( (float)mmapTable.cSrc(srcPhrase("red")) == 0 );
+
+  bool found;
+  mmapTable.getSrcTrgInfo(srcPhrase("the"),trgPhrase("la"),found);
+  CPPUNIT_ASSERT( found );
+  mmapTable.getSrcTrgInfo(srcPhrase("the"),trgPhrase("verde"),found);
+  CPPUNIT_ASSERT( !found );
+
+  CPPUNIT_ASSERT( (double)mmapTable.logpSrcGivenTrg(srcPhrase("home"),trgPhrase("la casa")) == (double)stlTable.logpSrcGivenTrg(srcPhrase("home"),trgPhrase("la casa")) );
+  CPPUNIT_ASSERT( (double)mmapTable.logpTrgGivenSrc(srcPhrase("home"),trgPhrase("la casa")) == (double)stlTable.logpTrgGivenSrc(srcPhrase("home"),trgPhrase("la casa")) );
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::testNbestForTrg()
+{
+  const char* trgPhrases[]={"la casa","casa","verde","la"};
+  for(unsigned int i=0;i<4;++i)
+  {
+    std::vector<WordIndex> t=trgPhrase(trgPhrases[i]);
+    for(int N=-1;N<=3;++N)
+    {
+      NbestTableNode<PhraseTransTableNodeData> mmapNbt;
+      NbestTableNode<PhraseTransTableNodeData> stlNbt;
+      bool mmapFound=mmapTable.getNbestForTrg(t,mmapNbt,N);
+      bool stlFound=stlTable.getNbestForTrg(t,stlNbt,N);
+      CPPUNIT_ASSERT( mmapFound == stlFound );
+      CPPUNIT_ASSERT( mmapNbt.size() == stlNbt.size() );
+
+          // Ties have to be broken in the same way
+      NbestTableNode<PhraseTransTableNodeData>::iterator mmapIter=mmapNbt.begin();
+      NbestTableNode<PhraseTransTableNodeData>::iterator stlIter=stlNbt.begin();
+      for(;mmapIter!=mmapNbt.end();++mmapIter,++stlIter)
+      {
+        CPPUNIT_ASSERT( mmapIter->first == stlIter->first );
+        CPPUNIT_ASSERT( mmapIter->second == stlIter->second );
+      }
+    }
+  }
+
+      // Entries with null joint count are not returned
+  NbestTableNode<PhraseTransTableNodeData> nbt;
+  CPPUNIT_ASSERT( !mmapTable.getNbestForTrg(trgPhrase("la"),nbt) );
+  CPPUNIT_ASSERT( !mmapTable.getNbestForTrg(trgPhrase("rojo"),nbt) );
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::testEntriesForSource()
+{
+  MmapPhraseTable::TrgTableNode mmapNode;
+  StlPhraseTable::TrgTableNode stlNode;
+  CPPUNIT_ASSERT( mmapTable.getEntriesForSource(srcPhrase("house"),mmapNode) );
+  stlTable.getEntriesForSource(srcPhrase("house"),stlNode);
+  CPPUNIT_ASSERT( mmapNode.size() == 2 );
+  CPPUNIT_ASSERT( mmapNode.size() == stlNode.size() );
+  MmapPhraseTable::TrgTableNode::iterator mmapIter=mmapNode.begin();
+  StlPhraseTable::TrgTableNode::iterator stlIter=stlNode.begin();
+  for(;mmapIter!=mmapNode.end();++mmapIter,++stlIter)
+  {
+    CPPUNIT_ASSERT( mmapIter->first == stlIter->first );
+    CPPUNIT_ASSERT( (float)mmapIter->second.first == (float)stlIter->second.first );
+    CPPUNIT_ASSERT( (float)mmapIter->second.second == (float)stlIter->second.second );
+  }
+
+      // The table is read-only
+  mmapTable.incrCountsOfEntry(srcPhrase("house"),trgPhrase("casa"),1);
+  CPPUNIT_ASSERT( (float)mmapTable.cSrcTrg(srcPhrase("house"),trgPhrase("casa")) == 12 );
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::testWordIndexMaps()
+{
+      // Model word indices are obtained by adding an offset to those
+      // of the file
+  const WordIndex offset=100;
+  std::vector<WordIndex> srcFileToModel;
+  for(WordIndex w=0;w<mmapTable.getSrcVocabSize();++w)
+    srcFileToModel.push_back(w+offset);
+  std::vector<WordIndex> trgFileToModel;
+  for(WordIndex w=0;w<mmapTable.getTrgVocabSize();++w)
+    trgFileToModel.push_back(w+offset);
+  mmapTable.setWordIndexMaps(srcFileToModel,trgFileToModel);
+
+  std::vector<WordIndex> s=srcPhrase("house");
+  std::vector<WordIndex> t=trgPhrase("casa");
+  CPPUNIT_ASSERT( (float)mmapTable.cSrcTrg(s,t) == 0 );
+  for(unsigned int i=0;i<s.size();++i)
+    s[i]+=offset;
+  for(unsigned int i=0;i<t.size();++i)
+    t[i]+=offset;
+  CPPUNIT_ASSERT( (float)mmapTable.cSrcTrg(s,t) == 12 );
+
+  NbestTableNode<PhraseTransTableNodeData> nbt;
+  CPPUNIT_ASSERT( mmapTable.getNbestForTrg(t,nbt,1) );
+  CPPUNIT_ASSERT( nbt.size() == 1 );
+  CPPUNIT_ASSERT( nbt.getBestElem() == s );
+}
+
+//---------------------------------------
+void MmapPhraseTableTest::testNbestTiesWithWordIndexMaps()
+{
+      // Source word indices of the model are given in reverse order
+      // with respect to those of the file, so "the home" precedes
+      // "home" in the file but not in the model
+  std::vector<WordIndex> srcFileToModel;
+  WordIndex srcVocabSize=mmapTable.getSrcVocabSize();
+  for(WordIndex w=0;w<srcVocabSize;++w)
+    srcFileToModel.push_back(srcVocabSize-1-w);
+  std::vector<WordIndex> trgFileToModel;
+  for(WordIndex w=0;w<mmapTable.getTrgVocabSize();++w)
+    trgFileToModel.push_back(w);
+  mmapTable.setWordIndexMaps(srcFileToModel,trgFileToModel);
+
+  std::vector<WordIndex> home=srcPhrase("home");
+  std::vector<WordIndex> theHome=srcPhrase("the home");
+  for(unsigned int i=0;i<home.size();++i)
+    home[i]=srcFileToModel[home[i]];
+  for(unsigned int i=0;i<theHome.size();++i)
+    theHome[i]=srcFileToModel[theHome[i]];
+  CPPUNIT_ASSERT( srcPhrase("the home") < srcPhrase("home") );
+  CPPUNIT_ASSERT( home < theHome );
+
+      // "home" and "the home" are tied for "la casa", the tie is
+      // broken using the word indices of the model, both when the
+      // n-best list is cut and when it is not
+  NbestTableNode<PhraseTransTableNodeData> nbt;
+  CPPUNIT_ASSERT( mmapTable.getNbestForTrg(trgPhrase("la casa"),nbt,2) );
+  CPPUNIT_ASSERT( nbt.size() == 2 );
+  NbestTableNode<PhraseTransTableNodeData>::iterator iter=nbt.begin();
+  ++iter;
+  CPPUNIT_ASSERT( iter->second == home );
+
+  CPPUNIT_ASSERT( mmapTable.getNbestForTrg(trgPhrase("la casa"),nbt) );
+  CPPUNIT_ASSERT( nbt.size() == 4 );
+  iter=nbt.begin();
+  ++iter;
+  CPPUNIT_ASSERT( iter->second == home );
+  ++iter;
+  CPPUNIT_ASSERT( iter->second == theHome );
+}
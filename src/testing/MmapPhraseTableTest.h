@@ -0,0 +1,91 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file MmapPhraseTableTest.h
+ *
+ * @brief Declares the MmapPhraseTableTest class implementing unit
+ * tests for the MmapPhraseTable class.
+ */
+
+#ifndef _MmapPhraseTableTest_h
+#define _MmapPhraseTableTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "MmapPhraseTable.h"
+#include "StlPhraseTable.h"
+#include "SingleWordVocab.h"
+#include "StrProcUtils.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- MmapPhraseTableTest class
+
+/**
+ * @brief Class implementing tests for MmapPhraseTable.
+ */
+
+class MmapPhraseTableTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( MmapPhraseTableTest );
+  CPPUNIT_TEST( testCounts );
+  CPPUNIT_TEST( testNbestForTrg );
+  CPPUNIT_TEST( testEntriesForSource );
+  CPPUNIT_TEST( testWordIndexMaps );
+  CPPUNIT_TEST( testNbestTiesWithWordIndexMaps );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testCounts();
+  void testNbestForTrg();
+  void testEntriesForSource();
+  void testWordIndexMaps();
+  void testNbestTiesWithWordIndexMaps();
+
+ private:
+  std::string ttableFileName;
+  std::string binFileName;
+  SingleWordVocab swVocab;
+  StlPhraseTable stlTable;
+  MmapPhraseTable mmapTable;
+
+  void addEntry(std::ofstream& ttableF,
+                const std::string& s,
+                const std::string& t,
+                float c_s,
+                float c_st);
+  std::vector<WordIndex> srcPhrase(const std::string& s);
+  std::vector<WordIndex> trgPhrase(const std::string& t);
+};
+
+#endif
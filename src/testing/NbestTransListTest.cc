@@ -0,0 +1,88 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NbestTransListTest.cc
+ * 
+ * @brief Definitions file for NbestTransListTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "NbestTransListTest.h"
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( NbestTransListTest );
+
+//--------------- NbestTransListTest class functions
+//
+
+//---------------------------------------
+void NbestTransListTest::setUp()
+{
+}
+
+//---------------------------------------
+void NbestTransListTest::tearDown()
+{
+  nbtList.clear();
+}
+
+//---------------------------------------
+void NbestTransListTest::testOrder()
+{
+  NbestTableNode<PhraseTransTableNodeData> nbt;
+  PhraseTransTableNodeData trgPhrase;
+
+  trgPhrase.push_back(1);
+  nbt.insert(-2,trgPhrase);
+  trgPhrase.push_back(2);
+  nbt.insert(-1,trgPhrase);
+  trgPhrase.push_back(3);
+  nbt.insert(-2,trgPhrase);
+  nbtList.init(nbt);
+
+      // Best translations first, ties in insertion order
+  CPPUNIT_ASSERT( nbtList.size() == 3 );
+  CPPUNIT_ASSERT( nbtList.getScore(0) == -1 );
+  CPPUNIT_ASSERT( nbtList.getTrgPhrase(0).size() == 2 );
+  CPPUNIT_ASSERT( nbtList.getScore(1) == -2 );
+  CPPUNIT_ASSERT( nbtList.getTrgPhrase(1).size() == 1 );
+  CPPUNIT_ASSERT( nbtList.getScore(2) == -2 );
+  CPPUNIT_ASSERT( nbtList.getTrgPhrase(2).size() == 3 );
+
+      // The list does not depend on the node it was built from
+  nbt.clear();
+  CPPUNIT_ASSERT( nbtList.size() == 3 );
+  CPPUNIT_ASSERT( nbtList.getTrgPhrase(2)[2] == 3 );
+}
+
+//---------------------------------------
+void NbestTransListTest::testSingle()
+{
+  PhraseTransTableNodeData trgPhrase;
+  trgPhrase.push_back(7);
+
+  nbtList.initSingle(0,trgPhrase);
+  CPPUNIT_ASSERT( nbtList.size() == 1 );
+  CPPUNIT_ASSERT( nbtList.getScore(0) == 0 );
+  CPPUNIT_ASSERT( nbtList.getTrgPhrase(0)[0] == 7 );
+
+  nbtList.clear();
+  CPPUNIT_ASSERT( nbtList.empty() );
+}
@@ -0,0 +1,64 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NbestTransListTest.h
+ *
+ * @brief Declares the NbestTransListTest class implementing unit
+ * tests for the NbestTransList class.
+ */
+
+#ifndef _NbestTransListTest_h
+#define _NbestTransListTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "NbestTransList.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- NbestTransListTest class
+
+/**
+ * @brief Class implementing tests for NbestTransList.
+ */
+
+class NbestTransListTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( NbestTransListTest );
+  CPPUNIT_TEST( testOrder );
+  CPPUNIT_TEST( testSingle );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testOrder();
+  void testSingle();
+
+ private:
+  NbestTransList nbtList;
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file NgramCounterTest.cc
+ * 
+ * @brief Definitions file for NgramCounterTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "NgramCounterTest.h"
+#include <map>
+#include <vector>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( NgramCounterTest );
+
+//--------------- Handler used in the tests
+
+typedef std::map<std::vector<WordIndex>,std::pair<NgramCounter::NgramCount,NgramCounter::NgramCount> > NgramCountMap;
+
+class NgramCountCollector: public NgramCounter::NgramCountHandler
+{
+ public:
+  NgramCountMap countMap;
+  std::vector<std::vector<WordIndex> > ngramSeq;
+
+  int handleNgram(const WordIndex* ngram,
+                  unsigned int len,
+                  NgramCounter::NgramCount histCount,
+                  NgramCounter::NgramCount count)
+  {
+    std::vector<WordIndex> ngramVec(ngram,ngram+len);
+    countMap[ngramVec]=std::make_pair(histCount,count);
+    ngramSeq.push_back(ngramVec);
+    return THOT_OK;
+  }
+};
+
+static std::vector<WordIndex> makeNgram(WordIndex w1,
+                                        WordIndex w2)
+{
+  std::vector<WordIndex> ngram;
+  ngram.push_back(w1);
+  ngram.push_back(w2);
+  return ngram;
+}
+
+//--------------- NgramCounterTest class functions
+//
+
+//---------------------------------------
+void NgramCounterTest::setUp()
+{
+}
+
+//---------------------------------------
+void NgramCounterTest::tearDown()
+{
+}
+
+//---------------------------------------
+void NgramCounterTest::testCounts()
+{
+      // Corpus with sentences "a b a" and "b"
+  WordIndex a=4;
+  WordIndex b=5;
+  std::vector<std::vector<WordIndex> > sentences(2);
+  sentences[0].push_back(a);
+  sentences[0].push_back(b);
+  sentences[0].push_back(a);
+  sentences[1].push_back(b);
+
+  NgramCounter ngramCounter;
+  CPPUNIT_ASSERT( ngramCounter.setOrder(2) == THOT_OK );
+  CPPUNIT_ASSERT( ngramCounter.addSentences(sentences) == THOT_OK );
+  NgramCountCollector collector;
+  CPPUNIT_ASSERT( ngramCounter.extractCounts(collector) == THOT_OK );
+
+  NgramCountMap& countMap=collector.countMap;
+  CPPUNIT_ASSERT( countMap.size() == 10 );
+
+      // Unigrams, the history count is the number of words including
+      // the sentence begin and end symbols
+  CPPUNIT_ASSERT( countMap[std::vector<WordIndex>(1,a)] == std::make_pair(8ULL,2ULL) );
+  CPPUNIT_ASSERT( countMap[std::vector<WordIndex>(1,b)] == std::make_pair(8ULL,2ULL) );
+  CPPUNIT_ASSERT( countMap[std::vector<WordIndex>(1,S_BEGIN)] == std::make_pair(8ULL,2ULL) );
+  CPPUNIT_ASSERT( countMap[std::vector<WordIndex>(1,S_END)] == std::make_pair(8ULL,2ULL) );
+
+      // Bigrams
+  CPPUNIT_ASSERT( countMap[makeNgram(S_BEGIN,a)] == std::make_pair(2ULL,1ULL) );
+  CPPUNIT_ASSERT( countMap[makeNgram(S_BEGIN,b)] == std::make_pair(2ULL,1ULL) );
+  CPPUNIT_ASSERT( countMap[makeNgram(a,b)] == std::make_pair(2ULL,1ULL) );
+  CPPUNIT_ASSERT( countMap[makeNgram(b,a)] == std::make_pair(2ULL,1ULL) );
+  CPPUNIT_ASSERT( countMap[makeNgram(a,S_END)] == std::make_pair(2ULL,1ULL) );
+  CPPUNIT_ASSERT( countMap[makeNgram(b,S_END)] == std::make_pair(2ULL,1ULL) );
+
+      // The counter is empty after extracting the counts
+  CPPUNIT_ASSERT( ngramCounter.numEntriesInMem() == 0 );
+}
+
+//---------------------------------------
+void NgramCounterTest::testSpilledCountsMatchInMemoryCounts()
+{
+  std::vector<std::vector<WordIndex> > sentences;
+  for(unsigned int s=0;s<200;++s)
+  {
+    std::vector<WordIndex> sentence;
+    for(unsigned int i=0;i<s%13;++i)
+      sentence.push_back(4+((s*7+i*i)%17));
+    sentences.push_back(sentence);
+  }
+
+      // Count n-grams in memory with a single thread
+  NgramCounter inMemCounter;
+  inMemCounter.setOrder(4);
+  CPPUNIT_ASSERT( inMemCounter.addSentences(sentences) == THOT_OK );
+  CPPUNIT_ASSERT( inMemCounter.numRunFiles() == 0 );
+  NgramCountCollector inMemCollector;
+  CPPUNIT_ASSERT( inMemCounter.extractCounts(inMemCollector) == THOT_OK );
+
+      // Count n-grams with several threads adding the sentences in
+      // small blocks, forcing the counts to be written to disk
+  NgramCounter spillCounter;
+  spillCounter.setOrder(4);
+  spillCounter.setNumThreads(3);
+  spillCounter.setMaxEntriesInMem(100);
+  for(unsigned int s=0;s<sentences.size();s+=20)
+  {
+    std::vector<std::vector<WordIndex> > block(sentences.begin()+s,sentences.begin()+s+20);
+    CPPUNIT_ASSERT( spillCounter.addSentences(block) == THOT_OK );
+  }
+  CPPUNIT_ASSERT( spillCounter.numRunFiles() > 0 );
+  NgramCountCollector spillCollector;
+  CPPUNIT_ASSERT( spillCounter.extractCounts(spillCollector) == THOT_OK );
+  CPPUNIT_ASSERT( spillCounter.numRunFiles() == 0 );
+
+      // Both counters should produce the same n-grams in the same
+      // order
+  CPPUNIT_ASSERT( inMemCollector.ngramSeq == spillCollector.ngramSeq );
+  CPPUNIT_ASSERT( inMemCollector.countMap == spillCollector.countMap );
+}
+
+//---------------------------------------
+void NgramCounterTest::testInvalidOrder()
+{
+  NgramCounter ngramCounter;
+  CPPUNIT_ASSERT( ngramCounter.setOrder(0) == THOT_ERROR );
+  CPPUNIT_ASSERT( ngramCounter.setOrder(NGRAM_COUNTER_MAX_ORDER+1) == THOT_ERROR );
+  CPPUNIT_ASSERT( ngramCounter.setOrder(NGRAM_COUNTER_MAX_ORDER) == THOT_OK );
+}
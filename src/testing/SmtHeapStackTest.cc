@@ -0,0 +1,180 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SmtHeapStackTest.cc
+ * 
+ * @brief Definitions file for SmtHeapStackTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "SmtHeapStackTest.h"
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( SmtHeapStackTest );
+
+//--------------- SmtHeapStackTest class functions
+//
+
+//---------------------------------------
+void SmtHeapStackTest::setUp()
+{
+}
+
+//---------------------------------------
+void SmtHeapStackTest::tearDown()
+{
+}
+
+//---------------------------------------
+void SmtHeapStackTest::testPopOrder()
+{
+  SmtHeapStack<TestHyp> stack;
+  stack.push(TestHyp(-3,0));
+  stack.push(TestHyp(-1,1));
+  stack.push(TestHyp(-2,2));
+  stack.push(TestHyp(-1,3));
+  stack.push(TestHyp(-5,4));
+
+      // Hypotheses are popped by decreasing score, ties are resolved
+      // by insertion order
+  CPPUNIT_ASSERT( stack.size() == 5 );
+  CPPUNIT_ASSERT( stack.last().id == 4 );
+  CPPUNIT_ASSERT( stack.pop().id == 1 );
+  CPPUNIT_ASSERT( stack.pop().id == 3 );
+  CPPUNIT_ASSERT( stack.pop().id == 2 );
+  CPPUNIT_ASSERT( stack.pop().id == 0 );
+  CPPUNIT_ASSERT( stack.pop().id == 4 );
+  CPPUNIT_ASSERT( stack.empty() );
+}
+
+//---------------------------------------
+void SmtHeapStackTest::testBoundedPush()
+{
+  SmtHeapStack<TestHyp> stack;
+  stack.setMaxStackSize(2);
+
+  CPPUNIT_ASSERT( stack.push(TestHyp(-2,0)) );
+  CPPUNIT_ASSERT( stack.push(TestHyp(-4,1)) );
+
+      // Hypotheses not better than the worst one are rejected
+  CPPUNIT_ASSERT( !stack.push(TestHyp(-4,2)) );
+  CPPUNIT_ASSERT( !stack.push(TestHyp(-6,3)) );
+
+      // Better hypotheses evict the worst one
+  CPPUNIT_ASSERT( stack.push(TestHyp(-1,4)) );
+  CPPUNIT_ASSERT( stack.size() == 2 );
+  CPPUNIT_ASSERT( stack.last().id == 0 );
+  CPPUNIT_ASSERT( stack.top().id == 4 );
+
+      // Storage is reused after clearing the stack
+  stack.clear();
+  CPPUNIT_ASSERT( stack.empty() );
+  CPPUNIT_ASSERT( stack.push(TestHyp(-7,5)) );
+  CPPUNIT_ASSERT( stack.top().id == 5 );
+}
+
+//---------------------------------------
+void SmtHeapStackTest::testRemove()
+{
+  SmtHeapStack<TestHyp> stack;
+  SmtHeapStack<TestHyp>::HypHandle h0=stack.pushHandle(TestHyp(-1,0));
+  SmtHeapStack<TestHyp>::HypHandle h1=stack.pushHandle(TestHyp(-2,1));
+  SmtHeapStack<TestHyp>::HypHandle h2=stack.pushHandle(TestHyp(-3,2));
+
+  CPPUNIT_ASSERT( stack.getHyp(h1).id == 1 );
+  stack.remove(h1);
+  CPPUNIT_ASSERT( stack.size() == 2 );
+  stack.remove(h0);
+  CPPUNIT_ASSERT( stack.top().id == 2 );
+  CPPUNIT_ASSERT( stack.last().id == 2 );
+  stack.remove(h2);
+  CPPUNIT_ASSERT( stack.empty() );
+}
+
+//---------------------------------------
+void SmtHeapStackTest::testSameBehaviourAsSmtStack()
+{
+  SmtStack<TestHyp> smtStack;
+  SmtHeapStack<TestHyp> smtHeapStack;
+  smtStack.setMaxStackSize(10);
+  smtHeapStack.setMaxStackSize(10);
+
+      // Push hypotheses with repeated scores and pop some of them
+      // after each round
+  unsigned int id=0;
+  for(unsigned int round=0;round<20;++round)
+  {
+    for(unsigned int i=0;i<15;++i)
+    {
+      TestHyp hyp(-(Score)((id*7919)%13),id);
+      CPPUNIT_ASSERT( smtStack.push(hyp) == smtHeapStack.push(hyp) );
+      ++id;
+    }
+    CPPUNIT_ASSERT( smtStack.size() == smtHeapStack.size() );
+    CPPUNIT_ASSERT( smtStack.last().id == smtHeapStack.last().id );
+    for(unsigned int i=0;i<3;++i)
+    {
+      CPPUNIT_ASSERT( smtStack.pop().id == smtHeapStack.pop().id );
+    }
+  }
+  while(!smtStack.empty())
+  {
+    CPPUNIT_ASSERT( smtStack.pop().id == smtHeapStack.pop().id );
+  }
+  CPPUNIT_ASSERT( smtHeapStack.empty() );
+}
+
+//---------------------------------------
+void SmtHeapStackTest::testSmtStackHandles()
+{
+      // SmtStack provides the handle-based interface of SmtHeapStack,
+      // so both classes can be used as sub-stacks of SmtMultiStackRec
+  SmtStack<TestHyp> smtStack;
+  SmtHeapStack<TestHyp> smtHeapStack;
+  smtStack.setMaxStackSize(3);
+  smtHeapStack.setMaxStackSize(3);
+
+  SmtStack<TestHyp>::HypHandle sh=smtStack.pushHandle(TestHyp(-2,0));
+  SmtHeapStack<TestHyp>::HypHandle hh=smtHeapStack.pushHandle(TestHyp(-2,0));
+  CPPUNIT_ASSERT( smtStack.getHyp(sh).id == smtHeapStack.getHyp(hh).id );
+  for(unsigned int id=1;id<5;++id)
+  {
+    TestHyp hyp(-(Score)id,id);
+    CPPUNIT_ASSERT( (smtStack.pushHandle(hyp)==smtStack.nullHandle()) ==
+                    (smtHeapStack.pushHandle(hyp)==smtHeapStack.nullHandle()) );
+  }
+  CPPUNIT_ASSERT( smtStack.topScore() == smtHeapStack.topScore() );
+  CPPUNIT_ASSERT( smtStack.lastScore() == smtHeapStack.lastScore() );
+  CPPUNIT_ASSERT( smtStack.getHyp(smtStack.lastHandle()).id == smtHeapStack.getHyp(smtHeapStack.lastHandle()).id );
+
+  std::vector<SmtStack<TestHyp>::HypHandle> smtStackHandles;
+  std::vector<SmtHeapStack<TestHyp>::HypHandle> smtHeapStackHandles;
+  smtStack.getSortedHandles(smtStackHandles);
+  smtHeapStack.getSortedHandles(smtHeapStackHandles);
+  CPPUNIT_ASSERT( smtStackHandles.size() == smtHeapStackHandles.size() );
+  for(unsigned int i=0;i<smtStackHandles.size();++i)
+    CPPUNIT_ASSERT( smtStack.getHyp(smtStackHandles[i]).id == smtHeapStack.getHyp(smtHeapStackHandles[i]).id );
+
+  smtStack.remove(sh);
+  smtHeapStack.remove(hh);
+  CPPUNIT_ASSERT( smtStack.size() == 2 );
+  CPPUNIT_ASSERT( smtStack.top().id == smtHeapStack.top().id );
+  CPPUNIT_ASSERT( smtStack.last().id == smtHeapStack.last().id );
+}
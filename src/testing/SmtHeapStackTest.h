@@ -0,0 +1,92 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SmtHeapStackTest.h
+ *
+ * @brief Declares the SmtHeapStackTest class implementing unit tests
+ * for the SmtHeapStack class.
+ */
+
+#ifndef _SmtHeapStackTest_h
+#define _SmtHeapStackTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "SmtHeapStack.h"
+#include "SmtStack.h"
+#include "Score.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- TestHyp class
+
+/**
+ * @brief Minimal hypothesis class used to test stacks.
+ */
+
+class TestHyp
+{
+ public:
+  Score score;
+  unsigned int id;
+
+  TestHyp(void){score=0; id=0;}
+  TestHyp(Score _score,unsigned int _id){score=_score; id=_id;}
+  Score getScore(void)const{return score;}
+};
+
+//--------------- SmtHeapStackTest class
+
+/**
+ * @brief Class implementing tests for SmtHeapStack.
+ */
+
+class SmtHeapStackTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SmtHeapStackTest );
+  CPPUNIT_TEST( testPopOrder );
+  CPPUNIT_TEST( testBoundedPush );
+  CPPUNIT_TEST( testRemove );
+  CPPUNIT_TEST( testSameBehaviourAsSmtStack );
+  CPPUNIT_TEST( testSmtStackHandles );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testPopOrder();
+  void testBoundedPush();
+  void testRemove();
+  void testSameBehaviourAsSmtStack();
+  void testSmtStackHandles();
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SocketEventPollerTest.cc
+ * 
+ * @brief Definitions file for SocketEventPollerTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "SocketEventPollerTest.h"
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( SocketEventPollerTest );
+
+//--------------- SocketEventPollerTest class functions
+//
+
+//---------------------------------------
+void SocketEventPollerTest::setUp()
+{
+}
+
+//---------------------------------------
+void SocketEventPollerTest::tearDown()
+{
+}
+
+//---------------------------------------
+void SocketEventPollerTest::testConnectionIsReportedOnce()
+{
+  int sv[2];
+  CPPUNIT_ASSERT( socketpair(AF_UNIX,SOCK_STREAM,0,sv) == 0 );
+
+  SocketEventPoller poller;
+  CPPUNIT_ASSERT( poller.init() == THOT_OK );
+  CPPUNIT_ASSERT( poller.addConnection(sv[0]) == THOT_OK );
+
+      // Nothing to read
+  std::vector<int> readyFdVec;
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,0) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.empty() );
+
+      // Data is reported once
+  char c='a';
+  CPPUNIT_ASSERT( write(sv[1],&c,1) == 1 );
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,1000) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.size() == 1 );
+  CPPUNIT_ASSERT( readyFdVec[0] == sv[0] );
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,0) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.empty() );
+
+      // Unread data is reported again after re-arming the socket
+  CPPUNIT_ASSERT( poller.rearm(sv[0]) == THOT_OK );
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,1000) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.size() == 1 );
+  CPPUNIT_ASSERT( readyFdVec[0] == sv[0] );
+
+  CPPUNIT_ASSERT( poller.remove(sv[0]) == THOT_OK );
+  close(sv[0]);
+  close(sv[1]);
+}
+
+//---------------------------------------
+void SocketEventPollerTest::testListenerIsReportedAgain()
+{
+  int sv[2];
+  CPPUNIT_ASSERT( socketpair(AF_UNIX,SOCK_STREAM,0,sv) == 0 );
+
+  SocketEventPoller poller;
+  CPPUNIT_ASSERT( poller.init() == THOT_OK );
+  CPPUNIT_ASSERT( poller.addListener(sv[0]) == THOT_OK );
+
+  char c='a';
+  CPPUNIT_ASSERT( write(sv[1],&c,1) == 1 );
+  std::vector<int> readyFdVec;
+  for(unsigned int i=0;i<2;++i)
+  {
+    CPPUNIT_ASSERT( poller.wait(readyFdVec,1000) == THOT_OK );
+    CPPUNIT_ASSERT( readyFdVec.size() == 1 );
+    CPPUNIT_ASSERT( readyFdVec[0] == sv[0] );
+  }
+
+      // Reading the data stops the notifications
+  CPPUNIT_ASSERT( read(sv[0],&c,1) == 1 );
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,0) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.empty() );
+
+  CPPUNIT_ASSERT( poller.remove(sv[0]) == THOT_OK );
+  close(sv[0]);
+  close(sv[1]);
+}
+
+//---------------------------------------
+void SocketEventPollerTest::testWakeUp()
+{
+  SocketEventPoller poller;
+  CPPUNIT_ASSERT( poller.init() == THOT_OK );
+
+      // wait() returns without ready sockets
+  poller.wakeUp();
+  std::vector<int> readyFdVec;
+  CPPUNIT_ASSERT( poller.wait(readyFdVec,-1) == THOT_OK );
+  CPPUNIT_ASSERT( readyFdVec.empty() );
+}
@@ -0,0 +1,69 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file SocketEventPollerTest.h
+ *
+ * @brief Declares the SocketEventPollerTest class implementing unit
+ * tests for the SocketEventPoller class.
+ */
+
+#ifndef _SocketEventPollerTest_h
+#define _SocketEventPollerTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "SocketEventPoller.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- SocketEventPollerTest class
+
+/**
+ * @brief Class implementing tests for SocketEventPoller.
+ */
+
+class SocketEventPollerTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SocketEventPollerTest );
+  CPPUNIT_TEST( testConnectionIsReportedOnce );
+  CPPUNIT_TEST( testListenerIsReportedAgain );
+  CPPUNIT_TEST( testWakeUp );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testConnectionIsReportedOnce();
+  void testListenerIsReportedAgain();
+  void testWakeUp();
+};
+
+#endif
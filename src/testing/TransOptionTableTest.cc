@@ -0,0 +1,122 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file TransOptionTableTest.cc
+ * 
+ * @brief Definitions file for TransOptionTableTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "TransOptionTableTest.h"
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( TransOptionTableTest );
+
+//--------------- TransOptionTableTest class functions
+//
+
+//---------------------------------------
+void TransOptionTableTest::setUp()
+{
+      // Sentence with 3 words, source phrases with up to 2 words and
+      // 2 scores per option
+  table.init(3,2,2);
+
+  std::vector<WordIndex> trgPhrase;
+  std::vector<Score> scoreVec(2);
+
+  trgPhrase.push_back(10);
+  scoreVec[0]=-1; scoreVec[1]=-2;
+  table.addOption(1,1,trgPhrase,scoreVec);
+  trgPhrase.push_back(11);
+  scoreVec[0]=-3; scoreVec[1]=-4;
+  table.addOption(1,1,trgPhrase,scoreVec);
+
+  trgPhrase.clear();
+  trgPhrase.push_back(10);
+  scoreVec[0]=-5; scoreVec[1]=-6;
+  table.addOption(2,3,trgPhrase,scoreVec);
+}
+
+//---------------------------------------
+void TransOptionTableTest::tearDown()
+{
+  table.clear();
+}
+
+//---------------------------------------
+void TransOptionTableTest::testSpanOptions()
+{
+  PositionIndex trgPhraseLen;
+
+  CPPUNIT_ASSERT( table.size() == 3 );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(1,1) == 0 );
+  CPPUNIT_ASSERT( table.getNumOptions(1,1) == 2 );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(2,3) == 2 );
+  CPPUNIT_ASSERT( table.getNumOptions(2,3) == 1 );
+
+      // Options are stored in the order they were added
+  const WordIndex* trgPhrase=table.getTrgPhrase(1,trgPhraseLen);
+  CPPUNIT_ASSERT( trgPhraseLen == 2 );
+  CPPUNIT_ASSERT( trgPhrase[0] == 10 );
+  CPPUNIT_ASSERT( trgPhrase[1] == 11 );
+  trgPhrase=table.getTrgPhrase(2,trgPhraseLen);
+  CPPUNIT_ASSERT( trgPhraseLen == 1 );
+  CPPUNIT_ASSERT( trgPhrase[0] == 10 );
+
+      // Spans without options
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(2,2) == TRANS_OPT_NOT_FOUND );
+  CPPUNIT_ASSERT( table.getNumOptions(2,2) == 0 );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(1,2) == TRANS_OPT_NOT_FOUND );
+}
+
+//---------------------------------------
+void TransOptionTableTest::testScores()
+{
+  CPPUNIT_ASSERT( table.getNumScores() == 2 );
+  const Score* scores=table.getScores(table.getFirstOptionIdx(1,1)+1);
+  CPPUNIT_ASSERT( scores[0] == -3 );
+  CPPUNIT_ASSERT( scores[1] == -4 );
+  scores=table.getScores(table.getFirstOptionIdx(2,3));
+  CPPUNIT_ASSERT( scores[0] == -5 );
+  CPPUNIT_ASSERT( scores[1] == -6 );
+}
+
+//---------------------------------------
+void TransOptionTableTest::testInvalidSpans()
+{
+  std::vector<WordIndex> trgPhraseVec(1,10);
+  std::vector<Score> scoreVec(2,0);
+
+      // Spans out of the sentence or longer than the maximum source
+      // phrase length are ignored
+  table.addOption(1,3,trgPhraseVec,scoreVec);
+  table.addOption(3,4,trgPhraseVec,scoreVec);
+  CPPUNIT_ASSERT( table.size() == 3 );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(1,3) == TRANS_OPT_NOT_FOUND );
+  CPPUNIT_ASSERT( table.getNumOptions(1,3) == 0 );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(0,1) == TRANS_OPT_NOT_FOUND );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(3,4) == TRANS_OPT_NOT_FOUND );
+
+      // Clearing the table removes all of the options
+  table.clear();
+  CPPUNIT_ASSERT( table.empty() );
+  CPPUNIT_ASSERT( table.getFirstOptionIdx(2,3) == TRANS_OPT_NOT_FOUND );
+}
@@ -0,0 +1,66 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file TransOptionTableTest.h
+ *
+ * @brief Declares the TransOptionTableTest class implementing unit
+ * tests for the TransOptionTable class.
+ */
+
+#ifndef _TransOptionTableTest_h
+#define _TransOptionTableTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "TransOptionTable.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- TransOptionTableTest class
+
+/**
+ * @brief Class implementing tests for TransOptionTable.
+ */
+
+class TransOptionTableTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TransOptionTableTest );
+  CPPUNIT_TEST( testSpanOptions );
+  CPPUNIT_TEST( testScores );
+  CPPUNIT_TEST( testInvalidSpans );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testSpanOptions();
+  void testScores();
+  void testInvalidSpans();
+
+ private:
+  TransOptionTable table;
+};
+
+#endif
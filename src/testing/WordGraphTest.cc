@@ -0,0 +1,237 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WordGraphTest.cc
+ * 
+ * @brief Definitions file for WordGraphTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "WordGraphTest.h"
+#include <stdio.h>
+#include <sstream>
+
+//--------------- Constants ------------------------------------------
+
+#define WG_TEST_BIN_FILE "/tmp/thot_word_graph_unit_test.wgb"
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( WordGraphTest );
+
+//--------------- WordGraphTest class functions
+//
+
+//---------------------------------------
+void WordGraphTest::setUp()
+{
+      // Word graph with two paths from the initial state to the final
+      // state 3: "a b d" (score -2) and "c a" (score -2.5)
+  wg.clear();
+  wg.addArc(0,1,strToVec("a b"),-1);
+  wg.addArc(0,2,strToVec("c"),-2);
+  wg.addArc(1,3,strToVec("d"),-1);
+  wg.addArc(2,3,strToVec("a"),-0.5);
+  wg.addFinalState(3);
+}
+
+//---------------------------------------
+void WordGraphTest::tearDown()
+{
+  remove(WG_TEST_BIN_FILE);
+}
+
+//---------------------------------------
+void WordGraphTest::testArcWords()
+{
+  CPPUNIT_ASSERT( wg.numArcs() == 4 );
+  CPPUNIT_ASSERT( wg.numStates() == 4 );
+
+      // Words are stored only once in the vocabulary
+  CPPUNIT_ASSERT( wg.getVocabSize() == 4 );
+  WordIndex aIdx;
+  CPPUNIT_ASSERT( wg.existString("a",aIdx) );
+  CPPUNIT_ASSERT( wg.wordIndexToString(aIdx) == "a" );
+  WordIndex eIdx;
+  CPPUNIT_ASSERT( !wg.existString("e",eIdx) );
+
+  WordGraphArc wgArc=wg.wordGraphArcId2WordGraphArc(0);
+  CPPUNIT_ASSERT( wgArc.numWords == 2 );
+  CPPUNIT_ASSERT( wg.getArcWord(wgArc,0) == "a" );
+  CPPUNIT_ASSERT( wg.getArcWord(wgArc,1) == "b" );
+  CPPUNIT_ASSERT( wg.getArcWordIndex(wgArc,0) == aIdx );
+
+  wgArc=wg.wordGraphArcId2WordGraphArc(3);
+  CPPUNIT_ASSERT( wgArc.numWords == 1 );
+  CPPUNIT_ASSERT( wg.getArcWordIndex(wgArc,0) == aIdx );
+  std::vector<std::string> words;
+  wg.getArcWords(wgArc,words);
+  CPPUNIT_ASSERT( words == strToVec("a") );
+}
+
+//---------------------------------------
+void WordGraphTest::testAdjacency()
+{
+  WordGraph::ArcIdRange range=wg.getArcIdRangeToSuccStates(0);
+  CPPUNIT_ASSERT( range.second-range.first == 2 );
+  CPPUNIT_ASSERT( range.first[0] == 0 );
+  CPPUNIT_ASSERT( range.first[1] == 1 );
+
+  range=wg.getArcIdRangeToPredStates(3);
+  CPPUNIT_ASSERT( range.second-range.first == 2 );
+  CPPUNIT_ASSERT( range.first[0] == 2 );
+  CPPUNIT_ASSERT( range.first[1] == 3 );
+
+  range=wg.getArcIdRangeToSuccStates(3);
+  CPPUNIT_ASSERT( range.first == range.second );
+
+      // Adjacency information is updated when new arcs are added
+  wg.addArc(1,4,strToVec("e"),-3);
+  range=wg.getArcIdRangeToSuccStates(1);
+  CPPUNIT_ASSERT( range.second-range.first == 2 );
+  CPPUNIT_ASSERT( range.first[1] == 4 );
+
+  WordGraphStateData wgsData=wg.getWordGraphStateData(1);
+  CPPUNIT_ASSERT( wgsData.arcsToPredStates.size() == 1 );
+  CPPUNIT_ASSERT( wgsData.arcsToSuccStates.size() == 2 );
+}
+
+//---------------------------------------
+void WordGraphTest::testBestPathWithExcludedArcs()
+{
+  std::vector<WordGraphArc> arcVec;
+  std::vector<bool> excludedArcs;
+  Score score=wg.bestPathFromFinalStateToIdx(INITIAL_STATE,excludedArcs,arcVec);
+  CPPUNIT_ASSERT( score == -2 );
+  CPPUNIT_ASSERT( arcVec.size() == 2 );
+  CPPUNIT_ASSERT( arcWordsToStr(wg,arcVec[1]) == "a b" );
+  CPPUNIT_ASSERT( arcWordsToStr(wg,arcVec[0]) == "d" );
+
+      // Exclude the first arc of the best path
+  excludedArcs.resize(1,false);
+  excludedArcs[0]=true;
+  score=wg.bestPathFromFinalStateToIdx(INITIAL_STATE,excludedArcs,arcVec);
+  CPPUNIT_ASSERT( score == -2.5 );
+  CPPUNIT_ASSERT( arcVec.size() == 2 );
+  CPPUNIT_ASSERT( arcWordsToStr(wg,arcVec[1]) == "c" );
+  CPPUNIT_ASSERT( arcWordsToStr(wg,arcVec[0]) == "a" );
+}
+
+//---------------------------------------
+void WordGraphTest::testNbestList()
+{
+  std::vector<std::pair<Score,std::string> > nblist;
+  std::vector<NbSearchHighLevelHyp> highLevelHypList;
+  std::vector<std::vector<Score> > scoreCompsVec;
+  wg.obtainNbestList(3,nblist,highLevelHypList,scoreCompsVec);
+
+  CPPUNIT_ASSERT( nblist.size() == 2 );
+  CPPUNIT_ASSERT( nblist[0].first == -2 );
+  CPPUNIT_ASSERT( nblist[0].second == "a b d" );
+  CPPUNIT_ASSERT( nblist[1].first == -2.5 );
+  CPPUNIT_ASSERT( nblist[1].second == "c a" );
+}
+
+//---------------------------------------
+void WordGraphTest::testOrderArcsTopol()
+{
+      // Add arcs whose predecessor state is used by a previous arc as
+      // successor state
+  WordGraph wordGraph;
+  std::vector<Score> scrVec;
+  scrVec.push_back(-1);
+  wordGraph.addArcWithScrComps(1,2,strToVec("y"),-1,scrVec);
+  scrVec[0]=-2;
+  wordGraph.addArcWithScrComps(0,1,strToVec("x"),-2,scrVec);
+  wordGraph.addFinalState(2);
+  wordGraph.prune(1);
+  CPPUNIT_ASSERT( !wordGraph.arcPruned(0) );
+  
+  wordGraph.orderArcsTopol();
+
+  WordGraphArc wgArc=wordGraph.wordGraphArcId2WordGraphArc(0);
+  CPPUNIT_ASSERT( wgArc.predStateIndex == 0 );
+  CPPUNIT_ASSERT( arcWordsToStr(wordGraph,wgArc) == "x" );
+  wgArc=wordGraph.wordGraphArcId2WordGraphArc(1);
+  CPPUNIT_ASSERT( wgArc.predStateIndex == 1 );
+  CPPUNIT_ASSERT( arcWordsToStr(wordGraph,wgArc) == "y" );
+
+  WordGraph::ArcIdRange range=wordGraph.getArcIdRangeToSuccStates(0);
+  CPPUNIT_ASSERT( range.second-range.first == 1 );
+  CPPUNIT_ASSERT( range.first[0] == 0 );
+
+  std::vector<WordGraphArc> arcVec;
+  std::vector<bool> excludedArcs;
+  Score score=wordGraph.bestPathFromFinalStateToIdx(INITIAL_STATE,excludedArcs,arcVec);
+  CPPUNIT_ASSERT( score == -3 );
+}
+
+//---------------------------------------
+void WordGraphTest::testBinaryFormat()
+{
+  std::vector<std::pair<std::string,float> > compWeights;
+  compWeights.push_back(std::make_pair("lm",0.5));
+  wg.setCompWeights(compWeights);
+  wg.setInitialStateScore(-0.25);
+  
+  CPPUNIT_ASSERT( wg.printBin(WG_TEST_BIN_FILE) == THOT_OK );
+  CPPUNIT_ASSERT( WordGraph::isBinWordGraphFile(WG_TEST_BIN_FILE) );
+
+  WordGraph loadedWg;
+  CPPUNIT_ASSERT( loadedWg.load(WG_TEST_BIN_FILE) == THOT_OK );
+  CPPUNIT_ASSERT( loadedWg.numArcs() == wg.numArcs() );
+  CPPUNIT_ASSERT( loadedWg.numStates() == wg.numStates() );
+  CPPUNIT_ASSERT( loadedWg.getInitialStateScore() == -0.25 );
+  CPPUNIT_ASSERT( loadedWg.stateIsFinal(3) );
+
+  std::vector<std::pair<std::string,float> > loadedCompWeights;
+  loadedWg.getCompWeights(loadedCompWeights);
+  CPPUNIT_ASSERT( loadedCompWeights == compWeights );
+
+      // The text representation of both word graphs is the same
+  std::ostringstream origStream;
+  std::ostringstream loadedStream;
+  wg.print(origStream);
+  loadedWg.print(loadedStream);
+  CPPUNIT_ASSERT( origStream.str() == loadedStream.str() );
+}
+
+//---------------------------------------
+std::vector<std::string> WordGraphTest::strToVec(const std::string& str)
+{
+  std::vector<std::string> vec;
+  std::istringstream iss(str);
+  std::string word;
+  while(iss>>word)
+    vec.push_back(word);
+  return vec;
+}
+
+//---------------------------------------
+std::string WordGraphTest::arcWordsToStr(const WordGraph& wordGraph,
+                                         const WordGraphArc& wgArc)
+{
+  std::string str;
+  for(unsigned int i=0;i<wgArc.numWords;++i)
+  {
+    if(i!=0) str+=" ";
+    str+=wordGraph.getArcWord(wgArc,i);
+  }
+  return str;
+}
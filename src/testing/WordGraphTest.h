@@ -0,0 +1,76 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WordGraphTest.h
+ *
+ * @brief Declares the WordGraphTest class implementing unit tests for
+ * the WordGraph class.
+ */
+
+#ifndef _WordGraphTest_h
+#define _WordGraphTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "WordGraph.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Classes --------------------------------------------
+
+//--------------- WordGraphTest class
+
+/**
+ * @brief Class implementing tests for WordGraph.
+ */
+
+class WordGraphTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( WordGraphTest );
+  CPPUNIT_TEST( testArcWords );
+  CPPUNIT_TEST( testAdjacency );
+  CPPUNIT_TEST( testBestPathWithExcludedArcs );
+  CPPUNIT_TEST( testNbestList );
+  CPPUNIT_TEST( testOrderArcsTopol );
+  CPPUNIT_TEST( testBinaryFormat );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testArcWords();
+  void testAdjacency();
+  void testBestPathWithExcludedArcs();
+  void testNbestList();
+  void testOrderArcsTopol();
+  void testBinaryFormat();
+
+ private:
+  WordGraph wg;
+
+  std::vector<std::string> strToVec(const std::string& str);
+  std::string arcWordsToStr(const WordGraph& wordGraph,
+                            const WordGraphArc& wgArc);
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WorkerThreadPoolTest.cc
+ * 
+ * @brief Definitions file for WorkerThreadPoolTest.h
+ */
+
+//--------------- Include files --------------------------------------
+
+#include "WorkerThreadPoolTest.h"
+#include <vector>
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( WorkerThreadPoolTest );
+
+//--------------- Task functions used in the tests
+
+struct PoolTestData
+{
+  std::vector<unsigned int> countVec;
+  std::vector<unsigned int> workerIdxVec;
+};
+
+static void countTask(void* data,
+                      unsigned int taskIdx,
+                      unsigned int workerIdx)
+{
+  PoolTestData* dataPtr=(PoolTestData*) data;
+  dataPtr->countVec[taskIdx]+=1;
+  dataPtr->workerIdxVec[taskIdx]=workerIdx;
+}
+
+//--------------- WorkerThreadPoolTest class functions
+//
+
+//---------------------------------------
+void WorkerThreadPoolTest::setUp()
+{
+}
+
+//---------------------------------------
+void WorkerThreadPoolTest::tearDown()
+{
+}
+
+//---------------------------------------
+void WorkerThreadPoolTest::testRunExecutesEachTaskOnce()
+{
+  WorkerThreadPool pool(4);
+  PoolTestData data;
+  for(unsigned int n=0;n<100;++n)
+  {
+    data.countVec.assign(n,0);
+    data.workerIdxVec.assign(n,0);
+    pool.run(n,&countTask,(void*) &data);
+    for(unsigned int i=0;i<n;++i)
+    {
+      CPPUNIT_ASSERT( data.countVec[i] == 1 );
+      CPPUNIT_ASSERT( data.workerIdxVec[i] < 4 );
+    }
+  }
+}
+
+//---------------------------------------
+void WorkerThreadPoolTest::testRunOnEachWorker()
+{
+  WorkerThreadPool pool(3);
+  PoolTestData data;
+  data.countVec.assign(3,0);
+  data.workerIdxVec.assign(3,0);
+  pool.runOnEachWorker(&countTask,(void*) &data);
+  for(unsigned int i=0;i<3;++i)
+  {
+    CPPUNIT_ASSERT( data.countVec[i] == 1 );
+    CPPUNIT_ASSERT( data.workerIdxVec[i] == i );
+  }
+
+      // The thread requesting the work is not a thread of the pool
+  CPPUNIT_ASSERT( pool.getCurrentWorkerIdx() == 0 );
+}
+
+//---------------------------------------
+void WorkerThreadPoolTest::testCopiedPool()
+{
+  WorkerThreadPool pool(2);
+  PoolTestData data;
+  data.countVec.assign(10,0);
+  data.workerIdxVec.assign(10,0);
+  pool.run(10,&countTask,(void*) &data);
+
+      // Copies use their own threads
+  WorkerThreadPool poolCopy(pool);
+  CPPUNIT_ASSERT( poolCopy.getNumThreads() == 2 );
+  poolCopy.run(10,&countTask,(void*) &data);
+  pool.run(10,&countTask,(void*) &data);
+  for(unsigned int i=0;i<10;++i)
+    CPPUNIT_ASSERT( data.countVec[i] == 3 );
+}
@@ -0,0 +1,69 @@
+/*
+thot package for statistical machine translation
+Copyright (C) 2013 Daniel Ortiz-Mart\'inez
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public License
+as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file WorkerThreadPoolTest.h
+ *
+ * @brief Declares the WorkerThreadPoolTest class implementing unit
+ * tests for the WorkerThreadPool class.
+ */
+
+#ifndef _WorkerThreadPoolTest_h
+#define _WorkerThreadPoolTest_h
+
+//--------------- Include files --------------------------------------
+
+#if HAVE_CONFIG_H
+#  include <thot_config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "WorkerThreadPool.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+//--------------- Constants ------------------------------------------
+
+
+//--------------- typedefs -------------------------------------------
+
+
+//--------------- Classes --------------------------------------------
+
+//--------------- WorkerThreadPoolTest class
+
+/**
+ * @brief Class implementing tests for WorkerThreadPool.
+ */
+
+class WorkerThreadPoolTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( WorkerThreadPoolTest );
+  CPPUNIT_TEST( testRunExecutesEachTaskOnce );
+  CPPUNIT_TEST( testRunOnEachWorker );
+  CPPUNIT_TEST( testCopiedPool );
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp();
+  void tearDown();
+
+  void testRunExecutesEachTaskOnce();
+  void testRunOnEachWorker();
+  void testCopiedPool();
+};
+
+#endif
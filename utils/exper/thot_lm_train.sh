@@ -191,26 +191,41 @@ generate_outsubdir_name()
 }
 
 ########
-estimate_thotlm()
+get_ngram_counts()
 {
-    # Determine output directory information
-    prefix=$outd/${outsubdir}/trg.lm
-    relative_prefix="${outsubdir}/trg.lm"
+    local outfile=$1
 
     # Obtain number of lines for input file
     nl=`"$WC" -l $corpus | "$AWK" '{printf"%s",$1}'`
 
-    # Estimate n-gram model parameters
     if [ $nl -gt 0 ]; then
-        "${bindir}"/thot_pbs_get_ngram_counts -pr ${pr_val} \
-                 -c "$corpus" -o "$prefix" -n ${n_val} -f ${fragm_size} ${unk_opt} \
-                 ${qs_opt} "${qs_par}" -tdir "$tdir" -sdir "$sdir" ${debug_opt} || return 1
+        if [ ${qs_given} -eq 0 ]; then
+            # Count n-grams in the local machine using one thread per
+            # processor
+            "${bindir}"/thot_count_ngrams -c "$corpus" -n ${n_val} ${unk_opt} \
+                     -nt ${pr_val} -tdir "$tdir" -o "$outfile" || return 1
+        else
+            "${bindir}"/thot_pbs_get_ngram_counts -pr ${pr_val} \
+                     -c "$corpus" -o "$outfile" -n ${n_val} -f ${fragm_size} ${unk_opt} \
+                     ${qs_opt} "${qs_par}" -tdir "$tdir" -sdir "$sdir" ${debug_opt} || return 1
+        fi
     else
         ${bindir}/thot_get_ngram_counts -c "$corpus" \
-                 -n ${n_val} > "$prefix" || return 1
+                 -n ${n_val} > "$outfile" || return 1
     fi
 }
 
+########
+estimate_thotlm()
+{
+    # Determine output directory information
+    prefix=$outd/${outsubdir}/trg.lm
+    relative_prefix="${outsubdir}/trg.lm"
+
+    # Estimate n-gram model parameters
+    get_ngram_counts "$prefix" || return 1
+}
+
 ########
 estimate_klm()
 {
@@ -238,18 +253,8 @@ estimate_ldb()
     # Determine output directory of native thot language model
     thotlm_prefix="$outd/${outsubdir}/trg.thotlm"
 
-    # Obtain number of lines for input file
-    nl=`"$WC" -l $corpus | "$AWK" '{printf"%s",$1}'`
-
     # Estimate n-gram model parameters
-    if [ $nl -gt 0 ]; then
-        "${bindir}"/thot_pbs_get_ngram_counts -pr ${pr_val} \
-                 -c "$corpus" -o "${thotlm_prefix}" -n ${n_val} -f ${fragm_size} ${unk_opt} \
-                 ${qs_opt} "${qs_par}" -tdir "$tdir" -sdir "$sdir" ${debug_opt} || return 1
-    else
-        ${bindir}/thot_get_ngram_counts -c "$corpus" \
-                 -n ${n_val} > "${thotlm_prefix}" || return 1
-    fi
+    get_ngram_counts "${thotlm_prefix}" || return 1
 
     # Determine output directory information
     prefix="$outd/${outsubdir}/trg.lm"
@@ -29,7 +29,7 @@ usage()
 {
     echo "thot_smt_tune           [-pr <int>] -c <string>"
     echo "                        -s <string> -t <string> -o <string>"
-    echo "                        [-qs <string>] [-tdir <string>]"
+    echo "                        [-qs <string>] [-tdir <string>] [-inproc]"
     echo "                        [-debug] [--help] [--version]"
     echo ""
     echo "-pr <int>               Number of processors (1 by default)"
@@ -60,6 +60,8 @@ usage()
     echo "                        NOTES:"
     echo "                         a) give absolute paths when using pbs clusters"
     echo "                         b) ensure there is enough disk space in the partition"
+    echo "-inproc                 Tune log-linear weights using a single process that"
+    echo "                        loads the models only once (thot_ms_tune tool)."
     echo "-debug                  After ending, do not delete temporary files"
     echo "                        (for debugging purposes)"
     echo "--help                  Display this help and exit."
@@ -613,6 +615,16 @@ loglin_upd()
         > "${outd}/llweights_tune.out" 2> "${outd}/llweights_tune.log" || return 1
 }
 
+########
+loglin_inproc_upd()
+{
+    echo "NOTE: see file ${outd}/llweights_tune.log to track optimization progress" >&2
+
+    # Execute in-process tuning algorithm
+    "${bindir}"/thot_ms_tune -c "${outd}/tune_loglin.cfg" -t "$scorpus" -r "$tcorpus" \
+        -nt ${pr_val} -o "${outd}/llweights_tune.out" 2> "${outd}/llweights_tune.log" || return 1
+}
+
 ########
 linear_interp_upd()
 {
@@ -688,7 +700,9 @@ tune_tm()
     # Tune log-linear model
     echo "" >&2
     echo "- Tuning log-linear model weights..." >&2
-    if [ $ENABLE_DOWNHILL_LLW -eq 1 ]; then
+    if [ ${inproc_given} -eq 1 ]; then
+        loglin_inproc_upd || return 1
+    elif [ $ENABLE_DOWNHILL_LLW -eq 1 ]; then
         loglin_downhill || return 1
     else
         loglin_upd || return 1
@@ -722,6 +736,7 @@ tdir_given=0
 tdir="/tmp"
 sdir_given=0
 sdir=$HOME
+inproc_given=0
 debug=0
 
 while [ $# -ne 0 ]; do
@@ -786,6 +801,8 @@ while [ $# -ne 0 ]; do
                 sdir_given=1
             fi
             ;;
+        "-inproc") inproc_given=1
+            ;;
         "-debug") debug=1
             debug_opt="-debug"
             ;;
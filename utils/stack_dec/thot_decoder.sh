@@ -31,7 +31,10 @@ usage()
     echo "                [-sdir <string>] [-qs <string>] [-v|-v1|-v2]"
     echo "                [-debug] [--help] [--version]"
     echo ""
-    echo " -pr <int>         : Number of processors."
+    echo " -pr <int>         : Number of processors. If there are non-process-safe"
+    echo "                     modules (e.g. LevelDB-based ones), a single decoder"
+    echo "                     process with <int> translation threads sharing the"
+    echo "                     models is used instead."
     echo " -c <string>       : Configuration file (command-line options override"
     echo "                     configuration file options)."
     echo " -tm <string>      : Prefix of phrase model files or model descriptor."
@@ -115,7 +118,7 @@ trans_frag()
     echo "** Processing chunk ${fragm} (started at "`date`")..." > "$SDIR"/qs_trans_${fragm}.err
 
     "${bindir}"/thot_ms_dec ${cfg_opt} "$cfgfile" -t "$SDIR"/${fragm} ${tm_opt} "${tm}" ${lm_opt} "${lm}" ${dec_pars} \
-        ${wgp_par} -wg "$SDIR"/wg_${fragm} 2>> "$SDIR"/qs_trans_${fragm}.err >"$SDIR"/qs_trans_${fragm}.out || \
+        ${nt_par} ${wgp_par} -wg "$SDIR"/wg_${fragm} 2>> "$SDIR"/qs_trans_${fragm}.err >"$SDIR"/qs_trans_${fragm}.out || \
         { echo "Error while executing trans_frag for $SDIR/${fragm}" >> "$SDIR"/qs_trans_${fragm}.err; return 1 ; }
 
     # Write date to log file
@@ -196,6 +199,7 @@ report_errors()
 # main
 pr_given=0
 num_procs=1
+num_threads=1
 c_given=0
 tm_given=0
 lm_given=0
@@ -371,7 +375,10 @@ fi
 process_safety=`check_process_safety`
 if [ ${process_safety} = "no" ]; then
     if [ ${num_procs} -gt 1 ]; then
-        echo "Warning: only one processor will be used since there are non-process-safe modules" >&2
+        # Non-process-safe modules can be shared by the translation
+        # threads of a single decoder process
+        echo "Warning: there are non-process-safe modules, one process with ${num_procs} translation threads will be used" >&2
+        num_threads=${num_procs}
         num_procs=1
     fi
 fi
@@ -403,6 +410,13 @@ else
     wgp_par=""
 fi
 
+# set nt_par variable
+if [ ${num_threads} -gt 1 ]; then
+    nt_par="-nt ${num_threads}"
+else
+    nt_par=""
+fi
+
 # create log file
 echo "Input file: ${sents}"> "$SDIR"/log
 echo "">> "$SDIR"/log
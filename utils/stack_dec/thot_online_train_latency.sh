@@ -0,0 +1,191 @@
+# Author: Daniel Ortiz Mart\'inez
+# *- bash -*
+
+# Measures the latency of the translation requests served by
+# thot_server with and without concurrent online training requests
+
+########
+print_desc()
+{
+    echo "thot_online_train_latency written by Daniel Ortiz"
+    echo "thot_online_train_latency measures translation latency during online training"
+    echo "type \"thot_online_train_latency --help\" to get usage information."
+}
+
+########
+version()
+{
+    echo "thot_online_train_latency is part of the thot package"
+    echo "thot version "${version}
+    echo "thot is GNU software written by Daniel Ortiz"
+}
+
+########
+usage()
+{
+    echo "thot_online_train_latency -i <string> [-p <int>]"
+    echo "                          -t <string> -s <string> -r <string>"
+    echo "                          [--help] [--version]"
+    echo ""
+    echo " -i <string>             : IP address of the server."
+    echo " -p <int>                : Server port."
+    echo " -t <string>             : File with the sentences to translate."
+    echo " -s <string>             : File with source sentences for online"
+    echo "                           training."
+    echo " -r <string>             : File with reference sentences for online"
+    echo "                           training."
+    echo " --help                  : Display this help and exit."
+    echo " --version               : Output version information and exit."
+    echo ""
+    echo "NOTE: the sentences given with -t are translated twice, first alone"
+    echo "      and then while the sentence pairs given with -s and -r are"
+    echo "      trained by another user. The server models are modified."
+}
+
+########
+translate_corpus()
+{
+    # Translate sentences and print the latency of each request in
+    # milliseconds
+    while read -r s; do
+        start=`date +%s%N`
+        "$bindir"/thot_client -i $ip ${port_op} -uid 0 -t "$s" > /dev/null || return 1
+        end=`date +%s%N`
+        echo "$start $end" | $AWK '{printf"%.3f\n",($2-$1)/1000000}'
+    done < $testfile
+}
+
+########
+train_corpus()
+{
+    numSent=0
+    while read -r s; do
+        numSent=`expr $numSent + 1`
+        r=`head -${numSent} "$reffile" | tail -1`
+        "$bindir"/thot_client -i $ip ${port_op} -uid 1 -tr "$s" "$r" > /dev/null || return 1
+    done < $srcfile
+}
+
+########
+latency_stats()
+{
+    $AWK '{
+           sum+=$1
+           if($1>max) max=$1
+          }
+          END{
+              if(NR>0) printf"requests: %d ; mean latency: %.3f ms ; max. latency: %.3f ms\n",NR,sum/NR,max
+             }'
+}
+
+########
+
+# Print command line to the error output
+echo "Cmd. line: $0 $*" >&2
+
+ip_given=0
+sents_given=0
+srcs_given=0
+refs_given=0
+
+if [ $# -eq 0 ]; then
+    print_desc
+    exit 1
+fi
+
+while [ $# -ne 0 ]; do
+    case $1 in
+        "--help") usage
+            exit 0
+            ;;
+        "--version") version
+            exit 0
+            ;;
+        "-i") shift
+            if [ $# -ne 0 ]; then
+                ip=$1
+                ip_given=1
+            else
+                ip_given=0
+            fi
+            ;;
+        "-p") shift
+            if [ $# -ne 0 ]; then
+                port=$1
+                port_op="-p ${port}"
+            fi
+            ;;
+        "-t") shift
+            if [ $# -ne 0 ]; then
+                testfile=$1
+                sents_given=1
+            fi
+            ;;
+        "-s") shift
+            if [ $# -ne 0 ]; then
+                srcfile=$1
+                srcs_given=1
+            fi
+            ;;
+        "-r") shift
+            if [ $# -ne 0 ]; then
+                reffile=$1
+                refs_given=1
+            fi
+            ;;
+    esac
+    shift
+done
+
+# verify parameters
+
+if [ ${ip_given} -eq 0 ]; then
+    echo "Error: ip address not given" >&2
+    exit 1
+fi
+
+if [ ${sents_given} -eq 0 ]; then
+    echo "Error: file with sentences not given">&2
+    exit 1
+else
+    if [ ! -f  "${testfile}" ]; then
+        echo "Error: file ${testfile} with test sentences does not exist">&2
+        exit 1
+    fi
+fi
+
+if [ ${srcs_given} -eq 0 ]; then
+    echo "Error: file with source sentences not given">&2
+    exit 1
+else
+    if [ ! -f  "${srcfile}" ]; then
+        echo "Error: file ${srcfile} with source sentences does not exist">&2
+        exit 1
+    fi
+fi
+
+if [ ${refs_given} -eq 0 ]; then
+    echo "Error: file with references not given">&2
+    exit 1
+else
+    if [ ! -f  "${reffile}" ]; then
+        echo "Error: file ${reffile} with references does not exist">&2
+        exit 1
+    fi
+fi
+
+# parameters are ok
+
+# Translate without concurrent training
+echo "* Translation without concurrent training:"
+translate_corpus | latency_stats
+
+# Translate while another user trains the models
+echo "* Translation with concurrent training:"
+train_corpus &
+train_pid=$!
+translate_corpus | latency_stats
+wait ${train_pid} || exit 1
+
+# Return 0
+exit 0